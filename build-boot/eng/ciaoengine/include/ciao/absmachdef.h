@@ -0,0 +1 @@
+/root/repo/core/bootstrap/ciaoc.car/absmachdef.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/atomic_basic.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/attributes.h
\ No newline at end of file
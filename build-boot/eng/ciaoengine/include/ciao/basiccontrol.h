@@ -0,0 +1 @@
+/root/repo/core/engine/basiccontrol.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/ciao_prolog.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/configure.EMSCRIPTENwasm32p64.h
\ No newline at end of file
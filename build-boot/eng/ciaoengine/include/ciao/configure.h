@@ -0,0 +1,34 @@
+#if !defined(_REENTRANT)
+#define _REENTRANT
+#endif
+#if !defined(LINUX)
+#define LINUX
+#endif
+#if !defined(x86_64)
+#define x86_64
+#endif
+#if !defined(USE_THREADS)
+#define USE_THREADS
+#endif
+#if !defined(FOREIGN_FILES)
+#define FOREIGN_FILES
+#endif
+#if !defined(USE_OWN_MALLOC)
+#define USE_OWN_MALLOC
+#endif
+#define IS_BIG_ENDIAN 0
+#define MallocBase5 0x0
+#define MIN_MEM_ALLOC_5 0x4000
+#define MallocBase4 0x0
+#define MIN_MEM_ALLOC_4 0x4000
+#define MallocBase3 0x0
+#define MIN_MEM_ALLOC_3 0x4000
+#define MallocBase2 0x0
+#define MIN_MEM_ALLOC_2 0x4000
+#define MallocBase1 0x0
+#define MIN_MEM_ALLOC_1 0x4000
+#define MallocBase0 0x0
+#define MIN_MEM_ALLOC_0 0x4000
+#if !defined(USE_OWN_MALLOC)
+#define USE_OWN_MALLOC 1
+#endif
@@ -0,0 +1 @@
+/root/repo/core/engine/dtoa_ryu.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_bytes.h
\ No newline at end of file
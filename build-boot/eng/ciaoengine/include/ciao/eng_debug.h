@@ -0,0 +1 @@
+/root/repo/core/engine/eng_debug.h
\ No newline at end of file
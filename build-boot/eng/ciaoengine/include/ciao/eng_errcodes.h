@@ -0,0 +1 @@
+/root/repo/core/engine/eng_errcodes.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_registry.h
\ No newline at end of file
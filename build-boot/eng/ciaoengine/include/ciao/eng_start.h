@@ -0,0 +1 @@
+/root/repo/core/engine/eng_start.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/bootstrap/ciaoc.car/instrdefs.h
\ No newline at end of file
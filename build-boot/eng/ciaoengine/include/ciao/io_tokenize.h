@@ -0,0 +1 @@
+/root/repo/core/engine/io_tokenize.h
\ No newline at end of file
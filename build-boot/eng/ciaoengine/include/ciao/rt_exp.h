@@ -0,0 +1 @@
+/root/repo/core/engine/rt_exp.h
\ No newline at end of file
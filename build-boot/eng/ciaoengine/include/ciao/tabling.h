@@ -0,0 +1 @@
+/root/repo/core/engine/tabling.h
\ No newline at end of file
@@ -0,0 +1,8 @@
+#ifndef _CIAO_VERSION_H
+#define _CIAO_VERSION_H
+#define CIAO_VERSION_STRING "Ciao 1.25.0"
+#define CIAO_MAJOR_VERSION 1
+#define CIAO_MINOR_VERSION 25
+#define CIAO_PATCH_NUMBER 0
+
+#endif /* _CIAO_VERSION_H */
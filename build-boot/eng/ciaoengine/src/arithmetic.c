@@ -0,0 +1 @@
+/root/repo/core/engine/arithmetic.c
\ No newline at end of file
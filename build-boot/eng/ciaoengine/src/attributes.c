@@ -0,0 +1 @@
+/root/repo/core/engine/attributes.c
\ No newline at end of file
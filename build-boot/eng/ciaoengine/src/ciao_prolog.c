@@ -0,0 +1 @@
+/root/repo/core/engine/ciao_prolog.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/concurrency.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/fix_size.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/gauge.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/internals.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/own_malloc.c
\ No newline at end of file
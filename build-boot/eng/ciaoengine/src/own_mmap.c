@@ -0,0 +1 @@
+/root/repo/core/engine/own_mmap.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/rt_exp.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/rune.c
\ No newline at end of file
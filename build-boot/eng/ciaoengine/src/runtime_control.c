@@ -0,0 +1 @@
+/root/repo/core/engine/runtime_control.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/term_basic.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/terms_check.c
\ No newline at end of file
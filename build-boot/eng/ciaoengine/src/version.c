@@ -0,0 +1,6 @@
+char *ciao_version = "1.25";
+char *ciao_patch = "0";
+char *ciao_commit_branch = "unknown";
+char *ciao_commit_id = "unknown";
+char *ciao_commit_date = "unknown";
+char *ciao_commit_desc = "unknown";
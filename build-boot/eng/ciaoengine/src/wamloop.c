@@ -0,0 +1 @@
+/root/repo/core/bootstrap/ciaoc.car/wamloop.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/win32_mman.c
\ No newline at end of file
@@ -0,0 +1,29 @@
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
@@ -0,0 +1,29 @@
+'example_static:bar'(5) .
+'example_static:bar'(4) .
+'example_static:bar'(3) .
+'example_static:bar'(2) .
+'example_static:bar'(1) .
+'example_static:bar'(5) .
+'example_static:bar'(4) .
+'example_static:bar'(3) .
+'example_static:bar'(2) .
+'example_static:bar'(1) .
+'example_static:bar'(5) .
+'example_static:bar'(4) .
+'example_static:bar'(3) .
+'example_static:bar'(2) .
+'example_static:bar'(1) .
+'example_static:bar'(5) .
+'example_static:bar'(4) .
+'example_static:bar'(3) .
+'example_static:bar'(2) .
+'example_static:bar'(1) .
+'example_static:bar'(5) .
+'example_static:bar'(4) .
+'example_static:bar'(3) .
+'example_static:bar'(2) .
+'example_static:bar'(1) .
+'example_static:bar'(5) .
+'example_static:bar'(4) .
+'example_static:bar'(3) .
+'example_static:bar'(2) .
@@ -0,0 +1,68 @@
+#include <ciao/ciao_gluecode.h>
+
+int count_sliced(int, long);
+bool_t gluecode_count_sliced(worker_t *w) {
+  ERR__FUNCTOR("embedding_threads:count_sliced", 3);
+  ciao_term t0;
+  ciao_term t1;
+  ciao_term t2;
+  int c0;
+  long c1;
+  int c2;
+  ciao_term u2;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  t1 = ciao_ref(ctx, X(1));
+  t2 = ciao_ref(ctx, X(2));
+  if (!ciao_is_integer_s(ctx, t0)) ERROR_IN_ARG(X(0), 0 + 1, ERR_type_error(integer));
+  if (!ciao_is_integer_s(ctx, t1)) ERROR_IN_ARG(X(1), 1 + 1, ERR_type_error(integer));
+  c0 = ciao_get_c_int_s(ctx, t0);
+  c1 = ciao_get_c_long_s(ctx, t1);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c2 = count_sliced(c0, c1));
+  u2 = ciao_mk_c_int_s(ctx, c2);
+  if (!ciao_unify_s(ctx, u2, t2)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+int count_threads(int, int);
+bool_t gluecode_count_threads(worker_t *w) {
+  ERR__FUNCTOR("embedding_threads:count_threads", 3);
+  ciao_term t0;
+  ciao_term t1;
+  ciao_term t2;
+  int c0;
+  int c1;
+  int c2;
+  ciao_term u2;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  t1 = ciao_ref(ctx, X(1));
+  t2 = ciao_ref(ctx, X(2));
+  if (!ciao_is_integer_s(ctx, t0)) ERROR_IN_ARG(X(0), 0 + 1, ERR_type_error(integer));
+  if (!ciao_is_integer_s(ctx, t1)) ERROR_IN_ARG(X(1), 1 + 1, ERR_type_error(integer));
+  c0 = ciao_get_c_int_s(ctx, t0);
+  c1 = ciao_get_c_int_s(ctx, t1);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c2 = count_threads(c0, c1));
+  u2 = ciao_mk_c_int_s(ctx, c2);
+  if (!ciao_unify_s(ctx, u2, t2)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+void embedding_threads_init(char *module) {
+  define_c_mod_predicate(module, "count_sliced", 3, gluecode_count_sliced);
+  define_c_mod_predicate(module, "count_threads", 3, gluecode_count_threads);
+}
+
+void embedding_threads_end(char *module) {
+  undefine_c_mod_predicate(module, "count_sliced", 3);
+  undefine_c_mod_predicate(module, "count_threads", 3);
+}
+
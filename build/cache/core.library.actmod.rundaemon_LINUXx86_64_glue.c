@@ -0,0 +1,12 @@
+#include <ciao/ciao_gluecode.h>
+
+bool_t run_daemon(worker_t *);
+
+void rundaemon_init(char *module) {
+  define_c_mod_predicate(module, "run_daemon", 3, run_daemon);
+}
+
+void rundaemon_end(char *module) {
+  undefine_c_mod_predicate(module, "run_daemon", 3);
+}
+
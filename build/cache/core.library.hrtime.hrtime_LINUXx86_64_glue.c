@@ -0,0 +1,68 @@
+#include <ciao/ciao_gluecode.h>
+
+double prolog_hrtime(void);
+bool_t gluecode_hrtime(worker_t *w) {
+  ERR__FUNCTOR("hrtime:hrtime", 1);
+  ciao_term t0;
+  double c0;
+  ciao_term u0;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c0 = prolog_hrtime());
+  u0 = ciao_mk_c_double_s(ctx, c0);
+  if (!ciao_unify_s(ctx, u0, t0)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+char *prolog_hrmethod(void);
+bool_t gluecode_hrmethod(worker_t *w) {
+  ERR__FUNCTOR("hrtime:hrmethod", 1);
+  ciao_term t0;
+  char *c0;
+  ciao_term u0;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c0 = prolog_hrmethod());
+  u0 = ciao_atom_s(ctx, c0);
+  if (!ciao_unify_s(ctx, u0, t0)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+double prolog_hrfreq(void);
+bool_t gluecode_hrfreq(worker_t *w) {
+  ERR__FUNCTOR("hrtime:hrfreq", 1);
+  ciao_term t0;
+  double c0;
+  ciao_term u0;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c0 = prolog_hrfreq());
+  u0 = ciao_mk_c_double_s(ctx, c0);
+  if (!ciao_unify_s(ctx, u0, t0)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+void hrtime_init(char *module) {
+  define_c_mod_predicate(module, "hrtime", 1, gluecode_hrtime);
+  define_c_mod_predicate(module, "hrmethod", 1, gluecode_hrmethod);
+  define_c_mod_predicate(module, "hrfreq", 1, gluecode_hrfreq);
+}
+
+void hrtime_end(char *module) {
+  undefine_c_mod_predicate(module, "hrtime", 1);
+  undefine_c_mod_predicate(module, "hrmethod", 1);
+  undefine_c_mod_predicate(module, "hrfreq", 1);
+}
+
@@ -0,0 +1,20 @@
+#include <ciao/ciao_gluecode.h>
+
+bool_t prolog_random(worker_t *);
+
+bool_t prolog_random3(worker_t *);
+
+bool_t prolog_srandom(worker_t *);
+
+void random_init(char *module) {
+  define_c_mod_predicate(module, "random", 1, prolog_random);
+  define_c_mod_predicate(module, "random", 3, prolog_random3);
+  define_c_mod_predicate(module, "srandom", 1, prolog_srandom);
+}
+
+void random_end(char *module) {
+  undefine_c_mod_predicate(module, "random", 1);
+  undefine_c_mod_predicate(module, "random", 3);
+  undefine_c_mod_predicate(module, "srandom", 1);
+}
+
@@ -0,0 +1,100 @@
+#include <ciao/ciao_gluecode.h>
+
+bool_t sockets_c_init(worker_t *);
+
+bool_t init_from_ciaopp(worker_t *);
+
+bool_t prolog_connect_to_socket_type(worker_t *);
+
+bool_t prolog_bind_socket(worker_t *);
+
+bool_t prolog_socket_accept(worker_t *);
+
+bool_t prolog_select_socket(worker_t *);
+
+bool_t prolog_socket_send(worker_t *);
+
+bool_t prolog_socket_sendall(worker_t *);
+
+bool_t prolog_socket_sendall_list(worker_t *);
+
+bool_t prolog_socket_send_stream(worker_t *);
+
+bool_t prolog_socket_send_file(worker_t *);
+
+bool_t prolog_socket_receive(worker_t *);
+
+bool_t prolog_socket_evloop_new(worker_t *);
+
+bool_t prolog_socket_evloop_max_content(worker_t *);
+
+bool_t prolog_socket_evloop_wait(worker_t *);
+
+bool_t prolog_socket_evloop_resume(worker_t *);
+
+bool_t prolog_socket_evloop_release(worker_t *);
+
+bool_t prolog_socket_evloop_send(worker_t *);
+
+bool_t prolog_socket_evloop_wake(worker_t *);
+
+bool_t prolog_socket_evloop_close(worker_t *);
+
+bool_t prolog_socket_shutdown(worker_t *);
+
+bool_t prolog_hostname_address(worker_t *);
+
+bool_t prolog_socket_getpeername(worker_t *);
+
+void sockets_init(char *module) {
+  define_c_mod_predicate(module, "initial", 0, sockets_c_init);
+  define_c_mod_predicate(module, "initial_from_ciaopp", 0, init_from_ciaopp);
+  define_c_mod_predicate(module, "connect_to_socket_type", 4, prolog_connect_to_socket_type);
+  define_c_mod_predicate(module, "bind_socket", 3, prolog_bind_socket);
+  define_c_mod_predicate(module, "socket_accept", 2, prolog_socket_accept);
+  define_c_mod_predicate(module, "select_socket", 5, prolog_select_socket);
+  define_c_mod_predicate(module, "socket_send", 3, prolog_socket_send);
+  define_c_mod_predicate(module, "socket_sendall", 2, prolog_socket_sendall);
+  define_c_mod_predicate(module, "socket_sendall_list", 2, prolog_socket_sendall_list);
+  define_c_mod_predicate(module, "socket_send_stream", 2, prolog_socket_send_stream);
+  define_c_mod_predicate(module, "socket_send_file", 4, prolog_socket_send_file);
+  define_c_mod_predicate(module, "socket_recv", 3, prolog_socket_receive);
+  define_c_mod_predicate(module, "socket_evloop_new", 2, prolog_socket_evloop_new);
+  define_c_mod_predicate(module, "socket_evloop_max_content", 2, prolog_socket_evloop_max_content);
+  define_c_mod_predicate(module, "socket_evloop_wait", 3, prolog_socket_evloop_wait);
+  define_c_mod_predicate(module, "socket_evloop_resume", 2, prolog_socket_evloop_resume);
+  define_c_mod_predicate(module, "socket_evloop_release", 2, prolog_socket_evloop_release);
+  define_c_mod_predicate(module, "socket_evloop_send", 4, prolog_socket_evloop_send);
+  define_c_mod_predicate(module, "socket_evloop_wake", 1, prolog_socket_evloop_wake);
+  define_c_mod_predicate(module, "socket_evloop_close", 2, prolog_socket_evloop_close);
+  define_c_mod_predicate(module, "socket_shutdown", 2, prolog_socket_shutdown);
+  define_c_mod_predicate(module, "hostname_address", 2, prolog_hostname_address);
+  define_c_mod_predicate(module, "socket_getpeername", 2, prolog_socket_getpeername);
+}
+
+void sockets_end(char *module) {
+  undefine_c_mod_predicate(module, "initial", 0);
+  undefine_c_mod_predicate(module, "initial_from_ciaopp", 0);
+  undefine_c_mod_predicate(module, "connect_to_socket_type", 4);
+  undefine_c_mod_predicate(module, "bind_socket", 3);
+  undefine_c_mod_predicate(module, "socket_accept", 2);
+  undefine_c_mod_predicate(module, "select_socket", 5);
+  undefine_c_mod_predicate(module, "socket_send", 3);
+  undefine_c_mod_predicate(module, "socket_sendall", 2);
+  undefine_c_mod_predicate(module, "socket_sendall_list", 2);
+  undefine_c_mod_predicate(module, "socket_send_stream", 2);
+  undefine_c_mod_predicate(module, "socket_send_file", 4);
+  undefine_c_mod_predicate(module, "socket_recv", 3);
+  undefine_c_mod_predicate(module, "socket_evloop_new", 2);
+  undefine_c_mod_predicate(module, "socket_evloop_max_content", 2);
+  undefine_c_mod_predicate(module, "socket_evloop_wait", 3);
+  undefine_c_mod_predicate(module, "socket_evloop_resume", 2);
+  undefine_c_mod_predicate(module, "socket_evloop_release", 2);
+  undefine_c_mod_predicate(module, "socket_evloop_send", 4);
+  undefine_c_mod_predicate(module, "socket_evloop_wake", 1);
+  undefine_c_mod_predicate(module, "socket_evloop_close", 2);
+  undefine_c_mod_predicate(module, "socket_shutdown", 2);
+  undefine_c_mod_predicate(module, "hostname_address", 2);
+  undefine_c_mod_predicate(module, "socket_getpeername", 2);
+}
+
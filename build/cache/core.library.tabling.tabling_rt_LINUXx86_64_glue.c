@@ -0,0 +1,76 @@
+#include <ciao/ciao_gluecode.h>
+
+bool_t abolish_all_tables_c(worker_t *);
+
+bool_t tabled_call_c(worker_t *);
+
+bool_t new_answer_c(worker_t *);
+
+bool_t lookup_trie_c(worker_t *);
+
+bool_t execute_call_c(worker_t *);
+
+bool_t consume_answer_c(worker_t *);
+
+bool_t new_answer_attr_c(worker_t *);
+
+bool_t initial_tabling_c(worker_t *);
+
+bool_t gen_tree_backtracking_c(worker_t *);
+
+bool_t pop_ptcp_c(worker_t *);
+
+bool_t push_ptcp_c(worker_t *);
+
+bool_t lookup_attr_call_c(worker_t *);
+
+bool_t reinstall_gen_space_c(worker_t *);
+
+bool_t consume_attr_answer_c(worker_t *);
+
+bool_t set_tabling_flag_c(worker_t *);
+
+bool_t current_tabling_flag_c(worker_t *);
+
+bool_t tabling_stats_c(worker_t *);
+
+void tabling_rt_init(char *module) {
+  define_c_mod_predicate(module, "abolish_all_tables", 0, abolish_all_tables_c);
+  define_c_mod_predicate(module, "tabled_call", 1, tabled_call_c);
+  define_c_mod_predicate(module, "new_answer", 0, new_answer_c);
+  define_c_mod_predicate(module, "lookup_trie", 3, lookup_trie_c);
+  define_c_mod_predicate(module, "execute_call", 4, execute_call_c);
+  define_c_mod_predicate(module, "consume_answer", 4, consume_answer_c);
+  define_c_mod_predicate(module, "new_answer_attr", 0, new_answer_attr_c);
+  define_c_mod_predicate(module, "initial_tabling", 0, initial_tabling_c);
+  define_c_mod_predicate(module, "$gen_tree_backtracking", 0, gen_tree_backtracking_c);
+  define_c_mod_predicate(module, "$pop_ptcp", 0, pop_ptcp_c);
+  define_c_mod_predicate(module, "$push_ptcp", 1, push_ptcp_c);
+  define_c_mod_predicate(module, "lookup_attr_call", 5, lookup_attr_call_c);
+  define_c_mod_predicate(module, "reinstall_gen_space", 2, reinstall_gen_space_c);
+  define_c_mod_predicate(module, "consume_attr_answer", 2, consume_attr_answer_c);
+  define_c_mod_predicate(module, "set_tabling_flag", 2, set_tabling_flag_c);
+  define_c_mod_predicate(module, "current_tabling_flag", 2, current_tabling_flag_c);
+  define_c_mod_predicate(module, "tabling_stats", 0, tabling_stats_c);
+}
+
+void tabling_rt_end(char *module) {
+  undefine_c_mod_predicate(module, "abolish_all_tables", 0);
+  undefine_c_mod_predicate(module, "tabled_call", 1);
+  undefine_c_mod_predicate(module, "new_answer", 0);
+  undefine_c_mod_predicate(module, "lookup_trie", 3);
+  undefine_c_mod_predicate(module, "execute_call", 4);
+  undefine_c_mod_predicate(module, "consume_answer", 4);
+  undefine_c_mod_predicate(module, "new_answer_attr", 0);
+  undefine_c_mod_predicate(module, "initial_tabling", 0);
+  undefine_c_mod_predicate(module, "$gen_tree_backtracking", 0);
+  undefine_c_mod_predicate(module, "$pop_ptcp", 0);
+  undefine_c_mod_predicate(module, "$push_ptcp", 1);
+  undefine_c_mod_predicate(module, "lookup_attr_call", 5);
+  undefine_c_mod_predicate(module, "reinstall_gen_space", 2);
+  undefine_c_mod_predicate(module, "consume_attr_answer", 2);
+  undefine_c_mod_predicate(module, "set_tabling_flag", 2);
+  undefine_c_mod_predicate(module, "current_tabling_flag", 2);
+  undefine_c_mod_predicate(module, "tabling_stats", 0);
+}
+
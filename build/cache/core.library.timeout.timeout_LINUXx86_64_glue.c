@@ -0,0 +1,126 @@
+#include <ciao/ciao_gluecode.h>
+
+void *init_alarm(int, void *);
+bool_t gluecode_init_alarm_c(worker_t *w) {
+  ERR__FUNCTOR("timeout:init_alarm_c", 3);
+  ciao_term t0;
+  ciao_term t1;
+  ciao_term t2;
+  int c0;
+  void *c1;
+  void *c2;
+  ciao_term u2;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  t1 = ciao_ref(ctx, X(1));
+  t2 = ciao_ref(ctx, X(2));
+  if (!ciao_is_integer_s(ctx, t0)) ERROR_IN_ARG(X(0), 0 + 1, ERR_type_error(integer));
+  if (!ciao_is_address(ctx, t1)) USAGE_FAULT("foreign interface: pointer conversion received ill argument (needed $address/1)");
+  c0 = ciao_get_c_int_s(ctx, t0);
+  c1 = ciao_address_to_pointer(ctx, t1);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c2 = init_alarm(c0, c1));
+  u2 = ciao_pointer_to_address(ctx, c2);
+  if (!ciao_unify_s(ctx, u2, t2)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+int start_alarm(void *);
+bool_t gluecode_start_alarm_c(worker_t *w) {
+  ERR__FUNCTOR("timeout:start_alarm_c", 2);
+  ciao_term t0;
+  ciao_term t1;
+  void *c0;
+  int c1;
+  ciao_term u1;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  t1 = ciao_ref(ctx, X(1));
+  if (!ciao_is_address(ctx, t0)) USAGE_FAULT("foreign interface: pointer conversion received ill argument (needed $address/1)");
+  c0 = ciao_address_to_pointer(ctx, t0);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c1 = start_alarm(c0));
+  u1 = ciao_mk_c_int_s(ctx, c1);
+  if (!ciao_unify_s(ctx, u1, t1)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+void stop_alarm(void *);
+bool_t gluecode_stop_alarm_c(worker_t *w) {
+  ERR__FUNCTOR("timeout:stop_alarm_c", 1);
+  ciao_term t0;
+  void *c0;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  if (!ciao_is_address(ctx, t0)) USAGE_FAULT("foreign interface: pointer conversion received ill argument (needed $address/1)");
+  c0 = ciao_address_to_pointer(ctx, t0);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(stop_alarm(c0));
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+int alarm_stat(void *);
+bool_t gluecode_alarm_stat_c(worker_t *w) {
+  ERR__FUNCTOR("timeout:alarm_stat_c", 2);
+  ciao_term t0;
+  ciao_term t1;
+  void *c0;
+  int c1;
+  ciao_term u1;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  t1 = ciao_ref(ctx, X(1));
+  if (!ciao_is_address(ctx, t0)) USAGE_FAULT("foreign interface: pointer conversion received ill argument (needed $address/1)");
+  c0 = ciao_address_to_pointer(ctx, t0);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(c1 = alarm_stat(c0));
+  u1 = ciao_mk_c_int_s(ctx, c1);
+  if (!ciao_unify_s(ctx, u1, t1)) return FALSE;
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+void release_alarms(void *);
+bool_t gluecode_release_alarms_c(worker_t *w) {
+  ERR__FUNCTOR("timeout:release_alarms_c", 1);
+  ciao_term t0;
+  void *c0;
+  CiaoDeclCtx(ctx);
+  CiaoInitCtx(ctx);
+  ciao_frame_begin_s(ctx);
+  t0 = ciao_ref(ctx, X(0));
+  if (!ciao_is_address(ctx, t0)) USAGE_FAULT("foreign interface: pointer conversion received ill argument (needed $address/1)");
+  c0 = ciao_address_to_pointer(ctx, t0);
+  CiaoSetImplicitCtx(ctx);
+  GLUECODE_TRY(release_alarms(c0));
+  ciao_frame_end_s(ctx);
+  return TRUE;
+}
+
+void timeout_init(char *module) {
+  define_c_mod_predicate(module, "init_alarm_c", 3, gluecode_init_alarm_c);
+  define_c_mod_predicate(module, "start_alarm_c", 2, gluecode_start_alarm_c);
+  define_c_mod_predicate(module, "stop_alarm_c", 1, gluecode_stop_alarm_c);
+  define_c_mod_predicate(module, "alarm_stat_c", 2, gluecode_alarm_stat_c);
+  define_c_mod_predicate(module, "release_alarms_c", 1, gluecode_release_alarms_c);
+}
+
+void timeout_end(char *module) {
+  undefine_c_mod_predicate(module, "init_alarm_c", 3);
+  undefine_c_mod_predicate(module, "start_alarm_c", 2);
+  undefine_c_mod_predicate(module, "stop_alarm_c", 1);
+  undefine_c_mod_predicate(module, "alarm_stat_c", 2);
+  undefine_c_mod_predicate(module, "release_alarms_c", 1);
+}
+
@@ -0,0 +1,570 @@
+/***************************************************************************/
+/*                             WARNING!!!                                  */
+/*                      D O   N O T   M O D I F Y                          */
+/*                This file is autogenerated by emugen                     */
+/***************************************************************************/
+
+#define INS_OPCOUNT 263
+#define Fs(Ty) FTYPE_size(Ty)
+absmachdef_t abscurr= {
+.ftype_id_i = 10,
+.ftype_id_o = 15,
+.ins_info = (ftype_base_t *[]){
+FTYPE_STR(3,BRACES(19,6,8)),
+FTYPE_STR(2,BRACES(6,8)),
+FTYPE_STR(3,BRACES(19,6,8)),
+FTYPE_STR(2,BRACES(6,8)),
+FTYPE_STR(4,BRACES(19,17,6,8)),
+FTYPE_STR(3,BRACES(17,6,8)),
+FTYPE_STR(5,BRACES(19,17,17,6,8)),
+FTYPE_STR(4,BRACES(17,17,6,8)),
+FTYPE_STR(6,BRACES(19,17,17,17,6,8)),
+FTYPE_STR(5,BRACES(17,17,17,6,8)),
+FTYPE_STR(7,BRACES(19,17,17,17,17,6,8)),
+FTYPE_STR(6,BRACES(17,17,17,17,6,8)),
+FTYPE_STR(8,BRACES(19,17,17,17,17,17,6,8)),
+FTYPE_STR(7,BRACES(17,17,17,17,17,6,8)),
+FTYPE_STR(9,BRACES(19,17,17,17,17,17,17,6,8)),
+FTYPE_STR(8,BRACES(17,17,17,17,17,17,6,8)),
+FTYPE_STR(10,BRACES(19,17,17,17,17,17,17,17,6,8)),
+FTYPE_STR(9,BRACES(17,17,17,17,17,17,17,6,8)),
+FTYPE_STR(11,BRACES(19,17,17,17,17,17,17,17,17,6,8)),
+FTYPE_STR(10,BRACES(17,17,17,17,17,17,17,17,6,8)),
+FTYPE_STR(4,BRACES(19,3,6,8)),
+FTYPE_STR(3,BRACES(3,6,8)),
+FTYPE_STR(3,BRACES(19,6,8)),
+FTYPE_STR(2,BRACES(6,8)),
+FTYPE_STR(4,BRACES(19,18,6,8)),
+FTYPE_STR(3,BRACES(18,6,8)),
+FTYPE_STR(5,BRACES(19,18,18,6,8)),
+FTYPE_STR(4,BRACES(18,18,6,8)),
+FTYPE_STR(6,BRACES(19,18,18,18,6,8)),
+FTYPE_STR(5,BRACES(18,18,18,6,8)),
+FTYPE_STR(7,BRACES(19,18,18,18,18,6,8)),
+FTYPE_STR(6,BRACES(18,18,18,18,6,8)),
+FTYPE_STR(8,BRACES(19,18,18,18,18,18,6,8)),
+FTYPE_STR(7,BRACES(18,18,18,18,18,6,8)),
+FTYPE_STR(9,BRACES(19,18,18,18,18,18,18,6,8)),
+FTYPE_STR(8,BRACES(18,18,18,18,18,18,6,8)),
+FTYPE_STR(10,BRACES(19,18,18,18,18,18,18,18,6,8)),
+FTYPE_STR(9,BRACES(18,18,18,18,18,18,18,6,8)),
+FTYPE_STR(11,BRACES(19,18,18,18,18,18,18,18,18,6,8)),
+FTYPE_STR(10,BRACES(18,18,18,18,18,18,18,18,6,8)),
+FTYPE_STR(4,BRACES(19,4,6,8)),
+FTYPE_STR(3,BRACES(4,6,8)),
+FTYPE_STR(2,BRACES(19,6)),
+FTYPE_STR(1,BRACES(6)),
+FTYPE_STR(3,BRACES(19,18,6)),
+FTYPE_STR(2,BRACES(18,6)),
+FTYPE_STR(4,BRACES(19,18,18,6)),
+FTYPE_STR(3,BRACES(18,18,6)),
+FTYPE_STR(5,BRACES(19,18,18,18,6)),
+FTYPE_STR(4,BRACES(18,18,18,6)),
+FTYPE_STR(6,BRACES(19,18,18,18,18,6)),
+FTYPE_STR(5,BRACES(18,18,18,18,6)),
+FTYPE_STR(7,BRACES(19,18,18,18,18,18,6)),
+FTYPE_STR(6,BRACES(18,18,18,18,18,6)),
+FTYPE_STR(8,BRACES(19,18,18,18,18,18,18,6)),
+FTYPE_STR(7,BRACES(18,18,18,18,18,18,6)),
+FTYPE_STR(9,BRACES(19,18,18,18,18,18,18,18,6)),
+FTYPE_STR(8,BRACES(18,18,18,18,18,18,18,6)),
+FTYPE_STR(10,BRACES(19,18,18,18,18,18,18,18,18,6)),
+FTYPE_STR(9,BRACES(18,18,18,18,18,18,18,18,6)),
+FTYPE_STR(3,BRACES(19,4,6)),
+FTYPE_STR(2,BRACES(4,6)),
+FTYPE_STR(2,BRACES(19,6)),
+FTYPE_STR(1,BRACES(6)),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR(1,BRACES(10)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(3,BRACES(19,16,14)),
+FTYPE_STR(2,BRACES(16,14)),
+FTYPE_STR(3,BRACES(19,16,9)),
+FTYPE_STR(2,BRACES(16,9)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(4,BRACES(16,16,16,16)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(3,BRACES(19,16,14)),
+FTYPE_STR(2,BRACES(16,14)),
+FTYPE_STR(3,BRACES(19,16,9)),
+FTYPE_STR(2,BRACES(16,9)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(2,BRACES(19,14)),
+FTYPE_STR(1,BRACES(14)),
+FTYPE_STR(2,BRACES(19,9)),
+FTYPE_STR(1,BRACES(9)),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR(4,BRACES(16,16,16,16)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(4,BRACES(16,17,16,17)),
+FTYPE_STR(3,BRACES(19,16,14)),
+FTYPE_STR(2,BRACES(16,14)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(10)),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(2,BRACES(19,14)),
+FTYPE_STR(1,BRACES(14)),
+FTYPE_STR(2,BRACES(19,9)),
+FTYPE_STR(1,BRACES(9)),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR(2,BRACES(19,14)),
+FTYPE_STR(1,BRACES(14)),
+FTYPE_STR0(),
+FTYPE_STR(2,BRACES(10,16)),
+FTYPE_STR(2,BRACES(10,16)),
+FTYPE_STR(2,BRACES(10,16)),
+FTYPE_STR(2,BRACES(10,17)),
+FTYPE_STR(2,BRACES(10,17)),
+FTYPE_STR(2,BRACES(10,17)),
+FTYPE_STR(2,BRACES(10,17)),
+FTYPE_STR(2,BRACES(10,17)),
+FTYPE_STR(2,BRACES(16,10)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(17,10)),
+FTYPE_STR(2,BRACES(17,10)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(16,10)),
+FTYPE_STR(2,BRACES(16,10)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,16)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(16,17)),
+FTYPE_STR(2,BRACES(17,10)),
+FTYPE_STR(2,BRACES(17,10)),
+FTYPE_STR(2,BRACES(17,10)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,16)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(2,BRACES(17,17)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR0(),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR0(),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR0(),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR0(),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(1,BRACES(17)),
+FTYPE_STR(5,BRACES(19,16,16,5,12)),
+FTYPE_STR(4,BRACES(16,16,5,12)),
+FTYPE_STR(6,BRACES(19,16,16,16,5,12)),
+FTYPE_STR(5,BRACES(16,16,16,5,12)),
+FTYPE_STR(3,BRACES(19,16,5)),
+FTYPE_STR(2,BRACES(16,5)),
+FTYPE_STR(4,BRACES(19,16,16,5)),
+FTYPE_STR(3,BRACES(16,16,5)),
+FTYPE_STR(5,BRACES(19,16,16,16,5)),
+FTYPE_STR(4,BRACES(16,16,16,5)),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR(2,BRACES(19,5)),
+FTYPE_STR(1,BRACES(5)),
+FTYPE_STR0(),
+FTYPE_STR(5,BRACES(19,16,16,5,12)),
+FTYPE_STR(4,BRACES(16,16,5,12)),
+FTYPE_STR(6,BRACES(19,16,16,16,5,12)),
+FTYPE_STR(5,BRACES(16,16,16,5,12)),
+FTYPE_STR0(),
+FTYPE_STR(2,BRACES(19,12)),
+FTYPE_STR(1,BRACES(12)),
+FTYPE_STR(1,BRACES(16)),
+FTYPE_STR(2,BRACES(19,11)),
+FTYPE_STR(1,BRACES(11)),
+FTYPE_STR(3,BRACES(19,11,11)),
+FTYPE_STR(2,BRACES(11,11)),
+FTYPE_STR(3,BRACES(19,16,7)),
+FTYPE_STR(2,BRACES(16,7)),
+FTYPE_STR(3,BRACES(19,16,7)),
+FTYPE_STR(2,BRACES(16,7)),
+FTYPE_STR(2,BRACES(19,7)),
+FTYPE_STR(1,BRACES(7)),
+FTYPE_STR(2,BRACES(19,7)),
+FTYPE_STR(1,BRACES(7)),
+FTYPE_STR(1,BRACES(8)),
+FTYPE_STR(2,BRACES(3,8)),
+FTYPE_STR0()}
+,
+.ins_n = 263,
+.ftype_info = (ftype_base_t *[]){
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_STR0(),
+FTYPE_ARRAY(10,17),
+FTYPE_ARRAY(10,18),
+FTYPE_BASIC(Fs(f_C),9,6),
+FTYPE_BASIC(Fs(f_E),7,6),
+FTYPE_BLOB(),
+FTYPE_BASIC(Fs(f_e),8,8),
+FTYPE_BASIC(Fs(f_f),5,6),
+FTYPE_BASIC(Fs(f_i),8,8),
+FTYPE_BASIC(Fs(f_l),2,6),
+FTYPE_STR(2,BRACES(11,10)),
+FTYPE_BASIC(Fs(f_p),3,3),
+FTYPE_BASIC(Fs(f_t),6,6),
+FTYPE_BASIC(Fs(f_o),8,8),
+FTYPE_BASIC(Fs(f_x),8,8),
+FTYPE_BASIC(Fs(f_y),8,8),
+FTYPE_BASIC(Fs(f_z),8,8),
+FTYPE_BASIC(Fs(f_Q),8,8)}
+,
+.ftype_n = 20,
+.q_pad1 = 128*4,
+.q_pad2 = 1152*4,
+.tagged_size = sizeof(tagged_t),
+.size_align = sizeof(tagged_t)
+};
+char *ins_name[263] = {
+"q+alloc_init_fcall(f_E,f_e)",
+"alloc_init_fcall(f_E,f_e)",
+"q+fcall(f_E,f_e)",
+"fcall(f_E,f_e)",
+"q+init(s(1))+fcall(f_E,f_e)",
+"init(s(1))+fcall(f_E,f_e)",
+"q+init(s(2))+fcall(f_E,f_e)",
+"init(s(2))+fcall(f_E,f_e)",
+"q+init(s(3))+fcall(f_E,f_e)",
+"init(s(3))+fcall(f_E,f_e)",
+"q+init(s(4))+fcall(f_E,f_e)",
+"init(s(4))+fcall(f_E,f_e)",
+"q+init(s(5))+fcall(f_E,f_e)",
+"init(s(5))+fcall(f_E,f_e)",
+"q+init(s(6))+fcall(f_E,f_e)",
+"init(s(6))+fcall(f_E,f_e)",
+"q+init(s(7))+fcall(f_E,f_e)",
+"init(s(7))+fcall(f_E,f_e)",
+"q+init(s(8))+fcall(f_E,f_e)",
+"init(s(8))+fcall(f_E,f_e)",
+"q+init(f_Y)+fcall(f_E,f_e)",
+"init(f_Y)+fcall(f_E,f_e)",
+"q+kall(f_E,f_e)",
+"kall(f_E,f_e)",
+"q+zputn(s(1))+kall(f_E,f_e)",
+"zputn(s(1))+kall(f_E,f_e)",
+"q+zputn(s(2))+kall(f_E,f_e)",
+"zputn(s(2))+kall(f_E,f_e)",
+"q+zputn(s(3))+kall(f_E,f_e)",
+"zputn(s(3))+kall(f_E,f_e)",
+"q+zputn(s(4))+kall(f_E,f_e)",
+"zputn(s(4))+kall(f_E,f_e)",
+"q+zputn(s(5))+kall(f_E,f_e)",
+"zputn(s(5))+kall(f_E,f_e)",
+"q+zputn(s(6))+kall(f_E,f_e)",
+"zputn(s(6))+kall(f_E,f_e)",
+"q+zputn(s(7))+kall(f_E,f_e)",
+"zputn(s(7))+kall(f_E,f_e)",
+"q+zputn(s(8))+kall(f_E,f_e)",
+"zputn(s(8))+kall(f_E,f_e)",
+"q+zputn(f_Z)+kall(f_E,f_e)",
+"zputn(f_Z)+kall(f_E,f_e)",
+"q+deallocate+execute(f_E)",
+"deallocate+execute(f_E)",
+"q+zputn(s(1))+deallocate+execute(f_E)",
+"zputn(s(1))+deallocate+execute(f_E)",
+"q+zputn(s(2))+deallocate+execute(f_E)",
+"zputn(s(2))+deallocate+execute(f_E)",
+"q+zputn(s(3))+deallocate+execute(f_E)",
+"zputn(s(3))+deallocate+execute(f_E)",
+"q+zputn(s(4))+deallocate+execute(f_E)",
+"zputn(s(4))+deallocate+execute(f_E)",
+"q+zputn(s(5))+deallocate+execute(f_E)",
+"zputn(s(5))+deallocate+execute(f_E)",
+"q+zputn(s(6))+deallocate+execute(f_E)",
+"zputn(s(6))+deallocate+execute(f_E)",
+"q+zputn(s(7))+deallocate+execute(f_E)",
+"zputn(s(7))+deallocate+execute(f_E)",
+"q+zputn(s(8))+deallocate+execute(f_E)",
+"zputn(s(8))+deallocate+execute(f_E)",
+"q+zputn(f_Z)+deallocate+execute(f_E)",
+"zputn(f_Z)+deallocate+execute(f_E)",
+"q+execute(f_E)",
+"execute(f_E)",
+"proceed",
+"neck",
+"neck_proceed",
+"failins",
+"branch(f_i)",
+"inith(f_x)",
+"init2h(f_x,f_x)",
+"revmove(f_x,f_x)",
+"revglob2(f_x,f_x)",
+"alloc+init2s(f_x,f_y)",
+"init2s(f_x,f_y)",
+"revmove(f_x,f_y)",
+"revglob(f_x,f_y)",
+"q+ld_cons(f_x,f_t)",
+"ld_cons(f_x,f_t)",
+"q+ld_str(f_x,f_f)",
+"ld_str(f_x,f_f)",
+"ld_cons_nil(f_x)",
+"ld_lst(f_x)",
+"alloc+init2s(f_x,f_y)+init2s(f_x,f_y)",
+"init2s(f_x,f_y)+init2s(f_x,f_y)",
+"revmove(f_x,f_x)+revmove(f_x,f_x)",
+"revmove(f_x,f_y)+revmove(f_x,f_y)",
+"revmove(f_x,f_y)+revglob(f_x,f_y)",
+"revglob(f_x,f_y)+revmove(f_x,f_y)",
+"revglob(f_x,f_y)+revglob(f_x,f_y)",
+"move(f_x,f_x)",
+"u_val(f_x,f_x)",
+"alloc+move(f_x,f_y)",
+"move(f_x,f_y)",
+"u_fval(f_x,f_y)",
+"u_val(f_x,f_y)",
+"q+u_cons(f_x,f_t)",
+"u_cons(f_x,f_t)",
+"q+u_str(f_x,f_f)",
+"u_str(f_x,f_f)",
+"u_nil(f_x)",
+"u_lst(f_x)",
+"q+u_cons_x0(f_t)",
+"u_cons_x0(f_t)",
+"q+u_str_x0(f_f)",
+"u_str_x0(f_f)",
+"u_nil_x0",
+"u_list_x0",
+"move(f_x,f_x)+move(f_x,f_x)",
+"alloc+move(f_x,f_y)+move(f_x,f_y)",
+"move(f_x,f_y)+move(f_x,f_y)",
+"get_constant_neck_proceedq",
+"get_constant_neck_proceed",
+"get_nil_neck_proceed",
+"unify_void(f_i)",
+"unify_void(1)",
+"unify_void(2)",
+"unify_void(3)",
+"unify_void(4)",
+"un_var(f_x)",
+"un_val(f_x)",
+"un_lval(f_x)",
+"alloc+un_var(f_y)",
+"un_var(f_y)",
+"un_fval(f_y)",
+"un_val(f_y)",
+"un_lval(f_y)",
+"q+un_cons(f_t)",
+"un_cons(f_t)",
+"q+un_str(f_f)",
+"un_str(f_f)",
+"un_nil",
+"un_lst",
+"unify_constant_neck_proceedq",
+"unify_constant_neck_proceed",
+"unify_nil_neck_proceed",
+"un_voidr(f_i)+un_var(f_x)",
+"un_voidr(f_i)+un_val(f_x)",
+"un_voidr(f_i)+un_lval(f_x)",
+"alloc+un_voidr(f_i)+un_var(f_y)",
+"un_voidr(f_i)+un_var(f_y)",
+"un_voidr(f_i)+un_fval(f_y)",
+"un_voidr(f_i)+un_val(f_y)",
+"un_voidr(f_i)+un_lval(f_y)",
+"un_var(f_x)+un_voidr(f_i)",
+"un_var(f_x)+un_var(f_x)",
+"un_var(f_x)+un_val(f_x)",
+"un_var(f_x)+un_lval(f_x)",
+"alloc+un_var(f_x)+un_var(f_y)",
+"un_var(f_x)+un_var(f_y)",
+"un_var(f_x)+un_fval(f_y)",
+"un_var(f_x)+un_val(f_y)",
+"un_var(f_x)+un_lval(f_y)",
+"alloc+un_var(f_y)+un_voidr(f_i)",
+"un_var(f_y)+un_voidr(f_i)",
+"alloc+un_var(f_y)+un_var(f_x)",
+"un_var(f_y)+un_var(f_x)",
+"alloc+un_var(f_y)+un_var(f_y)",
+"un_var(f_y)+un_var(f_y)",
+"alloc+un_var(f_y)+un_val(f_x)",
+"un_var(f_y)+un_val(f_x)",
+"alloc+un_var(f_y)+un_lval(f_x)",
+"un_var(f_y)+un_lval(f_x)",
+"alloc+un_var(f_y)+un_val(f_y)",
+"un_var(f_y)+un_val(f_y)",
+"alloc+un_var(f_y)+un_lval(f_y)",
+"un_var(f_y)+un_lval(f_y)",
+"un_val(f_x)+un_voidr(f_i)",
+"un_lval(f_x)+un_voidr(f_i)",
+"un_val(f_x)+un_var(f_x)",
+"un_lval(f_x)+un_var(f_x)",
+"alloc+un_val(f_x)+un_var(f_y)",
+"alloc+un_lval(f_x)+un_var(f_y)",
+"un_val(f_x)+un_var(f_y)",
+"un_lval(f_x)+un_var(f_y)",
+"un_val(f_x)+un_val(f_x)",
+"un_lval(f_x)+un_val(f_x)",
+"un_val(f_x)+un_lval(f_x)",
+"un_lval(f_x)+un_lval(f_x)",
+"un_val(f_x)+un_fval(f_y)",
+"un_lval(f_x)+un_fval(f_y)",
+"un_val(f_x)+un_val(f_y)",
+"un_lval(f_x)+un_val(f_y)",
+"un_val(f_x)+un_lval(f_y)",
+"un_lval(f_x)+un_lval(f_y)",
+"un_fval(f_y)+un_voidr(f_i)",
+"un_val(f_y)+un_voidr(f_i)",
+"un_lval(f_y)+un_voidr(f_i)",
+"un_fval(f_y)+un_var(f_x)",
+"un_val(f_y)+un_var(f_x)",
+"un_lval(f_y)+un_var(f_x)",
+"un_val(f_y)+un_var(f_y)",
+"un_lval(f_y)+un_var(f_y)",
+"un_fval(f_y)+un_val(f_x)",
+"un_val(f_y)+un_val(f_x)",
+"un_lval(f_y)+un_val(f_x)",
+"un_fval(f_y)+un_lval(f_x)",
+"un_val(f_y)+un_lval(f_x)",
+"un_lval(f_y)+un_lval(f_x)",
+"un_fval(f_y)+un_fval(f_y)",
+"un_val(f_y)+un_fval(f_y)",
+"un_lval(f_y)+un_fval(f_y)",
+"un_fval(f_y)+un_val(f_y)",
+"un_val(f_y)+un_val(f_y)",
+"un_lval(f_y)+un_val(f_y)",
+"un_fval(f_y)+un_lval(f_y)",
+"un_val(f_y)+un_lval(f_y)",
+"un_lval(f_y)+un_lval(f_y)",
+"cutb(f_x)",
+"cutf",
+"cutb_x_neck",
+"cutb_neck",
+"cutb_x_neck_proceed",
+"cutb_neck_proceed",
+"cute(f_x)",
+"cutf_x",
+"cute_x_neck",
+"cute_neck",
+"cutf(f_y)",
+"getchoice(f_x)",
+"alloc+getchoice(f_y)",
+"getchoice(f_y)",
+"q+function_1(f_x,f_x,f_C,f_g)",
+"function_1(f_x,f_x,f_C,f_g)",
+"q+function_2(f_x,f_x,f_x,f_C,f_g)",
+"function_2(f_x,f_x,f_x,f_C,f_g)",
+"q+builtin_1(f_x,f_C)",
+"builtin_1(f_x,f_C)",
+"q+builtin_2(f_x,f_x,f_C)",
+"builtin_2(f_x,f_x,f_C)",
+"q+builtin_3(f_x,f_x,f_x,f_C)",
+"builtin_3(f_x,f_x,f_x,f_C)",
+"retry_instance",
+"kontinue",
+"leave",
+"exit_toplevel",
+"dynamic_neck_proceed",
+"q+retry_c(f_C)+proceed",
+"retry_c(f_C)+proceed",
+"(none)",
+"q+builtin_2_env(f_x,f_x,f_C,f_g)",
+"builtin_2_env(f_x,f_x,f_C,f_g)",
+"q+builtin_3_env(f_x,f_x,f_x,f_C,f_g)",
+"builtin_3_env(f_x,f_x,f_x,f_C,f_g)",
+"(none)",
+"q+heapmargin_call(f_g)",
+"heapmargin_call(f_g)",
+"u_constraint(f_x)",
+"q+bump_counter(f_l)",
+"bump_counter(f_l)",
+"counted_neckq",
+"counted_neck",
+"q+ld_blob(f_x,f_b)",
+"ld_blob(f_x,f_b)",
+"q+u_blob(f_x,f_b)",
+"u_blob(f_x,f_b)",
+"q+u_blob_x0(f_b)",
+"u_blob_x0(f_b)",
+"q+un_blob(f_b)",
+"un_blob(f_b)",
+"alloc_init_cframe(f_e)",
+"init(f_Y)+cframe(f_e)",
+"restart_point"}
+;
@@ -0,0 +1 @@
+/root/repo/core/engine/bc_aux.h
\ No newline at end of file
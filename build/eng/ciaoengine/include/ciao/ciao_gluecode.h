@@ -0,0 +1 @@
+/root/repo/core/engine/ciao_gluecode.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/configure.EMSCRIPTENwasm32.h
\ No newline at end of file
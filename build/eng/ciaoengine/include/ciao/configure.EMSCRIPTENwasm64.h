@@ -0,0 +1 @@
+/root/repo/core/engine/configure.EMSCRIPTENwasm64.h
\ No newline at end of file
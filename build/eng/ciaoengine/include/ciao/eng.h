@@ -0,0 +1 @@
+/root/repo/core/engine/eng.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_bignum.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_interrupt.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_jit.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_numarray.h
\ No newline at end of file
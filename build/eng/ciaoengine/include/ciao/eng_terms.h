@@ -0,0 +1 @@
+/root/repo/core/engine/eng_terms.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/gauge.h
\ No newline at end of file
@@ -0,0 +1,57 @@
+/***************************************************************************/
+/*                             WARNING!!!                                  */
+/*                      D O   N O T   M O D I F Y                          */
+/*                This file is autogenerated by emugen                     */
+/***************************************************************************/
+
+#define CALLQ 22
+#define CALL 23
+#define LASTCALLQ 42
+#define LASTCALL 43
+#define EXECUTEQ 62
+#define EXECUTE 63
+#define GET_X_VALUE 91
+#define GET_CONSTANTQ 96
+#define GET_CONSTANT 97
+#define GET_LARGEQ 254
+#define GET_LARGE 255
+#define GET_STRUCTUREQ 98
+#define GET_STRUCTURE 99
+#define GET_NIL 100
+#define GET_LIST 101
+#define KONTINUE 233
+#define EXIT_TOPLEVEL 235
+#define RETRY_CQ 237
+#define RETRY_C 238
+#define GET_STRUCTURE_X0Q 104
+#define GET_STRUCTURE_X0 105
+#define GET_CONSTANT_X0Q 102
+#define GET_CONSTANT_X0 103
+#define GET_NIL_X0 106
+#define GET_LIST_X0 107
+#define GET_X_VARIABLE 90
+#define BRANCH 68
+#define RETRY_INSTANCE 232
+#define GET_CONSTRAINT 247
+#define UNIFY_VOID 114
+#define UNIFY_VOID_1 115
+#define UNIFY_VOID_2 116
+#define UNIFY_VOID_3 117
+#define UNIFY_VOID_4 118
+#define UNIFY_X_VARIABLE 119
+#define UNIFY_X_VALUE 120
+#define UNIFY_CONSTANTQ 127
+#define UNIFY_CONSTANT 128
+#define UNIFY_LARGEQ 258
+#define UNIFY_LARGE 259
+#define UNIFY_STRUCTUREQ 129
+#define UNIFY_STRUCTURE 130
+#define UNIFY_NIL 131
+#define UNIFY_LIST 132
+#define FAIL 67
+#define HEAPMARGIN_CALLQ 245
+#define HEAPMARGIN_CALL 246
+#define DYNAMIC_NECK_PROCEED 236
+#if defined(PARBACK)
+#define RESTART_POINT 262
+#endif
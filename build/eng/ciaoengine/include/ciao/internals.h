@@ -0,0 +1 @@
+/root/repo/core/engine/internals.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/io_format.h
\ No newline at end of file
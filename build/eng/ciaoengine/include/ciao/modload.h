@@ -0,0 +1 @@
+/root/repo/core/engine/modload.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/os_defs.h
\ No newline at end of file
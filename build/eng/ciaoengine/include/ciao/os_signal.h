@@ -0,0 +1 @@
+/root/repo/core/engine/os_signal.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/own_mmap.h
\ No newline at end of file
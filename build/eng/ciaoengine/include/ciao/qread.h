@@ -0,0 +1 @@
+/root/repo/core/engine/qread.h
\ No newline at end of file
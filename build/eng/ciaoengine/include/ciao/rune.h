@@ -0,0 +1 @@
+/root/repo/core/engine/rune.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/runtime_control.h
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/support.h
\ No newline at end of file
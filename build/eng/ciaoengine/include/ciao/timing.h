@@ -0,0 +1 @@
+/root/repo/core/engine/timing.h
\ No newline at end of file
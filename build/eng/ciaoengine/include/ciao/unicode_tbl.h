@@ -0,0 +1 @@
+/root/repo/core/engine/unicode_tbl.h
\ No newline at end of file
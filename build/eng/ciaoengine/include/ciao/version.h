@@ -0,0 +1,7 @@
+#ifndef _CIAO_VERSION_H
+#define _CIAO_VERSION_H
+#define CIAO_VERSION_STRING "Ciao " "1.25-master-g10861ca" " (" "2026-10-19 10:57:51 +0000" ")"
+#define CIAO_MAJOR_VERSION 1
+#define CIAO_MINOR_VERSION 25
+#define CIAO_PATCH_NUMBER 0
+#endif /* _CIAO_VERSION_H */
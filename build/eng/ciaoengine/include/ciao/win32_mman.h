@@ -0,0 +1 @@
+/root/repo/core/engine/win32_mman.h
\ No newline at end of file
@@ -0,0 +1,17 @@
+char *eng_architecture = "x86_64";
+char *eng_os = "LINUX";
+char *exec_suffix = "";
+char *so_suffix = ".so";
+
+char *eng_debug_level = "nodebug";
+
+int eng_is_sharedlib = 0;
+char *ciao_suffix = "";
+
+char *default_ciaoroot = "/root/repo";
+char *default_c_headers_dir = "/root/repo/build/eng/ciaoengine/include";
+
+char *foreign_opts_cc = "gcc";
+char *foreign_opts_ld = "gcc";
+char *foreign_opts_ccshared = " -fPIC ";
+char *foreign_opts_ldshared = " -shared ";
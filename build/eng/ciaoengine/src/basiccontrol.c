@@ -0,0 +1 @@
+/root/repo/core/engine/basiccontrol.c
\ No newline at end of file
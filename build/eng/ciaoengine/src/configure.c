@@ -0,0 +1 @@
+/root/repo/core/engine/configure.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/configure_main.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/debugger_support.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/dtoa_ryu.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/dynamic_rt.c
\ No newline at end of file
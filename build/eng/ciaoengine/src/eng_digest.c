@@ -0,0 +1 @@
+/root/repo/core/engine/eng_digest.c
\ No newline at end of file
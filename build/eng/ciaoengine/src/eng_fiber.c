@@ -0,0 +1 @@
+/root/repo/core/engine/eng_fiber.c
\ No newline at end of file
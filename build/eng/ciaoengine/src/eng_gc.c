@@ -0,0 +1 @@
+/root/repo/core/engine/eng_gc.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/eng_interrupt.c
\ No newline at end of file
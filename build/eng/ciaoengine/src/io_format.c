@@ -0,0 +1 @@
+/root/repo/core/engine/io_format.c
\ No newline at end of file
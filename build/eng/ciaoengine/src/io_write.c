@@ -0,0 +1 @@
+/root/repo/core/engine/io_write.c
\ No newline at end of file
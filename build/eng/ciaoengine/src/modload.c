@@ -0,0 +1 @@
+/root/repo/core/engine/modload.c
\ No newline at end of file
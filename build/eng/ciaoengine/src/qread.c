@@ -0,0 +1 @@
+/root/repo/core/engine/qread.c
\ No newline at end of file
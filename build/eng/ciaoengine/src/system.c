@@ -0,0 +1 @@
+/root/repo/core/engine/system.c
\ No newline at end of file
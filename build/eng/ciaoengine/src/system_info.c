@@ -0,0 +1 @@
+/root/repo/core/engine/system_info.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/term_compare.c
\ No newline at end of file
@@ -0,0 +1 @@
+/root/repo/core/engine/timing.c
\ No newline at end of file
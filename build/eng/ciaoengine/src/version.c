@@ -0,0 +1,6 @@
+char *ciao_version = "1.25";
+char *ciao_patch = "0";
+char *ciao_commit_branch = "master";
+char *ciao_commit_id = "10861ca758bd31480fa44aedc950c2652adda7c2";
+char *ciao_commit_date = "2026-10-19 10:57:51 +0000";
+char *ciao_commit_desc = "1.25-master-g10861ca";
@@ -0,0 +1,5985 @@
+/***************************************************************************/
+/*                             WARNING!!!                                  */
+/*                      D O   N O T   M O D I F Y                          */
+/*                This file is autogenerated by emugen                     */
+/***************************************************************************/
+
+extern instance_clock_t def_clock;
+extern instance_clock_t use_clock;
+#define BcOPCODE BcFetchOPCODE()
+#define BcP(Ty,X) ((*(FTYPE_ctype(Ty) *)BCoff(P,(X))))
+#define Fs(Ty) FTYPE_size(Ty)
+CVOID__PROTO(wam__2,goal_descriptor_t * desc,definition_t * start_func);
+CVOID__PROTO(wam,goal_descriptor_t * desc) {
+definition_t * func = (definition_t *)NULL;
+goto again;
+again:
+{
+EXCEPTION__CATCH({
+CVOID__CALL(wam__2, desc, func);
+return;
+}
+, {
+choice_t * b;
+if (!IsDeep()) {
+B = w->choice;
+if (!IsShallowTry()) {
+NECK_RETRY_PATCH(B);
+    }
+ else {
+B->next_alt = w->next_alt;
+B->frame = w->frame;
+B->next_insn = w->next_insn;
+B->local_top = w->local_top;
+intmach_t vr0 = ChoiceArity(B);
+for (intmach_t vr1 = 0;
+vr1<vr0;vr1++) {
+B->x[vr1] = w->x[vr1];
+      }
+
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+      }
+
+    }
+
+SetDeep();
+  }
+
+X(0) = MakeSmall(ErrCode);
+X(1) = GET_ATOM(ErrFuncName);
+X(2) = MakeSmall(ErrFuncArity);
+X(4) = Culprit;
+X(3) = MakeSmall(ErrArgNo);
+func = address_error;
+goto again;
+}
+);
+}
+}
+CVOID__PROTO(wam__2,goal_descriptor_t * desc,definition_t * start_func) {
+bcp_t p;
+try_node_t * alts;
+choice_t * b;
+frame_t * e;
+tagged_t * cached_r_h;
+tagged_t * r_s;
+intmach_t ei;
+bcp_t ptemp = NULL;
+alts = NULL;
+b = NULL;
+e = NULL;
+cached_r_h = NULL;
+r_s = NULL;
+ei = ~0;
+ON_DEBUG({
+if (debug_threads) {
+fprintf(stderr,"Worker state address is %p\n",desc);
+    }
+
+  }
+);
+if (start_func!=NULL) {
+P = (bcp_t)start_func;
+B = w->choice;
+H = w->heap_top;
+goto switch_on_pred;
+  }
+
+if (desc!=NULL&&desc->action&BACKTRACKING) {
+RECOVER_WAM_STATE;
+goto fail;
+  }
+
+goto r_op64;
+escape_to_p2:
+{
+tagged_t vr2;
+tagged_t vr3;
+vr2 = PointerToTerm(Func->code.intinfo);
+if (Func->arity==0) {
+vr3 = Func->printname;
+  }
+ else {
+vr3 = Tagp(STR,H);
+HeapPush(H,SetArity(Func->printname,Func->arity));
+for (intmach_t vr4 = 0;
+vr4<Func->arity;vr4++) {
+tagged_t vr5 = X(vr4);
+if (TaggedIsSVA(vr5)) {
+tagged_t vr6;
+do {
+RefSVA(vr6,vr5);
+if (vr6==vr5) {
+BindSVA(vr5,Tagp(HVA,H));
+PreLoadHVA(vr5,H);
+break;
+          }
+
+vr5 = vr6;
+        }
+ while (TaggedIsSVA(vr5));
+      }
+
+HeapPush(H,vr5);
+    }
+
+  }
+
+P = ptemp;
+X(0) = vr3;
+X(1) = vr2;
+goto switch_on_pred;
+  }
+escape_to_p:
+{
+tagged_t vr7;
+if (Func->arity==0) {
+vr7 = Func->printname;
+  }
+ else {
+vr7 = Tagp(STR,H);
+HeapPush(H,SetArity(Func->printname,Func->arity));
+for (intmach_t vr8 = 0;
+vr8<Func->arity;vr8++) {
+tagged_t vr9 = X(vr8);
+if (TaggedIsSVA(vr9)) {
+tagged_t vr10;
+do {
+RefSVA(vr10,vr9);
+if (vr10==vr9) {
+BindSVA(vr9,Tagp(HVA,H));
+PreLoadHVA(vr9,H);
+break;
+          }
+
+vr9 = vr10;
+        }
+ while (TaggedIsSVA(vr9));
+      }
+
+HeapPush(H,vr9);
+    }
+
+  }
+
+P = ptemp;
+X(0) = vr7;
+goto switch_on_pred;
+  }
+enter_predicate:
+{
+ON_ANDPARALLEL({
+if (Suspend==TOSUSPEND) {
+Suspend = SUSPENDED;
+Wait_Acquire_lock(Waiting_For_Work_Lock);
+Cond_Var_Wait(Waiting_For_Work_Cond_Var,Waiting_For_Work_Lock);
+Suspend = RELEASED;
+Release_lock(Waiting_For_Work_Lock);
+    }
+
+  }
+);
+if (TestEventOrHeapWarnOverflow(H)) {
+int wake_cnt;
+if (Stop_This_Goal(w)) {
+goto exit_toplevel;
+    }
+
+wake_cnt = WakeCount();
+if (HeapCharAvailable(H)<=CALLPAD+4*wake_cnt*sizeof(tagged_t)) {
+SETUP_PENDING_CALL(E,address_true);
+w->heap_top = H;
+heap_overflow(w,2*(CALLPAD+4*wake_cnt*sizeof(tagged_t)));
+H = w->heap_top;
+    }
+
+if (wake_cnt>0) {
+if (wake_cnt==1) {
+SETUP_PENDING_CALL(E,address_uvc);
+collect_one_pending_unification(w);
+tagged_t vr11;
+DEREF(vr11,X(1));
+if (TaggedIsCVA(vr11)) {
+X(1) = vr11;
+Setfunc(address_ucc);
+        }
+
+      }
+ else {
+SETUP_PENDING_CALL(E,address_pending_unifications);
+w->heap_top = H;
+collect_pending_unifications(w,wake_cnt);
+H = w->heap_top;
+      }
+
+    }
+
+if (OffStacktop(w->frame,Stack_Warn)) {
+SETUP_PENDING_CALL(E,address_true);
+stack_overflow(w);
+    }
+
+UnsetEvent();
+if (Yield_Request(w)) {
+w->misc->yield_request = FALSE;
+SETUP_PENDING_CALL(E,address_yield);
+    }
+
+if (TestCIntEvent()) {
+SETUP_PENDING_CALL(E,address_help);
+control_c_normal(w);
+    }
+
+if (Jit_Request(w)) {
+w->misc->jit_request = FALSE;
+SETUP_PENDING_CALL(E,address_jit);
+    }
+
+  }
+
+goto switch_on_pred;
+  }
+switch_on_pred:
+ei = Func->enter_instr;
+goto switch_on_pred_sub;
+switch_on_pred_sub:
+{
+switch (ei) {
+case ENTER_FASTCODE_INDEXED:
+{
+PRED_HOOK("N",Func);
+w->heap_top = H;
+intmach_t vr12 = jit_call(w,Func);
+if (vr12==JIT_OK) {
+goto r_op64;
+    }
+
+if (vr12==JIT_FAIL) {
+goto fail;
+    }
+
+H = w->heap_top;
+goto enter_compactcode_indexed;
+    }
+case ENTER_FASTCODE:
+{
+PRED_HOOK("N",Func);
+w->heap_top = H;
+intmach_t vr13 = jit_call(w,Func);
+if (vr13==JIT_OK) {
+goto r_op64;
+    }
+
+if (vr13==JIT_FAIL) {
+goto fail;
+    }
+
+H = w->heap_top;
+goto enter_compactcode;
+    }
+case ENTER_UNDEFINED:
+PRED_HOOK("U",Func);
+ptemp = (bcp_t)address_undefined_goal;
+goto escape_to_p;
+case ENTER_INTERPRETED:
+ptemp = (bcp_t)address_interpret_c_goal;
+goto escape_to_p2;
+case ENTER_C:
+{
+PRED_HOOK("C",Func);
+w->heap_top = H;
+intmach_t vr14 = ((cbool0_t)Func->code.proc)(w);
+if (Expanded_Worker!=NULL) {
+ON_DEBUG({
+fprintf(stderr,"wam() detected worker expanded by C predicate\n");
+      }
+);
+if (desc==NULL) {
+fprintf(stderr,"bug: invalid WAM expansion\n");
+abort();
+      }
+
+w = Expanded_Worker;
+desc->worker_registers = w;
+Expanded_Worker = NULL;
+    }
+
+if (vr14) {
+goto r_op64;
+    }
+ else {
+goto fail;
+    }
+
+    }
+case BUILTIN_TRUE:
+PRED_HOOK("B",Func);
+goto w_op64;
+case BUILTIN_FAIL:
+PRED_HOOK("B",Func);
+goto fail;
+case BUILTIN_CURRENT_INSTANCE:
+PRED_HOOK("B",Func);
+w->heap_top = H;
+w->misc->ins = CFUN__EVAL(current_instance0);
+if (w->misc->ins==NULL) {
+goto fail;
+    }
+
+P = (bcp_t)w->misc->ins->emulcode;
+goto r_dispatch;
+case BUILTIN_COMPILE_TERM:
+{
+PRED_HOOK("B",Func);
+w->heap_top = H;
+{worker_t * vr15;
+if (!compile_term(w,&vr15)) {
+goto fail;
+    }
+
+if (vr15!=NULL) {
+if (desc==NULL) {
+fprintf(stderr,"bug: invalid WAM expansion\n");
+abort();
+      }
+
+w = vr15;
+desc->worker_registers = w;
+ON_DEBUG({
+fprintf(stderr,"Reallocation of wrb detected in wam()\n");
+      }
+);
+    }
+
+}goto r_op64;
+    }
+case BUILTIN_INSTANCE:
+PRED_HOOK("B",Func);
+LoadHVA(X(3),H);
+w->misc->ins = TaggedToInstance(X(2));
+P = (bcp_t)w->misc->ins->emulcode;
+goto w_dispatch;
+case BUILTIN_GELER:
+{
+PRED_HOOK("B",Func);
+tagged_t vr16 = X(0);
+DerefSw_HVAorCVAorSVA_Other(vr16,{
+;    }
+,{
+;    }
+);
+tagged_t vr17 = X(1);
+DerefSw_HVAorCVAorSVA_Other(vr17,{
+;    }
+,{
+;    }
+);
+Setfunc(find_definition(predicates_location,vr17,&w->structure,TRUE));
+w->heap_top = H;
+CVOID__CALL(SUSPEND_T3_ON_T1,Func,vr17,vr16);
+H = w->heap_top;
+goto w_op64;
+    }
+case BUILTIN_NODEBUGCALL:
+{
+PRED_HOOK("B",Func);
+DerefSw_HVAorCVAorSVA_Other(X(0),{
+;    }
+,{
+;    }
+);
+tagged_t vr18 = X(0);
+Setfunc(find_definition(predicates_location,vr18,&w->structure,FALSE));
+if (Func==NULL) {
+goto fail;
+    }
+
+ei = Func->enter_instr;
+goto call4;
+    }
+case BUILTIN_SYSCALL:
+{
+PRED_HOOK("B",Func);
+DerefSw_HVAorCVAorSVA_Other(X(0),{
+;    }
+,{
+;    }
+);
+tagged_t vr19 = X(0);
+Setfunc(find_definition(predicates_location,vr19,&w->structure,FALSE));
+if (Func==NULL) {
+Setfunc(address_undefined_goal);
+goto switch_on_pred;
+    }
+
+ei = Func->enter_instr;
+goto call4;
+    }
+call4:
+{
+switch (ei) {
+case ENTER_INTERPRETED:
+X(1) = PointerToTerm(Func->code.intinfo);
+Setfunc(address_interpret_goal);
+goto switch_on_pred;
+case BUILTIN_DIF:
+{
+PRED_HOOK("B",Func);
+tagged_t * vr20 = w->structure;
+tagged_t vr21;
+RefHeapNext(vr21,vr20);
+X(0) = vr21;
+tagged_t vr22;
+RefHeapNext(vr22,vr20);
+X(1) = vr22;
+goto dif0;
+      }
+case SPYPOINT:
+if (!Func->properties.wait) {
+goto call5;
+      }
+
+goto call_waitpoint;
+case WAITPOINT:
+{
+call_waitpoint:
+{
+tagged_t vr23;
+RefHeap(vr23,w->structure);
+DerefSw_HVAorCVAorSVA_Other(vr23,{
+tagged_t vr24;
+vr24 = X(0);
+w->heap_top = H;
+CVOID__CALL(SUSPEND_T3_ON_T1,Func,vr24,vr23);
+H = w->heap_top;
+goto w_op64;
+      }
+,{
+;      }
+);
+goto call5;
+      }
+      }
+call5:
+ei = Func->predtyp;
+goto call4;
+default:
+{
+intmach_t vr25 = Func->arity;
+if (vr25!=0) {
+tagged_t * vr26 = w->x;
+tagged_t * vr27 = w->structure;
+do {
+PushRefHeapNext(vr26,vr27);
+        }
+ while (--vr25);
+      }
+
+goto switch_on_pred_sub;
+      }
+    }
+    }
+case BUILTIN_CALL:
+{
+PRED_HOOK("B",Func);
+DerefSw_HVAorCVAorSVA_Other(X(0),{
+;    }
+,{
+;    }
+);
+tagged_t vr28 = X(0);
+Setfunc(find_definition(predicates_location,vr28,&w->structure,FALSE));
+if (Func==NULL) {
+Setfunc(address_undefined_goal);
+goto switch_on_pred;
+    }
+
+if (Current_Debugger_Mode!=atom_off) {
+Setfunc(address_trace);
+goto switch_on_pred;
+    }
+
+ei = Func->enter_instr;
+goto call4;
+    }
+case BUILTIN_DIF:
+{
+dif0:
+{
+PRED_HOOK("B",Func);
+tagged_t vr29 = X(0);
+DerefSw_HVAorCVAorSVA_Other(vr29,{
+;    }
+,{
+;    }
+);
+tagged_t vr30 = X(1);
+DerefSw_HVAorCVAorSVA_Other(vr30,{
+;    }
+,{
+;    }
+);
+w->structure = NULL;
+if (vr29==vr30) {
+goto fail;
+    }
+ else if (BothNonvar(vr29,vr30)&&(IsNUMorATM(vr29)||IsNUMorATM(vr30))) {
+goto w_op64;
+    }
+ else {
+X(0) = vr29;
+X(1) = vr30;
+w->heap_top = H;
+if (!prolog_dif(w,Func)) {
+goto fail;
+      }
+
+goto r_op64;
+    }
+
+    }
+    }
+case BUILTIN_ABORT:
+{
+PRED_HOOK("B",Func);
+tagged_t vr31 = X(0);
+DerefSw_HVAorCVAorSVA_Other(vr31,{
+;    }
+,{
+;    }
+);
+w->misc->exit_code = GetSmall(vr31);
+w->previous_choice = InitialChoice;
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+goto fail;
+    }
+case SPYPOINT:
+if (Current_Debugger_Mode!=atom_off) {
+ptemp = (bcp_t)address_trace;
+goto escape_to_p;
+    }
+
+if (!Func->properties.wait) {
+goto nowait;
+    }
+
+goto waitpoint;
+case WAITPOINT:
+{
+waitpoint:
+{
+DerefSw_HVAorCVAorSVA_Other(X(0),{
+tagged_t vr32;
+tagged_t vr33;
+if (Func->arity==0) {
+vr32 = Func->printname;
+      }
+ else {
+vr32 = Tagp(STR,H);
+HeapPush(H,SetArity(Func->printname,Func->arity));
+for (intmach_t vr34 = 0;
+vr34<Func->arity;vr34++) {
+tagged_t vr35 = X(vr34);
+if (TaggedIsSVA(vr35)) {
+tagged_t vr36;
+do {
+RefSVA(vr36,vr35);
+if (vr36==vr35) {
+BindSVA(vr35,Tagp(HVA,H));
+PreLoadHVA(vr35,H);
+break;
+              }
+
+vr35 = vr36;
+            }
+ while (TaggedIsSVA(vr35));
+          }
+
+HeapPush(H,vr35);
+        }
+
+      }
+
+vr33 = X(0);
+if (TaggedIsSVA(vr33)) {
+RefSVA(vr33,X(0));
+      }
+
+w->heap_top = H;
+CVOID__CALL(SUSPEND_T3_ON_T1,Func,vr32,vr33);
+H = w->heap_top;
+goto w_op64;
+    }
+,{
+;    }
+);
+goto nowait;
+nowait:
+ei = Func->predtyp;
+goto switch_on_pred_sub;
+    }
+    }
+case BREAKPOINT:
+ei = Func->predtyp;
+goto switch_on_pred_sub;
+case ENTER_PROFILEDCODE_INDEXED:
+goto enter_compactcode_indexed;
+case ENTER_COMPACTCODE_INDEXED:
+{
+enter_compactcode_indexed:
+{
+PRED_HOOK("E",Func);
+JIT_COUNT_HOOK(Func);
+DerefSw_HVAorCVAorSVA_Other(X(0),{
+alts = Func->code.incoreinfo->varcase;
+if (alts->index) {
+alts = incore_index_select(w,alts);
+      }
+
+goto w_tryeach;
+    }
+,{
+;    }
+);
+tagged_t vr37 = X(0);
+tagged_t vr38;
+w->heap_top = H;
+if (vr37&TagBitComplex) {
+if (vr37&TagBitFunctor) {
+S = TaggedToArg(vr37,0);
+vr38 = HeapNext(S);
+      }
+ else {
+S = TagpPtr(LST,vr37);
+alts = Func->code.incoreinfo->lstcase;
+if (alts->index) {
+alts = incore_index_select(w,alts);
+        }
+
+goto r_tryeach;
+      }
+
+    }
+ else {
+vr38 = vr37;
+    }
+
+intmach_t vr39;
+hashtab_t * Htab = Func->code.incoreinfo->othercase;
+vr39 = 0;
+tagged_t vr40;
+vr40 = vr38;
+vr38&=Htab->mask;
+hashtab_node_t * HtabNode;
+do {
+HtabNode = SW_ON_KEY_NODE_FROM_OFFSET(Htab,vr38);
+if (HtabNode->key==vr40||!HtabNode->key) {
+break;
+      }
+
+vr39+=sizeof(hashtab_node_t);
+vr38 = (vr38+vr39)&Htab->mask;
+    }
+ while (TRUE);
+alts = HtabNode->value.try_chain;
+if (alts->index) {
+alts = incore_index_select(w,alts);
+    }
+
+goto r_tryeach;
+    }
+    }
+case ENTER_PROFILEDCODE:
+goto enter_compactcode;
+case ENTER_COMPACTCODE:
+enter_compactcode:
+PRED_HOOK("E",Func);
+JIT_COUNT_HOOK(Func);
+alts = Func->code.incoreinfo->varcase;
+if (alts->index) {
+alts = incore_index_select(w,alts);
+    }
+
+goto w_tryeach;
+  }
+  }
+fail:
+{
+PROFILE__HOOK_FAIL;
+ON_DEBUG({
+if (debug_choicepoints) {
+fprintf(stderr,"Failing: node = %p, previous_choice = %p, conc. node = %p\n",w->choice,w->previous_choice,TopConcChpt);
+    }
+
+if (w->misc->top_conc_chpt<w->choice&&w->misc->top_conc_chpt<w->previous_choice) {
+fprintf(stderr,"********** what happened here?\n");
+    }
+
+  }
+);
+ResetWakeCount();
+B = w->choice;
+ON_TABLING({
+MAKE_TRAIL_CACTUS_STACK;  }
+);
+{tagged_t vr41;
+tagged_t vr42;
+tagged_t * vr43;
+vr43 = w->trail_top;
+vr42 = (tagged_t)TrailTopUnmark(B->trail_top);
+if (TrailYounger(vr43,vr42)) {
+do {
+PlainUntrail(vr43,vr41,{
+w->trail_top = vr43;
+w->frame = B->frame;
+w->next_insn = B->next_insn;
+SetE(NodeLocalTop(B));
+E->frame = w->frame;
+E->next_insn = w->next_insn;
+w->frame = E;
+w->next_insn = failcode;
+w->local_top = (frame_t *)Offset(E,EToY0);
+H = w->heap_top;
+X(0) = vr41;
+Setfunc(find_definition(predicates_location,vr41,&w->structure,FALSE));
+if (Func==NULL) {
+Setfunc(address_undefined_goal);
+goto switch_on_pred;
+        }
+
+ei = Func->enter_instr;
+goto call4;
+      }
+);
+    }
+ while (TrailYounger(vr43,vr42));
+w->trail_top = vr43;
+  }
+
+}w->heap_top = NodeGlobalTop(B);
+if (IsDeep()) {
+ON_DEBUG({
+if (debug_choicepoints) {
+fprintf(stderr,"deep backtracking, node = %p\n",w->choice);
+      }
+
+    }
+);
+w->frame = B->frame;
+w->next_insn = B->next_insn;
+w->next_alt = B->next_alt;
+w->local_top = NodeLocalTop(B);
+intmach_t vr44 = B->next_alt->arity;
+w->previous_choice = ChoiceCont0(B,vr44);
+SetShallowRetry();
+for (intmach_t vr45 = 0;
+vr45<vr44;vr45++) {
+w->x[vr45] = B->x[vr45];
+    }
+
+  }
+
+PROFILE__HOOK_REDO;
+CLAUSE_COUNTERS__HOOK(w->next_alt,CLAUSE_COUNTERS__RETRY);
+P = (bcp_t)w->next_alt;
+try_node_t * vr46;
+vr46 = ((try_node_t *)P)->next;
+if (vr46==NULL) {
+SetDeep();
+B = w->previous_choice;
+SetChoice(B);
+ON_TABLING({
+if (FrozenChpt(B)) {
+push_choicept(w,address_nd_fake_choicept);
+      }
+
+    }
+);
+P = ((try_node_t *)P)->emul_p;
+if (!IsVar(X(0))) {
+goto r_dispatch;
+    }
+
+H = w->heap_top;
+goto w_dispatch;
+  }
+ else {
+CODE_CHOICE_PATCH(w->choice,vr46);
+P = ((try_node_t *)P)->emul_p;
+if (!IsVar(X(0))) {
+goto r_dispatch;
+    }
+
+H = w->heap_top;
+goto w_dispatch;
+  }
+
+  }
+r_tryeach:
+{
+#if defined(GAUGE)
+INCR_COUNTER(alts->entry_counter+1);
+#endif
+CLAUSE_COUNTERS__HOOK(alts,CLAUSE_COUNTERS__TRY);
+P = alts->emul_p2;
+w->previous_choice = w->choice;
+try_node_t * vr47 = alts->next;
+if (vr47!=NULL) {
+B = w->choice;
+GetFrameTop(w->local_top,B,G->frame);
+CODE_CHOICE_NEW0(B,vr47,w->heap_top);
+ON_DEBUG({
+if (debug_choicepoints) {
+fprintf(stderr,"WAM created choicepoint (r), node = %p\n",w->choice);
+      }
+
+    }
+);
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+    }
+
+  }
+ else {
+SetDeep();
+  }
+
+goto r_dispatch;
+  }
+r_dispatch:
+{
+switch (BcOPCODE) {
+case 260:
+H = w->heap_top;
+goto w_op260;
+case 261:
+H = w->heap_top;
+goto w_op261;
+case 0:
+P+=Fs(f_Q);
+goto r_op1;
+case 1:
+r_op1:
+H = w->heap_top;
+goto w_op1;
+case 20:
+P+=Fs(f_Q);
+goto r_op21;
+case 21:
+r_op21:
+H = w->heap_top;
+goto w_op21;
+case 18:
+P+=Fs(f_Q);
+goto r_op19;
+case 19:
+r_op19:
+H = w->heap_top;
+goto w_op19;
+case 16:
+P+=Fs(f_Q);
+goto r_op17;
+case 17:
+r_op17:
+H = w->heap_top;
+goto w_op17;
+case 14:
+P+=Fs(f_Q);
+goto r_op15;
+case 15:
+r_op15:
+H = w->heap_top;
+goto w_op15;
+case 12:
+P+=Fs(f_Q);
+goto r_op13;
+case 13:
+r_op13:
+H = w->heap_top;
+goto w_op13;
+case 10:
+P+=Fs(f_Q);
+goto r_op11;
+case 11:
+r_op11:
+H = w->heap_top;
+goto w_op11;
+case 8:
+P+=Fs(f_Q);
+goto r_op9;
+case 9:
+r_op9:
+H = w->heap_top;
+goto w_op9;
+case 6:
+P+=Fs(f_Q);
+goto r_op7;
+case 7:
+r_op7:
+H = w->heap_top;
+goto w_op7;
+case 4:
+P+=Fs(f_Q);
+goto r_op5;
+case 5:
+r_op5:
+H = w->heap_top;
+goto w_op5;
+case 2:
+P+=Fs(f_Q);
+goto r_op3;
+case 3:
+r_op3:
+H = w->heap_top;
+goto w_op3;
+case 40:
+P+=Fs(f_Q);
+goto r_op41;
+case 41:
+r_op41:
+H = w->heap_top;
+goto w_op41;
+case 38:
+P+=Fs(f_Q);
+goto r_op39;
+case 39:
+r_op39:
+H = w->heap_top;
+goto w_op39;
+case 36:
+P+=Fs(f_Q);
+goto r_op37;
+case 37:
+r_op37:
+H = w->heap_top;
+goto w_op37;
+case 34:
+P+=Fs(f_Q);
+goto r_op35;
+case 35:
+r_op35:
+H = w->heap_top;
+goto w_op35;
+case 32:
+P+=Fs(f_Q);
+goto r_op33;
+case 33:
+r_op33:
+H = w->heap_top;
+goto w_op33;
+case 30:
+P+=Fs(f_Q);
+goto r_op31;
+case 31:
+r_op31:
+H = w->heap_top;
+goto w_op31;
+case 28:
+P+=Fs(f_Q);
+goto r_op29;
+case 29:
+r_op29:
+H = w->heap_top;
+goto w_op29;
+case 26:
+P+=Fs(f_Q);
+goto r_op27;
+case 27:
+r_op27:
+H = w->heap_top;
+goto w_op27;
+case 24:
+P+=Fs(f_Q);
+goto r_op25;
+case 25:
+r_op25:
+H = w->heap_top;
+goto w_op25;
+case 22:
+P+=Fs(f_Q);
+goto r_op23;
+case 23:
+r_op23:
+H = w->heap_top;
+goto w_op23;
+case 60:
+P+=Fs(f_Q);
+goto r_op61;
+case 61:
+r_op61:
+H = w->heap_top;
+goto w_op61;
+case 58:
+P+=Fs(f_Q);
+goto r_op59;
+case 59:
+r_op59:
+H = w->heap_top;
+goto w_op59;
+case 56:
+P+=Fs(f_Q);
+goto r_op57;
+case 57:
+r_op57:
+H = w->heap_top;
+goto w_op57;
+case 54:
+P+=Fs(f_Q);
+goto r_op55;
+case 55:
+r_op55:
+H = w->heap_top;
+goto w_op55;
+case 52:
+P+=Fs(f_Q);
+goto r_op53;
+case 53:
+r_op53:
+H = w->heap_top;
+goto w_op53;
+case 50:
+P+=Fs(f_Q);
+goto r_op51;
+case 51:
+r_op51:
+H = w->heap_top;
+goto w_op51;
+case 48:
+P+=Fs(f_Q);
+goto r_op49;
+case 49:
+r_op49:
+H = w->heap_top;
+goto w_op49;
+case 46:
+P+=Fs(f_Q);
+goto r_op47;
+case 47:
+r_op47:
+H = w->heap_top;
+goto w_op47;
+case 44:
+P+=Fs(f_Q);
+goto r_op45;
+case 45:
+r_op45:
+H = w->heap_top;
+goto w_op45;
+case 42:
+P+=Fs(f_Q);
+goto r_op43;
+case 43:
+r_op43:
+H = w->heap_top;
+goto w_op43;
+case 62:
+H = w->heap_top;
+P = BcP(f_p,0+Fs(f_Q));
+goto enter_predicate;
+case 63:
+H = w->heap_top;
+P = BcP(f_p,0);
+goto enter_predicate;
+case 69:
+H = w->heap_top;
+goto w_op69;
+case 70:
+H = w->heap_top;
+goto w_op70;
+case 85:
+Xb(BcP(f_x,0)) = Xb(BcP(f_x,0+Fs(f_x)));
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x))) = Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+case 71:
+Xb(BcP(f_x,0)) = Xb(BcP(f_x,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+case 72:
+H = w->heap_top;
+goto w_op72;
+case 73:
+H = w->heap_top;
+goto w_op73;
+case 74:
+H = w->heap_top;
+goto w_op74;
+case 83:
+H = w->heap_top;
+goto w_op83;
+case 84:
+H = w->heap_top;
+goto w_op84;
+case 75:
+Xb(BcP(f_x,0)) = Yb(BcP(f_y,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 76:
+H = w->heap_top;
+goto w_op76;
+case 77:
+Xb(BcP(f_x,0+Fs(f_Q))) = BcP(f_t,0+Fs(f_Q)+Fs(f_x));
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_t);
+goto r_dispatch;
+case 78:
+Xb(BcP(f_x,0)) = BcP(f_t,0+Fs(f_x));
+P+=Fs(f_x)+Fs(f_t);
+goto r_dispatch;
+case 81:
+Xb(BcP(f_x,0)) = atom_nil;
+P+=Fs(f_x);
+goto r_dispatch;
+case 252:
+H = w->heap_top;
+goto w_op252;
+case 253:
+H = w->heap_top;
+goto w_op253;
+case 79:
+H = w->heap_top;
+goto w_op79;
+case 80:
+H = w->heap_top;
+goto w_op80;
+case 82:
+H = w->heap_top;
+goto w_op82;
+case 86:
+Xb(BcP(f_x,0)) = Yb(BcP(f_y,0+Fs(f_x)));
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y))) = Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 87:
+H = w->heap_top;
+goto w_op87;
+case 88:
+H = w->heap_top;
+goto w_op88;
+case 89:
+H = w->heap_top;
+goto w_op89;
+case 91:
+r_op91:
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),Xb(BcP(f_x,0+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+case 94:
+r_op94:
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_x))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_x))) = Xb(BcP(f_x,0));
+P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 95:
+r_op95:
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),Yb(BcP(f_y,0+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 96:
+P+=Fs(f_Q);
+goto r_op97;
+case 97:
+{
+r_op97:
+{
+tagged_t vr48 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr48,{
+BindHVA(vr48,BcP(f_t,0+Fs(f_x)));
+    }
+,{
+BindCVA(vr48,BcP(f_t,0+Fs(f_x)));
+    }
+,{
+BindSVA(vr48,BcP(f_t,0+Fs(f_x)));
+    }
+,{
+if (vr48!=BcP(f_t,0+Fs(f_x))) {
+goto fail;
+      }
+
+    }
+);
+P+=Fs(f_x)+Fs(f_t);
+goto r_dispatch;
+    }
+    }
+case 254:
+P+=Fs(f_Q);
+goto r_op255;
+case 255:
+{
+r_op255:
+{
+{tagged_t vr49;
+vr49 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr49,{
+BindHVA(vr49,BC_MakeBlob(w,&BcP(f_t,0+Fs(f_x))));
+    }
+,{
+BindCVA(vr49,BC_MakeBlob(w,&BcP(f_t,0+Fs(f_x))));
+    }
+,{
+BindSVA(vr49,BC_MakeBlob(w,&BcP(f_t,0+Fs(f_x))));
+    }
+,{
+BC_EqBlob(vr49,&BcP(f_t,0+Fs(f_x)),{
+goto fail;
+      }
+)    }
+);
+}P+=Fs(f_x)+LargeSize(*&BcP(f_t,0+Fs(f_x)));
+goto r_dispatch;
+    }
+    }
+case 98:
+P+=Fs(f_Q);
+goto r_op99;
+case 99:
+{
+r_op99:
+{
+tagged_t vr50 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr50,{
+H = w->heap_top;
+BindHVA(vr50,Tagp(STR,H));
+HeapPush(H,BcP(f_f,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_f);
+goto w_dispatch;
+    }
+,{
+H = w->heap_top;
+BindCVA(vr50,Tagp(STR,H));
+HeapPush(H,BcP(f_f,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_f);
+goto w_dispatch;
+    }
+,{
+H = w->heap_top;
+BindSVA(vr50,Tagp(STR,H));
+HeapPush(H,BcP(f_f,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_f);
+goto w_dispatch;
+    }
+,{
+if (!TaggedIsSTR(vr50)||TaggedToHeadfunctor(vr50)!=BcP(f_f,0+Fs(f_x))) {
+goto fail;
+      }
+
+S = TaggedToArg(vr50,1);
+P+=Fs(f_x)+Fs(f_f);
+goto r_dispatch;
+    }
+);
+    }
+    }
+case 100:
+{
+r_op100:
+{
+tagged_t vr51 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr51,{
+BindHVA(vr51,atom_nil);
+    }
+,{
+BindCVA(vr51,atom_nil);
+    }
+,{
+BindSVA(vr51,atom_nil);
+    }
+,{
+if (vr51!=atom_nil) {
+goto fail;
+      }
+
+    }
+);
+P+=Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 101:
+{
+r_op101:
+{
+{tagged_t vr52 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr52,{
+H = w->heap_top;
+BindHVA(vr52,Tagp(LST,H));
+P+=Fs(f_x);
+goto w_dispatch;
+    }
+,{
+H = w->heap_top;
+BindCVA(vr52,Tagp(LST,H));
+P+=Fs(f_x);
+goto w_dispatch;
+    }
+,{
+H = w->heap_top;
+BindSVA(vr52,Tagp(LST,H));
+P+=Fs(f_x);
+goto w_dispatch;
+    }
+,{
+if (!TermIsLST(vr52)) {
+goto fail;
+      }
+
+S = TagpPtr(LST,vr52);
+P+=Fs(f_x);
+goto r_dispatch;
+    }
+);
+}    }
+    }
+case 111:
+P+=Fs(f_Q);
+goto r_op112;
+case 112:
+{
+r_op112:
+{
+tagged_t vr53 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr53,{
+BindHVA(vr53,BcP(f_t,0+Fs(f_x)));
+    }
+,{
+BindCVA(vr53,BcP(f_t,0+Fs(f_x)));
+    }
+,{
+BindSVA(vr53,BcP(f_t,0+Fs(f_x)));
+    }
+,{
+if (vr53!=BcP(f_t,0+Fs(f_x))) {
+goto fail;
+      }
+
+    }
+);
+H = w->heap_top;
+goto w_op66;
+    }
+    }
+case 113:
+{
+r_op113:
+{
+tagged_t vr54 = Xb(BcP(f_x,0));
+DerefSw_HVA_CVA_SVA_Other(vr54,{
+BindHVA(vr54,atom_nil);
+    }
+,{
+BindCVA(vr54,atom_nil);
+    }
+,{
+BindSVA(vr54,atom_nil);
+    }
+,{
+if (vr54!=atom_nil) {
+goto fail;
+      }
+
+    }
+);
+H = w->heap_top;
+goto w_op66;
+    }
+    }
+case 208:
+r_op208:
+w->local_top = 0;
+w->previous_choice = ChoiceFromTagged(Xb(BcP(f_x,0)));
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+P+=Fs(f_x);
+goto r_dispatch;
+case 210:
+r_op210:
+w->local_top = 0;
+w->previous_choice = ChoiceFromTagged(Xb(BcP(f_x,0)));
+P+=Fs(f_x);
+goto r_op211;
+case 211:
+r_op211:
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+if (!IsDeep()) {
+SetDeep();
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+      }
+
+    }
+
+P+=0;
+goto r_dispatch;
+case 212:
+r_op212:
+w->previous_choice = ChoiceFromTagged(Xb(BcP(f_x,0)));
+goto r_op213;
+case 213:
+r_op213:
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+if (!IsDeep()) {
+SetDeep();
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+      }
+
+    }
+
+goto r_op64;
+case 214:
+r_op214:
+w->previous_choice = ChoiceFromTagged(Xb(BcP(f_x,0)));
+w->local_top = E;
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+SetE(w->local_top);
+P+=Fs(f_x);
+goto r_dispatch;
+case 216:
+r_op216:
+w->previous_choice = ChoiceFromTagged(Xb(BcP(f_x,0)));
+P+=Fs(f_x);
+goto r_op217;
+case 217:
+r_op217:
+w->local_top = E;
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+SetDeep();
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+    }
+
+SetE(w->local_top);
+P+=0;
+goto r_dispatch;
+case 215:
+r_op215:
+w->previous_choice = ChoiceFromTagged(Xb(BcP(f_x,0)));
+P+=Fs(f_x);
+goto r_op209;
+case 209:
+r_op209:
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+SetE(w->frame);
+P+=0;
+goto r_dispatch;
+case 218:
+{
+r_op218:
+{
+tagged_t vr55;
+vr55 = Yb(BcP(f_y,0));
+w->previous_choice = ChoiceFromTagged(vr55);
+PROFILE__HOOK_CUT;
+B = w->previous_choice;
+SetChoice(B);
+TRACE_CHPT_CUT(w->choice);
+ConcChptCleanUp(TopConcChpt,w->choice);
+SetE(w->frame);
+P+=Fs(f_y);
+goto r_dispatch;
+P+=Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 219:
+Xb(BcP(f_x,0)) = ChoiceToTagged(w->previous_choice);
+P+=Fs(f_x);
+goto r_dispatch;
+case 220:
+CODE_ALLOC(E);
+goto r_op221;
+case 221:
+r_op221:
+Yb(BcP(f_y,0)) = ChoiceToTagged(w->previous_choice);
+P+=Fs(f_y);
+goto r_dispatch;
+case 233:
+H = w->heap_top;
+goto w_op233;
+case 234:
+r_op234:
+goto r_op235;
+case 235:
+r_op235:
+goto exit_toplevel;
+case 237:
+r_op237:
+if (!IsDeep()) {
+NECK_RETRY_PATCH(B);
+SetDeep();
+    }
+
+if (!((cbool0_t)BcP(f_C,0+Fs(f_Q)))(w)) {
+goto fail;
+    }
+
+goto r_op64;
+case 238:
+r_op238:
+if (!IsDeep()) {
+NECK_RETRY_PATCH(B);
+SetDeep();
+    }
+
+if (!((cbool0_t)BcP(f_C,0))(w)) {
+goto fail;
+    }
+
+goto r_op64;
+case 104:
+{
+{
+tagged_t vr56 = X(0);
+S = TaggedToArg(vr56,1);
+P+=Fs(f_Q)+Fs(f_f);
+goto r_dispatch;
+    }
+    }
+case 105:
+{
+{
+tagged_t vr57 = X(0);
+S = TaggedToArg(vr57,1);
+P+=Fs(f_f);
+goto r_dispatch;
+    }
+    }
+case 256:
+{
+{
+tagged_t vr58 = X(0);
+{tagged_t vr59;
+vr59 = vr58;
+DerefSw_HVA_CVA_SVA_Other(vr59,{
+BindHVA(vr59,BC_MakeBlob(w,&BcP(f_t,0+Fs(f_Q))));
+    }
+,{
+BindCVA(vr59,BC_MakeBlob(w,&BcP(f_t,0+Fs(f_Q))));
+    }
+,{
+BindSVA(vr59,BC_MakeBlob(w,&BcP(f_t,0+Fs(f_Q))));
+    }
+,{
+BC_EqBlob(vr59,&BcP(f_t,0+Fs(f_Q)),{
+goto fail;
+      }
+)    }
+);
+}P+=Fs(f_Q)+LargeSize(*&BcP(f_t,0+Fs(f_Q)));
+goto r_dispatch;
+    }
+    }
+case 257:
+{
+{
+tagged_t vr60 = X(0);
+{tagged_t vr61;
+vr61 = vr60;
+DerefSw_HVA_CVA_SVA_Other(vr61,{
+BindHVA(vr61,BC_MakeBlob(w,&BcP(f_t,0)));
+    }
+,{
+BindCVA(vr61,BC_MakeBlob(w,&BcP(f_t,0)));
+    }
+,{
+BindSVA(vr61,BC_MakeBlob(w,&BcP(f_t,0)));
+    }
+,{
+BC_EqBlob(vr61,&BcP(f_t,0),{
+goto fail;
+      }
+)    }
+);
+}P+=LargeSize(*&BcP(f_t,0));
+goto r_dispatch;
+    }
+    }
+case 102:
+P+=Fs(f_Q)+Fs(f_t);
+goto r_dispatch;
+case 103:
+P+=Fs(f_t);
+goto r_dispatch;
+case 106:
+P+=0;
+goto r_dispatch;
+case 107:
+{
+{
+tagged_t vr62 = X(0);
+S = TagpPtr(LST,vr62);
+P+=0;
+goto r_dispatch;
+    }
+    }
+case 108:
+Xb(BcP(f_x,0+Fs(f_x))) = Xb(BcP(f_x,0));
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x)+Fs(f_x))) = Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+case 90:
+Xb(BcP(f_x,0+Fs(f_x))) = Xb(BcP(f_x,0));
+P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+case 92:
+CODE_ALLOC(E);
+goto r_op93;
+case 93:
+r_op93:
+Yb(BcP(f_y,0+Fs(f_x))) = Xb(BcP(f_x,0));
+P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 109:
+CODE_ALLOC(E);
+goto r_op110;
+case 110:
+r_op110:
+Yb(BcP(f_y,0+Fs(f_x))) = Xb(BcP(f_x,0));
+Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x))) = Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y)));
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 68:
+P = BCoff(P,BcP(f_i,0));
+goto r_dispatch;
+case 222:
+{
+r_op222:
+{
+w->liveinfo = &BcP(f_l,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_C));
+tagged_t vr63 = (tagged_t)((ctagged1_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x))));
+Xb(BcP(f_x,0+Fs(f_Q))) = vr63;
+if (ERRORTAG==vr63) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+    }
+    }
+case 223:
+{
+r_op223:
+{
+w->liveinfo = &BcP(f_l,0+Fs(f_x)+Fs(f_x)+Fs(f_C));
+tagged_t vr64 = (tagged_t)((ctagged1_t)BcP(f_C,0+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_x))));
+Xb(BcP(f_x,0)) = vr64;
+if (ERRORTAG==vr64) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+    }
+    }
+case 224:
+{
+r_op224:
+{
+w->liveinfo = &BcP(f_l,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C));
+tagged_t vr65 = (tagged_t)((ctagged2_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x)+Fs(f_x))));
+Xb(BcP(f_x,0+Fs(f_Q))) = vr65;
+if (ERRORTAG==vr65) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+    }
+    }
+case 225:
+{
+r_op225:
+{
+w->liveinfo = &BcP(f_l,0+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C));
+tagged_t vr66 = (tagged_t)((ctagged2_t)BcP(f_C,0+Fs(f_x)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_x))),Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x))));
+Xb(BcP(f_x,0)) = vr66;
+if (ERRORTAG==vr66) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+    }
+    }
+case 226:
+r_op226:
+if (!((cbool1_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q))))) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_C);
+goto r_dispatch;
+case 227:
+r_op227:
+if (!((cbool1_t)BcP(f_C,0+Fs(f_x)))(w,Xb(BcP(f_x,0)))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_C);
+goto r_dispatch;
+case 228:
+r_op228:
+if (!((cbool2_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_C);
+goto r_dispatch;
+case 229:
+r_op229:
+if (!((cbool2_t)BcP(f_C,0+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0)),Xb(BcP(f_x,0+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x)+Fs(f_C);
+goto r_dispatch;
+case 230:
+r_op230:
+if (!((cbool3_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x)+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C);
+goto r_dispatch;
+case 231:
+r_op231:
+if (!((cbool3_t)BcP(f_C,0+Fs(f_x)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0)),Xb(BcP(f_x,0+Fs(f_x))),Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C);
+goto r_dispatch;
+case 240:
+r_op240:
+w->liveinfo = &BcP(f_l,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_C));
+if (!((cbool2_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+case 241:
+r_op241:
+w->liveinfo = &BcP(f_l,0+Fs(f_x)+Fs(f_x)+Fs(f_C));
+if (!((cbool2_t)BcP(f_C,0+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0)),Xb(BcP(f_x,0+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+case 242:
+r_op242:
+w->liveinfo = &BcP(f_l,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C));
+if (!((cbool3_t)BcP(f_C,0+Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0+Fs(f_Q))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x))),Xb(BcP(f_x,0+Fs(f_Q)+Fs(f_x)+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+case 243:
+r_op243:
+w->liveinfo = &BcP(f_l,0+Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C));
+if (!((cbool3_t)BcP(f_C,0+Fs(f_x)+Fs(f_x)+Fs(f_x)))(w,Xb(BcP(f_x,0)),Xb(BcP(f_x,0+Fs(f_x))),Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x))))) {
+goto fail;
+    }
+
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_C)+Fs(f_g);
+goto r_dispatch;
+case 232:
+r_op232:
+if ((TaggedToRoot(X(RootArg))->behavior_on_failure!=DYNAMIC&&!next_instance_conc(w,&w->misc->ins))||(TaggedToRoot(X(RootArg))->behavior_on_failure==DYNAMIC&&!next_instance(w,&w->misc->ins))) {
+SetDeep();
+B = w->previous_choice;
+SetChoice(B);
+    }
+
+if (w->misc->ins==NULL) {
+ON_DEBUG({
+if (debug_concchoicepoints) {
+if (TaggedToRoot(X(RootArg))->behavior_on_failure!=CONC_CLOSED&&IS_BLOCKING(X(InvocationAttr))) {
+fprintf(stderr,"**wam(): failing on a concurrent closed pred, chpt=%p, failing chpt=%p .\n",w->choice,TopConcChpt);
+          }
+
+        }
+
+if (debug_conc) {
+if (TaggedToRoot(X(RootArg))->x2_pending_on_instance||TaggedToRoot(X(RootArg))->x5_pending_on_instance) {
+fprintf(stderr,"**wam(): failing with invokations pending from root, type = %d.\n",TaggedToRoot(X(RootArg))->behavior_on_failure);
+          }
+
+        }
+
+      }
+);
+TopConcChpt = TermToPointerOrNull(choice_t,X(PrevDynChpt));
+ON_DEBUG({
+if (debug_concchoicepoints) {
+fprintf(stderr,"New topmost concurrent chpt = %p\n",TopConcChpt);
+        }
+
+      }
+);
+goto fail;
+    }
+
+ON_DEBUG({
+if (debug_conc&&TaggedToRoot(X(RootArg))->behavior_on_failure!=DYNAMIC) {
+fprintf(stderr,"*** %" PRIdm " (%" PRIdm ") backtracking on a concurrent predicate.\n",(intmach_t)Thread_Id,(intmach_t)GET_INC_COUNTER);
+      }
+
+if (debug_concchoicepoints&&TaggedToRoot(X(RootArg))->behavior_on_failure!=DYNAMIC) {
+fprintf(stderr,"backtracking to chpt. = %p\n",w->choice);
+      }
+
+    }
+);
+P = (bcp_t)w->misc->ins->emulcode;
+goto r_dispatch;
+case 247:
+H = w->heap_top;
+goto w_op247;
+case 114:
+S = HeapOffset(S,BcP(f_i,0));
+P+=Fs(f_i);
+goto r_dispatch;
+case 115:
+S = HeapOffset(S,1);
+P+=0;
+goto r_dispatch;
+case 116:
+S = HeapOffset(S,2);
+P+=0;
+goto r_dispatch;
+case 117:
+S = HeapOffset(S,3);
+P+=0;
+goto r_dispatch;
+case 118:
+S = HeapOffset(S,4);
+P+=0;
+goto r_dispatch;
+case 119:
+RefHeapNext(Xb(BcP(f_x,0)),S);
+P+=Fs(f_x);
+goto r_dispatch;
+case 120:
+goto r_op121;
+case 121:
+{
+r_op121:
+{
+{tagged_t vr67;
+RefHeapNext(vr67,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr67)) {
+goto fail;
+    }
+
+}P+=Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 122:
+CODE_ALLOC(E);
+goto r_op123;
+case 123:
+r_op123:
+RefHeapNext(Yb(BcP(f_y,0)),S);
+P+=Fs(f_y);
+goto r_dispatch;
+case 124:
+{
+{
+{tagged_t vr68;
+RefHeapNext(vr68,S);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr68;
+}P+=Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 125:
+goto r_op126;
+case 126:
+{
+r_op126:
+{
+{tagged_t vr69;
+RefHeapNext(vr69,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr69)) {
+goto fail;
+    }
+
+}P+=Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 127:
+P+=Fs(f_Q);
+goto r_op128;
+case 128:
+{
+r_op128:
+{
+tagged_t vr70;
+RefHeapNext(vr70,S);
+tagged_t vr71 = vr70;
+HeapDerefSw_HVA_CVA_Other(vr71,{
+BindHVA(vr71,BcP(f_t,0));
+    }
+,{
+BindCVA(vr71,BcP(f_t,0));
+    }
+,{
+if (vr71!=BcP(f_t,0)) {
+goto fail;
+      }
+
+    }
+);
+P+=Fs(f_t);
+goto r_dispatch;
+    }
+    }
+case 258:
+P+=Fs(f_Q);
+goto r_op259;
+case 259:
+{
+r_op259:
+{
+tagged_t vr72;
+RefHeapNext(vr72,S);
+{tagged_t vr73 = vr72;
+HeapDerefSw_HVA_CVA_Other(vr73,{
+BindHVA(vr73,BC_MakeBlob(w,&BcP(f_t,0)));
+    }
+,{
+BindCVA(vr73,BC_MakeBlob(w,&BcP(f_t,0)));
+    }
+,{
+BC_EqBlob(vr73,&BcP(f_t,0),{
+goto fail;
+      }
+)    }
+);
+}P+=LargeSize(*&BcP(f_t,0));
+goto r_dispatch;
+    }
+    }
+case 129:
+P+=Fs(f_Q);
+goto r_op130;
+case 130:
+{
+r_op130:
+{
+tagged_t vr74;
+RefHeapNext(vr74,S);
+tagged_t vr75 = vr74;
+HeapDerefSw_HVA_CVA_Other(vr75,{
+H = w->heap_top;
+BindHVA(vr75,Tagp(STR,H));
+HeapPush(H,BcP(f_f,0));
+P+=Fs(f_f);
+goto w_dispatch;
+    }
+,{
+H = w->heap_top;
+BindCVA(vr75,Tagp(STR,H));
+HeapPush(H,BcP(f_f,0));
+P+=Fs(f_f);
+goto w_dispatch;
+    }
+,{
+if (!TaggedIsSTR(vr75)||TaggedToHeadfunctor(vr75)!=BcP(f_f,0)) {
+goto fail;
+      }
+
+S = TaggedToArg(vr75,1);
+P+=Fs(f_f);
+goto r_dispatch;
+    }
+);
+    }
+    }
+case 131:
+{
+{
+tagged_t vr76;
+RefHeapNext(vr76,S);
+tagged_t vr77 = vr76;
+HeapDerefSw_HVA_CVA_Other(vr77,{
+BindHVA(vr77,atom_nil);
+    }
+,{
+BindCVA(vr77,atom_nil);
+    }
+,{
+if (vr77!=atom_nil) {
+goto fail;
+      }
+
+    }
+);
+P+=0;
+goto r_dispatch;
+    }
+    }
+case 132:
+{
+{
+tagged_t vr78;
+RefHeapNext(vr78,S);
+{tagged_t vr79 = vr78;
+HeapDerefSw_HVA_CVA_Other(vr79,{
+H = w->heap_top;
+BindHVA(vr79,Tagp(LST,H));
+P+=0;
+goto w_dispatch;
+    }
+,{
+H = w->heap_top;
+BindCVA(vr79,Tagp(LST,H));
+P+=0;
+goto w_dispatch;
+    }
+,{
+if (!TermIsLST(vr79)) {
+goto fail;
+      }
+
+S = TagpPtr(LST,vr79);
+P+=0;
+goto r_dispatch;
+    }
+);
+}    }
+    }
+case 133:
+P+=Fs(f_Q);
+goto r_op134;
+case 134:
+{
+r_op134:
+{
+tagged_t vr80;
+RefHeapNext(vr80,S);
+tagged_t vr81 = vr80;
+HeapDerefSw_HVA_CVA_Other(vr81,{
+BindHVA(vr81,BcP(f_t,0));
+    }
+,{
+BindCVA(vr81,BcP(f_t,0));
+    }
+,{
+if (vr81!=BcP(f_t,0)) {
+goto fail;
+      }
+
+    }
+);
+H = w->heap_top;
+goto w_op66;
+    }
+    }
+case 135:
+{
+{
+tagged_t vr82;
+RefHeapNext(vr82,S);
+tagged_t vr83 = vr82;
+HeapDerefSw_HVA_CVA_Other(vr83,{
+BindHVA(vr83,atom_nil);
+    }
+,{
+BindCVA(vr83,atom_nil);
+    }
+,{
+if (vr83!=atom_nil) {
+goto fail;
+      }
+
+    }
+);
+H = w->heap_top;
+goto w_op66;
+    }
+    }
+case 136:
+S = HeapOffset(S,BcP(f_i,0));
+RefHeapNext(Xb(BcP(f_x,0+Fs(f_i))),S);
+P+=Fs(f_i)+Fs(f_x);
+goto r_dispatch;
+case 139:
+CODE_ALLOC(E);
+goto r_op140;
+case 140:
+r_op140:
+S = HeapOffset(S,BcP(f_i,0));
+RefHeapNext(Yb(BcP(f_y,0+Fs(f_i))),S);
+P+=Fs(f_i)+Fs(f_y);
+goto r_dispatch;
+case 137:
+goto r_op138;
+case 138:
+{
+r_op138:
+{
+S = HeapOffset(S,BcP(f_i,0));
+{tagged_t vr84;
+RefHeapNext(vr84,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0+Fs(f_i))),vr84)) {
+goto fail;
+    }
+
+}P+=Fs(f_i)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 141:
+{
+{
+S = HeapOffset(S,BcP(f_i,0));
+{tagged_t vr85;
+RefHeapNext(vr85,S);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_i))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_i)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_i))) = vr85;
+}P+=Fs(f_i)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 142:
+goto r_op143;
+case 143:
+{
+r_op143:
+{
+S = HeapOffset(S,BcP(f_i,0));
+{tagged_t vr86;
+RefHeapNext(vr86,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0+Fs(f_i))),vr86)) {
+goto fail;
+    }
+
+}P+=Fs(f_i)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 144:
+RefHeapNext(Xb(BcP(f_x,0)),S);
+S = HeapOffset(S,BcP(f_i,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_i);
+goto r_dispatch;
+case 145:
+RefHeapNext(Xb(BcP(f_x,0)),S);
+RefHeapNext(Xb(BcP(f_x,0+Fs(f_x))),S);
+P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+case 148:
+CODE_ALLOC(E);
+goto r_op149;
+case 149:
+r_op149:
+RefHeapNext(Xb(BcP(f_x,0)),S);
+RefHeapNext(Yb(BcP(f_y,0+Fs(f_x))),S);
+P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+case 146:
+goto r_op147;
+case 147:
+{
+r_op147:
+{
+RefHeapNext(Xb(BcP(f_x,0)),S);
+{tagged_t vr87;
+RefHeapNext(vr87,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0+Fs(f_x))),vr87)) {
+goto fail;
+    }
+
+}P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 150:
+{
+{
+RefHeapNext(Xb(BcP(f_x,0)),S);
+{tagged_t vr88;
+RefHeapNext(vr88,S);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_x))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_x))) = vr88;
+}P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 151:
+goto r_op152;
+case 152:
+{
+r_op152:
+{
+RefHeapNext(Xb(BcP(f_x,0)),S);
+{tagged_t vr89;
+RefHeapNext(vr89,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0+Fs(f_x))),vr89)) {
+goto fail;
+    }
+
+}P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 153:
+CODE_ALLOC(E);
+goto r_op154;
+case 154:
+r_op154:
+RefHeapNext(Yb(BcP(f_y,0)),S);
+S = HeapOffset(S,BcP(f_i,0+Fs(f_y)));
+P+=Fs(f_y)+Fs(f_i);
+goto r_dispatch;
+case 155:
+CODE_ALLOC(E);
+goto r_op156;
+case 156:
+r_op156:
+RefHeapNext(Yb(BcP(f_y,0)),S);
+RefHeapNext(Xb(BcP(f_x,0+Fs(f_y))),S);
+P+=Fs(f_y)+Fs(f_x);
+goto r_dispatch;
+case 157:
+CODE_ALLOC(E);
+goto r_op158;
+case 158:
+r_op158:
+RefHeapNext(Yb(BcP(f_y,0)),S);
+RefHeapNext(Yb(BcP(f_y,0+Fs(f_y))),S);
+P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+case 159:
+goto r_op161;
+case 161:
+r_op161:
+CODE_ALLOC(E);
+goto r_op162;
+case 160:
+goto r_op162;
+case 162:
+{
+r_op162:
+{
+RefHeapNext(Yb(BcP(f_y,0)),S);
+{tagged_t vr90;
+RefHeapNext(vr90,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0+Fs(f_y))),vr90)) {
+goto fail;
+    }
+
+}P+=Fs(f_y)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 163:
+goto r_op165;
+case 165:
+r_op165:
+CODE_ALLOC(E);
+goto r_op166;
+case 164:
+goto r_op166;
+case 166:
+{
+r_op166:
+{
+RefHeapNext(Yb(BcP(f_y,0)),S);
+{tagged_t vr91;
+RefHeapNext(vr91,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0+Fs(f_y))),vr91)) {
+goto fail;
+    }
+
+}P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 185:
+{
+{
+{tagged_t vr92;
+RefHeapNext(vr92,S);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr92;
+}S = HeapOffset(S,BcP(f_i,0+Fs(f_y)));
+P+=Fs(f_y)+Fs(f_i);
+goto r_dispatch;
+    }
+    }
+case 188:
+{
+{
+{tagged_t vr93;
+RefHeapNext(vr93,S);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr93;
+}RefHeapNext(Xb(BcP(f_x,0+Fs(f_y))),S);
+P+=Fs(f_y)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 199:
+{
+{
+{tagged_t vr94;
+RefHeapNext(vr94,S);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr94;
+}{tagged_t vr95;
+RefHeapNext(vr95,S);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_y))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_y)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_y))) = vr95;
+}P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 193:
+goto r_op196;
+case 196:
+{
+r_op196:
+{
+{tagged_t vr96;
+RefHeapNext(vr96,S);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr96;
+}{tagged_t vr97;
+RefHeapNext(vr97,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0+Fs(f_y))),vr97)) {
+goto fail;
+    }
+
+}P+=Fs(f_y)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 202:
+goto r_op205;
+case 205:
+{
+r_op205:
+{
+{tagged_t vr98;
+RefHeapNext(vr98,S);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr98;
+}{tagged_t vr99;
+RefHeapNext(vr99,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0+Fs(f_y))),vr99)) {
+goto fail;
+    }
+
+}P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 167:
+goto r_op168;
+case 168:
+{
+r_op168:
+{
+{tagged_t vr100;
+RefHeapNext(vr100,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr100)) {
+goto fail;
+    }
+
+}S = HeapOffset(S,BcP(f_i,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_i);
+goto r_dispatch;
+    }
+    }
+case 169:
+goto r_op170;
+case 170:
+{
+r_op170:
+{
+{tagged_t vr101;
+RefHeapNext(vr101,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr101)) {
+goto fail;
+    }
+
+}RefHeapNext(Xb(BcP(f_x,0+Fs(f_x))),S);
+P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 171:
+goto r_op172;
+case 172:
+r_op172:
+CODE_ALLOC(E);
+goto r_op174;
+case 173:
+goto r_op174;
+case 174:
+{
+r_op174:
+{
+{tagged_t vr102;
+RefHeapNext(vr102,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr102)) {
+goto fail;
+    }
+
+}RefHeapNext(Yb(BcP(f_y,0+Fs(f_x))),S);
+P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 175:
+goto r_op177;
+case 177:
+r_op177:
+goto r_op176;
+case 176:
+r_op176:
+goto r_op178;
+case 178:
+{
+r_op178:
+{
+{tagged_t vr103;
+RefHeapNext(vr103,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr103)) {
+goto fail;
+    }
+
+}{tagged_t vr104;
+RefHeapNext(vr104,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0+Fs(f_x))),vr104)) {
+goto fail;
+    }
+
+}P+=Fs(f_x)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 179:
+goto r_op180;
+case 180:
+{
+r_op180:
+{
+{tagged_t vr105;
+RefHeapNext(vr105,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr105)) {
+goto fail;
+    }
+
+}{tagged_t vr106;
+RefHeapNext(vr106,S);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_x))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_x))) = vr106;
+}P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 181:
+goto r_op183;
+case 183:
+r_op183:
+goto r_op182;
+case 182:
+r_op182:
+goto r_op184;
+case 184:
+{
+r_op184:
+{
+{tagged_t vr107;
+RefHeapNext(vr107,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0)),vr107)) {
+goto fail;
+    }
+
+}{tagged_t vr108;
+RefHeapNext(vr108,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0+Fs(f_x))),vr108)) {
+goto fail;
+    }
+
+}P+=Fs(f_x)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 186:
+goto r_op187;
+case 187:
+{
+r_op187:
+{
+{tagged_t vr109;
+RefHeapNext(vr109,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr109)) {
+goto fail;
+    }
+
+}S = HeapOffset(S,BcP(f_i,0+Fs(f_y)));
+P+=Fs(f_y)+Fs(f_i);
+goto r_dispatch;
+    }
+    }
+case 189:
+goto r_op190;
+case 190:
+{
+r_op190:
+{
+{tagged_t vr110;
+RefHeapNext(vr110,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr110)) {
+goto fail;
+    }
+
+}RefHeapNext(Xb(BcP(f_x,0+Fs(f_y))),S);
+P+=Fs(f_y)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 191:
+goto r_op192;
+case 192:
+{
+r_op192:
+{
+{tagged_t vr111;
+RefHeapNext(vr111,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr111)) {
+goto fail;
+    }
+
+}RefHeapNext(Yb(BcP(f_y,0+Fs(f_y))),S);
+P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 200:
+goto r_op201;
+case 201:
+{
+r_op201:
+{
+{tagged_t vr112;
+RefHeapNext(vr112,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr112)) {
+goto fail;
+    }
+
+}{tagged_t vr113;
+RefHeapNext(vr113,S);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_y))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_y)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_y))) = vr113;
+}P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 194:
+goto r_op197;
+case 197:
+r_op197:
+goto r_op195;
+case 195:
+r_op195:
+goto r_op198;
+case 198:
+{
+r_op198:
+{
+{tagged_t vr114;
+RefHeapNext(vr114,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr114)) {
+goto fail;
+    }
+
+}{tagged_t vr115;
+RefHeapNext(vr115,S);
+if (!CBOOL__SUCCEED(cunify,Xb(BcP(f_x,0+Fs(f_y))),vr115)) {
+goto fail;
+    }
+
+}P+=Fs(f_y)+Fs(f_x);
+goto r_dispatch;
+    }
+    }
+case 203:
+goto r_op206;
+case 206:
+r_op206:
+goto r_op204;
+case 204:
+r_op204:
+goto r_op207;
+case 207:
+{
+r_op207:
+{
+{tagged_t vr116;
+RefHeapNext(vr116,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0)),vr116)) {
+goto fail;
+    }
+
+}{tagged_t vr117;
+RefHeapNext(vr117,S);
+if (!CBOOL__SUCCEED(cunify,Yb(BcP(f_y,0+Fs(f_y))),vr117)) {
+goto fail;
+    }
+
+}P+=Fs(f_y)+Fs(f_y);
+goto r_dispatch;
+    }
+    }
+case 248:
+P+=Fs(f_Q);
+goto r_op249;
+case 249:
+r_op249:
+#if defined(GAUGE)
+INCR_COUNTER(BcP(f_l,0));
+#endif
+P+=Fs(f_l);
+goto r_dispatch;
+case 250:
+P+=Fs(f_Q);
+goto r_op251;
+case 251:
+r_op251:
+#if defined(GAUGE)
+if (!IsDeep()) {
+B = w->choice;
+if (!IsShallowTry()) {
+#if defined(GAUGE)
+INCR_COUNTER(BcP(f_l,0));
+#endif
+      }
+ else {
+#if defined(GAUGE)
+INCR_COUNTER(BcP(f_l,0+Fs(f_l)));
+#endif
+      }
+
+    }
+
+#endif
+P+=Fs(f_l)+Fs(f_l);
+goto r_op65;
+case 67:
+goto fail;
+case 245:
+P+=Fs(f_Q);
+goto r_op246;
+case 246:
+r_op246:
+if (HeapCharDifference(w->heap_top,Heap_End)<(intmach_t)BcP(f_l,0)) {
+explicit_heap_overflow(w,(intmach_t)BcP(f_l,0)*2,(FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_l)));
+    }
+
+P+=Fs(f_l)+Fs(f_i);
+goto r_dispatch;
+case 65:
+{
+r_op65:
+{
+if (!IsDeep()) {
+B = w->choice;
+if (!IsShallowTry()) {
+NECK_RETRY_PATCH(B);
+      }
+ else {
+B->next_alt = w->next_alt;
+B->frame = w->frame;
+B->next_insn = w->next_insn;
+B->local_top = w->local_top;
+intmach_t vr118 = ChoiceArity(B);
+for (intmach_t vr119 = 0;
+vr119<vr118;vr119++) {
+B->x[vr119] = w->x[vr119];
+        }
+
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+        }
+
+      }
+
+SetDeep();
+SetE(w->local_top);
+    }
+
+P+=0;
+goto r_dispatch;
+    }
+    }
+case 236:
+H = w->heap_top;
+goto w_op236;
+case 66:
+H = w->heap_top;
+goto w_op66;
+case 64:
+r_op64:
+w->local_top = 0;
+SetE(w->frame);
+P = w->next_insn;
+PROFILE__HOOK_PROCEED;
+P+=0;
+goto r_dispatch;
+#if defined(PARBACK)
+case 262:
+w->heap_top = TaggedToPointer(w->choice->x[0]);
+H = w->heap_top;
+P = (bcp_t)*TaggedToPointer(w->choice->x[0]);
+w->next_insn = w->choice->next_insn;
+pop_choicept(w);
+goto enter_predicate;
+#endif
+default:
+goto illop;
+  }
+  }
+w_tryeach:
+{
+#if defined(GAUGE)
+INCR_COUNTER(alts->entry_counter);
+#endif
+CLAUSE_COUNTERS__HOOK(alts,CLAUSE_COUNTERS__TRY);
+P = alts->emul_p;
+w->previous_choice = w->choice;
+try_node_t * vr120 = alts->next;
+if (vr120!=NULL) {
+B = w->choice;
+GetFrameTop(w->local_top,B,G->frame);
+CODE_CHOICE_NEW0(B,vr120,H);
+ON_DEBUG({
+if (debug_choicepoints) {
+fprintf(stderr,"WAM created choicepoint (r), node = %p\n",w->choice);
+      }
+
+    }
+);
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+    }
+
+  }
+ else {
+SetDeep();
+  }
+
+goto w_dispatch;
+  }
+w_dispatch:
+{
+switch (BcOPCODE) {
+case 260:
+{
+w_op260:
+{
+CODE_ALLOC(E);
+for (intmach_t vr121 = BcP(f_e,0)-sizeof(tagged_t);
+vr121>=EToY0*sizeof(tagged_t);vr121-=sizeof(tagged_t)) {
+LoadSVA(Yb(vr121));
+    }
+
+goto firsttrue;
+    }
+    }
+case 261:
+{
+w_op261:
+{
+intmach_t vr122 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+P+=Fs(f_i);
+for (intmach_t vr123 = vr122;
+vr123>0;vr123--) {
+tagged_t vr124 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr124));
+    }
+
+goto firsttrue;
+firsttrue:
+E->next_insn = w->next_insn;
+E->frame = w->frame;
+w->frame = E;
+w->next_insn = BCoff(P,Fs(f_e));
+w->local_top = StackCharOffset(E,BcP(f_e,0));
+if (OffStacktop(E,Stack_Warn)) {
+SetEvent();
+    }
+
+P+=Fs(f_e);
+goto w_dispatch;
+    }
+    }
+case 0:
+P+=Fs(f_Q);
+goto w_op1;
+case 1:
+{
+w_op1:
+{
+CODE_ALLOC(E);
+for (intmach_t vr125 = BcP(f_e,0+Fs(f_E))-sizeof(tagged_t);
+vr125>=EToY0*sizeof(tagged_t);vr125-=sizeof(tagged_t)) {
+LoadSVA(Yb(vr125));
+    }
+
+goto w_op3;
+    }
+    }
+case 20:
+P+=Fs(f_Q);
+goto w_op21;
+case 21:
+{
+w_op21:
+{
+intmach_t vr126 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+P+=Fs(f_i);
+for (intmach_t vr127 = vr126;
+vr127>8;vr127--) {
+tagged_t vr128 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr128));
+    }
+
+goto w_op19;
+    }
+    }
+case 18:
+P+=Fs(f_Q);
+goto w_op19;
+case 19:
+{
+w_op19:
+{
+{
+tagged_t vr129 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr129));
+    }
+goto w_op17;
+    }
+    }
+case 16:
+P+=Fs(f_Q);
+goto w_op17;
+case 17:
+{
+w_op17:
+{
+{
+tagged_t vr130 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr130));
+    }
+goto w_op15;
+    }
+    }
+case 14:
+P+=Fs(f_Q);
+goto w_op15;
+case 15:
+{
+w_op15:
+{
+{
+tagged_t vr131 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr131));
+    }
+goto w_op13;
+    }
+    }
+case 12:
+P+=Fs(f_Q);
+goto w_op13;
+case 13:
+{
+w_op13:
+{
+{
+tagged_t vr132 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr132));
+    }
+goto w_op11;
+    }
+    }
+case 10:
+P+=Fs(f_Q);
+goto w_op11;
+case 11:
+{
+w_op11:
+{
+{
+tagged_t vr133 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr133));
+    }
+goto w_op9;
+    }
+    }
+case 8:
+P+=Fs(f_Q);
+goto w_op9;
+case 9:
+{
+w_op9:
+{
+{
+tagged_t vr134 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr134));
+    }
+goto w_op7;
+    }
+    }
+case 6:
+P+=Fs(f_Q);
+goto w_op7;
+case 7:
+{
+w_op7:
+{
+{
+tagged_t vr135 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr135));
+    }
+goto w_op5;
+    }
+    }
+case 4:
+P+=Fs(f_Q);
+goto w_op5;
+case 5:
+{
+w_op5:
+{
+{
+tagged_t vr136 = BcP(f_y,0);
+P+=Fs(f_y);
+LoadSVA(Yb(vr136));
+    }
+goto w_op3;
+    }
+    }
+case 2:
+P+=Fs(f_Q);
+goto w_op3;
+case 3:
+w_op3:
+E->next_insn = w->next_insn;
+E->frame = w->frame;
+w->frame = E;
+w->next_insn = BCoff(P,Fs(f_E)+Fs(f_e));
+w->local_top = StackCharOffset(E,BcP(f_e,0+Fs(f_E)));
+if (OffStacktop(E,Stack_Warn)) {
+SetEvent();
+    }
+
+P = BcP(f_p,0);
+goto enter_predicate;
+case 40:
+P+=Fs(f_Q);
+goto w_op41;
+case 41:
+{
+w_op41:
+{
+intmach_t vr137 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+P+=Fs(f_i);
+for (intmach_t vr138 = vr137;
+vr138>8;vr138--) {
+tagged_t vr139 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr139&1) {
+tagged_t vr140;
+tagged_t vr141;
+vr140 = Yb(vr139+1);
+if (TaggedIsSVA(vr140)) {
+do {
+RefSVA(vr141,vr140);
+if (vr141==vr140) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr140)) {
+LoadHVA(vr140,H);
+BindSVA(vr141,vr140);
+              }
+
+break;
+            }
+
+vr140 = vr141;
+          }
+ while (TaggedIsSVA(vr140));
+        }
+
+X(vr138-1) = vr140;
+      }
+ else {
+X(vr138-1) = Yb(vr139);
+      }
+
+    }
+
+goto w_op39;
+    }
+    }
+case 38:
+P+=Fs(f_Q);
+goto w_op39;
+case 39:
+{
+w_op39:
+{
+{
+tagged_t vr142 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr142&1) {
+tagged_t vr143;
+tagged_t vr144;
+vr143 = Yb(vr142+1);
+if (TaggedIsSVA(vr143)) {
+do {
+RefSVA(vr144,vr143);
+if (vr144==vr143) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr143)) {
+LoadHVA(vr143,H);
+BindSVA(vr144,vr143);
+            }
+
+break;
+          }
+
+vr143 = vr144;
+        }
+ while (TaggedIsSVA(vr143));
+      }
+
+X(7) = vr143;
+    }
+ else {
+X(7) = Yb(vr142);
+    }
+
+    }
+goto w_op37;
+    }
+    }
+case 36:
+P+=Fs(f_Q);
+goto w_op37;
+case 37:
+{
+w_op37:
+{
+{
+tagged_t vr145 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr145&1) {
+tagged_t vr146;
+tagged_t vr147;
+vr146 = Yb(vr145+1);
+if (TaggedIsSVA(vr146)) {
+do {
+RefSVA(vr147,vr146);
+if (vr147==vr146) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr146)) {
+LoadHVA(vr146,H);
+BindSVA(vr147,vr146);
+            }
+
+break;
+          }
+
+vr146 = vr147;
+        }
+ while (TaggedIsSVA(vr146));
+      }
+
+X(6) = vr146;
+    }
+ else {
+X(6) = Yb(vr145);
+    }
+
+    }
+goto w_op35;
+    }
+    }
+case 34:
+P+=Fs(f_Q);
+goto w_op35;
+case 35:
+{
+w_op35:
+{
+{
+tagged_t vr148 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr148&1) {
+tagged_t vr149;
+tagged_t vr150;
+vr149 = Yb(vr148+1);
+if (TaggedIsSVA(vr149)) {
+do {
+RefSVA(vr150,vr149);
+if (vr150==vr149) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr149)) {
+LoadHVA(vr149,H);
+BindSVA(vr150,vr149);
+            }
+
+break;
+          }
+
+vr149 = vr150;
+        }
+ while (TaggedIsSVA(vr149));
+      }
+
+X(5) = vr149;
+    }
+ else {
+X(5) = Yb(vr148);
+    }
+
+    }
+goto w_op33;
+    }
+    }
+case 32:
+P+=Fs(f_Q);
+goto w_op33;
+case 33:
+{
+w_op33:
+{
+{
+tagged_t vr151 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr151&1) {
+tagged_t vr152;
+tagged_t vr153;
+vr152 = Yb(vr151+1);
+if (TaggedIsSVA(vr152)) {
+do {
+RefSVA(vr153,vr152);
+if (vr153==vr152) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr152)) {
+LoadHVA(vr152,H);
+BindSVA(vr153,vr152);
+            }
+
+break;
+          }
+
+vr152 = vr153;
+        }
+ while (TaggedIsSVA(vr152));
+      }
+
+X(4) = vr152;
+    }
+ else {
+X(4) = Yb(vr151);
+    }
+
+    }
+goto w_op31;
+    }
+    }
+case 30:
+P+=Fs(f_Q);
+goto w_op31;
+case 31:
+{
+w_op31:
+{
+{
+tagged_t vr154 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr154&1) {
+tagged_t vr155;
+tagged_t vr156;
+vr155 = Yb(vr154+1);
+if (TaggedIsSVA(vr155)) {
+do {
+RefSVA(vr156,vr155);
+if (vr156==vr155) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr155)) {
+LoadHVA(vr155,H);
+BindSVA(vr156,vr155);
+            }
+
+break;
+          }
+
+vr155 = vr156;
+        }
+ while (TaggedIsSVA(vr155));
+      }
+
+X(3) = vr155;
+    }
+ else {
+X(3) = Yb(vr154);
+    }
+
+    }
+goto w_op29;
+    }
+    }
+case 28:
+P+=Fs(f_Q);
+goto w_op29;
+case 29:
+{
+w_op29:
+{
+{
+tagged_t vr157 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr157&1) {
+tagged_t vr158;
+tagged_t vr159;
+vr158 = Yb(vr157+1);
+if (TaggedIsSVA(vr158)) {
+do {
+RefSVA(vr159,vr158);
+if (vr159==vr158) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr158)) {
+LoadHVA(vr158,H);
+BindSVA(vr159,vr158);
+            }
+
+break;
+          }
+
+vr158 = vr159;
+        }
+ while (TaggedIsSVA(vr158));
+      }
+
+X(2) = vr158;
+    }
+ else {
+X(2) = Yb(vr157);
+    }
+
+    }
+goto w_op27;
+    }
+    }
+case 26:
+P+=Fs(f_Q);
+goto w_op27;
+case 27:
+{
+w_op27:
+{
+{
+tagged_t vr160 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr160&1) {
+tagged_t vr161;
+tagged_t vr162;
+vr161 = Yb(vr160+1);
+if (TaggedIsSVA(vr161)) {
+do {
+RefSVA(vr162,vr161);
+if (vr162==vr161) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr161)) {
+LoadHVA(vr161,H);
+BindSVA(vr162,vr161);
+            }
+
+break;
+          }
+
+vr161 = vr162;
+        }
+ while (TaggedIsSVA(vr161));
+      }
+
+X(1) = vr161;
+    }
+ else {
+X(1) = Yb(vr160);
+    }
+
+    }
+goto w_op25;
+    }
+    }
+case 24:
+P+=Fs(f_Q);
+goto w_op25;
+case 25:
+{
+w_op25:
+{
+{
+tagged_t vr163 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr163&1) {
+tagged_t vr164;
+tagged_t vr165;
+vr164 = Yb(vr163+1);
+if (TaggedIsSVA(vr164)) {
+do {
+RefSVA(vr165,vr164);
+if (vr165==vr164) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr164)) {
+LoadHVA(vr164,H);
+BindSVA(vr165,vr164);
+            }
+
+break;
+          }
+
+vr164 = vr165;
+        }
+ while (TaggedIsSVA(vr164));
+      }
+
+X(0) = vr164;
+    }
+ else {
+X(0) = Yb(vr163);
+    }
+
+    }
+goto w_op23;
+    }
+    }
+case 22:
+P+=Fs(f_Q);
+goto w_op23;
+case 23:
+w_op23:
+w->next_insn = BCoff(P,Fs(f_E)+Fs(f_e));
+P = BcP(f_p,0);
+goto enter_predicate;
+case 60:
+P+=Fs(f_Q);
+goto w_op61;
+case 61:
+{
+w_op61:
+{
+intmach_t vr166 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+P+=Fs(f_i);
+for (intmach_t vr167 = vr166;
+vr167>8;vr167--) {
+tagged_t vr168 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr168&1) {
+tagged_t vr169;
+tagged_t vr170;
+vr169 = Yb(vr168+1);
+if (TaggedIsSVA(vr169)) {
+do {
+RefSVA(vr170,vr169);
+if (vr170==vr169) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr169)) {
+LoadHVA(vr169,H);
+BindSVA(vr170,vr169);
+              }
+
+break;
+            }
+
+vr169 = vr170;
+          }
+ while (TaggedIsSVA(vr169));
+        }
+
+X(vr167-1) = vr169;
+      }
+ else {
+X(vr167-1) = Yb(vr168);
+      }
+
+    }
+
+goto w_op59;
+    }
+    }
+case 58:
+P+=Fs(f_Q);
+goto w_op59;
+case 59:
+{
+w_op59:
+{
+{
+tagged_t vr171 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr171&1) {
+tagged_t vr172;
+tagged_t vr173;
+vr172 = Yb(vr171+1);
+if (TaggedIsSVA(vr172)) {
+do {
+RefSVA(vr173,vr172);
+if (vr173==vr172) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr172)) {
+LoadHVA(vr172,H);
+BindSVA(vr173,vr172);
+            }
+
+break;
+          }
+
+vr172 = vr173;
+        }
+ while (TaggedIsSVA(vr172));
+      }
+
+X(7) = vr172;
+    }
+ else {
+X(7) = Yb(vr171);
+    }
+
+    }
+goto w_op57;
+    }
+    }
+case 56:
+P+=Fs(f_Q);
+goto w_op57;
+case 57:
+{
+w_op57:
+{
+{
+tagged_t vr174 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr174&1) {
+tagged_t vr175;
+tagged_t vr176;
+vr175 = Yb(vr174+1);
+if (TaggedIsSVA(vr175)) {
+do {
+RefSVA(vr176,vr175);
+if (vr176==vr175) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr175)) {
+LoadHVA(vr175,H);
+BindSVA(vr176,vr175);
+            }
+
+break;
+          }
+
+vr175 = vr176;
+        }
+ while (TaggedIsSVA(vr175));
+      }
+
+X(6) = vr175;
+    }
+ else {
+X(6) = Yb(vr174);
+    }
+
+    }
+goto w_op55;
+    }
+    }
+case 54:
+P+=Fs(f_Q);
+goto w_op55;
+case 55:
+{
+w_op55:
+{
+{
+tagged_t vr177 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr177&1) {
+tagged_t vr178;
+tagged_t vr179;
+vr178 = Yb(vr177+1);
+if (TaggedIsSVA(vr178)) {
+do {
+RefSVA(vr179,vr178);
+if (vr179==vr178) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr178)) {
+LoadHVA(vr178,H);
+BindSVA(vr179,vr178);
+            }
+
+break;
+          }
+
+vr178 = vr179;
+        }
+ while (TaggedIsSVA(vr178));
+      }
+
+X(5) = vr178;
+    }
+ else {
+X(5) = Yb(vr177);
+    }
+
+    }
+goto w_op53;
+    }
+    }
+case 52:
+P+=Fs(f_Q);
+goto w_op53;
+case 53:
+{
+w_op53:
+{
+{
+tagged_t vr180 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr180&1) {
+tagged_t vr181;
+tagged_t vr182;
+vr181 = Yb(vr180+1);
+if (TaggedIsSVA(vr181)) {
+do {
+RefSVA(vr182,vr181);
+if (vr182==vr181) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr181)) {
+LoadHVA(vr181,H);
+BindSVA(vr182,vr181);
+            }
+
+break;
+          }
+
+vr181 = vr182;
+        }
+ while (TaggedIsSVA(vr181));
+      }
+
+X(4) = vr181;
+    }
+ else {
+X(4) = Yb(vr180);
+    }
+
+    }
+goto w_op51;
+    }
+    }
+case 50:
+P+=Fs(f_Q);
+goto w_op51;
+case 51:
+{
+w_op51:
+{
+{
+tagged_t vr183 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr183&1) {
+tagged_t vr184;
+tagged_t vr185;
+vr184 = Yb(vr183+1);
+if (TaggedIsSVA(vr184)) {
+do {
+RefSVA(vr185,vr184);
+if (vr185==vr184) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr184)) {
+LoadHVA(vr184,H);
+BindSVA(vr185,vr184);
+            }
+
+break;
+          }
+
+vr184 = vr185;
+        }
+ while (TaggedIsSVA(vr184));
+      }
+
+X(3) = vr184;
+    }
+ else {
+X(3) = Yb(vr183);
+    }
+
+    }
+goto w_op49;
+    }
+    }
+case 48:
+P+=Fs(f_Q);
+goto w_op49;
+case 49:
+{
+w_op49:
+{
+{
+tagged_t vr186 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr186&1) {
+tagged_t vr187;
+tagged_t vr188;
+vr187 = Yb(vr186+1);
+if (TaggedIsSVA(vr187)) {
+do {
+RefSVA(vr188,vr187);
+if (vr188==vr187) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr187)) {
+LoadHVA(vr187,H);
+BindSVA(vr188,vr187);
+            }
+
+break;
+          }
+
+vr187 = vr188;
+        }
+ while (TaggedIsSVA(vr187));
+      }
+
+X(2) = vr187;
+    }
+ else {
+X(2) = Yb(vr186);
+    }
+
+    }
+goto w_op47;
+    }
+    }
+case 46:
+P+=Fs(f_Q);
+goto w_op47;
+case 47:
+{
+w_op47:
+{
+{
+tagged_t vr189 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr189&1) {
+tagged_t vr190;
+tagged_t vr191;
+vr190 = Yb(vr189+1);
+if (TaggedIsSVA(vr190)) {
+do {
+RefSVA(vr191,vr190);
+if (vr191==vr190) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr190)) {
+LoadHVA(vr190,H);
+BindSVA(vr191,vr190);
+            }
+
+break;
+          }
+
+vr190 = vr191;
+        }
+ while (TaggedIsSVA(vr190));
+      }
+
+X(1) = vr190;
+    }
+ else {
+X(1) = Yb(vr189);
+    }
+
+    }
+goto w_op45;
+    }
+    }
+case 44:
+P+=Fs(f_Q);
+goto w_op45;
+case 45:
+{
+w_op45:
+{
+{
+tagged_t vr192 = BcP(f_z,0);
+P+=Fs(f_z);
+if (vr192&1) {
+tagged_t vr193;
+tagged_t vr194;
+vr193 = Yb(vr192+1);
+if (TaggedIsSVA(vr193)) {
+do {
+RefSVA(vr194,vr193);
+if (vr194==vr193) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr193)) {
+LoadHVA(vr193,H);
+BindSVA(vr194,vr193);
+            }
+
+break;
+          }
+
+vr193 = vr194;
+        }
+ while (TaggedIsSVA(vr193));
+      }
+
+X(0) = vr193;
+    }
+ else {
+X(0) = Yb(vr192);
+    }
+
+    }
+goto w_op43;
+    }
+    }
+case 42:
+P+=Fs(f_Q);
+goto w_op43;
+case 43:
+w_op43:
+w->next_insn = E->next_insn;
+w->frame = E->frame;
+goto w_op63;
+case 62:
+P = BcP(f_p,0+Fs(f_Q));
+goto enter_predicate;
+case 63:
+w_op63:
+P = BcP(f_p,0);
+goto enter_predicate;
+case 69:
+w_op69:
+LoadHVA(Xb(BcP(f_x,0)),H);
+P+=Fs(f_x);
+goto w_dispatch;
+case 70:
+{
+w_op70:
+{
+{
+tagged_t vr195;
+vr195 = Tagp(HVA,H);
+Xb(BcP(f_x,0+Fs(f_x))) = vr195;
+Xb(BcP(f_x,0)) = vr195;
+HeapPush(H,vr195);
+    }
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 85:
+Xb(BcP(f_x,0)) = Xb(BcP(f_x,0+Fs(f_x)));
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x))) = Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 71:
+Xb(BcP(f_x,0)) = Xb(BcP(f_x,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 72:
+{
+w_op72:
+{
+tagged_t vr196;
+tagged_t vr197;
+tagged_t vr198;
+vr197 = Xb(BcP(f_x,0+Fs(f_x)));
+if (TaggedIsSVA(vr197)) {
+do {
+RefSVA(vr198,vr197);
+if (vr198==vr197) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr197)) {
+LoadHVA(vr197,H);
+BindSVA(vr198,vr197);
+          }
+
+break;
+        }
+
+vr197 = vr198;
+      }
+ while (TaggedIsSVA(vr197));
+    }
+
+vr196 = vr197;
+Xb(BcP(f_x,0)) = vr196;
+Xb(BcP(f_x,0+Fs(f_x))) = vr196;
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 73:
+w_op73:
+CODE_ALLOC(E);
+goto w_op74;
+case 74:
+{
+w_op74:
+{
+{
+tagged_t vr199;
+vr199 = Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x))));
+Yb(BcP(f_y,0+Fs(f_x))) = vr199;
+Xb(BcP(f_x,0)) = vr199;
+    }
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 83:
+w_op83:
+CODE_ALLOC(E);
+goto w_op84;
+case 84:
+{
+w_op84:
+{
+{
+tagged_t vr200;
+vr200 = Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x))));
+Yb(BcP(f_y,0+Fs(f_x))) = vr200;
+Xb(BcP(f_x,0)) = vr200;
+    }
+{
+tagged_t vr201;
+vr201 = Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x))));
+Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x))) = vr201;
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y))) = vr201;
+    }
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 75:
+Xb(BcP(f_x,0)) = Yb(BcP(f_y,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 76:
+{
+w_op76:
+{
+tagged_t vr202;
+tagged_t vr203;
+vr202 = Yb(BcP(f_y,0+Fs(f_x)));
+if (TaggedIsSVA(vr202)) {
+do {
+RefSVA(vr203,vr202);
+if (vr203==vr202) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr202)) {
+LoadHVA(vr202,H);
+BindSVA(vr203,vr202);
+          }
+
+break;
+        }
+
+vr202 = vr203;
+      }
+ while (TaggedIsSVA(vr202));
+    }
+
+Xb(BcP(f_x,0)) = vr202;
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 77:
+Xb(BcP(f_x,0+Fs(f_Q))) = BcP(f_t,0+Fs(f_Q)+Fs(f_x));
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_t);
+goto w_dispatch;
+case 78:
+Xb(BcP(f_x,0)) = BcP(f_t,0+Fs(f_x));
+P+=Fs(f_x)+Fs(f_t);
+goto w_dispatch;
+case 81:
+Xb(BcP(f_x,0)) = atom_nil;
+P+=Fs(f_x);
+goto w_dispatch;
+case 252:
+w_op252:
+w->heap_top = H;
+Xb(BcP(f_x,0+Fs(f_Q))) = BC_MakeBlob(w,&BcP(f_t,0+Fs(f_Q)+Fs(f_x)));
+H = w->heap_top;
+P+=Fs(f_Q)+Fs(f_x)+LargeSize(*&BcP(f_t,0+Fs(f_Q)+Fs(f_x)));
+goto w_dispatch;
+case 253:
+w_op253:
+w->heap_top = H;
+Xb(BcP(f_x,0)) = BC_MakeBlob(w,&BcP(f_t,0+Fs(f_x)));
+H = w->heap_top;
+P+=Fs(f_x)+LargeSize(*&BcP(f_t,0+Fs(f_x)));
+goto w_dispatch;
+case 79:
+w_op79:
+Xb(BcP(f_x,0+Fs(f_Q))) = Tagp(STR,H);
+HeapPush(H,BcP(f_f,0+Fs(f_Q)+Fs(f_x)));
+P+=Fs(f_Q)+Fs(f_x)+Fs(f_f);
+goto w_dispatch;
+case 80:
+w_op80:
+Xb(BcP(f_x,0)) = Tagp(STR,H);
+HeapPush(H,BcP(f_f,0+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_f);
+goto w_dispatch;
+case 82:
+w_op82:
+Xb(BcP(f_x,0)) = Tagp(LST,H);
+P+=Fs(f_x);
+goto w_dispatch;
+case 86:
+Xb(BcP(f_x,0)) = Yb(BcP(f_y,0+Fs(f_x)));
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y))) = Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 87:
+{
+w_op87:
+{
+Xb(BcP(f_x,0)) = Yb(BcP(f_y,0+Fs(f_x)));
+tagged_t vr204;
+tagged_t vr205;
+vr204 = Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x)));
+if (TaggedIsSVA(vr204)) {
+do {
+RefSVA(vr205,vr204);
+if (vr205==vr204) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr204)) {
+LoadHVA(vr204,H);
+BindSVA(vr205,vr204);
+          }
+
+break;
+        }
+
+vr204 = vr205;
+      }
+ while (TaggedIsSVA(vr204));
+    }
+
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y))) = vr204;
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 88:
+{
+w_op88:
+{
+tagged_t vr206;
+tagged_t vr207;
+vr206 = Yb(BcP(f_y,0+Fs(f_x)));
+if (TaggedIsSVA(vr206)) {
+do {
+RefSVA(vr207,vr206);
+if (vr207==vr206) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr206)) {
+LoadHVA(vr206,H);
+BindSVA(vr207,vr206);
+          }
+
+break;
+        }
+
+vr206 = vr207;
+      }
+ while (TaggedIsSVA(vr206));
+    }
+
+Xb(BcP(f_x,0)) = vr206;
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y))) = Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 89:
+{
+w_op89:
+{
+tagged_t vr208;
+tagged_t vr209;
+vr208 = Yb(BcP(f_y,0+Fs(f_x)));
+if (TaggedIsSVA(vr208)) {
+do {
+RefSVA(vr209,vr208);
+if (vr209==vr208) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr208)) {
+LoadHVA(vr208,H);
+BindSVA(vr209,vr208);
+          }
+
+break;
+        }
+
+vr208 = vr209;
+      }
+ while (TaggedIsSVA(vr208));
+    }
+
+Xb(BcP(f_x,0)) = vr208;
+tagged_t vr210;
+tagged_t vr211;
+vr210 = Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x)));
+if (TaggedIsSVA(vr210)) {
+do {
+RefSVA(vr211,vr210);
+if (vr211==vr210) {
+if (!YoungerStackVar(Tagp(SVA,Offset(E,EToY0)),vr210)) {
+LoadHVA(vr210,H);
+BindSVA(vr211,vr210);
+          }
+
+break;
+        }
+
+vr210 = vr211;
+      }
+ while (TaggedIsSVA(vr210));
+    }
+
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y))) = vr210;
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 91:
+w->heap_top = H;
+goto r_op91;
+case 94:
+w->heap_top = H;
+goto r_op94;
+case 95:
+w->heap_top = H;
+goto r_op95;
+case 96:
+P+=Fs(f_Q);
+goto w_op97;
+case 97:
+w_op97:
+w->heap_top = H;
+goto r_op97;
+case 254:
+P+=Fs(f_Q);
+goto w_op255;
+case 255:
+w_op255:
+w->heap_top = H;
+goto r_op255;
+case 98:
+P+=Fs(f_Q);
+goto w_op99;
+case 99:
+w_op99:
+w->heap_top = H;
+goto r_op99;
+case 100:
+w->heap_top = H;
+goto r_op100;
+case 101:
+w->heap_top = H;
+goto r_op101;
+case 111:
+P+=Fs(f_Q);
+goto w_op112;
+case 112:
+w_op112:
+w->heap_top = H;
+goto r_op112;
+case 113:
+w->heap_top = H;
+goto r_op113;
+case 208:
+w->heap_top = H;
+goto r_op208;
+case 210:
+w->heap_top = H;
+goto r_op210;
+case 211:
+w->heap_top = H;
+goto r_op211;
+case 212:
+w->heap_top = H;
+goto r_op212;
+case 213:
+w->heap_top = H;
+goto r_op213;
+case 214:
+w->heap_top = H;
+goto r_op214;
+case 216:
+w->heap_top = H;
+goto r_op216;
+case 217:
+w->heap_top = H;
+goto r_op217;
+case 215:
+w->heap_top = H;
+goto r_op215;
+case 209:
+w->heap_top = H;
+goto r_op209;
+case 218:
+w->heap_top = H;
+goto r_op218;
+case 219:
+Xb(BcP(f_x,0)) = ChoiceToTagged(w->previous_choice);
+P+=Fs(f_x);
+goto w_dispatch;
+case 220:
+CODE_ALLOC(E);
+goto w_op221;
+case 221:
+w_op221:
+Yb(BcP(f_y,0)) = ChoiceToTagged(w->previous_choice);
+P+=Fs(f_y);
+goto w_dispatch;
+case 233:
+{
+w_op233:
+{
+Setfunc(TaggedToFunctor(Y(0)));
+for (intmach_t vr212 = 0;
+vr212<Func->arity;vr212++) {
+X(vr212) = Y(vr212+1);
+    }
+
+w->next_insn = E->next_insn;
+w->frame = E->frame;
+goto enter_predicate;
+    }
+    }
+case 234:
+w->heap_top = H;
+goto r_op234;
+case 235:
+w->heap_top = H;
+goto r_op235;
+case 237:
+w->heap_top = H;
+goto r_op237;
+case 238:
+w->heap_top = H;
+goto r_op238;
+case 104:
+P+=Fs(f_Q);
+goto w_op105;
+case 105:
+{
+w_op105:
+{
+tagged_t vr213 = Tagp(STR,H);
+tagged_t vr214 = X(0);
+if (TaggedIsHVA(vr214)) {
+BindHVA(vr214,vr213);
+    }
+ else if (vr214&TagBitSVA) {
+BindSVA(vr214,vr213);
+    }
+ else {
+BindCVA(vr214,vr213);
+    }
+
+HeapPush(H,BcP(f_f,0));
+P+=Fs(f_f);
+goto w_dispatch;
+    }
+    }
+case 256:
+P+=Fs(f_Q);
+goto w_op257;
+case 257:
+{
+w_op257:
+{
+w->heap_top = H;
+tagged_t vr215 = BC_MakeBlob(w,&BcP(f_t,0));
+H = w->heap_top;
+tagged_t vr216 = X(0);
+if (TaggedIsHVA(vr216)) {
+BindHVA(vr216,vr215);
+    }
+ else if (vr216&TagBitSVA) {
+BindSVA(vr216,vr215);
+    }
+ else {
+BindCVA(vr216,vr215);
+    }
+
+P+=LargeSize(*&BcP(f_t,0));
+goto w_dispatch;
+    }
+    }
+case 102:
+P+=Fs(f_Q);
+goto w_op103;
+case 103:
+{
+w_op103:
+{
+tagged_t vr217 = X(0);
+if (TaggedIsHVA(vr217)) {
+BindHVA(vr217,BcP(f_t,0));
+    }
+ else if (vr217&TagBitSVA) {
+BindSVA(vr217,BcP(f_t,0));
+    }
+ else {
+BindCVA(vr217,BcP(f_t,0));
+    }
+
+P+=Fs(f_t);
+goto w_dispatch;
+    }
+    }
+case 106:
+{
+{
+tagged_t vr218 = X(0);
+if (TaggedIsHVA(vr218)) {
+BindHVA(vr218,atom_nil);
+    }
+ else if (vr218&TagBitSVA) {
+BindSVA(vr218,atom_nil);
+    }
+ else {
+BindCVA(vr218,atom_nil);
+    }
+
+P+=0;
+goto w_dispatch;
+    }
+    }
+case 107:
+{
+{
+tagged_t vr219 = Tagp(LST,H);
+tagged_t vr220 = X(0);
+if (TaggedIsHVA(vr220)) {
+BindHVA(vr220,vr219);
+    }
+ else if (vr220&TagBitSVA) {
+BindSVA(vr220,vr219);
+    }
+ else {
+BindCVA(vr220,vr219);
+    }
+
+P+=0;
+goto w_dispatch;
+    }
+    }
+case 108:
+Xb(BcP(f_x,0+Fs(f_x))) = Xb(BcP(f_x,0));
+Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x)+Fs(f_x))) = Xb(BcP(f_x,0+Fs(f_x)+Fs(f_x)));
+P+=Fs(f_x)+Fs(f_x)+Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 90:
+Xb(BcP(f_x,0+Fs(f_x))) = Xb(BcP(f_x,0));
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 92:
+CODE_ALLOC(E);
+goto w_op93;
+case 93:
+w_op93:
+Yb(BcP(f_y,0+Fs(f_x))) = Xb(BcP(f_x,0));
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 109:
+CODE_ALLOC(E);
+goto w_op110;
+case 110:
+w_op110:
+Yb(BcP(f_y,0+Fs(f_x))) = Xb(BcP(f_x,0));
+Yb(BcP(f_y,0+Fs(f_x)+Fs(f_y)+Fs(f_x))) = Xb(BcP(f_x,0+Fs(f_x)+Fs(f_y)));
+P+=Fs(f_x)+Fs(f_y)+Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 68:
+P = BCoff(P,BcP(f_i,0));
+goto w_dispatch;
+case 222:
+w->heap_top = H;
+goto r_op222;
+case 223:
+w->heap_top = H;
+goto r_op223;
+case 224:
+w->heap_top = H;
+goto r_op224;
+case 225:
+w->heap_top = H;
+goto r_op225;
+case 226:
+w->heap_top = H;
+goto r_op226;
+case 227:
+w->heap_top = H;
+goto r_op227;
+case 228:
+w->heap_top = H;
+goto r_op228;
+case 229:
+w->heap_top = H;
+goto r_op229;
+case 230:
+w->heap_top = H;
+goto r_op230;
+case 231:
+w->heap_top = H;
+goto r_op231;
+case 240:
+w->heap_top = H;
+goto r_op240;
+case 241:
+w->heap_top = H;
+goto r_op241;
+case 242:
+w->heap_top = H;
+goto r_op242;
+case 243:
+w->heap_top = H;
+goto r_op243;
+case 232:
+w->heap_top = H;
+goto r_op232;
+case 247:
+{
+w_op247:
+{
+tagged_t vr221 = Xb(BcP(f_x,0));
+tagged_t vr222;
+LoadCVA(vr222,H);
+DerefSw_HVA_CVA_SVA_Other(vr221,{
+BindHVA(vr221,vr222);
+Xb(BcP(f_x,0)) = vr222;
+    }
+,{
+BindCVA(vr222,vr221);
+    }
+,{
+BindSVA(vr221,vr222);
+Xb(BcP(f_x,0)) = vr222;
+    }
+,{
+BindCVA(vr222,vr221);
+    }
+);
+P+=Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 114:
+{
+{
+intmach_t vr223 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+P+=Fs(f_i);
+for (intmach_t vr224 = vr223;
+vr224>4;vr224--) {
+ConstrHVA(H);
+    }
+
+goto w_op118;
+    }
+    }
+case 115:
+w_op115:
+ConstrHVA(H);
+P+=0;
+goto w_dispatch;
+case 116:
+w_op116:
+ConstrHVA(H);
+goto w_op115;
+case 117:
+w_op117:
+ConstrHVA(H);
+goto w_op116;
+case 118:
+w_op118:
+ConstrHVA(H);
+goto w_op117;
+case 119:
+LoadHVA(Xb(BcP(f_x,0)),H);
+P+=Fs(f_x);
+goto w_dispatch;
+case 120:
+HeapPush(H,Xb(BcP(f_x,0)));
+P+=Fs(f_x);
+goto w_dispatch;
+case 121:
+{
+{
+{tagged_t vr225 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr225)) {
+tagged_t vr226;
+do {
+RefSVA(vr226,vr225);
+if (vr226==vr225) {
+BindSVA(vr225,Tagp(HVA,H));
+PreLoadHVA(vr225,H);
+break;
+        }
+
+vr225 = vr226;
+      }
+ while (TaggedIsSVA(vr225));
+    }
+
+HeapPush(H,vr225);
+}P+=Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 122:
+CODE_ALLOC(E);
+goto w_op123;
+case 123:
+w_op123:
+LoadHVA(Yb(BcP(f_y,0)),H);
+P+=Fs(f_y);
+goto w_dispatch;
+case 124:
+{
+{
+{tagged_t vr227;
+LoadHVA(vr227,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr227;
+}P+=Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 125:
+HeapPush(H,Yb(BcP(f_y,0)));
+P+=Fs(f_y);
+goto w_dispatch;
+case 126:
+{
+{
+{tagged_t vr228 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr228)) {
+tagged_t vr229;
+do {
+RefSVA(vr229,vr228);
+if (vr229==vr228) {
+BindSVA(vr228,Tagp(HVA,H));
+PreLoadHVA(vr228,H);
+break;
+        }
+
+vr228 = vr229;
+      }
+ while (TaggedIsSVA(vr228));
+    }
+
+HeapPush(H,vr228);
+}P+=Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 127:
+HeapPush(H,BcP(f_t,0+Fs(f_Q)));
+P+=Fs(f_Q)+Fs(f_t);
+goto w_dispatch;
+case 128:
+HeapPush(H,BcP(f_t,0));
+P+=Fs(f_t);
+goto w_dispatch;
+case 258:
+P+=Fs(f_Q);
+goto w_op259;
+case 259:
+w_op259:
+w->heap_top = HeapOffset(H,1);
+*H = BC_MakeBlob(w,&BcP(f_t,0));
+P+=LargeSize(*&BcP(f_t,0));
+goto r_dispatch;
+case 129:
+HeapPush(H,Tagp(STR,HeapOffset(H,1)));
+HeapPush(H,BcP(f_f,0+Fs(f_Q)));
+P+=Fs(f_Q)+Fs(f_f);
+goto w_dispatch;
+case 130:
+HeapPush(H,Tagp(STR,HeapOffset(H,1)));
+HeapPush(H,BcP(f_f,0));
+P+=Fs(f_f);
+goto w_dispatch;
+case 131:
+HeapPush(H,atom_nil);
+P+=0;
+goto w_dispatch;
+case 132:
+HeapPush(H,Tagp(LST,HeapOffset(H,1)));
+P+=0;
+goto w_dispatch;
+case 133:
+HeapPush(H,BcP(f_t,0+Fs(f_Q)));
+goto w_op66;
+case 134:
+HeapPush(H,BcP(f_t,0));
+goto w_op66;
+case 135:
+HeapPush(H,atom_nil);
+goto w_op66;
+case 136:
+{
+{
+intmach_t vr230 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr230);
+LoadHVA(Xb(BcP(f_x,0+Fs(f_i))),H);
+P+=Fs(f_i)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 139:
+CODE_ALLOC(E);
+goto w_op140;
+case 140:
+{
+w_op140:
+{
+intmach_t vr231 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr231);
+LoadHVA(Yb(BcP(f_y,0+Fs(f_i))),H);
+P+=Fs(f_i)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 137:
+{
+{
+intmach_t vr232 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr232);
+HeapPush(H,Xb(BcP(f_x,0+Fs(f_i))));
+P+=Fs(f_i)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 138:
+{
+{
+intmach_t vr233 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr233);
+{tagged_t vr234 = Xb(BcP(f_x,0+Fs(f_i)));
+if (TaggedIsSVA(vr234)) {
+tagged_t vr235;
+do {
+RefSVA(vr235,vr234);
+if (vr235==vr234) {
+BindSVA(vr234,Tagp(HVA,H));
+PreLoadHVA(vr234,H);
+break;
+        }
+
+vr234 = vr235;
+      }
+ while (TaggedIsSVA(vr234));
+    }
+
+HeapPush(H,vr234);
+}P+=Fs(f_i)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 141:
+{
+{
+intmach_t vr236 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr236);
+{tagged_t vr237;
+LoadHVA(vr237,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_i))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_i)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_i))) = vr237;
+}P+=Fs(f_i)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 142:
+{
+{
+intmach_t vr238 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr238);
+HeapPush(H,Yb(BcP(f_y,0+Fs(f_i))));
+P+=Fs(f_i)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 143:
+{
+{
+intmach_t vr239 = (FTYPE_ctype(f_i_signed))BcP(f_i,0);
+do {
+ConstrHVA(H);
+    }
+ while (--vr239);
+{tagged_t vr240 = Yb(BcP(f_y,0+Fs(f_i)));
+if (TaggedIsSVA(vr240)) {
+tagged_t vr241;
+do {
+RefSVA(vr241,vr240);
+if (vr241==vr240) {
+BindSVA(vr240,Tagp(HVA,H));
+PreLoadHVA(vr240,H);
+break;
+        }
+
+vr240 = vr241;
+      }
+ while (TaggedIsSVA(vr240));
+    }
+
+HeapPush(H,vr240);
+}P+=Fs(f_i)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 144:
+{
+{
+LoadHVA(Xb(BcP(f_x,0)),H);
+intmach_t vr242 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_x));
+do {
+ConstrHVA(H);
+    }
+ while (--vr242);
+P+=Fs(f_x)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 145:
+LoadHVA(Xb(BcP(f_x,0)),H);
+LoadHVA(Xb(BcP(f_x,0+Fs(f_x))),H);
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 148:
+CODE_ALLOC(E);
+goto w_op149;
+case 149:
+w_op149:
+LoadHVA(Xb(BcP(f_x,0)),H);
+LoadHVA(Yb(BcP(f_y,0+Fs(f_x))),H);
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 146:
+LoadHVA(Xb(BcP(f_x,0)),H);
+HeapPush(H,Xb(BcP(f_x,0+Fs(f_x))));
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 147:
+{
+{
+LoadHVA(Xb(BcP(f_x,0)),H);
+{tagged_t vr243 = Xb(BcP(f_x,0+Fs(f_x)));
+if (TaggedIsSVA(vr243)) {
+tagged_t vr244;
+do {
+RefSVA(vr244,vr243);
+if (vr244==vr243) {
+BindSVA(vr243,Tagp(HVA,H));
+PreLoadHVA(vr243,H);
+break;
+        }
+
+vr243 = vr244;
+      }
+ while (TaggedIsSVA(vr243));
+    }
+
+HeapPush(H,vr243);
+}P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 150:
+{
+{
+LoadHVA(Xb(BcP(f_x,0)),H);
+{tagged_t vr245;
+LoadHVA(vr245,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_x))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_x))) = vr245;
+}P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 151:
+LoadHVA(Xb(BcP(f_x,0)),H);
+HeapPush(H,Yb(BcP(f_y,0+Fs(f_x))));
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 152:
+{
+{
+LoadHVA(Xb(BcP(f_x,0)),H);
+{tagged_t vr246 = Yb(BcP(f_y,0+Fs(f_x)));
+if (TaggedIsSVA(vr246)) {
+tagged_t vr247;
+do {
+RefSVA(vr247,vr246);
+if (vr247==vr246) {
+BindSVA(vr246,Tagp(HVA,H));
+PreLoadHVA(vr246,H);
+break;
+        }
+
+vr246 = vr247;
+      }
+ while (TaggedIsSVA(vr246));
+    }
+
+HeapPush(H,vr246);
+}P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 153:
+CODE_ALLOC(E);
+goto w_op154;
+case 154:
+{
+w_op154:
+{
+LoadHVA(Yb(BcP(f_y,0)),H);
+intmach_t vr248 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_y));
+do {
+ConstrHVA(H);
+    }
+ while (--vr248);
+P+=Fs(f_y)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 155:
+CODE_ALLOC(E);
+goto w_op156;
+case 156:
+w_op156:
+LoadHVA(Yb(BcP(f_y,0)),H);
+LoadHVA(Xb(BcP(f_x,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+case 157:
+CODE_ALLOC(E);
+goto w_op158;
+case 158:
+w_op158:
+LoadHVA(Yb(BcP(f_y,0)),H);
+LoadHVA(Yb(BcP(f_y,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+case 159:
+CODE_ALLOC(E);
+goto w_op160;
+case 161:
+CODE_ALLOC(E);
+goto w_op162;
+case 160:
+w_op160:
+LoadHVA(Yb(BcP(f_y,0)),H);
+HeapPush(H,Xb(BcP(f_x,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+case 162:
+{
+w_op162:
+{
+LoadHVA(Yb(BcP(f_y,0)),H);
+{tagged_t vr249 = Xb(BcP(f_x,0+Fs(f_y)));
+if (TaggedIsSVA(vr249)) {
+tagged_t vr250;
+do {
+RefSVA(vr250,vr249);
+if (vr250==vr249) {
+BindSVA(vr249,Tagp(HVA,H));
+PreLoadHVA(vr249,H);
+break;
+        }
+
+vr249 = vr250;
+      }
+ while (TaggedIsSVA(vr249));
+    }
+
+HeapPush(H,vr249);
+}P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 163:
+CODE_ALLOC(E);
+goto w_op164;
+case 165:
+CODE_ALLOC(E);
+goto w_op166;
+case 164:
+w_op164:
+LoadHVA(Yb(BcP(f_y,0)),H);
+HeapPush(H,Yb(BcP(f_y,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+case 166:
+{
+w_op166:
+{
+LoadHVA(Yb(BcP(f_y,0)),H);
+{tagged_t vr251 = Yb(BcP(f_y,0+Fs(f_y)));
+if (TaggedIsSVA(vr251)) {
+tagged_t vr252;
+do {
+RefSVA(vr252,vr251);
+if (vr252==vr251) {
+BindSVA(vr251,Tagp(HVA,H));
+PreLoadHVA(vr251,H);
+break;
+        }
+
+vr251 = vr252;
+      }
+ while (TaggedIsSVA(vr251));
+    }
+
+HeapPush(H,vr251);
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 185:
+{
+{
+{tagged_t vr253;
+LoadHVA(vr253,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr253;
+}intmach_t vr254 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_y));
+do {
+ConstrHVA(H);
+    }
+ while (--vr254);
+P+=Fs(f_y)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 188:
+{
+{
+{tagged_t vr255;
+LoadHVA(vr255,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr255;
+}LoadHVA(Xb(BcP(f_x,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 199:
+{
+{
+{tagged_t vr256;
+LoadHVA(vr256,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr256;
+}{tagged_t vr257;
+LoadHVA(vr257,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_y))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_y)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_y))) = vr257;
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 193:
+{
+{
+{tagged_t vr258;
+LoadHVA(vr258,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr258;
+}HeapPush(H,Xb(BcP(f_x,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 196:
+{
+{
+{tagged_t vr259;
+LoadHVA(vr259,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr259;
+}{tagged_t vr260 = Xb(BcP(f_x,0+Fs(f_y)));
+if (TaggedIsSVA(vr260)) {
+tagged_t vr261;
+do {
+RefSVA(vr261,vr260);
+if (vr261==vr260) {
+BindSVA(vr260,Tagp(HVA,H));
+PreLoadHVA(vr260,H);
+break;
+        }
+
+vr260 = vr261;
+      }
+ while (TaggedIsSVA(vr260));
+    }
+
+HeapPush(H,vr260);
+}P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 202:
+{
+{
+{tagged_t vr262;
+LoadHVA(vr262,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr262;
+}HeapPush(H,Yb(BcP(f_y,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 205:
+{
+{
+{tagged_t vr263;
+LoadHVA(vr263,H);
+if (CondStackvar(Yb(BcP(f_y,0)))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0))));
+    }
+
+Yb(BcP(f_y,0)) = vr263;
+}{tagged_t vr264 = Yb(BcP(f_y,0+Fs(f_y)));
+if (TaggedIsSVA(vr264)) {
+tagged_t vr265;
+do {
+RefSVA(vr265,vr264);
+if (vr265==vr264) {
+BindSVA(vr264,Tagp(HVA,H));
+PreLoadHVA(vr264,H);
+break;
+        }
+
+vr264 = vr265;
+      }
+ while (TaggedIsSVA(vr264));
+    }
+
+HeapPush(H,vr264);
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 167:
+{
+{
+HeapPush(H,Xb(BcP(f_x,0)));
+intmach_t vr266 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_x));
+do {
+ConstrHVA(H);
+    }
+ while (--vr266);
+P+=Fs(f_x)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 168:
+{
+{
+{tagged_t vr267 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr267)) {
+tagged_t vr268;
+do {
+RefSVA(vr268,vr267);
+if (vr268==vr267) {
+BindSVA(vr267,Tagp(HVA,H));
+PreLoadHVA(vr267,H);
+break;
+        }
+
+vr267 = vr268;
+      }
+ while (TaggedIsSVA(vr267));
+    }
+
+HeapPush(H,vr267);
+}intmach_t vr269 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_x));
+do {
+ConstrHVA(H);
+    }
+ while (--vr269);
+P+=Fs(f_x)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 169:
+HeapPush(H,Xb(BcP(f_x,0)));
+LoadHVA(Xb(BcP(f_x,0+Fs(f_x))),H);
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 170:
+{
+{
+{tagged_t vr270 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr270)) {
+tagged_t vr271;
+do {
+RefSVA(vr271,vr270);
+if (vr271==vr270) {
+BindSVA(vr270,Tagp(HVA,H));
+PreLoadHVA(vr270,H);
+break;
+        }
+
+vr270 = vr271;
+      }
+ while (TaggedIsSVA(vr270));
+    }
+
+HeapPush(H,vr270);
+}LoadHVA(Xb(BcP(f_x,0+Fs(f_x))),H);
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 171:
+CODE_ALLOC(E);
+goto w_op173;
+case 172:
+CODE_ALLOC(E);
+goto w_op174;
+case 173:
+w_op173:
+HeapPush(H,Xb(BcP(f_x,0)));
+LoadHVA(Yb(BcP(f_y,0+Fs(f_x))),H);
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 174:
+{
+w_op174:
+{
+{tagged_t vr272 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr272)) {
+tagged_t vr273;
+do {
+RefSVA(vr273,vr272);
+if (vr273==vr272) {
+BindSVA(vr272,Tagp(HVA,H));
+PreLoadHVA(vr272,H);
+break;
+        }
+
+vr272 = vr273;
+      }
+ while (TaggedIsSVA(vr272));
+    }
+
+HeapPush(H,vr272);
+}LoadHVA(Yb(BcP(f_y,0+Fs(f_x))),H);
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 175:
+HeapPush(H,Xb(BcP(f_x,0)));
+HeapPush(H,Xb(BcP(f_x,0+Fs(f_x))));
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+case 177:
+{
+{
+HeapPush(H,Xb(BcP(f_x,0)));
+{tagged_t vr274 = Xb(BcP(f_x,0+Fs(f_x)));
+if (TaggedIsSVA(vr274)) {
+tagged_t vr275;
+do {
+RefSVA(vr275,vr274);
+if (vr275==vr274) {
+BindSVA(vr274,Tagp(HVA,H));
+PreLoadHVA(vr274,H);
+break;
+        }
+
+vr274 = vr275;
+      }
+ while (TaggedIsSVA(vr274));
+    }
+
+HeapPush(H,vr274);
+}P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 176:
+{
+{
+{tagged_t vr276 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr276)) {
+tagged_t vr277;
+do {
+RefSVA(vr277,vr276);
+if (vr277==vr276) {
+BindSVA(vr276,Tagp(HVA,H));
+PreLoadHVA(vr276,H);
+break;
+        }
+
+vr276 = vr277;
+      }
+ while (TaggedIsSVA(vr276));
+    }
+
+HeapPush(H,vr276);
+}HeapPush(H,Xb(BcP(f_x,0+Fs(f_x))));
+P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 178:
+{
+{
+{tagged_t vr278 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr278)) {
+tagged_t vr279;
+do {
+RefSVA(vr279,vr278);
+if (vr279==vr278) {
+BindSVA(vr278,Tagp(HVA,H));
+PreLoadHVA(vr278,H);
+break;
+        }
+
+vr278 = vr279;
+      }
+ while (TaggedIsSVA(vr278));
+    }
+
+HeapPush(H,vr278);
+}{tagged_t vr280 = Xb(BcP(f_x,0+Fs(f_x)));
+if (TaggedIsSVA(vr280)) {
+tagged_t vr281;
+do {
+RefSVA(vr281,vr280);
+if (vr281==vr280) {
+BindSVA(vr280,Tagp(HVA,H));
+PreLoadHVA(vr280,H);
+break;
+        }
+
+vr280 = vr281;
+      }
+ while (TaggedIsSVA(vr280));
+    }
+
+HeapPush(H,vr280);
+}P+=Fs(f_x)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 179:
+{
+{
+HeapPush(H,Xb(BcP(f_x,0)));
+{tagged_t vr282;
+LoadHVA(vr282,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_x))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_x))) = vr282;
+}P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 180:
+{
+{
+{tagged_t vr283 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr283)) {
+tagged_t vr284;
+do {
+RefSVA(vr284,vr283);
+if (vr284==vr283) {
+BindSVA(vr283,Tagp(HVA,H));
+PreLoadHVA(vr283,H);
+break;
+        }
+
+vr283 = vr284;
+      }
+ while (TaggedIsSVA(vr283));
+    }
+
+HeapPush(H,vr283);
+}{tagged_t vr285;
+LoadHVA(vr285,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_x))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_x)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_x))) = vr285;
+}P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 181:
+HeapPush(H,Xb(BcP(f_x,0)));
+HeapPush(H,Yb(BcP(f_y,0+Fs(f_x))));
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+case 183:
+{
+{
+HeapPush(H,Xb(BcP(f_x,0)));
+{tagged_t vr286 = Yb(BcP(f_y,0+Fs(f_x)));
+if (TaggedIsSVA(vr286)) {
+tagged_t vr287;
+do {
+RefSVA(vr287,vr286);
+if (vr287==vr286) {
+BindSVA(vr286,Tagp(HVA,H));
+PreLoadHVA(vr286,H);
+break;
+        }
+
+vr286 = vr287;
+      }
+ while (TaggedIsSVA(vr286));
+    }
+
+HeapPush(H,vr286);
+}P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 182:
+{
+{
+{tagged_t vr288 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr288)) {
+tagged_t vr289;
+do {
+RefSVA(vr289,vr288);
+if (vr289==vr288) {
+BindSVA(vr288,Tagp(HVA,H));
+PreLoadHVA(vr288,H);
+break;
+        }
+
+vr288 = vr289;
+      }
+ while (TaggedIsSVA(vr288));
+    }
+
+HeapPush(H,vr288);
+}HeapPush(H,Yb(BcP(f_y,0+Fs(f_x))));
+P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 184:
+{
+{
+{tagged_t vr290 = Xb(BcP(f_x,0));
+if (TaggedIsSVA(vr290)) {
+tagged_t vr291;
+do {
+RefSVA(vr291,vr290);
+if (vr291==vr290) {
+BindSVA(vr290,Tagp(HVA,H));
+PreLoadHVA(vr290,H);
+break;
+        }
+
+vr290 = vr291;
+      }
+ while (TaggedIsSVA(vr290));
+    }
+
+HeapPush(H,vr290);
+}{tagged_t vr292 = Yb(BcP(f_y,0+Fs(f_x)));
+if (TaggedIsSVA(vr292)) {
+tagged_t vr293;
+do {
+RefSVA(vr293,vr292);
+if (vr293==vr292) {
+BindSVA(vr292,Tagp(HVA,H));
+PreLoadHVA(vr292,H);
+break;
+        }
+
+vr292 = vr293;
+      }
+ while (TaggedIsSVA(vr292));
+    }
+
+HeapPush(H,vr292);
+}P+=Fs(f_x)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 186:
+{
+{
+HeapPush(H,Yb(BcP(f_y,0)));
+intmach_t vr294 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_y));
+do {
+ConstrHVA(H);
+    }
+ while (--vr294);
+P+=Fs(f_y)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 187:
+{
+{
+{tagged_t vr295 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr295)) {
+tagged_t vr296;
+do {
+RefSVA(vr296,vr295);
+if (vr296==vr295) {
+BindSVA(vr295,Tagp(HVA,H));
+PreLoadHVA(vr295,H);
+break;
+        }
+
+vr295 = vr296;
+      }
+ while (TaggedIsSVA(vr295));
+    }
+
+HeapPush(H,vr295);
+}intmach_t vr297 = (FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_y));
+do {
+ConstrHVA(H);
+    }
+ while (--vr297);
+P+=Fs(f_y)+Fs(f_i);
+goto w_dispatch;
+    }
+    }
+case 189:
+HeapPush(H,Yb(BcP(f_y,0)));
+LoadHVA(Xb(BcP(f_x,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+case 190:
+{
+{
+{tagged_t vr298 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr298)) {
+tagged_t vr299;
+do {
+RefSVA(vr299,vr298);
+if (vr299==vr298) {
+BindSVA(vr298,Tagp(HVA,H));
+PreLoadHVA(vr298,H);
+break;
+        }
+
+vr298 = vr299;
+      }
+ while (TaggedIsSVA(vr298));
+    }
+
+HeapPush(H,vr298);
+}LoadHVA(Xb(BcP(f_x,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 191:
+HeapPush(H,Yb(BcP(f_y,0)));
+LoadHVA(Yb(BcP(f_y,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+case 192:
+{
+{
+{tagged_t vr300 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr300)) {
+tagged_t vr301;
+do {
+RefSVA(vr301,vr300);
+if (vr301==vr300) {
+BindSVA(vr300,Tagp(HVA,H));
+PreLoadHVA(vr300,H);
+break;
+        }
+
+vr300 = vr301;
+      }
+ while (TaggedIsSVA(vr300));
+    }
+
+HeapPush(H,vr300);
+}LoadHVA(Yb(BcP(f_y,0+Fs(f_y))),H);
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 200:
+{
+{
+HeapPush(H,Yb(BcP(f_y,0)));
+{tagged_t vr302;
+LoadHVA(vr302,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_y))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_y)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_y))) = vr302;
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 201:
+{
+{
+{tagged_t vr303 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr303)) {
+tagged_t vr304;
+do {
+RefSVA(vr304,vr303);
+if (vr304==vr303) {
+BindSVA(vr303,Tagp(HVA,H));
+PreLoadHVA(vr303,H);
+break;
+        }
+
+vr303 = vr304;
+      }
+ while (TaggedIsSVA(vr303));
+    }
+
+HeapPush(H,vr303);
+}{tagged_t vr305;
+LoadHVA(vr305,H);
+if (CondStackvar(Yb(BcP(f_y,0+Fs(f_y))))) {
+TrailPushCheck(w->trail_top,Tagp(SVA,&Yb(BcP(f_y,0+Fs(f_y)))));
+    }
+
+Yb(BcP(f_y,0+Fs(f_y))) = vr305;
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 194:
+HeapPush(H,Yb(BcP(f_y,0)));
+HeapPush(H,Xb(BcP(f_x,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+case 197:
+{
+{
+HeapPush(H,Yb(BcP(f_y,0)));
+{tagged_t vr306 = Xb(BcP(f_x,0+Fs(f_y)));
+if (TaggedIsSVA(vr306)) {
+tagged_t vr307;
+do {
+RefSVA(vr307,vr306);
+if (vr307==vr306) {
+BindSVA(vr306,Tagp(HVA,H));
+PreLoadHVA(vr306,H);
+break;
+        }
+
+vr306 = vr307;
+      }
+ while (TaggedIsSVA(vr306));
+    }
+
+HeapPush(H,vr306);
+}P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 195:
+{
+{
+{tagged_t vr308 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr308)) {
+tagged_t vr309;
+do {
+RefSVA(vr309,vr308);
+if (vr309==vr308) {
+BindSVA(vr308,Tagp(HVA,H));
+PreLoadHVA(vr308,H);
+break;
+        }
+
+vr308 = vr309;
+      }
+ while (TaggedIsSVA(vr308));
+    }
+
+HeapPush(H,vr308);
+}HeapPush(H,Xb(BcP(f_x,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 198:
+{
+{
+{tagged_t vr310 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr310)) {
+tagged_t vr311;
+do {
+RefSVA(vr311,vr310);
+if (vr311==vr310) {
+BindSVA(vr310,Tagp(HVA,H));
+PreLoadHVA(vr310,H);
+break;
+        }
+
+vr310 = vr311;
+      }
+ while (TaggedIsSVA(vr310));
+    }
+
+HeapPush(H,vr310);
+}{tagged_t vr312 = Xb(BcP(f_x,0+Fs(f_y)));
+if (TaggedIsSVA(vr312)) {
+tagged_t vr313;
+do {
+RefSVA(vr313,vr312);
+if (vr313==vr312) {
+BindSVA(vr312,Tagp(HVA,H));
+PreLoadHVA(vr312,H);
+break;
+        }
+
+vr312 = vr313;
+      }
+ while (TaggedIsSVA(vr312));
+    }
+
+HeapPush(H,vr312);
+}P+=Fs(f_y)+Fs(f_x);
+goto w_dispatch;
+    }
+    }
+case 203:
+HeapPush(H,Yb(BcP(f_y,0)));
+HeapPush(H,Yb(BcP(f_y,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+case 206:
+{
+{
+HeapPush(H,Yb(BcP(f_y,0)));
+{tagged_t vr314 = Yb(BcP(f_y,0+Fs(f_y)));
+if (TaggedIsSVA(vr314)) {
+tagged_t vr315;
+do {
+RefSVA(vr315,vr314);
+if (vr315==vr314) {
+BindSVA(vr314,Tagp(HVA,H));
+PreLoadHVA(vr314,H);
+break;
+        }
+
+vr314 = vr315;
+      }
+ while (TaggedIsSVA(vr314));
+    }
+
+HeapPush(H,vr314);
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 204:
+{
+{
+{tagged_t vr316 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr316)) {
+tagged_t vr317;
+do {
+RefSVA(vr317,vr316);
+if (vr317==vr316) {
+BindSVA(vr316,Tagp(HVA,H));
+PreLoadHVA(vr316,H);
+break;
+        }
+
+vr316 = vr317;
+      }
+ while (TaggedIsSVA(vr316));
+    }
+
+HeapPush(H,vr316);
+}HeapPush(H,Yb(BcP(f_y,0+Fs(f_y))));
+P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 207:
+{
+{
+{tagged_t vr318 = Yb(BcP(f_y,0));
+if (TaggedIsSVA(vr318)) {
+tagged_t vr319;
+do {
+RefSVA(vr319,vr318);
+if (vr319==vr318) {
+BindSVA(vr318,Tagp(HVA,H));
+PreLoadHVA(vr318,H);
+break;
+        }
+
+vr318 = vr319;
+      }
+ while (TaggedIsSVA(vr318));
+    }
+
+HeapPush(H,vr318);
+}{tagged_t vr320 = Yb(BcP(f_y,0+Fs(f_y)));
+if (TaggedIsSVA(vr320)) {
+tagged_t vr321;
+do {
+RefSVA(vr321,vr320);
+if (vr321==vr320) {
+BindSVA(vr320,Tagp(HVA,H));
+PreLoadHVA(vr320,H);
+break;
+        }
+
+vr320 = vr321;
+      }
+ while (TaggedIsSVA(vr320));
+    }
+
+HeapPush(H,vr320);
+}P+=Fs(f_y)+Fs(f_y);
+goto w_dispatch;
+    }
+    }
+case 248:
+P+=Fs(f_Q);
+goto w_op249;
+case 249:
+w_op249:
+#if defined(GAUGE)
+INCR_COUNTER(BcP(f_l,0));
+#endif
+P+=Fs(f_l);
+goto w_dispatch;
+case 250:
+P+=Fs(f_Q);
+goto w_op251;
+case 251:
+w_op251:
+#if defined(GAUGE)
+if (!IsDeep()) {
+B = w->choice;
+if (!IsShallowTry()) {
+#if defined(GAUGE)
+INCR_COUNTER(BcP(f_l,0));
+#endif
+      }
+ else {
+#if defined(GAUGE)
+INCR_COUNTER(BcP(f_l,0+Fs(f_l)));
+#endif
+      }
+
+    }
+
+#endif
+P+=Fs(f_l)+Fs(f_l);
+goto w_op65;
+case 67:
+goto fail;
+case 245:
+P+=Fs(f_Q);
+goto w_op246;
+case 246:
+w_op246:
+if (HeapCharDifference(H,Heap_End)<(intmach_t)BcP(f_l,0)) {
+w->heap_top = H;
+explicit_heap_overflow(w,(intmach_t)BcP(f_l,0)*2,(FTYPE_ctype(f_i_signed))BcP(f_i,0+Fs(f_l)));
+H = w->heap_top;
+    }
+
+P+=Fs(f_l)+Fs(f_i);
+goto w_dispatch;
+case 65:
+{
+w_op65:
+{
+if (!IsDeep()) {
+B = w->choice;
+if (!IsShallowTry()) {
+NECK_RETRY_PATCH(B);
+      }
+ else {
+B->next_alt = w->next_alt;
+B->frame = w->frame;
+B->next_insn = w->next_insn;
+B->local_top = w->local_top;
+intmach_t vr322 = ChoiceArity(B);
+for (intmach_t vr323 = 0;
+vr323<vr322;vr323++) {
+B->x[vr323] = w->x[vr323];
+        }
+
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+        }
+
+      }
+
+SetDeep();
+SetE(w->local_top);
+    }
+
+P+=0;
+goto w_dispatch;
+    }
+    }
+case 236:
+{
+w_op236:
+{
+tagged_t vr324 = X(3);
+if (vr324&TagBitSVA) {
+BindSVA(vr324,PointerToTerm(w->misc->ins));
+    }
+ else {
+BindHVA(vr324,PointerToTerm(w->misc->ins));
+    }
+
+if (IsDeep()) {
+goto w_op64;
+    }
+
+B = w->choice;
+if (IsShallowTry()) {
+def_clock = use_clock+1;
+if (def_clock==65535) {
+w->heap_top = H;
+clock_overflow(w);
+H = w->heap_top;
+      }
+
+    }
+
+goto w_op66;
+    }
+    }
+case 66:
+{
+w_op66:
+{
+if (!IsDeep()) {
+B = w->choice;
+if (!IsShallowTry()) {
+NECK_RETRY_PATCH(B);
+      }
+ else {
+B->next_alt = w->next_alt;
+B->frame = w->frame;
+B->next_insn = w->next_insn;
+B->local_top = w->local_top;
+intmach_t vr325 = ChoiceArity(B);
+for (intmach_t vr326 = 0;
+vr326<vr325;vr326++) {
+B->x[vr326] = w->x[vr326];
+        }
+
+if (ChoiceYounger(ChoiceOffset(B,CHOICEPAD),w->trail_top)) {
+choice_overflow(w,2*CHOICEPAD*sizeof(tagged_t),TRUE);
+        }
+
+      }
+
+SetDeep();
+    }
+ else {
+w->local_top = 0;
+    }
+
+SetE(w->frame);
+P = w->next_insn;
+PROFILE__HOOK_PROCEED;
+P+=0;
+goto w_dispatch;
+    }
+    }
+case 64:
+w_op64:
+w->local_top = 0;
+SetE(w->frame);
+P = w->next_insn;
+PROFILE__HOOK_PROCEED;
+P+=0;
+goto w_dispatch;
+#if defined(PARBACK)
+case 262:
+w->heap_top = TaggedToPointer(w->choice->x[0]);
+H = w->heap_top;
+P = (bcp_t)*TaggedToPointer(w->choice->x[0]);
+w->next_insn = w->choice->next_insn;
+pop_choicept(w);
+goto enter_predicate;
+#endif
+default:
+goto illop;
+  }
+  }
+exit_toplevel:
+w->insn = P;
+if (desc!=NULL&&desc->action&KEEP_STACKS) {
+SAVE_WAM_STATE;
+  }
+
+if (Stop_This_Goal(w)) {
+w->misc->exit_code = WAM_INTERRUPTED;
+  }
+
+ON_DEBUG({
+  }
+);
+return;
+illop:
+SERIOUS_FAULT("unimplemented WAM instruction");
+}
@@ -471,6 +471,7 @@ core__USE_THREADS="$opt__USE_THREADS"
 core__AND_PARALLEL_EXECUTION=no
 core__PAR_BACK=no
 core__TABLED_EXECUTION=no
+core__USE_GMP=no
 core__OPTIM_LEVEL="$opt__OPTIM_LEVEL"
 core__DEBUG_LEVEL="$opt__DEBUG_LEVEL"
 #
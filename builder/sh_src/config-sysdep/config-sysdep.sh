@@ -327,6 +327,10 @@ case "$CIAOOS$CIAOARCH" in
     *) LIBS0="-ldl -lm" ;;
 esac
 
+# Bignum arithmetic with GMP
+GMP_LIB=
+if test x"$core__USE_GMP" = x"yes"; then GMP_LIB="-lgmp"; fi
+
 # ===========================================================================
 
 # TODO: Recover? (add NOCONSOLEFLAG to LDFLAGS)
@@ -407,6 +411,7 @@ emit_cdefs() {
     #
     if test x"$core__PAR_BACK" = x"yes"; then emit_cdef "PARBACK"; fi
     if test x"$core__TABLED_EXECUTION" = x"yes"; then emit_cdef "TABLING"; fi
+    if test x"$core__USE_GMP" = x"yes"; then emit_cdef "USE_GMP"; fi
 }    
 CDEFS=`emit_cdefs`
 
@@ -416,7 +421,7 @@ CFLAGS="$OPTIM_FLAGS $DEBUG_FLAGS $THREAD_FLAGS $SOCKETS_FLAG $ARCHFLAGS $CDEFS"
 LDFLAGS="$LDARCHFLAGS $LDFLAGS0 $LDRPATH $PROFILE_LD_FLAGS"
 CCSHARED="$ARCHFLAGS $CCSHARED" # TODO: misses OPTIM_FLAGS, etc.?
 LDSHARED="$LDARCHFLAGS $LDSHARED"
-LIBS="$LIBS0 $LD_THREAD_LIB $LD_SOCKETS_LIB $DEBUG_LIBS"
+LIBS="$LIBS0 $GMP_LIB $LD_THREAD_LIB $LD_SOCKETS_LIB $DEBUG_LIBS"
 STAT_LIBS="$STAT_SOCKETS_LIB"
 
 # Add extra CFLAGS and LDFLAGS
@@ -1,4 +1,4 @@
-:- module(_, [], [assertions, fsyntax, hiord, dcg]).
+:- module(_, [], [assertions, fsyntax, hiord, dcg, datafacts]).
 
 :- doc(title,  "Build code using the Ciao compiler").
 :- doc(author, "Jose F. Morales").
@@ -17,7 +17,6 @@
 % (improvements)
 :- doc(bug, "Add interface to ciaopp").
 :- doc(bug, "Add interface to optim_comp").
-:- doc(bug, "Better build plans, start several jobs (workers)").
 
 % TODO: With CIAOCCACHE (out-of-tree builds) enabled by default, the
 %  bootstrap system could be simplified to a (reduced?) toplevel.
@@ -425,35 +424,22 @@ sort_by_file_([m(Dir, File, FileName)|Modules],
 
 % ---------------------------------------------------------------------------
 
-:- use_module(library(process), [process_join/1]).
+:- use_module(library(process), [process_call/3, process_join/1]).
 
 %:- export(compile_module_list/4).
 compile_module_list(Modules, BaseDir, RelDir, CompActions) :- 
     build_workers(Workers),
-    ( Workers > 1 ->
-        % Do static task allocation (naive approach)
-        split_k(Workers, Modules, Groups)
-    ; Groups = [Modules]
-    ),
     report_mode(Workers, ReportMode),
-    create_build_workers(Groups, BaseDir, RelDir, CompActions, ReportMode, Ps),
-    join_processes(Ps),
+    ( Workers > 1, Modules = [_,_|_] ->
+        compile_sched(Modules, Workers, BaseDir, RelDir, CompActions, ReportMode)
+    ; invoke_ciaosh_batch([
+        % TODO: integrate ciaoc_batch_call.pl in ciaoc (or create another executable)
+        use_module(ciaobld(ciaoc_batch_call), [compile_mods/5]),
+        compile_mods(Modules, CompActions, BaseDir, RelDir, ReportMode)
+      ])
+    ),
     display_summary(Modules, RelDir).
 
-create_build_workers([], _BaseDir, _RelDir, _CompActions, _ReportMode, []).
-create_build_workers([Modules|Groups], BaseDir, RelDir, CompActions, ReportMode, [P|Ps]) :-
-    invoke_ciaosh_batch([
-      % TODO: integrate ciaoc_batch_call.pl in ciaoc (or create another executable)
-      use_module(ciaobld(ciaoc_batch_call), [compile_mods/5]),
-      compile_mods(Modules, CompActions, BaseDir, RelDir, ReportMode)
-    ], [background(P)]),
-    create_build_workers(Groups, BaseDir, RelDir, CompActions, ReportMode, Ps).
-
-join_processes([]).
-join_processes([P|Ps]) :-
-    process_join(P),
-    join_processes(Ps).
-
 :- use_module(library(system), [get_numcores/1]).
 
 build_workers(X) :-
@@ -478,33 +464,420 @@ display_summary(Modules, RelDir) :-
     normal_message("compiled ~w/ (~w modules)", [RelDir, N]).
 
 % ---------------------------------------------------------------------------
+% Parallel builds
+%
+% Modules are compiled by a pool of compile servers (compile_server/4
+% at ciaoc_batch_call.pl): ciaosh processes that load the compiler
+% once, keep the itf cache between modules, and compile the modules
+% they receive one at a time. A module is sent to an idle server as
+% soon as all the modules it imports have been compiled, so that
+% dependencies are (re)generated exactly once and no server waits for
+% another. Ready modules with the longest chain of importers go
+% first. Servers report each compiled module (and its compilation
+% time) as a line on a common pipe, relayed through @tt{cat} so that
+% the builder can wait for any of them. On POSIX systems each server
+% runs under a shell that also reports its exit, so that a server
+% that dies stops the build instead of leaving it waiting. If a
+% module cannot be compiled no more modules are sent and the build
+% stops once the busy servers are done.
+
+:- use_module(library(lists), [length/2, reverse/2]).
+:- use_module(library(system), [using_windows/0]).
+:- use_module(engine(runtime_control), [statistics/2]).
+:- use_module(engine(stream_basic)).
+:- use_module(library(stream_utils), [get_line/2]).
+:- use_module(library(write), [write_canonical/2]).
+:- use_module(library(format), [format/3]).
+
+% sched_mod(I, M): M is the I-th module
+:- data sched_mod/2.
+% sched_imports(I, J): module I imports module J
+:- data sched_imports/2.
+% sched_imported(J, I): module J is imported by module I
+:- data sched_imported/2.
+% sched_wave(I, W): module I is in the W-th topological wave
+:- data sched_wave/2.
+% sched_wait(I, C): module I waits for C imported modules
+:- data sched_wait/2.
+% sched_height(I, H): H is the length of the longest chain of
+% importers of module I (including itself)
+:- data sched_height/2.
+% sched_ready(I): module I can be compiled
+:- data sched_ready/1.
+% sched_busy(K, I): server K is compiling module I
+:- data sched_busy/2.
+% sched_time(I, T): module I was compiled in T milliseconds
+:- data sched_time/2.
+% sched_failed(I): module I could not be compiled
+:- data sched_failed/1.
+% sched_exited(K): server K exited before being stopped
+:- data sched_exited/1.
+
+compile_sched(Modules, Workers, BaseDir, RelDir, CompActions, ReportMode) :-
+    sched_cleanup,
+    sched_number(Modules, 1, N),
+    statistics(walltime, [T0, _]),
+    ( Workers < N -> K = Workers ; K = N ),
+    process_call(path(cat), [],
+                 [stdin(pipe(Relay)), stdout(pipe(Done)), background(RelayP)]),
+    start_servers(1, K, Relay, [
+      use_module(ciaobld(ciaoc_batch_call), [compile_server/4]),
+      compile_server(CompActions, BaseDir, RelDir, ReportMode)
+    ], Servers),
+    % (only the servers write on the relay, so that it ends when all
+    % of them have exited)
+    close(Relay),
+    catch(sched_run(N, Servers, Done, Waves), E, true),
+    stop_servers(Servers),
+    process_join(RelayP),
+    close(Done),
+    ( nonvar(E) ->
+        sched_cleanup,
+        throw(E)
+    ; current_fact(sched_failed(I)) ->
+        sched_mod(I, m(_, _, FileName)),
+        sched_cleanup,
+        throw(error_msg("Compilation of ~w failed.", [FileName]))
+    ; true
+    ),
+    statistics(walltime, [T1, _]),
+    Wall is T1 - T0,
+    display_critical_path(Waves, K, Wall),
+    sched_cleanup.
+
+sched_run(N, Servers, Done, Waves) :-
+    sched_graph(N, Servers, Done, Waves),
+    sched_loop(N, N, Servers, Done).
+
+start_servers(K0, K, _Relay, _Cmds, Servers) :- K0 > K, !, Servers = [].
+start_servers(K0, K, Relay, Cmds, [s(K0, In, P)|Servers]) :-
+    add_config_prolog_flags(Cmds, Cmds2),
+    Opts = [stdin(pipe(In)), stdout(stream(Relay)), background(P)],
+    ( using_windows ->
+        cpx_process_call(~ciaosh_exec, ['-q', '-f'], Opts)
+    ; % (report "@exited K0" when the server exits, even if it crashes)
+      number_codes(K0, Ks),
+      atom_codes(KAtm, Ks),
+      cpx_process_call('/bin/sh',
+                       ['-c', '"$@"; echo "@exited $0"', KAtm,
+                        ~ciaosh_exec, '-q', '-f'],
+                       Opts)
+    ),
+    send_terms(Cmds2, In),
+    K1 is K0 + 1,
+    start_servers(K1, K, Relay, Cmds, Servers).
+
+stop_servers([]).
+stop_servers([s(K, In, P)|Servers]) :-
+    ( current_fact(sched_exited(K)) -> true
+    ; send_terms([end, halt], In)
+    ),
+    catch(close(In), _, true), % (unsent output if it exited)
+    process_join(P),
+    stop_servers(Servers).
+
+send_terms([], In) :- flush_output(In).
+send_terms([X|Xs], In) :-
+    write_canonical(In, X), display(In, ' .'), nl(In),
+    send_terms(Xs, In).
+
+% Send ready modules to idle servers and wait for the next compiled
+% module, until Left modules remain to be compiled. After a failure,
+% only wait for the busy servers.
+sched_loop(Left, N, Servers, Done) :-
+    ( Left = 0 -> true
+    ; current_fact(sched_failed(_)),
+      \+ current_fact(sched_busy(_, _)) -> true
+    ; ( current_fact(sched_failed(_)) -> true
+      ; sched_dispatch(Servers, N)
+      ),
+      sched_wait_done(Done, Status, I, T),
+      retract_fact(sched_busy(_, I)),
+      ( Status = compiled -> sched_compiled(I, T)
+      ; assertz_fact(sched_failed(I))
+      ),
+      Left1 is Left - 1,
+      sched_loop(Left1, N, Servers, Done)
+    ).
+
+% Module I has been compiled in T milliseconds
+sched_compiled(I, T) :-
+    assertz_fact(sched_time(I, T)),
+    ( % (failure-driven loop)
+      sched_imported(I, J),
+        sched_wave(I, WI), sched_wave(J, WJ), WI < WJ,
+        retract_fact(sched_wait(J, C)),
+        C1 is C - 1,
+        ( C1 = 0 -> assertz_fact(sched_ready(J))
+        ; assertz_fact(sched_wait(J, C1))
+        ),
+        fail
+    ; true
+    ).
+
+sched_dispatch([], _N).
+sched_dispatch([s(K, In, _)|Servers], N) :-
+    ( \+ current_fact(sched_busy(K, _)),
+      sched_next(I) ->
+        sched_mod(I, M),
+        send_terms([compile(I, N, M)], In),
+        assertz_fact(sched_busy(K, I))
+    ; true
+    ),
+    sched_dispatch(Servers, N).
+
+% Take the ready module with the longest chain of importers
+sched_next(I) :-
+    findall(H-I0, (sched_ready(I0), sched_height(I0, H)), Hs),
+    Hs = [H0-I1|Hs1],
+    max_height(Hs1, H0, I1, I),
+    retract_fact(sched_ready(I)).
+
+max_height([], _, I, I).
+max_height([H-I0|Hs], H0, I1, I) :-
+    ( H > H0 -> max_height(Hs, H, I0, I)
+    ; max_height(Hs, H0, I1, I)
+    ).
+
+% Wait for a "@compiled I T" or "@failed I T" line from any server
+sched_wait_done(Done, Status, I, T) :-
+    sched_msg(Done, Msg),
+    ( Msg = compiled(I, T) -> Status = compiled
+    ; Msg = failed(I, T) -> Status = failed
+    ; sched_wait_done(Done, Status, I, T)
+    ).
+
+% Next "@Name N1 ... Nk" line from the servers, as a Name(N1, ..., Nk)
+% term (other output is ignored). Servers only exit when they are
+% stopped, after the schedule.
+sched_msg(Done, Msg) :-
+    get_line(Done, Line),
+    ( Line = end_of_file ->
+        throw(error_msg("All the compile servers exited.", []))
+    ; append(_, "@"||Cs, Line),
+      sched_words(Cs, [NameCs|ArgsCs]),
+      atom_codes(Name, NameCs),
+      sched_numbers(ArgsCs, Args) ->
+        Msg0 =.. [Name|Args],
+        ( Msg0 = exited(K) ->
+            assertz_fact(sched_exited(K)),
+            throw(error_msg("Compile server ~w exited.", [K]))
+        ; Msg = Msg0
+        )
+    ; sched_msg(Done, Msg)
+    ).
+
+sched_words(Cs, Ws) :-
+    ( append(W, " "||Cs1, Cs) -> Ws = [W|Ws1], sched_words(Cs1, Ws1)
+    ; Ws = [Cs]
+    ).
+
+sched_numbers([], []).
+sched_numbers([Cs|Css], [X|Xs]) :-
+    catch(number_codes(X, Cs), _, fail),
+    sched_numbers(Css, Xs).
+
+sched_cleanup :-
+    retractall_fact(sched_mod(_, _)),
+    retractall_fact(sched_imports(_, _)),
+    retractall_fact(sched_imported(_, _)),
+    retractall_fact(sched_wave(_, _)),
+    retractall_fact(sched_wait(_, _)),
+    retractall_fact(sched_height(_, _)),
+    retractall_fact(sched_ready(_)),
+    retractall_fact(sched_busy(_, _)),
+    retractall_fact(sched_time(_, _)),
+    retractall_fact(sched_failed(_)),
+    retractall_fact(sched_exited(_)).
+
+% ---------------------------------------------------------------------------
+% Dependency graph for parallel builds
+%
+% Import edges come from the itf data of each source (obtained by the
+% servers, which read the sources with the operators and translations
+% of their packages when the itf files are not up to date), keeping
+% only imports of modules in the same build. Modules are then split
+% into topological waves, where each wave only imports modules from
+% previous ones. Import cycles are broken at the module with the
+% lowest index, whose imports from its own or later waves are ignored
+% during scheduling.
+
+sched_graph(N, Servers, Done, Waves) :-
+    sched_imports_from(Servers, Done),
+    ( % (failure-driven loop)
+      sched_mod(I, _),
+        findall(J, sched_imports(I, J), Js),
+        length(Js, C),
+        C > 0,
+        assertz_fact(sched_wait(I, C)),
+        fail
+    ; true
+    ),
+    findall(I, (sched_mod(I, _), \+ current_fact(sched_wait(I, _))), Wave0),
+    sched_waves(Wave0, 0, N, Waves),
+    sched_heights,
+    % Modules waiting for imports from previous waves
+    ( % (failure-driven loop)
+      sched_mod(I, _),
+        sched_wave(I, WI),
+        findall(J, (sched_imports(I, J), sched_wave(J, WJ), WJ < WI), Js),
+        length(Js, C),
+        ( C = 0 -> assertz_fact(sched_ready(I))
+        ; assertz_fact(sched_wait(I, C))
+        ),
+        fail
+    ; true
+    ).
+
+sched_number([], I, N) :- N is I - 1.
+sched_number([M|Ms], I, N) :-
+    assertz_fact(sched_mod(I, M)),
+    I1 is I + 1,
+    sched_number(Ms, I1, N).
+
+% Ask the servers (in parallel) for the imports between modules
+sched_imports_from(Servers, Done) :-
+    findall(I-FileName, sched_mod(I, m(_, _, FileName)), Mods),
+    findall(I, sched_mod(I, _), Is),
+    length(Servers, K),
+    sched_split(Is, 0, K, Parts),
+    send_imports(Servers, Parts, Mods),
+    sched_wait_imports(K, Done).
+
+% Split Is in K parts (module I goes to the (I mod K)-th part)
+sched_split(Is, K0, K, Parts) :-
+    ( K0 = K -> Parts = []
+    ; findall(I, (member(I, Is), I mod K =:= K0), Part),
+      K1 is K0 + 1,
+      Parts = [Part|Parts1],
+      sched_split(Is, K1, K, Parts1)
+    ).
+
+send_imports([], [], _Mods).
+send_imports([s(_, In, _)|Servers], [Part|Parts], Mods) :-
+    send_terms([imports(Part, Mods)], In),
+    send_imports(Servers, Parts, Mods).
+
+sched_wait_imports(K, Done) :-
+    ( K = 0 -> true
+    ; sched_msg(Done, Msg),
+      ( Msg = imports(I, J) ->
+          ( current_fact(sched_imports(I, J)) -> true
+          ; assertz_fact(sched_imports(I, J)),
+            assertz_fact(sched_imported(J, I))
+          ),
+          K1 = K
+      ; Msg = imports_done ->
+          K1 is K - 1
+      ; K1 = K
+      ),
+      sched_wait_imports(K1, Done)
+    ).
+
+% Assign modules to waves (Waves is the number of waves)
+sched_waves([], W, Left, Waves) :- !,
+    ( Left = 0 ->
+        Waves = W
+    ; % Break an import cycle
+      findall(I0, sched_wait(I0, _), Is0),
+      sort(Is0, [I|_]),
+      retract_fact(sched_wait(I, _)),
+      sched_waves([I], W, Left, Waves)
+    ).
+sched_waves(Wave, W, Left, Waves) :-
+    ( % (failure-driven loop)
+      member(I, Wave),
+        assertz_fact(sched_wave(I, W)),
+        fail
+    ; true
+    ),
+    findall(J, (member(I, Wave), sched_imported(I, J), sched_release(J)), Next),
+    length(Wave, C),
+    Left1 is Left - C,
+    W1 is W + 1,
+    sched_waves(Next, W1, Left1, Waves).
+
+% One of the imports of J has been assigned a wave
+sched_release(J) :-
+    retract_fact(sched_wait(J, C)),
+    C1 is C - 1,
+    ( C1 = 0 -> true
+    ; assertz_fact(sched_wait(J, C1)),
+      fail
+    ).
 
-:- use_module(library(lists), [length/2]).
-
-%:- export(split_k/3).
-% Split list Xs into K groups of approximatelly equal size.
-% (Empty groups are omitted)
-split_k(_K, [], Groups) :- !, Groups = [].
-split_k(K, Xs, Groups) :-
-    length(Xs, Len),
-    Q is Len//K, % quotient
-    R is Len-Q*K, % reminder
-    % Take R times Q+1 and the rest Q
-    split_k_(Xs, Q, R, Groups).
-
-split_k_([], _Q, _R, []) :- !.
-split_k_(Xs, Q, R, [Group|Groups]) :- !,
-    ( R > 0 -> R1 is R-1, N is Q+1 ; R1=R, N=Q ),
-    take_n(N, Xs, Group, Xs2),
-    split_k_(Xs2, Q, R1, Groups).
-
-% Split Xs into lists As of length N and rest Bs.
-% If length of Xs is less than N, As=Xs and Bs=[].
-take_n(0, Xs, As, Bs) :- !, As=[], Bs=Xs.
-take_n(_, [], As, Bs) :- !, As=[], Bs=[].
-take_n(I, [X|Xs], [X|As], Bs) :- I > 0,
-    I1 is I - 1,
-    take_n(I1, Xs, As, Bs).
+% Compute sched_height/2, from the last wave to the first one
+sched_heights :-
+    findall(W-I, sched_wave(I, W), Ps0),
+    sort(Ps0, Ps1),
+    reverse(Ps1, Ps),
+    ( % (failure-driven loop)
+      member(W-I, Ps),
+        findall(H, (sched_imported(I, J), sched_wave(J, WJ), WJ > W,
+                    sched_height(J, H)), Hs),
+        max_list_or_zero(Hs, H0),
+        H is H0 + 1,
+        assertz_fact(sched_height(I, H)),
+        fail
+    ; true
+    ).
+
+max_list_or_zero([], 0).
+max_list_or_zero([X|Xs], Max) :-
+    max_list_or_zero(Xs, Max0),
+    ( X > Max0 -> Max = X ; Max = Max0 ).
+
+% sched_finish(I, F, Prev): the chain of imports of module I finishes
+% at time F (ms after the start of the build, if servers were always
+% available), and Prev is the last module of that chain before I
+:- data sched_finish/3.
+
+% Report the length of the critical path: the most expensive chain of
+% modules that had to be compiled one after the other
+display_critical_path(Waves, K, Wall) :-
+    findall(W-I, sched_wave(I, W), Ps0),
+    sort(Ps0, Ps),
+    ( % (failure-driven loop)
+      member(W-I, Ps),
+        sched_time(I, T),
+        findall(F-J, (sched_imports(I, J), sched_wave(J, WJ), WJ < W,
+                      sched_finish(J, F, _)), Fs),
+        ( Fs = [] -> F0 = 0, Prev = none
+        ; sort(Fs, Fs1), reverse(Fs1, [F0-Prev|_])
+        ),
+        F1 is F0 + T,
+        assertz_fact(sched_finish(I, F1, Prev)),
+        fail
+    ; true
+    ),
+    findall(F-I, sched_finish(I, F, _), Fs2),
+    sort(Fs2, Fs3),
+    reverse(Fs3, [Crit-Last|_]),
+    critical_path(Last, [], Path),
+    length(Path, Len),
+    findall(T, sched_time(_, T), Ts),
+    sum_times(Ts, Total),
+    CritS is Crit / 1000, TotalS is Total / 1000, WallS is Wall / 1000,
+    normal_message("critical path ~2fs (~w modules, ~w waves); ~2fs of compilation in ~2fs with ~w servers",
+                   [CritS, Len, Waves, TotalS, WallS, K]),
+    ( % (failure-driven loop)
+      member(I, Path),
+        sched_mod(I, m(_, _, FileName)),
+        sched_time(I, T),
+        TS is T / 1000,
+        verbose_message("  ~w (~2fs)", [FileName, TS]),
+        fail
+    ; true
+    ),
+    retractall_fact(sched_finish(_, _, _)).
+
+critical_path(none, Path, Path) :- !.
+critical_path(I, Path0, Path) :-
+    sched_finish(I, _, Prev),
+    critical_path(Prev, [I|Path0], Path).
+
+sum_times([], 0).
+sum_times([X|Xs], S) :- sum_times(Xs, S0), S is S0 + X.
 
 % ===========================================================================
 :- doc(section, "Testing").
@@ -518,11 +891,13 @@ runtests_dir(Bundle, Dir) :-
 :- export(runtests_dir/3).
 % Call unittests on directory Dir (recursive) of bundle Bundle
 % Fails whenever a test failure is detected after executing all tests
-runtests_dir(Bundle, Dir, Opts) :-
+runtests_dir(Bundle, Dir, Opts0) :-
     AbsDir = ~bundle_path(Bundle, Dir),
     exists_and_compilable(AbsDir),
     !,
     normal_message("running tests at ~w/", [Dir]),
+    build_workers(Workers),
+    ( Workers > 1 -> Opts = [jobs(Workers)|Opts0] ; Opts = Opts0 ),
     invoke_ciaosh_batch([
       use_module(library(unittest), [run_tests_in_dir_rec/3]),
       (run_tests_in_dir_rec(AbsDir, Opts, St), halt(St))
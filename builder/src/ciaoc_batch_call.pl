@@ -1,4 +1,4 @@
-:- module(ciaoc_batch_call, [], []).
+:- module(ciaoc_batch_call, [], [datafacts]).
 
 % Auxiliary file to call ciaoc in batch mode from invoke_ciaosh_batch/1
 % (many modules compiled from the same process).
@@ -8,22 +8,28 @@
 % TODO: This (with some changes) may be part of ciaoc
 
 :- use_module(library(format), [format/3]).
-:- use_module(library(lists), [length/2]).
+:- use_module(library(lists), [length/2, member/2]).
 :- use_module(library(system), [mktemp_in_tmp/2]).
 :- use_module(library(system_extra), [del_file_nofail/1]).
 :- use_module(library(llists), [flatten/2]).
 :- use_module(engine(stream_basic)).
 :- use_module(library(stream_utils), [string_to_file/2]).
 :- use_module(library(pathnames), [path_get_relative/3]).
+:- use_module(library(read), [read/2]).
+:- use_module(library(messages), [show_message/3]).
+:- use_module(engine(runtime_control), [statistics/2]).
 
 :- use_module(library(compiler), [make_po/1]).
-:- use_module(library(compiler/c_itf), [cleanup_itf_cache/0]).
+:- use_module(library(compiler/c_itf), [cleanup_itf_cache/0,
+    refresh_unchanged_source/1, process_file/7, uses_file/2, adds/2,
+    base_name/2, false/1]).
 :- use_module(library(assertions/assrt_lib),
     [get_code_and_related_assertions/5,
      cleanup_code_and_related_assertions/0]).
 :- use_module(engine(internals),
     [po_filename/2,
      itf_filename/2,
+     stamp_filename/2,
      asr_filename/2,
      ast_filename/2]).
 :- use_module(library(compiler/up_to_date)).
@@ -41,13 +47,103 @@ compile_mods_([M|Ms], CompActions, BaseDir, RelDir, ReportMode, I, N) :-
     I1 is I + 1,
     compile_mods_(Ms, CompActions, BaseDir, RelDir, ReportMode, I1, N).
 
-compile_mod(m(_, _, FileName), CompActions, BaseDir, RelDir, ReportMode, I, N) :-
+compile_mod(M, CompActions, BaseDir, RelDir, ReportMode, I, N) :-
+    compile_mod_(M, CompActions, BaseDir, RelDir, ReportMode, I, N),
+    cleanup_itf_cache. % TODO: needed?
+
+compile_mod_(m(_, _, FileName), CompActions, BaseDir, RelDir, ReportMode, I, N) :-
     ( path_get_relative(BaseDir, FileName, File0) -> File = File0
     ; File = FileName
     ),
     display_progress(ReportMode, RelDir, File, I, N),
-    do_comp_actions(CompActions, FileName),
-    cleanup_itf_cache. % TODO: needed?
+    do_comp_actions(CompActions, FileName).
+
+% compilation_error was signaled while compiling a module
+:- data comp_error/0.
+
+:- export(compile_server/4).
+% Compile the modules received as compile(I, N, M) terms from the
+% standard input, until any other term is read. Each module is
+% acknowledged with a "@compiled I Time" line on the standard output,
+% or "@failed I Time" if it could not be compiled (Time in
+% milliseconds). The itf cache is kept between modules (it is
+% validated against the itf file modification times).
+%
+% An imports(Is, Mods) term (Mods is a list of I-FileName pairs) is
+% answered with a "@imports I J" line for each module J in Mods
+% imported by a module I in Is, and a final "@imports_done" line.
+compile_server(CompActions, BaseDir, RelDir, ReportMode) :-
+    read(user_input, Cmd),
+    ( Cmd = compile(I, N, M) ->
+        statistics(walltime, [T0, _]),
+        retractall_fact(comp_error),
+        ( intercept(catch(compile_mod_(M, CompActions, BaseDir, RelDir, ReportMode, I, N),
+                          E, (compile_exc(M, E), fail)),
+                    compilation_error,
+                    set_fact(comp_error)),
+          \+ current_fact(comp_error) ->
+            Status = compiled
+        ; Status = failed
+        ),
+        statistics(walltime, [T1, _]),
+        T is T1 - T0,
+        format(user_output, "@~w ~w ~w~n", [Status, I, T]),
+        flush_output(user_output),
+        compile_server(CompActions, BaseDir, RelDir, ReportMode)
+    ; Cmd = imports(Is, Mods) ->
+        send_imports(Is, Mods),
+        compile_server(CompActions, BaseDir, RelDir, ReportMode)
+    ; display_done(ReportMode)
+    ).
+
+compile_exc(m(_, _, FileName), E) :-
+    show_message(error, "Exception while compiling ~w: ~q", [FileName, E]).
+
+% ---------------------------------------------------------------------------
+% Imports between modules (for the schedule of parallel builds)
+
+% imported_file(FileName): FileName is imported by the last processed
+% source
+:- data imported_file/1.
+
+send_imports(Is, Mods) :-
+    ( % (failure-driven loop)
+      member(I, Is),
+        member(I-FileName, Mods),
+        source_imports(FileName),
+        retract_fact(imported_file(File)),
+        member(J-File, Mods),
+        I \== J,
+        format(user_output, "@imports ~w ~w~n", [I, J]),
+        fail
+    ; true
+    ),
+    format(user_output, "@imports_done~n", []),
+    flush_output(user_output).
+
+% Record the files imported by the source FileName, from its itf data
+% (read from the source, with the operators and translations of its
+% packages, if the itf file is not up to date). Errors are left for
+% its compilation.
+source_imports(FileName) :-
+    retractall_fact(imported_file(_)),
+    catch(process_file(FileName, in, any,
+                       c_itf:false, ciaoc_batch_call:record_imports,
+                       c_itf:false, c_itf:false),
+          _, true).
+
+% (do not treat the file, just record its imports)
+record_imports(Base) :-
+    ( % (failure-driven loop)
+      ( uses_file(Base, File) ; adds(Base, File) ),
+        base_name(File, ImpBase),
+        atom_concat(ImpBase, '.pl', ImpFileName),
+        assertz_fact(imported_file(ImpFileName)),
+        fail
+    ; true
+    ).
+
+% ---------------------------------------------------------------------------
 
 do_comp_actions([], _FileName).
 do_comp_actions([Action|Actions], FileName) :-
@@ -61,6 +157,7 @@ gaf(FileName0) :-
     % (absolute path needed in *_filename/2)
     absolute_file_name(FileName0, FileName),
     get_base_name(FileName, FileBase),
+    refresh_unchanged_source(FileBase),
     asr_filename(FileBase, FileNameAsr),
     ( up_to_date(FileNameAsr, FileName) ->
         true
@@ -96,6 +193,7 @@ gpo(FileName0) :-
     % (absolute path needed in *_filename/2)
     absolute_file_name(FileName0, FileName),
     get_base_name(FileName, FileBase),
+    refresh_unchanged_source(FileBase),
     po_filename(FileBase, FileNamePo),
     itf_filename(FileBase, FileNameItf),
     ( up_to_date(FileNamePo,  FileName),
@@ -131,8 +229,10 @@ clean_mods([Base|Bases]) :- clean_mod(Base), clean_mods(Bases).
 %      "$1.asr"
 %      "$1.ast"
 %      "$1.itf"
+%      "$1.stamp"
 %      "$1.po"
 %      "$1.testout"
+%      "$1.testtimes"
 %      "$1""_""$CIAOOS$CIAOARCH"".o"
 %      "$1""_""$CIAOOS$CIAOARCH"".a"
 %      "$1""_""$CIAOOS$CIAOARCH"".so"
@@ -143,8 +243,10 @@ clean_mods([Base|Bases]) :- clean_mod(Base), clean_mods(Bases).
 %      "$1""_""$CIAOOS$CIAOARCH""_inline.c"
 clean_mod(Base) :-
     itf_filename(Base, Itf),
+    stamp_filename(Base, Stamp),
     po_filename(Base, Po),
     del_file_nofail(Itf),
+    del_file_nofail(Stamp),
     del_file_nofail(Po).
 
 % ---------------------------------------------------------------------------
@@ -146,6 +146,24 @@
 
 % ---------------------------------------------------------------------------
 
+% (also needed by config-sysdep.sh)
+:- bundle_flag(use_gmp, [
+    comment("Use GMP for bignum arithmetic"),
+    details(
+      % .....................................................................
+      "Set the following variable to \"yes\" if you wish to compile an engine\n"||
+      "that uses the GMP library (which must be installed) for multiplication,\n"||
+      "division and radix conversion of large integers. Otherwise the engine\n"||
+      "uses its own subquadratic algorithms."),
+    valid_values(['yes', 'no']),
+    %
+    rule_default('no'),
+    %
+    interactive([advanced])
+]).
+
+% ---------------------------------------------------------------------------
+
 % (also needed by config-sysdep.sh)
 :- bundle_flag(optim_level, [
     comment("Optimization level"),
@@ -205,7 +223,6 @@
   add_stat_libs, % link statically against C system libraries
   static_mods([library(random),
            library(sockets),
-           library(sha1),
            library(concurrency)]), % link statically against foreign code
   % TODO: extract from static_mods
   static_cfgs([at_bundle(ciao_gsl, 'gsl')]) % see gsl.hooks.pl at 'ciao_gsl' bundle
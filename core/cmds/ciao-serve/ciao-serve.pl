@@ -7,7 +7,7 @@
    services (active modules, HTTP requests, etc.). See
    @lib{service_registry} and @lib{serve_http} for more details.").
 
-:- use_module(library(http/http_server), [http_bind/1, http_loop/1]).
+:- use_module(library(http/http_server), [http_bind/1, http_loop/1, http_prefork_loop/2]).
 :- use_module(library(system), [cd/1]).
 :- use_module(library(format), [format/3]).
 
@@ -28,13 +28,18 @@
 
 main(Args) :- serve(Args).
 
-help_msg("Usage: ciao-serve [-p Port] <action>
+help_msg("Usage: ciao-serve [-p Port] [<prefork options>] <action>
 
 where action is one of:
   help - show this message
   stop - kill running daemons
   <default> - start the server
 
+Prefork options (handle requests in a pool of forked processes):
+  --workers N         number of worker processes
+  --max-requests N    recycle a worker after N requests
+  --max-memory MB     recycle a worker when it uses more than MB megabytes
+
 ").
 
 help :-
@@ -52,20 +57,33 @@ serve([stop]) :- !,
     reload_service_registry,
     service_stop_all.
 serve(Args) :-
-    ( Args = ['-p', PortAtm|Rest] ->
+    ( Args = ['-p', PortAtm|Rest0] ->
         atom_number(PortAtm, Port)
     ; % (leave Port unbound)
-      Rest = Args
+      Rest0 = Args
     ),
+    prefork_opts(Rest0, Rest, Prefork),
     Rest = [],
     % Select default port
     ( var(Port) -> Port = 8000 ; true ),
     dist_set_reg_protocol(filebased), % TODO: customize? needed for actmod_http
-    serve_at_port(Port).
+    serve_at_port(Port, Prefork).
+
+% Options for http_prefork_loop/2 ([] if requests are handled in this process)
+prefork_opts(['--workers', N|Args], Rest, [workers(Workers)|Opts]) :- !,
+    atom_number(N, Workers),
+    prefork_opts(Args, Rest, Opts).
+prefork_opts(['--max-requests', N|Args], Rest, [max_requests(MaxReqs)|Opts]) :- !,
+    atom_number(N, MaxReqs),
+    prefork_opts(Args, Rest, Opts).
+prefork_opts(['--max-memory', MB|Args], Rest, [max_memory(Bytes)|Opts]) :- !,
+    Bytes is ~atom_number(MB) * 1024 * 1024,
+    prefork_opts(Args, Rest, Opts).
+prefork_opts(Args, Args, []).
 
 :- use_module(library(system_extra), [mkpath/1]).
 
-serve_at_port(Port) :-
+serve_at_port(Port, Prefork) :-
     format(user_error, "=> starting HTTP server~n", []),
     reload_service_registry,
     serve_banner(Port),
@@ -74,7 +92,11 @@ serve_at_port(Port) :-
     SiteDir = ~ensure_site_dir,
     cd(SiteDir),
     %
-    http_loop(ExitCode),
+    ( Prefork = [] ->
+        http_loop(ExitCode)
+    ; format(user_error, "   Using worker processes ~w~n", [Prefork]),
+      http_prefork_loop(Prefork, ExitCode)
+    ),
     format(user_error, "=> HTTP server finished with exit code ~w~n", [ExitCode]),
     halt(ExitCode).
 
@@ -312,6 +312,14 @@ If you want to view the WAM instructions of one or more @tt{.pl} files
 you can use the @tt{-w} option.  That will generate a @tt{.wam} file
 with such instructions in a pretty format per each @tt{.pl} file.
 
+Modules that use the @lib{jit} package can be compiled ahead of time
+(AOT) with the @tt{--native} option (see @lib{jit/jit_aot}): the
+predicates that the @lib{jit} package would compile when they become
+hot are compiled to native code beforehand. The WAM code of the module
+is not translated, so other modules are not affected by this option.
+The native code is kept with the foreign code of each module, so that
+it is loaded with the module (also by executables built later).
+
 @section{Usage (ciaoc)}
 
 The following provides details on the different command line options
@@ -353,6 +361,7 @@ available when invoking @apl{ciaoc}:
 :- use_module(library(libpaths),        [get_alias_path/0]).
 :- use_module(library(compiler),        [make_po/1, make_wam/1, use_module/3]).
 :- use_module(library(compiler/c_itf), [opt_suffix/2, default_package/1]).
+:- use_module(library(jit/jit_aot), [make_native/1]).
 :- use_module(library(read_from_string), [read_from_atom/2]).
 :- use_module(library(compiler/global_module_options)).
 
@@ -360,6 +369,7 @@ available when invoking @apl{ciaoc}:
         [make_exec/2, force_lazy/1, dynamic_search_path/1]).
 
 :- use_module(engine(runtime_control), [set_prolog_flag/2, current_prolog_flag/2]).
+:- use_module(engine(messages_basic), [message/2]).
 
 % ---------------------------------------------------------------------------
 
@@ -422,6 +432,13 @@ main(Args) :-
     "Generate .wam files (WAM code) for the input modules.",
     continue, Args, Args).
 %
+:- simple_option('--native',
+    set_fact(output_kind(native)),
+    "AOT for jit modules: compile the predicates of the input modules \n\t"||
+    "(which use the jit package) that the jit would compile to native \n\t"||
+    "code (next to their foreign code, -o cannot be used).",
+    continue, Args, Args).
+%
 :- simple_option('-S',
     ( set_prolog_flag(executables, static),
       get_platform(EngCfg),
@@ -550,6 +567,13 @@ run_ciaoc(Args) :-
         make_po(Args) % TODO: OutputName is ignored, show warning if nonvar?
     ; output_kind(wam) ->
         make_wam(Args) % TODO: OutputName is ignored, show warning if nonvar?
+    ; output_kind(native) ->
+        % (the native code must be kept with the foreign code of each module)
+        ( nonvar(OutputName) ->
+            message(error, ['Option -o cannot be used with --native']),
+            halt(1)
+        ; make_native(Args)
+        )
     ; % (default)
       make_exec(Args, OutputName)
     ).
@@ -1602,6 +1602,15 @@ profile_hook(proceed) => call0('PROFILE__HOOK_PROCEED').
 profile_hook(fail) => call0('PROFILE__HOOK_FAIL').
 profile_hook(redo) => call0('PROFILE__HOOK_REDO').
 
+% ---------------------------------------------------------------------------
+%! # Clause counters (runtime switchable, see eng_profile.h)
+
+:- rkind(clause_counters_hook/2, []).
+clause_counters_hook(try, Alt) =>
+    callstmt('CLAUSE_COUNTERS__HOOK', [Alt, tk('CLAUSE_COUNTERS__TRY')]).
+clause_counters_hook(retry, Alt) =>
+    callstmt('CLAUSE_COUNTERS__HOOK', [Alt, tk('CLAUSE_COUNTERS__RETRY')]).
+
 % ---------------------------------------------------------------------------
 %! # Gauge (profiling counters)
 
@@ -1982,6 +1991,7 @@ backtrack_ =>
     (~w)^.heap_top <- ~node_global_top(~b),
     code_restore_args,
     profile_hook(redo),
+    clause_counters_hook(retry, (~w)^.next_alt),
     (~p) <- cast(bcp, (~w)^.next_alt),
     localv(ptr(try_node), Alt),
     Alt <- cast(ptr(try_node), (~p))^.next,
@@ -2121,9 +2131,15 @@ code_enter_pred =>
          setup_pending_call(~e, tk('address_true')),
          cvoid_call('stack_overflow', []))),
       unset_event,
+      if(cbool_succeed('Yield_Request', []), (
+         (~w)^.misc^.yield_request <- ~false,
+         setup_pending_call(~e, tk('address_yield')))),
       if(~test_cint_event, (
          setup_pending_call(~e, tk('address_help')),
-         cvoid_call('control_c_normal', []))))),
+         cvoid_call('control_c_normal', []))),
+      if(cbool_succeed('Jit_Request', []), (
+         (~w)^.misc^.jit_request <- ~false,
+         setup_pending_call(~e, tk('address_jit')))))),
     goto('switch_on_pred').
 
 switch_on_pred =>
@@ -2397,7 +2413,8 @@ pred_enter_breakpoint =>
 pred_enter_compactcode_indexed =>
     [[ update(mode(w)) ]],
     pred_hook(tk_string("E")),
-    deref_sw(x(0), jump_tryeach((~func)^.code.incoreinfo^.varcase)),
+    jit_count_hook,
+    deref_sw(x(0), jump_tryeach_ix((~func)^.code.incoreinfo^.varcase)),
     localv(tagged, T0, x(0)),
     localv(tagged, T1),
     setmode(r),
@@ -2408,7 +2425,7 @@ pred_enter_compactcode_indexed =>
           T1 <- ~heap_next(~s)
       ), (
           (~s) <- ~tagp_ptr(lst, T0),
-          jump_tryeach((~func)^.code.incoreinfo^.lstcase)
+          jump_tryeach_ix((~func)^.code.incoreinfo^.lstcase)
       )),
       T1 <- T0),
     %
@@ -2428,12 +2445,34 @@ pred_enter_compactcode_indexed =>
         assign(I + sizeof(hashtab_node)),
         T1 <- paren(T1+I) /\ Htab^.mask % (note: paren is not needed, but C emits readability warning)
     ), ~true),
-    jump_tryeach(HtabNode^.value.try_chain). % (this will break the loop)
+    jump_tryeach_ix(HtabNode^.value.try_chain). % (this will break the loop)
 
 pred_enter_compactcode =>
     [[ update(mode(w)) ]],
     pred_hook(tk_string("E")),
-    jump_tryeach((~func)^.code.incoreinfo^.varcase).
+    jit_count_hook,
+    jump_tryeach_ix((~func)^.code.incoreinfo^.varcase).
+
+% Native code (see eng_jit.h), or the bytecode at Lab if it bails
+pred_enter_fastcode(Lab) =>
+    [[ update(mode(w)) ]],
+    pred_hook(tk_string("N")),
+    setmode(r),
+    localv(intmach, I, cfun_eval('jit_call', [~func])),
+    if(I == tk('JIT_OK'), goto_ins(proceed)),
+    if(I == tk('JIT_FAIL'), jump_fail),
+    setmode(w),
+    goto(Lab).
+
+jit_count_hook => callstmt('JIT_COUNT_HOOK', [~func]).
+
+% Like jump_tryeach/1, through the secondary index of the chain (if any)
+jump_tryeach_ix(Alts) =>
+    tk('alts') <- Alts,
+    if(tk('alts')^.index,
+      tk('alts') <- cfun_eval('incore_index_select', [tk('alts')])),
+    tryeach_lab(Lab),
+    goto(Lab).
 
 jump_switch_on_pred_sub(Enter), [[ Enter = tk('ei') ]] => goto('switch_on_pred_sub').
 jump_switch_on_pred_sub(Enter) =>
@@ -2442,9 +2481,9 @@ jump_switch_on_pred_sub(Enter) =>
 
 code_switch_on_pred_sub => % (needs: ei)
     switch(tk('ei'), (
-        case_blk('ENTER_FASTCODE_INDEXED', goto('enter_undefined')),
-        case_blk('ENTER_FASTCODE', goto('enter_undefined')),
-        case_blk('ENTER_UNDEFINED', label_blk('enter_undefined', pred_enter_undefined)),
+        case_blk('ENTER_FASTCODE_INDEXED', pred_enter_fastcode('enter_compactcode_indexed')),
+        case_blk('ENTER_FASTCODE', pred_enter_fastcode('enter_compactcode')),
+        case_blk('ENTER_UNDEFINED', pred_enter_undefined),
         case_blk('ENTER_INTERPRETED', pred_enter_interpreted),
         case_blk('ENTER_C', pred_enter_c),
         case_blk('BUILTIN_TRUE', pred_enter_builtin_true),
@@ -2515,6 +2554,7 @@ alt_dispatcher_ =>
     [[ Alts = tk('alts') ]],
     %
     gauge_incr_counter_alts(Alts),
+    clause_counters_hook(try, Alts),
     %
     emul_p(Alts, EmulP),
     (~p) <- EmulP,
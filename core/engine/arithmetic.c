@@ -110,6 +110,13 @@ static CFUN__PROTO(evaluate, tagged_t, tagged_t v) {
         tagged_t u = *TaggedToArg(v,2);
         CFUN__LASTCALL(((ctagged2_t)proc),t,u);
       }
+    case 3:
+      {
+        tagged_t t = *TaggedToArg(v,1);
+        tagged_t u = *TaggedToArg(v,2);
+        tagged_t s = *TaggedToArg(v,3);
+        CFUN__LASTCALL(((ctagged3_t)proc),t,u,s);
+      }
     }
     goto err;
   }, { /* other */
@@ -185,6 +192,16 @@ static CFUN__PROTO(evaluate, tagged_t, tagged_t v) {
   if (TaggedIsSmall(U)&&TaggedIsSmall(V)) goto LabSmall; else goto LabNonsmall; \
 }
 
+/* Dereference and evaluate U, V and W (using them as GC roots) */
+#define EvalArith3(DOM, U, V, W) { \
+  DerefCheckNonvar(U, 1); \
+  DerefCheckNonvar(V, 2); \
+  DerefCheckNonvar(W, 3); \
+  EvalArith_GC(DOM, U, 1, V, W); \
+  EvalArith_GC(DOM, V, 2, U, W); \
+  EvalArith_GC(DOM, W, 3, U, V); \
+}
+
 /* --------------------------------------------------------------------------- */
 
 #if defined(OPTIM_COMP)
@@ -286,6 +303,37 @@ CFUN__PROTO(bn_call1, tagged_t, bn_fun1_t f, tagged_t x0) {
   CFUN__LASTCALL(bn_finish);
 }
 
+CFUN__PROTO(bn_call3, tagged_t, bn_fun3_t f, tagged_t x0, tagged_t y0, tagged_t m0) {
+  bignum_size_t req;
+  DECL_BIGNUM_FOR_INTVAL(xb);
+  DECL_BIGNUM_FOR_INTVAL(yb);
+  DECL_BIGNUM_FOR_INTVAL(mb);
+  bignum_t *x;
+  bignum_t *y;
+  bignum_t *m;
+
+  if (IsFloat(x0) || IsFloat(y0) || IsFloat(m0)) {
+    SERIOUS_FAULT("bn_call3: called with floats");
+  }
+
+  ENSURE_BIGNUM(x0, xb, x);
+  ENSURE_BIGNUM(y0, yb, y);
+  ENSURE_BIGNUM(m0, mb, m);
+
+  ENSURE_LIVEINFO;
+  req = (*f)(x, y, m, (bignum_t *)G->heap_top, (bignum_t *)Heap_Warn_GC);
+  if (req != 0) {
+    HeapOverflow_GC(req*sizeof(bignum_t), x0, y0, m0);
+    ENSURE_BIGNUM(x0, xb, x);
+    ENSURE_BIGNUM(y0, yb, y);
+    ENSURE_BIGNUM(m0, mb, m);
+    if ((*f)(x, y, m, (bignum_t *)G->heap_top, (bignum_t *)Heap_Warn_GC)) {
+      SERIOUS_FAULT("miscalculated size of bignum");
+    }
+  }
+  CFUN__LASTCALL(bn_finish);
+}
+
 CFUN__PROTO(bn_from_float_GC, tagged_t, flt64_t f) {
   bignum_size_t req;
 
@@ -409,17 +457,190 @@ CFUN__PROTO(flt64_to_blob_GC, tagged_t, flt64_t i) {
 // }
 // #endif
 
+/* --------------------------------------------------------------------------- */
+/* Rational numbers */
+
+/* A rational is an integer or a '$rat'(N,D) structure (D>1 and
+   gcd(N,D)=1). Operations on rationals are exact and return normalized
+   results (an integer when D=1); mixing a rational with a float gives
+   a float. */
+
+#define IsRat(X) (TaggedIsSTR(X) && TaggedToHeadfunctor(X)==functor_rat)
+#define IsNumberQ(X) (IsNumber(X) || IsRat(X))
+
+#define CheckNumberQ(U,ArgNo) ({ \
+  if (!IsNumberQ(U)) { \
+    BUILTIN_ERROR(ERR_type_error(evaluable), (U), (ArgNo)); \
+  } \
+})
+
+#define IntegerIsNeg(X) (TaggedIsSmall(X) ? (X) < TaggedZero : !bn_positive(TaggedToBignum(X)))
+
+/* Numerator N and denominator D of the number U (D=1 if U is not a
+   '$rat'/2 structure) */
+#define RatParts(U, N, D, ArgNo) ({ \
+  if (IsRat(U)) { \
+    DerefArg(N, U, 1); \
+    DerefArg(D, U, 2); \
+    if (!IsInteger(N) || !IsInteger(D) || D == TaggedZero || IntegerIsNeg(D)) { \
+      BUILTIN_ERROR(ERR_type_error(evaluable), (U), (ArgNo)); \
+    } \
+  } else { \
+    N = U; \
+    D = MakeSmall(1); \
+  } \
+})
+
+CFUN__PROTO(fu1_minus, tagged_t, tagged_t x0);
+CFUN__PROTO(fu2_plus, tagged_t, tagged_t x0, tagged_t x1);
+CFUN__PROTO(fu2_times, tagged_t, tagged_t x0, tagged_t x1);
+CFUN__PROTO(fu2_idivide, tagged_t, tagged_t x0, tagged_t x1);
+CFUN__PROTO(fu2_gcd, tagged_t, tagged_t x0, tagged_t x1);
+CFUN__PROTO(fu2_lsh, tagged_t, tagged_t x0, tagged_t x1);
+
+/* N/D in normal form (pre: D>0) */
+static CFUN__PROTO(rat_make, tagged_t, tagged_t n, tagged_t d) {
+  tagged_t g;
+  tagged_t *h;
+  PROT_GC(g = CFUN__EVAL(fu2_gcd, n, d), n, d);
+  if (g != MakeSmall(1)) {
+    PROT_GC(n = CFUN__EVAL(fu2_idivide, n, g), d, g);
+    PROT_GC(d = CFUN__EVAL(fu2_idivide, d, g), n);
+  }
+  if (d == MakeSmall(1)) CFUN__PROCEED(n);
+  HeapMargin_GC(3*sizeof(tagged_t), n, d);
+  h = G->heap_top;
+  HeapPush(h, functor_rat);
+  HeapPush(h, n);
+  HeapPush(h, d);
+  G->heap_top = h;
+  CFUN__PROCEED(Tagp(STR, h-3));
+}
+
+/* -(N/D) */
+static CFUN__PROTO(rat_neg, tagged_t, tagged_t n, tagged_t d) {
+  PROT_GC(n = CFUN__EVAL(fu1_minus, n), d);
+  CFUN__LASTCALL(rat_make, n, d);
+}
+
+/* NU/DU + NV/DV */
+static CFUN__PROTO(rat_add, tagged_t, tagged_t nu, tagged_t du, tagged_t nv, tagged_t dv) {
+  PROT_GC(nu = CFUN__EVAL(fu2_times, nu, dv), du, nv, dv);
+  PROT_GC(nv = CFUN__EVAL(fu2_times, nv, du), nu, du, dv);
+  PROT_GC(nu = CFUN__EVAL(fu2_plus, nu, nv), du, dv);
+  PROT_GC(du = CFUN__EVAL(fu2_times, du, dv), nu);
+  CFUN__LASTCALL(rat_make, nu, du);
+}
+
+/* NU/DU - NV/DV */
+static CFUN__PROTO(rat_sub, tagged_t, tagged_t nu, tagged_t du, tagged_t nv, tagged_t dv) {
+  PROT_GC(nv = CFUN__EVAL(fu1_minus, nv), nu, du, dv);
+  CFUN__LASTCALL(rat_add, nu, du, nv, dv);
+}
+
+/* NU/DU * NV/DV */
+static CFUN__PROTO(rat_mul, tagged_t, tagged_t nu, tagged_t du, tagged_t nv, tagged_t dv) {
+  PROT_GC(nu = CFUN__EVAL(fu2_times, nu, nv), du, dv);
+  PROT_GC(du = CFUN__EVAL(fu2_times, du, dv), nu);
+  CFUN__LASTCALL(rat_make, nu, du);
+}
+
+/* (NU/DU) / (NV/DV) (pre: NV is not zero) */
+static CFUN__PROTO(rat_div, tagged_t, tagged_t nu, tagged_t du, tagged_t nv, tagged_t dv) {
+  PROT_GC(nu = CFUN__EVAL(fu2_times, nu, dv), du, nv);
+  PROT_GC(du = CFUN__EVAL(fu2_times, du, nv), nu);
+  if (IntegerIsNeg(du)) {
+    PROT_GC(nu = CFUN__EVAL(fu1_minus, nu), du);
+    PROT_GC(du = CFUN__EVAL(fu1_minus, du), nu);
+  }
+  CFUN__LASTCALL(rat_make, nu, du);
+}
+
+/* Number of bits of the integer X (rounded up to whole words) */
+#define IntegerBits(X) ((intmach_t)(TaggedIsSmall(X) ? 1 : LargeArity(TaggedToHeadfunctor(X))) * 8 * (intmach_t)sizeof(tagged_t))
+
+/* N/D as a float (pre: D>0). If N or D does not fit in a float, the
+   quotient is first computed on integers scaled to keep 64 bits of
+   precision at least. */
+static CFUN__PROTO(rat_to_flt64, flt64_t, tagged_t n, tagged_t d) {
+  flt64_t fn = TaggedToFloat(n);
+  flt64_t fd = TaggedToFloat(d);
+  if (float_is_finite(fn) && float_is_finite(fd)) CFUN__PROCEED(fn/fd);
+  intmach_t shift = IntegerBits(d) - IntegerBits(n) + 192;
+  if (shift > 0) {
+    PROT_GC(n = CFUN__EVAL(fu2_lsh, n, MakeSmall(shift)), d);
+  } else {
+    PROT_GC(d = CFUN__EVAL(fu2_lsh, d, MakeSmall(-shift)), n);
+  }
+  n = CFUN__EVAL(fu2_idivide, n, d);
+  CFUN__PROCEED(ldexp(TaggedToFloat(n), -shift));
+}
+
+/* Sign of the integer U-V */
+static inline intmach_t integer_compare(tagged_t u, tagged_t v) {
+  if (TaggedIsSmall(u) && TaggedIsSmall(v)) {
+    return (u > v) - (u < v);
+  } else if (TaggedIsSmall(u)) {
+    return bn_positive(TaggedToBignum(v)) ? -1 : 1;
+  } else if (TaggedIsSmall(v)) {
+    return bn_positive(TaggedToBignum(u)) ? 1 : -1;
+  } else {
+    return bn_compare(TaggedToBignum(u), TaggedToBignum(v));
+  }
+}
+
+/* Sign of NU/DU - NV/DV */
+static CFUN__PROTO(rat_compare, intmach_t, tagged_t nu, tagged_t du, tagged_t nv, tagged_t dv) {
+  PROT_GC(nu = CFUN__EVAL(fu2_times, nu, dv), du, nv);
+  PROT_GC(nv = CFUN__EVAL(fu2_times, nv, du), nu);
+  CFUN__PROCEED(integer_compare(nu, nv));
+}
+
+/* Code block for U OP V when U or V is a '$rat'/2 structure (RatFun
+   computes the exact result, CheckZero rejects a zero divisor) */
+#define CFUN__LASTCALL_RatArith(U, V, OP, RatFun, CheckZero) { \
+  tagged_t nu_, du_, nv_, dv_; \
+  RatParts(U, nu_, du_, 1); \
+  RatParts(V, nv_, dv_, 2); \
+  if (IsFloat(U) || IsFloat(V)) { \
+    flt64_t fu_, fv_; \
+    PROT_GC(fu_ = CFUN__EVAL(rat_to_flt64, nu_, du_), nv_, dv_); \
+    fv_ = CFUN__EVAL(rat_to_flt64, nv_, dv_); \
+    CFUN__LASTCALL(flt64_to_blob_GC, fu_ OP fv_); \
+  } \
+  if ((CheckZero) && nv_ == TaggedZero) { \
+    BUILTIN_ERROR(ERR_evaluation_error(zero_divisor), V, 2); \
+  } \
+  CFUN__LASTCALL(RatFun, nu_, du_, nv_, dv_); \
+}
+
+/* Code block for U OP V (comparison) when U or V is a '$rat'/2
+   structure */
+#define CBOOL__LASTTEST_RatCompare(U, V, OP) { \
+  tagged_t nu_, du_, nv_, dv_; \
+  RatParts(U, nu_, du_, 1); \
+  RatParts(V, nv_, dv_, 2); \
+  if (IsFloat(U) || IsFloat(V)) { \
+    flt64_t fu_, fv_; \
+    PROT_GC(fu_ = CFUN__EVAL(rat_to_flt64, nu_, du_), nv_, dv_); \
+    fv_ = CFUN__EVAL(rat_to_flt64, nv_, dv_); \
+    CBOOL__LASTTEST(fu_ OP fv_); \
+  } \
+  CBOOL__LASTTEST(CFUN__EVAL(rat_compare, nu_, du_, nv_, dv_) OP 0); \
+}
+
 /* --------------------------------------------------------------------------- */
 
 CBOOL__PROTO(bu2_numeq, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:=:=", 2);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   CBOOL__LASTTEST(t==u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CBOOL__LASTTEST_RatCompare(t, u, ==);
   if (IsFloat(t) || IsFloat(u)) {
     CBOOL__LASTTEST(TaggedToFloat(t)==TaggedToFloat(u));
   } else if (TaggedIsSmall(t) || TaggedIsSmall(u)) {
@@ -432,12 +653,13 @@ CBOOL__PROTO(bu2_numeq, tagged_t x0, tagged_t x1) {
 CBOOL__PROTO(bu2_numne, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:=\\=", 2);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   CBOOL__LASTTEST(t!=u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CBOOL__LASTTEST_RatCompare(t, u, !=);
   if (IsFloat(t) || IsFloat(u)) {
     CBOOL__LASTTEST(TaggedToFloat(t)!=TaggedToFloat(u));
   } else if (TaggedIsSmall(t) || TaggedIsSmall(u)) {
@@ -450,12 +672,13 @@ CBOOL__PROTO(bu2_numne, tagged_t x0, tagged_t x1) {
 CBOOL__PROTO(bu2_numlt, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:<", 2);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   CBOOL__LASTTEST(t<u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CBOOL__LASTTEST_RatCompare(t, u, <);
   if (IsFloat(t) || IsFloat(u)) {
     CBOOL__LASTTEST(TaggedToFloat(t)<TaggedToFloat(u));
   } else if (TaggedIsSmall(t)) {
@@ -470,12 +693,13 @@ CBOOL__PROTO(bu2_numlt, tagged_t x0, tagged_t x1) {
 CBOOL__PROTO(bu2_numle, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:=<", 2);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   CBOOL__LASTTEST(t<=u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CBOOL__LASTTEST_RatCompare(t, u, <=);
   if (IsFloat(t) || IsFloat(u)) {
     CBOOL__LASTTEST(TaggedToFloat(t)<=TaggedToFloat(u));
   } else if (TaggedIsSmall(t)) {
@@ -490,12 +714,13 @@ CBOOL__PROTO(bu2_numle, tagged_t x0, tagged_t x1) {
 CBOOL__PROTO(bu2_numgt, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:>", 2);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   CBOOL__LASTTEST(t>u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CBOOL__LASTTEST_RatCompare(t, u, >);
   if (IsFloat(t) || IsFloat(u)) {
     CBOOL__LASTTEST(TaggedToFloat(t)>TaggedToFloat(u));
   } else if (TaggedIsSmall(t)) {
@@ -510,12 +735,13 @@ CBOOL__PROTO(bu2_numgt, tagged_t x0, tagged_t x1) {
 CBOOL__PROTO(bu2_numge, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:>=", 2);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   CBOOL__LASTTEST(t>=u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CBOOL__LASTTEST_RatCompare(t, u, >=);
   if (IsFloat(t) || IsFloat(u)) {
     CBOOL__LASTTEST(TaggedToFloat(t)>=TaggedToFloat(u));
   } else if (TaggedIsSmall(t)) {
@@ -540,6 +766,10 @@ CBOOL__PROTO(bu2_numge, tagged_t x0, tagged_t x1) {
  LabNonsmall: \
   if (IsFloat(U)) { \
     CFUN__LASTCALL(flt64_to_blob_GC, -TaggedToFloat(U)); \
+  } else if (IsRat(U)) { \
+    tagged_t n_, d_; \
+    RatParts(U, n_, d_, 1); \
+    CFUN__LASTCALL(rat_neg, n_, d_); \
   } else { \
     goto big_; \
   } \
@@ -563,14 +793,19 @@ end_: {} \
 CFUN__PROTO(fu1_minus, tagged_t, tagged_t x0) {
   ERR__FUNCTOR("arithmetic:$-", 2);
   tagged_t t=x0;
-  EvalArith1Sw(Number, t, small, nonsmall);
+  EvalArith1Sw(NumberQ, t, small, nonsmall);
   CFUN__LASTCALL_NumberNegate(small, nonsmall, t);
 }
 
 CFUN__PROTO(fu1_plus, tagged_t, tagged_t x0) {
   ERR__FUNCTOR("arithmetic:$+", 2);
   tagged_t t=x0;
-  EvalArith1(Number, t);
+  EvalArith1(NumberQ, t);
+  if (IsRat(t)) {
+    tagged_t n, d;
+    RatParts(t, n, d, 1);
+    CFUN__LASTCALL(rat_make, n, d);
+  }
   CFUN__PROCEED(t);
 }
 
@@ -595,9 +830,13 @@ CFUN__PROTO(fu1_integer, tagged_t, tagged_t x0) {
 CFUN__PROTO(fu1_float, tagged_t, tagged_t x0) {
   ERR__FUNCTOR("arithmetic:$float", 2);
   tagged_t t=x0;
-  EvalArith1(Number, t);
+  EvalArith1(NumberQ, t);
   if (IsFloat(t)) {
     CFUN__PROCEED(t);
+  } else if (IsRat(t)) {
+    tagged_t n, d;
+    RatParts(t, n, d, 1);
+    CFUN__LASTCALL(flt64_to_blob_GC, CFUN__EVAL(rat_to_flt64, n, d));
   } else {
     CFUN__LASTCALL(flt64_to_blob_GC, TaggedToFloat(t));
   }
@@ -671,7 +910,7 @@ CFUN__PROTO(fu1_sub1, tagged_t, tagged_t x0) {
 CFUN__PROTO(fu2_plus, tagged_t, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:$+", 3);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   {
@@ -684,6 +923,7 @@ CFUN__PROTO(fu2_plus, tagged_t, tagged_t x0, tagged_t x1) {
   CFUN__LASTCALL(bn_call2,bn_add,t,u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CFUN__LASTCALL_RatArith(t, u, +, rat_add, FALSE);
   if (IsFloat(t) || IsFloat(u)) {
     CFUN__LASTCALL(flt64_to_blob_GC, TaggedToFloat(t) + TaggedToFloat(u));
   } else {
@@ -717,7 +957,7 @@ CFUN__PROTO(fu2_plus, tagged_t, tagged_t x0, tagged_t x1) {
 CFUN__PROTO(fu2_minus, tagged_t, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:$-", 3);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   {
@@ -730,6 +970,7 @@ CFUN__PROTO(fu2_minus, tagged_t, tagged_t x0, tagged_t x1) {
   CFUN__LASTCALL(bn_call2,bn_subtract,t,u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CFUN__LASTCALL_RatArith(t, u, -, rat_sub, FALSE);
   if (IsFloat(t) || IsFloat(u)) {
     CFUN__LASTCALL(flt64_to_blob_GC, TaggedToFloat(t) - TaggedToFloat(u));
   } else {
@@ -761,7 +1002,7 @@ CFUN__PROTO(fu2_minus, tagged_t, tagged_t x0, tagged_t x1) {
 CFUN__PROTO(fu2_times, tagged_t, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:$*", 3);
   tagged_t t=x0,u=x1;
-  EvalArith2Sw(Number, t, u, small, nonsmall);
+  EvalArith2Sw(NumberQ, t, u, small, nonsmall);
 
  small:
   {
@@ -774,6 +1015,7 @@ CFUN__PROTO(fu2_times, tagged_t, tagged_t x0, tagged_t x1) {
   CFUN__LASTCALL(bn_call2,bn_multiply,t,u);
 
  nonsmall:
+  if (IsRat(t) || IsRat(u)) CFUN__LASTCALL_RatArith(t, u, *, rat_mul, FALSE);
   if (IsFloat(t) || IsFloat(u)) {
     CFUN__LASTCALL(flt64_to_blob_GC, TaggedToFloat(t) * TaggedToFloat(u));
   } else {
@@ -784,10 +1026,21 @@ CFUN__PROTO(fu2_times, tagged_t, tagged_t x0, tagged_t x1) {
 CFUN__PROTO(fu2_fdivide, tagged_t, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:$/", 3);
   tagged_t t=x0,u=x1;
-  EvalArith2(Number, t, u);
+  EvalArith2(NumberQ, t, u);
+  if (IsRat(t) || IsRat(u)) CFUN__LASTCALL_RatArith(t, u, /, rat_div, TRUE);
   CFUN__LASTCALL(flt64_to_blob_GC, TaggedToFloat(t)/TaggedToFloat(u));
 }
 
+/* Exact division of rationals */
+CFUN__PROTO(fu2_rdiv, tagged_t, tagged_t x0, tagged_t x1) {
+  ERR__FUNCTOR("arithmetic:$rdiv", 3);
+  tagged_t t=x0,u=x1;
+  EvalArith2(NumberQ, t, u);
+  if (IsFloat(t)) BUILTIN_ERROR(ERR_type_error(rational), t, 1);
+  if (IsFloat(u)) BUILTIN_ERROR(ERR_type_error(rational), u, 2);
+  CFUN__LASTCALL_RatArith(t, u, /, rat_div, TRUE);
+}
+
 CFUN__PROTO(fu2_idivide, tagged_t, tagged_t x0, tagged_t x1) {
   ERR__FUNCTOR("arithmetic:$//", 3);
   tagged_t t=x0,u=x1;
@@ -885,7 +1138,7 @@ CFUN__PROTO(fu2_mod, tagged_t, tagged_t x0, tagged_t x1) {
 CFUN__PROTO(fu1_sign, tagged_t, tagged_t x0) {
   ERR__FUNCTOR("arithmetic:$sign", 2);
   tagged_t t=x0;
-  EvalArith1Sw(Number, t, small, nonsmall);
+  EvalArith1Sw(NumberQ, t, small, nonsmall);
 
  small:
   if (t==TaggedZero) {
@@ -906,6 +1159,10 @@ CFUN__PROTO(fu1_sign, tagged_t, tagged_t x0) {
     } else {
       CFUN__LASTCALL(flt64_to_blob_GC, 1.0);
     }
+  } else if (IsRat(t)) {
+    tagged_t n, d;
+    RatParts(t, n, d, 1);
+    CFUN__LASTCALL(fu1_sign, n);
   } else {
     if (!bn_positive(TaggedToBignum(t))) {
       CFUN__PROCEED(SmallSub(TaggedZero,1));
@@ -929,7 +1186,13 @@ end_: {} \
 CFUN__PROTO(fu1_abs, tagged_t, tagged_t x0) {
   ERR__FUNCTOR("arithmetic:$abs", 2);
   tagged_t t=x0;
-  EvalArith1(Number, t);
+  EvalArith1(NumberQ, t);
+  if (IsRat(t)) {
+    tagged_t n, d;
+    RatParts(t, n, d, 1);
+    if (IntegerIsNeg(n)) CFUN__LASTCALL(rat_neg, n, d);
+    CFUN__LASTCALL(rat_make, n, d);
+  }
 
   BranchNumberIsNeg(t, neg_small, neg_nonsmall);
   CFUN__PROCEED(t);
@@ -1156,6 +1419,66 @@ CFUN__PROTO(fu2_gcd, tagged_t, tagged_t x0, tagged_t x1) {
   }
 } 
 
+/* Modular exponentiation, the result has the sign of the modulus (as
+   in mod) */
+CFUN__PROTO(fu3_powm, tagged_t, tagged_t x0, tagged_t x1, tagged_t x2) {
+  ERR__FUNCTOR("arithmetic:$powm", 4);
+  tagged_t b=x0,e=x1,m=x2;
+  tagged_t r;
+  bool_t neg = FALSE;
+  EvalArith3(Integer, b, e, m);
+
+  BranchIntegerIsNeg(e, neg_exp, neg_exp);
+  if (m == TaggedZero) BUILTIN_ERROR(ERR_evaluation_error(zero_divisor), m, 3);
+  BranchIntegerIsNeg(m, neg_mod, neg_mod);
+  goto reduce;
+ neg_exp:
+  BUILTIN_ERROR(ERR_evaluation_error(e_undefined), e, 2);
+ neg_mod:
+  neg = TRUE;
+  PROT_GC(m = CFUN__EVAL(fu1_minus, m), b, e);
+ reduce:
+  PROT_GC(b = CFUN__EVAL(fu2_mod, b, m), e, m);
+  if (TaggedIsSmall(b) && TaggedIsSmall(e) && TaggedIsSmall(m) &&
+      GetSmall(m) <= ((intval_t)1<<(4*sizeof(intval_t)))) {
+    /* (products of residues fit in uintval_t) */
+    uintval_t bb = GetSmall(b);
+    uintval_t mm = GetSmall(m);
+    uintval_t rr = 1 % mm;
+    for (intval_t ee = GetSmall(e); ee > 0; ee >>= 1) {
+      if (ee & 1) rr = rr * bb % mm;
+      bb = bb * bb % mm;
+    }
+    r = MakeSmall(rr);
+  } else {
+    PROT_GC(r = CFUN__EVAL(bn_call3,bn_powm,b,e,m), m);
+  }
+  if (neg && r != TaggedZero) CFUN__LASTCALL(fu2_minus, r, m);
+  CFUN__PROCEED(r);
+}
+
+/* Integer square root (floor(sqrt(X)), exact for bignums) */
+CFUN__PROTO(fu1_isqrt, tagged_t, tagged_t x0) {
+  ERR__FUNCTOR("arithmetic:$isqrt", 2);
+  tagged_t t=x0;
+  EvalArith1Sw(Integer, t, small, nonsmall);
+
+ small:
+  {
+    intval_t i = GetSmall(t);
+    if (i < 0) BUILTIN_ERROR(ERR_evaluation_error(e_undefined), t, 1);
+    /* (correct the rounding errors of sqrt()) */
+    intval_t r = (intval_t)sqrt((flt64_t)i);
+    while (r*r > i) r--;
+    while ((r+1)*(r+1) <= i) r++;
+    CFUN__PROCEED(MakeSmall(r));
+  }
+
+ nonsmall:
+  if (!bn_positive(TaggedToBignum(t))) BUILTIN_ERROR(ERR_evaluation_error(e_undefined), t, 1);
+  CFUN__LASTCALL(bn_call1,bn_isqrt,t);
+}
+
 CFUN__PROTO(fu1_intpart, tagged_t, tagged_t x0) {
   ERR__FUNCTOR("arithmetic:$float_integer_part", 2);
   tagged_t t=x0;
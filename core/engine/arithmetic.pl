@@ -150,6 +150,23 @@ X=:=Y :- X=:=Y. % (compiled inline, hook for interpreter)
 X=\=Y :- X=\=Y. % (compiled inline, hook for interpreter)
 :- endif.
 
+:- export(divmod/4).
+:- doc(divmod(Dividend, Divisor, Quotient, Remainder), "Integer
+   division with the quotient rounded towards negative infinity:
+   @var{Remainder} is @tt{@var{Dividend} mod @var{Divisor}} (which has
+   the sign of @var{Divisor}) and @var{Quotient} is such that
+   @tt{@var{Dividend} =:= @var{Quotient}*@var{Divisor}+@var{Remainder}}.
+   Both @var{Dividend} and @var{Divisor} are integer expressions.").
+:- trust pred divmod(+A, +B, -Q, -R)
+    : intexpression * intexpression * term * term
+    => intexpression * intexpression * int * int.
+
+divmod(Dividend, Divisor, Quotient, Remainder) :-
+    X is Dividend,
+    Y is Divisor,
+    Remainder is X mod Y,
+    Quotient is (X - Remainder) // Y.
+
 :- if(defined(optim_comp)).
 % Internal arithmetic predicates (the compiler unfolds is/2 when possible)
 :- export('$-'/2).
@@ -211,6 +228,12 @@ X=\=Y :- X=\=Y. % (compiled inline, hook for interpreter)
 
 :- export('$gcd'/3).
 :- '$props'('$gcd'/3, [impnat=cfun(fu2_gcd,yes)]).
+:- export('$powm'/4).
+:- '$props'('$powm'/4, [impnat=cfun(fu3_powm,yes)]).
+:- export('$isqrt'/2).
+:- '$props'('$isqrt'/2, [impnat=cfun(fu1_isqrt,yes)]).
+:- export('$rdiv'/3).
+:- '$props'('$rdiv'/3, [impnat=cfun(fu2_rdiv,yes)]).
 :- export('$exp'/2).
 :- '$props'('$exp'/2, [impnat=cfun(fu1_exp,yes)]). % (ISO) 
 :- export('$log'/2).
@@ -256,6 +279,9 @@ X=\=Y :- X=\=Y. % (compiled inline, hook for interpreter)
     ;'mod'/2->fu2_mod
     ;'**'/2->fu2_pow
     ;'gcd'/2->fu2_gcd
+    ;'powm'/3->fu3_powm
+    ;'isqrt'/1->fu1_isqrt
+    ;'rdiv'/2->fu2_rdiv
     ;'exp'/1->fu1_exp
     ;'log'/1->fu1_log
     ;'sqrt'/1->fu1_sqrt
@@ -305,7 +331,8 @@ X=\=Y :- X=\=Y. % (compiled inline, hook for interpreter)
    @item @pred{// /2}: integer division.  Float arguments are truncated
    to integers, result always integer. @hfill @iso
 
-   @item @pred{/ /2}: division.  Result always float. @hfill @iso
+   @item @pred{/ /2}: division.  Result always float, unless an
+   argument is a rational (see @pred{rdiv/2}). @hfill @iso
 
    @item @pred{rem/2}: integer remainder.  The result is always an
    integer, its sign is the sign of the first argument. @hfill @iso
@@ -367,8 +394,29 @@ X=\=Y :- X=\=Y. % (compiled inline, hook for interpreter)
    @item @pred{gcd/2}: Greatest common divisor.  Arguments must evaluate
    to integers, result always integer.
 
+   @item @pred{powm/3}: modular exponentiation, @tt{powm(B,E,M)} is
+   @tt{(B^E) mod M} computed without the intermediate power.  Arguments
+   must evaluate to integers, @var{E} must be non-negative and @var{M}
+   non-zero. The result has the sign of @var{M} (as in @pred{mod/2}).
+
+   @item @pred{isqrt/1}: integer square root (the largest integer whose
+   square is not greater than the argument).  The argument must
+   evaluate to a non-negative integer.
+
+   @item @pred{rdiv/2}: exact division.  Arguments must evaluate to
+   integers or rationals, the result is a rational.
+
    @end{itemize}
 
+   A @concept{rational number} is represented as the structure
+   @tt{'$rat'(@var{N},@var{D})}, with @var{D}>1 and @var{N} and
+   @var{D} coprime, or as an integer if the denominator is 1.
+   @pred{+/2}, @pred{-/2}, @pred{* /2}, @pred{/ /2}, @pred{-/1},
+   @pred{abs/1}, @pred{sign/1} and the comparison predicates compute
+   exactly on rationals and return normalized results; @pred{float/1}
+   converts a rational to a float, and combining a rational with a
+   float gives a float.
+
    In addition to these functors, a list of just a number evaluates to
    this number.  Since a @concept{quoted string} is just a list of
    integers, this allows a quoted character to be used in place of its
@@ -392,6 +440,8 @@ arithexpression(X-Y) :- arithexpression(X), arithexpression(Y).
 arithexpression(X*Y) :- arithexpression(X), arithexpression(Y).
 arithexpression(X//Y) :- arithexpression(X), arithexpression(Y).
 arithexpression(X/Y) :- arithexpression(X), arithexpression(Y).
+arithexpression(rdiv(X, Y)) :- arithexpression(X), arithexpression(Y).
+arithexpression('$rat'(X, Y)) :- int(X), int(Y).
 %arithexpression(X rem Y) :- arithexpression(X), arithexpression(Y).
 %arithexpression(X mod Y) :- arithexpression(X), arithexpression(Y).
 arithexpression(abs(X)) :- arithexpression(X).
@@ -449,6 +499,8 @@ intexpression(X\/Y) :- arithexpression(X), arithexpression(Y).
 intexpression(\(X)) :- arithexpression(X).
 intexpression(X#Y) :- arithexpression(X), arithexpression(Y).
 intexpression(gcd(X, Y)) :- intexpression(X), intexpression(Y).
+intexpression(powm(X, Y, Z)) :- intexpression(X), intexpression(Y), intexpression(Z).
+intexpression(isqrt(X)) :- intexpression(X).
 intexpression([X]) :- intexpression(X).
 
 :- multifile('$internal_error_where_term'/4).
@@ -475,6 +527,9 @@ intexpression([X]) :- intexpression(X).
 '$internal_error_where_term'('arithmetic:$<<', 3, _, 'arithmetic:is'/2-2).
 '$internal_error_where_term'('arithmetic:$>>', 3, _, 'arithmetic:is'/2-2).
 '$internal_error_where_term'('arithmetic:$gcd', 3, _, 'arithmetic:is'/2-2).
+'$internal_error_where_term'('arithmetic:$powm', 4, _, 'arithmetic:is'/2-2).
+'$internal_error_where_term'('arithmetic:$isqrt', 2, _, 'arithmetic:is'/2-2).
+'$internal_error_where_term'('arithmetic:$rdiv', 3, _, 'arithmetic:is'/2-2).
 '$internal_error_where_term'('arithmetic:$float_integer_part', 2, _, 'arithmetic:is'/2-2).
 '$internal_error_where_term'('arithmetic:$float_fractional_part', 2, _, 'arithmetic:is'/2-2).
 '$internal_error_where_term'('arithmetic:$floor', 2, _, 'arithmetic:is'/2-2).
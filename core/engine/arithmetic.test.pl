@@ -0,0 +1,196 @@
+:- module(_, [], [assertions, nativeprops]).
+
+:- doc(title, "Tests for arithmetic.pl").
+
+:- doc(module, "Checks arithmetic on large integers, with operands
+   above and below the sizes where the engine switches from the
+   classical algorithms to the subquadratic ones (Karatsuba and Toom-3
+   multiplication, divide and conquer division and radix
+   conversion), the integer functions @tt{powm/3}, @tt{isqrt/1} and
+   @pred{divmod/4}, and arithmetic on rationals.").
+
+:- use_module(engine(arithmetic)).
+:- use_module(engine(atomic_basic)).
+:- use_module(library(lists), [length/2]).
+
+% (operand sizes, in bits)
+size(100).
+size(2000).
+size(7000).
+size(30000).
+size(200000).
+
+pow(_, 0, P) :- !, P = 1.
+pow(B, E, P) :-
+    E2 is E // 2,
+    pow(B, E2, P2),
+    ( E mod 2 =:= 0 -> P is P2*P2 ; P is P2*P2*B ).
+
+% X has about Bits bits, all digits in base 2^30 are non-zero
+operand(Bits, X) :-
+    N is Bits // 30 + 1,
+    operand_(N, 12345, X).
+
+operand_(0, _, X) :- !, X = 0.
+operand_(N, S, X) :-
+    S1 is (S * 1103515245 + 12345) mod 2147483648,
+    N1 is N - 1,
+    operand_(N1, S1, X1),
+    X is X1 * 1073741824 + (S1 mod 1073741823) + 1.
+
+:- export(mult_div/0).
+:- test mult_div # "Multiplication and division are inverse".
+
+mult_div :-
+    \+ ( size(BX), size(BY),
+         operand(BX, X),
+         operand(BY, Y0), Y is Y0 + 7,
+         R is Y0 // 3,
+         \+ mult_div_(X, Y, R) ).
+
+mult_div_(X, Y, R) :-
+    P is X*Y+R,
+    P // Y =:= X, P mod Y =:= R, P rem Y =:= R,
+    N is -P,
+    N // Y =:= -X, N rem Y =:= -R,
+    N mod Y =:= Y-R,
+    N // (-Y) =:= X,
+    P*P =:= N*N, % (the same term as both operands)
+    X*Y =:= Y*X.
+
+:- export(squares/0).
+:- test squares # "Squares of negative numbers".
+
+squares :-
+    X is -(1<<100), Y is X*X, Y =:= 1<<200,
+    operand(30000, A), B is -A, C is B*B, D is A*A, C =:= D, C > 0,
+    E is B//B, E =:= 1.
+
+:- export(known_values/0).
+:- test known_values # "Products and quotients with known values".
+
+known_values :-
+    pow(10, 5000, T),
+    Y is T - 1,
+    Y*Y =:= T*T - 2*T + 1,
+    (T*T) // Y =:= T + 1,
+    (T*T) mod Y =:= 1,
+    pow(3, 20000, P3), pow(3, 10000, Q3),
+    P3 // Q3 =:= Q3, P3 mod Q3 =:= 0.
+
+:- export(print_read/0).
+:- test print_read # "Conversion to and from text".
+
+print_read :-
+    pow(10, 20000, T),
+    number_codes(T, [0'1|Zs]), length(Zs, 20000), \+ member_nonzero(Zs),
+    M is -T + 1, number_codes(M, [0'-|Ns]), length(Ns, 20000), \+ member_nonnine(Ns),
+    \+ ( size(B), operand(B, X),
+         \+ print_read_(X) ).
+
+print_read_(X) :-
+    N is -X,
+    number_codes(X, Cs), number_codes(X1, Cs), X1 =:= X,
+    number_codes(N, [0'-|Cs]),
+    number_codes(X, 16, Hs), number_codes(X2, 16, Hs), X2 =:= X,
+    number_codes(N, 2, [0'-|Bs]), number_codes(N2, 2, [0'-|Bs]), N2 =:= N,
+    length(Hs, LH), length(Bs, LB), LH =:= (LB+3) // 4.
+
+member_nonzero([C|Cs]) :- ( C \== 0'0 -> true ; member_nonzero(Cs) ).
+member_nonnine([C|Cs]) :- ( C \== 0'9 -> true ; member_nonnine(Cs) ).
+
+:- export(known_text/0).
+:- test known_text # "Decimal digits of a power of 3".
+
+% (computed with an independent implementation)
+known_text :-
+    pow(3, 100000, X),
+    number_codes(X, Cs),
+    length(Cs, 47713),
+    digit_sum(Cs, 0, 214074),
+    prefix_codes("13349714142304014694", Cs),
+    append_suffix(Cs, "74250669865522000001").
+
+digit_sum([], S, S).
+digit_sum([C|Cs], S0, S) :- S1 is S0 + C - 0'0, digit_sum(Cs, S1, S).
+
+prefix_codes([], _).
+prefix_codes([C|Ps], [C|Cs]) :- prefix_codes(Ps, Cs).
+
+append_suffix(Cs, Suffix) :-
+    length(Cs, N), length(Suffix, M), K is N - M,
+    skip(K, Cs, Suffix).
+
+skip(0, Cs, Cs) :- !.
+skip(K, [_|Cs], Rest) :- K1 is K - 1, skip(K1, Cs, Rest).
+
+:- export(powm/0).
+:- test powm # "Modular exponentiation agrees with the naive definition".
+
+powm :-
+    powm(3, 1000, 1000007) =:= 297623,
+    powm(5, 3, -7) =:= -1,
+    powm(-2, 3, 5) =:= 2,
+    powm(7, 0, 1) =:= 0,
+    \+ ( size(BM), size(BB), BM =< 7000, BB =< 2000,
+         operand(BM, M0), M is M0 + 2,
+         operand(BB, B), E = 101,
+         pow(B, E, P),
+         \+ ( powm(B, E, M) =:= P mod M,
+              powm(-B, E, -M) =:= (-P) mod (-M) ) ),
+    % (Fermat's little theorem for the Mersenne prime 2^521-1)
+    Q is (1 << 521) - 1,
+    operand(2000, A),
+    powm(A, Q, Q) =:= A mod Q.
+
+:- export(isqrt/0).
+:- test isqrt # "Integer square roots".
+
+isqrt :-
+    isqrt(0) =:= 0, isqrt(1) =:= 1, isqrt(3) =:= 1, isqrt(4) =:= 2,
+    isqrt((1 << 62) - 1) =:= (1 << 31) - 1,
+    \+ ( size(B), operand(B, X),
+         R is isqrt(X),
+         \+ ( R*R =< X, (R+1)*(R+1) > X ) ),
+    \+ ( size(B), operand(B, X),
+         S is X*X,
+         \+ ( isqrt(S) =:= X, isqrt(S-1) =:= X-1, isqrt(S+2*X) =:= X ) ).
+
+:- export(divmod/0).
+:- test divmod # "Floored division and remainder".
+
+divmod :-
+    divmod(7, 2, 3, 1),
+    divmod(-7, 2, -4, 1),
+    divmod(7, -2, -4, -1),
+    divmod(-7, -2, 3, -1),
+    operand(7000, X), operand(2000, Y),
+    divmod(-X, Y, Q, R),
+    Q*Y+R =:= -X, R >= 0, R < Y.
+
+:- export(rationals/0).
+:- test rationals # "Exact arithmetic and comparison on rationals".
+
+rationals :-
+    X is rdiv(1, 3), X == '$rat'(1,3),
+    Y is X + rdiv(1, 6), Y == '$rat'(1,2),
+    Z is Y * 2, Z == 1,
+    W is rdiv(2, -4), W == '$rat'(-1,2),
+    V is X / 2, V == '$rat'(1,6),
+    U is -X, U == '$rat'(-1,3),
+    abs(W) =:= Y, sign(W) =:= -1,
+    F is X + 0.5, float(F), F > 0.83, F < 0.84,
+    X < Y, Y =:= rdiv(3, 6), X =\= Y, X > 0.3,
+    T is '$rat'(4, 8), T == '$rat'(1,2),
+    % (floats of rationals whose parts do not fit in a float)
+    operand(2000, B),
+    G is float(rdiv(B + 1, 3*B)), G > 0.333, G < 0.334,
+    \+ ( size(S), S =< 7000, operand(S, N), D is N + 2,
+         Q is rdiv(N, D),
+         \+ ( Q*D =:= N, Q - rdiv(N, D) =:= 0, Q < 1 ) ),
+    catch(_ is rdiv(1, 0), E1, true),
+    E1 = error(evaluation_error(zero_divisor), _),
+    catch(_ is rdiv(1.0, 2), E2, true),
+    E2 = error(type_error(rational, 1.0), _),
+    catch(_ is X / 0, E3, true),
+    E3 = error(evaluation_error(zero_divisor), _).
@@ -24,9 +24,11 @@
 #include <ciao/rt_exp.h>
 #include <ciao/runtime_control.h>
 #include <ciao/dynamic_rt.h>
+#include <ciao/internals.h>
 #include <ciao/eng_gc.h>
 #include <ciao/timing.h>
 #include <ciao/eng_profile.h>
+#include <ciao/eng_jit.h>
 #include <ciao/tabling.h>
 
 #include <ciao/bc_aux.h>
@@ -199,6 +199,7 @@ static try_node_t *get_null_alt(int arity)
 #endif
   a->next = NULL;               /* no more alternatives */
   a->previous = NULL;
+  a->index = NULL;
   null_alt = a;
   return a;
 }
@@ -255,6 +256,7 @@ try_node_t *def_retry_c(cbool0_t proc, int arity)
   item->entry_counter[1] = 0;
 #endif
   item->previous = NULL;
+  item->index = NULL;
   return item;
 }
 
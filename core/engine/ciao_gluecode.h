@@ -26,7 +26,11 @@
 /* TODO: decide which exception should be raised when an exception happens in
    the C code */
 
+#if defined(USE_THREADS)
+extern __thread jmp_buf ciao_gluecode_jmpbuf;
+#else
 extern jmp_buf ciao_gluecode_jmpbuf;
+#endif
 #define GLUECODE_TRY(Call) ({ \
   if (setjmp(ciao_gluecode_jmpbuf)) { \
     BUILTIN_ERROR(ERR_foreign_error, X(0), -1); \
@@ -43,13 +43,18 @@
 #include <ciao/eng_bignum.h>
 #include <ciao/eng_gc.h>
 #include <ciao/basiccontrol.h>
+#include <ciao/eng_numarray.h>
 #endif
 
 void ciao_exit(int result);
 
 /* ------------------------------------------------------------------------- */
 
+#if defined(USE_THREADS)
+__thread ciao_ctx ciao_implicit_ctx;
+#else
 ciao_ctx ciao_implicit_ctx;
+#endif
 
 /* ------------------------------------------------------------------------- */
 
@@ -113,8 +118,16 @@ extern try_node_t nullgoal_alt;
 extern try_node_t defaultgoal_alt;
 extern try_node_t startgoal_alt;
 
+#if !defined(OPTIM_COMP)
+/* Serializes code loading from the C API */
+static SLOCK ciao_load_l;
+#endif
+
 /* (must be called after ciao_opts) */
 void ciao_init(const char *boot_path) {
+#if !defined(OPTIM_COMP)
+  Init_slock(ciao_load_l);
+#endif
   engine_init(boot_path, NULL);
 }
 
@@ -135,17 +148,17 @@ void ciao_reinit(void) {
 /* ------------------------------------------------------------------------- */
 /* Ciao context creation */
 
+/* A new context (with its own worker) owned by the calling thread.
+   Different threads may use different contexts concurrently. */
 ciao_ctx ciao_ctx_new(void) {
 #if defined(OPTIM_COMP)
   // TODO: see 'core' version
   return gimme_a_new_gd();
 #else
-  static int first = 1;
-  if (first) {
-    return init_first_gd_entry();
-  } else {
-    return gimme_a_new_gd();
-  }
+  ciao_ctx ctx;
+  ctx = init_first_gd_entry();
+  ctx->time_slice = 0;
+  return ctx;
 #endif
 }
 
@@ -154,9 +167,7 @@ void ciao_ctx_free(ciao_ctx ctx) {
   // TODO: see 'core' version
   release_goal_desc(ctx);
 #else
-  if ((ctx->state != PENDING_SOLS) &&
-      (ctx->state != FAILED))
-    return; /* Trying to release a worker either working or without assigned work */
+  if (ctx->state == IDLE) return; /* Already released */
 
   make_goal_desc_free(ctx);
 #endif
@@ -198,9 +209,11 @@ FILE *ciao_open_qfile(const char *boot_path) {
 
 void ciao_load_qfile_s(ciao_ctx ctx, const char *boot_path) {
   FILE *qfile;
+  Wait_Acquire_slock(ciao_load_l);
   qfile = ciao_open_qfile(boot_path);
   load_ql_files(ctx->worker_registers, qfile);
   fclose(qfile);
+  Release_slock(ciao_load_l);
 }
 #endif
 
@@ -228,9 +241,11 @@ void ciao_open_exec_skip_stub(const char *file, FILE **stream);
 
 void ciao_load_embedded_qfile_s(ciao_ctx ctx, const char *program_name) {
   FILE *qfile;
+  Wait_Acquire_slock(ciao_load_l);
   qfile = ciao_open_embedded_qfile(program_name);
   load_ql_files(ctx->worker_registers, qfile);
   fclose(qfile);
+  Release_slock(ciao_load_l);
 }
 
 void ciao_load_embedded_qfile(const char *program_name) {
@@ -910,6 +925,96 @@ TEMPLATE(ciao_mk_c_double_list, double, BoxFloat(*s), 8)
 
 /* ------------------------------------------------------------------------- */
 
+ciao_term ciao_mk_numarray_s(ciao_ctx ctx, int type, size_t length, void **data) {
+  tagged_t t;
+  intmach_t id;
+  numarray_view_t v;
+  id = length > (size_t)INTMACH_MAX ? 0 : numarray_new(type, (intmach_t)length);
+  if (id == 0) {
+    if (data != NULL) *data = NULL;
+    return ciao_ref(ctx, atom_nil);
+  }
+  ciao_ensure_heap(ctx, NUMARRAY_CELLS);
+  WITH_WORKER(ctx->worker_registers, {
+    t = CFUN__EVAL(numarray_term, id, type, 0, length);
+  });
+  if (data != NULL) {
+    (void)numarray_view(t, &v);
+    *data = v.ptr;
+  }
+  return ciao_ref(ctx, t);
+}
+
+ciao_term ciao_mk_numarray(int type, size_t length, void **data) {
+  return ciao_mk_numarray_s(ciao_implicit_ctx, type, length, data);
+}
+
+int ciao_numarray_type_s(ciao_ctx ctx, ciao_term term) {
+  numarray_view_t v;
+  if (!numarray_view(ciao_unref(ctx, term), &v)) return -1;
+  return v.type;
+}
+
+int ciao_numarray_type(ciao_term term) {
+  return ciao_numarray_type_s(ciao_implicit_ctx, term);
+}
+
+void *ciao_numarray_data_s(ciao_ctx ctx, ciao_term term, size_t *length) {
+  numarray_view_t v;
+  if (!numarray_view(ciao_unref(ctx, term), &v)) {
+    if (length != NULL) *length = 0;
+    return NULL;
+  }
+  if (length != NULL) *length = v.len;
+  return v.ptr;
+}
+
+void *ciao_numarray_data(ciao_term term, size_t *length) {
+  return ciao_numarray_data_s(ciao_implicit_ctx, term, length);
+}
+
+size_t ciao_numarray_length(ciao_ctx ctx, ciao_term term) {
+  size_t length;
+  (void)ciao_numarray_data_s(ctx, term, &length);
+  return length;
+}
+
+ciao_bool ciao_numarray_free_s(ciao_ctx ctx, ciao_term term) {
+  numarray_view_t v;
+  return numarray_view(ciao_unref(ctx, term), &v) && numarray_free(v.id);
+}
+
+ciao_bool ciao_numarray_free(ciao_term term) {
+  return ciao_numarray_free_s(ciao_implicit_ctx, term);
+}
+
+#define Def_ciao_numarray_X(CType, DeclType, Type) \
+ciao_bool ciao_is_##CType##_numarray(ciao_ctx ctx, ciao_term term) { \
+  return ciao_numarray_type_s(ctx, term) == Type; \
+} \
+DeclType *ciao_get_##CType##_numarray(ciao_ctx ctx, ciao_term term) { \
+  if (ciao_numarray_type_s(ctx, term) != Type) return NULL; \
+  return (DeclType *)ciao_numarray_data_s(ctx, term, NULL); \
+} \
+ciao_term ciao_mk_##CType##_numarray(ciao_ctx ctx, DeclType *s, size_t length) { \
+  void *data; \
+  ciao_term t; \
+  t = ciao_mk_numarray_s(ctx, Type, length, &data); \
+  if (data != NULL) memcpy(data, s, length * sizeof(DeclType)); \
+  return t; \
+}
+
+Def_ciao_numarray_X(c_int8, int8_t, NUMARRAY_INT8)
+Def_ciao_numarray_X(c_int16, int16_t, NUMARRAY_INT16)
+Def_ciao_numarray_X(c_int32, int32_t, NUMARRAY_INT32)
+Def_ciao_numarray_X(c_int64, int64_t, NUMARRAY_INT64)
+Def_ciao_numarray_X(c_float, float, NUMARRAY_FLOAT32)
+Def_ciao_numarray_X(c_double, double, NUMARRAY_FLOAT64)
+
+#undef Def_ciao_numarray_X
+
+/* ------------------------------------------------------------------------- */
+
 char *ciao_list_to_str(ciao_ctx ctx, ciao_term list) {
   char *string;
   size_t length;
@@ -963,10 +1068,168 @@ void ciao_cut(ciao_ctx ctx, ciao_choice choice) {
   });
 }
 
-void ciao_fail(ciao_ctx ctx) {
+/* ------------------------------------------------------------------------- */
+/* Time slices [EXPERIMENTAL] */
+
+/* Each run of the abstract machine from the C API for a context with
+   a time slice is suspended, as if internals:'$yield'/0 was called,
+   at the first predicate call after the slice is over (continue with
+   ciao_query_resume()). A watchdog thread keeps the list of running
+   contexts and raises the yield requests. It only sets the (volatile)
+   Yield_Request flag and sends SLICE_SIGNAL to the thread of the
+   worker; the event that makes the worker check the flag is set by
+   the signal handler, in that thread (as interrupt_worker() does for
+   ^C), never by the watchdog. */
+
+#if !defined(OPTIM_COMP) && defined(USE_THREADS) && defined(USE_POSIX_THREADS)
+#define USE_TIME_SLICES 1
+#endif
+
+#if defined(USE_TIME_SLICES)
+#include <signal.h>
+
+/* Insist on expired runs (until they end) after this time */
+#define SLICE_RETRY_USECS 1000
+
+/* (ignored by default, not used elsewhere in the engine; the host
+   may use it too, its handler is called for the signals that are not
+   sent by the watchdog) */
+#define SLICE_SIGNAL SIGURG
+
+typedef struct slice_run_ slice_run_t;
+struct slice_run_ {
+  ciao_ctx ctx;
+  pthread_t thread; /* running the worker of ctx */
+  struct timespec deadline;
+  slice_run_t *next;
+};
+
+/* Worker with a time slice running in this thread (if any) */
+static __thread worker_t *slice_worker = NULL;
+
+/* Handler of SLICE_SIGNAL before slice_signal_h() was installed */
+static struct sigaction slice_prev_sa;
+
+static void slice_signal_h(int signal_number, siginfo_t *info, void *uctx) {
+  worker_t *w = slice_worker;
+  if (w != NULL && Yield_Request(w)) {
+    /* (the worker may overwrite the event if the signal interrupts an
+       update of it, the watchdog sends it again later) */
+    SetEvent();
+  } else if (slice_prev_sa.sa_flags & SA_SIGINFO) {
+    (*slice_prev_sa.sa_sigaction)(signal_number, info, uctx);
+  } else if (slice_prev_sa.sa_handler != SIG_DFL &&
+             slice_prev_sa.sa_handler != SIG_IGN) {
+    (*slice_prev_sa.sa_handler)(signal_number);
+  }
+}
+
+static pthread_mutex_t slice_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t slice_cond = PTHREAD_COND_INITIALIZER;
+static slice_run_t *slice_runs = NULL;
+static bool_t slice_watchdog_started = FALSE;
+
+static void timespec_add_usecs(struct timespec *t, intmach_t usecs) {
+  t->tv_sec += usecs / 1000000;
+  t->tv_nsec += (usecs % 1000000) * 1000;
+  if (t->tv_nsec >= 1000000000) {
+    t->tv_sec++;
+    t->tv_nsec -= 1000000000;
+  }
+}
+
+static bool_t timespec_le(struct timespec *a, struct timespec *b) {
+  return a->tv_sec < b->tv_sec ||
+    (a->tv_sec == b->tv_sec && a->tv_nsec <= b->tv_nsec);
+}
+
+static void *slice_watchdog(void *arg) {
+  struct timespec now, wakeup;
+  slice_run_t *r;
+  pthread_mutex_lock(&slice_lock);
+  for (;;) {
+    if (slice_runs == NULL) {
+      pthread_cond_wait(&slice_cond, &slice_lock);
+      continue;
+    }
+    clock_gettime(CLOCK_REALTIME, &now);
+    wakeup = slice_runs->deadline;
+    for (r = slice_runs; r != NULL; r = r->next) {
+      if (timespec_le(&r->deadline, &now)) {
+        Yield_Request(r->ctx->worker_registers) = TRUE;
+        pthread_kill(r->thread, SLICE_SIGNAL);
+        r->deadline = now;
+        timespec_add_usecs(&r->deadline, SLICE_RETRY_USECS);
+      }
+      if (timespec_le(&r->deadline, &wakeup)) wakeup = r->deadline;
+    }
+    pthread_cond_timedwait(&slice_cond, &slice_lock, &wakeup);
+  }
+  return NULL;
+}
+
+static void slice_begin(slice_run_t *run, ciao_ctx ctx) {
+  pthread_t thread;
+  struct sigaction sa;
+  run->ctx = ctx;
+  run->thread = pthread_self();
+  clock_gettime(CLOCK_REALTIME, &run->deadline);
+  timespec_add_usecs(&run->deadline, ctx->time_slice);
+  Yield_Request(ctx->worker_registers) = FALSE;
+  slice_worker = ctx->worker_registers;
+  pthread_mutex_lock(&slice_lock);
+  if (!slice_watchdog_started) {
+    memset(&sa, 0, sizeof(sa));
+    sa.sa_sigaction = slice_signal_h;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART | SA_SIGINFO;
+    sigaction(SLICE_SIGNAL, &sa, &slice_prev_sa);
+    if (pthread_create(&thread, NULL, slice_watchdog, NULL) == 0) {
+      pthread_detach(thread);
+      slice_watchdog_started = TRUE;
+    }
+  }
+  run->next = slice_runs;
+  slice_runs = run;
+  pthread_cond_broadcast(&slice_cond);
+  pthread_mutex_unlock(&slice_lock);
+}
+
+static void slice_end(slice_run_t *run) {
+  slice_run_t **r;
+  pthread_mutex_lock(&slice_lock);
+  for (r = &slice_runs; *r != run; r = &(*r)->next) {}
+  *r = run->next;
+  pthread_mutex_unlock(&slice_lock);
+  slice_worker = NULL;
+  Yield_Request(run->ctx->worker_registers) = FALSE;
+}
+#endif
+
+#if !defined(OPTIM_COMP)
+/* Set the time slice (in microseconds, 0 for none) for the queries of ctx */
+void ciao_ctx_set_time_slice(ciao_ctx ctx, long usecs) {
+  ctx->time_slice = usecs > 0 ? usecs : 0;
+}
+#endif
+
+/* Run the abstract machine (within the time slice of ctx, if any) */
+static void ciao_wam(ciao_ctx ctx) {
+#if defined(USE_TIME_SLICES)
+  slice_run_t run;
+  bool_t timed = ctx->time_slice > 0;
+  if (timed) slice_begin(&run, ctx);
+#endif
   WITH_WORKER(ctx->worker_registers, {
     CVOID__CALL(wam, ctx);
   });
+#if defined(USE_TIME_SLICES)
+  if (timed) slice_end(&run);
+#endif
+}
+
+void ciao_fail(ciao_ctx ctx) {
+  ciao_wam(ctx);
 }
 
 /* ------------------------------------------------------------------------- */
@@ -1000,6 +1263,13 @@ void ciao_query_end(ciao_query *query) {
     ciao_cut(ctx, query->base_choice);
   }
   WITH_WORKER(ctx->worker_registers, {
+#if !defined(OPTIM_COMP)
+    if (IsSuspendedGoal(w)) { /* (discard the pending resumption) */
+      Stop_This_Goal(w) = FALSE;
+      SetSuspendedGoal(w, FALSE);
+      UnsetEvent();
+    }
+#endif
     b = w->choice;
     b = ChoiceCont(b);
     w->previous_choice = b; /* TODO:[oc-merge] not in OC */
@@ -1035,8 +1305,8 @@ ciao_query *ciao_query_begin_term_s(ciao_ctx ctx, ciao_term goal) {
     SetDeep();
 
     ctx->action = BACKTRACKING | KEEP_STACKS;
-    CVOID__CALL(wam, ctx);
   });
+  ciao_wam(ctx);
   return query;
 }
 
@@ -1059,6 +1329,10 @@ ciao_bool ciao_commit_call_term_s(ciao_ctx ctx, ciao_term goal) {
   ciao_query *query;
 
   query = ciao_query_begin_term_s(ctx, goal);
+#if !defined(OPTIM_COMP)
+  /* (ignore time slices) */
+  while (ciao_query_suspended(query)) ciao_query_resume(query);
+#endif
   ok = ciao_query_ok(query);
   ciao_query_end(query);
 
@@ -1092,21 +1366,26 @@ bool_t ciao_query_suspended(ciao_query *query) {
   return b;
 }
 
-/* Resume the execution of query suspended with internals:'$yield'/0 [EXPERIMENTAL] */
+/* Resume the execution of query suspended with internals:'$yield'/0
+   or at the end of a time slice [EXPERIMENTAL] */
 void ciao_query_resume(ciao_query *query) {
   goal_descriptor_t *ctx = query->ctx;
   WITH_WORKER(ctx->worker_registers, {
     Stop_This_Goal(w) = FALSE;
     SetSuspendedGoal(w, FALSE);
     UnsetEvent(); // TODO: SetEvent() usage
-    CVOID__CALL(wam, ctx); // (continue with '$yield' alternative, resume execution)
   });
+  ciao_wam(ctx); // (continue with '$yield' alternative, resume execution)
 }
 #endif
 
 /* ------------------------------------------------------------------------- */
 
+#if defined(USE_THREADS)
+__thread jmp_buf ciao_gluecode_jmpbuf;
+#else
 jmp_buf ciao_gluecode_jmpbuf;
+#endif
 
 void ciao_raise_exception_s(ciao_ctx ctx, ciao_term exception) {
   WITH_WORKER(ctx->worker_registers, {
@@ -19,6 +19,7 @@ extern "C" {
 
 /* TODO: do not include all (use ciao_gluecode.h if needed) */
 #include <ciao/eng.h>
+#include <ciao/eng_numarray.h>
 
 #define CIAO_ERROR 0
 #define ciao_true 1
@@ -30,7 +31,13 @@ typedef struct goal_descriptor *ciao_ctx;
 typedef goal_descriptor_t *ciao_ctx;
 #endif
 
+/* Context for the functions without an explicit context (each thread
+   has its own) */
+#if defined(USE_THREADS)
+extern __thread ciao_ctx ciao_implicit_ctx;
+#else
 extern ciao_ctx ciao_implicit_ctx;
+#endif
 
 typedef unsigned long ciao_choice;
 typedef unsigned long ciao_term;
@@ -63,7 +70,11 @@ void ciao_finish(ciao_ctx ctx);
 
 /* Creation of a ciao_ctx context */
 
+/* Each context has its own worker and must be used by a single thread
+   at a time; different threads may run queries concurrently on
+   different contexts (code and atoms are shared). */
 ciao_ctx ciao_ctx_new(void);
+/* (must not be running a query) */
 void ciao_ctx_free(ciao_ctx ctx);
 
 /* Engine boot */
@@ -160,6 +171,51 @@ ciao_term ciao_mk_c_uint8_list(ciao_ctx ctx, const unsigned char *s, size_t leng
 ciao_term ciao_mk_c_int_list(ciao_ctx ctx, int *s, size_t length);
 ciao_term ciao_mk_c_double_list(ciao_ctx ctx, double *s, size_t length);
 
+/* Packed numeric arrays (see library(numarray)). The data is stored
+   outside the heap, so the pointer returned by ciao_numarray_data_s()
+   can be used to read or fill the array in place (until it is freed).
+   Type is one of NUMARRAY_INT8, ..., NUMARRAY_FLOAT64 (see
+   eng_numarray.h).
+
+   Arrays are never reclaimed by the garbage collector, also when no
+   term refers to them: they must be freed with ciao_numarray_free_s()
+   or numarray_free/1. */
+
+/* New zero-filled array. If the type or the length are not valid,
+   *data is set to NULL and the result is not a numeric array. */
+ciao_term ciao_mk_numarray_s(ciao_ctx ctx, int type, size_t length, void **data);
+ciao_term ciao_mk_numarray(int type, size_t length, void **data);
+
+/* Type of the array, or -1 if term is not a (valid) numeric array */
+int ciao_numarray_type_s(ciao_ctx ctx, ciao_term term);
+int ciao_numarray_type(ciao_term term);
+
+/* Data and length of the array (NULL and 0 if term is not a (valid)
+   numeric array) */
+void *ciao_numarray_data_s(ciao_ctx ctx, ciao_term term, size_t *length);
+void *ciao_numarray_data(ciao_term term, size_t *length);
+size_t ciao_numarray_length(ciao_ctx ctx, ciao_term term);
+
+/* Free the array (and all its slices). Returns false if term is not a
+   (valid) numeric array. */
+ciao_bool ciao_numarray_free_s(ciao_ctx ctx, ciao_term term);
+ciao_bool ciao_numarray_free(ciao_term term);
+
+/* (for c_<type>_array types in the foreign interface) */
+#define Decl_ciao_numarray_X(CType, DeclType) \
+  ciao_bool ciao_is_##CType##_numarray(ciao_ctx ctx, ciao_term term); \
+  DeclType *ciao_get_##CType##_numarray(ciao_ctx ctx, ciao_term term); \
+  ciao_term ciao_mk_##CType##_numarray(ciao_ctx ctx, DeclType *s, size_t length);
+
+Decl_ciao_numarray_X(c_int8, int8_t)
+Decl_ciao_numarray_X(c_int16, int16_t)
+Decl_ciao_numarray_X(c_int32, int32_t)
+Decl_ciao_numarray_X(c_int64, int64_t)
+Decl_ciao_numarray_X(c_float, float)
+Decl_ciao_numarray_X(c_double, double)
+
+#undef Decl_ciao_numarray_X
+
 /* Helper functions for term creation */
 
 ciao_term ciao_list_s(ciao_ctx ctx, ciao_term head, ciao_term tail);
@@ -271,10 +327,18 @@ ciao_bool ciao_commit_call(const char *name, int arity, ...);
 ciao_bool ciao_commit_call_term_s(ciao_ctx ctx, ciao_term goal);
 ciao_bool ciao_commit_call_term(ciao_term goal);
 
-/* (experimental for '$yield'/0) */
+/* (experimental for '$yield'/0 and time slices) */
 bool_t ciao_query_suspended(ciao_query *query);
 void ciao_query_resume(ciao_query *query);
 
+#if !defined(OPTIM_COMP)
+/* Suspend the queries of ctx (see ciao_query_suspended()) after
+   running for about usecs microseconds (0 for no limit) in each call
+   to ciao_query_begin*(), ciao_query_next(), or ciao_query_resume().
+   Calls to ciao_commit_call*() are not suspended. [EXPERIMENTAL] */
+void ciao_ctx_set_time_slice(ciao_ctx ctx, long usecs);
+#endif
+
 /* Helper functions */
 
 ciao_term ciao_copy_term_s(ciao_ctx src_desc, ciao_term src_term, ciao_ctx dst_desc);
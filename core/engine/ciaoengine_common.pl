@@ -102,6 +102,30 @@
 
 :- '$native_include_c_source'('eng_bignum.c').
 
+:- '$native_include_c_header'('eng_bytes.h').
+:- '$native_include_c_source'('eng_bytes.c').
+
+:- '$native_include_c_header'('eng_digest.h').
+:- '$native_include_c_source'('eng_digest.c').
+
+:- '$native_include_c_header'('eng_numarray.h').
+:- '$native_include_c_source'('eng_numarray.c').
+
+:- '$native_include_c_header'('eng_fiber.h').
+:- '$native_include_c_source'('eng_fiber.c').
+
+:- '$native_include_c_header'('eng_jit.h').
+:- '$native_include_c_source'('eng_jit.c').
+
+:- '$native_include_c_header'('io_tokenize.h').
+:- '$native_include_c_source'('io_tokenize.c').
+
+:- '$native_include_c_header'('io_write.h').
+:- '$native_include_c_source'('io_write.c').
+
+:- '$native_include_c_header'('io_format.h').
+:- '$native_include_c_source'('io_format.c').
+
 :- '$native_include_c_header'('dtoa_ryu.h').
 :- '$native_include_c_source'('dtoa_ryu.c').
 
@@ -281,6 +281,12 @@
 
 #define Stop_This_Goal(w) (w->misc->stop_this_goal)
 
+/* Suspend the goal (as in internals:'$yield'/0) at the next event */
+#define Yield_Request(w) (w->misc->yield_request)
+
+/* Call internals:jit_handler/0 at the next event (see eng_jit.h) */
+#define Jit_Request(w) (w->misc->jit_request)
+
 // TODO: better place to store this bit?
 #define IsSuspendedGoal(w) ((bool_t)((intptr_t)(w->dummy0)))
 #define SetSuspendedGoal(w,S) (w->dummy0 = (void *)(S))
@@ -652,6 +658,8 @@ typedef struct choice_ choice_t;
 typedef struct stream_node_ stream_node_t;
 typedef struct goal_descriptor_ goal_descriptor_t;
 typedef struct try_node_ try_node_t; /* defined in dynamic_rt.h */
+typedef struct incore_index_ incore_index_t;
+typedef struct incore_ixkeys_ incore_ixkeys_t;
 typedef struct definition_ definition_t; /* defined in dynamic_rt.h */
 typedef struct module_ module_t; /* defined in dynamic_rt.h */
 
@@ -880,6 +888,8 @@ struct debugger_state_ {
 #define GLOBAL_VARS_ROOT (w->misc->global_vars_root)
 #endif
 
+typedef struct clause_counters_ clause_counters_t; /* defined in eng_profile.c */
+
 typedef struct misc_info_ misc_info_t;
 struct misc_info_ {
 
@@ -930,6 +940,14 @@ struct misc_info_ {
   intmach_t exit_code;
   /* This goal should stop right now! */
   bool_t stop_this_goal;
+  /* This goal should yield at the next predicate call (set from the
+     time slice watchdog thread, see ciao_prolog.c) */
+  volatile bool_t yield_request;
+  /* Hot predicates are waiting for native code (see eng_jit.h) */
+  bool_t jit_request;
+
+  /* Per-worker clause counters (see eng_profile.c), NULL until used */
+  clause_counters_t *clause_counters;
 
 #if defined(TABLING)
   //tagged_t *tabled_top = NULL;
@@ -1082,6 +1100,8 @@ struct goal_descriptor_ {
   /* TODO: change type for global_goal_number? */
   intmach_t goal_number;        /* Snapshot of global counter */
   SLOCK goal_lock_l;
+  /* Time slice (microseconds) for C API queries, 0 if none (see ciao_prolog.c) */
+  intmach_t time_slice;
   goal_descriptor_t *forward, *backward;
 };
 
@@ -1432,6 +1452,7 @@ typedef short enter_instr_t;
 #define TABLE 25
 #define EMUL_INFO 26
 #define OTHER_STUFF 27
+#define INCORE_INDEX 28
 
 // uncomment to enable atom GC (incomplete)
 // #define ATOMGC 1
@@ -1461,6 +1482,7 @@ struct emul_info_ {
 #if defined(GAUGE)
   intmach_t *counters;      /* Pointer to clause's first counter. */
 #endif
+  incore_ixkeys_t *ixkeys;     /* keys for secondary indexing or NULL */
   char emulcode[FLEXIBLE_SIZE];
 };
 
@@ -1627,6 +1649,7 @@ struct try_node_ {
   intmach_t *entry_counter;        /* Offset of counter for clause entry */
 #endif
   try_node_t *previous;
+  incore_index_t *index;     /* secondary index (only in the first node) */
 };
 
 #define HASHTAB_SIZE(X) (((X)->mask / sizeof(hashtab_node_t))+1) 
@@ -1681,6 +1704,9 @@ struct hashtab_ {
 #define SW_ON_KEY_NODE_FROM_OFFSET(Tab, Offset) \
   ((hashtab_node_t *)((char *)&(Tab)->node[0] + (Offset)))
 
+typedef struct jit_native_ jit_native_t; /* (see eng_jit.h) */
+typedef struct jit_unit_ jit_unit_t;
+
 typedef struct incore_info_ incore_info_t;
 struct incore_info_ {
   emul_info_t *clauses; /* first clause */
@@ -1689,8 +1715,48 @@ struct incore_info_ {
   try_node_t *varcase;
   try_node_t *lstcase;
   hashtab_t *othercase;
+  intmach_t jit_countdown; /* calls until hot (0 if not a candidate) */
+  jit_native_t *jit; /* native code (if ENTER_FASTCODE*) */
 };
 
+/* Secondary indexing. Clauses carry the keys of their head arguments
+   other than the first one and of the arguments of the first-level
+   subterms (pos = Arg + 256*SubArg, SubArg=0 for the argument
+   itself). On its first call, a try chain of two or more clauses
+   ranks the positions that discriminate its clauses. A call switches
+   on the best of them that is bound (building its table the first
+   time), and the selected chain is indexed again the same way (see
+   incore_index_select()). */
+
+#define IXPOS_ARG(Pos) ((Pos) & 0xff)
+#define IXPOS_SUB(Pos) ((Pos) >> 8)
+#define INCORE_INDEX_MAX 4      /* max. number of ranked positions */
+
+typedef struct incore_ixkey_ incore_ixkey_t;
+struct incore_ixkey_ {
+  intmach_t pos;
+  tagged_t key;
+};
+
+struct incore_ixkeys_ {
+  intmach_t count;
+  incore_ixkey_t key[FLEXIBLE_SIZE];
+};
+
+typedef struct incore_ixsw_ incore_ixsw_t;
+struct incore_ixsw_ {
+  intmach_t pos;                              /* position of the key */
+  hashtab_t *keys;   /* try chains by key (default: no key) or NULL */
+};
+
+struct incore_index_ {
+  intmach_t count;
+  incore_ixsw_t sw[FLEXIBLE_SIZE];                      /* best first */
+};
+
+/* To be built on the next call through the chain */
+#define INCORE_INDEX_PENDING ((incore_index_t *)1)
+
 #define SetEnterInstr(F,I) \
 { \
   (F)->predtyp = (I); \
@@ -1747,7 +1813,8 @@ struct module_ {
 /* Classified somewhere else */
 extern hashtab_node_t **atmtab;
 extern hashtab_t *ciao_atoms;
-extern void *builtintab[];
+#define BUILTINTAB_SIZE 64
+extern void *builtintab[BUILTINTAB_SIZE];
 
 typedef struct statistics_ statistics_t;
 struct statistics_ {
@@ -1975,6 +2042,7 @@ extern tagged_t functor_Dsetarg;
 extern tagged_t functor_Dsetargstr;
 extern tagged_t functor_large;
 extern tagged_t functor_long;
+extern tagged_t functor_rat;
 
 extern tagged_t functor_active;
 extern tagged_t functor_pending;
@@ -2022,6 +2090,8 @@ extern definition_t *address_interpret_compiled_goal;
 extern definition_t *address_interpret_c_goal;
 extern definition_t *address_undefined_goal;
 extern definition_t *address_help; 
+extern definition_t *address_yield;
+extern definition_t *address_jit;
 extern definition_t *address_restart; 
 extern definition_t *address_trace;
 extern definition_t *address_getct;
@@ -2184,6 +2254,8 @@ CVOID__PROTO(pop_frame);
 /* Exit code from wam() when aborting */
 #define WAM_ABORT -32768 /* see exceptions.pl */
 #define WAM_INTERRUPTED -32767
+/* (no halt/1 yet, in goals run by eng_call/4) */
+#define WAM_NOT_HALTED -32766
 
 #include <setjmp.h>
 #include <ciao/os_signal.h>
@@ -14,6 +14,10 @@
 #include <ciao/eng_bignum.h>
 #endif
 #include <math.h>
+#include <string.h>
+#if defined(USE_GMP)
+#include <gmp.h>
+#endif
 
 #if defined(OPTIM_COMP)
 #define LOG2_bignum_size 5
@@ -660,6 +664,1108 @@ bignum_size_t bn_compare(bignum_t *x, bignum_t *y) {
   }
 }
 
+/* --------------------------------------------------------------------------- */
+/* Subquadratic algorithms
+ *
+ * Routines for multiplication, division and radix conversion of
+ * large numbers: Karatsuba and Toom-3 multiplication, divide and
+ * conquer division (Burnikel-Ziegler, in the formulation by Moller and
+ * Granlund used in GMP) and divide and conquer radix conversion. They
+ * work on magnitudes stored as plain arrays of bignum_half_t digits
+ * (least significant first, without header), using bignum_t for
+ * double digit intermediate results, like the classical algorithms
+ * below. Scratch memory is provided by the callers, with sizes (in
+ * digits) given by the *_ITCH macros and bh_*_itch() functions.
+ *
+ * The bn_*_fast() functions connect them with the bignum_t
+ * representation. When the engine is compiled with USE_GMP, the GMP
+ * mpn_* functions are used instead (see below).
+ *
+ * Thresholds are in digits and were tuned with
+ * core/examples/misc/bignum_bench.pl.
+ */
+
+#define BN_KARATSUBA_THRESHOLD 48 /* (must be >= 8) */
+#define BN_TOOM3_THRESHOLD 192 /* (must be >= 25) */
+#define BN_DC_DIV_THRESHOLD 96
+#define BN_DC_RADIX_THRESHOLD 192
+
+static inline void bh_zero(bignum_half_t *r, bnlen_t n) {
+  for (bnlen_t i = 0; i < n; i++) r[i] = 0;
+}
+
+static inline void bh_copy(bignum_half_t *r, bignum_half_t *a, bnlen_t n) {
+  for (bnlen_t i = 0; i < n; i++) r[i] = a[i];
+}
+
+/* Length of a without leading zero digits */
+static inline bnlen_t bh_normlen(bignum_half_t *a, bnlen_t n) {
+  while (n > 0 && a[n-1] == 0) n--;
+  return n;
+}
+
+static int bh_cmp(bignum_half_t *a, bignum_half_t *b, bnlen_t n) {
+  while (n > 0) {
+    n--;
+    if (a[n] != b[n]) return (a[n] < b[n] ? -1 : 1);
+  }
+  return 0;
+}
+
+/* r = a+b (n digits), return the carry */
+static bignum_half_t bh_add_n(bignum_half_t *r, bignum_half_t *a, bignum_half_t *b, bnlen_t n) {
+  bignum_t t = 0;
+  for (bnlen_t i = 0; i < n; i++) {
+    t += (bignum_t)a[i] + b[i];
+    r[i] = t & HalfMask;
+    t >>= HalfUnit;
+  }
+  return t;
+}
+
+/* r = a-b (n digits), return the borrow */
+static bignum_half_t bh_sub_n(bignum_half_t *r, bignum_half_t *a, bignum_half_t *b, bnlen_t n) {
+  bignum_t t = 0;
+  for (bnlen_t i = 0; i < n; i++) {
+    t = (bignum_t)a[i] - b[i] - t;
+    r[i] = t & HalfMask;
+    t = (t >> HalfUnit) & 1;
+  }
+  return t;
+}
+
+/* r = a+c (n digits, c is a digit), return the carry */
+static bignum_half_t bh_add_1(bignum_half_t *r, bignum_half_t *a, bnlen_t n, bignum_t c) {
+  for (bnlen_t i = 0; i < n; i++) {
+    if (c == 0 && r == a) return 0;
+    c += a[i];
+    r[i] = c & HalfMask;
+    c >>= HalfUnit;
+  }
+  return c;
+}
+
+/* r = a-c (n digits, c is a digit), return the borrow */
+static bignum_half_t bh_sub_1(bignum_half_t *r, bignum_half_t *a, bnlen_t n, bignum_t c) {
+  for (bnlen_t i = 0; i < n; i++) {
+    if (c == 0 && r == a) return 0;
+    c = (bignum_t)a[i] - c;
+    r[i] = c & HalfMask;
+    c = (c >> HalfUnit) & 1;
+  }
+  return c;
+}
+
+/* r = a+b (an >= bn digits), return the carry */
+static bignum_half_t bh_add(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_half_t *b, bnlen_t bn) {
+  return bh_add_1(r+bn, a+bn, an-bn, bh_add_n(r, a, b, bn));
+}
+
+/* r = a-b (an >= bn digits), return the borrow */
+static bignum_half_t bh_sub(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_half_t *b, bnlen_t bn) {
+  return bh_sub_1(r+bn, a+bn, an-bn, bh_sub_n(r, a, b, bn));
+}
+
+/* r = a<<d (n digits, 0 <= d < HalfUnit), return the shifted out bits */
+static bignum_half_t bh_lshift(bignum_half_t *r, bignum_half_t *a, bnlen_t n, int d) {
+  bignum_t t = 0;
+  for (bnlen_t i = 0; i < n; i++) {
+    t += (bignum_t)a[i] << d;
+    r[i] = t & HalfMask;
+    t >>= HalfUnit;
+  }
+  return t;
+}
+
+/* r = a>>d (n digits, 0 <= d < HalfUnit) */
+static void bh_rshift(bignum_half_t *r, bignum_half_t *a, bnlen_t n, int d) {
+  bignum_t t = 0;
+  bignum_t mask = ((bignum_t)1<<d)-1;
+  for (bnlen_t i = n-1; i >= 0; i--) {
+    t = (t << HalfUnit) + a[i];
+    r[i] = t >> d;
+    t &= mask;
+  }
+}
+
+/* r += a*d (n digits), return the carry */
+static bignum_half_t bh_addmul_1(bignum_half_t *r, bignum_half_t *a, bnlen_t n, bignum_half_t d) {
+  bignum_t t = 0;
+  for (bnlen_t i = 0; i < n; i++) {
+    t += (bignum_t)a[i]*d + r[i];
+    r[i] = t & HalfMask;
+    t >>= HalfUnit;
+  }
+  return t;
+}
+
+/* r -= a*d (n digits), return the borrow */
+static bignum_half_t bh_submul_1(bignum_half_t *r, bignum_half_t *a, bnlen_t n, bignum_half_t d) {
+  bignum_t t = 0;
+  for (bnlen_t i = 0; i < n; i++) {
+    bignum_half_t lo;
+    t += (bignum_t)a[i]*d;
+    lo = t & HalfMask;
+    t >>= HalfUnit;
+    if (r[i] < lo) t++;
+    r[i] = (r[i] - lo) & HalfMask;
+  }
+  return t;
+}
+
+/* r = a/d (n digits, d > 0), return a%d */
+static bignum_half_t bh_divrem_1(bignum_half_t *r, bignum_half_t *a, bnlen_t n, bignum_half_t d) {
+  bignum_t t = 0;
+  for (bnlen_t i = n-1; i >= 0; i--) {
+    t = (t << HalfUnit) + a[i];
+    r[i] = t / d;
+    t %= d;
+  }
+  return t;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Multiplication */
+
+/* r = a*b (an+bn digits, no overlap) */
+static void bh_mul_basecase(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_half_t *b, bnlen_t bn) {
+  bh_zero(r, an);
+  for (bnlen_t j = 0; j < bn; j++) {
+    r[an+j] = b[j] ? bh_addmul_1(r+j, a, an, b[j]) : 0;
+  }
+}
+
+/* Scratch for bh_mul_n(). By induction on n, 8n is enough for the
+   recursive calls of Karatsuba (4l+2 digits, l = ceil(n/2), and n >=
+   BN_KARATSUBA_THRESHOLD >= 4) and Toom-3 (12(k+1) digits, k =
+   ceil(n/3), and n >= BN_TOOM3_THRESHOLD >= 25). */
+#define BH_MUL_N_ITCH(N) (8*(N))
+
+static void bh_mul_n(bignum_half_t *r, bignum_half_t *a, bignum_half_t *b, bnlen_t n, bignum_half_t *s);
+
+/* r = |a-b| (an >= bn digits, r has an digits), return whether a < b */
+static bool_t bh_diff(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_half_t *b, bnlen_t bn) {
+  if (bh_normlen(a+bn, an-bn) == 0 && bh_cmp(a, b, bn) < 0) {
+    bh_sub_n(r, b, a, bn);
+    bh_zero(r+bn, an-bn);
+    return TRUE;
+  } else {
+    bh_sub(r, a, an, b, bn);
+    return FALSE;
+  }
+}
+
+/* Karatsuba multiplication, where (for a = a1*B^l+a0, b = b1*B^l+b0)
+   a*b = a1*b1*B^2l + (a0*b0+a1*b1-(a0-a1)*(b0-b1))*B^l + a0*b0 */
+static void bh_mul_n_karatsuba(bignum_half_t *r, bignum_half_t *a, bignum_half_t *b, bnlen_t n, bignum_half_t *s) {
+  bnlen_t l = (n+1)>>1;
+  bnlen_t h = n-l;
+  bignum_half_t *m = s+2*l+1; /* (a0-a1)*(b0-b1), 2l digits */
+  bignum_half_t *s1 = s+4*l+2;
+  bool_t neg;
+
+  neg = bh_diff(s, a, l, a+l, h);
+  neg ^= bh_diff(s+l, b, l, b+l, h);
+  bh_mul_n(m, s, s+l, l, s1);
+  bh_mul_n(r, a, b, l, s1);
+  bh_mul_n(r+2*l, a+l, b+l, h, s1);
+  /* middle term, 2l+1 digits */
+  s[2*l] = bh_add(s, r, 2*l, r+2*l, 2*h);
+  if (neg) {
+    s[2*l] += bh_add_n(s, s, m, 2*l);
+  } else {
+    s[2*l] -= bh_sub_n(s, s, m, 2*l);
+  }
+  bh_add_1(r+3*l+1, r+3*l+1, 2*n-3*l-1, bh_add_n(r+l, r+l, s, 2*l+1));
+}
+
+/* p1 = a0+a1+a2, pm1 = |a0-a1+a2|, p2 = a0+2*a1+4*a2 (k+1 digits
+   each, a = a2*B^2k+a1*B^k+a0, a2 has k2 digits), return whether
+   a0-a1+a2 < 0 */
+static bool_t bh_toom3_eval(bignum_half_t *p1, bignum_half_t *pm1, bignum_half_t *p2, bignum_half_t *a, bnlen_t k, bnlen_t k2) {
+  bignum_half_t *a1 = a+k;
+  bignum_half_t *a2 = a+2*k;
+  bool_t neg;
+
+  /* pm1 = a0+a2 (temporarily) */
+  pm1[k] = bh_add(pm1, a, k, a2, k2);
+  p1[k] = pm1[k] + bh_add_n(p1, pm1, a1, k);
+  if (pm1[k] == 0 && bh_cmp(pm1, a1, k) < 0) {
+    bh_sub_n(pm1, a1, pm1, k);
+    neg = TRUE;
+  } else {
+    pm1[k] -= bh_sub_n(pm1, pm1, a1, k);
+    neg = FALSE;
+  }
+  /* p2 = 2*(2*a2+a1)+a0 */
+  bh_copy(p2, a2, k2);
+  bh_zero(p2+k2, k+1-k2);
+  bh_lshift(p2, p2, k+1, 1);
+  bh_add(p2, p2, k+1, a1, k);
+  bh_lshift(p2, p2, k+1, 1);
+  bh_add(p2, p2, k+1, a, k);
+  return neg;
+}
+
+/* r += a<<off (r has rn digits, a has an digits, and the result fits) */
+static void bh_add_at(bignum_half_t *r, bnlen_t rn, bnlen_t off, bignum_half_t *a, bnlen_t an) {
+  if (an > rn-off) an = rn-off; /* (the remaining digits are zero) */
+  bh_add_1(r+off+an, r+off+an, rn-off-an, bh_add_n(r+off, r+off, a, an));
+}
+
+/* Toom-3 multiplication, evaluating at 0, 1, -1, 2 and infinity (the
+   interpolation sequence keeps all intermediate values nonnegative,
+   except v(-1)) */
+static void bh_mul_n_toom3(bignum_half_t *r, bignum_half_t *a, bignum_half_t *b, bnlen_t n, bignum_half_t *s) {
+  bnlen_t k = (n+2)/3;
+  bnlen_t k2 = n-2*k; /* digits of a2 and b2 */
+  bnlen_t k1 = k+1;
+  bnlen_t vn = 2*k1;
+  bignum_half_t *p1 = s, *q1 = s+k1;
+  bignum_half_t *pm1 = s+2*k1, *qm1 = s+3*k1;
+  bignum_half_t *p2 = s+4*k1, *q2 = s+5*k1;
+  bignum_half_t *v1 = s+6*k1, *vm1 = s+8*k1, *v2 = s+10*k1;
+  bignum_half_t *s1 = s+12*k1;
+  bignum_half_t *v0 = r, *vinf = r+4*k;
+  bool_t neg;
+
+  neg = bh_toom3_eval(p1, pm1, p2, a, k, k2);
+  neg ^= bh_toom3_eval(q1, qm1, q2, b, k, k2);
+  bh_mul_n(v1, p1, q1, k1, s1);
+  bh_mul_n(vm1, pm1, qm1, k1, s1);
+  bh_mul_n(v2, p2, q2, k1, s1);
+  bh_mul_n(v0, a, b, k, s1);
+  bh_mul_n(vinf, a+2*k, b+2*k, k2, s1);
+
+  /* Interpolate c1..c3 (for a*b = c4*x^4+c3*x^3+c2*x^2+c1*x+c0 at x = B^k) */
+  /* v2 = (v2-vm1)/3 = c1+c2+3*c3+5*c4 */
+  if (neg) bh_add_n(v2, v2, vm1, vn); else bh_sub_n(v2, v2, vm1, vn);
+  bh_divrem_1(v2, v2, vn, 3);
+  /* vm1 = (v1-vm1)/2 = c1+c3 */
+  if (neg) bh_add_n(vm1, v1, vm1, vn); else bh_sub_n(vm1, v1, vm1, vn);
+  bh_rshift(vm1, vm1, vn, 1);
+  /* v1 = v1-v0 = c1+c2+c3+c4 */
+  bh_sub(v1, v1, vn, v0, 2*k);
+  /* v2 = (v2-v1)/2 = c3+2*c4 */
+  bh_sub_n(v2, v2, v1, vn);
+  bh_rshift(v2, v2, vn, 1);
+  /* v1 = v1-vm1-vinf = c2 */
+  bh_sub_n(v1, v1, vm1, vn);
+  bh_sub(v1, v1, vn, vinf, 2*k2);
+  /* v2 = v2-2*vinf = c3 */
+  bh_sub(v2, v2, vn, vinf, 2*k2);
+  bh_sub(v2, v2, vn, vinf, 2*k2);
+  /* vm1 = vm1-v2 = c1 */
+  bh_sub_n(vm1, vm1, v2, vn);
+
+  /* Recompose (c0 and c4 are already in place) */
+  bh_zero(r+2*k, 2*k);
+  bh_add_at(r, 2*n, k, vm1, vn);
+  bh_add_at(r, 2*n, 2*k, v1, vn);
+  bh_add_at(r, 2*n, 3*k, v2, vn);
+}
+
+/* r = a*b (n digits each, r has 2n digits, no overlap) */
+static void bh_mul_n(bignum_half_t *r, bignum_half_t *a, bignum_half_t *b, bnlen_t n, bignum_half_t *s) {
+  if (n < BN_KARATSUBA_THRESHOLD) {
+    bh_mul_basecase(r, a, n, b, n);
+  } else if (n < BN_TOOM3_THRESHOLD) {
+    bh_mul_n_karatsuba(r, a, b, n, s);
+  } else {
+    bh_mul_n_toom3(r, a, b, n, s);
+  }
+}
+
+/* r = a*b (an >= bn >= 1 digits, r has an+bn digits, no overlap).
+   Unbalanced products are computed by slices of bn digits of a. */
+static void bh_mul(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_half_t *b, bnlen_t bn, bignum_half_t *s) {
+  if (an == bn) {
+    bh_mul_n(r, a, b, an, s);
+  } else if (bn < BN_KARATSUBA_THRESHOLD) {
+    bh_mul_basecase(r, a, an, b, bn);
+  } else {
+    bh_mul_n(r, a, b, bn, s);
+    for (bnlen_t k = bn; k < an; k += bn) {
+      bnlen_t c = (an-k < bn ? an-k : bn);
+      if (c == bn) {
+        bh_mul_n(s, a+k, b, bn, s+2*bn);
+      } else {
+        bh_mul(s, b, bn, a+k, c, s+2*bn);
+      }
+      bh_add_1(r+k+bn, s+bn, c, bh_add_n(r+k, r+k, s, bn));
+    }
+  }
+}
+
+/* Scratch for bh_mul() */
+static bnlen_t bh_mul_itch(bnlen_t an, bnlen_t bn) {
+  bnlen_t itch, itch1;
+  if (an == bn) return BH_MUL_N_ITCH(an);
+  if (bn < BN_KARATSUBA_THRESHOLD) return 0;
+  itch = BH_MUL_N_ITCH(bn);
+  if (an % bn != 0) {
+    itch1 = bh_mul_itch(bn, an % bn);
+    if (itch1 > itch) itch = itch1;
+  }
+  return 2*bn+itch;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Division */
+
+/* Schoolbook division (Knuth's algorithm D) of np (nn digits) by dp
+   (dn digits, normalized). The quotient is stored in q (nn-dn digits)
+   and the remainder in np (dn digits). Return the most significant
+   digit of the quotient (0 or 1). */
+static bignum_half_t bh_div_qr_basecase(bignum_half_t *q, bignum_half_t *np, bnlen_t nn, bignum_half_t *dp, bnlen_t dn) {
+  bignum_half_t qh, d1, d0, qj;
+  bignum_t num, d1q, d0q, t;
+  bnlen_t j;
+
+  qh = (bh_cmp(np+nn-dn, dp, dn) >= 0);
+  if (qh) bh_sub_n(np+nn-dn, np+nn-dn, dp, dn);
+  if (dn == 1) {
+    d1 = dp[0];
+    for (t = np[nn-1], j = nn-2; j >= 0; j--) {
+      t = (t << HalfUnit) + np[j];
+      q[j] = t / d1;
+      t %= d1;
+    }
+    np[0] = t;
+    return qh;
+  }
+
+  d1 = dp[dn-1];
+  d0 = dp[dn-2];
+  for (j = nn-dn-1; j >= 0; j--) {
+    /* Estimate the quotient digit (at most one too large) */
+    num = ((bignum_t)np[j+dn] << HalfUnit) + np[j+dn-1];
+    qj = (np[j+dn] == d1) ? HalfMask : num/d1;
+    d1q = (bignum_t)d1*qj;
+    d0q = (bignum_t)d0*qj;
+    while (num-d1q < ((bignum_t)1<<HalfUnit) &&
+           d0q > ((num-d1q)<<HalfUnit)+np[j+dn-2]) {
+      qj--;
+      d1q -= d1;
+      d0q -= d0;
+    }
+    /* Multiply and subtract */
+    t = bh_submul_1(np+j, dp, dn, qj);
+    if (np[j+dn] < t) {
+      qj--;
+      t -= bh_add_n(np+j, np+j, dp, dn);
+    }
+    np[j+dn] = (np[j+dn] - t) & HalfMask;
+    q[j] = qj;
+  }
+  return qh;
+}
+
+/* Scratch for bh_div_qr_n(): n digits for products plus their
+   scratch (for sizes hi and lo <= hi <= lo+1, at most 10*lo) */
+#define BH_DIV_QR_N_ITCH(N) (6*(N))
+
+/* Divide and conquer division of np (2n digits) by dp (n digits,
+   normalized), with the same outputs as bh_div_qr_basecase() */
+static bignum_half_t bh_div_qr_n(bignum_half_t *q, bignum_half_t *np, bignum_half_t *dp, bnlen_t n, bignum_half_t *s) {
+  bnlen_t lo = n>>1;
+  bnlen_t hi = n-lo;
+  bignum_half_t qh, ql, cy;
+
+  /* High half of the quotient, from the high 2hi digits of np and the
+     high hi digits of dp, and correction with the rest of dp */
+  if (hi < BN_DC_DIV_THRESHOLD) {
+    qh = bh_div_qr_basecase(q+lo, np+2*lo, 2*hi, dp+lo, hi);
+  } else {
+    qh = bh_div_qr_n(q+lo, np+2*lo, dp+lo, hi, s);
+  }
+  bh_mul(s, q+lo, hi, dp, lo, s+n);
+  cy = bh_sub_n(np+lo, np+lo, s, n);
+  if (qh) cy += bh_sub_n(np+n, np+n, dp, lo);
+  while (cy) {
+    qh -= bh_sub_1(q+lo, q+lo, hi, 1);
+    cy -= bh_add_n(np+lo, np+lo, dp, n);
+  }
+
+  /* Low half of the quotient */
+  if (lo < BN_DC_DIV_THRESHOLD) {
+    ql = bh_div_qr_basecase(q, np+hi, 2*lo, dp+hi, lo);
+  } else {
+    ql = bh_div_qr_n(q, np+hi, dp+hi, lo, s);
+  }
+  bh_mul(s, dp, hi, q, lo, s+n);
+  cy = bh_sub_n(np, np, s, n);
+  if (ql) cy += bh_sub_n(np+lo, np+lo, dp, hi);
+  while (cy) {
+    bh_sub_1(q, q, lo, 1);
+    cy -= bh_add_n(np, np, dp, n);
+  }
+
+  return qh;
+}
+
+/* Divide np (dn+b digits, b <= dn) by dp (dn digits, normalized), for
+   b digits of the quotient */
+static bignum_half_t bh_div_qr_block(bignum_half_t *q, bignum_half_t *np, bnlen_t b, bignum_half_t *dp, bnlen_t dn, bignum_half_t *s) {
+  bignum_half_t qh, cy;
+
+  if (b == dn) return bh_div_qr_n(q, np, dp, dn, s);
+
+  if (b < BN_DC_DIV_THRESHOLD) {
+    qh = bh_div_qr_basecase(q, np+dn-b, 2*b, dp+dn-b, b);
+  } else {
+    qh = bh_div_qr_n(q, np+dn-b, dp+dn-b, b, s);
+  }
+  if (b > dn-b) {
+    bh_mul(s, q, b, dp, dn-b, s+dn);
+  } else {
+    bh_mul(s, dp, dn-b, q, b, s+dn);
+  }
+  cy = bh_sub_n(np, np, s, dn);
+  if (qh) cy += bh_sub_n(np+b, np+b, dp, dn-b);
+  while (cy) {
+    qh -= bh_sub_1(q, q, b, 1);
+    cy -= bh_add_n(np, np, dp, dn);
+  }
+  return qh;
+}
+
+/* Division of np (nn digits) by dp (dn digits, normalized), with the
+   same outputs as bh_div_qr_basecase(). The quotient is computed by
+   blocks of dn digits, from the most significant one. */
+static bignum_half_t bh_div_qr(bignum_half_t *q, bignum_half_t *np, bnlen_t nn, bignum_half_t *dp, bnlen_t dn, bignum_half_t *s) {
+  bnlen_t qn = nn-dn;
+  bnlen_t b, k;
+  bignum_half_t qh;
+
+  if (dn < BN_DC_DIV_THRESHOLD || qn < BN_DC_DIV_THRESHOLD) {
+    return bh_div_qr_basecase(q, np, nn, dp, dn);
+  }
+  b = qn % dn;
+  if (b == 0) b = dn;
+  k = qn-b;
+  qh = bh_div_qr_block(q+k, np+k, b, dp, dn, s);
+  while (k > 0) {
+    k -= dn;
+    bh_div_qr_n(q+k, np+k, dp, dn, s);
+  }
+  return qh;
+}
+
+/* Scratch for bh_div_qr() */
+static bnlen_t bh_div_qr_itch(bnlen_t nn, bnlen_t dn) {
+  bnlen_t qn = nn-dn;
+  bnlen_t b, itch, itch1;
+  if (dn < BN_DC_DIV_THRESHOLD || qn < BN_DC_DIV_THRESHOLD) return 0;
+  itch = BH_DIV_QR_N_ITCH(dn);
+  b = qn % dn;
+  if (b != 0) {
+    itch1 = dn + (b > dn-b ? bh_mul_itch(b, dn-b) : bh_mul_itch(dn-b, b));
+    if (itch1 > itch) itch = itch1;
+  }
+  return itch;
+}
+
+/* q = a/b and r = a%b (an >= bn digits, b[bn-1] != 0, q has an-bn+1
+   digits and r has bn digits) */
+static void bh_tdiv_qr(bignum_half_t *q, bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_half_t *b, bnlen_t bn, bignum_half_t *s) {
+  bignum_half_t *u = s; /* normalized a, an+1 digits */
+  bignum_half_t *v = s+an+1; /* normalized b, bn digits */
+  bignum_half_t t;
+  int d;
+
+  if (bn == 1) {
+    r[0] = bh_divrem_1(q, a, an, b[0]);
+    return;
+  }
+  for (d = 0, t = b[bn-1]; !(t & ((bignum_t)1<<(HalfUnit-1))); d++) t <<= 1;
+  u[an] = bh_lshift(u, a, an, d);
+  bh_lshift(v, b, bn, d);
+  /* (the most significant digit of the quotient is 0 after normalization) */
+  bh_div_qr(q, u, an+1, v, bn, v+bn);
+  bh_rshift(r, u, bn, d);
+}
+
+/* Scratch for bh_tdiv_qr() */
+static bnlen_t bh_tdiv_qr_itch(bnlen_t an, bnlen_t bn) {
+  if (bn == 1) return 0;
+  return an+1+bn+bh_div_qr_itch(an+1, bn);
+}
+
+#if !defined(USE_GMP)
+
+/* --------------------------------------------------------------------------- */
+/* Radix conversion */
+
+#define BH_RADIX_MAX_POWERS 48
+
+typedef struct bh_radix bh_radix_t;
+struct bh_radix {
+  int base;
+  char hibase; /* (for digits >= 10) */
+  int dlen; /* digits per chunk */
+  bignum_half_t divisor; /* base^dlen */
+  int npw;
+  bignum_half_t *pw[BH_RADIX_MAX_POWERS]; /* divisor^(2^i) */
+  bnlen_t pwlen[BH_RADIX_MAX_POWERS];
+  bnlen_t pwsize[BH_RADIX_MAX_POWERS];
+};
+
+static void bh_radix_init(bh_radix_t *rx, int base, char hibase) {
+  bignum_t divisor, r;
+  int dlen;
+
+  /* largest power of base that fits in a digit */
+  r = HalfMask/base;
+  for (dlen=1, divisor=base; divisor<=r; dlen++) {
+    divisor *= base;
+  }
+  rx->base = base;
+  rx->hibase = hibase;
+  rx->dlen = dlen;
+  rx->divisor = divisor;
+  rx->pw[0] = checkalloc_ARRAY(bignum_half_t, 1);
+  rx->pw[0][0] = divisor;
+  rx->pwlen[0] = 1;
+  rx->pwsize[0] = 1;
+  rx->npw = 1;
+}
+
+/* Add the next power */
+static void bh_radix_square(bh_radix_t *rx) {
+  int i = rx->npw-1;
+  bnlen_t pn = rx->pwlen[i];
+  bnlen_t itch = BH_MUL_N_ITCH(pn);
+  bignum_half_t *s = checkalloc_ARRAY(bignum_half_t, itch+1);
+  bignum_half_t *p = checkalloc_ARRAY(bignum_half_t, 2*pn);
+
+  bh_mul_n(p, rx->pw[i], rx->pw[i], pn, s);
+  checkdealloc_ARRAY(bignum_half_t, itch+1, s);
+  rx->pw[i+1] = p;
+  rx->pwlen[i+1] = bh_normlen(p, 2*pn);
+  rx->pwsize[i+1] = 2*pn;
+  rx->npw++;
+}
+
+static void bh_radix_free(bh_radix_t *rx) {
+  for (int i = 0; i < rx->npw; i++) {
+    checkdealloc_ARRAY(bignum_half_t, rx->pwsize[i], rx->pw[i]);
+  }
+}
+
+/* Write the digits of a (an digits, destroyed) in out, padded with
+   zeros to exactly dlen<<t characters (a < pw[t]). Halves are
+   obtained dividing by pw[t-1] and converted recursively. */
+static void bh_get_str(char *out, bignum_half_t *a, bnlen_t an, int t, bh_radix_t *rx) {
+  if (t == 0 || an < BN_DC_RADIX_THRESHOLD) {
+    char *c = out+((bnlen_t)rx->dlen<<t);
+    while (c > out) {
+      bignum_t r = 0;
+      if (an > 0) {
+        r = bh_divrem_1(a, a, an, rx->divisor);
+        an = bh_normlen(a, an);
+      }
+      for (int j = rx->dlen; j > 0; j--) {
+        bignum_t digit = r%rx->base;
+        *--c = (digit<10 ? '0'+digit : rx->hibase+digit);
+        r /= rx->base;
+      }
+    }
+  } else {
+    bnlen_t half = (bnlen_t)rx->dlen<<(t-1);
+    bignum_half_t *p = rx->pw[t-1];
+    bnlen_t pn = rx->pwlen[t-1];
+    if (an < pn || (an == pn && bh_cmp(a, p, an) < 0)) {
+      memset(out, '0', half);
+      bh_get_str(out+half, a, an, t-1, rx);
+    } else {
+      bnlen_t qn = an-pn+1;
+      bnlen_t itch = bh_tdiv_qr_itch(an, pn);
+      bignum_half_t *q = checkalloc_ARRAY(bignum_half_t, qn+pn);
+      bignum_half_t *r = q+qn;
+      bignum_half_t *s = checkalloc_ARRAY(bignum_half_t, itch+1);
+      bh_tdiv_qr(q, r, a, an, p, pn, s);
+      checkdealloc_ARRAY(bignum_half_t, itch+1, s);
+      bh_get_str(out, q, bh_normlen(q, qn), t-1, rx);
+      bh_get_str(out+half, r, bh_normlen(r, pn), t-1, rx);
+      checkdealloc_ARRAY(bignum_half_t, qn+pn, q);
+    }
+  }
+}
+
+/* r = a*d+c (n digits, c is a digit), return the carry */
+static bignum_half_t bh_mul_1(bignum_half_t *r, bignum_half_t *a, bnlen_t n, bignum_half_t d, bignum_t c) {
+  for (bnlen_t i = 0; i < n; i++) {
+    c += (bignum_t)a[i]*d;
+    r[i] = c & HalfMask;
+    c >>= HalfUnit;
+  }
+  return c;
+}
+
+/* Store in r (nch digits) the value of the len digits at x, which
+   are split in nch chunks of dlen digits (except the first one), and
+   return its length. The low part is a power of two of chunks,
+   multiplied by pw[i] and added to the high part. */
+static bnlen_t bh_set_str(bignum_half_t *r, char *x, bnlen_t len, bnlen_t nch, bh_radix_t *rx) {
+  if (nch < BN_DC_RADIX_THRESHOLD) {
+    bnlen_t rn = 0;
+    char *end = x+len;
+    bnlen_t k = len-(nch-1)*rx->dlen;
+    while (x < end) {
+      bignum_t v = 0;
+      for (; k > 0; k--) {
+        char cur = *x++;
+        v = v*rx->base + (cur>='a' ? cur-'a'+10 : cur>='A' ? cur-'A'+10 : cur-'0');
+      }
+      k = rx->dlen;
+      v = bh_mul_1(r, r, rn, rx->divisor, v);
+      if (v) r[rn++] = v;
+    }
+    return rn;
+  } else {
+    int i = 0;
+    bnlen_t k, rlen, ln, rn, pn;
+    bignum_half_t *l, *p;
+    while (((bnlen_t)2<<i) < nch) i++;
+    k = (bnlen_t)1<<i; /* (chunks in the low part) */
+    rlen = k*rx->dlen;
+    p = rx->pw[i];
+    pn = rx->pwlen[i];
+    rn = bh_set_str(r, x+len-rlen, rlen, k, rx);
+    bh_zero(r+rn, nch-rn);
+    l = checkalloc_ARRAY(bignum_half_t, nch-k);
+    ln = bh_set_str(l, x, len-rlen, nch-k, rx);
+    if (ln > 0) {
+      bnlen_t itch = (ln >= pn ? bh_mul_itch(ln, pn) : bh_mul_itch(pn, ln));
+      bignum_half_t *m = checkalloc_ARRAY(bignum_half_t, ln+pn+itch);
+      if (ln >= pn) {
+        bh_mul(m, l, ln, p, pn, m+ln+pn);
+      } else {
+        bh_mul(m, p, pn, l, ln, m+ln+pn);
+      }
+      bh_add(r, r, nch, m, ln+pn);
+      checkdealloc_ARRAY(bignum_half_t, ln+pn+itch, m);
+    }
+    checkdealloc_ARRAY(bignum_half_t, nch-k, l);
+    return bh_normlen(r, nch);
+  }
+}
+
+/* --------------------------------------------------------------------------- */
+/* Connection with bignum_t */
+
+/* Scratch (in bignum_t units) for bn_mult_fast() */
+static bnlen_t bn_mult_fast_itch(bnlen_t xlen, bnlen_t ylen) {
+  bnlen_t an = xlen<<1;
+  bnlen_t bn = ylen<<1;
+  bnlen_t itch = (an >= bn ? bh_mul_itch(an, bn) : bh_mul_itch(bn, an));
+  return (2*(an+bn)+itch+1)>>1;
+}
+
+/* z = x*y (magnitudes), using the scratch after the xlen+ylen words of z */
+static void bn_mult_fast(bignum_t *x, bnlen_t xlen, bignum_t *y, bnlen_t ylen, bignum_t *z) {
+  bnlen_t an = xlen<<1;
+  bnlen_t bn = ylen<<1;
+  bignum_half_t *a = (bignum_half_t *)&Bn(z,xlen+ylen+1);
+  bignum_half_t *b = a+an;
+  bignum_half_t *r = b+bn;
+  bnlen_t i;
+
+  for (i=0; i<an; i++) a[i] = BignumHalf(x,i+1);
+  for (i=0; i<bn; i++) b[i] = BignumHalf(y,i+1);
+  if (an >= bn) {
+    bh_mul(r, a, an, b, bn, r+an+bn);
+  } else {
+    bh_mul(r, b, bn, a, an, r+an+bn);
+  }
+  for (i=0; i<an+bn; i++) BignumHalf(z,i+1) = r[i];
+}
+
+/* Quotient or remainder of magnitudes x and y (with ulen and vlen
+   significant digits) */
+static bignum_size_t bn_div_mod_fast(bignum_t *x, bnlen_t ulen, bignum_t *y, bnlen_t vlen, bool_t quot_wanted, bignum_t *z, bignum_t *zmax) {
+  bnlen_t qlen = ulen-vlen+1;
+  bnlen_t zlen = BignumLength(x)+1; /* (room for the result) */
+  bignum_half_t *u, *v, *q, *r, *res;
+  bnlen_t i, rlen, len;
+
+  BignumCheck(z,zlen+((ulen+vlen+qlen+vlen+bh_tdiv_qr_itch(ulen,vlen)+1)>>1),zmax);
+  u = (bignum_half_t *)&Bn(z,zlen+1);
+  v = u+ulen;
+  q = v+vlen;
+  r = q+qlen;
+  for (i=0; i<ulen; i++) u[i] = BignumHalf(x,i+1);
+  for (i=0; i<vlen; i++) v[i] = BignumHalf(y,i+1);
+  bh_tdiv_qr(q, r, u, ulen, v, vlen, r+vlen);
+  if (quot_wanted) {
+    res = q;
+    rlen = qlen;
+  } else {
+    res = r;
+    rlen = vlen;
+  }
+  len = (rlen+2)>>1; /* (at least a zero digit on top) */
+  BignumSetLength(z,len);
+  for (i=0; i<rlen; i++) BignumHalf(z,i+1) = res[i];
+  for (; i<2*len; i++) BignumHalf(z,i+1) = 0;
+  return 0;
+}
+
+static CVOID__PROTO(bn_to_string_fast, bignum_t *x, int base, char hibase) {
+  bool_t sx = BignumPositive(x);
+  bnlen_t xlen = BignumLength(x)<<1;
+  bnlen_t an, width, j, k;
+  bignum_half_t *a;
+  bh_radix_t rx;
+  char *c, *c0;
+  int t;
+
+  a = checkalloc_ARRAY(bignum_half_t, xlen);
+  if (!sx) {
+    for (k=1, j=0; j<xlen; j++) {
+      a[j] = ~BignumHalf(x,j+1)+k;
+      k &= !a[j];
+    }
+  } else {
+    for (j=0; j<xlen; j++) {
+      a[j] = BignumHalf(x,j+1);
+    }
+  }
+  an = bh_normlen(a, xlen);
+
+  /* smallest t such that a < divisor^(2^t) */
+  bh_radix_init(&rx, base, hibase);
+  for (t=0; rx.pwlen[t] < an || (rx.pwlen[t] == an && bh_cmp(rx.pw[t], a, an) <= 0); t++) {
+    if (t+1 == rx.npw) bh_radix_square(&rx);
+  }
+  width = (bnlen_t)rx.dlen<<t;
+  GET_ATOM_BUFFER2(c, width+2);
+  c0 = sx ? c : c+1;
+  bh_get_str(c0, a, an, t, &rx);
+  for (k=0; k<width-1 && c0[k]=='0'; k++) {}
+  memmove(c0, c0+k, width-k);
+  c0[width-k] = 0;
+  if (!sx) c[0] = '-';
+  bh_radix_free(&rx);
+  checkdealloc_ARRAY(bignum_half_t, xlen, a);
+}
+
+static bignum_size_t bn_from_string_fast(char *x, bool_t sx, bignum_t *z, bignum_t *zmax, int base) {
+  bnlen_t len = strlen(x);
+  bnlen_t nch, zlen, rn, i;
+  bignum_half_t *r;
+  bh_radix_t rx;
+  int bits;
+
+  /* (room for len*ceil(log2(base)) bits and a zero digit on top) */
+  for (bits=1; (1<<bits) < base; bits++) {}
+  zlen = ((len*bits)>>LOG2_bignum_size)+2;
+  BignumCheck(z,zlen,zmax);
+  bh_radix_init(&rx, base, 0);
+  nch = (len+rx.dlen-1)/rx.dlen;
+  while (((bnlen_t)1<<rx.npw) < nch) bh_radix_square(&rx);
+  r = checkalloc_ARRAY(bignum_half_t, nch);
+  rn = bh_set_str(r, x, len, nch, &rx);
+  zlen = (rn+2)>>1;
+  BignumSetLength(z,zlen);
+  for (i=0; i<rn; i++) BignumHalf(z,i+1) = r[i];
+  for (; i<2*zlen; i++) BignumHalf(z,i+1) = 0;
+  checkdealloc_ARRAY(bignum_half_t, nch, r);
+  bh_radix_free(&rx);
+  if (!sx) bn_negate(z);
+  bn_canonize(z);
+  return 0;
+}
+
+#else /* defined(USE_GMP) */
+
+/* GMP backend: the same entry points, implemented with mpn_* functions
+   on the bignum_t words (which must be GMP limbs) */
+
+#if GMP_LIMB_BITS != (1<<LOG2_bignum_size) || GMP_NAIL_BITS != 0
+#error "USE_GMP requires GMP limbs of the same size as bignum_t"
+#endif
+
+#define BnLimbs(X) ((mp_limb_t *)&Bn((X),1))
+
+static bnlen_t bn_mult_fast_itch(bnlen_t xlen, bnlen_t ylen) {
+  return 0;
+}
+
+static void bn_mult_fast(bignum_t *x, bnlen_t xlen, bignum_t *y, bnlen_t ylen, bignum_t *z) {
+  if (x == y) {
+    mpn_sqr(BnLimbs(z), BnLimbs(x), xlen);
+  } else if (xlen >= ylen) {
+    mpn_mul(BnLimbs(z), BnLimbs(x), xlen, BnLimbs(y), ylen);
+  } else {
+    mpn_mul(BnLimbs(z), BnLimbs(y), ylen, BnLimbs(x), xlen);
+  }
+}
+
+static bignum_size_t bn_div_mod_fast(bignum_t *x, bnlen_t ulen, bignum_t *y, bnlen_t vlen, bool_t quot_wanted, bignum_t *z, bignum_t *zmax) {
+  mp_size_t nn = (ulen+1)>>1;
+  mp_size_t dn = (vlen+1)>>1;
+  bnlen_t zlen = BignumLength(x)+1; /* (room for the result) */
+  bnlen_t rlen = quot_wanted ? nn-dn+1 : dn;
+  mp_limb_t *other;
+
+  BignumCheck(z,zlen+nn+1,zmax);
+  other = (mp_limb_t *)&Bn(z,zlen+1);
+  if (quot_wanted) {
+    mpn_tdiv_qr(BnLimbs(z), other, 0, BnLimbs(x), nn, BnLimbs(y), dn);
+  } else {
+    mpn_tdiv_qr(other, BnLimbs(z), 0, BnLimbs(x), nn, BnLimbs(y), dn);
+  }
+  BignumSetLength(z,rlen+1);
+  Bn(z,rlen+1) = 0;
+  return 0;
+}
+
+static CVOID__PROTO(bn_to_string_fast, bignum_t *x, int base, char hibase) {
+  bool_t sx = BignumPositive(x);
+  bnlen_t xlen = BignumLength(x);
+  mp_size_t n;
+  mp_limb_t *a;
+  size_t len, k, i;
+  char *c, *c0;
+  int digit;
+
+  a = checkalloc_ARRAY(mp_limb_t, xlen+1);
+  if (!sx) {
+    for (k=1, i=0; i<xlen; i++) {
+      a[i] = ~Bn(x,i+1)+k;
+      k &= !a[i];
+    }
+  } else {
+    for (i=0; i<xlen; i++) {
+      a[i] = Bn(x,i+1);
+    }
+  }
+  for (n=xlen; n>1 && a[n-1]==0; n--) {}
+  len = mpn_sizeinbase(a, n, base);
+  GET_ATOM_BUFFER2(c, len+3);
+  c0 = sx ? c : c+1;
+  len = mpn_get_str((unsigned char *)c0, base, a, n);
+  for (k=0; k<len-1 && c0[k]==0; k++) {}
+  for (i=k; i<len; i++) {
+    digit = c0[i];
+    c0[i-k] = (digit<10 ? '0'+digit : hibase+digit);
+  }
+  c0[len-k] = 0;
+  if (!sx) c[0] = '-';
+  checkdealloc_ARRAY(mp_limb_t, xlen+1, a);
+}
+
+static bignum_size_t bn_from_string_fast(char *x, bool_t sx, bignum_t *z, bignum_t *zmax, int base) {
+  size_t len = strlen(x);
+  unsigned char *d;
+  bnlen_t zlen;
+  mp_size_t n;
+  size_t i;
+  int bits;
+  char cur;
+
+  /* (room for len*ceil(log2(base)) bits, one extra limb, and a zero
+     word on top) */
+  for (bits=1; (1<<bits) < base; bits++) {}
+  zlen = ((len*bits)>>LOG2_bignum_size)+3;
+  BignumCheck(z,zlen,zmax);
+  d = checkalloc_ARRAY(unsigned char, len);
+  for (i=0; i<len; i++) {
+    cur = x[i];
+    d[i] = (cur>='a' ? cur-'a'+10 : cur>='A' ? cur-'A'+10 : cur-'0');
+  }
+  n = mpn_set_str(BnLimbs(z), d, len, base);
+  checkdealloc_ARRAY(unsigned char, len, d);
+  BignumSetLength(z,n+1);
+  Bn(z,n+1) = 0;
+  if (!sx) bn_negate(z);
+  bn_canonize(z);
+  return 0;
+}
+
+#endif /* defined(USE_GMP) */
+
+/* --------------------------------------------------------------------------- */
+/* Modular exponentiation and integer square root */
+
+/* Copy the magnitude of x to a (2*BignumLength(x) digits), return its
+   length without leading zero digits */
+static bnlen_t bh_from_bignum(bignum_half_t *a, bignum_t *x) {
+  bnlen_t xn = BignumLength(x)<<1;
+  bnlen_t j;
+  if (!BignumPositive(x)) {
+    bignum_half_t k = 1;
+    for (j=0; j<xn; j++) {
+      a[j] = ~BignumHalf(x,j+1)+k;
+      k &= !a[j];
+    }
+  } else {
+    for (j=0; j<xn; j++) a[j] = BignumHalf(x,j+1);
+  }
+  return bh_normlen(a, xn);
+}
+
+/* Store in z the non-negative integer r (rn digits), z must have room
+   for (rn+2)>>1 units */
+static void bn_from_bh(bignum_t *z, bignum_half_t *r, bnlen_t rn) {
+  bnlen_t zlen = (rn+2)>>1;
+  bnlen_t i;
+  BignumSetLength(z,zlen);
+  for (i=0; i<rn; i++) BignumHalf(z,i+1) = r[i];
+  for (; i<2*zlen; i++) BignumHalf(z,i+1) = 0;
+  bn_canonize(z);
+}
+
+/* r = a >> k (r must not overlap a, which has an digits), return the
+   length of r */
+static bnlen_t bh_shr_bits(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_t k) {
+  bnlen_t dq = k/HalfUnit;
+  if (dq >= an) return 0;
+  bh_rshift(r, a+dq, an-dq, k%HalfUnit);
+  return bh_normlen(r, an-dq);
+}
+
+/* r = a << k (r has room for an+k/HalfUnit+1 digits and must not
+   overlap a), return the length of r */
+static bnlen_t bh_shl_bits(bignum_half_t *r, bignum_half_t *a, bnlen_t an, bignum_t k) {
+  bnlen_t dq = k/HalfUnit;
+  bh_zero(r, dq);
+  r[dq+an] = bh_lshift(r+dq, a, an, k%HalfUnit);
+  return bh_normlen(r, dq+an+1);
+}
+
+/* z = x^y mod m (pre: 0 <= x < m, y >= 0, m > 0). Left-to-right binary
+   exponentiation, products and remainders use the subquadratic
+   kernels above */
+bignum_size_t bn_powm(bignum_t *x, bignum_t *y, bignum_t *m, bignum_t *z, bignum_t *zmax) {
+  bnlen_t n = BignumLength(m)<<1;
+  bnlen_t xn, yn, size, itch, i;
+  bignum_half_t *mm, *b, *r, *t, *q, *s;
+  bool_t started = FALSE;
+
+  while (n > 1 && BignumHalf(m,n) == 0) n--;
+  BignumCheck(z,(n+2)>>1,zmax);
+  itch = BH_MUL_N_ITCH(n);
+  if (bh_tdiv_qr_itch(2*n, n) > itch) itch = bh_tdiv_qr_itch(2*n, n);
+  /* (b has room for the whole x, which may have more units than m) */
+  size = n + (n+2) + n + 2*n + (n+1) + itch;
+  mm = checkalloc_ARRAY(bignum_half_t, size);
+  b = mm+n;
+  r = b+n+2;
+  t = r+n;
+  q = t+2*n;
+  s = q+n+1;
+  for (i=0; i<n; i++) mm[i] = BignumHalf(m,i+1);
+  xn = bh_from_bignum(b, x);
+  bh_zero(b+xn, n-xn);
+  bh_zero(r, n);
+  r[0] = (n == 1 && mm[0] == 1) ? 0 : 1; /* (1 mod m) */
+  yn = BignumLength(y)<<1;
+  while (yn > 0 && BignumHalf(y,yn) == 0) yn--;
+  for (i=yn; i>0; i--) {
+    bignum_half_t e = BignumHalf(y,i);
+    for (int j=HalfUnit-1; j>=0; j--) {
+      if (started) {
+        bh_mul_n(t, r, r, n, s);
+        bh_tdiv_qr(q, r, t, 2*n, mm, n, s);
+      }
+      if ((e>>j) & 1) {
+        if (started) {
+          bh_mul_n(t, r, b, n, s);
+          bh_tdiv_qr(q, r, t, 2*n, mm, n, s);
+        } else {
+          bh_copy(r, b, n);
+          started = TRUE;
+        }
+      }
+    }
+  }
+  bn_from_bh(z, r, bh_normlen(r, n));
+  checkdealloc_ARRAY(bignum_half_t, size, mm);
+  return 0;
+}
+
+/* z = floor(sqrt(x)) (pre: x >= 0). Uses the recursion on the number
+   of bits from Python's math.isqrt(), which doubles the precision of
+   the approximation a at each step, so that the cost is dominated by
+   the last division */
+bignum_size_t bn_isqrt(bignum_t *x, bignum_t *z, bignum_t *zmax) {
+  bnlen_t xn = BignumLength(x)<<1;
+  bnlen_t an_max = xn/2+3;
+  bnlen_t an, a2n, tn, qn, size, itch, itch_max;
+  bignum_half_t *xa, *a, *a2, *t, *q, *rem, *s;
+  bignum_t nbits, c, d, e;
+  int k;
+
+  BignumCheck(z,(an_max+2)>>1,zmax);
+  size = xn + 2*an_max + 2*xn + an_max;
+  xa = checkalloc_ARRAY(bignum_half_t, size);
+  a = xa+xn;
+  a2 = a+an_max;
+  t = a2+an_max;
+  q = t+xn;
+  rem = q+xn;
+  itch_max = 0;
+  s = NULL;
+  xn = bh_from_bignum(xa, x);
+  if (xn == 0) {
+    an = 0;
+    goto done;
+  }
+  nbits = (bignum_t)(xn-1)*HalfUnit + bignum_MSB(xa[xn-1]) + 1;
+  c = (nbits-1)/2;
+  a[0] = 1;
+  an = 1;
+  d = 0;
+  for (k = (c == 0) ? -1 : bignum_MSB(c); k >= 0; k--) {
+    /* a = (a << (d-e-1)) + (x >> (2c-e-d+1)) / a */
+    e = d;
+    d = c >> k;
+    tn = bh_shr_bits(t, xa, xn, 2*c-e-d+1);
+    if (tn >= an) {
+      itch = bh_tdiv_qr_itch(tn, an);
+      if (itch > itch_max) {
+        if (s != NULL) checkdealloc_ARRAY(bignum_half_t, itch_max, s);
+        s = checkalloc_ARRAY(bignum_half_t, itch);
+        itch_max = itch;
+      }
+      bh_tdiv_qr(q, rem, t, tn, a, an, s);
+      qn = bh_normlen(q, tn-an+1);
+    } else {
+      qn = 0;
+    }
+    a2n = bh_shl_bits(a2, a, an, d-e-1);
+    if (a2n >= qn) {
+      a[a2n] = bh_add(a, a2, a2n, q, qn);
+      an = a2n+1;
+    } else {
+      a[qn] = bh_add(a, q, qn, a2, a2n);
+      an = qn+1;
+    }
+    an = bh_normlen(a, an);
+  }
+  /* a*a > x iff a > x/a */
+  itch = bh_tdiv_qr_itch(xn, an);
+  if (itch > itch_max) {
+    if (s != NULL) checkdealloc_ARRAY(bignum_half_t, itch_max, s);
+    s = checkalloc_ARRAY(bignum_half_t, itch);
+    itch_max = itch;
+  }
+  bh_tdiv_qr(q, rem, xa, xn, a, an, s);
+  qn = bh_normlen(q, xn-an+1);
+  if (an > qn || (an == qn && bh_cmp(a, q, an) > 0)) {
+    bh_sub_1(a, a, an, 1);
+    an = bh_normlen(a, an);
+  }
+ done:
+  bn_from_bh(z, a, an);
+  if (s != NULL) checkdealloc_ARRAY(bignum_half_t, itch_max, s);
+  checkdealloc_ARRAY(bignum_half_t, size, xa);
+  return 0;
+}
+
 /* --------------------------------------------------------------------------- */
 
 /* y is shorter than x */
@@ -691,16 +1797,26 @@ bignum_size_t bn_multiply(bignum_t *x, bignum_t *y, bignum_t *z, bignum_t *zmax)
   bnlen_t xlen = BignumLength(x);
   bnlen_t ylen = BignumLength(y);
 
-  BignumCheck(z,xlen+ylen,zmax);
+  bool_t fast = 2*(xlen<ylen ? xlen : ylen) >= BN_KARATSUBA_THRESHOLD;
+
+  if (fast) {
+    BignumCheck(z,xlen+ylen+bn_mult_fast_itch(xlen,ylen),zmax);
+    BignumSetLength(z,xlen+ylen);
+  } else {
+    BignumCheck(z,xlen+ylen,zmax);
+  }
+  /* (x and y may be the same bignum) */
   if (!sx) bn_negate(x);
-  if (!sy) bn_negate(y);
-  if (xlen>ylen) {
+  if (!sy && y != x) bn_negate(y);
+  if (fast) {
+    bn_mult_fast(x,xlen,y,ylen,z);
+  } else if (xlen>ylen) {
     bn_mult_knuth(x,xlen,y,ylen,z);
   } else {
     bn_mult_knuth(y,ylen,x,xlen,z);
   }
   if (!sx) bn_negate(x);
-  if (!sy) bn_negate(y);
+  if (!sy && y != x) bn_negate(y);
   if (sx^sy) bn_negate(z);
   bn_canonize(z); 
   return 0;
@@ -751,6 +1867,8 @@ static bignum_size_t bn_div_mod_quot_wanted(bignum_t *x, bignum_t *y, bignum_t *
     BignumHalf(z,ulen+1) = 0;
     BignumHalf(z,ulen+2) = 0;
     return 0;
+  } else if (vlen >= BN_DC_DIV_THRESHOLD && ulen-vlen >= BN_DC_DIV_THRESHOLD) {
+    return bn_div_mod_fast(x,ulen,y,vlen,TRUE,z,zmax);
   }
   // prbignum("x", (bignum_half_t *)x, ulen);
   // prbignum("y", (bignum_half_t *)y, vlen);
@@ -870,6 +1988,8 @@ static bignum_size_t bn_div_mod_quot_not_wanted(bignum_t *x, bignum_t *y, bignum
     BignumCheck(z,1,zmax);
     Bn(z,1) = carry>>HalfUnit;
     return 0;
+  } else if (vlen >= BN_DC_DIV_THRESHOLD && ulen-vlen >= BN_DC_DIV_THRESHOLD) {
+    return bn_div_mod_fast(x,ulen,y,vlen,FALSE,z,zmax);
   }
   BignumCheck(z,(3*ulen+4)>>1,zmax);
   v = (bignum_half_t *)z+ulen+2;
@@ -959,10 +2079,10 @@ bignum_size_t bn_quotient_remainder_quot_wanted(bignum_t *x, bignum_t *y, bignum
   bignum_size_t value;
 
   if (!sx) bn_negate(x);
-  if (!sy) bn_negate(y);
+  if (!sy && y != x) bn_negate(y);
   value = bn_div_mod_quot_wanted(x,y,z,zmax);
   if (!sx) bn_negate(x);
-  if (!sy) bn_negate(y);
+  if (!sy && y != x) bn_negate(y);
   if (!value) {
     if (sx^sy) {
       bn_negate(z);
@@ -978,10 +2098,10 @@ bignum_size_t bn_quotient_remainder_quot_not_wanted(bignum_t *x, bignum_t *y, bi
   bignum_size_t value;
   
   if (!sx) bn_negate(x);
-  if (!sy) bn_negate(y);
+  if (!sy && y != x) bn_negate(y);
   value = bn_div_mod_quot_not_wanted(x,y,z,zmax);
   if (!sx) bn_negate(x);
-  if (!sy) bn_negate(y);
+  if (!sy && y != x) bn_negate(y);
   if (!value) {
     if (!sx) {
       bn_negate(z);
@@ -1168,6 +2288,9 @@ bignum_size_t bn_from_string(char *x, bignum_t *z, bignum_t *zmax, int base) {
   } else {
     sx = TRUE;
   }
+  if (strlen(x) >= BN_DC_RADIX_THRESHOLD) {
+    return bn_from_string_fast(x,sx,z,zmax,base);
+  }
 
   zlen = 2;
   BignumCheck(z,1,zmax);
@@ -1207,6 +2330,10 @@ CVOID__PROTO(bn_to_string, bignum_t *x, int base) {
     base = -base;
   }
   xlen = BignumLength(x)<<1;
+  if (xlen >= BN_DC_RADIX_THRESHOLD) {
+    CVOID__CALL(bn_to_string_fast, x, base, hibase);
+    return;
+  }
 
   /* compute divisor = base**N such that divisor <= 1<<16. */
   r = ((bignum_t)1<<HalfUnit)/base;
@@ -0,0 +1,480 @@
+/*
+ *  eng_bytes.c
+ *
+ *  Byte buffers (immutable byte strings stored in the heap)
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+#include <ciao/io_basic.h> /* RUNE_VOID */
+#include <ciao/stream_basic.h>
+#include <ciao/eng_bytes.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#if !defined(Win32)
+#include <sys/mman.h>
+#include <sys/socket.h>
+#endif
+
+/* Largest read/write buffer for a single call */
+#define BYTES_IO_CHUNK 65536
+
+static tagged_t functor_bytes = 0;
+static tagged_t atom_bytes_data = 0;
+
+static void bytes_init_atoms(void) {
+  if (functor_bytes == 0) {
+    atom_bytes_data = GET_ATOM("$bytes_data");
+    functor_bytes = SetArity(GET_ATOM("$bytes"), 3);
+  }
+}
+
+/* Decode a byte buffer (fails if t is not a well formed byte buffer) */
+bool_t bytes_view(tagged_t t, bytes_view_t *v) {
+  tagged_t data, off, len;
+  bytes_init_atoms();
+  DEREF(t, t);
+  if (!TaggedIsSTR(t) || TaggedToHeadfunctor(t) != functor_bytes) return FALSE;
+  DerefArg(data, t, 1);
+  DerefArg(off, t, 2);
+  DerefArg(len, t, 3);
+  if (!TaggedIsSTR(data) || !TaggedIsSmall(off) || !TaggedIsSmall(len)) return FALSE;
+  if (SetArity(TaggedToHeadfunctor(data), 0) != atom_bytes_data) return FALSE;
+  v->data = data;
+  v->off = GetSmall(off);
+  v->len = GetSmall(len);
+  if (v->off < 0 || v->len < 0 ||
+      v->off + v->len > Arity(TaggedToHeadfunctor(data)) * BYTES_PER_CELL) return FALSE;
+  return TRUE;
+}
+
+#define BytesWord(V, I) ((uintval_t)GetSmall(*TaggedToArg((V)->data, (I)+1)))
+
+static inline unsigned char bytes_at(bytes_view_t *v, intmach_t i) {
+  i += v->off;
+  return (BytesWord(v, i / BYTES_PER_CELL) >> (8 * (i % BYTES_PER_CELL))) & 0xff;
+}
+
+/* Copy n bytes (from byte 'from' of the view) to dst */
+void bytes_copy_out(bytes_view_t *v, intmach_t from, intmach_t n, unsigned char *dst) {
+  intmach_t i, w, sh;
+  uintval_t word;
+  if (n <= 0) return;
+  i = v->off + from;
+  w = i / BYTES_PER_CELL;
+  sh = i % BYTES_PER_CELL;
+  word = BytesWord(v, w) >> (8 * sh);
+  for (;;) {
+    *dst++ = word & 0xff;
+    if (--n == 0) break;
+    if (++sh == BYTES_PER_CELL) {
+      sh = 0;
+      w++;
+      word = BytesWord(v, w);
+    } else {
+      word >>= 8;
+    }
+  }
+}
+
+/* Pack bytes into the data words of a new byte buffer */
+
+typedef struct bytes_packer_ bytes_packer_t;
+struct bytes_packer_ {
+  tagged_t *h;
+  uintval_t word;
+  intmach_t sh;
+};
+
+#define BytesPackerPush(P, B) ({ \
+  (P)->word |= (uintval_t)(B) << (8 * (P)->sh); \
+  if (++(P)->sh == BYTES_PER_CELL) { \
+    HeapPush((P)->h, MakeSmall((P)->word)); \
+    (P)->word = 0; \
+    (P)->sh = 0; \
+  } \
+})
+
+/* Pre: BYTES_CELLS(len) available in the heap */
+static CFUN__PROTO(bytes_pack_begin, tagged_t, bytes_packer_t *p, intmach_t len) {
+  tagged_t data;
+  bytes_init_atoms();
+  data = Tagp(STR, G->heap_top);
+  HeapPush(G->heap_top, SetArity(atom_bytes_data, BYTES_DATA_WORDS(len)));
+  p->h = G->heap_top;
+  p->word = 0;
+  p->sh = 0;
+  return data;
+}
+
+static CFUN__PROTO(bytes_pack_end, tagged_t, bytes_packer_t *p, tagged_t data, intmach_t len) {
+  tagged_t t;
+  if (p->sh > 0 || len == 0) HeapPush(p->h, MakeSmall(p->word));
+  G->heap_top = p->h;
+  t = Tagp(STR, G->heap_top);
+  HeapPush(G->heap_top, functor_bytes);
+  HeapPush(G->heap_top, data);
+  HeapPush(G->heap_top, MakeSmall(0));
+  HeapPush(G->heap_top, MakeSmall(len));
+  return t;
+}
+
+/* New byte buffer with a copy of src[0..len-1]
+   Pre: BYTES_CELLS(len) available in the heap */
+CFUN__PROTO(bytes_make, tagged_t, const unsigned char *src, intmach_t len) {
+  bytes_packer_t p;
+  tagged_t data;
+  intmach_t i;
+  data = CFUN__EVAL(bytes_pack_begin, &p, len);
+  for (i = 0; i < len; i++) BytesPackerPush(&p, src[i]);
+  return CFUN__EVAL(bytes_pack_end, &p, data, len);
+}
+
+static CFUN__PROTO(bytes_make_slice, tagged_t, tagged_t data, intmach_t off, intmach_t len) {
+  tagged_t t;
+  t = Tagp(STR, G->heap_top);
+  HeapPush(G->heap_top, functor_bytes);
+  HeapPush(G->heap_top, data);
+  HeapPush(G->heap_top, MakeSmall(off));
+  HeapPush(G->heap_top, MakeSmall(len));
+  return t;
+}
+
+#define ENSURE_HEAP_BYTES(CELLS, ARITY) \
+  TEST_HEAP_OVERFLOW(G->heap_top, (CELLS)*sizeof(tagged_t)+CONTPAD, (ARITY))
+
+/* --------------------------------------------------------------------------- */
+
+/* '$bytes_from_codes'(+Codes, -Bytes) */
+CBOOL__PROTO(prolog_bytes_from_codes) {
+  bytes_packer_t p;
+  tagged_t l, car, data;
+  intmach_t len;
+
+  /* Check the list and get its length */
+  len = 0;
+  DEREF(l, X(0));
+  while (l != atom_nil) {
+    if (!TaggedIsLST(l)) CBOOL__FAIL;
+    DerefCar(car, l);
+    if (!TaggedIsSmall(car) || car < TaggedZero || car >= MakeSmall(256)) CBOOL__FAIL;
+    DerefCdr(l, l);
+    len++;
+  }
+
+  ENSURE_HEAP_BYTES(BYTES_CELLS(len), 2);
+  data = CFUN__EVAL(bytes_pack_begin, &p, len);
+  DEREF(l, X(0));
+  while (l != atom_nil) {
+    DerefCar(car, l);
+    BytesPackerPush(&p, GetSmall(car));
+    DerefCdr(l, l);
+  }
+  CBOOL__LASTUNIFY(CFUN__EVAL(bytes_pack_end, &p, data, len), X(1));
+}
+
+/* '$bytes_to_codes'(+Bytes, -Codes) */
+CBOOL__PROTO(prolog_bytes_to_codes) {
+  bytes_view_t v;
+  tagged_t l;
+  intmach_t i;
+
+  CBOOL__TEST(bytes_view(X(0), &v));
+  ENSURE_HEAP_LST(v.len, 2);
+  (void)bytes_view(X(0), &v); /* (after a possible GC) */
+  l = atom_nil;
+  for (i = v.len - 1; i >= 0; i--) {
+    MakeLST(l, MakeSmall(bytes_at(&v, i)), l);
+  }
+  CBOOL__LASTUNIFY(l, X(1));
+}
+
+/* '$bytes_sub'(+Bytes, +Off, +Len, -Sub) */
+CBOOL__PROTO(prolog_bytes_sub) {
+  bytes_view_t v;
+  tagged_t t;
+  intmach_t off, len;
+
+  CBOOL__TEST(bytes_view(X(0), &v));
+  DEREF(t, X(1));
+  CBOOL__TEST(TaggedIsSmall(t));
+  off = GetSmall(t);
+  DEREF(t, X(2));
+  CBOOL__TEST(TaggedIsSmall(t));
+  len = GetSmall(t);
+  CBOOL__TEST(off >= 0 && len >= 0 && off + len <= v.len);
+
+  ENSURE_HEAP_BYTES(BYTES_SLICE_CELLS, 4);
+  (void)bytes_view(X(0), &v); /* (after a possible GC) */
+  CBOOL__LASTUNIFY(CFUN__EVAL(bytes_make_slice, v.data, v.off + off, len), X(3));
+}
+
+/* '$bytes_concat'(+BytesList, -Bytes) */
+CBOOL__PROTO(prolog_bytes_concat) {
+  bytes_packer_t p;
+  bytes_view_t v;
+  tagged_t l, car, data;
+  intmach_t len, i;
+
+  len = 0;
+  DEREF(l, X(0));
+  while (l != atom_nil) {
+    if (!TaggedIsLST(l)) CBOOL__FAIL;
+    DerefCar(car, l);
+    CBOOL__TEST(bytes_view(car, &v));
+    len += v.len;
+    DerefCdr(l, l);
+  }
+
+  ENSURE_HEAP_BYTES(BYTES_CELLS(len), 2);
+  data = CFUN__EVAL(bytes_pack_begin, &p, len);
+  DEREF(l, X(0));
+  while (l != atom_nil) {
+    DerefCar(car, l);
+    (void)bytes_view(car, &v);
+    for (i = 0; i < v.len; i++) BytesPackerPush(&p, bytes_at(&v, i));
+    DerefCdr(l, l);
+  }
+  CBOOL__LASTUNIFY(CFUN__EVAL(bytes_pack_end, &p, data, len), X(1));
+}
+
+/* '$bytes_search'(+Bytes, +Pattern, +From, -Pos): first position
+   (from From) where Pattern occurs in Bytes */
+CBOOL__PROTO(prolog_bytes_search) {
+  bytes_view_t v, pv;
+  tagged_t t;
+  intmach_t from, pos, n;
+  unsigned char *buf, *pat, *q, *end;
+
+  CBOOL__TEST(bytes_view(X(0), &v));
+  CBOOL__TEST(bytes_view(X(1), &pv));
+  DEREF(t, X(2));
+  CBOOL__TEST(TaggedIsSmall(t));
+  from = GetSmall(t);
+  CBOOL__TEST(from >= 0 && from + pv.len <= v.len);
+
+  n = v.len - from;
+  buf = checkalloc_ARRAY(unsigned char, n + pv.len + 1);
+  pat = buf + n;
+  bytes_copy_out(&v, from, n, buf);
+  bytes_copy_out(&pv, 0, pv.len, pat);
+  pos = -1;
+  if (pv.len == 0) {
+    pos = from;
+  } else {
+    end = buf + n - pv.len;
+    for (q = buf; q <= end; q++) {
+      q = memchr(q, pat[0], end - q + 1);
+      if (q == NULL) break;
+      if (memcmp(q, pat, pv.len) == 0) { pos = from + (q - buf); break; }
+    }
+  }
+  checkdealloc_ARRAY(unsigned char, n + pv.len + 1, buf);
+  CBOOL__TEST(pos >= 0);
+  CBOOL__LASTUNIFY(MakeSmall(pos), X(3));
+}
+
+/* '$bytes_get'(+Bytes, +Index, -Byte) (0-based) */
+CBOOL__PROTO(prolog_bytes_get) {
+  bytes_view_t v;
+  tagged_t t;
+  intmach_t i;
+
+  CBOOL__TEST(bytes_view(X(0), &v));
+  DEREF(t, X(1));
+  CBOOL__TEST(TaggedIsSmall(t));
+  i = GetSmall(t);
+  CBOOL__TEST(i >= 0 && i < v.len);
+  CBOOL__LASTUNIFY(MakeSmall(bytes_at(&v, i)), X(2));
+}
+
+/* '$bytes_compare'(-Order, +Bytes1, +Bytes2) (compare the contents) */
+CBOOL__PROTO(prolog_bytes_compare) {
+  bytes_view_t v1, v2;
+  intmach_t i, n;
+  int d;
+
+  CBOOL__TEST(bytes_view(X(1), &v1));
+  CBOOL__TEST(bytes_view(X(2), &v2));
+  n = v1.len < v2.len ? v1.len : v2.len;
+  d = 0;
+  for (i = 0; i < n && d == 0; i++) {
+    d = (int)bytes_at(&v1, i) - (int)bytes_at(&v2, i);
+  }
+  if (d == 0) d = (v1.len > v2.len) - (v1.len < v2.len);
+  CBOOL__LASTUNIFY(d < 0 ? atom_lessthan : d > 0 ? atom_greaterthan : atom_equal, X(0));
+}
+
+/* --------------------------------------------------------------------------- */
+
+/* '$bytes_read'(+Stream, +Max, -Bytes): read at most Max bytes (less
+   only at end of stream or, for sockets, if less data is available).
+   The buffer grows with the data read, so that a large Max does not
+   allocate memory in advance */
+CBOOL__PROTO(prolog_bytes_read) {
+  ERR__FUNCTOR("bytes:bytes_read", 3);
+  stream_node_t *s;
+  tagged_t t;
+  int errcode;
+  intmach_t max, n, cap, want;
+  ssize_t r;
+  unsigned char *buf;
+
+  s = stream_to_ptr_check(X(0), 'r', &errcode);
+  if (!s) BUILTIN_ERROR(errcode, X(0), 1);
+  DEREF(t, X(1));
+  if (!TaggedIsSmall(t)) BUILTIN_ERROR(ERR_type_error(integer), X(1), 2);
+  max = GetSmall(t);
+  if (max < 0) BUILTIN_ERROR(ERR_domain_error(not_less_than_zero), X(1), 2);
+
+  cap = max < BYTES_IO_CHUNK ? max + 1 : BYTES_IO_CHUNK;
+  buf = checkalloc_ARRAY(unsigned char, cap);
+  n = 0;
+  if (max > 0 && s->pending_rune != RUNE_VOID) { /* (returned by peek) */
+    if (s->pending_rune >= 0) buf[n++] = s->pending_rune;
+    s->pending_rune = RUNE_VOID;
+  }
+  while (n < max) {
+    if (n == cap) {
+      intmach_t cap1 = cap > max - cap ? max : 2 * cap;
+      buf = checkrealloc_ARRAY(unsigned char, cap, cap1, buf);
+      cap = cap1;
+    }
+    want = cap - n;
+    if (s->streammode != 's') { /* not a socket */
+      r = fread(buf + n, 1, want, s->streamfile);
+      if (ferror(s->streamfile)) {
+        checkdealloc_ARRAY(unsigned char, cap, buf);
+        BUILTIN_ERROR(ERR_system_error, X(0), 1);
+      }
+      n += r;
+      if (r < want) break; /* end of file */
+    } else { /* a socket */
+      if (s->socket_eof) break;
+      /* (only the first read may block) */
+#if defined(Win32)
+      if (n > 0) break;
+      do {
+        r = read(GetSmall(s->label), buf + n, want);
+      } while (r < 0 && errno == EINTR);
+#else
+      do {
+        r = recv(GetSmall(s->label), buf + n, want, n == 0 ? 0 : MSG_DONTWAIT);
+      } while (r < 0 && errno == EINTR);
+#endif
+      if (r < 0) {
+        if (n > 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+        checkdealloc_ARRAY(unsigned char, cap, buf);
+        BUILTIN_ERROR(ERR_system_error, X(0), 1);
+      }
+      if (r == 0) s->socket_eof = TRUE;
+      n += r;
+      if (r < want) break; /* no more data for now */
+    }
+  }
+
+  ENSURE_HEAP_BYTES(BYTES_CELLS(n), 3);
+  t = CFUN__EVAL(bytes_make, buf, n);
+  checkdealloc_ARRAY(unsigned char, cap, buf);
+  CBOOL__LASTUNIFY(t, X(2));
+}
+
+/* '$bytes_write'(+Stream, +Bytes) (updating the character and line
+   counts of the stream, as other output does) */
+CBOOL__PROTO(prolog_bytes_write) {
+  ERR__FUNCTOR("bytes:bytes_write", 2);
+  stream_node_t *s;
+  bytes_view_t v;
+  int errcode;
+  intmach_t i, n;
+  unsigned char buf[BYTES_IO_CHUNK];
+
+  s = stream_to_ptr_check(X(0), 'w', &errcode);
+  if (!s) BUILTIN_ERROR(errcode, X(0), 1);
+  CBOOL__TEST(bytes_view(X(1), &v));
+
+  for (i = 0; i < v.len; i += n) {
+    n = v.len - i < BYTES_IO_CHUNK ? v.len - i : BYTES_IO_CHUNK;
+    bytes_copy_out(&v, i, n, buf);
+    CVOID__CALL(print_nstring, s, (const char *)buf, n);
+  }
+  CBOOL__PROCEED;
+}
+
+/* '$bytes_read_file'(+Path, +Offset, +Length, -Bytes): read a byte
+   range of a regular file (clipped to its size), mapping it instead
+   of copying it through stdio buffers */
+CBOOL__PROTO(prolog_bytes_read_file) {
+  ERR__FUNCTOR("bytes:bytes_read_file", 4);
+  tagged_t t;
+  int fd;
+  struct stat st;
+  intmach_t off, len;
+  unsigned char *addr;
+#if defined(Win32)
+  ssize_t r;
+  intmach_t n;
+#else
+  off_t page_off;
+#endif
+
+  DEREF(X(0), X(0));
+  if (!TaggedIsATM(X(0))) BUILTIN_ERROR(ERR_type_error(atom), X(0), 1);
+  DEREF(X(1), X(1));
+  if (!TaggedIsSmall(X(1))) BUILTIN_ERROR(ERR_type_error(integer), X(1), 2);
+  DEREF(X(2), X(2));
+  if (!TaggedIsSmall(X(2))) BUILTIN_ERROR(ERR_type_error(integer), X(2), 3);
+  off = GetSmall(X(1));
+  len = GetSmall(X(2));
+
+  fd = open(GetString(X(0)), O_RDONLY);
+  if (fd < 0) BUILTIN_ERROR(ERR_existence_error(source_sink), X(0), 1);
+  if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    BUILTIN_ERROR(ERR_domain_error(source_sink), X(0), 1);
+  }
+  if (off < 0 || off > st.st_size) off = st.st_size;
+  if (len < 0 || len > st.st_size - off) len = st.st_size - off;
+
+  /* (before mapping, the heap may be grown) */
+  ENSURE_HEAP_BYTES(BYTES_CELLS(len), 4);
+  if (len == 0) {
+    close(fd);
+    t = CFUN__EVAL(bytes_make, NULL, 0);
+    CBOOL__LASTUNIFY(t, X(3));
+  }
+#if defined(Win32)
+  addr = checkalloc_ARRAY(unsigned char, len);
+  n = 0;
+  if (lseek(fd, off, SEEK_SET) == off) {
+    for (; n < len; n += r) {
+      r = read(fd, addr + n, len - n);
+      if (r < 0 && errno == EINTR) { r = 0; continue; }
+      if (r <= 0) break;
+    }
+  }
+  close(fd);
+  if (n < len) {
+    checkdealloc_ARRAY(unsigned char, len, addr);
+    BUILTIN_ERROR(ERR_system_error, X(0), 1);
+  }
+  t = CFUN__EVAL(bytes_make, addr, len);
+  checkdealloc_ARRAY(unsigned char, len, addr);
+#else
+  page_off = off % sysconf(_SC_PAGESIZE);
+  addr = mmap(NULL, len + page_off, PROT_READ, MAP_PRIVATE, fd, off - page_off);
+  close(fd);
+  if (addr == MAP_FAILED) BUILTIN_ERROR(ERR_system_error, X(0), 1);
+  t = CFUN__EVAL(bytes_make, addr + page_off, len);
+  munmap(addr, len + page_off);
+#endif
+  CBOOL__LASTUNIFY(t, X(3));
+}
@@ -0,0 +1,52 @@
+/*
+ *  eng_bytes.h
+ *
+ *  Byte buffers (immutable byte strings stored in the heap)
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_ENG_BYTES_H
+#define _CIAO_ENG_BYTES_H
+
+#include <ciao/eng.h>
+
+/* A byte buffer is represented as the term '$bytes'(Data, Off, Len),
+   where Data is '$bytes_data'(W1,...,Wn) and each Wi is a small
+   integer packing BYTES_PER_CELL bytes (little-endian). Off and Len
+   select a slice of Data, so that slices share the data with the
+   original buffer. Byte buffers are ordinary terms for the rest of
+   the engine (GC, copy, assert, etc.). */
+
+#define BYTES_PER_CELL ((tagged__num_size-1)/8)
+
+/* Words of data for len bytes (at least one) */
+#define BYTES_DATA_WORDS(LEN) ((LEN) == 0 ? 1 : ((LEN)+BYTES_PER_CELL-1)/BYTES_PER_CELL)
+/* Heap cells for a new byte buffer of len bytes */
+#define BYTES_CELLS(LEN) (1 + BYTES_DATA_WORDS(LEN) + 4)
+/* Heap cells for a new slice */
+#define BYTES_SLICE_CELLS 4
+
+typedef struct bytes_view_ bytes_view_t;
+struct bytes_view_ {
+  tagged_t data; /* '$bytes_data'/N term */
+  intmach_t off;
+  intmach_t len;
+};
+
+bool_t bytes_view(tagged_t t, bytes_view_t *v);
+void bytes_copy_out(bytes_view_t *v, intmach_t from, intmach_t n, unsigned char *dst);
+CFUN__PROTO(bytes_make, tagged_t, const unsigned char *src, intmach_t len);
+
+CBOOL__PROTO(prolog_bytes_from_codes);
+CBOOL__PROTO(prolog_bytes_to_codes);
+CBOOL__PROTO(prolog_bytes_sub);
+CBOOL__PROTO(prolog_bytes_concat);
+CBOOL__PROTO(prolog_bytes_search);
+CBOOL__PROTO(prolog_bytes_get);
+CBOOL__PROTO(prolog_bytes_compare);
+CBOOL__PROTO(prolog_bytes_read);
+CBOOL__PROTO(prolog_bytes_write);
+CBOOL__PROTO(prolog_bytes_read_file);
+
+#endif /* _CIAO_ENG_BYTES_H */
@@ -0,0 +1,556 @@
+/*
+ *  eng_digest.c
+ *
+ *  Message digests (MD5, SHA-1, SHA-256, XXH64) with streaming contexts
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+#include <ciao/io_basic.h> /* RUNE_VOID */
+#include <ciao/stream_basic.h>
+#include <ciao/eng_bytes.h>
+#include <ciao/eng_digest.h>
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+
+/* Use SHA extensions (SHA-NI) for SHA-256 when the CPU supports them */
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define DIGEST_SHA_NI 1
+#include <cpuid.h>
+#include <immintrin.h>
+#endif
+
+#define DIGEST_IO_CHUNK 65536
+
+#define ROTL32(X,N) (((X) << (N)) | ((X) >> (32-(N))))
+#define ROTR32(X,N) (((X) >> (N)) | ((X) << (32-(N))))
+#define ROTL64(X,N) (((X) << (N)) | ((X) >> (64-(N))))
+
+static inline uint32_t load_le32(const uint8_t *p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+static inline uint32_t load_be32(const uint8_t *p) {
+  return ((uint32_t)p[0] << 24) | ((uint32_t)p[1] << 16) | ((uint32_t)p[2] << 8) | (uint32_t)p[3];
+}
+static inline uint64_t load_le64(const uint8_t *p) {
+  return (uint64_t)load_le32(p) | ((uint64_t)load_le32(p + 4) << 32);
+}
+
+/* --------------------------------------------------------------------------- */
+/* MD5 (RFC 1321) */
+
+static const uint32_t md5_k[64] = {
+  0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+  0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+  0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+  0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+  0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+  0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+  0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+  0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391
+};
+
+static const uint8_t md5_r[64] = {
+  7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+  5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+  4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+  6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21
+};
+
+static void md5_compress(uint32_t h[4], const uint8_t *p, size_t nblocks) {
+  uint32_t m[16], a, b, c, d, f, t;
+  int i, g;
+  for (; nblocks > 0; nblocks--, p += 64) {
+    for (i = 0; i < 16; i++) m[i] = load_le32(p + 4*i);
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    for (i = 0; i < 64; i++) {
+      if (i < 16) { f = d ^ (b & (c ^ d)); g = i; }
+      else if (i < 32) { f = c ^ (d & (b ^ c)); g = (5*i + 1) & 15; }
+      else if (i < 48) { f = b ^ c ^ d; g = (3*i + 5) & 15; }
+      else { f = c ^ (b | ~d); g = (7*i) & 15; }
+      t = d; d = c; c = b;
+      b = b + ROTL32(a + f + md5_k[i] + m[g], md5_r[i]);
+      a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+  }
+}
+
+/* --------------------------------------------------------------------------- */
+/* SHA-1 (FIPS 180-4) */
+
+static void sha1_compress(uint32_t h[5], const uint8_t *p, size_t nblocks) {
+  uint32_t w[80], a, b, c, d, e, f, k, t;
+  int i;
+  for (; nblocks > 0; nblocks--, p += 64) {
+    for (i = 0; i < 16; i++) w[i] = load_be32(p + 4*i);
+    for (; i < 80; i++) w[i] = ROTL32(w[i-3] ^ w[i-8] ^ w[i-14] ^ w[i-16], 1);
+    a = h[0]; b = h[1]; c = h[2]; d = h[3]; e = h[4];
+    for (i = 0; i < 80; i++) {
+      if (i < 20) { f = d ^ (b & (c ^ d)); k = 0x5a827999; }
+      else if (i < 40) { f = b ^ c ^ d; k = 0x6ed9eba1; }
+      else if (i < 60) { f = (b & c) | (d & (b | c)); k = 0x8f1bbcdc; }
+      else { f = b ^ c ^ d; k = 0xca62c1d6; }
+      t = ROTL32(a, 5) + f + e + k + w[i];
+      e = d; d = c; c = ROTL32(b, 30); b = a; a = t;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d; h[4] += e;
+  }
+}
+
+/* --------------------------------------------------------------------------- */
+/* SHA-256 (FIPS 180-4) */
+
+static const uint32_t sha256_k[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2
+};
+
+static void sha256_compress_generic(uint32_t h[8], const uint8_t *p, size_t nblocks) {
+  uint32_t w[64], a, b, c, d, e, f, g, hh, t1, t2;
+  int i;
+  for (; nblocks > 0; nblocks--, p += 64) {
+    for (i = 0; i < 16; i++) w[i] = load_be32(p + 4*i);
+    for (; i < 64; i++) {
+      uint32_t s0 = ROTR32(w[i-15], 7) ^ ROTR32(w[i-15], 18) ^ (w[i-15] >> 3);
+      uint32_t s1 = ROTR32(w[i-2], 17) ^ ROTR32(w[i-2], 19) ^ (w[i-2] >> 10);
+      w[i] = w[i-16] + s0 + w[i-7] + s1;
+    }
+    a = h[0]; b = h[1]; c = h[2]; d = h[3];
+    e = h[4]; f = h[5]; g = h[6]; hh = h[7];
+    for (i = 0; i < 64; i++) {
+      t1 = hh + (ROTR32(e, 6) ^ ROTR32(e, 11) ^ ROTR32(e, 25)) + (g ^ (e & (f ^ g))) + sha256_k[i] + w[i];
+      t2 = (ROTR32(a, 2) ^ ROTR32(a, 13) ^ ROTR32(a, 22)) + ((a & b) | (c & (a | b)));
+      hh = g; g = f; f = e; e = d + t1;
+      d = c; c = b; b = a; a = t1 + t2;
+    }
+    h[0] += a; h[1] += b; h[2] += c; h[3] += d;
+    h[4] += e; h[5] += f; h[6] += g; h[7] += hh;
+  }
+}
+
+#if defined(DIGEST_SHA_NI)
+__attribute__((target("sha,sse4.1,ssse3")))
+static void sha256_compress_shani(uint32_t h[8], const uint8_t *p, size_t nblocks) {
+  __m128i state0, state1, msg, tmp, abef_save, cdgh_save;
+  __m128i m[4];
+  const __m128i mask = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+  int g;
+
+  tmp = _mm_loadu_si128((const __m128i *)&h[0]);
+  state1 = _mm_loadu_si128((const __m128i *)&h[4]);
+  tmp = _mm_shuffle_epi32(tmp, 0xB1); /* CDAB */
+  state1 = _mm_shuffle_epi32(state1, 0x1B); /* EFGH */
+  state0 = _mm_alignr_epi8(tmp, state1, 8); /* ABEF */
+  state1 = _mm_blend_epi16(state1, tmp, 0xF0); /* CDGH */
+
+  for (; nblocks > 0; nblocks--, p += 64) {
+    abef_save = state0;
+    cdgh_save = state1;
+    /* 16 groups of 4 rounds; m[g%4] holds the message words of group g */
+    for (g = 0; g < 16; g++) {
+      if (g < 4) m[g] = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i *)(p + 16*g)), mask);
+      msg = _mm_add_epi32(m[g&3], _mm_loadu_si128((const __m128i *)&sha256_k[4*g]));
+      state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+      if (g >= 3 && g <= 14) {
+        tmp = _mm_alignr_epi8(m[g&3], m[(g+3)&3], 4);
+        m[(g+1)&3] = _mm_add_epi32(m[(g+1)&3], tmp);
+        m[(g+1)&3] = _mm_sha256msg2_epu32(m[(g+1)&3], m[g&3]);
+      }
+      msg = _mm_shuffle_epi32(msg, 0x0E);
+      state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+      if (g >= 1 && g <= 12) {
+        m[(g+3)&3] = _mm_sha256msg1_epu32(m[(g+3)&3], m[g&3]);
+      }
+    }
+    state0 = _mm_add_epi32(state0, abef_save);
+    state1 = _mm_add_epi32(state1, cdgh_save);
+  }
+
+  tmp = _mm_shuffle_epi32(state0, 0x1B); /* FEBA */
+  state1 = _mm_shuffle_epi32(state1, 0xB1); /* DCHG */
+  state0 = _mm_blend_epi16(tmp, state1, 0xF0); /* DCBA */
+  state1 = _mm_alignr_epi8(state1, tmp, 8); /* ABEF */
+  _mm_storeu_si128((__m128i *)&h[0], state0);
+  _mm_storeu_si128((__m128i *)&h[4], state1);
+}
+
+static int sha_ni_available = -1; /* unknown */
+
+static bool_t check_sha_ni(void) {
+  unsigned int a, b, c, d;
+  if (sha_ni_available < 0) {
+    sha_ni_available = 0;
+    if (__get_cpuid(1, &a, &b, &c, &d) &&
+        (c & bit_SSSE3) && (c & bit_SSE4_1) &&
+        __get_cpuid_count(7, 0, &a, &b, &c, &d) &&
+        (b & (1 << 29))) { /* SHA */
+      sha_ni_available = 1;
+    }
+  }
+  return sha_ni_available;
+}
+#endif
+
+static void sha256_compress(uint32_t h[8], const uint8_t *p, size_t nblocks) {
+#if defined(DIGEST_SHA_NI)
+  if (check_sha_ni()) {
+    sha256_compress_shani(h, p, nblocks);
+    return;
+  }
+#endif
+  sha256_compress_generic(h, p, nblocks);
+}
+
+/* --------------------------------------------------------------------------- */
+/* XXH64 (non-cryptographic, seed 0) */
+
+#define XXH_P1 0x9E3779B185EBCA87ULL
+#define XXH_P2 0xC2B2AE3D27D4EB4FULL
+#define XXH_P3 0x165667B19E3779F9ULL
+#define XXH_P4 0x85EBCA77C2B2AE63ULL
+#define XXH_P5 0x27D4EB2F165667C5ULL
+
+static inline uint64_t xxh64_round(uint64_t acc, uint64_t input) {
+  acc += input * XXH_P2;
+  acc = ROTL64(acc, 31);
+  return acc * XXH_P1;
+}
+
+static inline uint64_t xxh64_merge(uint64_t acc, uint64_t val) {
+  acc ^= xxh64_round(0, val);
+  return acc * XXH_P1 + XXH_P4;
+}
+
+static void xxh64_compress(uint64_t v[4], const uint8_t *p, size_t nblocks) {
+  for (; nblocks > 0; nblocks--, p += 32) {
+    v[0] = xxh64_round(v[0], load_le64(p));
+    v[1] = xxh64_round(v[1], load_le64(p + 8));
+    v[2] = xxh64_round(v[2], load_le64(p + 16));
+    v[3] = xxh64_round(v[3], load_le64(p + 24));
+  }
+}
+
+static uint64_t xxh64_final(const digest_ctx_t *c) {
+  const uint64_t *v = c->h.h64;
+  const uint8_t *p = c->buf;
+  const uint8_t *end = c->buf + c->buflen;
+  uint64_t h;
+  if (c->total >= 32) {
+    h = ROTL64(v[0], 1) + ROTL64(v[1], 7) + ROTL64(v[2], 12) + ROTL64(v[3], 18);
+    h = xxh64_merge(h, v[0]);
+    h = xxh64_merge(h, v[1]);
+    h = xxh64_merge(h, v[2]);
+    h = xxh64_merge(h, v[3]);
+  } else {
+    h = XXH_P5;
+  }
+  h += c->total;
+  for (; p + 8 <= end; p += 8) {
+    h ^= xxh64_round(0, load_le64(p));
+    h = ROTL64(h, 27) * XXH_P1 + XXH_P4;
+  }
+  if (p + 4 <= end) {
+    h ^= (uint64_t)load_le32(p) * XXH_P1;
+    h = ROTL64(h, 23) * XXH_P2 + XXH_P3;
+    p += 4;
+  }
+  for (; p < end; p++) {
+    h ^= (*p) * XXH_P5;
+    h = ROTL64(h, 11) * XXH_P1;
+  }
+  h ^= h >> 33;
+  h *= XXH_P2;
+  h ^= h >> 29;
+  h *= XXH_P3;
+  h ^= h >> 32;
+  return h;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Streaming interface */
+
+static size_t digest_block_size(int alg) {
+  return alg == DIGEST_XXH64 ? 32 : 64;
+}
+
+static void digest_compress(digest_ctx_t *c, const uint8_t *p, size_t nblocks) {
+  switch (c->alg) {
+  case DIGEST_MD5: md5_compress(c->h.h32, p, nblocks); break;
+  case DIGEST_SHA1: sha1_compress(c->h.h32, p, nblocks); break;
+  case DIGEST_SHA256: sha256_compress(c->h.h32, p, nblocks); break;
+  case DIGEST_XXH64: xxh64_compress(c->h.h64, p, nblocks); break;
+  }
+}
+
+void digest_init(digest_ctx_t *c, int alg) {
+  memset(c, 0, sizeof(*c));
+  c->alg = alg;
+  switch (alg) {
+  case DIGEST_MD5:
+    c->h.h32[0] = 0x67452301; c->h.h32[1] = 0xefcdab89;
+    c->h.h32[2] = 0x98badcfe; c->h.h32[3] = 0x10325476;
+    break;
+  case DIGEST_SHA1:
+    c->h.h32[0] = 0x67452301; c->h.h32[1] = 0xefcdab89;
+    c->h.h32[2] = 0x98badcfe; c->h.h32[3] = 0x10325476;
+    c->h.h32[4] = 0xc3d2e1f0;
+    break;
+  case DIGEST_SHA256:
+    c->h.h32[0] = 0x6a09e667; c->h.h32[1] = 0xbb67ae85;
+    c->h.h32[2] = 0x3c6ef372; c->h.h32[3] = 0xa54ff53a;
+    c->h.h32[4] = 0x510e527f; c->h.h32[5] = 0x9b05688c;
+    c->h.h32[6] = 0x1f83d9ab; c->h.h32[7] = 0x5be0cd19;
+    break;
+  case DIGEST_XXH64:
+    c->h.h64[0] = XXH_P1 + XXH_P2;
+    c->h.h64[1] = XXH_P2;
+    c->h.h64[2] = 0;
+    c->h.h64[3] = -XXH_P1;
+    break;
+  }
+}
+
+void digest_update(digest_ctx_t *c, const uint8_t *p, size_t n) {
+  size_t bs = digest_block_size(c->alg);
+  size_t k;
+  c->total += n;
+  if (c->buflen > 0) {
+    k = bs - c->buflen;
+    if (k > n) k = n;
+    memcpy(c->buf + c->buflen, p, k);
+    c->buflen += k;
+    p += k;
+    n -= k;
+    if (c->buflen < bs) return;
+    digest_compress(c, c->buf, 1);
+    c->buflen = 0;
+  }
+  if (n >= bs) {
+    k = n / bs;
+    digest_compress(c, p, k);
+    p += k * bs;
+    n -= k * bs;
+  }
+  if (n > 0) {
+    memcpy(c->buf, p, n);
+    c->buflen = n;
+  }
+}
+
+size_t digest_final(const digest_ctx_t *c0, uint8_t *out) {
+  digest_ctx_t c = *c0;
+  uint8_t pad[72];
+  uint64_t bits;
+  size_t padlen;
+  int i;
+
+  if (c.alg == DIGEST_XXH64) {
+    uint64_t h = xxh64_final(&c);
+    for (i = 0; i < 8; i++) out[i] = (uint8_t)(h >> (56 - 8*i)); /* (canonical, big endian) */
+    return 8;
+  }
+
+  /* Merkle-Damgard padding: 0x80, zeros, length in bits */
+  bits = c.total << 3;
+  padlen = (c.buflen < 56 ? 56 : 120) - c.buflen;
+  memset(pad, 0, sizeof(pad));
+  pad[0] = 0x80;
+  for (i = 0; i < 8; i++) {
+    pad[padlen + i] = c.alg == DIGEST_MD5 ? (uint8_t)(bits >> (8*i))
+      : (uint8_t)(bits >> (56 - 8*i));
+  }
+  digest_update(&c, pad, padlen + 8);
+
+  switch (c.alg) {
+  case DIGEST_MD5:
+    for (i = 0; i < 16; i++) out[i] = (uint8_t)(c.h.h32[i>>2] >> (8*(i&3)));
+    return 16;
+  case DIGEST_SHA1:
+    for (i = 0; i < 20; i++) out[i] = (uint8_t)(c.h.h32[i>>2] >> (24 - 8*(i&3)));
+    return 20;
+  default: /* DIGEST_SHA256 */
+    for (i = 0; i < 32; i++) out[i] = (uint8_t)(c.h.h32[i>>2] >> (24 - 8*(i&3)));
+    return 32;
+  }
+}
+
+/* --------------------------------------------------------------------------- */
+/* Builtins. A context is a byte buffer (see eng_bytes.h) with a copy
+   of the digest_ctx_t structure, so that contexts are ordinary
+   (immutable) terms. */
+
+static bool_t get_digest_ctx(tagged_t t, digest_ctx_t *c) {
+  bytes_view_t v;
+  if (!bytes_view(t, &v) || v.len != sizeof(digest_ctx_t)) return FALSE;
+  bytes_copy_out(&v, 0, v.len, (unsigned char *)c);
+  return c->alg >= DIGEST_MD5 && c->alg <= DIGEST_XXH64 &&
+    c->buflen < digest_block_size(c->alg);
+}
+
+/* Unify X(I) with a new context term */
+#define DIGEST_CTX_RETURN(C, I, ARITY) { \
+  TEST_HEAP_OVERFLOW(G->heap_top, BYTES_CELLS(sizeof(digest_ctx_t))*sizeof(tagged_t)+CONTPAD, (ARITY)); \
+  CBOOL__LASTUNIFY(CFUN__EVAL(bytes_make, (const unsigned char *)(C), sizeof(digest_ctx_t)), X(I)); \
+}
+
+/* '$digest_init'(+Alg, -Ctx) */
+CBOOL__PROTO(prolog_digest_init) {
+  ERR__FUNCTOR("digest:digest_init", 2);
+  digest_ctx_t c;
+  tagged_t t;
+  char *name;
+  int alg;
+
+  DEREF(t, X(0));
+  if (!TaggedIsATM(t)) BUILTIN_ERROR(ERR_type_error(atom), X(0), 1);
+  name = GetString(t);
+  if (strcmp(name, "md5") == 0) alg = DIGEST_MD5;
+  else if (strcmp(name, "sha1") == 0) alg = DIGEST_SHA1;
+  else if (strcmp(name, "sha256") == 0) alg = DIGEST_SHA256;
+  else if (strcmp(name, "xxh64") == 0) alg = DIGEST_XXH64;
+  else BUILTIN_ERROR(ERR_domain_error(flag_value), X(0), 1);
+
+  digest_init(&c, alg);
+  DIGEST_CTX_RETURN(&c, 1, 2);
+}
+
+/* '$digest_update'(+Ctx0, +Data, -Ctx): Data is a byte buffer, a
+   list of bytes, or an atom */
+CBOOL__PROTO(prolog_digest_update) {
+  digest_ctx_t c;
+  bytes_view_t v;
+  tagged_t t, car;
+  intmach_t i, n;
+  uint8_t buf[4096];
+
+  CBOOL__TEST(get_digest_ctx(X(0), &c));
+  DEREF(t, X(1));
+  if (TaggedIsATM(t)) {
+    if (t != atom_nil) digest_update(&c, (uint8_t *)GetString(t), GetAtomLen(t));
+  } else if (TaggedIsLST(t)) {
+    n = 0;
+    while (t != atom_nil) {
+      CBOOL__TEST(TaggedIsLST(t));
+      DerefCar(car, t);
+      CBOOL__TEST(TaggedIsSmall(car) && car >= TaggedZero && car < MakeSmall(256));
+      buf[n++] = GetSmall(car);
+      if (n == sizeof(buf)) { digest_update(&c, buf, n); n = 0; }
+      DerefCdr(t, t);
+    }
+    digest_update(&c, buf, n);
+  } else {
+    CBOOL__TEST(bytes_view(t, &v));
+    for (i = 0; i < v.len; i += n) {
+      n = v.len - i < (intmach_t)sizeof(buf) ? v.len - i : (intmach_t)sizeof(buf);
+      bytes_copy_out(&v, i, n, buf);
+      digest_update(&c, buf, n);
+    }
+  }
+  DIGEST_CTX_RETURN(&c, 2, 3);
+}
+
+/* '$digest_update_stream'(+Ctx0, +Stream, -Ctx): consume the stream
+   until its end */
+CBOOL__PROTO(prolog_digest_update_stream) {
+  ERR__FUNCTOR("digest:digest_update_stream", 3);
+  digest_ctx_t c;
+  stream_node_t *s;
+  int errcode;
+  ssize_t n;
+  uint8_t *buf;
+
+  CBOOL__TEST(get_digest_ctx(X(0), &c));
+  s = stream_to_ptr_check(X(1), 'r', &errcode);
+  if (!s) BUILTIN_ERROR(errcode, X(1), 2);
+
+  if (s->pending_rune != RUNE_VOID) { /* (returned by peek) */
+    if (s->pending_rune >= 0) {
+      uint8_t b = s->pending_rune;
+      digest_update(&c, &b, 1);
+    }
+    s->pending_rune = RUNE_VOID;
+  }
+  buf = checkalloc_ARRAY(uint8_t, DIGEST_IO_CHUNK);
+  if (s->streammode != 's') { /* not a socket */
+    while ((n = fread(buf, 1, DIGEST_IO_CHUNK, s->streamfile)) > 0) {
+      digest_update(&c, buf, n);
+    }
+    n = ferror(s->streamfile) ? -1 : 0;
+  } else if (!s->socket_eof) { /* a socket */
+    for (;;) {
+      n = read(GetSmall(s->label), buf, DIGEST_IO_CHUNK);
+      if (n < 0 && errno == EINTR) continue;
+      if (n <= 0) break;
+      digest_update(&c, buf, n);
+    }
+    if (n == 0) s->socket_eof = TRUE;
+  } else {
+    n = 0;
+  }
+  checkdealloc_ARRAY(uint8_t, DIGEST_IO_CHUNK, buf);
+  if (n < 0) BUILTIN_ERROR(ERR_system_error, X(1), 2);
+  DIGEST_CTX_RETURN(&c, 2, 3);
+}
+
+/* '$digest_update_file'(+Ctx0, +Path, -Ctx) */
+CBOOL__PROTO(prolog_digest_update_file) {
+  ERR__FUNCTOR("digest:digest_update_file", 3);
+  digest_ctx_t c;
+  tagged_t t;
+  int fd;
+  ssize_t n;
+  uint8_t *buf;
+
+  CBOOL__TEST(get_digest_ctx(X(0), &c));
+  DEREF(t, X(1));
+  if (!TaggedIsATM(t)) BUILTIN_ERROR(ERR_type_error(atom), X(1), 2);
+  fd = open(GetString(t), O_RDONLY);
+  if (fd < 0) BUILTIN_ERROR(ERR_existence_error(source_sink), X(1), 2);
+#if defined(POSIX_FADV_SEQUENTIAL)
+  (void)posix_fadvise(fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+  buf = checkalloc_ARRAY(uint8_t, DIGEST_IO_CHUNK);
+  for (;;) {
+    n = read(fd, buf, DIGEST_IO_CHUNK);
+    if (n < 0 && errno == EINTR) continue;
+    if (n <= 0) break;
+    digest_update(&c, buf, n);
+  }
+  checkdealloc_ARRAY(uint8_t, DIGEST_IO_CHUNK, buf);
+  close(fd);
+  if (n < 0) BUILTIN_ERROR(ERR_system_error, X(1), 2);
+  DIGEST_CTX_RETURN(&c, 2, 3);
+}
+
+/* '$digest_final'(+Ctx, -Hex): digest as an atom of hexadecimal
+   digits (the context is not modified) */
+CBOOL__PROTO(prolog_digest_final) {
+  static const char hexdigits[] = "0123456789abcdef";
+  digest_ctx_t c;
+  uint8_t out[DIGEST_MAX_SIZE];
+  char hex[2*DIGEST_MAX_SIZE+1];
+  size_t i, n;
+
+  CBOOL__TEST(get_digest_ctx(X(0), &c));
+  n = digest_final(&c, out);
+  for (i = 0; i < n; i++) {
+    hex[2*i] = hexdigits[out[i] >> 4];
+    hex[2*i+1] = hexdigits[out[i] & 15];
+  }
+  hex[2*n] = '\0';
+  CBOOL__LASTUNIFY(GET_ATOM(hex), X(1));
+}
@@ -0,0 +1,45 @@
+/*
+ *  eng_digest.h
+ *
+ *  Message digests (MD5, SHA-1, SHA-256, XXH64) with streaming contexts
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_ENG_DIGEST_H
+#define _CIAO_ENG_DIGEST_H
+
+#include <ciao/eng.h>
+#include <stdint.h>
+
+#define DIGEST_MD5 0
+#define DIGEST_SHA1 1
+#define DIGEST_SHA256 2
+#define DIGEST_XXH64 3
+
+#define DIGEST_MAX_SIZE 32
+
+typedef struct digest_ctx_ digest_ctx_t;
+struct digest_ctx_ {
+  int32_t alg;
+  uint32_t buflen; /* pending bytes in buf */
+  uint64_t total; /* total bytes processed */
+  union {
+    uint32_t h32[8];
+    uint64_t h64[4];
+  } h;
+  uint8_t buf[64];
+};
+
+void digest_init(digest_ctx_t *c, int alg);
+void digest_update(digest_ctx_t *c, const uint8_t *p, size_t n);
+/* Returns the size of the digest (in bytes) */
+size_t digest_final(const digest_ctx_t *c, uint8_t *out);
+
+CBOOL__PROTO(prolog_digest_init);
+CBOOL__PROTO(prolog_digest_update);
+CBOOL__PROTO(prolog_digest_update_stream);
+CBOOL__PROTO(prolog_digest_update_file);
+CBOOL__PROTO(prolog_digest_final);
+
+#endif /* _CIAO_ENG_DIGEST_H */
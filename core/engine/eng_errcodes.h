@@ -60,6 +60,7 @@
 #define _type_err__predicate_indicator 10
 // #define _type_err__variable 11 // (deprecated, corr2, use uninstantiation)
 #define _type_err__callable 12
+#define _type_err__rational 13
 
 #define _domain_err(KEY) _domain_err__##KEY
 #define _domain_err__character_code_list 0 // TODO:[JF] not ISO, remove
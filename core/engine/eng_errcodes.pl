@@ -80,7 +80,8 @@ type_err(X) := ~'$keytable'(X, [
     case(number, 9),
     case(predicate_indicator, 10),
     % case(variable, 11), % (deprecated, corr2, use uninstantiation)
-    case(callable, 12)
+    case(callable, 12),
+    case(rational, 13)
 ]).
 
 :- pred domain_err/2 + lowentrymacrofuncons([iany], intmach, '_domain_err').
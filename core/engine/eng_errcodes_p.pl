@@ -76,6 +76,7 @@ type_code(9, number).
 type_code(10, predicate_indicator).
 % type_code(11, variable). % (deprecated, corr2, use uninstantiation)
 type_code(12, callable).
+type_code(13, rational).
 
 domain_code(0, character_code_list). % TODO:[JF] not ISO, remove
 domain_code(1, source_sink).
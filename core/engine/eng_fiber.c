@@ -0,0 +1,411 @@
+/*
+ *  eng_fiber.c
+ *
+ *  Fibers (coroutines with their own small worker)
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+#include <ciao/internals.h>
+#include <ciao/basiccontrol.h>
+#include <ciao/eng_fiber.h>
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+
+extern bcp_t call_code;
+extern bcp_t default_code;
+extern try_node_t defaultgoal_alt;
+extern try_node_t startgoal_alt;
+
+CBOOL__PROTO(prolog_copy_term); /* term_basic.c */
+
+try_node_t *address_nd_fiber_yield;
+
+static tagged_t functor_fiber = 0;
+
+static void fiber_init_atoms(void) {
+  if (functor_fiber == 0) {
+    functor_fiber = SetArity(GET_ATOM("$fiber"), 1);
+  }
+}
+
+/* --------------------------------------------------------------------------- */
+/* Table of fibers (indexed by identifier, entries of freed fibers are
+   NULL). The table (which moves when it grows), the pool of free
+   workers, and the state of the fibers are only accessed with
+   fiber_table_l held (fibers may be created and resumed from several
+   threads). */
+
+#define FIBER_NEW 0 /* not started yet */
+#define FIBER_SUSPENDED 1 /* stopped at '$fiber_yield'/2 */
+#define FIBER_RUNNING 2 /* running (or resuming other fiber) */
+#define FIBER_DONE 3 /* finished without yielding (its worker is unusable) */
+#define FIBER_BROKEN 4 /* (stopped without its yield choicepoint, not stored) */
+#define FIBER_COPYING 5 /* suspended, its result is being copied */
+
+typedef struct fiber_ fiber_t;
+struct fiber_ {
+  intmach_t id;
+  int state;
+  goal_descriptor_t *gd;
+};
+
+static fiber_t **fiber_table = NULL;
+static intmach_t fiber_table_size = 0;
+static intmach_t fiber_next_id = 1;
+SLOCK fiber_table_l;
+
+/* Fiber running in this thread (NULL if none) */
+#if defined(USE_THREADS)
+static __thread fiber_t *fiber_current = NULL;
+#else
+static fiber_t *fiber_current = NULL;
+#endif
+
+/* Goal descriptors (with their workers) of freed fibers, kept for
+   reuse up to FIBER_POOL_MAX */
+#define FIBER_POOL_MAX 64
+static goal_descriptor_t *fiber_pool[FIBER_POOL_MAX];
+static intmach_t fiber_pool_count = 0;
+
+static goal_descriptor_t *fiber_gd_new(void) {
+  goal_descriptor_t *gd;
+  worker_t *fw;
+
+  Wait_Acquire_slock(fiber_table_l);
+  if (fiber_pool_count > 0) {
+    gd = fiber_pool[--fiber_pool_count];
+    Release_slock(fiber_table_l);
+    return gd;
+  }
+  Release_slock(fiber_table_l);
+
+  /* (not in the goal descriptor list, it is never run by a thread) */
+  gd = checkalloc_TYPE(goal_descriptor_t);
+  gd->state = WORKING;
+  gd->goal_number = 0;
+  gd->thread_id = Thread_Id;
+  gd->thread_handle = (THREAD_T)NULL;
+  gd->action = NO_ACTION;
+  gd->goal = (tagged_t)NULL;
+  gd->time_slice = 0;
+  Init_slock(gd->goal_lock_l);
+
+  fw = create_wam_storage();
+  WITH_WORKER(fw, {
+    CVOID__CALL(create_wam_areas_sized,
+                FIBER_GLOBALSTKSIZE, FIBER_LOCALSTKSIZE,
+                FIBER_CHOICESTKSIZE, FIBER_TRAILSTKSIZE);
+    CVOID__CALL(local_init_each_time);
+  });
+  gd->worker_registers = fw;
+  fw->misc->goal_desc_ptr = gd;
+  return gd;
+}
+
+static void fiber_gd_free(goal_descriptor_t *gd) {
+  WITH_WORKER(gd->worker_registers, {
+    CVOID__CALL(local_init_each_time);
+  });
+  Wait_Acquire_slock(fiber_table_l);
+  if (fiber_pool_count < FIBER_POOL_MAX) {
+    fiber_pool[fiber_pool_count++] = gd;
+    Release_slock(fiber_table_l);
+    return;
+  }
+  Release_slock(fiber_table_l);
+  WITH_WORKER(gd->worker_registers, {
+#if defined(ANDPARALLEL) || defined(PARBACK)
+    w->misc->goal_desc_ptr = NULL;
+    CVOID__CALL(release_wam);
+#else
+    CVOID__CALL(destroy_wam);
+#endif
+  });
+  checkdealloc_TYPE(goal_descriptor_t, gd);
+}
+
+static fiber_t *fiber_new(void) {
+  fiber_t *f;
+
+  f = checkalloc_TYPE(fiber_t);
+  f->state = FIBER_NEW;
+  f->gd = fiber_gd_new();
+  Wait_Acquire_slock(fiber_table_l);
+  if (fiber_next_id >= fiber_table_size) {
+    intmach_t size = fiber_table_size == 0 ? 64 : fiber_table_size * 2;
+    fiber_table = fiber_table == NULL ?
+      checkalloc_ARRAY(fiber_t *, size) :
+      checkrealloc_ARRAY(fiber_t *, fiber_table_size, size, fiber_table);
+    memset(fiber_table + fiber_table_size, 0,
+           (size - fiber_table_size) * sizeof(fiber_t *));
+    fiber_table_size = size;
+  }
+  f->id = fiber_next_id++;
+  fiber_table[f->id] = f;
+  Release_slock(fiber_table_l);
+  return f;
+}
+
+/* Decode a fiber term (NULL if it is not well formed or the fiber has
+   been freed). Pre: fiber_table_l held */
+static fiber_t *fiber_get(tagged_t t) {
+  tagged_t id;
+  fiber_init_atoms();
+  DEREF(t, t);
+  if (!TaggedIsSTR(t) || TaggedToHeadfunctor(t) != functor_fiber) return NULL;
+  DerefArg(id, t, 1);
+  if (!TaggedIsSmall(id)) return NULL;
+  if (GetSmall(id) <= 0 || GetSmall(id) >= fiber_next_id) return NULL;
+  return fiber_table[GetSmall(id)];
+}
+
+/* Pre: 2 cells available in the heap */
+static CFUN__PROTO(fiber_term, tagged_t, fiber_t *f) {
+  tagged_t t;
+  fiber_init_atoms();
+  t = Tagp(STR, G->heap_top);
+  HeapPush(G->heap_top, functor_fiber);
+  HeapPush(G->heap_top, MakeSmall(f->id));
+  return t;
+}
+
+/* --------------------------------------------------------------------------- */
+
+/* '$fiber_new'(+Goal, -Fiber): a new fiber that will run (a copy of)
+   Goal (which must not fail, raise exceptions or leave choicepoints
+   when it ends; see '$fiber_yield'/2). */
+CBOOL__PROTO(prolog_fiber_new) {
+  fiber_t *f;
+  tagged_t goal;
+
+  TEST_HEAP_OVERFLOW(G->heap_top, 2*sizeof(tagged_t)+CONTPAD, 2);
+  DEREF(goal, X(0));
+  f = fiber_new();
+  /* (start with the current streams of the creator) */
+  *f->gd->worker_registers->streams = *w->streams;
+  CVOID__WITH_WORKER(f->gd->worker_registers, {
+    choice_t *b;
+    tagged_t *pt;
+    goal = CFUN__EVAL(cross_copy_term, goal);
+    /* (will be the arg. of a call/1, like in ciao_query_begin_term_s()) */
+    pt = G->heap_top;
+    HeapPush(pt, SetArity(GET_ATOM("hiord_rt:call"), 1));
+    HeapPush(pt, goal);
+    X(0) = Tagp(STR, G->heap_top);
+    G->heap_top = pt;
+
+    /* push null choice */
+    G->next_insn = default_code;
+    CODE_CHOICE_NEW(b, &defaultgoal_alt);
+    CODE_NECK_TRY(b);
+    SetDeep();
+
+    /* push choice for starting goal */
+    G->next_insn = call_code;
+    CODE_CHOICE_NEW(b, &startgoal_alt);
+    CODE_NECK_TRY(b);
+    SetDeep();
+  });
+  CBOOL__LASTUNIFY(CFUN__EVAL(fiber_term, f), X(1));
+}
+
+/* '$fiber_resume'(+Fiber, +In): continue the execution of Fiber (a
+   copy of In is the value of the second argument of the
+   '$fiber_yield'/2 call that suspended it) until it yields again.
+   Fails if the fiber is running or cannot continue. */
+CBOOL__PROTO(prolog_fiber_resume) {
+  fiber_t *f, *caller;
+  goal_descriptor_t *gd;
+  tagged_t in;
+  bool_t resumed;
+  int state;
+
+  Wait_Acquire_slock(fiber_table_l);
+  f = fiber_get(X(0));
+  if (f == NULL || (f->state != FIBER_NEW && f->state != FIBER_SUSPENDED)) {
+    Release_slock(fiber_table_l);
+    CBOOL__FAIL;
+  }
+  resumed = f->state == FIBER_SUSPENDED;
+  f->state = FIBER_RUNNING;
+  Release_slock(fiber_table_l);
+  DEREF(in, X(1));
+  gd = f->gd;
+  CVOID__WITH_WORKER(gd->worker_registers, {
+    if (resumed) {
+      /* w->choice is the choicepoint pushed by '$fiber_yield'/2; keep
+         the copy of In above its heap top */
+      w->choice->x[2] = CFUN__EVAL(cross_copy_term, in);
+      w->choice->heap_top = G->heap_top;
+      Stop_This_Goal(w) = FALSE;
+      SetSuspendedGoal(w, FALSE);
+      UnsetEvent();
+    }
+    gd->action = BACKTRACKING | KEEP_STACKS;
+  });
+
+  caller = fiber_current;
+  fiber_current = f;
+  CVOID__WITH_WORKER(gd->worker_registers, {
+    CVOID__CALL(wam, gd);
+    /* (the choicepoint of '$fiber_yield'/2 may have been cut before
+       the fiber stopped, then it cannot continue) */
+    state = IsSuspendedGoal(w) ? FIBER_SUSPENDED : FIBER_DONE;
+    if (state == FIBER_SUSPENDED &&
+        w->choice->next_alt != address_nd_fiber_yield) state = FIBER_BROKEN;
+  });
+  fiber_current = caller;
+  Wait_Acquire_slock(fiber_table_l);
+  f->state = state == FIBER_BROKEN ? FIBER_DONE : state;
+  Release_slock(fiber_table_l);
+  CBOOL__LASTTEST(state != FIBER_BROKEN);
+}
+
+/* '$fiber_result'(+Fiber, ?Out): Out is (a copy of) the first
+   argument of the '$fiber_yield'/2 call that suspended Fiber. Fails
+   if the fiber is not suspended. */
+CBOOL__PROTO(prolog_fiber_result) {
+  fiber_t *f;
+  bool_t ok;
+
+  Wait_Acquire_slock(fiber_table_l);
+  f = fiber_get(X(0));
+  if (f == NULL || f->state != FIBER_SUSPENDED) {
+    Release_slock(fiber_table_l);
+    CBOOL__FAIL;
+  }
+  /* (the copy binds variables of the fiber heap for a while, and may
+     need a GC, so it is not done with fiber_table_l held; the fiber
+     cannot be resumed or freed meanwhile) */
+  f->state = FIBER_COPYING;
+  X(0) = f->gd->worker_registers->choice->x[0];
+  Release_slock(fiber_table_l);
+  /* (copy X(0) from the fiber heap and unify with X(1)) */
+  ok = CBOOL__SUCCEED(prolog_copy_term);
+  Wait_Acquire_slock(fiber_table_l);
+  f->state = FIBER_SUSPENDED;
+  Release_slock(fiber_table_l);
+  CBOOL__LASTTEST(ok);
+}
+
+/* '$fiber_yield'(+Out, ?In): suspend the current fiber, returning
+   Out to the resumer, and unify In with the value passed on resume.
+   Fails if not called from a fiber.
+
+   The fiber actually stops on the next predicate call (through the
+   event mechanism), so the call to '$fiber_yield'/2 must be directly
+   followed by a predicate call: a cut in between would remove the
+   choicepoint that continues the fiber. That is detected when the
+   fiber stops: '$fiber_resume'/2 fails and the fiber cannot be
+   resumed again. */
+CBOOL__PROTO(prolog_fiber_yield) {
+  goal_descriptor_t *ctx = w->misc->goal_desc_ptr;
+
+  CBOOL__TEST(fiber_current != NULL && fiber_current->gd == ctx);
+  X(2) = atom_nil; /* (replaced on resume) */
+  CVOID__CALL(push_choicept, address_nd_fiber_yield);
+  Stop_This_Goal(w) = TRUE;
+  SetEvent();
+  SetSuspendedGoal(w, TRUE);
+  ctx->action = BACKTRACKING | KEEP_STACKS; // continue on alternative
+  CBOOL__PROCEED;
+}
+
+CBOOL__PROTO(nd_fiber_yield) {
+  CVOID__CALL(pop_choicept);
+  CBOOL__LASTUNIFY(X(1), X(2));
+}
+
+/* '$fiber_self'(?Fiber): Fiber is the current fiber (fails if none) */
+CBOOL__PROTO(prolog_fiber_self) {
+  CBOOL__TEST(fiber_current != NULL &&
+              fiber_current->gd == w->misc->goal_desc_ptr);
+  TEST_HEAP_OVERFLOW(G->heap_top, 2*sizeof(tagged_t)+CONTPAD, 1);
+  CBOOL__LASTUNIFY(CFUN__EVAL(fiber_term, fiber_current), X(0));
+}
+
+/* '$fiber_free'(+Fiber): release a fiber that is not running */
+CBOOL__PROTO(prolog_fiber_free) {
+  fiber_t *f;
+
+  Wait_Acquire_slock(fiber_table_l);
+  f = fiber_get(X(0));
+  if (f == NULL || f->state == FIBER_RUNNING || f->state == FIBER_COPYING) {
+    Release_slock(fiber_table_l);
+    CBOOL__FAIL;
+  }
+  fiber_table[f->id] = NULL;
+  Release_slock(fiber_table_l);
+  fiber_gd_free(f->gd);
+  checkdealloc_TYPE(fiber_t, f);
+  CBOOL__PROCEED;
+}
+
+/* --------------------------------------------------------------------------- */
+/* I/O readiness */
+
+/* '$fiber_poll'(+Waits, +Timeout, -Ready): wait (at most Timeout
+   milliseconds, forever if negative) until some of the Fd-Mode
+   elements of the list Waits (Mode is read or write) is ready, and
+   return the ready elements in Ready (in the same order). Errors and
+   hang-ups count as ready. */
+CBOOL__PROTO(prolog_fiber_poll) {
+  tagged_t l, car, fd, mode, t;
+  tagged_t atom_read = GET_ATOM("read");
+  tagged_t atom_write = GET_ATOM("write");
+  struct pollfd *fds;
+  tagged_t *elems;
+  intmach_t n, i, timeout;
+  int res;
+
+  DEREF(t, X(1));
+  CBOOL__TEST(TaggedIsSmall(t));
+  timeout = GetSmall(t);
+  /* Check the list and get its length */
+  n = 0;
+  DEREF(l, X(0));
+  while (l != atom_nil) {
+    CBOOL__TEST(TaggedIsLST(l));
+    DerefCar(car, l);
+    CBOOL__TEST(TaggedIsSTR(car) && TaggedToHeadfunctor(car) == functor_minus);
+    DerefArg(fd, car, 1);
+    DerefArg(mode, car, 2);
+    CBOOL__TEST(TaggedIsSmall(fd) && (mode == atom_read || mode == atom_write));
+    DerefCdr(l, l);
+    n++;
+  }
+  TEST_HEAP_OVERFLOW(G->heap_top, n*LSTCELLS*sizeof(tagged_t)+CONTPAD, 3);
+
+  fds = checkalloc_ARRAY(struct pollfd, n == 0 ? 1 : n);
+  elems = checkalloc_ARRAY(tagged_t, n == 0 ? 1 : n);
+  DEREF(l, X(0));
+  for (i = 0; i < n; i++) {
+    DerefCar(car, l);
+    elems[i] = car;
+    DerefArg(fd, car, 1);
+    DerefArg(mode, car, 2);
+    fds[i].fd = GetSmall(fd);
+    fds[i].events = mode == atom_read ? POLLIN : POLLOUT;
+    fds[i].revents = 0;
+    DerefCdr(l, l);
+  }
+  res = poll(fds, n, timeout < 0 ? -1 : timeout);
+
+  /* Build the list of ready elements (from the end) */
+  t = atom_nil;
+  if (res > 0) {
+    for (i = n - 1; i >= 0; i--) {
+      if (fds[i].revents != 0) MakeLST(t, elems[i], t);
+    }
+  }
+  checkdealloc_ARRAY(tagged_t, n == 0 ? 1 : n, elems);
+  checkdealloc_ARRAY(struct pollfd, n == 0 ? 1 : n, fds);
+  CBOOL__TEST(res >= 0 || errno == EINTR);
+  CBOOL__LASTUNIFY(t, X(2));
+}
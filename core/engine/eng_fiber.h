@@ -0,0 +1,48 @@
+/*
+ *  eng_fiber.h
+ *
+ *  Fibers (coroutines with their own small worker)
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_ENG_FIBER_H
+#define _CIAO_ENG_FIBER_H
+
+#include <ciao/eng.h>
+
+/* A fiber runs a goal in its own worker (with small initial areas,
+   which grow on demand like any other). Switching to a fiber is a
+   nested run of the abstract machine on the worker of the fiber, on
+   the same OS thread, that continues where the fiber was suspended
+   (by '$fiber_yield'/2, with the Stop_This_Goal/SetSuspendedGoal
+   mechanism of '$yield'/0). Terms are exchanged by copying them
+   between the heaps.
+
+   A fiber is referenced from Prolog by the term '$fiber'(Id).
+   Identifiers are never reused, so that stale references are
+   detected. */
+
+/* Initial sizes (in cells) of the areas of a fiber worker (enough for
+   the overflow pads, see CALLPAD, STACKPAD and CHOICEPAD). With the
+   worker structures, a fiber takes about 60KB (56KB of areas on
+   64-bit machines), so 100k fibers take about 6GB. Going much lower
+   needs smaller pads (CALLPAD alone is 2*STATICMAXATOM cells). */
+#define FIBER_GLOBALSTKSIZE (4*kCells)
+#define FIBER_LOCALSTKSIZE (1*kCells)
+#define FIBER_CHOICESTKSIZE (1*kCells)
+#define FIBER_TRAILSTKSIZE (1*kCells)
+
+extern try_node_t *address_nd_fiber_yield;
+extern SLOCK fiber_table_l;
+
+CBOOL__PROTO(prolog_fiber_new);
+CBOOL__PROTO(prolog_fiber_resume);
+CBOOL__PROTO(prolog_fiber_result);
+CBOOL__PROTO(prolog_fiber_yield);
+CBOOL__PROTO(nd_fiber_yield);
+CBOOL__PROTO(prolog_fiber_self);
+CBOOL__PROTO(prolog_fiber_free);
+CBOOL__PROTO(prolog_fiber_poll);
+
+#endif /* _CIAO_ENG_FIBER_H */
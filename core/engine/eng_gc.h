@@ -120,14 +120,18 @@ CVOID__PROTO(stack_overflow_adjust_wam, intmach_t reloc_factor);
 #define SAVE_XS0() {}
 #define SAVE_XS1(V0) { X(idx_)=V0; }
 #define SAVE_XS2(V0,V1) { X(idx_)=V0; X(idx_+1)=V1; }
+#define SAVE_XS3(V0,V1,V2) { X(idx_)=V0; X(idx_+1)=V1; X(idx_+2)=V2; }
 #define RESTORE_XS0() {}
 #define RESTORE_XS1(V0) { V0=X(idx_); }
 #define RESTORE_XS2(V0,V1) { V0=X(idx_); V1=X(idx_+1); }
+#define RESTORE_XS3(V0,V1,V2) { V0=X(idx_); V1=X(idx_+1); V2=X(idx_+2); }
 
 #define SAVE_YS1(V0) { frame_t *a=G->frame; a->x[0]=TaggedZero; a->x[1]=V0; }
 #define SAVE_YS2(V0,V1) { frame_t *a=G->frame; a->x[0]=TaggedZero; a->x[1]=V0; a->x[2]=V1; }
 #define RESTORE_YS1(V0) { frame_t *a=G->frame; V0=a->x[1]; }
+#define SAVE_YS3(V0,V1,V2) { frame_t *a=G->frame; a->x[0]=TaggedZero; a->x[1]=V0; a->x[2]=V1; a->x[3]=V2; }
 #define RESTORE_YS2(V0,V1) { frame_t *a=G->frame; V0=a->x[1]; V1=a->x[2]; }
+#define RESTORE_YS3(V0,V1,V2) { frame_t *a=G->frame; V0=a->x[1]; V1=a->x[2]; V2=a->x[3]; }
 
 #if defined(CONTCODE) /* TODO: always? */
 static inline CVOID__PROTO(push_gc_frame, intmach_t i) {
@@ -151,9 +155,11 @@ static inline CVOID__PROTO(pop_gc_frame) {
 #define PUSH_GC0() {}
 #define PUSH_GC1(V0) ({ CVOID__CALL(push_gc_frame,1); SAVE_YS1(V0); })
 #define PUSH_GC2(V0,V1) ({ CVOID__CALL(push_gc_frame,2); SAVE_YS2(V0,V1); })
+#define PUSH_GC3(V0,V1,V2) ({ CVOID__CALL(push_gc_frame,3); SAVE_YS3(V0,V1,V2); })
 #define POP_GC0() {}
 #define POP_GC1(V0) ({ RESTORE_YS1(V0); CVOID__CALL(pop_gc_frame); })
 #define POP_GC2(V0,V1) ({ RESTORE_YS2(V0,V1); CVOID__CALL(pop_gc_frame); })
+#define POP_GC3(V0,V1,V2) ({ RESTORE_YS3(V0,V1,V2); CVOID__CALL(pop_gc_frame); })
 
 /* --------------------------------------------------------------------------- */
 
@@ -0,0 +1,480 @@
+/*
+ *  eng_jit.c
+ *
+ *  Native code for hot predicates (see library(jit))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+#include <ciao/internals.h>
+#include <ciao/eng_jit.h>
+#include <string.h>
+
+#if defined(FOREIGN_FILES) && !defined(_WIN32) && !defined(_WIN64)
+#include <dlfcn.h>
+#define JIT_DLOPEN 1
+#endif
+
+/* The queue of hot predicates, the units, and the shared objects
+   compiled ahead of time are shared by all the workers, and only
+   modified with jit_l held. Predicates are not looked up with jit_l
+   held (insert_definition() takes prolog_predicates_l).
+
+   jit_call() reads the native code of a predicate without jit_l, so
+   a jit_native_t that is replaced or removed may still be in use by
+   other workers: it is retired (see jit_native_retire()) instead of
+   freed. */
+SLOCK jit_l;
+
+/* --------------------------------------------------------------------------- */
+/* Hot predicates */
+
+/* Queue of candidates that reached zero (see '$jit_hot'/1) */
+static definition_t **jit_queue = NULL;
+static intmach_t jit_queue_count = 0;
+static intmach_t jit_queue_size = 0;
+
+CVOID__PROTO(jit_hot, definition_t *f) {
+  Wait_Acquire_slock(jit_l);
+  if (jit_queue_count == jit_queue_size) {
+    intmach_t size = jit_queue_size == 0 ? 16 : jit_queue_size * 2;
+    jit_queue = jit_queue == NULL ?
+      checkalloc_ARRAY(definition_t *, size) :
+      checkrealloc_ARRAY(definition_t *, jit_queue_size, size, jit_queue);
+    jit_queue_size = size;
+  }
+  jit_queue[jit_queue_count++] = f;
+  Release_slock(jit_l);
+  Jit_Request(w) = TRUE;
+  SetEvent();
+}
+
+/* A compiled predicate (NULL if not found) */
+static definition_t *jit_predicate(tagged_t name, intmach_t arity) {
+  definition_t *f;
+
+  f = insert_definition(predicates_location, name, arity, FALSE);
+  if (f == NULL || f->predtyp > ENTER_FASTCODE_INDEXED ||
+      f->predtyp == ENTER_PROFILEDCODE ||
+      f->predtyp == ENTER_PROFILEDCODE_INDEXED) {
+    return NULL;
+  }
+  return f;
+}
+
+/* A compiled predicate from 'Module:Name'/Arity (NULL if not found) */
+static definition_t *jit_definition(tagged_t spec) {
+  tagged_t name, arity;
+
+  DEREF(spec, spec);
+  if (!TaggedIsSTR(spec) || TaggedToHeadfunctor(spec) != functor_slash) {
+    return NULL;
+  }
+  DerefArg(name, spec, 1);
+  DerefArg(arity, spec, 2);
+  if (!TaggedIsATM(name) || !TaggedIsSmall(arity)) return NULL;
+  return jit_predicate(name, GetSmall(arity));
+}
+
+/* '$jit_candidate'(+Spec, +Calls): count down Calls calls of the
+   predicate Spec before it is hot (never if 0) */
+CBOOL__PROTO(prolog_jit_candidate) {
+  definition_t *f;
+  tagged_t calls;
+
+  f = jit_definition(X(0));
+  DEREF(calls, X(1));
+  CBOOL__TEST(f != NULL && TaggedIsSmall(calls) && GetSmall(calls) >= 0);
+  f->code.incoreinfo->jit_countdown = GetSmall(calls);
+  CBOOL__PROCEED;
+}
+
+/* '$jit_hot'(-Specs): take the queue of hot predicates */
+CBOOL__PROTO(prolog_jit_hot) {
+  tagged_t list, spec;
+  definition_t **queue;
+  intmach_t count, size, i;
+
+  /* (take the queue, the heap may need to grow) */
+  Wait_Acquire_slock(jit_l);
+  queue = jit_queue;
+  count = jit_queue_count;
+  size = jit_queue_size;
+  jit_queue = NULL;
+  jit_queue_count = 0;
+  jit_queue_size = 0;
+  Release_slock(jit_l);
+
+  TEST_HEAP_OVERFLOW(G->heap_top, count*5*sizeof(tagged_t)+CONTPAD, 1);
+  list = atom_nil;
+  for (i = count - 1; i >= 0; i--) {
+    definition_t *f = queue[i];
+    spec = Tagp(STR, G->heap_top);
+    HeapPush(G->heap_top, functor_slash);
+    HeapPush(G->heap_top, FuncName(f));
+    HeapPush(G->heap_top, MakeSmall(FuncArity(f)));
+    MakeLST(list, spec, list);
+  }
+  if (queue != NULL) checkdealloc_ARRAY(definition_t *, size, queue);
+  CBOOL__LASTUNIFY(list, X(0));
+}
+
+/* --------------------------------------------------------------------------- */
+/* Units */
+
+static jit_unit_t *jit_units = NULL;
+
+/* Shared objects compiled ahead of time, by module */
+struct jit_aot_ {
+  jit_aot_t *next;
+  char *module;
+  char *stamp; /* (of the source, see jit_c:jit_src_stamp/2) */
+  void (*init)(void);
+  intmach_t count;
+  jit_entry_t *entries;
+  jit_unit_t *unit; /* (NULL if not installed) */
+};
+
+static jit_aot_t *jit_aots = NULL;
+
+/* Retired native code. It is kept (as the shared objects), since no
+   point is known at which other workers are not running it. */
+static jit_native_t *jit_retired = NULL;
+
+/* (with jit_l held) */
+static void jit_native_retire(jit_native_t *n) {
+  n->retired = jit_retired;
+  jit_retired = n;
+}
+
+static bool_t jit_unit_has(jit_unit_t *u, definition_t *f) {
+  intmach_t i;
+  for (i = 0; i < u->count; i++) {
+    if (u->preds[i] == f) return TRUE;
+  }
+  return FALSE;
+}
+
+/* Back to bytecode for the predicates entered through the unit */
+static void jit_unit_free(jit_unit_t *u) {
+  intmach_t i;
+  for (i = 0; i < u->count; i++) {
+    definition_t *f = u->preds[i];
+    incore_info_t *d = f->code.incoreinfo;
+    jit_native_t *n = d->jit;
+    if (n != NULL && n->unit == u) {
+      SetEnterInstr(f, f->predtyp - ENTER_FASTCODE + ENTER_COMPACTCODE);
+      d->jit = NULL;
+      jit_native_retire(n);
+    }
+  }
+  if (u->aot != NULL) u->aot->unit = NULL;
+  checkdealloc_ARRAY(definition_t *, u->count, u->preds);
+  checkdealloc_TYPE(jit_unit_t, u);
+}
+
+/* Enter the predicates preds through procs (takes preds, with jit_l
+   held) */
+static jit_unit_t *jit_unit_new(void *handle, intmach_t count,
+                                definition_t **preds, jit_proc_t *procs) {
+  jit_unit_t *u;
+  intmach_t i;
+
+  u = checkalloc_TYPE(jit_unit_t);
+  u->handle = handle;
+  u->aot = NULL;
+  u->count = count;
+  u->preds = preds;
+  for (i = 0; i < count; i++) {
+    definition_t *f = preds[i];
+    incore_info_t *d = f->code.incoreinfo;
+    jit_native_t *n = checkalloc_TYPE(jit_native_t);
+    n->proc = procs[i];
+    n->unit = u;
+    n->bails = 0;
+    n->retired = NULL;
+    if (d->jit != NULL) jit_native_retire(d->jit);
+    d->jit = n;
+    if (f->predtyp < ENTER_FASTCODE) {
+      SetEnterInstr(f, f->predtyp - ENTER_COMPACTCODE + ENTER_FASTCODE);
+    }
+  }
+  u->next = jit_units;
+  jit_units = u;
+  return u;
+}
+
+/* (with jit_l held) */
+static void jit_unit_remove(jit_unit_t *u) {
+  jit_unit_t **p = &jit_units;
+  while (*p != u) p = &(*p)->next;
+  *p = u->next;
+  jit_unit_free(u);
+}
+
+/* Remove the units that contain code of f (which is being redefined) */
+void jit_deopt(definition_t *f) {
+  jit_unit_t **p;
+  Wait_Acquire_slock(jit_l);
+  p = &jit_units;
+  while (*p != NULL) {
+    jit_unit_t *u = *p;
+    if (jit_unit_has(u, f)) {
+      *p = u->next;
+      jit_unit_free(u);
+    } else {
+      p = &u->next;
+    }
+  }
+  Release_slock(jit_l);
+}
+
+/* '$jit_install'(+File, +Init, +Entries): load the shared object File,
+   call its function Init, and enter each predicate Spec of the list
+   Entries of Spec-Symbol through the function Symbol */
+CBOOL__PROTO(prolog_jit_install) {
+#if defined(JIT_DLOPEN)
+  tagged_t file, init, l, t, spec, sym;
+  void *handle;
+  void (*init_fn)(void);
+  intmach_t count, i;
+  definition_t **preds;
+  jit_proc_t *procs;
+
+  DEREF(file, X(0));
+  DEREF(init, X(1));
+  CBOOL__TEST(TaggedIsATM(file) && TaggedIsATM(init));
+  /* Check the entries */
+  count = 0;
+  DEREF(l, X(2));
+  while (TaggedIsLST(l)) {
+    DerefCar(t, l);
+    CBOOL__TEST(TaggedIsSTR(t) && TaggedToHeadfunctor(t) == functor_minus);
+    DerefArg(spec, t, 1);
+    DerefArg(sym, t, 2);
+    CBOOL__TEST(jit_definition(spec) != NULL && TaggedIsATM(sym));
+    count++;
+    DerefCdr(l, l);
+  }
+  CBOOL__TEST(l == atom_nil && count > 0);
+
+  handle = dlopen(GetString(file), RTLD_NOW | RTLD_LOCAL);
+  CBOOL__TEST(handle != NULL);
+  init_fn = (void (*)(void))dlsym(handle, GetString(init));
+  if (init_fn == NULL) goto error;
+  preds = checkalloc_ARRAY(definition_t *, count);
+  procs = checkalloc_ARRAY(jit_proc_t, count);
+  DEREF(l, X(2));
+  for (i = 0; i < count; i++) {
+    DerefCar(t, l);
+    DerefArg(spec, t, 1);
+    DerefArg(sym, t, 2);
+    preds[i] = jit_definition(spec);
+    procs[i] = (jit_proc_t)dlsym(handle, GetString(sym));
+    if (procs[i] == NULL) {
+      checkdealloc_ARRAY(definition_t *, count, preds);
+      checkdealloc_ARRAY(jit_proc_t, count, procs);
+      goto error;
+    }
+    DerefCdr(l, l);
+  }
+  (*init_fn)();
+  Wait_Acquire_slock(jit_l);
+  (void)jit_unit_new(handle, count, preds, procs);
+  Release_slock(jit_l);
+  checkdealloc_ARRAY(jit_proc_t, count, procs);
+  CBOOL__PROCEED;
+ error:
+  dlclose(handle);
+  CBOOL__FAIL;
+#else
+  CBOOL__FAIL;
+#endif
+}
+
+/* '$jit_uninstall'(+Spec): back to bytecode for the predicate (and
+   the rest of its units) */
+CBOOL__PROTO(prolog_jit_uninstall) {
+  definition_t *f = jit_definition(X(0));
+  CBOOL__TEST(f != NULL);
+  jit_deopt(f);
+  CBOOL__PROCEED;
+}
+
+/* '$jit_native'(+Spec): the predicate is entered through native code */
+CBOOL__PROTO(prolog_jit_native) {
+  definition_t *f = jit_definition(X(0));
+  CBOOL__TEST(f != NULL && f->code.incoreinfo->jit != NULL);
+  CBOOL__PROCEED;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Ahead of time */
+
+static jit_aot_t **jit_aot_find(char *module) {
+  jit_aot_t **p = &jit_aots;
+  while (*p != NULL && strcmp((*p)->module, module) != 0) p = &(*p)->next;
+  return p;
+}
+
+/* (with jit_l held) */
+static void jit_aot_remove(char *module) {
+  jit_aot_t **p = jit_aot_find(module);
+  jit_aot_t *a = *p;
+  if (a == NULL) return;
+  if (a->unit != NULL) jit_unit_remove(a->unit);
+  *p = a->next;
+  checkdealloc_TYPE(jit_aot_t, a);
+}
+
+void jit_aot_register(char *module, char *stamp, void (*init)(void),
+                      intmach_t count, jit_entry_t *entries) {
+  jit_aot_t *a;
+
+  Wait_Acquire_slock(jit_l);
+  jit_aot_remove(module);
+  a = checkalloc_TYPE(jit_aot_t);
+  a->module = module;
+  a->stamp = stamp;
+  a->init = init;
+  a->count = count;
+  a->entries = entries;
+  a->unit = NULL;
+  a->next = jit_aots;
+  jit_aots = a;
+  Release_slock(jit_l);
+}
+
+/* (before the shared object is unloaded) */
+void jit_aot_unregister(char *module) {
+  Wait_Acquire_slock(jit_l);
+  jit_aot_remove(module);
+  Release_slock(jit_l);
+}
+
+/* '$jit_aot_stamp'(+Module, -Stamp): native code was registered for
+   Module, with the Stamp of its source */
+CBOOL__PROTO(prolog_jit_aot_stamp) {
+  tagged_t module;
+  jit_aot_t *a;
+  char *stamp;
+
+  DEREF(module, X(0));
+  CBOOL__TEST(TaggedIsATM(module));
+  Wait_Acquire_slock(jit_l);
+  a = *jit_aot_find(GetString(module));
+  stamp = a == NULL ? NULL : a->stamp;
+  Release_slock(jit_l);
+  CBOOL__TEST(stamp != NULL);
+  CBOOL__LASTUNIFY(GET_ATOM(stamp), X(1));
+}
+
+/* '$jit_aot_install'(+Module): enter the predicates of Module through
+   the native code registered for it */
+CBOOL__PROTO(prolog_jit_aot_install) {
+  tagged_t module;
+  jit_aot_t *a;
+  void (*init)(void);
+  intmach_t count;
+  jit_entry_t *entries;
+  definition_t **preds;
+  jit_proc_t *procs;
+  intmach_t i;
+
+  DEREF(module, X(0));
+  CBOOL__TEST(TaggedIsATM(module));
+  Wait_Acquire_slock(jit_l);
+  a = *jit_aot_find(GetString(module));
+  if (a == NULL) {
+    Release_slock(jit_l);
+    CBOOL__FAIL;
+  }
+  init = a->init;
+  count = a->count;
+  entries = a->entries;
+  Release_slock(jit_l);
+  preds = checkalloc_ARRAY(definition_t *, count);
+  for (i = 0; i < count; i++) {
+    preds[i] = jit_predicate(GET_ATOM(entries[i].name), entries[i].arity);
+    if (preds[i] == NULL) {
+      checkdealloc_ARRAY(definition_t *, count, preds);
+      CBOOL__FAIL;
+    }
+  }
+  (*init)();
+  procs = checkalloc_ARRAY(jit_proc_t, count);
+  for (i = 0; i < count; i++) procs[i] = entries[i].proc;
+  Wait_Acquire_slock(jit_l);
+  /* (unless registered again meanwhile) */
+  a = *jit_aot_find(GetString(module));
+  if (a == NULL || a->entries != entries) {
+    Release_slock(jit_l);
+    checkdealloc_ARRAY(definition_t *, count, preds);
+    checkdealloc_ARRAY(jit_proc_t, count, procs);
+    CBOOL__FAIL;
+  }
+  if (a->unit != NULL) jit_unit_remove(a->unit);
+  a->unit = jit_unit_new(NULL, count, preds, procs);
+  a->unit->aot = a;
+  Release_slock(jit_l);
+  checkdealloc_ARRAY(jit_proc_t, count, procs);
+  CBOOL__PROCEED;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Calls to native code */
+
+/* Call the native code of f with its arguments in X(0)...; return
+   JIT_OK, JIT_FAIL, or JIT_BAIL (with everything undone, or if f has
+   just gone back to bytecode) */
+CFUN__PROTO(jit_call, intmach_t, definition_t *f) {
+  jit_native_t *n = f->code.incoreinfo->jit;
+  tagged_t global_uncond = w->global_uncond;
+  tagged_t local_uncond = w->local_uncond;
+  tagged_t *h0, *tr;
+  intmach_t tr0, wake0, pad, r;
+
+  if (n == NULL) return JIT_BAIL; /* (removed by other worker) */
+  pad = JIT_HEAP_PAD;
+ again:
+  h0 = w->heap_top;
+  tr0 = w->trail_top - Trail_Start; /* (the trail may be moved) */
+  wake0 = WakeCount();
+  /* Trail all bindings, so that they can be undone */
+  w->global_uncond = Tagp(HVA, h0);
+  w->local_uncond = Tagp(SVA, Stack_End);
+  r = (*n->proc)(w);
+  w->global_uncond = global_uncond;
+  w->local_uncond = local_uncond;
+  if (r >= 0) return r;
+
+  /* Undo */
+  tr = Trail_Start + tr0;
+  while (TrailYounger(w->trail_top, tr)) {
+    tagged_t ref;
+    TrailDec(w->trail_top);
+    ref = *w->trail_top;
+    if (IsVar(ref)) *TaggedToPointer(ref) = ref;
+  }
+  w->heap_top = h0;
+  if (WakeCount() > wake0) SetWakeCount(wake0);
+
+  if (r == JIT_BAIL_HEAP && pad <= 4*JIT_HEAP_PAD) {
+    CVOID__CALL(explicit_heap_overflow, pad, FuncArity(f));
+    pad *= 4;
+    goto again;
+  }
+  if (++n->bails >= JIT_MAX_BAILS) jit_deopt(f);
+  return JIT_BAIL;
+}
+
+/* Unify for native code (which cannot run the wakeups of attributed
+   variables) */
+CFUN__PROTO(jit_unify, intmach_t, tagged_t x, tagged_t y) {
+  intmach_t wake = WakeCount();
+  if (!CBOOL__SUCCEED(cunify, x, y)) return JIT_FAIL;
+  return WakeCount() == wake ? JIT_OK : JIT_BAIL;
+}
@@ -0,0 +1,192 @@
+/*
+ *  eng_jit.h
+ *
+ *  Native code for hot predicates (see library(jit))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_ENG_JIT_H
+#define _CIAO_ENG_JIT_H
+
+#include <ciao/eng.h>
+
+/* Predicates of modules that use the jit package are candidates: they
+   count their calls down (jit_countdown in incore_info_t). The one
+   that reaches zero is queued and a JIT request event calls
+   internals:jit_handler/0 at the next predicate call. That compiles
+   it (with the predicates that it calls) to C, builds a shared
+   object, and installs its functions with '$jit_install'/3.
+
+   A predicate with native code is entered as ENTER_FASTCODE(_INDEXED)
+   and keeps its bytecode. Native code is deterministic and returns
+   JIT_OK, JIT_FAIL, or JIT_BAIL when it cannot go on (e.g., on an
+   argument that is not a small integer, on an attributed variable,
+   on deep recursion, or on pending events). Then jit_call() undoes
+   its bindings (all of them are trailed during the call) and its
+   heap, and the predicate runs from its bytecode instead.
+
+   All the predicates of a unit (the functions of a shared object)
+   return to bytecode when one of them is redefined or bails too
+   often. Shared objects are never unloaded.
+
+   Native code can also be compiled ahead of time (see
+   library(jit/jit_aot)). Then the shared object is the foreign code
+   of the module: its init function (called by dynlink/2) registers
+   its entries with jit_aot_register(), and they are installed when
+   the module is initialized (see '$jit_aot_install'/1). */
+
+/* Results of native code */
+#define JIT_FAIL 0
+#define JIT_OK 1
+#define JIT_BAIL (-1)
+#define JIT_BAIL_HEAP (-2) /* bail, and retry after growing the heap */
+
+#define JIT_MAX_DEPTH 4096 /* nested C calls in native code */
+#define JIT_MAX_BAILS 64 /* before going back to bytecode for good */
+#define JIT_HEAP_PAD (64*kCells*sizeof(tagged_t)) /* (bytes, to retry) */
+
+typedef CFUN__PROTO((*jit_proc_t), intmach_t);
+
+struct jit_native_ {
+  jit_proc_t proc;
+  jit_unit_t *unit;
+  intmach_t bails;
+  jit_native_t *retired; /* (next retired, see eng_jit.c) */
+};
+
+typedef struct jit_aot_ jit_aot_t; /* (see eng_jit.c) */
+
+struct jit_unit_ {
+  jit_unit_t *next;
+  void *handle; /* (NULL if ahead of time) */
+  jit_aot_t *aot; /* (if ahead of time) */
+  intmach_t count;
+  definition_t **preds;
+};
+
+/* Entries of native code compiled ahead of time */
+typedef struct jit_entry_ jit_entry_t;
+struct jit_entry_ {
+  char *name; /* (of the predicate, with its module) */
+  intmach_t arity;
+  jit_proc_t proc;
+};
+
+/* (at the entry of compiled predicates) */
+#define JIT_COUNT_HOOK(F) ({ \
+  incore_info_t *d__ = (F)->code.incoreinfo; \
+  if (d__->jit_countdown > 0 && --d__->jit_countdown == 0) { \
+    CVOID__CALL(jit_hot, (F)); \
+  } \
+})
+
+extern SLOCK jit_l;
+
+CVOID__PROTO(jit_hot, definition_t *f);
+CFUN__PROTO(jit_call, intmach_t, definition_t *f);
+void jit_deopt(definition_t *f);
+
+/* (for the init and end functions of shared objects compiled ahead of
+   time) */
+void jit_aot_register(char *module, char *stamp, void (*init)(void),
+                      intmach_t count, jit_entry_t *entries);
+void jit_aot_unregister(char *module);
+
+/* (for native code) */
+CFUN__PROTO(jit_unify, intmach_t, tagged_t x, tagged_t y);
+
+/* Native code (generated by library(jit/jit_c)). Statements that
+   return JIT_BAIL when the result would not be a small integer, or on
+   arguments that are not small integers. */
+
+#define JIT_HEAP(CELLS) ({ \
+  if (HeapCharAvailable(G->heap_top) < (CELLS)*sizeof(tagged_t)+CONTPAD) return JIT_BAIL_HEAP; \
+})
+/* (push X, moving unbound stack variables to the heap) */
+#define JIT_PUSH(X) ({ \
+  tagged_t t__; \
+  DEREF(t__, (X)); \
+  if (TaggedIsSVA(t__)) { \
+    tagged_t h__; \
+    HeapPush(G->heap_top, h__ = Tagp(HVA, G->heap_top)); \
+    BindSVA(t__, h__); \
+  } else { \
+    HeapPush(G->heap_top, t__); \
+  } \
+})
+/* (binds plain variables to nonvariables inline) */
+#define JIT_UNIFY(X, Y, FAIL) ({ \
+  tagged_t x__, y__; \
+  DEREF(x__, (X)); \
+  DEREF(y__, (Y)); \
+  if (x__ == y__) { \
+  } else if (IsVar(x__) && !IsVar(y__) && !TaggedIsCVA(x__)) { \
+    JIT_BIND(x__, y__); \
+  } else if (IsVar(y__) && !IsVar(x__) && !TaggedIsCVA(y__)) { \
+    JIT_BIND(y__, x__); \
+  } else { \
+    intmach_t r__ = CFUN__EVAL(jit_unify, x__, y__); \
+    if (r__ != JIT_OK) return r__ == JIT_FAIL ? (FAIL) : r__; \
+  } \
+})
+#define JIT_BIND(U, V) ({ \
+  if (TaggedIsHVA(U)) BindHVA(U, V) else BindSVA(U, V); \
+})
+#define JIT_CALL(CALL) ({ \
+  intmach_t r__ = (CALL); \
+  if (r__ != JIT_OK) return r__; \
+})
+#define JIT_IS_ATOMIC(X) (TaggedIsATM(X) || IsNumber(X))
+
+#define JIT_INT(I, X) ({ \
+  tagged_t t__; \
+  DEREF(t__, (X)); \
+  if (!TaggedIsSmall(t__)) return JIT_BAIL; \
+  (I) = GetSmall(t__); \
+})
+#define JIT_SMALL(X, I) ({ \
+  if (!IsInSmiValRange(I)) return JIT_BAIL; \
+  (X) = MakeSmall(I); \
+})
+#define JIT_ADD(R, A, B) ({ if (__builtin_add_overflow((A), (B), &(R))) return JIT_BAIL; })
+#define JIT_SUB(R, A, B) ({ if (__builtin_sub_overflow((A), (B), &(R))) return JIT_BAIL; })
+#define JIT_MUL(R, A, B) ({ if (__builtin_mul_overflow((A), (B), &(R))) return JIT_BAIL; })
+#define JIT_NEG(R, A) JIT_SUB(R, 0, A)
+#define JIT_ABS(R, A) ({ if ((A) < 0) JIT_NEG(R, A); else (R) = (A); })
+#define JIT_SIGN(R, A) ({ (R) = ((A) > 0) - ((A) < 0); })
+#define JIT_MIN(R, A, B) ({ (R) = (A) < (B) ? (A) : (B); })
+#define JIT_MAX(R, A, B) ({ (R) = (A) > (B) ? (A) : (B); })
+/* (// truncates, mod takes the sign of the divisor, rem the sign of
+   the dividend) */
+#define JIT_IDIV(R, A, B) ({ \
+  if ((B) == 0) return JIT_BAIL; \
+  if ((B) == -1) JIT_NEG(R, A); else (R) = (A) / (B); \
+})
+#define JIT_REM(R, A, B) ({ \
+  if ((B) == 0) return JIT_BAIL; \
+  (R) = (B) == -1 ? 0 : (A) % (B); \
+})
+#define JIT_MOD(R, A, B) ({ \
+  JIT_REM(R, A, B); \
+  if ((R) != 0 && (((R) ^ (B)) < 0)) (R) += (B); \
+})
+#define JIT_SHL(R, A, B) ({ \
+  if ((B) < 0 || (B) >= (intmach_t)(8*sizeof(intmach_t)-1)) return JIT_BAIL; \
+  (R) = (intmach_t)((uintmach_t)(A) << (B)); \
+  if (((R) >> (B)) != (A)) return JIT_BAIL; \
+})
+#define JIT_SHR(R, A, B) ({ \
+  if ((B) < 0) return JIT_BAIL; \
+  (R) = (B) >= (intmach_t)(8*sizeof(intmach_t)) ? ((A) < 0 ? -1 : 0) : (A) >> (B); \
+})
+
+CBOOL__PROTO(prolog_jit_candidate);
+CBOOL__PROTO(prolog_jit_hot);
+CBOOL__PROTO(prolog_jit_install);
+CBOOL__PROTO(prolog_jit_uninstall);
+CBOOL__PROTO(prolog_jit_native);
+CBOOL__PROTO(prolog_jit_aot_stamp);
+CBOOL__PROTO(prolog_jit_aot_install);
+
+#endif /* _CIAO_ENG_JIT_H */
@@ -0,0 +1,547 @@
+/*
+ *  eng_numarray.c
+ *
+ *  Packed numeric arrays (stored outside the heap)
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+#include <ciao/eng_numarray.h>
+
+#include <stdint.h>
+#include <string.h>
+
+const size_t numarray_elem_size[] = { 1, 2, 4, 8, 4, 8 };
+
+static char *numarray_type_names[] = {
+  "int8", "int16", "int32", "int64", "float32", "float64"
+};
+
+#define NUMARRAY_TYPES 6
+
+static tagged_t functor_numarray = 0;
+static tagged_t numarray_type_atoms[NUMARRAY_TYPES];
+
+SLOCK numarray_table_l;
+
+static void numarray_init_atoms(void) {
+  int i;
+  if (functor_numarray == 0) {
+    Wait_Acquire_slock(numarray_table_l);
+    if (functor_numarray == 0) {
+      for (i = 0; i < NUMARRAY_TYPES; i++) {
+        numarray_type_atoms[i] = GET_ATOM(numarray_type_names[i]);
+      }
+      functor_numarray = SetArity(GET_ATOM("$numarray"), 4);
+    }
+    Release_slock(numarray_table_l);
+  }
+}
+
+/* Type for an atom (-1 if it is not a valid type) */
+static int numarray_type(tagged_t t) {
+  int i;
+  numarray_init_atoms();
+  DEREF(t, t);
+  for (i = 0; i < NUMARRAY_TYPES; i++) {
+    if (numarray_type_atoms[i] == t) return i;
+  }
+  return -1;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Table of blocks (indexed by identifier, entries of freed blocks are
+   NULL). The table may be moved when it grows, so it is only accessed
+   with numarray_table_l held. */
+
+typedef struct numarray_block_ numarray_block_t;
+struct numarray_block_ {
+  int type;
+  intmach_t len;
+  char *data;
+};
+
+static numarray_block_t **numarray_table = NULL;
+static intmach_t numarray_table_size = 0;
+static intmach_t numarray_next_id = 1;
+
+/* New zero-filled block, returns its identifier (0 if the type or
+   the length are not valid) */
+intmach_t numarray_new(int type, intmach_t len) {
+  numarray_block_t *b;
+  intmach_t id;
+  intmach_t nbytes;
+
+  if (type < 0 || type >= NUMARRAY_TYPES || !NUMARRAY_LEN_OK(type, len)) return 0;
+  nbytes = (len == 0 ? 1 : len) * numarray_elem_size[type];
+  b = checkalloc_TYPE(numarray_block_t);
+  b->type = type;
+  b->len = len;
+  b->data = checkalloc_ARRAY(char, nbytes);
+  memset(b->data, 0, nbytes);
+  Wait_Acquire_slock(numarray_table_l);
+  if (numarray_next_id >= numarray_table_size) {
+    intmach_t size = numarray_table_size == 0 ? 64 : numarray_table_size * 2;
+    numarray_table = numarray_table == NULL ?
+      checkalloc_ARRAY(numarray_block_t *, size) :
+      checkrealloc_ARRAY(numarray_block_t *, numarray_table_size, size, numarray_table);
+    memset(numarray_table + numarray_table_size, 0,
+           (size - numarray_table_size) * sizeof(numarray_block_t *));
+    numarray_table_size = size;
+  }
+  id = numarray_next_id++;
+  numarray_table[id] = b;
+  Release_slock(numarray_table_l);
+  return id;
+}
+
+/* Free a block (fails if it has already been freed) */
+bool_t numarray_free(intmach_t id) {
+  numarray_block_t *b;
+  Wait_Acquire_slock(numarray_table_l);
+  if (id <= 0 || id >= numarray_next_id || numarray_table[id] == NULL) {
+    Release_slock(numarray_table_l);
+    return FALSE;
+  }
+  b = numarray_table[id];
+  numarray_table[id] = NULL;
+  Release_slock(numarray_table_l);
+  checkdealloc_ARRAY(char, (b->len == 0 ? 1 : b->len) * numarray_elem_size[b->type], b->data);
+  checkdealloc_TYPE(numarray_block_t, b);
+  return TRUE;
+}
+
+/* Decode a numarray term (fails if it is not well formed or its block
+   has been freed) */
+bool_t numarray_view(tagged_t t, numarray_view_t *v) {
+  tagged_t id, type, off, len;
+  numarray_block_t *b;
+  numarray_init_atoms();
+  DEREF(t, t);
+  if (!TaggedIsSTR(t) || TaggedToHeadfunctor(t) != functor_numarray) return FALSE;
+  DerefArg(id, t, 1);
+  DerefArg(type, t, 2);
+  DerefArg(off, t, 3);
+  DerefArg(len, t, 4);
+  if (!TaggedIsSmall(id) || !TaggedIsSmall(off) || !TaggedIsSmall(len)) return FALSE;
+  v->id = GetSmall(id);
+  Wait_Acquire_slock(numarray_table_l);
+  b = (v->id <= 0 || v->id >= numarray_next_id) ? NULL : numarray_table[v->id];
+  Release_slock(numarray_table_l);
+  if (b == NULL || numarray_type_atoms[b->type] != type) return FALSE;
+  v->type = b->type;
+  v->off = GetSmall(off);
+  v->len = GetSmall(len);
+  if (v->off < 0 || v->len < 0 || v->off + v->len > b->len) return FALSE;
+  v->ptr = b->data + v->off * numarray_elem_size[v->type];
+  return TRUE;
+}
+
+/* Pre: NUMARRAY_CELLS available in the heap */
+CFUN__PROTO(numarray_term, tagged_t, intmach_t id, int type, intmach_t off, intmach_t len) {
+  tagged_t t;
+  numarray_init_atoms();
+  t = Tagp(STR, G->heap_top);
+  HeapPush(G->heap_top, functor_numarray);
+  HeapPush(G->heap_top, MakeSmall(id));
+  HeapPush(G->heap_top, numarray_type_atoms[type]);
+  HeapPush(G->heap_top, MakeSmall(off));
+  HeapPush(G->heap_top, MakeSmall(len));
+  return t;
+}
+
+#define ENSURE_HEAP_NUMARRAY(CELLS, ARITY) \
+  TEST_HEAP_OVERFLOW(G->heap_top, (CELLS)*sizeof(tagged_t)+CONTPAD, (ARITY))
+
+/* Cells for a boxed number (see make_integer() and make_float()) */
+#define NUMBER_CELLS 4
+
+/* --------------------------------------------------------------------------- */
+/* Element access */
+
+static inline int64_t numarray_geti(numarray_view_t *v, intmach_t i) {
+  switch (v->type) {
+  case NUMARRAY_INT8: return ((int8_t *)v->ptr)[i];
+  case NUMARRAY_INT16: return ((int16_t *)v->ptr)[i];
+  case NUMARRAY_INT32: return ((int32_t *)v->ptr)[i];
+  case NUMARRAY_INT64: return ((int64_t *)v->ptr)[i];
+  case NUMARRAY_FLOAT32: return (int64_t)((float *)v->ptr)[i];
+  default: return (int64_t)((double *)v->ptr)[i];
+  }
+}
+
+static inline double numarray_getf(numarray_view_t *v, intmach_t i) {
+  switch (v->type) {
+  case NUMARRAY_INT8: return ((int8_t *)v->ptr)[i];
+  case NUMARRAY_INT16: return ((int16_t *)v->ptr)[i];
+  case NUMARRAY_INT32: return ((int32_t *)v->ptr)[i];
+  case NUMARRAY_INT64: return (double)((int64_t *)v->ptr)[i];
+  case NUMARRAY_FLOAT32: return ((float *)v->ptr)[i];
+  default: return ((double *)v->ptr)[i];
+  }
+}
+
+static inline void numarray_seti(numarray_view_t *v, intmach_t i, int64_t x) {
+  switch (v->type) {
+  case NUMARRAY_INT8: ((int8_t *)v->ptr)[i] = (int8_t)x; break;
+  case NUMARRAY_INT16: ((int16_t *)v->ptr)[i] = (int16_t)x; break;
+  case NUMARRAY_INT32: ((int32_t *)v->ptr)[i] = (int32_t)x; break;
+  case NUMARRAY_INT64: ((int64_t *)v->ptr)[i] = x; break;
+  case NUMARRAY_FLOAT32: ((float *)v->ptr)[i] = (float)x; break;
+  default: ((double *)v->ptr)[i] = (double)x; break;
+  }
+}
+
+static inline void numarray_setf(numarray_view_t *v, intmach_t i, double x) {
+  switch (v->type) {
+  case NUMARRAY_INT8: ((int8_t *)v->ptr)[i] = (int8_t)x; break;
+  case NUMARRAY_INT16: ((int16_t *)v->ptr)[i] = (int16_t)x; break;
+  case NUMARRAY_INT32: ((int32_t *)v->ptr)[i] = (int32_t)x; break;
+  case NUMARRAY_INT64: ((int64_t *)v->ptr)[i] = (int64_t)x; break;
+  case NUMARRAY_FLOAT32: ((float *)v->ptr)[i] = (float)x; break;
+  default: ((double *)v->ptr)[i] = x; break;
+  }
+}
+
+/* Store a number (fails if t is not a number of the right kind) */
+static bool_t numarray_set_tagged(numarray_view_t *v, intmach_t i, tagged_t t) {
+  DEREF(t, t);
+  if (NUMARRAY_IS_FLOAT(v->type)) {
+    if (!IsNumber(t)) return FALSE;
+    numarray_setf(v, i, TaggedToFloat(t));
+  } else {
+    if (!IsInteger(t)) return FALSE;
+    numarray_seti(v, i, TaggedToIntmach(t));
+  }
+  return TRUE;
+}
+
+/* Pre: NUMBER_CELLS available in the heap */
+static CFUN__PROTO(numarray_get_tagged, tagged_t, numarray_view_t *v, intmach_t i) {
+  if (NUMARRAY_IS_FLOAT(v->type)) {
+    return BoxFloat(numarray_getf(v, i));
+  } else {
+    return IntmachToTagged((intmach_t)numarray_geti(v, i));
+  }
+}
+
+/* --------------------------------------------------------------------------- */
+
+/* '$numarray_new'(+Type, +Len, -Array) */
+CBOOL__PROTO(prolog_numarray_new) {
+  tagged_t t;
+  int type;
+  ERR__FUNCTOR("numarray:numarray_new", 3);
+  intmach_t len, id;
+
+  type = numarray_type(X(0));
+  CBOOL__TEST(type >= 0);
+  DEREF(t, X(1));
+  CBOOL__TEST(TaggedIsSmall(t));
+  len = GetSmall(t);
+  CBOOL__TEST(len >= 0);
+  if (!NUMARRAY_LEN_OK(type, len)) {
+    BUILTIN_ERROR(ERR_resource_error(r_undefined), X(1), 2);
+  }
+  ENSURE_HEAP_NUMARRAY(NUMARRAY_CELLS, 3);
+  id = numarray_new(type, len);
+  CBOOL__LASTUNIFY(CFUN__EVAL(numarray_term, id, type, 0, len), X(2));
+}
+
+/* '$numarray_from_list'(+Type, +List, -Array) */
+CBOOL__PROTO(prolog_numarray_from_list) {
+  numarray_view_t v;
+  tagged_t l, car, t;
+  int type;
+  intmach_t len, id, i;
+
+  type = numarray_type(X(0));
+  CBOOL__TEST(type >= 0);
+  /* Check the list and get its length */
+  len = 0;
+  DEREF(l, X(1));
+  while (l != atom_nil) {
+    if (!TaggedIsLST(l)) CBOOL__FAIL;
+    DerefCar(car, l);
+    if (NUMARRAY_IS_FLOAT(type) ? !IsNumber(car) : !IsInteger(car)) CBOOL__FAIL;
+    DerefCdr(l, l);
+    len++;
+  }
+
+  ENSURE_HEAP_NUMARRAY(NUMARRAY_CELLS, 3);
+  id = numarray_new(type, len);
+  t = CFUN__EVAL(numarray_term, id, type, 0, len);
+  (void)numarray_view(t, &v);
+  i = 0;
+  DEREF(l, X(1));
+  while (l != atom_nil) {
+    DerefCar(car, l);
+    (void)numarray_set_tagged(&v, i++, car);
+    DerefCdr(l, l);
+  }
+  CBOOL__LASTUNIFY(t, X(2));
+}
+
+/* '$numarray_to_list'(+Array, -List) */
+CBOOL__PROTO(prolog_numarray_to_list) {
+  numarray_view_t v;
+  tagged_t l;
+  intmach_t i;
+
+  CBOOL__TEST(numarray_view(X(0), &v));
+  ENSURE_HEAP_NUMARRAY(v.len * (LSTCELLS + NUMBER_CELLS), 2);
+  l = atom_nil;
+  for (i = v.len - 1; i >= 0; i--) {
+    MakeLST(l, CFUN__EVAL(numarray_get_tagged, &v, i), l);
+  }
+  CBOOL__LASTUNIFY(l, X(1));
+}
+
+/* '$numarray_get'(+Array, +Index, -X) */
+CBOOL__PROTO(prolog_numarray_get) {
+  numarray_view_t v;
+  tagged_t t;
+  intmach_t i;
+
+  CBOOL__TEST(numarray_view(X(0), &v));
+  DEREF(t, X(1));
+  CBOOL__TEST(TaggedIsSmall(t));
+  i = GetSmall(t);
+  CBOOL__TEST(i >= 0 && i < v.len);
+  ENSURE_HEAP_NUMARRAY(NUMBER_CELLS, 3);
+  CBOOL__LASTUNIFY(CFUN__EVAL(numarray_get_tagged, &v, i), X(2));
+}
+
+/* '$numarray_set'(+Array, +Index, +X) (destructive) */
+CBOOL__PROTO(prolog_numarray_set) {
+  numarray_view_t v;
+  tagged_t t;
+  intmach_t i;
+
+  CBOOL__TEST(numarray_view(X(0), &v));
+  DEREF(t, X(1));
+  CBOOL__TEST(TaggedIsSmall(t));
+  i = GetSmall(t);
+  CBOOL__TEST(i >= 0 && i < v.len);
+  CBOOL__LASTTEST(numarray_set_tagged(&v, i, X(2)));
+}
+
+/* '$numarray_fill'(+Array, +X) (destructive) */
+CBOOL__PROTO(prolog_numarray_fill) {
+  numarray_view_t v;
+  intmach_t i;
+
+  CBOOL__TEST(numarray_view(X(0), &v));
+  if (v.len == 0) CBOOL__PROCEED;
+  CBOOL__TEST(numarray_set_tagged(&v, 0, X(1)));
+  for (i = 1; i < v.len; i++) {
+    memcpy(v.ptr + i * numarray_elem_size[v.type], v.ptr, numarray_elem_size[v.type]);
+  }
+  CBOOL__PROCEED;
+}
+
+/* '$numarray_copy'(+Array, -Copy) (new block) */
+CBOOL__PROTO(prolog_numarray_copy) {
+  numarray_view_t v, c;
+  tagged_t t;
+  intmach_t id;
+
+  CBOOL__TEST(numarray_view(X(0), &v));
+  ENSURE_HEAP_NUMARRAY(NUMARRAY_CELLS, 2);
+  (void)numarray_view(X(0), &v); /* (after a possible GC) */
+  id = numarray_new(v.type, v.len);
+  t = CFUN__EVAL(numarray_term, id, v.type, 0, v.len);
+  (void)numarray_view(t, &c);
+  (void)numarray_view(X(0), &v); /* (the table may have moved) */
+  memcpy(c.ptr, v.ptr, v.len * numarray_elem_size[v.type]);
+  CBOOL__LASTUNIFY(t, X(1));
+}
+
+/* '$numarray_free'(+Array) (frees the block, invalidates all slices) */
+CBOOL__PROTO(prolog_numarray_free) {
+  numarray_view_t v;
+
+  CBOOL__TEST(numarray_view(X(0), &v));
+  CBOOL__LASTTEST(numarray_free(v.id));
+}
+
+/* --------------------------------------------------------------------------- */
+/* Vectorized arithmetic */
+
+#define NUMARRAY_OP_ADD 0
+#define NUMARRAY_OP_SUB 1
+#define NUMARRAY_OP_MUL 2
+#define NUMARRAY_OP_DIV 3
+#define NUMARRAY_OP_MIN 4
+#define NUMARRAY_OP_MAX 5
+
+static int numarray_op(tagged_t t) {
+  DEREF(t, t);
+  if (t == GET_ATOM("+")) return NUMARRAY_OP_ADD;
+  if (t == GET_ATOM("-")) return NUMARRAY_OP_SUB;
+  if (t == GET_ATOM("*")) return NUMARRAY_OP_MUL;
+  if (t == GET_ATOM("/")) return NUMARRAY_OP_DIV;
+  if (t == GET_ATOM("min")) return NUMARRAY_OP_MIN;
+  if (t == GET_ATOM("max")) return NUMARRAY_OP_MAX;
+  return -1;
+}
+
+/* Element-wise loop on typed pointers (B is an array or a scalar) */
+#define NUMARRAY_LOOP(T, OP, A, B, C, N, BSTEP) ({ \
+  T *a_ = (T *)(A); T *b_ = (T *)(B); T *c_ = (T *)(C); \
+  intmach_t i_; \
+  switch (OP) { \
+  case NUMARRAY_OP_ADD: for (i_ = 0; i_ < (N); i_++) c_[i_] = a_[i_] + b_[i_*(BSTEP)]; break; \
+  case NUMARRAY_OP_SUB: for (i_ = 0; i_ < (N); i_++) c_[i_] = a_[i_] - b_[i_*(BSTEP)]; break; \
+  case NUMARRAY_OP_MUL: for (i_ = 0; i_ < (N); i_++) c_[i_] = a_[i_] * b_[i_*(BSTEP)]; break; \
+  case NUMARRAY_OP_DIV: for (i_ = 0; i_ < (N); i_++) c_[i_] = a_[i_] / b_[i_*(BSTEP)]; break; \
+  case NUMARRAY_OP_MIN: for (i_ = 0; i_ < (N); i_++) { T x_ = a_[i_], y_ = b_[i_*(BSTEP)]; c_[i_] = x_ < y_ ? x_ : y_; } break; \
+  case NUMARRAY_OP_MAX: for (i_ = 0; i_ < (N); i_++) { T x_ = a_[i_], y_ = b_[i_*(BSTEP)]; c_[i_] = x_ > y_ ? x_ : y_; } break; \
+  } \
+})
+
+#define NUMARRAY_LOOP_TYPED(TYPE, OP, A, B, C, N, BSTEP) ({ \
+  switch (TYPE) { \
+  case NUMARRAY_INT8: NUMARRAY_LOOP(int8_t, OP, A, B, C, N, BSTEP); break; \
+  case NUMARRAY_INT16: NUMARRAY_LOOP(int16_t, OP, A, B, C, N, BSTEP); break; \
+  case NUMARRAY_INT32: NUMARRAY_LOOP(int32_t, OP, A, B, C, N, BSTEP); break; \
+  case NUMARRAY_INT64: NUMARRAY_LOOP(int64_t, OP, A, B, C, N, BSTEP); break; \
+  case NUMARRAY_FLOAT32: NUMARRAY_LOOP(float, OP, A, B, C, N, BSTEP); break; \
+  default: NUMARRAY_LOOP(double, OP, A, B, C, N, BSTEP); break; \
+  } \
+})
+
+/* '$numarray_op'(+Op, +A, +B, -C): C is a new array (of the type of
+   A) with the result of applying Op to the elements of A and B (an
+   array of the same length or a number) */
+CBOOL__PROTO(prolog_numarray_op) {
+  ERR__FUNCTOR("numarray:numarray_op", 4);
+  numarray_view_t va, vb, vc;
+  tagged_t b, t;
+  int op;
+  bool_t scalar;
+  intmach_t n, i, id;
+  union { int8_t i8; int16_t i16; int32_t i32; int64_t i64; float f32; double f64; } s;
+  numarray_view_t vs;
+
+  op = numarray_op(X(0));
+  CBOOL__TEST(op >= 0);
+  CBOOL__TEST(numarray_view(X(1), &va));
+  n = va.len;
+  DEREF(b, X(2));
+  scalar = IsNumber(b);
+  if (scalar) {
+    /* Convert the scalar to the element type */
+    vs.type = va.type;
+    vs.ptr = (char *)&s;
+    if (NUMARRAY_IS_FLOAT(va.type)) {
+      numarray_setf(&vs, 0, TaggedToFloat(b));
+    } else {
+      CBOOL__TEST(IsInteger(b));
+      numarray_seti(&vs, 0, TaggedToIntmach(b));
+      if (op == NUMARRAY_OP_DIV && numarray_geti(&vs, 0) == 0) {
+        BUILTIN_ERROR(ERR_evaluation_error(zero_divisor), X(2), 3);
+      }
+    }
+  } else {
+    CBOOL__TEST(numarray_view(b, &vb));
+    CBOOL__TEST(vb.len == n);
+    if (op == NUMARRAY_OP_DIV && !NUMARRAY_IS_FLOAT(va.type)) {
+      for (i = 0; i < n; i++) {
+        if (numarray_geti(&vb, i) == 0) {
+          BUILTIN_ERROR(ERR_evaluation_error(zero_divisor), X(2), 3);
+        }
+      }
+    }
+  }
+
+  ENSURE_HEAP_NUMARRAY(NUMARRAY_CELLS, 4);
+  id = numarray_new(va.type, n);
+  t = CFUN__EVAL(numarray_term, id, va.type, 0, n);
+  /* (views again, after a possible GC or table resize) */
+  (void)numarray_view(t, &vc);
+  (void)numarray_view(X(1), &va);
+  if (scalar) {
+    NUMARRAY_LOOP_TYPED(va.type, op, va.ptr, vs.ptr, vc.ptr, n, 0);
+  } else {
+    (void)numarray_view(X(2), &vb);
+    if (vb.type == va.type) {
+      NUMARRAY_LOOP_TYPED(va.type, op, va.ptr, vb.ptr, vc.ptr, n, 1);
+    } else if (NUMARRAY_IS_FLOAT(va.type) || NUMARRAY_IS_FLOAT(vb.type)) {
+      /* (mixed types, go through double) */
+      for (i = 0; i < n; i++) {
+        double x = numarray_getf(&va, i), y = numarray_getf(&vb, i), r;
+        switch (op) {
+        case NUMARRAY_OP_ADD: r = x + y; break;
+        case NUMARRAY_OP_SUB: r = x - y; break;
+        case NUMARRAY_OP_MUL: r = x * y; break;
+        case NUMARRAY_OP_DIV: r = x / y; break;
+        case NUMARRAY_OP_MIN: r = x < y ? x : y; break;
+        default: r = x > y ? x : y; break;
+        }
+        numarray_setf(&vc, i, r);
+      }
+    } else {
+      /* (mixed integer types, go through int64) */
+      for (i = 0; i < n; i++) {
+        int64_t x = numarray_geti(&va, i), y = numarray_geti(&vb, i), r;
+        switch (op) {
+        case NUMARRAY_OP_ADD: r = x + y; break;
+        case NUMARRAY_OP_SUB: r = x - y; break;
+        case NUMARRAY_OP_MUL: r = x * y; break;
+        case NUMARRAY_OP_DIV: r = x / y; break;
+        case NUMARRAY_OP_MIN: r = x < y ? x : y; break;
+        default: r = x > y ? x : y; break;
+        }
+        numarray_seti(&vc, i, r);
+      }
+    }
+  }
+  CBOOL__LASTUNIFY(t, X(3));
+}
+
+/* '$numarray_reduce'(+Op, +Array, -X): sum, min or max of the
+   elements (min and max fail on empty arrays) */
+CBOOL__PROTO(prolog_numarray_reduce) {
+  numarray_view_t v;
+  tagged_t op;
+  intmach_t i;
+
+  DEREF(op, X(0));
+  CBOOL__TEST(numarray_view(X(1), &v));
+  ENSURE_HEAP_NUMARRAY(NUMBER_CELLS, 3);
+  (void)numarray_view(X(1), &v); /* (after a possible GC) */
+  if (op == GET_ATOM("sum")) {
+    if (NUMARRAY_IS_FLOAT(v.type)) {
+      double r = 0.0;
+      for (i = 0; i < v.len; i++) r += numarray_getf(&v, i);
+      CBOOL__LASTUNIFY(BoxFloat(r), X(2));
+    } else {
+      int64_t r = 0;
+      for (i = 0; i < v.len; i++) r += numarray_geti(&v, i);
+      CBOOL__LASTUNIFY(IntmachToTagged((intmach_t)r), X(2));
+    }
+  } else if (op == GET_ATOM("min") || op == GET_ATOM("max")) {
+    bool_t is_min = (op == GET_ATOM("min"));
+    intmach_t best;
+    CBOOL__TEST(v.len > 0);
+    best = 0;
+    for (i = 1; i < v.len; i++) {
+      bool_t better;
+      if (NUMARRAY_IS_FLOAT(v.type)) {
+        double x = numarray_getf(&v, i), y = numarray_getf(&v, best);
+        better = is_min ? x < y : x > y;
+      } else {
+        int64_t x = numarray_geti(&v, i), y = numarray_geti(&v, best);
+        better = is_min ? x < y : x > y;
+      }
+      if (better) best = i;
+    }
+    CBOOL__LASTUNIFY(CFUN__EVAL(numarray_get_tagged, &v, best), X(2));
+  } else {
+    CBOOL__FAIL;
+  }
+}
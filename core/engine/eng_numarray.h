@@ -0,0 +1,69 @@
+/*
+ *  eng_numarray.h
+ *
+ *  Packed numeric arrays (stored outside the heap)
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_ENG_NUMARRAY_H
+#define _CIAO_ENG_NUMARRAY_H
+
+#include <ciao/eng.h>
+
+/* A numeric array is a block of packed elements allocated outside the
+   heap (so that its address never changes and C code can read or
+   fill it in place). It is referenced from Prolog by the term
+   '$numarray'(Id, Type, Off, Len), where Id identifies the block and
+   Off and Len select a slice of it (slices share the block). Blocks
+   are released explicitly; identifiers are never reused, so that
+   stale references are detected. */
+
+#define NUMARRAY_INT8 0
+#define NUMARRAY_INT16 1
+#define NUMARRAY_INT32 2
+#define NUMARRAY_INT64 3
+#define NUMARRAY_FLOAT32 4
+#define NUMARRAY_FLOAT64 5
+
+#define NUMARRAY_IS_FLOAT(TYPE) ((TYPE) >= NUMARRAY_FLOAT32)
+
+/* Valid length for an array of TYPE (its size in bytes must fit in an
+   intmach_t, and its length in a small integer) */
+#define NUMARRAY_LEN_OK(TYPE, LEN) \
+  ((LEN) >= 0 && (LEN) <= SmiValMax && \
+   (LEN) <= INTMACH_MAX / (intmach_t)numarray_elem_size[(TYPE)])
+
+/* Heap cells for a new numarray term */
+#define NUMARRAY_CELLS 5
+
+typedef struct numarray_view_ numarray_view_t;
+struct numarray_view_ {
+  intmach_t id;
+  int type;
+  intmach_t off;
+  intmach_t len;
+  char *ptr; /* first element of the slice */
+};
+
+extern const size_t numarray_elem_size[];
+
+extern SLOCK numarray_table_l;
+
+intmach_t numarray_new(int type, intmach_t len);
+bool_t numarray_free(intmach_t id);
+bool_t numarray_view(tagged_t t, numarray_view_t *v);
+CFUN__PROTO(numarray_term, tagged_t, intmach_t id, int type, intmach_t off, intmach_t len);
+
+CBOOL__PROTO(prolog_numarray_new);
+CBOOL__PROTO(prolog_numarray_from_list);
+CBOOL__PROTO(prolog_numarray_to_list);
+CBOOL__PROTO(prolog_numarray_get);
+CBOOL__PROTO(prolog_numarray_set);
+CBOOL__PROTO(prolog_numarray_fill);
+CBOOL__PROTO(prolog_numarray_copy);
+CBOOL__PROTO(prolog_numarray_op);
+CBOOL__PROTO(prolog_numarray_reduce);
+CBOOL__PROTO(prolog_numarray_free);
+
+#endif /* _CIAO_ENG_NUMARRAY_H */
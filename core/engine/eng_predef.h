@@ -258,6 +258,7 @@ typedef bool_t (*cbool2_t)(worker_t *, tagged_t, tagged_t);
 typedef bool_t (*cbool3_t)(worker_t *, tagged_t, tagged_t, tagged_t);
 typedef tagged_t (*ctagged1_t)(worker_t *, tagged_t);
 typedef tagged_t (*ctagged2_t)(worker_t *, tagged_t, tagged_t);
+typedef tagged_t (*ctagged3_t)(worker_t *, tagged_t, tagged_t, tagged_t);
 
 /* ------------------------------------------------------------------------- */
 /* Runtime definitions for the current instruction set */
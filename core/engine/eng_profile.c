@@ -301,3 +301,273 @@ CBOOL__PROTO(prolog_profile_reset) {
 #endif
   CBOOL__PROCEED;
 }
+
+/* --------------------------------------------------------------------------- */
+/* Clause counters */
+
+/* Count how many times each clause is entered, either as the first
+   alternative of a call (try) or on backtracking (retry). Unlike
+   GAUGE this does not need instrumented code nor a special engine:
+   the emulator calls clause_counters__hit() only when
+   clause_counters_enabled is set.
+
+   Each worker owns an open-addressing table keyed by clause. All
+   tables are linked in a global list and merged on demand (per
+   predicate and clause number). Each table has its own lock, so that
+   other workers can read or reset it; it is almost never contended.
+   Entries are removed when their clause is freed (see
+   clause_counters_forget()), so that the memory of a clause does not
+   inherit its counts when it is reused. */
+
+#if !defined(OPTIM_COMP)
+
+#include <string.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+
+bool_t clause_counters_enabled = FALSE; /* Shared */
+
+typedef struct clause_counter_ clause_counter_t;
+struct clause_counter_ {
+  emul_info_t *clause;
+  intmach_t tries;
+  intmach_t retries;
+};
+
+struct clause_counters_ {
+  clause_counters_t *next; /* next table in clause_counters_list */
+  SLOCK lock;
+  uintmach_t mask; /* size-1 (size is a power of 2) */
+  uintmach_t count; /* number of used entries */
+  clause_counter_t *entries;
+};
+
+#define CLAUSE_COUNTERS_INITIAL_SIZE 256
+
+static clause_counters_t *clause_counters_list = NULL; /* Shared */
+SLOCK clause_counters_list_l;
+
+static inline uintmach_t clause_counters_hash(emul_info_t *cl) {
+  uintmach_t k = (uintmach_t)cl >> 4;
+  return k ^ (k >> 11);
+}
+
+static clause_counter_t *clause_counters_lookup(clause_counters_t *t, emul_info_t *cl) {
+  uintmach_t i = clause_counters_hash(cl) & t->mask;
+  for (;;) {
+    clause_counter_t *e = &t->entries[i];
+    if (e->clause == cl || e->clause == NULL) return e;
+    i = (i + 1) & t->mask;
+  }
+}
+
+static void clause_counters_grow(clause_counters_t *t) {
+  clause_counter_t *old = t->entries;
+  uintmach_t oldsize = t->mask + 1;
+  uintmach_t i;
+
+  t->entries = checkalloc_ARRAY(clause_counter_t, oldsize * 2);
+  memset(t->entries, 0, oldsize * 2 * sizeof(clause_counter_t));
+  t->mask = oldsize * 2 - 1;
+  for (i = 0; i < oldsize; i++) {
+    if (old[i].clause != NULL) {
+      *clause_counters_lookup(t, old[i].clause) = old[i];
+    }
+  }
+  checkdealloc_ARRAY(clause_counter_t, oldsize, old);
+}
+
+static clause_counters_t *clause_counters_new(void) {
+  clause_counters_t *t;
+
+  t = checkalloc_TYPE(clause_counters_t);
+  Init_slock(t->lock);
+  t->mask = CLAUSE_COUNTERS_INITIAL_SIZE - 1;
+  t->count = 0;
+  t->entries = checkalloc_ARRAY(clause_counter_t, CLAUSE_COUNTERS_INITIAL_SIZE);
+  memset(t->entries, 0, CLAUSE_COUNTERS_INITIAL_SIZE * sizeof(clause_counter_t));
+
+  Wait_Acquire_slock(clause_counters_list_l);
+  t->next = clause_counters_list;
+  clause_counters_list = t;
+  Release_slock(clause_counters_list_l);
+  return t;
+}
+
+CVOID__PROTO(clause_counters__hit, try_node_t *alt, intmach_t kind) {
+  clause_counters_t *t;
+  clause_counter_t *e;
+  emul_info_t *cl;
+
+  cl = alt->clause;
+  if (cl == NULL) return; /* not a clause (e.g., fail_alt) */
+  t = w->misc->clause_counters;
+  if (t == NULL) {
+    t = clause_counters_new();
+    w->misc->clause_counters = t;
+  }
+  Wait_Acquire_slock(t->lock);
+  e = clause_counters_lookup(t, cl);
+  if (e->clause == NULL) {
+    if ((t->count + 1) * 4 > (t->mask + 1) * 3) { /* keep load below 3/4 */
+      clause_counters_grow(t);
+      e = clause_counters_lookup(t, cl);
+    }
+    e->clause = cl;
+    t->count++;
+  }
+  if (kind == CLAUSE_COUNTERS__TRY) {
+    e->tries++;
+  } else {
+    e->retries++;
+  }
+  Release_slock(t->lock);
+}
+
+/* Remove the entry e of t (keeping the probe sequences of the other
+   entries unbroken) */
+static void clause_counters_delete(clause_counters_t *t, clause_counter_t *e) {
+  uintmach_t i = e - t->entries;
+  uintmach_t j = i;
+
+  for (;;) {
+    uintmach_t k;
+    j = (j + 1) & t->mask;
+    if (t->entries[j].clause == NULL) break;
+    k = clause_counters_hash(t->entries[j].clause) & t->mask;
+    /* move entry j to the hole at i unless its home k is in (i,j] */
+    if (i <= j ? (i < k && k <= j) : (i < k || k <= j)) continue;
+    t->entries[i] = t->entries[j];
+    i = j;
+  }
+  t->entries[i].clause = NULL;
+  t->entries[i].tries = 0;
+  t->entries[i].retries = 0;
+  t->count--;
+}
+
+/* (called before the memory of clause cl is freed) */
+void clause_counters_forget(emul_info_t *cl) {
+  clause_counters_t *t;
+  clause_counter_t *e;
+
+  if (clause_counters_list == NULL) return; /* (never used) */
+  Wait_Acquire_slock(clause_counters_list_l);
+  for (t = clause_counters_list; t != NULL; t = t->next) {
+    Wait_Acquire_slock(t->lock);
+    e = clause_counters_lookup(t, cl);
+    if (e->clause != NULL) clause_counters_delete(t, e);
+    Release_slock(t->lock);
+  }
+  Release_slock(clause_counters_list_l);
+}
+
+/* Sum the counters of clause cl across all workers */
+static bool_t clause_counters_merged(emul_info_t *cl, intmach_t *tries, intmach_t *retries) {
+  clause_counters_t *t;
+  clause_counter_t *e;
+  bool_t found = FALSE;
+
+  *tries = 0;
+  *retries = 0;
+  Wait_Acquire_slock(clause_counters_list_l);
+  for (t = clause_counters_list; t != NULL; t = t->next) {
+    Wait_Acquire_slock(t->lock);
+    e = clause_counters_lookup(t, cl);
+    if (e->clause != NULL) {
+      *tries += e->tries;
+      *retries += e->retries;
+      found = TRUE;
+    }
+    Release_slock(t->lock);
+  }
+  Release_slock(clause_counters_list_l);
+  return found;
+}
+
+/* Execute BODY for each clause CL (number N of predicate D) with
+   collected counters */
+#define FOREACH_COUNTED_CLAUSE(D, N, CL, TRIES, RETRIES, BODY) { \
+  hashtab_t *table_ = *predicates_location; \
+  intmach_t j_; \
+  for (j_ = HASHTAB_SIZE(table_) - 1; j_ >= 0; --j_) { \
+    definition_t *D = (definition_t *)table_->node[j_].value.as_ptr; \
+    emul_info_t *CL, *stop_; \
+    intmach_t N, TRIES, RETRIES; \
+    if (D == NULL || D->predtyp > ENTER_FASTCODE_INDEXED) continue; \
+    stop_ = *D->code.incoreinfo->clauses_tail; \
+    for (CL = D->code.incoreinfo->clauses, N = 1; CL != stop_; CL = CL->next, N++) { \
+      if (!clause_counters_merged(CL, &TRIES, &RETRIES)) continue; \
+      BODY; \
+    } \
+  } \
+}
+
+CBOOL__PROTO(prolog_clause_counters_set) {
+  tagged_t x;
+  DEREF(x,X(0));
+  if (x == atom_on) {
+    clause_counters_enabled = TRUE;
+  } else if (x == atom_off) {
+    clause_counters_enabled = FALSE;
+  } else {
+    CBOOL__FAIL;
+  }
+  CBOOL__PROCEED;
+}
+
+CBOOL__PROTO(prolog_clause_counters_get) {
+  CBOOL__LASTUNIFY(clause_counters_enabled ? atom_on : atom_off, X(0));
+}
+
+CBOOL__PROTO(prolog_clause_counters_reset) {
+  clause_counters_t *t;
+  Wait_Acquire_slock(clause_counters_list_l);
+  for (t = clause_counters_list; t != NULL; t = t->next) {
+    Wait_Acquire_slock(t->lock);
+    memset(t->entries, 0, (t->mask + 1) * sizeof(clause_counter_t));
+    t->count = 0;
+    Release_slock(t->lock);
+  }
+  Release_slock(clause_counters_list_l);
+  CBOOL__PROCEED;
+}
+
+/* '$clause_counters'(-L): L is a list of
+   clause_count(Name/Arity, ClauseNumber, Tries, Retries) for each
+   clause entered at least once since the last reset. */
+
+#define CLAUSE_COUNT_CELLS (LSTCELLS+5+3+2*4) /* (room for 2 bignums) */
+
+CBOOL__PROTO(prolog_clause_counters) {
+  intmach_t n;
+  tagged_t list, item, spec, ttries, tretries;
+  tagged_t functor_clause_count;
+
+  n = 0;
+  FOREACH_COUNTED_CLAUSE(d, i, cl, tries, retries, { n++; });
+
+  TEST_HEAP_OVERFLOW(G->heap_top, n*CLAUSE_COUNT_CELLS*sizeof(tagged_t)+CONTPAD, 1);
+  functor_clause_count = SetArity(GET_ATOM("clause_count"), 4);
+  list = atom_nil;
+  FOREACH_COUNTED_CLAUSE(d, i, cl, tries, retries, {
+    if (n == 0) continue; /* (clauses may have been hit meanwhile) */
+    n--;
+    ttries = IntmachToTagged(tries);
+    tretries = IntmachToTagged(retries);
+    spec = Tagp(STR, G->heap_top);
+    HeapPush(G->heap_top, functor_slash);
+    HeapPush(G->heap_top, FuncName(d));
+    HeapPush(G->heap_top, MakeSmall(FuncArity(d)));
+    item = Tagp(STR, G->heap_top);
+    HeapPush(G->heap_top, functor_clause_count);
+    HeapPush(G->heap_top, spec);
+    HeapPush(G->heap_top, MakeSmall(i));
+    HeapPush(G->heap_top, ttries);
+    HeapPush(G->heap_top, tretries);
+    MakeLST(list, item, list);
+  });
+  CBOOL__LASTUNIFY(list, X(0));
+}
+
+#endif
@@ -76,6 +76,27 @@ CBOOL__PROTO(prolog_profile_flags_get);
 CBOOL__PROTO(prolog_profile_dump);
 CBOOL__PROTO(prolog_profile_reset);
 
+/* Clause counters (available in all engines, switchable at runtime) */
+
+#define CLAUSE_COUNTERS__TRY   0 /* clause entered as first alternative */
+#define CLAUSE_COUNTERS__RETRY 1 /* clause entered on backtracking */
+
+extern bool_t clause_counters_enabled;
+
+extern SLOCK clause_counters_list_l;
+
+CVOID__PROTO(clause_counters__hit, try_node_t *alt, intmach_t kind);
+void clause_counters_forget(emul_info_t *cl);
+
+#define CLAUSE_COUNTERS__HOOK(ALT, KIND) ({ \
+  if (clause_counters_enabled) CVOID__CALL(clause_counters__hit, (ALT), (KIND)); \
+})
+
+CBOOL__PROTO(prolog_clause_counters_set);
+CBOOL__PROTO(prolog_clause_counters_get);
+CBOOL__PROTO(prolog_clause_counters_reset);
+CBOOL__PROTO(prolog_clause_counters);
+
 #endif /* !defined(OPTIM_COMP) */
 
 #endif /* _CIAO_ENG_PROFILE_H */
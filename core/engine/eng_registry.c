@@ -25,6 +25,14 @@
 
 #include <ciao/eng_registry.h>
 #include <ciao/eng_profile.h>
+#include <ciao/eng_bytes.h>
+#include <ciao/eng_digest.h>
+#include <ciao/eng_numarray.h>
+#include <ciao/eng_fiber.h>
+#include <ciao/eng_jit.h>
+#include <ciao/io_tokenize.h>
+#include <ciao/io_write.h>
+#include <ciao/io_format.h>
 
 /* (only for registering) */
 #include <ciao/rune.h>
@@ -92,7 +100,7 @@ static char                  /* Shared -- for adding new atoms; need lock */
   *prolog_chars=NULL,
   *prolog_chars_end=NULL;
 
-void *builtintab[64];                                           /* Shared */
+void *builtintab[BUILTINTAB_SIZE];                              /* Shared */
 
                 /* Shared -- related with the hashing of arith. functions */
 hashtab_t *switch_on_function;
@@ -242,6 +250,7 @@ tagged_t functor_Dsetarg;
 tagged_t functor_Dsetargstr;
 tagged_t functor_large;
 tagged_t functor_long;
+tagged_t functor_rat;
 
 tagged_t functor_active;
 tagged_t functor_pending;
@@ -298,6 +307,8 @@ definition_t *address_interpret_compiled_goal;
 definition_t *address_interpret_c_goal;
 definition_t *address_undefined_goal;
 definition_t *address_help; 
+definition_t *address_yield;
+definition_t *address_jit;
 definition_t *address_restart; 
 definition_t *address_trace;
 definition_t *address_getct;
@@ -921,6 +932,12 @@ void init_locks(void){
   Init_slock(worker_id_pool_l);
   Init_slock(atom_id_l);
   Init_slock(wam_list_l);
+  Init_slock(clause_counters_list_l);
+  Init_slock(op_table_l);
+  Init_slock(numarray_table_l);
+  Init_slock(fiber_table_l);
+  Init_slock(incore_index_l);
+  Init_slock(jit_l);
 
 #if defined(ANDPARALLEL)
   Init_slock(stackset_expansion_l);
@@ -1002,6 +1019,8 @@ CBOOL__PROTO(line_position);
 CBOOL__PROTO(line_count);
 CBOOL__PROTO(flush_output);
 CBOOL__PROTO(flush_output1);
+CBOOL__PROTO(prolog_fsync_output);
+CBOOL__PROTO(prolog_stream_is_file);
 CBOOL__PROTO(prolog_clearerr);
 CBOOL__PROTO(current_stream);
 /* io_basic.c */
@@ -1061,6 +1080,9 @@ CFUN__PROTO(fu1_sub1, tagged_t, tagged_t x0);
 CFUN__PROTO(fu2_and, tagged_t, tagged_t x0, tagged_t x1);
 CFUN__PROTO(fu2_fdivide, tagged_t, tagged_t x0, tagged_t x1);
 CFUN__PROTO(fu2_gcd, tagged_t, tagged_t x0, tagged_t x1);
+CFUN__PROTO(fu2_rdiv, tagged_t, tagged_t x0, tagged_t x1);
+CFUN__PROTO(fu3_powm, tagged_t, tagged_t x0, tagged_t x1, tagged_t x2);
+CFUN__PROTO(fu1_isqrt, tagged_t, tagged_t x0);
 CFUN__PROTO(fu2_idivide, tagged_t, tagged_t x0, tagged_t x1);
 CFUN__PROTO(fu2_lsh, tagged_t, tagged_t x0, tagged_t x1);
 CFUN__PROTO(fu2_minus, tagged_t, tagged_t x0, tagged_t x1);
@@ -1156,6 +1178,7 @@ CBOOL__PROTO(prolog_unlock_predicate_x);
 CBOOL__PROTO(prolog_using_windows);
 CBOOL__PROTO(prolog_exec);
 CBOOL__PROTO(prolog_wait);
+CBOOL__PROTO(prolog_wait_any);
 CBOOL__PROTO(prolog_kill);
 CBOOL__PROTO(prolog_unix_cd);
 CBOOL__PROTO(prolog_exec_shell);
@@ -1261,6 +1284,9 @@ static void define_functions(void)
   deffunction("abs",1,(void *)fu1_abs,19); /* (ISO) */
   deffunction("sign",1,(void *)fu1_sign,49); /* (ISO) */
   deffunction_nobtin("gcd",2,(void *)fu2_gcd);
+  deffunction_nobtin("powm",3,(void *)fu3_powm);
+  deffunction_nobtin("isqrt",1,(void *)fu1_isqrt);
+  deffunction_nobtin("rdiv",2,(void *)fu2_rdiv);
 
   /* all of these ISO */
   deffunction("float_integer_part",1,(void *)fu1_intpart,50);
@@ -1440,6 +1466,7 @@ void init_once(void) {
   functor_Dsetargstr = deffunctor("$$$setargstr$$$",1); // (users should not create this!)
   functor_large = deffunctor("large",2);
   functor_long = deffunctor("long",1);
+  functor_rat = deffunctor("$rat",2);
 
 
   functor_active = deffunctor("active", 4);
@@ -1456,6 +1483,7 @@ void init_once(void) {
   address_undefined_goal = define_builtin("basiccontrol:undefined_goal",ENTER_UNDEFINED,1);
   address_trace = define_builtin("basiccontrol:debug_goal",ENTER_UNDEFINED,1);
   address_help = define_builtin("internals:control_c_handler",ENTER_UNDEFINED,0);
+  address_jit = define_builtin("internals:jit_handler",ENTER_UNDEFINED,0);
   address_restart = define_builtin("internals:reboot",ENTER_UNDEFINED,0);
   (void) define_builtin("$geler",BUILTIN_GELER,2);
   (void) define_builtin("internals:$instance",BUILTIN_INSTANCE,3);
@@ -1499,6 +1527,8 @@ void init_once(void) {
   define_c_mod_predicate("stream_basic","pipe",2,prolog_pipe);
   define_c_mod_predicate("stream_basic","flush_output",0,flush_output);
   define_c_mod_predicate("stream_basic","flush_output",1,flush_output1);
+  define_c_mod_predicate("internals","$fsync_output",1,prolog_fsync_output);
+  define_c_mod_predicate("internals","$stream_is_file",2,prolog_stream_is_file);
   define_c_mod_predicate("stream_basic","clearerr",1,prolog_clearerr);
 
   define_c_mod_predicate("io_alias_redirection", "replace_stream",2, prolog_replace_stream);
@@ -1629,6 +1659,77 @@ void init_once(void) {
   define_c_mod_predicate("internals","$profile_flags_set",1,prolog_profile_flags_set);
   define_c_mod_predicate("internals","$profile_dump",0,prolog_profile_dump);
   define_c_mod_predicate("internals","$profile_reset",0,prolog_profile_reset);
+  define_c_mod_predicate("internals","$clause_counters_set",1,prolog_clause_counters_set);
+  define_c_mod_predicate("internals","$clause_counters_get",1,prolog_clause_counters_get);
+  define_c_mod_predicate("internals","$clause_counters_reset",0,prolog_clause_counters_reset);
+  define_c_mod_predicate("internals","$clause_counters",1,prolog_clause_counters);
+
+                                /* eng_bytes.c */
+
+  define_c_mod_predicate("internals","$bytes_from_codes",2,prolog_bytes_from_codes);
+  define_c_mod_predicate("internals","$bytes_to_codes",2,prolog_bytes_to_codes);
+  define_c_mod_predicate("internals","$bytes_sub",4,prolog_bytes_sub);
+  define_c_mod_predicate("internals","$bytes_concat",2,prolog_bytes_concat);
+  define_c_mod_predicate("internals","$bytes_search",4,prolog_bytes_search);
+  define_c_mod_predicate("internals","$bytes_get",3,prolog_bytes_get);
+  define_c_mod_predicate("internals","$bytes_compare",3,prolog_bytes_compare);
+  define_c_mod_predicate("internals","$bytes_read",3,prolog_bytes_read);
+  define_c_mod_predicate("internals","$bytes_write",2,prolog_bytes_write);
+  define_c_mod_predicate("internals","$bytes_read_file",4,prolog_bytes_read_file);
+
+                                /* eng_digest.c */
+
+  define_c_mod_predicate("internals","$digest_init",2,prolog_digest_init);
+  define_c_mod_predicate("internals","$digest_update",3,prolog_digest_update);
+  define_c_mod_predicate("internals","$digest_update_stream",3,prolog_digest_update_stream);
+  define_c_mod_predicate("internals","$digest_update_file",3,prolog_digest_update_file);
+  define_c_mod_predicate("internals","$digest_final",2,prolog_digest_final);
+
+                                /* eng_numarray.c */
+
+  define_c_mod_predicate("internals","$numarray_new",3,prolog_numarray_new);
+  define_c_mod_predicate("internals","$numarray_from_list",3,prolog_numarray_from_list);
+  define_c_mod_predicate("internals","$numarray_to_list",2,prolog_numarray_to_list);
+  define_c_mod_predicate("internals","$numarray_get",3,prolog_numarray_get);
+  define_c_mod_predicate("internals","$numarray_set",3,prolog_numarray_set);
+  define_c_mod_predicate("internals","$numarray_fill",2,prolog_numarray_fill);
+  define_c_mod_predicate("internals","$numarray_copy",2,prolog_numarray_copy);
+  define_c_mod_predicate("internals","$numarray_op",4,prolog_numarray_op);
+  define_c_mod_predicate("internals","$numarray_reduce",3,prolog_numarray_reduce);
+  define_c_mod_predicate("internals","$numarray_free",1,prolog_numarray_free);
+
+                                /* eng_fiber.c */
+
+  define_c_mod_predicate("internals","$fiber_new",2,prolog_fiber_new);
+  define_c_mod_predicate("internals","$fiber_resume",2,prolog_fiber_resume);
+  define_c_mod_predicate("internals","$fiber_result",2,prolog_fiber_result);
+  define_c_mod_predicate("internals","$fiber_yield",2,prolog_fiber_yield);
+  define_c_mod_predicate("internals","$fiber_self",1,prolog_fiber_self);
+  define_c_mod_predicate("internals","$fiber_free",1,prolog_fiber_free);
+  define_c_mod_predicate("internals","$fiber_poll",3,prolog_fiber_poll);
+
+                                /* eng_jit.c */
+
+  define_c_mod_predicate("internals","$jit_candidate",2,prolog_jit_candidate);
+  define_c_mod_predicate("internals","$jit_hot",1,prolog_jit_hot);
+  define_c_mod_predicate("internals","$jit_install",3,prolog_jit_install);
+  define_c_mod_predicate("internals","$jit_uninstall",1,prolog_jit_uninstall);
+  define_c_mod_predicate("internals","$jit_native",1,prolog_jit_native);
+  define_c_mod_predicate("internals","$jit_aot_stamp",2,prolog_jit_aot_stamp);
+  define_c_mod_predicate("internals","$jit_aot_install",1,prolog_jit_aot_install);
+
+                                /* io_tokenize.c */
+
+  address_read_tokens = define_c_mod_predicate("internals","$read_tokens",4,prolog_read_tokens);
+
+                                /* io_write.c */
+
+  define_c_mod_predicate("internals","$op_update",5,prolog_op_update);
+  define_c_mod_predicate("internals","$write_term",4,prolog_write_term);
+
+                                /* io_format.c */
+
+  define_c_mod_predicate("internals","$format",3,prolog_format);
 
                                 /* qread.c */
 
@@ -1652,6 +1753,7 @@ void init_once(void) {
   define_c_mod_predicate("system","fd_close",1,prolog_fd_close);
   define_c_mod_predicate("internals","$exec",9,prolog_exec);
   define_c_mod_predicate("system","wait",2,prolog_wait);
+  define_c_mod_predicate("system","wait_any",2,prolog_wait_any);
   define_c_mod_predicate("system","kill",2,prolog_kill);
   define_c_mod_predicate("internals","$unix_argv",1,prolog_unix_argv);
   define_c_mod_predicate("system","mktemp",2,prolog_unix_mktemp);
@@ -1763,7 +1865,7 @@ void init_once(void) {
   define_c_mod_predicate("runtime_control", "new_atom", 1, prolog_new_atom);
   define_c_mod_predicate("internals","$max_arity",1,get_max_arity);
   // (experimental)
-  define_c_mod_predicate("internals", "$yield", 0, prolog_yield);
+  address_yield = define_c_mod_predicate("internals", "$yield", 0, prolog_yield);
 
 #if defined(GAUGE)
   /* gauge.c */
@@ -1819,6 +1921,7 @@ void init_once(void) {
   }
 #endif
   address_nd_yield = def_retry_c(nd_yield,0);
+  address_nd_fiber_yield = def_retry_c(nd_fiber_yield,3);
 
 #include "eng_static_mod.c"
 
@@ -1917,6 +2020,9 @@ CVOID__PROTO(local_init_each_time) {
   w->next_insn = bootcode;
   w->misc->exit_code = 0;
   Stop_This_Goal(Arg) = FALSE;
+  Yield_Request(Arg) = FALSE;
+  SetSuspendedGoal(Arg, FALSE);
+  Jit_Request(Arg) = FALSE;
   UnsetEvent();
 
   w->liveinfo = NULL;
@@ -2071,6 +2177,7 @@ worker_t *create_wam_storage(void) {
 
   w = checkalloc_FLEXIBLE(worker_t, tagged_t, reg_bank_size);
   w->misc = checkalloc_TYPE(misc_info_t);
+  w->misc->clause_counters = NULL;
   w->streams = checkalloc_TYPE(io_streams_t);
   w->debugger_info = checkalloc_TYPE(debugger_state_t);
 
@@ -2078,6 +2185,17 @@ worker_t *create_wam_storage(void) {
 }
 
 CVOID__PROTO(create_wam_areas) {
+  CVOID__CALL(create_wam_areas_sized,
+              eng_cfg_getenv("GLOBALSTKSIZE",GLOBALSTKSIZE),
+              eng_cfg_getenv("LOCALSTKSIZE",LOCALSTKSIZE),
+              eng_cfg_getenv("CHOICESTKSIZE",CHOICESTKSIZE),
+              eng_cfg_getenv("TRAILSTKSIZE",TRAILSTKSIZE));
+}
+
+/* Create the areas with the given initial sizes (in cells) */
+CVOID__PROTO(create_wam_areas_sized,
+             intmach_t heap_cells, intmach_t stack_cells,
+             intmach_t choice_cells, intmach_t trail_cells) {
   intmach_t i, j;
 
   Atom_Buffer_Length = STATICMAXATOM;
@@ -2143,20 +2261,20 @@ CVOID__PROTO(create_wam_areas) {
 #endif
 
   /* heap pointer is first free cell, grows ++ */
-  i = eng_cfg_getenv("GLOBALSTKSIZE",GLOBALSTKSIZE) * sizeof(tagged_t);
+  i = heap_cells * sizeof(tagged_t);
   Heap_Start = ALLOC_AREA(i);
   Heap_End = (tagged_t *)HeapCharOffset(Heap_Start,i);
   UnsetEvent();
 
   /* stack pointer is first free cell, grows ++ */
-  i = eng_cfg_getenv("LOCALSTKSIZE",LOCALSTKSIZE) * sizeof(tagged_t);
+  i = stack_cells * sizeof(tagged_t);
   Stack_Start = ALLOC_AREA(i);
   Stack_End = (tagged_t *)StackCharOffset(Stack_Start,i);
 
   /* trail pointer is first free cell, grows ++ */
   /* choice pointer is last busy cell, grows -- */
-  i = eng_cfg_getenv("CHOICESTKSIZE",CHOICESTKSIZE) * sizeof(tagged_t);
-  j = eng_cfg_getenv("TRAILSTKSIZE",TRAILSTKSIZE) * sizeof(tagged_t);
+  i = choice_cells * sizeof(tagged_t);
+  j = trail_cells * sizeof(tagged_t);
   i += j;
   Choice_End = Trail_Start = ALLOC_AREA(i);
   Choice_Start = Trail_End = (tagged_t *)TrailCharOffset(Trail_Start, i);
@@ -2166,6 +2284,21 @@ CVOID__PROTO(create_wam_areas) {
 #endif
 }
 
+/* Release the areas and the storage of a worker that is not in the
+   free WAM list (not for ANDPARALLEL or PARBACK workers, which are
+   linked in the circular list of WAMs) */
+CVOID__PROTO(destroy_wam) {
+  checkdealloc_ARRAY(char, HeapCharSize(), (char *)Heap_Start);
+  checkdealloc_ARRAY(char, StackCharSize(), (char *)Stack_Start);
+  checkdealloc_ARRAY(char, TrailCharDifference(Trail_Start,Trail_End), (char *)Trail_Start);
+  checkdealloc_ARRAY(char, Atom_Buffer_Length, Atom_Buffer);
+  checkdealloc_TYPE(debugger_state_t, w->debugger_info);
+  checkdealloc_TYPE(io_streams_t, w->streams);
+  /* (w->misc->clause_counters, if any, stays in the global list) */
+  checkdealloc_TYPE(misc_info_t, w->misc);
+  checkdealloc_FLEXIBLE(worker_t, tagged_t, reg_bank_size, w);
+}
+
 /* Cleanup after abort: shrink stacks to initial sizes. */
 CVOID__PROTO(reinitialize_wam_areas) {
   intmach_t i, j;
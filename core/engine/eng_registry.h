@@ -34,6 +34,10 @@ CBOOL__PROTO(statistics);
 CBOOL__PROTO(total_usage);
 worker_t *create_wam_storage(void);
 CVOID__PROTO(create_wam_areas);
+CVOID__PROTO(create_wam_areas_sized,
+             intmach_t heap_cells, intmach_t stack_cells,
+             intmach_t choice_cells, intmach_t trail_cells);
+CVOID__PROTO(destroy_wam);
 CVOID__PROTO(reinitialize_wam_areas);
 CVOID__PROTO(release_wam);
 
@@ -372,6 +372,114 @@
     from_c      = ciao_mk_c_double_list,
     compound    = yes ]).
 
+:- ttr_match(in_c_int8_array, (c_int8_array, ground, ground)).
+:- ttr_match(go_c_int8_array, (c_int8_array, term, ground)).
+:- ttr_def(in_c_int8_array, [
+    ctype_decl  = pointer(int8_t),
+    ctype_call  = pointer(int8_t),
+    check       = ciao_is_c_int8_numarray,
+    exception   = usage_fault("foreign interface: array length or type inconsistency."),
+    to_c        = ciao_get_c_int8_numarray,
+    length_of   = ciao_numarray_length,
+    compound    = yes ]).
+:- ttr_def(go_c_int8_array, [
+    ctype_decl  = pointer(int8_t),
+    ctype_res   = pointer(int8_t),
+    ctype_call  = pointer(pointer(int8_t)),
+    call_cref   = yes,
+    from_c      = ciao_mk_c_int8_numarray,
+    compound    = yes ]).
+
+:- ttr_match(in_c_int16_array, (c_int16_array, ground, ground)).
+:- ttr_match(go_c_int16_array, (c_int16_array, term, ground)).
+:- ttr_def(in_c_int16_array, [
+    ctype_decl  = pointer(int16_t),
+    ctype_call  = pointer(int16_t),
+    check       = ciao_is_c_int16_numarray,
+    exception   = usage_fault("foreign interface: array length or type inconsistency."),
+    to_c        = ciao_get_c_int16_numarray,
+    length_of   = ciao_numarray_length,
+    compound    = yes ]).
+:- ttr_def(go_c_int16_array, [
+    ctype_decl  = pointer(int16_t),
+    ctype_res   = pointer(int16_t),
+    ctype_call  = pointer(pointer(int16_t)),
+    call_cref   = yes,
+    from_c      = ciao_mk_c_int16_numarray,
+    compound    = yes ]).
+
+:- ttr_match(in_c_int32_array, (c_int32_array, ground, ground)).
+:- ttr_match(go_c_int32_array, (c_int32_array, term, ground)).
+:- ttr_def(in_c_int32_array, [
+    ctype_decl  = pointer(int32_t),
+    ctype_call  = pointer(int32_t),
+    check       = ciao_is_c_int32_numarray,
+    exception   = usage_fault("foreign interface: array length or type inconsistency."),
+    to_c        = ciao_get_c_int32_numarray,
+    length_of   = ciao_numarray_length,
+    compound    = yes ]).
+:- ttr_def(go_c_int32_array, [
+    ctype_decl  = pointer(int32_t),
+    ctype_res   = pointer(int32_t),
+    ctype_call  = pointer(pointer(int32_t)),
+    call_cref   = yes,
+    from_c      = ciao_mk_c_int32_numarray,
+    compound    = yes ]).
+
+:- ttr_match(in_c_int64_array, (c_int64_array, ground, ground)).
+:- ttr_match(go_c_int64_array, (c_int64_array, term, ground)).
+:- ttr_def(in_c_int64_array, [
+    ctype_decl  = pointer(int64_t),
+    ctype_call  = pointer(int64_t),
+    check       = ciao_is_c_int64_numarray,
+    exception   = usage_fault("foreign interface: array length or type inconsistency."),
+    to_c        = ciao_get_c_int64_numarray,
+    length_of   = ciao_numarray_length,
+    compound    = yes ]).
+:- ttr_def(go_c_int64_array, [
+    ctype_decl  = pointer(int64_t),
+    ctype_res   = pointer(int64_t),
+    ctype_call  = pointer(pointer(int64_t)),
+    call_cref   = yes,
+    from_c      = ciao_mk_c_int64_numarray,
+    compound    = yes ]).
+
+:- ttr_match(in_c_float_array, (c_float_array, ground, ground)).
+:- ttr_match(go_c_float_array, (c_float_array, term, ground)).
+:- ttr_def(in_c_float_array, [
+    ctype_decl  = pointer(float),
+    ctype_call  = pointer(float),
+    check       = ciao_is_c_float_numarray,
+    exception   = usage_fault("foreign interface: array length or type inconsistency."),
+    to_c        = ciao_get_c_float_numarray,
+    length_of   = ciao_numarray_length,
+    compound    = yes ]).
+:- ttr_def(go_c_float_array, [
+    ctype_decl  = pointer(float),
+    ctype_res   = pointer(float),
+    ctype_call  = pointer(pointer(float)),
+    call_cref   = yes,
+    from_c      = ciao_mk_c_float_numarray,
+    compound    = yes ]).
+
+:- ttr_match(in_c_double_array, (c_double_array, ground, ground)).
+:- ttr_match(go_c_double_array, (c_double_array, term, ground)).
+:- ttr_def(in_c_double_array, [
+    ctype_decl  = pointer(double),
+    ctype_call  = pointer(double),
+    check       = ciao_is_c_double_numarray,
+    exception   = usage_fault("foreign interface: array length or type inconsistency."),
+    to_c        = ciao_get_c_double_numarray,
+    length_of   = ciao_numarray_length,
+    compound    = yes ]).
+:- ttr_def(go_c_double_array, [
+    ctype_decl  = pointer(double),
+    ctype_res   = pointer(double),
+    ctype_call  = pointer(pointer(double)),
+    call_cref   = yes,
+    from_c      = ciao_mk_c_double_numarray,
+    compound    = yes ]).
+
 :- ttr_match(go_any_term, (any_term, term, ground)).
 :- ttr_def(go_any_term, [
     ctype_decl  = ciao_term,
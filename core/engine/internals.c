@@ -7,6 +7,7 @@
 
 #include <setjmp.h>
 #include <stdio.h>
+#include <stdlib.h>
 #include <string.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -27,6 +28,7 @@
 #include <ciao/eng_bignum.h>
 #include <ciao/eng_gc.h>
 #include <ciao/timing.h>
+#include <ciao/eng_jit.h>
 #include <ciao/eng_profile.h>
 
 CBOOL__PROTO(stack_shift_usage);
@@ -432,12 +434,14 @@ CBOOL__PROTO(bc_eq_blob, tagged_t t, tagged_t *ptr) {
       return t == MakeSmall(ptr[1]);
     }
     // fprintf(stderr, "eq_blob->bignum\n");
+    f = BlobFunctorBignum(len); /* (as in bc_make_blob()) */
   }
 
   /* Compare blob from the heap */
   if (!TaggedIsSTR(t)) return FALSE;
-  for (intmach_t i=ar; i>0; i--) {
-    if (ptr[i-1] != *TaggedToArg(t,i-1)) return FALSE;
+  if (TaggedToHeadfunctor(t) != f) return FALSE;
+  for (intmach_t i=ar-1; i>0; i--) {
+    if (ptr[i] != *TaggedToArg(t,i)) return FALSE;
   }
   return TRUE;
 }
@@ -550,6 +554,8 @@ static void incore_puthash(hashtab_t **psw,
                            incore_info_t *def,
                            tagged_t k);
 static try_node_t *incore_copy(try_node_t *from);
+static void incore_index_reset(try_node_t *t);
+static void incore_index_free(incore_index_t *ix);
 static void trychain_free(try_node_t *t);
 static void free_hashtab_trychain(hashtab_t *sw);
 static void free_emulinfo(emul_info_t *cl);
@@ -592,6 +598,7 @@ static void incore_insert(try_node_t **t0,
 #if defined(GAUGE)
   t->entry_counter = ref->counters;
 #endif
+  t->index = NULL;
 
   if (TRY_NODE_IS_NULL(*t0)) {
     *t0 = t;
@@ -604,6 +611,7 @@ static void incore_insert(try_node_t **t0,
     SET_NONDET(tt);
     tt->next = t;
     t->previous = tt;
+    incore_index_reset(*t0);
   }
   (*t0)->previous = t;
   /* just in case *t0 was modified, maintain emul_p2 optimization */
@@ -627,6 +635,7 @@ static try_node_t *incore_copy(try_node_t *from)
 #if defined(GAUGE)
     t->entry_counter = from->entry_counter;
 #endif
+    t->index = NULL;
     from=from->next;
     while (!TRY_NODE_IS_NULL(from)) {
       t0 = t;
@@ -639,10 +648,12 @@ static try_node_t *incore_copy(try_node_t *from)
 #if defined(GAUGE)
       t->entry_counter = from->entry_counter;
 #endif
+      t->index = NULL;
       from=from->next;
     }
     t->next = NULL;
     copy->previous = t;
+    incore_index_reset(copy);
   }
   return copy;
 }
@@ -750,9 +761,247 @@ static void incore_puthash(hashtab_t **psw,
   }
 }
 
+/* --------------------------------------------------------------------------- */
+/* Secondary indexing of try chains (see incore_index_t) */
+
+/* Indices are built lazily by the workers that call the predicate.
+   They are built with incore_index_l held, and published once
+   complete, so that lookups do not need the lock. */
+SLOCK incore_index_l;
+
+/* Mark the secondary index of the chain starting at t as out of
+   date. The old one may still be used by choicepoints, so leave it to
+   the gc. (Called when clauses are added or removed, like the rest of
+   the updates of the chain, and also for the new chains of an index
+   while incore_index_l is held.) */
+static void incore_index_reset(try_node_t *t) {
+  if (t->index != NULL && t->index != INCORE_INDEX_PENDING) {
+    leave_to_gc(INCORE_INDEX, (char *)t->index);
+  }
+  t->index = TRY_NODE_IS_NULL(t->next) ? NULL : INCORE_INDEX_PENDING;
+}
+
+static void incore_index_free(incore_index_t *ix) {
+  intmach_t i;
+  if (ix == NULL || ix == INCORE_INDEX_PENDING) return;
+  for (i = 0; i < ix->count; i++) {
+    if (ix->sw[i].keys != NULL) free_hashtab_trychain(ix->sw[i].keys);
+  }
+  checkdealloc_FLEXIBLE(incore_index_t, incore_ixsw_t, ix->count, ix);
+}
+
+/* Key of a term, as in the first argument switch (but for lists).
+   Large numbers (floats and bignums) have no key: their header only
+   tells their size, so only clauses without key may match them. */
+static inline tagged_t incore_index_key(tagged_t t) {
+  if (TaggedIsLST(t)) return functor_lst;
+  if (TaggedIsSTR(t)) return STRIsLarge(t) ? ERRORTAG : TaggedToHeadfunctor(t);
+  return t;
+}
+
+/* Keys from a list of Pos-Key pairs (NULL if empty). Pairs whose key
+   is a large number are ignored (see incore_index_key()). */
+static incore_ixkeys_t *incore_ixkeys_new(tagged_t list) {
+  incore_ixkeys_t *ks;
+  tagged_t l, pair, t, key;
+  intmach_t n;
+
+  n = 0;
+  for (l = list; TaggedIsLST(l); ) {
+    DerefCar(pair,l);
+    DerefArg(t,pair,2);
+    if (incore_index_key(t) != ERRORTAG) n++;
+    DerefCdr(l,l);
+  }
+  if (n == 0) return NULL;
+  ks = checkalloc_FLEXIBLE(incore_ixkeys_t, incore_ixkey_t, n);
+  ks->count = n;
+  n = 0;
+  for (l = list; TaggedIsLST(l); ) {
+    DerefCar(pair,l);
+    DerefArg(t,pair,2);
+    key = incore_index_key(t);
+    if (key != ERRORTAG) {
+      ks->key[n].key = key;
+      DerefArg(t,pair,1);
+      ks->key[n].pos = GetSmall(t);
+      n++;
+    }
+    DerefCdr(l,l);
+  }
+  return ks;
+}
+
+static tagged_t incore_ixkeys_get(incore_ixkeys_t *ks, intmach_t pos) {
+  intmach_t i;
+  if (ks != NULL) {
+    for (i = 0; i < ks->count; i++) {
+      if (ks->key[i].pos == pos) return ks->key[i].key;
+    }
+  }
+  return ERRORTAG;
+}
+
+static int incore_ixkey_cmp(const void *a, const void *b) {
+  const incore_ixkey_t *x = (const incore_ixkey_t *)a;
+  const incore_ixkey_t *y = (const incore_ixkey_t *)b;
+  if (x->pos != y->pos) return x->pos < y->pos ? -1 : 1;
+  if (x->key != y->key) return x->key < y->key ? -1 : 1;
+  return 0;
+}
+
+/* Rank the positions that discriminate the clauses of the chain t0
+   by the average length of the chain selected by a key
+   (nvar+(n-nvar)/nkeys for n clauses, nvar of them without key at
+   that position, and nkeys different keys). Clauses without key are
+   copied to every chain, so positions where that would take more
+   than 2*n extra nodes are skipped. Return NULL if no position
+   helps. */
+static incore_index_t *incore_index_new(try_node_t *t0) {
+  try_node_t *t;
+  incore_ixkey_t *keys;
+  incore_ixkeys_t *ks;
+  incore_index_t *ix;
+  intmach_t n, m, size, i, j, k, nkeys, nvar, count;
+  intmach_t pos[INCORE_INDEX_MAX], num[INCORE_INDEX_MAX], den[INCORE_INDEX_MAX];
+
+  n = 0;
+  size = 0;
+  for (t = t0; !TRY_NODE_IS_NULL(t); t = t->next) {
+    n++;
+    if (t->clause->ixkeys != NULL) size += t->clause->ixkeys->count;
+  }
+  if (size == 0) return NULL;
+
+  keys = checkalloc_ARRAY(incore_ixkey_t, size);
+  m = 0;
+  for (t = t0; !TRY_NODE_IS_NULL(t); t = t->next) {
+    ks = t->clause->ixkeys;
+    if (ks == NULL) continue;
+    for (i = 0; i < ks->count; i++) keys[m++] = ks->key[i];
+  }
+  qsort(keys, m, sizeof(incore_ixkey_t), incore_ixkey_cmp);
+
+  count = 0;
+  for (i = 0; i < m; i = j) {
+    nkeys = 0;
+    for (j = i; j < m && keys[j].pos == keys[i].pos; j++) {
+      if (j == i || keys[j].key != keys[j-1].key) nkeys++;
+    }
+    nvar = n - (j - i);
+    if (nvar*nkeys > 2*n) continue;
+    if (nvar*nkeys + n - nvar >= n*nkeys) continue; /* no better than n */
+    /* insert sorted (stable, so earlier positions win ties) */
+    for (k = count; k > 0; k--) {
+      if (num[k-1] * nkeys <= (nvar*nkeys + n - nvar) * den[k-1]) break;
+      if (k < INCORE_INDEX_MAX) {
+        pos[k] = pos[k-1]; num[k] = num[k-1]; den[k] = den[k-1];
+      }
+    }
+    if (k < INCORE_INDEX_MAX) {
+      pos[k] = keys[i].pos;
+      num[k] = nvar*nkeys + n - nvar;
+      den[k] = nkeys;
+      if (count < INCORE_INDEX_MAX) count++;
+    }
+  }
+  checkdealloc_ARRAY(incore_ixkey_t, size, keys);
+  if (count == 0) return NULL;
+
+  ix = checkalloc_FLEXIBLE(incore_index_t, incore_ixsw_t, count);
+  ix->count = count;
+  for (i = 0; i < count; i++) {
+    ix->sw[i].pos = pos[i];
+    ix->sw[i].keys = NULL;
+  }
+  return ix;
+}
+
+/* Split the chain t0 on the keys at pos */
+static hashtab_t *incore_index_switch(try_node_t *t0, intmach_t pos) {
+  hashtab_t *sw;
+  try_node_t *t;
+
+  sw = new_switch_on_key(2,fail_alt);
+  for (t = t0; !TRY_NODE_IS_NULL(t); t = t->next) {
+    incore_puthash(&sw, t->arity, t->clause, NULL,
+                   incore_ixkeys_get(t->clause->ixkeys, pos));
+  }
+  return sw;
+}
+
+/* Clauses of the chain alts that may match the current arguments,
+   going down through the secondary indices (built here when first
+   needed). Positions with a variable in the call are skipped. */
+CFUN__PROTO(incore_index_select, try_node_t *, try_node_t *alts) {
+  incore_index_t *ix;
+  incore_ixsw_t *sw;
+  hashtab_t *keys;
+  intmach_t i, sub;
+  tagged_t t;
+
+ again:
+  ix = alts->index;
+  if (ix == INCORE_INDEX_PENDING) {
+    Wait_Acquire_slock(incore_index_l);
+    ix = alts->index;
+    if (ix == INCORE_INDEX_PENDING) { /* (not built by other worker) */
+      intmach_t current_mem = total_mem_count;
+      ix = incore_index_new(alts);
+      INC_MEM_PROG(total_mem_count - current_mem);
+      alts->index = ix;
+    }
+    Release_slock(incore_index_l);
+  }
+  if (ix == NULL) return alts;
+  for (i = 0; i < ix->count; i++) {
+    sw = &ix->sw[i];
+    t = X(IXPOS_ARG(sw->pos)-1);
+    DEREF(t,t);
+    if (IsVar(t)) continue;
+    sub = IXPOS_SUB(sw->pos);
+    if (sub != 0) {
+      if (TaggedIsLST(t) && sub <= 2) {
+        if (sub == 1) {
+          DerefCar(t,t);
+        } else {
+          DerefCdr(t,t);
+        }
+        if (IsVar(t)) continue;
+        t = incore_index_key(t);
+      } else if (TaggedIsSTR(t) && !STRIsLarge(t) &&
+                 sub <= Arity(TaggedToHeadfunctor(t))) {
+        DerefArg(t,t,sub);
+        if (IsVar(t)) continue;
+        t = incore_index_key(t);
+      } else {
+        t = ERRORTAG; /* only clauses without key here may match */
+      }
+    } else {
+      t = incore_index_key(t);
+    }
+    keys = sw->keys;
+    if (keys == NULL) {
+      Wait_Acquire_slock(incore_index_l);
+      keys = sw->keys;
+      if (keys == NULL) {
+        intmach_t current_mem = total_mem_count;
+        keys = incore_index_switch(alts, sw->pos);
+        INC_MEM_PROG(total_mem_count - current_mem);
+        sw->keys = keys;
+      }
+      Release_slock(incore_index_l);
+    }
+    alts = hashtab_get(keys,t)->value.try_chain;
+    goto again;
+  }
+  return alts;
+}
+
 static void trychain_free(try_node_t *t) {
   try_node_t *t1, *t2;
 
+  if (!TRY_NODE_IS_NULL(t)) incore_index_free(t->index);
   for (t1=t; !TRY_NODE_IS_NULL(t1); t1=t2) {
     t2=t1->next;
     checkdealloc_TYPE(try_node_t, t1);
@@ -784,6 +1033,15 @@ static void free_hashtab_trychain(hashtab_t *sw) {
 
 static void free_emulinfo(emul_info_t *cl)
 {
+#if !defined(OPTIM_COMP)
+  clause_counters_forget(cl);
+#endif
+  if (cl->ixkeys != NULL) {
+    checkdealloc_FLEXIBLE(incore_ixkeys_t,
+                          incore_ixkey_t,
+                          cl->ixkeys->count,
+                          cl->ixkeys);
+  }
   checkdealloc_FLEXIBLE_S(emul_info_t, objsize, cl);
 }
 
@@ -838,6 +1096,7 @@ CVOID__PROTO(erase_interpreted, definition_t *f);
 
 static CVOID__PROTO(make_undefined, definition_t *f) {
   /*Wait_Acquire_slock(prolog_predicates_l);*/
+  jit_deopt(f);
   leave_to_gc(f->predtyp, (char *)f->code.intinfo);
   if (f->predtyp==ENTER_INTERPRETED) {
     CVOID__CALL(erase_interpreted, f);
@@ -936,6 +1195,11 @@ static void free_info(enter_instr_t enter_instr, char *info)
         free_emulinfo((emul_info_t *)info);
         break;
       }
+    case INCORE_INDEX:
+      {
+        incore_index_free((incore_index_t *)info);
+        break;
+      }
     case OTHER_STUFF:
       {
         other_stuff_t *other = (other_stuff_t *)info;
@@ -1058,6 +1322,8 @@ CBOOL__PROTO(define_predicate)
       d->varcase = fail_alt;
       d->lstcase = NULL;        /* Used by native preds to hold nc_info */
       d->othercase = NULL; /* Used by native preds to hold index_clause */
+      d->jit_countdown = 0;
+      d->jit = NULL;
       f->code.incoreinfo = d;
     }
     f->properties.nonvar = 0;
@@ -1096,7 +1362,7 @@ CBOOL__PROTO(compiled_clause)
   DEREF(X(1),X(1));             /* Bytecode object */
   ref = TaggedToEmul(X(1));
   DEREF(X(2),X(2));             /* Mode */
-  DEREF(X(3),X(3));             /* f(Type,Key[,Base,Woff,Roff]) */
+  DEREF(X(3),X(3));             /* f(Type,Key[,IxKeys]) */
   DerefArg(t1,X(3),1);
   type = GetSmall(t1);
   DerefArg(key,X(3),2);
@@ -1104,10 +1370,15 @@ CBOOL__PROTO(compiled_clause)
     key = ERRORTAG;
   else if (TaggedIsSTR(key))
     key = TaggedToHeadfunctor(key);
+  if (Arity(TaggedToHeadfunctor(X(3))) == 3) {
+    DerefArg(t1,X(3),3);        /* [Pos-Key,...] (see incore_index_t) */
+    ref->ixkeys = incore_ixkeys_new(t1);
+  }
 
   if (f->predtyp == ENTER_INTERPRETED) {
     MAJOR_FAULT("adding compiled_clause to interpreted predicate!!!");
   }
+  jit_deopt(f);
 
   /* add a new clause. */
   d = f->code.incoreinfo;
@@ -1243,6 +1514,8 @@ void trychain_drain_marked(try_node_t **tfirst, tagged_t mark) {
   try_node_t *last;
   t = *tfirst;
   if (!TRY_NODE_IS_NULL(t)) {
+    incore_index_reset(t);
+    t->index = NULL;
     last = NULL; /* the last seen valid try_node */
     do {
       if (t->clause->mark == mark) {
@@ -1280,6 +1553,7 @@ void trychain_drain_marked(try_node_t **tfirst, tagged_t mark) {
       (*tfirst)->previous = last;
       /* just in case *tfirst was modified, maintain emul_p2 optimization */
       PATCH_EMUL_P2(*tfirst);
+      incore_index_reset(*tfirst);
     }
   }
 }
@@ -1310,6 +1584,7 @@ CBOOL__PROTO(incore_drain_marked, definition_t *f, tagged_t mark) {
   emul_info_t **last;
 
   // TODO:[oc-merge] "d->othercase != NULL" (and others) not in oc
+  jit_deopt(f);
   d = f->code.incoreinfo;
 #if defined(ABSMACH_OPT__debug_abolish_multifile)
   fprintf(stderr, "incore_drain_marked: begin\n");
@@ -1491,6 +1766,7 @@ CFUN__PROTO(attach_me_to_goal_desc_list, goal_descriptor_t *)
   goal_desc_p = checkalloc_TYPE(goal_descriptor_t);
   goal_desc_p->state = WORKING;
   goal_desc_p->goal_number = ++global_goal_number;
+  goal_desc_p->time_slice = 0;
   Init_slock(goal_desc_p->goal_lock_l);
   associate_wam_goal(Arg, goal_desc_p);
 
@@ -1567,12 +1843,16 @@ worker_t *get_my_worker(void)
   Wait_Acquire_slock(goal_desc_list_l);
   this_goal = goal_desc_list;
 
-  /* Go backwards: the goals at the beginning are free. */
+  /* Go backwards: the goals at the beginning are free. (The loop
+     must visit the whole ring: with threads that run their own
+     contexts (see ciao_prolog.c), the goal of this thread is not
+     necessarily the first one.) */
 
-  while( (this_goal != goal_desc_list) &&
-         ((this_goal->state != WORKING ) ||
-          !Thread_Equal(this_goal->thread_id, thr_id)))
+  do {
+    if (this_goal->state == WORKING &&
+        Thread_Equal(this_goal->thread_id, thr_id)) break;
     this_goal = this_goal->backward;
+  } while (this_goal != goal_desc_list);
   Release_slock(goal_desc_list_l);
   
   if (Thread_Equal(this_goal->thread_id, thr_id) &&
@@ -1689,6 +1969,7 @@ THREAD_RES_T startgoal(THREAD_ARG wo)
   w->next_insn = startgoalcode;
   SetDeep();  /* Force backtracking after alts. exahusted */
   w->choice->x[0] = X(0);    /* Will be the arg. of a call/1 */
+  w->misc->exit_code = WAM_NOT_HALTED;
  
 #if defined(DEBUG_TRACE) && defined(USE_THREADS)
   if (debug_threads)
@@ -1700,6 +1981,11 @@ THREAD_RES_T startgoal(THREAD_ARG wo)
   wam(Arg, goal_desc);    /* segfault patch -- jf */
   w = goal_desc->worker_registers;
   wam_result = w->misc->exit_code;
+  /* halt/1 in a goal halts the whole system */
+  if (wam_result != WAM_NOT_HALTED && wam_result != WAM_ABORT &&
+      wam_result != WAM_INTERRUPTED) {
+    engine_exit(wam_result);
+  }
 
 #if defined(DEBUG_TRACE) && defined(USE_THREADS)
   if (debug_threads)
@@ -1775,10 +2061,15 @@ THREAD_RES_T make_backtracking(THREAD_ARG wo)
   int wam_result;
   worker_t *w = goal_desc->worker_registers;
 
+  w->misc->exit_code = WAM_NOT_HALTED;
   /* segfault patch -- jf */
   wam(Arg, goal_desc);
   Arg = goal_desc->worker_registers;
   wam_result = goal_desc->worker_registers->misc->exit_code;
+  if (wam_result != WAM_NOT_HALTED && wam_result != WAM_ABORT &&
+      wam_result != WAM_INTERRUPTED) {
+    engine_exit(wam_result);
+  }
   if (wam_result == WAM_ABORT) {
     MAJOR_FAULT("Wam aborted while doing backtracking");
   }
@@ -34,6 +34,8 @@ CBOOL__PROTO(abolish_multifile, definition_t *f, tagged_t mod); /* JFMC */
 CBOOL__PROTO(define_predicate);
 CBOOL__PROTO(erase_clause);
 CBOOL__PROTO(compiled_clause);
+CFUN__PROTO(incore_index_select, try_node_t *, try_node_t *alts);
+extern SLOCK incore_index_l;
 hashtab_node_t *hashtab_lookup(hashtab_t **swp, tagged_t k);
 CBOOL__PROTO(set_property);
 
@@ -52,9 +54,11 @@ CBOOL__PROTO(gc_margin);
 
 typedef bignum_size_t (*bn_fun2_t)(bignum_t *x, bignum_t *y, bignum_t *z, bignum_t *zmax);
 typedef bignum_size_t (*bn_fun1_t)(bignum_t *x, bignum_t *z, bignum_t *zmax);
+typedef bignum_size_t (*bn_fun3_t)(bignum_t *x, bignum_t *y, bignum_t *m, bignum_t *z, bignum_t *zmax);
 
 CFUN__PROTO(bn_call2, tagged_t, bn_fun2_t f, tagged_t x, tagged_t y);
 CFUN__PROTO(bn_call1, tagged_t, bn_fun1_t f, tagged_t x);
+CFUN__PROTO(bn_call3, tagged_t, bn_fun3_t f, tagged_t x, tagged_t y, tagged_t m);
 CFUN__PROTO(bn_from_float_GC, tagged_t, flt64_t f);
 
 void reinit_list(goal_descriptor_t *goal);
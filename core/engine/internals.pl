@@ -257,6 +257,176 @@ compiling_mode(unprofiled).
 
 :- export('$profile_reset'/0).
 :- impl_defined('$profile_reset'/0).
+
+:- export('$clause_counters_set'/1).
+:- trust pred '$clause_counters_set'(T) : atm(T).
+:- impl_defined('$clause_counters_set'/1).
+
+:- export('$clause_counters_get'/1).
+:- trust pred '$clause_counters_get'(T) => atm(T).
+:- impl_defined('$clause_counters_get'/1).
+
+:- export('$clause_counters_reset'/0).
+:- impl_defined('$clause_counters_reset'/0).
+
+:- export('$clause_counters'/1).
+:- trust pred '$clause_counters'(L) => list(L).
+:- impl_defined('$clause_counters'/1).
+
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Byte buffers (see library(bytes))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$bytes_from_codes'/2).
+:- impl_defined('$bytes_from_codes'/2).
+:- export('$bytes_to_codes'/2).
+:- impl_defined('$bytes_to_codes'/2).
+:- export('$bytes_sub'/4).
+:- impl_defined('$bytes_sub'/4).
+:- export('$bytes_concat'/2).
+:- impl_defined('$bytes_concat'/2).
+:- export('$bytes_search'/4).
+:- impl_defined('$bytes_search'/4).
+:- export('$bytes_get'/3).
+:- impl_defined('$bytes_get'/3).
+:- export('$bytes_compare'/3).
+:- impl_defined('$bytes_compare'/3).
+:- export('$bytes_read'/3).
+:- impl_defined('$bytes_read'/3).
+:- export('$bytes_write'/2).
+:- impl_defined('$bytes_write'/2).
+:- export('$bytes_read_file'/4).
+:- impl_defined('$bytes_read_file'/4).
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Message digests (see library(digest))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$digest_init'/2).
+:- impl_defined('$digest_init'/2).
+:- export('$digest_update'/3).
+:- impl_defined('$digest_update'/3).
+:- export('$digest_update_stream'/3).
+:- impl_defined('$digest_update_stream'/3).
+:- export('$digest_update_file'/3).
+:- impl_defined('$digest_update_file'/3).
+:- export('$digest_final'/2).
+:- impl_defined('$digest_final'/2).
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Numeric arrays (see library(numarray))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$numarray_new'/3).
+:- impl_defined('$numarray_new'/3).
+:- export('$numarray_from_list'/3).
+:- impl_defined('$numarray_from_list'/3).
+:- export('$numarray_to_list'/2).
+:- impl_defined('$numarray_to_list'/2).
+:- export('$numarray_get'/3).
+:- impl_defined('$numarray_get'/3).
+:- export('$numarray_set'/3).
+:- impl_defined('$numarray_set'/3).
+:- export('$numarray_fill'/2).
+:- impl_defined('$numarray_fill'/2).
+:- export('$numarray_copy'/2).
+:- impl_defined('$numarray_copy'/2).
+:- export('$numarray_op'/4).
+:- impl_defined('$numarray_op'/4).
+:- export('$numarray_reduce'/3).
+:- impl_defined('$numarray_reduce'/3).
+:- export('$numarray_free'/1).
+:- impl_defined('$numarray_free'/1).
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Fibers (see library(fibers/native_fibers))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$fiber_new'/2).
+:- impl_defined('$fiber_new'/2).
+:- export('$fiber_resume'/2).
+:- impl_defined('$fiber_resume'/2).
+:- export('$fiber_result'/2).
+:- impl_defined('$fiber_result'/2).
+:- export('$fiber_yield'/2).
+:- impl_defined('$fiber_yield'/2).
+:- export('$fiber_self'/1).
+:- impl_defined('$fiber_self'/1).
+:- export('$fiber_free'/1).
+:- impl_defined('$fiber_free'/1).
+:- export('$fiber_poll'/3).
+:- impl_defined('$fiber_poll'/3).
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Native code for hot predicates (see library(jit))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$jit_candidate'/2).
+:- impl_defined('$jit_candidate'/2).
+:- export('$jit_hot'/1).
+:- impl_defined('$jit_hot'/1).
+:- export('$jit_install'/3).
+:- impl_defined('$jit_install'/3).
+:- export('$jit_uninstall'/1).
+:- impl_defined('$jit_uninstall'/1).
+:- export('$jit_native'/1).
+:- impl_defined('$jit_native'/1).
+:- export('$jit_aot_stamp'/2).
+:- impl_defined('$jit_aot_stamp'/2).
+:- export('$jit_aot_install'/1).
+:- impl_defined('$jit_aot_install'/1).
+
+:- multifile '$jit_compile_hook'/1.
+:- doc('$jit_compile_hook'(Specs), "Compile to native code the
+   predicates @var{Specs} (a list of @tt{'M:f'/A}), which became hot").
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Native tokenizer (see library(tokenize))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$read_tokens'/4).
+:- impl_defined('$read_tokens'/4).
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Native term writer (see library(write))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$op_update'/5).
+:- impl_defined('$op_update'/5).
+:- export('$write_term'/4).
+:- impl_defined('$write_term'/4).
+:- endif.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Native formatter (see library(format))").
+
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$format'/3).
+:- impl_defined('$format'/3).
 :- endif.
 
 % ---------------------------------------------------------------------------
@@ -759,6 +929,17 @@ where_term(PredName, PredArity, Arg, WhereError) :-
 :- impl_defined('$force_interactive'/0).
 :- endif.
 
+:- if(defined(optim_comp)).
+% TODO:[oc-merge] port to OC
+:- else.
+:- export('$fsync_output'/1).
+:- trust pred '$fsync_output'(Stream) : stream(Stream).
+:- impl_defined('$fsync_output'/1).
+:- export('$stream_is_file'/2).
+:- trust pred '$stream_is_file'(Stream, Path) : (stream(Stream), atm(Path)).
+:- impl_defined('$stream_is_file'/2).
+:- endif.
+
 % ---------------------------------------------------------------------------
 :- doc(section, "Internal for system.pl").
 
@@ -1162,6 +1343,8 @@ po_filename(Base, Name) :- product_filename(prolog_object, Base, Name).
 wam_filename(Base, Name) :- product_filename(prolog_wam, Base, Name).
 :- export(itf_filename/2).
 itf_filename(Base, Name) :- product_filename(prolog_itf, Base, Name).
+:- export(stamp_filename/2). % (see c_itf)
+stamp_filename(Base, Name) :- product_filename(prolog_stamp, Base, Name).
 :- export(asr_filename/2).
 asr_filename(Base, Name) :- product_filename(prolog_assertion, Base, Name).
 :- export(ast_filename/2). % (like .asr, for CiaoPP)
@@ -1285,6 +1468,7 @@ is_dir(Path) :-
 filetype(prolog_object,     '.po',  noarch).
 filetype(prolog_wam,        '.wam', noarch).
 filetype(prolog_itf,        '.itf', noarch).
+filetype(prolog_stamp,      '.stamp', noarch).
 filetype(prolog_assertion,  '.asr', noarch).
 filetype(prolog_assertion2, '.ast', noarch).
 filetype(prolog_testout,    '.testout', noarch).
@@ -1450,6 +1634,18 @@ poversion(version(67)).
 :- endif.
 control_c_handler :- send_signal(control_c).
 
+:- if(defined(optim_comp)).
+:- else.
+:- entry jit_handler/0.
+% (called on a JIT request event, see eng_jit.h)
+jit_handler :-
+    '$jit_hot'(Specs),
+    ( Specs = [] -> true
+    ; '$jit_compile_hook'(Specs) -> true
+    ; true
+    ).
+:- endif.
+
 % ---------------------------------------------------------------------------
 :- doc(section, "Boot the machine").
 
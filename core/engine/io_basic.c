@@ -796,6 +796,38 @@ static CFUN__PROTO(readrune_mb, c_rune_t,
   return r;
 }
 
+/* Rune reading for the native tokenizer (see io_tokenize.c) */
+
+/* Like getct/2 (or getct1/2 if skip_layout) on stream s */
+CFUN__PROTO(getct_rune, c_rune_t, stream_node_t *s, bool_t skip_layout,
+            definition_t *pred_address, int *typ) {
+  return CFUN__EVAL(readrune_mb,s,(skip_layout ? GET1 : GET),pred_address,typ);
+}
+
+/* Like skip_code/1 on stream s, but stops at the end of stream
+   (returns r or RUNE_EOF) */
+CFUN__PROTO(skip_rune, c_rune_t, stream_node_t *s, c_rune_t r,
+            definition_t *pred_address) {
+  c_rune_t r1;
+  do {
+    r1 = CFUN__EVAL(readrune,s,r,pred_address);
+  } while (r1 != r && r1 >= 0);
+  return r1;
+}
+
+/* Like skip_line/0 on stream s */
+CVOID__PROTO(skip_rune_line, stream_node_t *s, definition_t *pred_address) {
+  int r;
+
+  for (r=0; r!=0xa && r!=0xd && r>=0;) {
+    r = CFUN__EVAL(readrune,s,SKIPLN,pred_address);
+  }
+
+  if (r == 0xd) { /* Delete a possible 0xa (win end-of-line) */
+    (void)CFUN__EVAL(readrune,s,DELRET,pred_address);
+  }
+}
+
 CBOOL__PROTO(getct) {
   ERR__FUNCTOR("io_basic:getct", 2);
   c_rune_t r;
@@ -1225,6 +1257,41 @@ CVOID__PROTO(print_string, stream_node_t *stream, char *p) {
   fflush(fileptr);
 }
 
+/* Like print_string() but for a block of len bytes (which may
+   contain nulls). Files are written with a single fwrite() and
+   sockets with as few write() calls as possible. */
+CVOID__PROTO(print_nstring, stream_node_t *stream, const char *p, size_t len) {
+  FILE *fileptr = stream->streamfile;
+  size_t i;
+
+  if (stream->isatty) {
+    stream = root_stream_ptr;
+    /* ignore errors on tty */
+    fwrite(p, 1, len, fileptr);
+  } else if (stream->streammode != 's') { /* not a socket */
+    if (fwrite(p, 1, len, fileptr) < len) {
+      IO_ERROR("fwrite() in print_nstring()");
+    }
+  } else { /* a socket */
+    const char *q = p;
+    size_t left = len;
+    ssize_t n;
+    while (left > 0) {
+      n = write(TaggedToIntmach(stream->label), q, left);
+      if (n < 0) {
+        if (errno == EINTR) continue;
+        IO_ERROR("write() in print_nstring()");
+      }
+      q += n;
+      left -= n;
+    }
+  }
+  for (i = 0; i < len; i++) {
+    inc_counts((unsigned char)p[i], stream);
+  }
+  fflush(fileptr);
+}
+
 /* From HVA/SVA to NUM (for printing) */
 CFUN__PROTO(var_address, tagged_t, tagged_t term) {
   intval_t n;
@@ -1268,6 +1335,58 @@ CVOID__PROTO(print_number, stream_node_t *stream, tagged_t term) {
 
 #define PRINT_CONTROL_RUNE(X) { *bp++ = '\\'; *bp++ = (X); }
 
+/* Write the quoted name of the atom at bp (which must have room for
+   PRINT_ATOM_QUOTED_MAX(atom_len) bytes). Returns the end of the
+   written text (which is not null terminated). */
+char *quote_atom_name(char *bp, atom_t *atomptr) {
+  unsigned char *ch = (unsigned char *)atomptr->name;
+  c_rune_t r;
+      
+  *bp++ = '\'';
+#if defined(FULL_ESCAPE_QUOTED_ATOMS)
+  while ((r = *ch++)) {
+    /* See tokenize.pl for table of symbolic control chars */
+    if (r <= 0x7F && get_rune_class(r) == 0) { /* TODO: only for ASCII, is it OK? */
+      switch (r) {
+      case 7: PRINT_CONTROL_RUNE('a'); break;
+      case 8: PRINT_CONTROL_RUNE('b'); break;
+      case 9: PRINT_CONTROL_RUNE('t'); break;
+      case 10: PRINT_CONTROL_RUNE('n'); break;
+      case 11: PRINT_CONTROL_RUNE('v'); break;
+      case 12: PRINT_CONTROL_RUNE('f'); break;
+      case 13: PRINT_CONTROL_RUNE('r'); break;
+        /* case 27: PRINT_CONTROL_RUNE('e'); break; */
+      case 32: *bp++ = ' '; break;
+        /* case 127: PRINT_CONTROL_RUNE('d'); break; */
+      default:
+        *bp++ = '\\';
+        *bp++ = '0' + ((r >> 6) & 7);
+        *bp++ = '0' + ((r >> 3) & 7);
+        *bp++ = '0' + (r & 7);
+        *bp++ = '\\';
+      }
+    } else {
+      if (r=='\'' || r=='\\') { *bp++ = r; }
+      *bp++ = r;
+    }
+  }
+#else
+  if (atomptr->has_squote) {
+    while ((r = *ch++)) {
+      if (r=='\'' || r=='\\') { *bp++ = r; }
+      *bp++ = r;
+    }
+  } else {
+    while ((r = *ch++)) {
+      if (r=='\\') { *bp++ = r; }
+      *bp++ = r;
+    }
+  }
+#endif
+  *bp++ = '\'';
+  return bp;
+}
+
 CVOID__PROTO(print_atom, stream_node_t *stream, tagged_t term) {
   atom_t *atomptr = TaggedToAtom(term);
 
@@ -1276,52 +1395,7 @@ CVOID__PROTO(print_atom, stream_node_t *stream, tagged_t term) {
   } else {
     // TODO: do not use checkalloc_ARRAY, use the Atom_Buffer instead?! just check the amot length (JFMC)
     char *buf = checkalloc_ARRAY(char, PRINT_ATOM_BUFF_SIZE);
-    unsigned char *ch = (unsigned char *)atomptr->name;
-    char *bp = buf;
-    c_rune_t r;
-      
-    *bp++ = '\'';
-#if defined(FULL_ESCAPE_QUOTED_ATOMS)
-    while ((r = *ch++)) {
-      /* See tokenize.pl for table of symbolic control chars */
-      if (r <= 0x7F && get_rune_class(r) == 0) { /* TODO: only for ASCII, is it OK? */
-        switch (r) {
-        case 7: PRINT_CONTROL_RUNE('a'); break;
-        case 8: PRINT_CONTROL_RUNE('b'); break;
-        case 9: PRINT_CONTROL_RUNE('t'); break;
-        case 10: PRINT_CONTROL_RUNE('n'); break;
-        case 11: PRINT_CONTROL_RUNE('v'); break;
-        case 12: PRINT_CONTROL_RUNE('f'); break;
-        case 13: PRINT_CONTROL_RUNE('r'); break;
-          /* case 27: PRINT_CONTROL_RUNE('e'); break; */
-        case 32: *bp++ = ' '; break;
-          /* case 127: PRINT_CONTROL_RUNE('d'); break; */
-        default:
-          *bp++ = '\\';
-          *bp++ = '0' + ((r >> 6) & 7);
-          *bp++ = '0' + ((r >> 3) & 7);
-          *bp++ = '0' + (r & 7);
-          *bp++ = '\\';
-        }
-      } else {
-        if (r=='\'' || r=='\\') { *bp++ = r; }
-        *bp++ = r;
-      }
-    }
-#else
-    if (atomptr->has_squote) {
-      while ((r = *ch++)) {
-        if (r=='\'' || r=='\\') { *bp++ = r; }
-        *bp++ = r;
-      }
-    } else {
-      while ((r = *ch++)) {
-        if (r=='\\') { *bp++ = r; }
-        *bp++ = r;
-      }
-    }
-#endif
-    *bp++ = '\'';
+    char *bp = quote_atom_name(buf, atomptr);
     *bp++ = 0;
     CVOID__CALL(print_string, stream, buf);
     // TODO: do not use checkalloc_ARRAY, use the Atom_Buffer instead?! just check the atom length (JFMC)
@@ -1862,15 +1936,29 @@ CBOOL__PROTO(prolog_display_string) {
  * total number of digits for some FORMATS.
  */
 
-#define MAX_OUTPUT_DIGITS 1023
-#define BUFF_SIZE         2048
 
 /* See format.pl documentation, using the underlying C printf
    implementation is the expected behavior */
+/* Text of f as printed by prolog_format_print_float() (b must have
+   room for FORMAT_FLOAT_SIZE bytes) */
+void format_float_to_string(char *b, char format_ch, flt64_t f, int precision) {
+  char fmtstr[16];
+
+  /* Limit precision */
+  if (precision > 1023) {
+    precision = 1023;
+  } else if (precision<0) {
+    precision = 6; /* default printf precision */
+  }
+
+  /* Assume format_ch in {'e','E','f','g','G'} */
+  snprintf(fmtstr, 16, "%%.%d%c", precision, format_ch);
+  snprintf(b, FORMAT_FLOAT_SIZE, fmtstr, f);
+}
+
 CBOOL__PROTO(prolog_format_print_float) {
   int precision;
-  char fmtstr[16];
-  char b[BUFF_SIZE];
+  char b[FORMAT_FLOAT_SIZE];
   char format_ch;
   flt64_t f;
 
@@ -1882,16 +1970,7 @@ CBOOL__PROTO(prolog_format_print_float) {
   
   f = TaggedToFloat(X(1));
 
-  /* Limit precision */
-  if (precision > 1023) {
-    precision = 1023;
-  } else if (precision<0) {
-    precision = 6; /* default printf precision */
-  }
-
-  /* Assume format_ch in {'e','E','f','g','G'} */
-  snprintf(fmtstr, 16, "%%.%d%c", precision, format_ch);
-  snprintf(b, BUFF_SIZE, fmtstr, f);
+  format_float_to_string(b, format_ch, f, precision);
   CVOID__CALL(print_string, Output_Stream_Ptr, b);
 
   CBOOL__PROCEED;
@@ -1916,7 +1995,6 @@ extern liveinfo_t prolog_format_print_integer__liveinfo;
 CBOOL__PROTO(prolog_format_print_integer) {
   char formatChar;
   int precision;
-  int base;
   
   DEREF(X(0),X(0));
   formatChar = GetSmall(X(0));
@@ -1924,6 +2002,20 @@ CBOOL__PROTO(prolog_format_print_integer) {
   DEREF(X(2),X(2));
   precision = TaggedToIntmach(X(2));
 
+  if (IsFloat(X(1))) { /* TODO: fail? format.pl ensures that this never happens */
+    w->liveinfo = prolog_format_print_integer__liveinfo;
+    X(1) = CFUN__EVAL(fu1_integer, X(1));
+  }
+  CVOID__CALL(format_integer_to_string, formatChar, X(1), precision);
+  CVOID__CALL(print_string, Output_Stream_Ptr, Atom_Buffer);
+  CBOOL__PROCEED;
+}
+
+/* Leave in Atom_Buffer the text of the integer t as printed by
+   prolog_format_print_integer() */
+CVOID__PROTO(format_integer_to_string, char formatChar, tagged_t t, int precision) {
+  int base;
+
   if (formatChar=='r')
     base = ((precision<2 || precision>36) ? 8 : precision);
   else if (formatChar=='R')
@@ -1931,11 +2023,7 @@ CBOOL__PROTO(prolog_format_print_integer) {
   else
     base = 10;
 
-  if (IsFloat(X(1))) { /* TODO: fail? format.pl ensures that this never happens */
-    w->liveinfo = prolog_format_print_integer__liveinfo;
-    X(1) = CFUN__EVAL(fu1_integer, X(1));
-  }
-  CVOID__CALL(number_to_string, X(1), base);
+  CVOID__CALL(number_to_string, t, base);
   
   if ((formatChar=='d' || formatChar=='D') && precision > 0)
     {
@@ -2040,6 +2128,4 @@ CBOOL__PROTO(prolog_format_print_integer) {
         }
     }
   
-  CVOID__CALL(print_string, Output_Stream_Ptr, Atom_Buffer);
-  CBOOL__PROCEED;
 }
@@ -31,6 +31,18 @@ CVOID__PROTO(display_term, tagged_t term, stream_node_t *stream, bool_t quoted);
 })
 
 CVOID__PROTO(print_string, stream_node_t *stream, char *p);
+CVOID__PROTO(print_nstring, stream_node_t *stream, const char *p, size_t len);
+
+/* Upper bound of the size of a quoted atom name of Len bytes */
+#define PRINT_ATOM_QUOTED_MAX(Len) (5*(Len)+2)
+char *quote_atom_name(char *bp, atom_t *atomptr);
+
+CFUN__PROTO(var_address, tagged_t, tagged_t term);
+
+/* Text of format/2 numeric directives (see format.pl) */
+#define FORMAT_FLOAT_SIZE 2048
+void format_float_to_string(char *b, char format_ch, flt64_t f, int precision);
+CVOID__PROTO(format_integer_to_string, char formatChar, tagged_t t, int precision);
 
 /* --------------------------------------------------------------------------- */
 
@@ -73,6 +85,14 @@ int c_mblen(const char *s);
 int c_mbstrlen(const char * s);
 #endif
 
+/* --------------------------------------------------------------------------- */
+
+CFUN__PROTO(getct_rune, c_rune_t, stream_node_t *s, bool_t skip_layout,
+            definition_t *pred_address, int *typ);
+CFUN__PROTO(skip_rune, c_rune_t, stream_node_t *s, c_rune_t r,
+            definition_t *pred_address);
+CVOID__PROTO(skip_rune_line, stream_node_t *s, definition_t *pred_address);
+
 void print_syserror(char *s); /* TODO: move somewhere else? */ 
 
 #endif /* _CIAO_IO_BASIC_H */
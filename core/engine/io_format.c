@@ -0,0 +1,376 @@
+/*
+ *  io_format.c
+ *
+ *  Native formatter for format/2,3 (see library(format))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/io_basic.h>
+#include <ciao/eng_registry.h>
+#include <ciao/io_write.h>
+#include <ciao/io_format.h>
+
+#include <string.h>
+
+/* This executes the directive lists built by fmt_compile/2 in
+   library(format) and must print exactly what fmt_print/4 prints for
+   the same control and arguments. The elements of a directive list
+   are:
+
+     Atom     literal text
+     C        directive ~C (with its default numeric argument)
+     d(C,N)   directive ~NC (N is an integer or '*')
+
+   The arguments are checked in a first pass, so that '$format'/3
+   fails without writing anything when some directive cannot be
+   handled here (format.pl then uses the Prolog code, which also
+   reports the errors). Output is collected in the buffer of the
+   native writer (see io_write.c), which also writes the terms for
+   ~w, ~q and ~k. */
+
+typedef struct fmtr_ fmtr_t;
+struct fmtr_ {
+  wt_t wt;
+  bool_t write_ok; /* write ~w, ~q and ~k here */
+  bool_t columns; /* there are column directives (~|, ~+, ~N) */
+  /* line counters of the output (when columns is set) */
+  stream_node_t *cs; /* stream with the counters */
+  intmach_t scanned; /* bytes of the buffer already counted */
+  intmach_t nl_count; /* line count after the scanned bytes */
+  intmach_t last_nl; /* offset after the last newline (or -1) */
+  int previous;
+};
+
+static tagged_t functor_d;
+static tagged_t atom_star;
+static tagged_t atom_none;
+static bool_t fmt_atoms_ready = FALSE;
+
+static void fmt_init_atoms(void) {
+  if (fmt_atoms_ready) return;
+  functor_d = SetArity(GET_ATOM("d"), 2);
+  atom_star = GET_ATOM("*");
+  atom_none = GET_ATOM("none");
+  fmt_atoms_ready = TRUE;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Line counters (see inc_counts() in io_basic.c) */
+
+static void fmt_scan(fmtr_t *f) {
+  wt_t *wt = &f->wt;
+  intmach_t i;
+  int c;
+
+  for (i = f->scanned; i < wt->len; i++) {
+    c = (unsigned char)wt->buf[i];
+    if (c == 0xd) {
+      f->last_nl = i + 1;
+      f->nl_count++;
+    } else if (c == 0xa) {
+      f->last_nl = i + 1;
+      if (f->previous != 0xd) f->nl_count++;
+    }
+    f->previous = c;
+  }
+  f->scanned = wt->len;
+}
+
+/* line_count/2 */
+static intmach_t fmt_line_count(fmtr_t *f) {
+  fmt_scan(f);
+  return f->nl_count;
+}
+
+/* line_position/2 */
+static intmach_t fmt_line_position(fmtr_t *f) {
+  fmt_scan(f);
+  if (f->last_nl >= 0) return f->wt.len - f->last_nl;
+  return f->cs->rune_count - f->cs->last_nl_pos + f->wt.len;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Directives */
+
+/* Decode a directive (returns FALSE for literal text) */
+static inline bool_t fmt_directive(tagged_t item, int *c, tagged_t *n) {
+  tagged_t x;
+  if (TaggedIsSmall(item)) {
+    *c = GetSmall(item);
+    *n = 0;
+    return TRUE;
+  }
+  if (TaggedIsSTR(item) && TaggedToHeadfunctor(item) == functor_d) {
+    DerefArg(x, item, 1);
+    *c = GetSmall(x);
+    DerefArg(*n, item, 2);
+    return TRUE;
+  }
+  return FALSE;
+}
+
+/* Default numeric argument (see fmt_parse//6 in format.pl) */
+static intmach_t fmt_default(int c) {
+  switch (c) {
+  case 'e': case 'E': case 'f': case 'g': case 'G': return 6;
+  case 'd': case 'D': return 0;
+  case 'r': case 'R': case '+': return 8;
+  case 't': return ' ';
+  case '|': case 's': return 0; /* (not used) */
+  default: return 1;
+  }
+}
+
+/* Next argument (or 0 if there are no more) */
+static inline tagged_t fmt_next_arg(tagged_t *args) {
+  tagged_t a;
+  if (!TaggedIsLST(*args)) return 0;
+  DerefCar(a, *args);
+  DerefCdr(*args, *args);
+  return a;
+}
+
+/* Character codes that put_code/1 accepts (and writes as one byte) */
+static inline bool_t fmt_is_code(tagged_t t) {
+  return TaggedIsSmall(t) && GetSmall(t) >= 0 && GetSmall(t) <= 255;
+}
+
+/* Set the writer options for ~w, ~q and ~k */
+static void fmt_write_options(fmtr_t *f, int c) {
+  f->wt.quoted = (c != 'w');
+  f->wt.ignore_ops = (c == 'k') ? WT_NO_OPS : WT_OPS;
+  f->wt.numbervars = (c != 'k');
+}
+
+/* Length of a list of character codes (or -1) */
+static intmach_t fmt_codes_length(tagged_t l) {
+  tagged_t c;
+  intmach_t n = 0;
+  while (TaggedIsLST(l)) {
+    DerefCar(c, l);
+    if (!fmt_is_code(c)) return -1;
+    n++;
+    DerefCdr(l, l);
+  }
+  return (l == atom_nil) ? n : -1;
+}
+
+/* First pass: check the directives and arguments */
+static bool_t fmt_check(fmtr_t *f, tagged_t items, tagged_t args) {
+  tagged_t item, n, a;
+  intmach_t k;
+  int c;
+
+  while (TaggedIsLST(items)) {
+    DerefCar(item, items);
+    DerefCdr(items, items);
+    if (!fmt_directive(item, &c, &n)) {
+      if (!TaggedIsATM(item)) return FALSE;
+      continue;
+    }
+    if (n == 0) {
+      k = fmt_default(c);
+    } else if (n == atom_star) {
+      if ((a = fmt_next_arg(&args)) == 0 || !TaggedIsSmall(a)) return FALSE;
+      k = GetSmall(a);
+    } else if (TaggedIsSmall(n)) {
+      k = GetSmall(n);
+    } else {
+      return FALSE;
+    }
+    switch (c) {
+    case '~': case 'N': case 'i': case 'a': case 'k': case 'q': case 'w':
+      if (k != 1) return FALSE;
+      break;
+    case 'c': case 'n': case 's': case '|': case '+':
+      if (k < 0) return FALSE;
+      break;
+    case 't':
+      if (k < 0 || k > 255) return FALSE;
+      break;
+    }
+    switch (c) {
+    case '~': case 'n': case 't':
+      break;
+    case 'N': case '|': case '+':
+      f->columns = TRUE;
+      break;
+    case 'i':
+      if (fmt_next_arg(&args) == 0) return FALSE;
+      break;
+    case 'a':
+      if ((a = fmt_next_arg(&args)) == 0 || !TaggedIsATM(a)) return FALSE;
+      break;
+    case 'c':
+      if ((a = fmt_next_arg(&args)) == 0 || !fmt_is_code(a)) return FALSE;
+      break;
+    case 'e': case 'E': case 'f': case 'g': case 'G':
+      if ((a = fmt_next_arg(&args)) == 0 || !(TaggedIsSmall(a) || IsFloat(a))) return FALSE;
+      break;
+    case 'd': case 'D': case 'r': case 'R':
+      if ((a = fmt_next_arg(&args)) == 0 || !IsInteger(a)) return FALSE;
+      break;
+    case 's':
+      if ((a = fmt_next_arg(&args)) == 0 || fmt_codes_length(a) < 0) return FALSE;
+      break;
+    case 'k': case 'q': case 'w':
+      if (!f->write_ok || (a = fmt_next_arg(&args)) == 0) return FALSE;
+      fmt_write_options(f, c);
+      if (!wt_check(&f->wt, a)) return FALSE;
+      break;
+    default: /* (including ~p, for portray hooks) */
+      return FALSE;
+    }
+  }
+  return (items == atom_nil && args == atom_nil);
+}
+
+/* putn/2 */
+static inline void fmt_putn(fmtr_t *f, intmach_t n, int c) {
+  wt_ensure(&f->wt, n);
+  memset(f->wt.buf + f->wt.len, c, n);
+  f->wt.len += n;
+}
+
+/* Second pass: write the output (see fmt_print/5) */
+static CVOID__PROTO(fmt_print, fmtr_t *f, tagged_t items, tagged_t args) {
+  wt_t *wt = &f->wt;
+  tagged_t item, n, a;
+  intmach_t k, tab, pos, lc = 0, len;
+  int c, fill;
+  atom_t *atomptr;
+  char b[FORMAT_FLOAT_SIZE];
+
+  tab = 0;
+  fill = ' ';
+  while (TaggedIsLST(items)) {
+    DerefCar(item, items);
+    DerefCdr(items, items);
+    if (!fmt_directive(item, &c, &n)) {
+      atomptr = TaggedToAtom(item);
+      wt_puts(wt, atomptr->name, atomptr->atom_len);
+      if (memchr(atomptr->name, '\n', atomptr->atom_len) != NULL) {
+        tab = 0;
+        fill = ' ';
+      }
+      continue;
+    }
+    if (n == 0) {
+      k = fmt_default(c);
+    } else if (n == atom_star) {
+      k = GetSmall(fmt_next_arg(&args));
+    } else {
+      k = GetSmall(n);
+    }
+    switch (c) {
+    case '~':
+      wt_put(wt, '~');
+      continue;
+    case 't':
+      fill = k;
+      continue;
+    case 'N': case '|': case '+':
+      pos = fmt_line_position(f);
+      if (c == 'N') {
+        k = 0;
+      } else if (c == '|') {
+        if (n == 0) k = pos; /* (column at the current position) */
+      } else {
+        k += tab;
+      }
+      tab = k;
+      if (pos > tab) {
+        wt_put(wt, '\n');
+        fmt_putn(f, tab, fill);
+      } else {
+        fmt_putn(f, tab - pos, fill);
+      }
+      continue;
+    case 'i':
+      (void)fmt_next_arg(&args);
+      continue;
+    }
+    /* spec(X,A,N) */
+    if (f->columns) lc = fmt_line_count(f);
+    if (c == 'n') {
+      fmt_putn(f, k, '\n');
+    } else {
+      a = fmt_next_arg(&args);
+      switch (c) {
+      case 'a':
+        atomptr = TaggedToAtom(a);
+        wt_puts(wt, atomptr->name, atomptr->atom_len);
+        break;
+      case 'c':
+        fmt_putn(f, k, GetSmall(a));
+        break;
+      case 'e': case 'E': case 'f': case 'g': case 'G':
+        format_float_to_string(b, c, TaggedIsSmall(a) ? (flt64_t)GetSmall(a) : TaggedToFloat(a), k);
+        wt_puts(wt, b, strlen(b));
+        break;
+      case 'd': case 'D': case 'r': case 'R':
+        CVOID__CALL(format_integer_to_string, c, a, k);
+        wt_puts(wt, Atom_Buffer, strlen(Atom_Buffer));
+        break;
+      case 's':
+        if (n == 0) k = fmt_codes_length(a);
+        for (len = 0; len < k && TaggedIsLST(a); len++) {
+          wt_put(wt, GetSmall(fmt_next_arg(&a)));
+        }
+        fmt_putn(f, k - len, ' ');
+        break;
+      case 'k': case 'q': case 'w':
+        fmt_write_options(f, c);
+        CVOID__CALL(wt_write, wt, a, 1200);
+        break;
+      }
+    }
+    if (!f->columns) {
+      if (wt->len > WT_FLUSH_SIZE) CVOID__CALL(wt_flush, wt);
+    } else if (fmt_line_count(f) != lc) {
+      tab = 0;
+      fill = ' ';
+    }
+  }
+}
+
+/* '$format'(+Items, ?Args, +WriteStrings): print Args with the
+   directive list Items (see above) to the current output.
+   WriteStrings is the value of the write_strings flag, or 'none' if
+   ~w, ~q and ~k must be left to the Prolog code. Fails without
+   writing anything if the Prolog code must be used. */
+CBOOL__PROTO(prolog_format) {
+  fmtr_t f_;
+  fmtr_t *f = &f_;
+  tagged_t items, args, x;
+  stream_node_t *s;
+
+  fmt_init_atoms();
+  wt_init_atoms();
+  DEREF(items, X(0));
+  DEREF(args, X(1));
+  DEREF(x, X(2));
+  f->write_ok = (x != atom_none);
+  f->wt.write_strings = (x == atom_on);
+  f->wt.limit = 1000000;
+  f->wt.varnames = atom_nil;
+  f->columns = FALSE;
+  CBOOL__TEST(fmt_check(f, items, args));
+
+  s = Output_Stream_Ptr;
+  wt_open(&f->wt, s);
+  if (f->columns) {
+    /* (keep the whole output in the buffer to compute the columns) */
+    f->wt.flush_size = INTMACH_MAX;
+    f->cs = s->isatty ? root_stream_ptr : s;
+    f->scanned = 0;
+    f->nl_count = f->cs->nl_count;
+    f->last_nl = -1;
+    f->previous = f->cs->previous_rune;
+  }
+  CVOID__CALL(fmt_print, f, items, args);
+  CVOID__CALL(wt_close, &f->wt);
+  CBOOL__PROCEED;
+}
@@ -0,0 +1,16 @@
+/*
+ *  io_format.h
+ *
+ *  Native formatter for format/2,3 (see library(format))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_IO_FORMAT_H
+#define _CIAO_IO_FORMAT_H
+
+#include <ciao/eng.h>
+
+CBOOL__PROTO(prolog_format);
+
+#endif /* _CIAO_IO_FORMAT_H */
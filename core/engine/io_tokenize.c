@@ -0,0 +1,1144 @@
+/*
+ *  io_tokenize.c
+ *
+ *  Native tokenizer for read_term (see library(tokenize))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/io_basic.h>
+#include <ciao/eng_registry.h>
+#include <ciao/eng_gc.h>
+#include <ciao/atomic_basic.h> /* string_to_number */
+#include <ciao/io_tokenize.h>
+
+#include <setjmp.h>
+#include <string.h>
+
+/* This is a C version of read_tokens/2 in library(tokenize) (see
+   that module for the token grammar). It must produce exactly the
+   same tokens and consume exactly the same characters. The
+   dictionary of variables is returned as a list of v(Name,Var,Count)
+   (in order of first occurrence) so that library(tokenize) can
+   replay dic_lookup/3 and check_singleton/2 on it.
+
+   Characters are read with getct_rune() (which pulls runes directly
+   from the stream buffer). Tokens are collected in C buffers and the
+   token list is built on the heap at the end, after a single heap
+   overflow check. Documentation comments and curly blocks are not
+   supported here (the Prolog tokenizer is used instead).
+
+   The operator precedence parser (library(read)) stays in Prolog.
+   Operators are not the obstacle (io_write.c keeps a C mirror of
+   current_op/5, updated by '$op_update'/5, that a parser could
+   share), but the parser backtracks over alternative readings of
+   operators and reports syntax errors with the remaining tokens, and
+   a C version would have to reproduce both exactly. */
+
+definition_t *address_read_tokens;
+
+/* Values for the character_escapes flag */
+#define TK_CEF_OFF 0
+#define TK_CEF_ISO 1
+#define TK_CEF_SICSTUS 2
+
+/* Exit codes of tk_run() */
+#define TK_OK 0
+#define TK_FAIL 1
+#define TK_PAST_EOF 2
+#define TK_ERROR 3 /* exception raised while reading (e.g., I/O error) */
+
+/* Token kinds */
+#define TK_PUNCT 0 /* the atom itself (',', '(', '.', etc.) */
+#define TK_ATOM 1 /* atom(A) */
+#define TK_BADATOM 2 /* badatom(Codes) */
+#define TK_STRING 3 /* string(Bytes) */
+#define TK_VAR 4 /* var(V,Name) (anonymous if index<0) */
+#define TK_NUMBER 5 /* number(N), from text (base 0 is current radix) */
+#define TK_INT 6 /* number(N), from value */
+#define TK_UNEXPECTED 7 /* unexpected(C) */
+
+typedef struct tk_token_ tk_token_t;
+struct tk_token_ {
+  int kind;
+  tagged_t atm; /* TK_PUNCT and TK_ATOM */
+  intmach_t off; /* text (codes or nbuf) offset or variable index */
+  intmach_t len; /* text length or base */
+  int64_t val; /* TK_INT and TK_UNEXPECTED */
+};
+
+typedef struct tk_var_ tk_var_t;
+struct tk_var_ {
+  intmach_t off; /* name (in codes) */
+  intmach_t len;
+  intmach_t count;
+  tagged_t var; /* (when building) */
+  tagged_t name;
+};
+
+/* Growable array */
+#define TK_BUF(Type, Name) Type *Name; intmach_t Name##_len; intmach_t Name##_cap
+
+#define TK_BUF_INIT(Type, Name, Cap) ({ \
+  tk->Name = checkalloc_ARRAY(Type, (Cap)); \
+  tk->Name##_len = 0; \
+  tk->Name##_cap = (Cap); \
+})
+
+#define TK_BUF_FREE(Type, Name) \
+  checkdealloc_ARRAY(Type, tk->Name##_cap, tk->Name)
+
+#define TK_BUF_ENSURE(Type, Name, N) ({ \
+  if (tk->Name##_len + (N) > tk->Name##_cap) { \
+    intmach_t cap = tk->Name##_cap * 2; \
+    while (tk->Name##_len + (N) > cap) cap *= 2; \
+    tk->Name = checkrealloc_ARRAY(Type, tk->Name##_cap, cap, tk->Name); \
+    tk->Name##_cap = cap; \
+  } \
+})
+
+#define TK_BUF_PUSH(Type, Name, X) ({ \
+  TK_BUF_ENSURE(Type, Name, 1); \
+  tk->Name[tk->Name##_len++] = (X); \
+})
+
+typedef struct tkz_ tkz_t;
+struct tkz_ {
+  stream_node_t *s;
+  c_rune_t ch; /* current character */
+  int typ; /* and its class */
+  int cef; /* character_escapes */
+  tagged_t second_prompt;
+  jmp_buf env;
+  bool_t past_eof_getct1; /* (for the error) */
+  TK_BUF(tk_token_t, toks);
+  TK_BUF(int64_t, runes); /* text of the current token */
+  TK_BUF(int64_t, codes); /* strings, badatoms and variable names */
+  TK_BUF(char, nbuf); /* text of numbers (null terminated) */
+  TK_BUF(char, abuf); /* atom names */
+  TK_BUF(tk_var_t, vars);
+  intmach_t *vhash; /* variable hash table (-1 for empty) */
+  intmach_t vhash_size;
+  intmach_t cells; /* heap cells needed for the result */
+  intmach_t nstart; /* start of the current number text */
+};
+
+static tagged_t functor_atom;
+static tagged_t functor_badatom;
+static tagged_t functor_number;
+static tagged_t functor_string;
+static tagged_t functor_var;
+static tagged_t functor_unexpected;
+static tagged_t functor_v;
+static tagged_t atom_tk_open;
+static tagged_t atom_tk_open_ws;
+static tagged_t atom_tk_close;
+static tagged_t atom_tk_comma;
+static tagged_t atom_tk_lbracket;
+static tagged_t atom_tk_rbracket;
+static tagged_t atom_tk_bar;
+static tagged_t atom_tk_lcurly;
+static tagged_t atom_tk_rcurly;
+static tagged_t atom_tk_dot;
+static tagged_t atom_tk_eof_comment;
+static tagged_t atom_tk_empty_parens;
+static tagged_t atom_tk_cut;
+static tagged_t atom_tk_semicolon;
+static bool_t tk_atoms_ready = FALSE;
+
+static void tk_init_atoms(void) {
+  if (tk_atoms_ready) return;
+  functor_atom = SetArity(GET_ATOM("atom"), 1);
+  functor_badatom = SetArity(GET_ATOM("badatom"), 1);
+  functor_number = SetArity(GET_ATOM("number"), 1);
+  functor_string = SetArity(GET_ATOM("string"), 1);
+  functor_var = SetArity(GET_ATOM("var"), 2);
+  functor_unexpected = SetArity(GET_ATOM("unexpected"), 1);
+  functor_v = SetArity(GET_ATOM("v"), 3);
+  atom_tk_open = GET_ATOM("(");
+  atom_tk_open_ws = GET_ATOM(" (");
+  atom_tk_close = GET_ATOM(")");
+  atom_tk_comma = GET_ATOM(",");
+  atom_tk_lbracket = GET_ATOM("[");
+  atom_tk_rbracket = GET_ATOM("]");
+  atom_tk_bar = GET_ATOM("|");
+  atom_tk_lcurly = GET_ATOM("{");
+  atom_tk_rcurly = GET_ATOM("}");
+  atom_tk_dot = GET_ATOM(".");
+  atom_tk_eof_comment = GET_ATOM("/* ...");
+  atom_tk_empty_parens = GET_ATOM("()");
+  atom_tk_cut = GET_ATOM("!");
+  atom_tk_semicolon = GET_ATOM(";");
+  tk_atoms_ready = TRUE;
+}
+
+/* Cells for a boxed number (see make_integer() and make_float()) */
+#define TK_NUMBER_CELLS 4
+
+/* --------------------------------------------------------------------------- */
+/* Reading characters */
+
+#define TK_GET() CVOID__CALL(tk_get, tk, FALSE)
+#define TK_GET1() CVOID__CALL(tk_get, tk, TRUE)
+
+/* getct/2 (or getct1/2) */
+static CVOID__PROTO(tk_get, tkz_t *tk, bool_t skip_layout) {
+  tk->ch = CFUN__EVAL(getct_rune, tk->s, skip_layout, address_read_tokens, &tk->typ);
+  if (tk->ch == RUNE_PAST_EOF) {
+    tk->past_eof_getct1 = skip_layout;
+    longjmp(tk->env, TK_PAST_EOF);
+  }
+}
+
+static void tk_fail(tkz_t *tk) {
+  longjmp(tk->env, TK_FAIL);
+}
+
+/* --------------------------------------------------------------------------- */
+/* Emitting tokens */
+
+static tk_token_t *tk_push(tkz_t *tk, int kind, intmach_t cells) {
+  tk_token_t *t;
+  TK_BUF_ENSURE(tk_token_t, toks, 1);
+  t = &tk->toks[tk->toks_len++];
+  t->kind = kind;
+  tk->cells += LSTCELLS + cells;
+  return t;
+}
+
+static void tk_emit_punct(tkz_t *tk, tagged_t atm) {
+  tk_push(tk, TK_PUNCT, 0)->atm = atm;
+}
+
+static void tk_emit_atom(tkz_t *tk, tagged_t atm) {
+  tk_push(tk, TK_ATOM, 2)->atm = atm;
+}
+
+static void tk_emit_int(tkz_t *tk, int64_t val) {
+  tk_push(tk, TK_INT, 2+TK_NUMBER_CELLS)->val = val;
+}
+
+static void tk_emit_unexpected(tkz_t *tk, int64_t val) {
+  tk_push(tk, TK_UNEXPECTED, 2)->val = val;
+}
+
+/* UTF8 encoding of a code (see rune_encode/3 in engine(io_basic));
+   returns FALSE if it cannot be encoded */
+#define TK_ENCODE(C, PUSH) ({ \
+  int64_t c_ = (C); \
+  bool_t ok_ = TRUE; \
+  if (c_ <= 0x7F) { \
+    PUSH(c_); \
+  } else if (c_ <= 0x7FF) { \
+    PUSH(0xC0|((c_>>6)&0x1F)); \
+    PUSH((c_&0x3F)|0x80); \
+  } else if (c_ <= 0xFFFF) { \
+    PUSH(0xE0|((c_>>12)&0xF)); \
+    PUSH(((c_>>6)&0x3F)|0x80); \
+    PUSH((c_&0x3F)|0x80); \
+  } else if (c_ <= 0x10FFFF) { \
+    PUSH(0xF0|((c_>>18)&0x7)); \
+    PUSH(((c_>>12)&0x3F)|0x80); \
+    PUSH(((c_>>6)&0x3F)|0x80); \
+    PUSH((c_&0x3F)|0x80); \
+  } else { \
+    ok_ = FALSE; \
+  } \
+  ok_; \
+})
+
+#define TK_PUSH_ABUF(X) TK_BUF_PUSH(char, abuf, (char)(X))
+#define TK_PUSH_CODES(X) TK_BUF_PUSH(int64_t, codes, (X))
+
+/* atom_token/2: an atom from the current text (or a badatom if it
+   contains codes that cannot be encoded) */
+static void tk_emit_atom_text(tkz_t *tk) {
+  intmach_t i;
+  tk_token_t *t;
+
+  tk->abuf_len = 0;
+  for (i = 0; i < tk->runes_len; i++) {
+    if (!TK_ENCODE(tk->runes[i], TK_PUSH_ABUF)) goto bad;
+  }
+  TK_PUSH_ABUF(0);
+  tk_emit_atom(tk, GET_ATOM(tk->abuf));
+  return;
+ bad:
+  t = tk_push(tk, TK_BADATOM, 2 + (LSTCELLS+TK_NUMBER_CELLS)*tk->runes_len);
+  t->off = tk->codes_len;
+  t->len = tk->runes_len;
+  TK_BUF_ENSURE(int64_t, codes, tk->runes_len);
+  memcpy(tk->codes + tk->codes_len, tk->runes, tk->runes_len * sizeof(int64_t));
+  tk->codes_len += tk->runes_len;
+}
+
+/* A string from the current text (fails like string_bytes/2 if it
+   contains codes that cannot be encoded) */
+static void tk_emit_string_text(tkz_t *tk) {
+  intmach_t i, off;
+  tk_token_t *t;
+
+  off = tk->codes_len;
+  for (i = 0; i < tk->runes_len; i++) {
+    if (!TK_ENCODE(tk->runes[i], TK_PUSH_CODES)) tk_fail(tk);
+  }
+  t = tk_push(tk, TK_STRING, 2 + LSTCELLS*(tk->codes_len - off));
+  t->off = off;
+  t->len = tk->codes_len - off;
+}
+
+static intmach_t tk_var_hash(int64_t *s, intmach_t len) {
+  uintmach_t h = 5381;
+  intmach_t i;
+  for (i = 0; i < len; i++) h = h * 33 + (uintmach_t)s[i];
+  return (intmach_t)h;
+}
+
+static void tk_vhash_insert(tkz_t *tk, intmach_t k) {
+  tk_var_t *v = &tk->vars[k];
+  intmach_t mask = tk->vhash_size - 1;
+  intmach_t j = tk_var_hash(tk->codes + v->off, v->len) & mask;
+  while (tk->vhash[j] >= 0) j = (j + 1) & mask;
+  tk->vhash[j] = k;
+}
+
+/* dic_lookup/3 and check_singleton/2: a variable with the current
+   text as name ("_" is anonymous, unless always_named) */
+static void tk_emit_var_text(tkz_t *tk, bool_t always_named) {
+  intmach_t i, off, len, mask, j, k;
+  tk_token_t *t;
+  tk_var_t *v;
+
+  off = tk->codes_len;
+  for (i = 0; i < tk->runes_len; i++) {
+    (void)TK_ENCODE(tk->runes[i], TK_PUSH_CODES); /* (always valid) */
+  }
+  len = tk->codes_len - off;
+
+  if (!always_named && len == 1 && tk->codes[off] == '_') {
+    tk->codes_len = off;
+    t = tk_push(tk, TK_VAR, 3 + 1 + LSTCELLS);
+    t->off = -1;
+    return;
+  }
+
+  mask = tk->vhash_size - 1;
+  j = tk_var_hash(tk->codes + off, len) & mask;
+  while ((k = tk->vhash[j]) >= 0) {
+    v = &tk->vars[k];
+    if (v->len == len &&
+        memcmp(tk->codes + v->off, tk->codes + off, len * sizeof(int64_t)) == 0) {
+      tk->codes_len = off; /* (reuse the name) */
+      v->count++;
+      goto found;
+    }
+    j = (j + 1) & mask;
+  }
+
+  /* New variable */
+  k = tk->vars_len;
+  TK_BUF_ENSURE(tk_var_t, vars, 1);
+  v = &tk->vars[tk->vars_len++];
+  v->off = off;
+  v->len = len;
+  v->count = 1;
+  /* (variable, name, and entry in the list of variables) */
+  tk->cells += 1 + LSTCELLS*len + LSTCELLS + 4;
+  if (2 * tk->vars_len > tk->vhash_size) { /* grow and rehash */
+    checkdealloc_ARRAY(intmach_t, tk->vhash_size, tk->vhash);
+    tk->vhash_size *= 2;
+    tk->vhash = checkalloc_ARRAY(intmach_t, tk->vhash_size);
+    for (j = 0; j < tk->vhash_size; j++) tk->vhash[j] = -1;
+    for (j = 0; j < tk->vars_len; j++) tk_vhash_insert(tk, j);
+  } else {
+    tk_vhash_insert(tk, k);
+  }
+ found:
+  t = tk_push(tk, TK_VAR, 3);
+  t->off = k;
+}
+
+#define TK_PUSH_RUNE(X) TK_BUF_PUSH(int64_t, runes, (X))
+
+/* Text of numbers */
+
+static void tk_num_start(tkz_t *tk) {
+  tk->nstart = tk->nbuf_len;
+}
+
+static void tk_num_push(tkz_t *tk, c_rune_t c) {
+  /* (like atom_codes/2, codes are truncated to bytes) */
+  TK_BUF_PUSH(char, nbuf, (char)c);
+}
+
+static void tk_num_discard(tkz_t *tk) {
+  tk->nbuf_len = tk->nstart;
+}
+
+static void tk_num_emit(tkz_t *tk, int base) {
+  tk_token_t *t;
+  intmach_t len = tk->nbuf_len - tk->nstart;
+  TK_BUF_PUSH(char, nbuf, 0);
+  /* (one cell per digit is enough for any bignum) */
+  t = tk_push(tk, TK_NUMBER, 2 + TK_NUMBER_CELLS + len);
+  t->off = tk->nstart;
+  t->len = base;
+}
+
+static void tk_num_emit_text(tkz_t *tk, char *text) {
+  tk_num_start(tk);
+  while (*text) tk_num_push(tk, *text++);
+  tk_num_emit(tk, 0);
+}
+
+/* --------------------------------------------------------------------------- */
+/* Tokenizer */
+
+/* read_name/5 */
+static CVOID__PROTO(tk_read_name, tkz_t *tk) {
+  while (tk->typ == RUNETY_LOWERCASE || tk->typ == RUNETY_UPPERCASE ||
+         tk->typ == RUNETY_DIGIT || tk->typ == RUNETY_IDCONT) {
+    TK_PUSH_RUNE(tk->ch);
+    TK_GET();
+  }
+}
+
+/* read_symbol/5 */
+static CVOID__PROTO(tk_read_symbol, tkz_t *tk) {
+  while (tk->typ == RUNETY_SYMBOL) {
+    TK_PUSH_RUNE(tk->ch);
+    TK_GET();
+  }
+}
+
+/* skip_line/0 */
+static CVOID__PROTO(tk_skip_line, tkz_t *tk) {
+  CVOID__CALL(skip_rune_line, tk->s, address_read_tokens);
+}
+
+static int tk_control_character(int typ, c_rune_t c) {
+  if (typ == RUNETY_SYMBOL && c == '?') return 127;
+  if (typ == RUNETY_SYMBOL && c == '@') return 0;
+  if (typ == RUNETY_UPPERCASE || typ == RUNETY_LOWERCASE) return c % 32;
+  if (typ == RUNETY_SYMBOL && c >= '[' && c <= '^') return c % 32;
+  return -1;
+}
+
+static int tk_symbolic_control_char(c_rune_t c) {
+  switch (c) {
+  case 'a': return 7;
+  case 'b': return 8;
+  case 't': return 9;
+  case 'n': return 10;
+  case 'v': return 11;
+  case 'f': return 12;
+  case 'r': return 13;
+  case 'e': return 27;
+  case 's': return 32;
+  case 'd': return 127;
+  default: return -1;
+  }
+}
+
+/* Value of a hexadecimal digit (-1 if not a digit, -2 for non ASCII
+   digits, which number_codes/3 rejects) */
+static int tk_hexa_digit(int typ, c_rune_t c) {
+  if (typ == RUNETY_DIGIT) return (c <= '9' ? c - '0' : -2);
+  if (typ == RUNETY_UPPERCASE && c <= 'F') return c - 'A' + 10;
+  if (typ == RUNETY_LOWERCASE && c <= 'f') return c - 'a' + 10;
+  return -1;
+}
+
+#define TK_IS_OCTAL(TYP, C) ((TYP) == RUNETY_DIGIT && (C) <= '7')
+
+/* escape_sequence/7 ('\' has been read). Returns TRUE if a character
+   is produced (in val). */
+static CFUN__PROTO(tk_escape, bool_t, tkz_t *tk, int64_t *val) {
+  c_rune_t c = tk->ch;
+  int typ = tk->typ;
+  uint64_t v;
+  int n, d;
+  bool_t bad;
+
+  if (typ == RUNETY_LAYOUT) { /* continuation escape sequence */
+    TK_GET();
+    return FALSE;
+  } else if (typ == RUNETY_SYMBOL && c == '^') { /* control_escape_char */
+    TK_GET();
+    d = tk_control_character(tk->typ, tk->ch);
+    if (d >= 0) {
+      *val = d;
+      TK_GET();
+    } else {
+      *val = '^';
+    }
+    return TRUE;
+  } else if (TK_IS_OCTAL(typ, c)) { /* octal escape sequence */
+    v = c - '0';
+    TK_GET();
+    if (tk->cef == TK_CEF_SICSTUS) {
+      for (n = 2; n >= 1 && TK_IS_OCTAL(tk->typ, tk->ch); n--) {
+        v = v * 8 + (tk->ch - '0');
+        TK_GET();
+      }
+    } else {
+      while (!(tk->typ == RUNETY_SYMBOL && tk->ch == '\\')) {
+        /* (ignore other characters) */
+        if (TK_IS_OCTAL(tk->typ, tk->ch)) v = v * 8 + (tk->ch - '0');
+        TK_GET();
+      }
+      TK_GET();
+    }
+    *val = (int64_t)v;
+    return TRUE;
+  } else if ((typ == RUNETY_LOWERCASE && (c == 'x' || c == 'u')) ||
+             (typ == RUNETY_UPPERCASE && c == 'U')) {
+    v = 0;
+    bad = FALSE;
+    TK_GET();
+    if (c == 'x' && tk->cef != TK_CEF_SICSTUS) {
+      while (!(tk->typ == RUNETY_SYMBOL && tk->ch == '\\')) {
+        /* (ignore other characters) */
+        d = tk_hexa_digit(tk->typ, tk->ch);
+        if (d == -2) bad = TRUE;
+        if (d >= 0) v = v * 16 + d;
+        TK_GET();
+      }
+      TK_GET();
+    } else {
+      for (n = (c == 'x' ? 2 : c == 'u' ? 4 : 8); n >= 1; n--) {
+        d = tk_hexa_digit(tk->typ, tk->ch);
+        if (d == -1) break;
+        if (d == -2) bad = TRUE;
+        v = v * 16 + d;
+        TK_GET();
+      }
+    }
+    if (bad) tk_fail(tk);
+    *val = (int64_t)v;
+    return TRUE;
+  } else if (typ == RUNETY_LOWERCASE && c == 'c') { /* skip layout */
+    TK_GET1();
+    return FALSE;
+  } else if (typ == RUNETY_LOWERCASE && (d = tk_symbolic_control_char(c)) >= 0) {
+    *val = d;
+    TK_GET();
+    return TRUE;
+  } else {
+    *val = c;
+    TK_GET();
+    return TRUE;
+  }
+}
+
+/* read_quoted/5 (the opening quote has been read). Returns FALSE if
+   the token list ends. */
+static CFUN__PROTO(tk_read_quoted, bool_t, tkz_t *tk, c_rune_t quote) {
+  int64_t val;
+
+  tk->runes_len = 0;
+  for (;;) {
+    if (tk->typ == RUNETY_EOF) { /* unexpected end of file */
+      if (quote == '\'') tk_emit_atom_text(tk); else tk_emit_string_text(tk);
+      tk_emit_unexpected(tk, -1);
+      return FALSE;
+    } else if (tk->typ == RUNETY_PUNCT && tk->ch == quote) {
+      TK_GET();
+      if (tk->typ == RUNETY_PUNCT && tk->ch == quote) { /* doubled quote */
+        TK_PUSH_RUNE(quote);
+        TK_GET();
+      } else {
+        if (quote == '\'') tk_emit_atom_text(tk); else tk_emit_string_text(tk);
+        return TRUE;
+      }
+    } else if (tk->typ == RUNETY_SYMBOL && tk->ch == '\\' && tk->cef != TK_CEF_OFF) {
+      TK_GET();
+      if (CFUN__EVAL(tk_escape, tk, &val)) TK_PUSH_RUNE(val);
+    } else if (tk->ch == '\n' && quote == '\'') { /* newline in quoted atom */
+      tk_emit_atom_text(tk);
+      tk_emit_unexpected(tk, '\n');
+      return FALSE;
+    } else {
+      TK_PUSH_RUNE(tk->ch);
+      TK_GET();
+    }
+  }
+}
+
+/* read_quoted_character/5 ("0'" has been read) */
+static CVOID__PROTO(tk_read_quoted_character, tkz_t *tk) {
+  int64_t val;
+
+  for (;;) {
+    if (tk->typ == RUNETY_SYMBOL && tk->ch == '\\' && tk->cef != TK_CEF_OFF) {
+      TK_GET();
+      if (CFUN__EVAL(tk_escape, tk, &val)) {
+        tk_emit_int(tk, val);
+        return;
+      }
+    } else if (tk->typ == RUNETY_PUNCT && tk->ch == '\'' && tk->cef == TK_CEF_ISO) {
+      TK_GET();
+      if (tk->typ == RUNETY_PUNCT && tk->ch == '\'') TK_GET();
+      tk_emit_int(tk, '\'');
+      return;
+    } else {
+      tk_emit_int(tk, tk->ch);
+      TK_GET();
+      return;
+    }
+  }
+}
+
+/* read_fullstop/4 ('.' has been read). Returns FALSE if the token
+   list ends. */
+static CFUN__PROTO(tk_read_fullstop, bool_t, tkz_t *tk) {
+  if (tk->typ == RUNETY_EOF || tk->typ == RUNETY_LAYOUT) {
+    tk_emit_punct(tk, atom_tk_dot);
+    return FALSE;
+  } else if (tk->typ == RUNETY_PUNCT && tk->ch == '%') {
+    tk_emit_punct(tk, atom_tk_dot);
+    CVOID__CALL(tk_skip_line, tk);
+    return FALSE;
+  } else {
+    tk->runes_len = 0;
+    TK_PUSH_RUNE('.');
+    CVOID__CALL(tk_read_symbol, tk);
+    tk_emit_atom_text(tk);
+    return TRUE;
+  }
+}
+
+/* read_based_int/4 (pushes the digits, returns how many) */
+static CFUN__PROTO(tk_read_based_int, intmach_t, tkz_t *tk, int base) {
+  c_rune_t max_digit = '0' + base - 1;
+  c_rune_t max_letter = 'A' + base - 11;
+  intmach_t n = 0;
+
+  TK_GET();
+  for (;;) {
+    if ((tk->typ == RUNETY_DIGIT && tk->ch <= max_digit) ||
+        (tk->typ == RUNETY_UPPERCASE && tk->ch <= max_letter) ||
+        (tk->typ == RUNETY_LOWERCASE && tk->ch <= max_letter + 'a' - 'A')) {
+      tk_num_push(tk, tk->ch);
+      n++;
+      TK_GET();
+    } else {
+      return n;
+    }
+  }
+}
+
+/* Value of the current number text as a base (in 2..36), or 0 */
+static int tk_num_base(tkz_t *tk) {
+  intmach_t i;
+  int radix = GetSmall(current_radix);
+  int d;
+  intmach_t v = 0;
+
+  for (i = tk->nstart; i < tk->nbuf_len; i++) {
+    char c = tk->nbuf[i];
+    if (c >= '0' && c <= '9') d = c - '0';
+    else if (c >= 'a' && c <= 'z') d = c - 'a' + 10;
+    else if (c >= 'A' && c <= 'Z') d = c - 'A' + 10;
+    else return 0;
+    if (d >= radix) return 0;
+    v = v * radix + d;
+    if (v > 36) return 0;
+  }
+  return (v >= 2 ? (int)v : 0);
+}
+
+static bool_t tk_num_is(tkz_t *tk, char *text) {
+  intmach_t len = strlen(text);
+  return (tk->nbuf_len - tk->nstart == len &&
+          memcmp(tk->nbuf + tk->nstart, text, len) == 0);
+}
+
+static bool_t tk_runes_are(tkz_t *tk, char *text) {
+  intmach_t i, len = strlen(text);
+  if (tk->runes_len != len) return FALSE;
+  for (i = 0; i < len; i++) {
+    if (tk->runes[i] != text[i]) return FALSE;
+  }
+  return TRUE;
+}
+
+/* read_number/4 (the current character is a digit). Returns FALSE if
+   the token list ends. */
+static CFUN__PROTO(tk_read_number, bool_t, tkz_t *tk) {
+  c_rune_t c, e, sign;
+  int base;
+
+  tk_num_start(tk);
+  c = tk->ch;
+  TK_GET();
+  if (c == '0') { /* read_after_0/5 */
+    if (tk->typ == RUNETY_DIGIT) {
+      tk_num_push(tk, tk->ch);
+      TK_GET();
+      goto digits;
+    } else if (tk->typ == RUNETY_SYMBOL && tk->ch == '.') {
+      tk_num_push(tk, '0');
+      TK_GET();
+      goto after_period;
+    } else if (tk->typ == RUNETY_LOWERCASE &&
+               (tk->ch == 'b' || tk->ch == 'o' || tk->ch == 'x')) {
+      c = tk->ch;
+      base = (c == 'b' ? 2 : c == 'o' ? 8 : 16);
+      if (CFUN__EVAL(tk_read_based_int, tk, base) == 0) {
+        /* not a based int, start of an atom with letter c */
+        tk_num_discard(tk);
+        tk_emit_int(tk, 0);
+        tk->runes_len = 0;
+        TK_PUSH_RUNE(c);
+        CVOID__CALL(tk_read_name, tk);
+        tk_emit_atom_text(tk);
+      } else {
+        tk_num_emit(tk, base);
+      }
+      return TRUE;
+    } else if (tk->typ == RUNETY_PUNCT && tk->ch == '\'') {
+      TK_GET();
+      CVOID__CALL(tk_read_quoted_character, tk);
+      return TRUE;
+    } else {
+      tk_emit_int(tk, 0);
+      return TRUE;
+    }
+  }
+  tk_num_push(tk, c);
+
+ digits: /* read_digits/7 */
+  while (tk->typ == RUNETY_DIGIT) {
+    tk_num_push(tk, tk->ch);
+    TK_GET();
+  }
+  if (tk->typ == RUNETY_SYMBOL && tk->ch == '.') {
+    TK_GET();
+    goto after_period;
+  } else if (tk->typ == RUNETY_PUNCT && tk->ch == '\'' &&
+             (base = tk_num_base(tk)) != 0) {
+    tk_num_discard(tk);
+    if (CFUN__EVAL(tk_read_based_int, tk, base) == 0) {
+      /* not a based int, start of quoted atom */
+      tk_emit_int(tk, base);
+      return CFUN__EVAL(tk_read_quoted, tk, '\'');
+    }
+    tk_num_emit(tk, base);
+    return TRUE;
+  } else {
+    tk_num_emit(tk, 0);
+    return TRUE;
+  }
+
+ after_period: /* read_after_period/7 */
+  if (tk->typ == RUNETY_DIGIT) {
+    tk_num_push(tk, '.');
+    while (tk->typ == RUNETY_DIGIT) { /* read_after_float/7 */
+      tk_num_push(tk, tk->ch);
+      TK_GET();
+    }
+    if ((tk->typ == RUNETY_LOWERCASE && tk->ch == 'e') ||
+        (tk->typ == RUNETY_UPPERCASE && tk->ch == 'E')) {
+      e = tk->ch;
+      TK_GET();
+      if (tk->typ == RUNETY_DIGIT) {
+        tk_num_push(tk, e);
+      } else if (tk->typ == RUNETY_SYMBOL && (tk->ch == '+' || tk->ch == '-')) {
+        sign = tk->ch;
+        TK_GET();
+        if (tk->typ == RUNETY_DIGIT) {
+          tk_num_push(tk, e);
+          tk_num_push(tk, sign);
+        } else { /* token_start_e_sign/6 */
+          tk_num_emit(tk, 0);
+          tk->runes_len = 0;
+          TK_PUSH_RUNE(e);
+          if (e == 'e') tk_emit_atom_text(tk); else tk_emit_var_text(tk, TRUE);
+          tk->runes_len = 0;
+          TK_PUSH_RUNE(sign);
+          CVOID__CALL(tk_read_symbol, tk);
+          tk_emit_atom_text(tk);
+          return TRUE;
+        }
+      } else { /* token_start_e/5 */
+        tk_num_emit(tk, 0);
+        tk->runes_len = 0;
+        TK_PUSH_RUNE(e);
+        CVOID__CALL(tk_read_name, tk);
+        if (e == 'e') tk_emit_atom_text(tk); else tk_emit_var_text(tk, TRUE);
+        return TRUE;
+      }
+      while (tk->typ == RUNETY_DIGIT) { /* read_after_exp/7 */
+        tk_num_push(tk, tk->ch);
+        TK_GET();
+      }
+    }
+    tk_num_emit(tk, 0);
+    return TRUE;
+  } else if (tk->typ == RUNETY_UPPERCASE && (tk->ch == 'N' || tk->ch == 'I') &&
+             tk_num_is(tk, "0")) { /* read_inf_or_nan/6 */
+    tk_num_discard(tk);
+    tk->runes_len = 0;
+    TK_PUSH_RUNE(tk->ch);
+    TK_GET();
+    CVOID__CALL(tk_read_name, tk);
+    if (tk_runes_are(tk, "Nan")) {
+      tk_num_emit_text(tk, "0.Nan");
+    } else if (tk_runes_are(tk, "Inf")) {
+      tk_num_emit_text(tk, "0.Inf");
+    } else {
+      tk_emit_int(tk, 0);
+      tk_emit_atom(tk, atom_tk_dot);
+      tk_emit_var_text(tk, TRUE);
+    }
+    return TRUE;
+  } else {
+    tk_num_emit(tk, 0);
+    return CFUN__EVAL(tk_read_fullstop, tk);
+  }
+}
+
+/* '(' has been read (with layout before if after_layout) */
+static CVOID__PROTO(tk_read_open, tkz_t *tk, bool_t after_layout) {
+  TK_GET1();
+  if (tk->ch == ')') {
+    tk_emit_atom(tk, atom_tk_empty_parens);
+    TK_GET();
+  } else {
+    tk_emit_punct(tk, after_layout ? atom_tk_open_ws : atom_tk_open);
+  }
+}
+
+/* read_tokens/4 and read_tokens_after_layout/4 */
+static CVOID__PROTO(tk_read_tokens, tkz_t *tk) {
+  bool_t after_layout = FALSE;
+  c_rune_t c;
+
+  for (;;) {
+    c = tk->ch;
+    switch (tk->typ) {
+    case RUNETY_EOF:
+      return;
+    case RUNETY_LAYOUT:
+      TK_GET1();
+      after_layout = TRUE;
+      continue;
+    case RUNETY_LOWERCASE: /* atom */
+      tk->runes_len = 0;
+      CVOID__CALL(tk_read_name, tk);
+      tk_emit_atom_text(tk);
+      break;
+    case RUNETY_UPPERCASE: /* variable */
+      tk->runes_len = 0;
+      CVOID__CALL(tk_read_name, tk);
+      tk_emit_var_text(tk, FALSE);
+      break;
+    case RUNETY_DIGIT: /* number */
+      if (!CFUN__EVAL(tk_read_number, tk)) return;
+      break;
+    case RUNETY_SYMBOL:
+      if (c == '/') { /* comment if an '*' follows */
+        TK_GET();
+        if (tk->typ == RUNETY_SYMBOL && tk->ch == '*') {
+          /* ('/'+'*' has been read) */
+          TK_GET();
+          if (tk->typ == RUNETY_EOF) goto eof_comment;
+          if (!(tk->typ == RUNETY_SYMBOL && tk->ch == '*')) goto skip_block;
+        asterisk: /* '*' found */
+          TK_GET();
+          if (tk->typ == RUNETY_SYMBOL && tk->ch == '/') {
+            TK_GET1();
+            after_layout = TRUE;
+            continue;
+          } else if (tk->typ == RUNETY_SYMBOL && tk->ch == '*') {
+            goto asterisk;
+          }
+        skip_block:
+          if (CFUN__EVAL(skip_rune, tk->s, '*', address_read_tokens) == '*') {
+            goto asterisk;
+          }
+        eof_comment:
+          tk_emit_punct(tk, atom_tk_eof_comment);
+          return;
+        }
+        tk->runes_len = 0;
+        TK_PUSH_RUNE('/');
+        CVOID__CALL(tk_read_symbol, tk);
+        tk_emit_atom_text(tk);
+      } else if (c == '.') { /* end token or graphic atom */
+        TK_GET();
+        if (!CFUN__EVAL(tk_read_fullstop, tk)) return;
+      } else { /* graphic atom */
+        tk->runes_len = 0;
+        CVOID__CALL(tk_read_symbol, tk);
+        tk_emit_atom_text(tk);
+      }
+      break;
+    case RUNETY_PUNCT:
+      switch (c) {
+      case '!':
+        tk_emit_atom(tk, atom_tk_cut);
+        TK_GET();
+        break;
+      case ';':
+        tk_emit_atom(tk, atom_tk_semicolon);
+        TK_GET();
+        break;
+      case '%': /* comment */
+        TK_GET();
+        if (!(tk->ch == '\n' || tk->typ == RUNETY_EOF)) {
+          CVOID__CALL(tk_skip_line, tk);
+          TK_GET1();
+        }
+        after_layout = TRUE;
+        continue;
+      case '(':
+        CVOID__CALL(tk_read_open, tk, after_layout);
+        break;
+      case ')':
+        tk_emit_punct(tk, atom_tk_close);
+        TK_GET1();
+        break;
+      case ',':
+        tk_emit_punct(tk, atom_tk_comma);
+        TK_GET1();
+        break;
+      case '[':
+        tk_emit_punct(tk, atom_tk_lbracket);
+        TK_GET1();
+        break;
+      case ']':
+        tk_emit_punct(tk, atom_tk_rbracket);
+        TK_GET1();
+        break;
+      case '{':
+        tk_emit_punct(tk, atom_tk_lcurly);
+        TK_GET1();
+        break;
+      case '|':
+        tk_emit_punct(tk, atom_tk_bar);
+        TK_GET1();
+        break;
+      case '}':
+        tk_emit_punct(tk, atom_tk_rcurly);
+        TK_GET1();
+        break;
+      case '"': /* string */
+      case '\'': /* quoted atom */
+        TK_GET();
+        if (!CFUN__EVAL(tk_read_quoted, tk, c)) return;
+        break;
+      default:
+        tk_fail(tk);
+      }
+      break;
+    case RUNETY_IDCONT: /* solo */
+      tk->runes_len = 0;
+      TK_PUSH_RUNE(c);
+      tk_emit_atom_text(tk);
+      TK_GET();
+      break;
+    default:
+      tk_fail(tk);
+    }
+    after_layout = FALSE;
+  }
+}
+
+static CFUN__PROTO(tk_run, int, tkz_t *tk) {
+  SIGJMP_BUF handler;
+  SIGJMP_BUF *old_handler;
+  int ret;
+
+  /* (exceptions from readrune() are caught here so that the caller
+     can release the buffers before raising them again) */
+  old_handler = w->misc->errhandler;
+  w->misc->errhandler = &handler;
+  if (SIGSETJMP(handler)) {
+    w->misc->errhandler = old_handler;
+    return TK_ERROR;
+  }
+  ret = setjmp(tk->env);
+  if (ret == 0) {
+    TK_GET1();
+    current_prompt = tk->second_prompt;
+    CVOID__CALL(tk_read_tokens, tk);
+  }
+  w->misc->errhandler = old_handler;
+  return ret;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Building the result */
+
+static CFUN__PROTO(tk_make_codes, tagged_t, int64_t *s, intmach_t len) {
+  tagged_t l = atom_nil;
+  intmach_t i;
+  for (i = len - 1; i >= 0; i--) {
+    MakeLST(l, IntvalToTagged(s[i]), l);
+  }
+  return l;
+}
+
+static CFUN__PROTO(tk_make_struct, tagged_t, tagged_t f, tagged_t a) {
+  tagged_t *h = G->heap_top;
+  HeapPush(G->heap_top, f);
+  HeapPush(G->heap_top, a);
+  return Tagp(STR, h);
+}
+
+static CFUN__PROTO(tk_make_token, tagged_t, tkz_t *tk, tk_token_t *t) {
+  tagged_t x, name, str;
+  tk_var_t *v;
+
+  switch (t->kind) {
+  case TK_PUNCT:
+    return t->atm;
+  case TK_ATOM:
+    return CFUN__EVAL(tk_make_struct, functor_atom, t->atm);
+  case TK_BADATOM:
+    x = CFUN__EVAL(tk_make_codes, tk->codes + t->off, t->len);
+    return CFUN__EVAL(tk_make_struct, functor_badatom, x);
+  case TK_STRING:
+    x = CFUN__EVAL(tk_make_codes, tk->codes + t->off, t->len);
+    return CFUN__EVAL(tk_make_struct, functor_string, x);
+  case TK_VAR:
+    if (t->off < 0) { /* anonymous */
+      LoadHVA(x, G->heap_top);
+      MakeLST(name, MakeSmall('_'), atom_nil);
+    } else {
+      v = &tk->vars[t->off];
+      x = v->var;
+      name = v->name;
+    }
+    str = Tagp(STR, G->heap_top);
+    HeapPush(G->heap_top, functor_var);
+    HeapPush(G->heap_top, x);
+    HeapPush(G->heap_top, name);
+    return str;
+  case TK_NUMBER:
+    if (!CBOOL__SUCCEED(string_to_number, tk->nbuf + t->off,
+                        (t->len == 0 ? GetSmall(current_radix) : t->len),
+                        &x, 4)) {
+      return ERRORTAG; /* (like number_codes/2) */
+    }
+    return CFUN__EVAL(tk_make_struct, functor_number, x);
+  case TK_INT:
+    x = IntvalToTagged(t->val);
+    return CFUN__EVAL(tk_make_struct, functor_number, x);
+  default: /* TK_UNEXPECTED */
+    return CFUN__EVAL(tk_make_struct, functor_unexpected, MakeSmall(t->val));
+  }
+}
+
+static void tk_init(tkz_t *tk) {
+  intmach_t i;
+  TK_BUF_INIT(tk_token_t, toks, 64);
+  TK_BUF_INIT(int64_t, runes, 64);
+  TK_BUF_INIT(int64_t, codes, 256);
+  TK_BUF_INIT(char, nbuf, 64);
+  TK_BUF_INIT(char, abuf, 64);
+  TK_BUF_INIT(tk_var_t, vars, 16);
+  tk->vhash_size = 32;
+  tk->vhash = checkalloc_ARRAY(intmach_t, tk->vhash_size);
+  for (i = 0; i < tk->vhash_size; i++) tk->vhash[i] = -1;
+  tk->cells = 0;
+  tk->nstart = 0;
+}
+
+static void tk_free(tkz_t *tk) {
+  TK_BUF_FREE(tk_token_t, toks);
+  TK_BUF_FREE(int64_t, runes);
+  TK_BUF_FREE(int64_t, codes);
+  TK_BUF_FREE(char, nbuf);
+  TK_BUF_FREE(char, abuf);
+  TK_BUF_FREE(tk_var_t, vars);
+  checkdealloc_ARRAY(intmach_t, tk->vhash_size, tk->vhash);
+}
+
+/* '$read_tokens'(+CEF, +SecondPrompt, -Tokens, -Vars): read_tokens/2
+   from the current input (CEF is 0, 1 or 2 for character_escapes
+   off, iso, and sicstus). Fails if read_tokens/2 would fail.
+
+   Note: buffers are lost if interrupted (SIGINT) while reading from a
+   tty. */
+CBOOL__PROTO(prolog_read_tokens) {
+  tkz_t tk_;
+  tkz_t *tk = &tk_;
+  tagged_t t, old_prompt, tokens, vars;
+  tagged_t *tail;
+  intmach_t i;
+  int ret;
+  tk_var_t *v;
+
+  tk_init_atoms();
+  DEREF(t, X(0));
+  CBOOL__TEST(TaggedIsSmall(t));
+  tk->cef = GetSmall(t);
+  DEREF(tk->second_prompt, X(1));
+  tk->s = Input_Stream_Ptr;
+
+  tk_init(tk);
+  old_prompt = current_prompt;
+  ret = CFUN__EVAL(tk_run, tk);
+  current_prompt = old_prompt;
+  if (ret == TK_FAIL) {
+    tk_free(tk);
+    CBOOL__FAIL;
+  } else if (ret == TK_ERROR) {
+    tk_free(tk);
+    EXCEPTION__THROW; /* (ErrCode, etc. are kept) */
+  } else if (ret == TK_PAST_EOF) {
+    tk_free(tk);
+    /* (as if raised by getct/2 or getct1/2) */
+    if (tk->past_eof_getct1) {
+      ERR__FUNCTOR("io_basic:getct1", 2);
+      BUILTIN_ERROR(ERR_permission_error(access, past_end_of_stream),atom_nil,0);
+    } else {
+      ERR__FUNCTOR("io_basic:getct", 2);
+      BUILTIN_ERROR(ERR_permission_error(access, past_end_of_stream),atom_nil,0);
+    }
+  }
+
+  TEST_HEAP_OVERFLOW(G->heap_top, (tk->cells+LSTCELLS)*sizeof(tagged_t)+CONTPAD, 4);
+
+  /* Variables (and their names) */
+  for (i = 0; i < tk->vars_len; i++) {
+    v = &tk->vars[i];
+    LoadHVA(v->var, G->heap_top);
+    v->name = CFUN__EVAL(tk_make_codes, tk->codes + v->off, v->len);
+  }
+
+  /* Tokens (built forwards, numbers are created at the heap top) */
+  tail = &tokens;
+  for (i = 0; i < tk->toks_len; i++) {
+    t = CFUN__EVAL(tk_make_token, tk, &tk->toks[i]);
+    if (t == ERRORTAG) {
+      tk_free(tk);
+      CBOOL__FAIL;
+    }
+    *tail = Tagp(LST, G->heap_top);
+    HeapPush(G->heap_top, t);
+    tail = G->heap_top;
+    HeapPush(G->heap_top, atom_nil);
+  }
+  *tail = atom_nil;
+
+  /* List of v(Name,Var,Count) */
+  vars = atom_nil;
+  for (i = tk->vars_len - 1; i >= 0; i--) {
+    v = &tk->vars[i];
+    t = Tagp(STR, G->heap_top);
+    HeapPush(G->heap_top, functor_v);
+    HeapPush(G->heap_top, v->name);
+    HeapPush(G->heap_top, v->var);
+    HeapPush(G->heap_top, MakeSmall(v->count));
+    MakeLST(vars, t, vars);
+  }
+
+  tk_free(tk);
+  CBOOL__UNIFY(tokens, X(2));
+  CBOOL__LASTUNIFY(vars, X(3));
+}
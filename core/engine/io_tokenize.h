@@ -0,0 +1,18 @@
+/*
+ *  io_tokenize.h
+ *
+ *  Native tokenizer for read_term (see library(tokenize))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_IO_TOKENIZE_H
+#define _CIAO_IO_TOKENIZE_H
+
+#include <ciao/eng.h>
+
+extern definition_t *address_read_tokens;
+
+CBOOL__PROTO(prolog_read_tokens);
+
+#endif /* _CIAO_IO_TOKENIZE_H */
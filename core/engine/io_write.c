@@ -0,0 +1,691 @@
+/*
+ *  io_write.c
+ *
+ *  Native term writer for write_term (see library(write))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#include <ciao/eng.h>
+#include <ciao/io_basic.h>
+#include <ciao/eng_registry.h>
+#include <ciao/internals.h> /* hashtab_get, expand_sw_on_key */
+#include <ciao/atomic_basic.h> /* number_to_string */
+#include <ciao/eng_bignum.h> /* bn_positive */
+#include <ciao/io_write.h>
+
+#include <math.h>
+#include <string.h>
+
+/* This is a C version of write_out/8 in library(write). It must
+   produce exactly the same text (including the spacing and
+   parenthesization decisions), so the code follows the clauses of
+   write_out/8, write_out_/11, write_tail/3 and write_string_tail/4
+   one by one.
+
+   The operator table is mirrored from the current_op/5 data of
+   library(operators) (which calls '$op_update'/5 on each change).
+   The parser of library(read) still uses current_op/5 (see
+   io_tokenize.c for why it is not written in C).
+   Terms that need portray hooks, terms nested deeper than
+   WT_MAX_NESTING (which would exhaust the C stack) and a few odd
+   '$VAR' arguments are left to the Prolog writer ('$write_term'/4
+   fails without writing anything).
+
+   Output is collected in a local buffer and written to the stream
+   in large blocks (see print_nstring()). */
+
+/* --------------------------------------------------------------------------- */
+/* Operator table */
+
+typedef struct op_info_ op_info_t;
+struct op_info_ {
+  /* (a precedence of 0 means that the operator is not defined) */
+  int16_t pre_prec, pre_right; /* current_prefixop(Op, Prec, Right) */
+  int16_t in_left, in_prec, in_right; /* current_infixop(Op, Left, Prec, Right) */
+  int16_t post_left, post_prec; /* current_postfixop(Op, Left, Prec) */
+};
+
+/* Atom -> op_info_t. Entries are never removed. Updates are done
+   with op_table_l held and old tables are not freed on expansion,
+   so that lookups do not need the lock (as in find_definition()). */
+static hashtab_t *op_table = NULL;
+SLOCK op_table_l;
+
+static op_info_t *op_get(tagged_t atm) {
+  hashtab_t *table = op_table;
+  hashtab_node_t *h;
+
+  if (table == NULL) return NULL;
+  h = hashtab_get(table, atm);
+  if (!h->key) return NULL;
+  return (op_info_t *)h->value.as_ptr;
+}
+
+/* '$op_update'(+Atom, +Type, +Left, +Prec, +Right): Atom has the
+   current_op/5 entry of Type (pre, in or post) given by Left, Prec
+   and Right (or none if Prec is 0) */
+CBOOL__PROTO(prolog_op_update) {
+  tagged_t atm, type, left, prec, right;
+  hashtab_node_t *h;
+  op_info_t *op;
+  char *tname;
+
+  DEREF(atm, X(0));
+  DEREF(type, X(1));
+  DEREF(left, X(2));
+  DEREF(prec, X(3));
+  DEREF(right, X(4));
+  CBOOL__TEST(TaggedIsATM(atm) && TaggedIsATM(type));
+  CBOOL__TEST(TaggedIsSmall(left) && TaggedIsSmall(prec) && TaggedIsSmall(right));
+
+  Wait_Acquire_slock(op_table_l);
+  if (op_table == NULL) op_table = new_switch_on_key(64, NULL);
+  h = hashtab_get(op_table, atm);
+  if (h->key) {
+    op = (op_info_t *)h->value.as_ptr;
+  } else {
+    if ((op_table->count+1)<<1 > HASHTAB_SIZE(op_table)) {
+      expand_sw_on_key(&op_table, NULL, FALSE);
+      h = hashtab_get(op_table, atm);
+    }
+    op = checkalloc_TYPE(op_info_t);
+    memset(op, 0, sizeof(op_info_t));
+    h->value.as_ptr = (void *)op;
+    h->key = atm;
+    op_table->count++;
+  }
+  tname = TaggedToAtom(type)->name;
+  if (strcmp(tname, "pre") == 0) {
+    op->pre_right = GetSmall(right);
+    op->pre_prec = GetSmall(prec);
+  } else if (strcmp(tname, "in") == 0) {
+    op->in_left = GetSmall(left);
+    op->in_right = GetSmall(right);
+    op->in_prec = GetSmall(prec);
+  } else if (strcmp(tname, "post") == 0) {
+    op->post_left = GetSmall(left);
+    op->post_prec = GetSmall(prec);
+  }
+  Release_slock(op_table_l);
+  CBOOL__PROCEED;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Writer state */
+
+/* Contexts (last token written, see maybe_space/2) */
+#define CTX_ALPHA 0 /* 2'000 */
+#define CTX_QUOTE 1 /* 2'001 */
+#define CTX_OTHER 2 /* 2'010 */
+#define CTX_PUNCT 4 /* 2'100 */
+
+/* Maximum nesting of terms (deeper terms use the Prolog writer) */
+#define WT_MAX_NESTING 10000
+
+static tagged_t functor_curly;
+static tagged_t functor_Dvar;
+static tagged_t functor_equal;
+static tagged_t atom_minus;
+static tagged_t atom_bar;
+static tagged_t atom_ops;
+static bool_t wt_atoms_ready = FALSE;
+
+void wt_init_atoms(void) {
+  if (wt_atoms_ready) return;
+  functor_curly = SetArity(GET_ATOM("{}"), 1);
+  functor_Dvar = SetArity(GET_ATOM("$VAR"), 1);
+  functor_equal = SetArity(GET_ATOM("="), 2);
+  atom_minus = GET_ATOM("-");
+  atom_bar = GET_ATOM("|");
+  atom_ops = GET_ATOM("ops");
+  wt_atoms_ready = TRUE;
+}
+
+void wt_ensure(wt_t *wt, intmach_t n) {
+  intmach_t cap;
+  if (wt->len + n <= wt->cap) return;
+  cap = wt->cap * 2;
+  while (wt->len + n > cap) cap *= 2;
+  wt->buf = checkrealloc_ARRAY(char, wt->cap, cap, wt->buf);
+  wt->cap = cap;
+}
+
+void wt_puts(wt_t *wt, const char *p, intmach_t n) {
+  wt_ensure(wt, n);
+  memcpy(wt->buf + wt->len, p, n);
+  wt->len += n;
+}
+
+#define WT_PUTS(S) wt_puts(wt, (S), sizeof(S)-1)
+
+CVOID__PROTO(wt_flush, wt_t *wt) {
+  if (wt->len > 0) {
+    CVOID__CALL(print_nstring, wt->s, wt->buf, wt->len);
+    wt->len = 0;
+  }
+}
+
+/* Prepare the output buffer (options are set by the caller) */
+void wt_open(wt_t *wt, stream_node_t *s) {
+  wt->s = s;
+  wt->flush_size = WT_FLUSH_SIZE;
+  wt->cap = 1024;
+  wt->len = 0;
+  wt->buf = checkalloc_ARRAY(char, wt->cap);
+}
+
+/* Write the pending output and release the buffer */
+CVOID__PROTO(wt_close, wt_t *wt) {
+  CVOID__CALL(wt_flush, wt);
+  checkdealloc_ARRAY(char, wt->cap, wt->buf);
+}
+
+#define WT_MAYBE_FLUSH() ({ \
+  if (wt->len > wt->flush_size) CVOID__CALL(wt_flush, wt); \
+})
+
+/* maybe_space/2 */
+static inline void wt_space(wt_t *wt, int ci, int co) {
+  if ((ci|co) < CTX_PUNCT && (ci^co) < CTX_OTHER) wt_put(wt, ' ');
+}
+
+/* '$atom_mode'/2 */
+static inline int wt_atom_mode(atom_t *atomptr) {
+  if (atomptr->has_special) return CTX_QUOTE;
+  if (atomptr->has_dquote) return CTX_OTHER;
+  if (atomptr->has_squote) return CTX_PUNCT;
+  return CTX_ALPHA;
+}
+
+/* display/1 or displayq/1 of an atom (no spacing) */
+static void wt_atom_text(wt_t *wt, atom_t *atomptr, bool_t quoted) {
+  char *end;
+  if (quoted && atomptr->has_special) {
+    wt_ensure(wt, PRINT_ATOM_QUOTED_MAX(atomptr->atom_len));
+    end = quote_atom_name(wt->buf + wt->len, atomptr);
+    wt->len = end - wt->buf;
+  } else {
+    wt_puts(wt, atomptr->name, atomptr->atom_len);
+  }
+}
+
+/* write_atom/4 */
+static int wt_atom(wt_t *wt, tagged_t atm, bool_t quoted, int ci) {
+  atom_t *atomptr = TaggedToAtom(atm);
+  int co = wt_atom_mode(atomptr);
+  wt_space(wt, ci, co);
+  wt_atom_text(wt, atomptr, quoted);
+  return co;
+}
+
+/* displayq/1 of a number */
+static CVOID__PROTO(wt_number, wt_t *wt, tagged_t t) {
+  CVOID__CALL(number_to_string, t, 10);
+  wt_puts(wt, Atom_Buffer, strlen(Atom_Buffer));
+}
+
+/* Name of a variable (from variable_names), or 0 */
+static tagged_t wt_var_name(wt_t *wt, tagged_t v) {
+  tagged_t l, e, x;
+
+  DEREF(l, wt->varnames);
+  while (TaggedIsLST(l)) {
+    DerefCar(e, l);
+    if (TaggedIsSTR(e) && TaggedToHeadfunctor(e) == functor_equal) {
+      DerefArg(x, e, 2);
+      if (x == v) {
+        DerefArg(x, e, 1);
+        if (TaggedIsATM(x)) return x;
+      }
+    }
+    DerefCdr(l, l);
+  }
+  return 0;
+}
+
+/* write_var/2 (no spacing) */
+static CVOID__PROTO(wt_var_text, wt_t *wt, tagged_t v) {
+  tagged_t name = wt_var_name(wt, v);
+  if (name != 0) {
+    wt_atom_text(wt, TaggedToAtom(name), FALSE);
+  } else {
+    wt_put(wt, '_');
+    CVOID__CALL(wt_number, wt, CFUN__EVAL(var_address, v));
+  }
+}
+
+/* printable_char/1 */
+static inline bool_t wt_printable(tagged_t t) {
+  intmach_t c;
+  if (!TaggedIsSmall(t)) return FALSE;
+  c = GetSmall(t);
+  return (c == 9 || c == 10 || c == 32 ||
+          (c > 32 && c < 256 && get_rune_class(c) > 0));
+}
+
+/* put_string_code/1 */
+static inline void wt_string_code(wt_t *wt, tagged_t t) {
+  intmach_t c = GetSmall(t);
+  if (c == '"') {
+    WT_PUTS("\"\"");
+  } else if (c == '\\') {
+    WT_PUTS("\\\\");
+  } else {
+    wt_put(wt, (char)c);
+  }
+}
+
+/* (for list and structure arguments) */
+static inline tagged_t wt_arg(tagged_t t, int i) {
+  tagged_t a;
+  if (TaggedIsLST(t)) {
+    if (i == 1) {
+      DerefCar(a, t);
+    } else {
+      DerefCdr(a, t);
+    }
+  } else {
+    DerefArg(a, t, i);
+  }
+  return a;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Precheck */
+
+/* Codes of a '$VAR' name (as accepted by atom_codes/2 without errors) */
+static bool_t wt_var_codes_ok(tagged_t l) {
+  tagged_t c;
+  intmach_t n = 0;
+  while (TaggedIsLST(l)) {
+    DerefCar(c, l);
+    if (!TaggedIsSmall(c) || GetSmall(c) <= 0 || GetSmall(c) > 255) return FALSE;
+    if (++n >= STATICMAXATOM) return FALSE;
+    DerefCdr(l, l);
+  }
+  return (l == atom_nil);
+}
+
+/* Check that the term can be written natively (see above) */
+bool_t wt_check(wt_t *wt, tagged_t t0) {
+  typedef struct { tagged_t t; intmach_t depth; } wt_pending_t;
+  wt_pending_t *stack;
+  intmach_t sp, cap;
+  tagged_t t, a;
+  intmach_t depth;
+  int i, arity;
+  bool_t ok = TRUE;
+
+  cap = 256;
+  stack = checkalloc_ARRAY(wt_pending_t, cap);
+  sp = 0;
+  stack[sp].t = t0;
+  stack[sp].depth = 0;
+  sp++;
+  while (sp > 0) {
+    sp--;
+    DEREF(t, stack[sp].t);
+    depth = stack[sp].depth;
+    if (depth >= wt->limit) continue;
+    if (depth > WT_MAX_NESTING) { ok = FALSE; break; }
+    if (TaggedIsLST(t)) {
+      arity = 2;
+    } else if (TaggedIsSTR(t) && !TaggedIsLarge(t)) {
+      arity = Arity(TaggedToHeadfunctor(t));
+      if (wt->numbervars && TaggedToHeadfunctor(t) == functor_Dvar) {
+        DerefArg(a, t, 1);
+        if (TaggedIsLarge(a) && IsInteger(a)) { ok = FALSE; break; }
+        if (TaggedIsLST(a)) {
+          DerefCar(a, a);
+          if (IsInteger(a) && !wt_var_codes_ok(wt_arg(t, 1))) { ok = FALSE; break; }
+        }
+      }
+    } else {
+      continue;
+    }
+    if (sp + arity > cap) {
+      intmach_t cap1 = cap * 2;
+      while (sp + arity > cap1) cap1 *= 2;
+      stack = checkrealloc_ARRAY(wt_pending_t, cap, cap1, stack);
+      cap = cap1;
+    }
+    /* (list tails do not increase the nesting, see wt_list()) */
+    for (i = arity; i >= 1; i--) {
+      stack[sp].t = wt_arg(t, i);
+      stack[sp].depth = (TaggedIsLST(t) && i == 2) ? depth : depth + 1;
+      sp++;
+    }
+  }
+  checkdealloc_ARRAY(wt_pending_t, cap, stack);
+  return ok;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Writing */
+
+static CFUN__PROTO(wt_out, int, wt_t *wt, tagged_t t, int prio, int preprio, intmach_t depth, bool_t lpar_ws, int ci);
+
+static inline void wt_lpar(wt_t *wt, bool_t lpar_ws) {
+  if (lpar_ws) {
+    WT_PUTS(" (");
+  } else {
+    wt_put(wt, '(');
+  }
+}
+
+/* write_args/5 (from the first argument) */
+static CVOID__PROTO(wt_args, wt_t *wt, tagged_t t, int arity, intmach_t depth) {
+  int i;
+  if (depth >= wt->limit) {
+    WT_PUTS("(...)");
+    return;
+  }
+  for (i = 1; i <= arity; i++) {
+    WT_MAYBE_FLUSH();
+    wt_put(wt, (i == 1) ? '(' : ',');
+    (void)CFUN__EVAL(wt_out, wt, wt_arg(t, i), 999, 0, depth, FALSE, CTX_PUNCT);
+  }
+  wt_put(wt, ')');
+}
+
+/* Functional notation (depth is already incremented) */
+static CFUN__PROTO(wt_canonical, int, wt_t *wt, tagged_t t, intmach_t depth, int ci) {
+  tagged_t f;
+  int arity;
+  if (TaggedIsLST(t)) {
+    f = atom_list;
+    arity = 2;
+  } else {
+    f = TaggedToHeadfunctor(t);
+    arity = Arity(f);
+    f = FUNCTOR_NAME(f);
+  }
+  (void)wt_atom(wt, f, wt->quoted, ci);
+  CVOID__CALL(wt_args, wt, t, arity, depth);
+  return CTX_PUNCT;
+}
+
+/* write_string_tail/4 */
+static CFUN__PROTO(wt_string_tail, int, wt_t *wt, tagged_t t, intmach_t depth) {
+  tagged_t c;
+  for (;;) {
+    DEREF(t, t);
+    if (IsVar(t)) {
+      WT_PUTS("\"||");
+      CVOID__CALL(wt_var_text, wt, t);
+      return CTX_ALPHA;
+    } else if (t == atom_nil) {
+      wt_put(wt, '"');
+      return CTX_PUNCT;
+    } else if (depth >= wt->limit) {
+      WT_PUTS("\"||...");
+      return CTX_OTHER;
+    } else if (TaggedIsLST(t)) {
+      DerefCar(c, t);
+      if (!wt_printable(c)) break;
+      wt_string_code(wt, c);
+      depth++;
+      DerefCdr(t, t);
+    } else {
+      break;
+    }
+  }
+  WT_PUTS("\"||");
+  return CFUN__EVAL(wt_out, wt, t, 999, 0, depth, FALSE, CTX_PUNCT);
+}
+
+/* [Head|Tail] and write_tail/3 */
+static CVOID__PROTO(wt_list, wt_t *wt, tagged_t t, intmach_t depth) {
+  wt_put(wt, '[');
+  depth++;
+  (void)CFUN__EVAL(wt_out, wt, wt_arg(t, 1), 999, 0, depth, FALSE, CTX_PUNCT);
+  t = wt_arg(t, 2);
+  for (;;) {
+    WT_MAYBE_FLUSH();
+    if (IsVar(t)) {
+      wt_put(wt, '|');
+      CVOID__CALL(wt_var_text, wt, t);
+      wt_put(wt, ']');
+      return;
+    } else if (t == atom_nil) {
+      wt_put(wt, ']');
+      return;
+    } else if (depth >= wt->limit) {
+      WT_PUTS("|...]");
+      return;
+    } else if (TaggedIsLST(t)) {
+      wt_put(wt, ',');
+      (void)CFUN__EVAL(wt_out, wt, wt_arg(t, 1), 999, 0, depth, FALSE, CTX_PUNCT);
+      depth++;
+      t = wt_arg(t, 2);
+    } else {
+      wt_put(wt, '|');
+      (void)CFUN__EVAL(wt_out, wt, t, 999, 0, depth, FALSE, CTX_PUNCT);
+      wt_put(wt, ']');
+      return;
+    }
+  }
+}
+
+/* write_VAR/3 (returns -1 if it does not apply) */
+static CFUN__PROTO(wt_VAR, int, wt_t *wt, tagged_t n, int ci) {
+  intmach_t i;
+  int co;
+  atom_t *atomptr;
+
+  if (TaggedIsSmall(n)) {
+    i = GetSmall(n);
+    if (i < 0) return -1;
+    wt_space(wt, ci, CTX_ALPHA);
+    wt_put(wt, 'A' + (i % 26));
+    if (i >= 26) CVOID__CALL(wt_number, wt, MakeSmall(i / 26));
+    return CTX_ALPHA;
+  } else if (TaggedIsATM(n)) {
+    atomptr = TaggedToAtom(n);
+  } else if (TaggedIsLST(n)) {
+    char name[STATICMAXATOM];
+    tagged_t c, l;
+    DerefCar(c, n);
+    if (!TaggedIsSmall(c)) return -1;
+    /* (codes already checked by wt_check()) */
+    i = 0;
+    l = n;
+    while (TaggedIsLST(l)) {
+      DerefCar(c, l);
+      name[i++] = (char)GetSmall(c);
+      DerefCdr(l, l);
+    }
+    name[i] = '\0';
+    atomptr = TaggedToAtom(GET_ATOM(name));
+  } else {
+    return -1;
+  }
+  co = wt_atom_mode(atomptr);
+  wt_space(wt, ci, co);
+  wt_atom_text(wt, atomptr, FALSE);
+  return co;
+}
+
+/* Maybe open a parenthesis (maybe_open_paren/6), returns the
+   context and the left parenthesis for the first subterm */
+#define WT_OPEN_PAREN(P) ({ \
+  if ((P) > prio) { \
+    wt_lpar(wt, lpar_ws); \
+    lpar_ws = FALSE; \
+    ci = CTX_PUNCT; \
+  } \
+})
+
+/* maybe_close_paren/4 */
+#define WT_CLOSE_PAREN(P, C) ({ \
+  int co_; \
+  if ((P) > prio) { \
+    wt_put(wt, ')'); \
+    co_ = CTX_PUNCT; \
+  } else { \
+    co_ = (C); \
+  } \
+  co_; \
+})
+
+static CFUN__PROTO(wt_out, int, wt_t *wt, tagged_t t, int prio, int preprio, intmach_t depth, bool_t lpar_ws, int ci) {
+  tagged_t f, a, b;
+  op_info_t *op;
+  int arity, co, o1, c2;
+
+  DEREF(t, t);
+  if (IsVar(t)) {
+    tagged_t name = wt_var_name(wt, t);
+    if (name != 0) {
+      return wt_atom(wt, name, FALSE, ci);
+    }
+    wt_space(wt, ci, CTX_ALPHA);
+    CVOID__CALL(wt_var_text, wt, t);
+    return CTX_ALPHA;
+  }
+  if (depth >= wt->limit) {
+    wt_space(wt, ci, CTX_OTHER);
+    WT_PUTS("...");
+    return CTX_OTHER;
+  }
+  if (wt->numbervars && TaggedIsSTR(t) && TaggedToHeadfunctor(t) == functor_Dvar) {
+    co = CFUN__EVAL(wt_VAR, wt, wt_arg(t, 1), ci);
+    if (co >= 0) return co;
+  }
+  if (TaggedIsATM(t)) {
+    op = op_get(t);
+    if (op != NULL && op->pre_prec > 0 && op->pre_prec <= preprio) {
+      wt_lpar(wt, lpar_ws);
+      (void)wt_atom(wt, t, wt->quoted, CTX_PUNCT);
+      wt_put(wt, ')');
+      return CTX_PUNCT;
+    }
+    return wt_atom(wt, t, wt->quoted, ci);
+  }
+  if (IsNumber(t)) {
+    bool_t neg;
+    if (TaggedIsSmall(t)) {
+      neg = GetSmall(t) < 0;
+    } else if (IsFloat(t)) {
+      flt64_t d = TaggedToFloat(t);
+      neg = (d < 0 || signbit(d));
+    } else {
+      neg = !bn_positive(TaggedToBignum(t));
+    }
+    wt_space(wt, ci, neg ? CTX_OTHER : CTX_ALPHA);
+    CVOID__CALL(wt_number, wt, t);
+    return CTX_ALPHA;
+  }
+  /* Compound terms */
+  if (wt->ignore_ops == WT_NO_OPS) {
+    return CFUN__EVAL(wt_canonical, wt, t, depth+1, ci);
+  }
+  if (TaggedIsSTR(t) && TaggedToHeadfunctor(t) == functor_curly) {
+    wt_put(wt, '{');
+    (void)CFUN__EVAL(wt_out, wt, wt_arg(t, 1), 1200, 0, depth+1, FALSE, CTX_PUNCT);
+    wt_put(wt, '}');
+    return CTX_PUNCT;
+  }
+  if (TaggedIsLST(t)) {
+    a = wt_arg(t, 1);
+    if (wt->write_strings && wt_printable(a)) {
+      wt_put(wt, '"');
+      wt_string_code(wt, a);
+      return CFUN__EVAL(wt_string_tail, wt, wt_arg(t, 2), depth+1);
+    }
+    CVOID__CALL(wt_list, wt, t, depth);
+    return CTX_PUNCT;
+  }
+  if (wt->ignore_ops == WT_NO_OPS_BUT_LISTS) {
+    return CFUN__EVAL(wt_canonical, wt, t, depth+1, ci);
+  }
+  depth++;
+  f = TaggedToHeadfunctor(t);
+  if (f == functor_and) {
+    /* This case stops writeq quoting commas. */
+    WT_OPEN_PAREN(1000);
+    (void)CFUN__EVAL(wt_out, wt, wt_arg(t, 1), 999, 0, depth, lpar_ws, ci);
+    wt_put(wt, ',');
+    c2 = CFUN__EVAL(wt_out, wt, wt_arg(t, 2), 1000, 1000, depth, FALSE, CTX_PUNCT);
+    return WT_CLOSE_PAREN(1000, c2);
+  }
+  arity = Arity(f);
+  f = FUNCTOR_NAME(f);
+  op = op_get(f);
+  if (op != NULL && arity == 1 && op->post_prec > 0) {
+    o1 = (op->in_prec > 0) ? 1200 : op->post_prec;
+    WT_OPEN_PAREN(o1);
+    co = CFUN__EVAL(wt_out, wt, wt_arg(t, 1), op->post_left, 1200, depth, lpar_ws, ci);
+    co = wt_atom(wt, f, wt->quoted, co);
+    return WT_CLOSE_PAREN(o1, co);
+  }
+  if (op != NULL && arity == 1 && op->pre_prec > 0) {
+    a = wt_arg(t, 1);
+    if (!(IsNumber(a) && f == atom_minus)) {
+      o1 = (preprio == 1200) ? op->pre_right + 1 : op->pre_prec;
+      WT_OPEN_PAREN(o1);
+      co = wt_atom(wt, f, wt->quoted, ci);
+      co = CFUN__EVAL(wt_out, wt, a, op->pre_right, op->pre_right, depth, TRUE, co);
+      return WT_CLOSE_PAREN(o1, co);
+    }
+  }
+  if (op != NULL && arity == 2 && op->in_prec > 0) {
+    o1 = (preprio == 1200) ? op->in_right + 1 : op->in_prec;
+    WT_OPEN_PAREN(o1);
+    a = wt_arg(t, 1);
+    b = wt_arg(t, 2);
+    co = CFUN__EVAL(wt_out, wt, a, op->in_left, 1200, depth, lpar_ws, ci);
+    co = wt_atom(wt, f, (f == atom_bar) ? FALSE : wt->quoted, co);
+    co = CFUN__EVAL(wt_out, wt, b, op->in_right, op->in_right, depth, FALSE, co);
+    return WT_CLOSE_PAREN(o1, co);
+  }
+  (void)wt_atom(wt, f, wt->quoted, ci);
+  CVOID__CALL(wt_args, wt, t, arity, depth);
+  return CTX_PUNCT;
+}
+
+/* Write a term (which must have passed wt_check()) with priority
+   prio */
+CVOID__PROTO(wt_write, wt_t *wt, tagged_t t, int prio) {
+  (void)CFUN__EVAL(wt_out, wt, t, prio, 0, 0, FALSE, CTX_PUNCT);
+}
+
+/* '$write_term'(?Term, +Options, +Prio, +WriteStrings): write Term
+   to the current output as write_out/8 does (with
+   Options=options(Quoted,IgnoreOps,NumberVars,false,Limit,VarNames)).
+   Fails without writing anything if the term must be written by the
+   Prolog writer. */
+CBOOL__PROTO(prolog_write_term) {
+  wt_t wt_;
+  wt_t *wt = &wt_;
+  tagged_t t, opts, x;
+
+  wt_init_atoms();
+  DEREF(opts, X(1));
+  CBOOL__TEST(TaggedIsSTR(opts) && Arity(TaggedToHeadfunctor(opts)) == 6);
+  DerefArg(x, opts, 1);
+  wt->quoted = (x == atom_true);
+  DerefArg(x, opts, 2);
+  wt->ignore_ops = (x == atom_true) ? WT_NO_OPS : (x == atom_ops) ? WT_NO_OPS_BUT_LISTS : WT_OPS;
+  DerefArg(x, opts, 3);
+  wt->numbervars = (x == atom_true);
+  DerefArg(x, opts, 4);
+  CBOOL__TEST(x == atom_false); /* (portray hooks) */
+  DerefArg(x, opts, 5);
+  CBOOL__TEST(TaggedIsSmall(x));
+  wt->limit = GetSmall(x);
+  DerefArg(wt->varnames, opts, 6);
+  DEREF(x, X(3));
+  wt->write_strings = (x == atom_on);
+  DEREF(x, X(2));
+  CBOOL__TEST(TaggedIsSmall(x));
+
+  DEREF(t, X(0));
+  CBOOL__TEST(wt_check(wt, t));
+
+  wt_open(wt, Output_Stream_Ptr);
+  CVOID__CALL(wt_write, wt, t, GetSmall(x));
+  CVOID__CALL(wt_close, wt);
+  CBOOL__PROCEED;
+}
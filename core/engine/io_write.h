@@ -0,0 +1,58 @@
+/*
+ *  io_write.h
+ *
+ *  Native term writer for write_term (see library(write))
+ *
+ *  See Copyright Notice in ciaoengine.pl
+ */
+
+#ifndef _CIAO_IO_WRITE_H
+#define _CIAO_IO_WRITE_H
+
+#include <ciao/eng.h>
+
+extern SLOCK op_table_l;
+
+CBOOL__PROTO(prolog_op_update);
+CBOOL__PROTO(prolog_write_term);
+
+/* Values of ignore_ops */
+#define WT_OPS 0 /* false */
+#define WT_NO_OPS 1 /* true */
+#define WT_NO_OPS_BUT_LISTS 2 /* ops */
+
+/* Flush the output buffer when it grows above this size */
+#define WT_FLUSH_SIZE 65536
+
+/* Writer state: write options and output buffer (also used by the
+   native formatter, see io_format.c) */
+typedef struct wt_ wt_t;
+struct wt_ {
+  stream_node_t *s;
+  bool_t quoted;
+  int ignore_ops;
+  bool_t numbervars;
+  bool_t write_strings;
+  intmach_t limit; /* max_depth */
+  tagged_t varnames; /* list of Name=Var */
+  intmach_t flush_size;
+  char *buf;
+  intmach_t len;
+  intmach_t cap;
+};
+
+void wt_init_atoms(void);
+void wt_open(wt_t *wt, stream_node_t *s);
+CVOID__PROTO(wt_close, wt_t *wt);
+CVOID__PROTO(wt_flush, wt_t *wt);
+void wt_ensure(wt_t *wt, intmach_t n);
+void wt_puts(wt_t *wt, const char *p, intmach_t n);
+bool_t wt_check(wt_t *wt, tagged_t t);
+CVOID__PROTO(wt_write, wt_t *wt, tagged_t t, int prio);
+
+static inline void wt_put(wt_t *wt, char c) {
+  wt_ensure(wt, 1);
+  wt->buf[wt->len++] = c;
+}
+
+#endif /* _CIAO_IO_WRITE_H */
@@ -25,7 +25,8 @@
 /* --------------------------------------------------------------------------- */
 
 //#define QLBFSIZE 1024
-#define QLBFSIZE 4096
+//#define QLBFSIZE 4096
+#define QLBFSIZE 65536
 int qlbuffidx, qlbuffend;
 unsigned char qlbuff[QLBFSIZE];
 
@@ -68,36 +69,71 @@ void skip_to_ctrl_l(FILE *file);
 #define WORKSTRINGLEN (STATICMAXATOM)
 static char workstring[WORKSTRINGLEN]; 
 
-/* read into ws (assume enough space) */
+/* Truncated or corrupt .po files are detected (instead of reading
+   past the end of the buffers or of the file) */
+#define QL_CORRUPT(WHAT) SERIOUS_FAULT("$qread: corrupt object file (" WHAT ")")
+
+/* read into ws (at most WORKSTRINGLEN chars) */
 static inline void getstring_ws(FILE *f, char *ws) {
-  while ((*ws++ = GETC(f))) {
-#if defined(DEBUG_TRACE)
-    if ((ws - workstring) > WORKSTRINGLEN) {
-      SERIOUS_FAULT("workstring length exceeded");
-    }
-#endif
-  }
+  char *end = ws + WORKSTRINGLEN;
+  int c;
+  do {
+    if (ws == end) QL_CORRUPT("string too long");
+    c = GETC(f);
+    if (c == EOF) QL_CORRUPT("unexpected end of file");
+    *ws++ = c;
+  } while (c != 0);
 }
 
 /* read into Atom_Buffer (expand if needed) */
 static inline CVOID__PROTO(getstring_ab, FILE *f) {
   int used_length = 0;
   char *ws = Atom_Buffer; /* TODO: use a custom buffer instead? */
-  while ((ws[used_length++] = GETC(f))) {
+  int c;
+  do {
+    c = GETC(f);
+    if (c == EOF) QL_CORRUPT("unexpected end of file");
+    ws[used_length++] = c;
     ENSURE_ATOM_BUFFER(used_length, { ws = Atom_Buffer; });
+  } while (c != 0);
+}
+
+/* Read a decimal integer (terminated by '\0'), starting with char c.
+   Parsed directly from the input buffer (the loader reads millions of
+   them at startup) */
+static inline intmach_t qr_int_from(FILE *f, int c) {
+  intmach_t n = 0;
+  bool_t neg = FALSE;
+  if (c == '-') {
+    neg = TRUE;
+    c = GETC(f);
+  }
+  if (c == 0) QL_CORRUPT("empty number");
+  while (c != 0) {
+    if (c == EOF) QL_CORRUPT("unexpected end of file");
+    if (c < '0' || c > '9') QL_CORRUPT("bad digit");
+    if (n > (INTMACH_MAX - (c - '0')) / 10) QL_CORRUPT("number too large");
+    n = n*10 + (c - '0');
+    c = GETC(f);
   }
+  return neg ? -n : n;
 }
 
-/* Read a int16_t integer */
-static int qr_int16(FILE *f) { 
-  getstring_ws(f, workstring);
-  return atoi(workstring);
+/* Read a 32-bit integer */
+static inline int32_t qr_int32_from(FILE *f, int c) {
+  intmach_t n = qr_int_from(f, c);
+  if (n < INT32_MIN || n > INT32_MAX) QL_CORRUPT("number too large");
+  return (int32_t)n;
+}
+
+/* Read a int16_t integer (also used for larger indices, as int) */
+static inline int qr_int16(FILE *f) { 
+  return qr_int32_from(f, GETC(f));
 }
 
 /* Read a int32_t integer */
-static int32_t qr_int32(FILE *f) {
-  getstring_ws(f, workstring);
-  return atol(workstring);
+static inline int32_t qr_int32(FILE *f) {
+  return qr_int32_from(f, GETC(f));
 }
 
 static flt64_t qr_flt64(FILE *f) {
@@ -664,20 +700,21 @@ CVOID__PROTO(getbytecode32, FILE *f,
     }
       
     case '+':
-      getstring_ws(f, workstring);
-      EMIT_l(atol(workstring));
+      EMIT_l(qr_int_from(f, GETC(f)));
       break;
       
-    case 'C':
-      getstring_ws(f, workstring);
-      EMIT_C(builtintab[atoi(workstring)]);
+    case 'C': {
+      intmach_t i = qr_int_from(f, GETC(f));
+      if (i < 0 || i >= BUILTINTAB_SIZE) {
+        QL_CORRUPT("bad builtin");
+      }
+      EMIT_C(builtintab[i]);
       break;
+    }
       
     default:
-      workstring[0] = c;
-      getstring_ws(f, workstring+1);
       /* TODO: assumes that f_o,f_x,f_y,etc. have the same size */
-      EMIT_o(atoi(workstring));
+      EMIT_o(qr_int_from(f, c));
     }
   }
 
@@ -771,6 +808,7 @@ CBOOL__PROTO(make_bytecode_object) {
 #endif
 
   object->next = NULL;
+  object->ixkeys = NULL;
 #if defined(GAUGE)
   object->counters = (intmach_t *)((char *)object+object->objsize)-counter_cnt;
   for (i=0; i<counter_cnt; i++)
@@ -1029,6 +1067,7 @@ static CVOID__PROTO(load_dbnode32,
   latest_bytecode = db;  
   latest_bytecode_size = codelength;
   db->next = NULL;
+  db->ixkeys = NULL;
 #if defined(GAUGE)
   db->counters = (intmach_t *)((char *)db+db->objsize)-counter_cnt;
   for (i=0; i<counter_cnt; i++)
@@ -754,6 +754,52 @@ CBOOL__PROTO(flush_output1) {
 
 /*----------------------------------------------------------------*/
 
+/* Flush the stream and wait until its data reaches the storage device */
+CBOOL__PROTO(prolog_fsync_output) {
+  ERR__FUNCTOR("internals:$fsync_output", 1);
+  int errcode;
+  stream_node_t *s;
+
+  s = stream_to_ptr_check(X(0), 'w', &errcode);
+  if (!s) {
+    BUILTIN_ERROR(errcode,X(0),1);
+  }
+
+  if (s->streammode != 's') { /* not a socket */
+    if (fflush(s->streamfile) || fsync(fileno(s->streamfile))) {
+      BUILTIN_ERROR(ERR_system_error,X(0),1);
+    }
+  }
+  CBOOL__PROCEED;
+}
+
+/* '$stream_is_file'(+Stream, +Path): the stream is still open on the
+   file at Path (e.g., it has not been removed or replaced since the
+   stream was opened) */
+CBOOL__PROTO(prolog_stream_is_file) {
+  ERR__FUNCTOR("internals:$stream_is_file", 2);
+  int errcode;
+  stream_node_t *s;
+  struct stat st_stream, st_path;
+
+  s = stream_to_ptr_check(X(0), 'x', &errcode);
+  if (!s) {
+    BUILTIN_ERROR(errcode,X(0),1);
+  }
+  DEREF(X(1),X(1));
+  if (!TaggedIsATM(X(1))) {
+    BUILTIN_ERROR(ERR_type_error(atom),X(1),2);
+  }
+
+  CBOOL__TEST(s->streammode != 's' && s->streamfile != NULL);
+  CBOOL__TEST(fstat(fileno(s->streamfile), &st_stream) == 0);
+  CBOOL__TEST(stat(GetString(X(1)), &st_path) == 0);
+  CBOOL__LASTTEST(st_stream.st_dev == st_path.st_dev &&
+                  st_stream.st_ino == st_path.st_ino);
+}
+
+/*----------------------------------------------------------------*/
+
 CBOOL__PROTO(prolog_clearerr) {
   ERR__FUNCTOR("stream_basic:clearerr", 1);
   int errcode;
@@ -2140,6 +2140,30 @@ static inline pid_t c_waitpid(pid_t pid, int *status) {
 }
 #endif
 
+/* Return code for a waitpid() status (negative for signals). Returns
+   FALSE if the process did not terminate. */
+static bool_t wait_retcode(int status, int *retcode) {
+#if defined(_WIN32) || defined(_WIN64)
+  // Windows-specific process termination handling
+  if (status & 0xC0000000) { /* error */
+    *retcode = -(status & 0xC0000000); /* negative number for signals */
+  } else {
+    *retcode = status; /* Process terminated normally */
+  }
+#else
+  /* Process did not terminated normally */
+  if (WIFSIGNALED(status)) { /* Process terminated due to signal */
+    *retcode = -WTERMSIG(status); /* negative number for signals */
+  } else if (WIFEXITED(status)) { /* Process terminated normally */
+    *retcode = WEXITSTATUS(status);
+  } else {
+    // TODO: only if WIFSTOPPED(status) (see man page)
+    return FALSE;
+  }
+#endif
+  return TRUE;
+}
+
 CBOOL__PROTO(prolog_wait) {
   ERR__FUNCTOR("system:wait", 2);
   int waited_pid, status;
@@ -2156,25 +2180,26 @@ CBOOL__PROTO(prolog_wait) {
   }
 
   int retcode;
+  if (!wait_retcode(status, &retcode)) return FALSE;
+  CBOOL__LASTUNIFY(X(1), MakeSmall(retcode));
+}
+
+/* wait_any(-Pid, -RetCode): wait for any child process */
+CBOOL__PROTO(prolog_wait_any) {
 #if defined(_WIN32) || defined(_WIN64)
-  // Windows-specific process termination handling
-  if (status & 0xC0000000) { /* error */
-    retcode = -(status & 0xC0000000); /* negative number for signals */
-  } else {
-    retcode = status; /* Process terminated normally */
-  }
+  return FALSE; /* TODO(MinGW): not supported */
 #else
-  /* Process did not terminated normally */
-  if (WIFSIGNALED(status)) { /* Process terminated due to signal */
-    retcode = -WTERMSIG(status); /* negative number for signals */
-  } else if (WIFEXITED(status)) { /* Process terminated normally */
-    retcode = WEXITSTATUS(status);
-  } else {
-    // TODO: only if WIFSTOPPED(status) (see man page)
-    return FALSE;
-  }
-#endif
+  pid_t waited_pid;
+  int status, retcode;
+
+  do {
+    waited_pid = waitpid(-1, &status, 0);
+  } while (waited_pid == -1 && errno == EINTR);
+  if (waited_pid == -1) return FALSE; /* no children */
+  if (!wait_retcode(status, &retcode)) return FALSE;
+  CBOOL__UnifyCons(MakeSmall(waited_pid), X(0));
   CBOOL__LASTUNIFY(X(1), MakeSmall(retcode));
+#endif
 }
 
 #if defined(_WIN32) || defined(_WIN64)
@@ -113,6 +113,24 @@
 }
 #endif
 
+#if defined(SAFE_CROSS_COPY)
+/* Copy blobs from other heaps (keep the rest) */
+#define COPY_BLOB { \
+  if (OnHeap(TagpPtr(STR,t1))) goto keep_old; \
+  if (OnHeap(loc)) { /* (loc may move) */ \
+    pt2rel = GetRelPtrOldHeap(loc); \
+    GCTEST(LargeArity(hf)+1); \
+    loc = GetAbsPtr(pt2rel); \
+  } else { \
+    GCTEST(LargeArity(hf)+1); \
+  } \
+  *loc = CFUN__EVAL(make_blob, TagpPtr(STR,t1)); \
+  return; \
+}
+#else
+#define COPY_BLOB goto keep_old
+#endif
+
 #define TMPL_copy_term(CopyTerm, ROOT_CVA, COPY_CVA) \
 static CVOID__PROTO(CopyTerm##__it, tagged_t *loc); \
 CBOOL__PROTO(CopyTerm) { \
@@ -165,8 +183,7 @@ static CVOID__PROTO(CopyTerm##__it, tagged_t *loc) { \
     goto copy_2_cells; \
   }, { /* STR */ \
     SwStruct(hf, t1, { /* STR(blob) */ \
-      /* TODO: fixme, cross copy term requires copying the blob */ \
-      goto keep_old; \
+      COPY_BLOB; \
     },{ /* STR(struct) */ \
       /* copy the structure (first with same arguments) */ \
       pt1 = TaggedToArg(t1,1); \
@@ -262,7 +279,6 @@ TMPL_copy_term(prolog_copy_term_nat, {
    with self references. */
 
 // TODO: see bugs/Pending/cross_copy_term/README.txt
-//  - blobs are not copied across heaps!
 
 CFUN__PROTO(cross_copy_term, tagged_t, tagged_t remote_term) {
   bool_t ok MAYBE_UNUSED;
@@ -0,0 +1,98 @@
+:- module(bignum_bench, [main/1], [assertions]).
+
+:- doc(title, "Bignum arithmetic microbenchmarks").
+
+:- doc(module, "Measures the time taken by multiplication, division
+   and radix conversion (@pred{number_codes/2} in both directions) of
+   large integers, for operands of increasing size, and checks that
+   the results are consistent (e.g., that @tt{(X*Y+R)//Y =:= X} and
+   that printed numbers read back to the same value).
+
+   Usage: @tt{bignum_bench [Digits ...]}, where each @var{Digits} is
+   the number of decimal digits of the operands (by default 100, 1000,
+   10000 and 100000).").
+
+:- use_module(engine(io_basic)).
+:- use_module(engine(runtime_control), [statistics/2]).
+:- use_module(library(format), [format/2]).
+
+main([]) :- !,
+    bench_sizes([100, 1000, 10000, 100000]).
+main(Args) :-
+    args_to_sizes(Args, Sizes),
+    bench_sizes(Sizes).
+
+args_to_sizes([], []).
+args_to_sizes([A|As], [N|Ns]) :-
+    atom_codes(A, Cs),
+    number_codes(N, Cs),
+    args_to_sizes(As, Ns).
+
+bench_sizes(Sizes) :-
+    format("~w~t~10|~w~t~12+~w~t~12+~w~t~12+~w~t~12+~w~n",
+           [digits, 'mul(ms)', 'div(ms)', 'mod(ms)', 'print(ms)', 'read(ms)']),
+    bench_sizes_(Sizes, ok, Ok),
+    ( Ok = ok -> format("All results are consistent~n", [])
+    ; format("*** Results differ ***~n", [])
+    ).
+
+bench_sizes_([], Ok, Ok).
+bench_sizes_([D|Ds], Ok0, Ok) :-
+    bench_size(D, Ok0, Ok1),
+    bench_sizes_(Ds, Ok1, Ok).
+
+% (operations are repeated so that each row takes a similar time)
+bench_size(D, Ok0, Ok) :-
+    operands(D, X, Y, R),
+    Reps is 2000000 // (D*D//100+D) + 1,
+    time_op(Reps, mul(X, Y, _), TMul),
+    P is X*Y+R,
+    time_op(Reps, div(P, Y, _), TDiv),
+    time_op(Reps, mod(P, Y, _), TMod),
+    time_op(Reps, print(P, _), TPrint),
+    number_codes(P, Cs),
+    time_op(Reps, read(Cs, _), TRead),
+    format("~d~t~10|~3f~t~12+~3f~t~12+~3f~t~12+~3f~t~12+~3f~n",
+           [D, TMul, TDiv, TMod, TPrint, TRead]),
+    ( P // Y =:= X, P mod Y =:= R,
+      number_codes(P1, Cs), P1 =:= P,
+      N is -P, N // Y =:= -X, number_codes(N, [0'-|Cs]) ->
+        Ok = Ok0
+    ; Ok = failed
+    ).
+
+% X and Y have D decimal digits, R < Y
+operands(D, X, Y, R) :-
+    EX is integer(D / 0.47712125472), % log10(3)
+    EY is integer(D / 0.84509804001), % log10(7)
+    pow(3, EX, X),
+    pow(7, EY, Y0),
+    Y is Y0+1,
+    R is Y0 // 3.
+
+pow(_, 0, P) :- !, P = 1.
+pow(B, E, P) :-
+    E2 is E // 2,
+    pow(B, E2, P2),
+    ( E mod 2 =:= 0 -> P is P2*P2 ; P is P2*P2*B ).
+
+% Average time (in ms) of running Op Reps times
+time_op(Reps, Op, T) :-
+    statistics(runtime, _),
+    repeat_op(Reps, Op),
+    statistics(runtime, [_, T0]),
+    T is T0 / Reps.
+
+repeat_op(N, Op) :-
+    ( between1(1, N), \+ \+ op(Op), fail
+    ; true
+    ).
+
+between1(I, N) :- I =< N.
+between1(I, N) :- I < N, I1 is I+1, between1(I1, N).
+
+op(mul(X, Y, Z)) :- Z is X*Y.
+op(div(X, Y, Z)) :- Z is X//Y.
+op(mod(X, Y, Z)) :- Z is X mod Y.
+op(print(X, Cs)) :- number_codes(X, Cs).
+op(read(Cs, X)) :- number_codes(X, Cs).
@@ -0,0 +1,110 @@
+:- module(read_bench, [main/1], [assertions]).
+
+:- doc(title, "Reading throughput benchmark").
+
+:- doc(module, "Measures how fast @pred{read_term/3} reads terms,
+   with the native (C) tokenizer and with the Prolog tokenizer (see
+   the @tt{native_tokenizer} flag of @lib{tokenize}), and checks
+   that both read the same terms.
+
+   Usage: @tt{read_bench [File ...]}. Without arguments a data file
+   with synthetic clauses is generated.").
+
+:- use_module(engine(stream_basic)).
+:- use_module(engine(io_basic)).
+:- use_module(engine(runtime_control), [statistics/2, set_prolog_flag/2]).
+:- use_module(library(read), [read_term/3]).
+:- use_module(library(write), [writeq/1]).
+:- use_module(library(format), [format/2]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1]).
+:- use_module(library(terms_check), [variant/2]).
+:- use_module(library(lists), [length/2]).
+
+main([]) :- !,
+    mktemp_in_tmp('read_benchXXXXXX', File),
+    gen_data(File, 20000),
+    bench_files([File]),
+    delete_file(File).
+main(Files) :-
+    bench_files(Files).
+
+bench_files(Files) :-
+    bench(on, Files, T1, C1, Terms1),
+    bench(off, Files, T2, C2, Terms2),
+    report(native, T1, C1, Terms1),
+    report(prolog, T2, C2, Terms2),
+    ( variant(Terms1, Terms2) ->
+        format("Both tokenizers read the same terms~n", [])
+    ; format("*** Terms differ ***~n", [])
+    ),
+    ( T1 > 0 -> Speedup is T2/T1, format("Speedup: ~2fx~n", [Speedup])
+    ; true
+    ).
+
+report(Name, T, C, Terms) :-
+    length(Terms, N),
+    format("~w: ~d terms, ~d chars in ~d ms", [Name, N, C, T]),
+    ( T > 0 ->
+        KC is C/T,
+        format(" (~1f Kchars/s)~n", [KC])
+    ; format("~n", [])
+    ).
+
+bench(Flag, Files, T, C, Terms) :-
+    set_prolog_flag(native_tokenizer, Flag),
+    statistics(runtime, _),
+    read_files(Files, 0, C, Terms),
+    statistics(runtime, [_, T]),
+    set_prolog_flag(native_tokenizer, on).
+
+read_files([], C, C, []).
+read_files([F|Fs], C0, C, Terms) :-
+    open(F, read, S),
+    read_all(S, Terms, Terms0),
+    character_count(S, C1),
+    close(S),
+    C2 is C0+C1,
+    read_files(Fs, C2, C, Terms0).
+
+read_all(S, Terms, Terms0) :-
+    catch(read_term(S, T, [variable_names(Ns)]), E, (T = '$error'(E), Ns = [])),
+    ( T == end_of_file ->
+        Terms = Terms0
+    ; Terms = [T-Ns|Terms1],
+      read_all(S, Terms1, Terms0)
+    ).
+
+% ---------------------------------------------------------------------------
+% Synthetic data
+
+gen_data(File, N) :-
+    open(File, write, S),
+    current_output(Old),
+    set_output(S),
+    gen_clauses(0, N),
+    set_output(Old),
+    close(S).
+
+gen_clauses(I, N) :- I >= N, !.
+gen_clauses(I, N) :-
+    gen_clause(I),
+    I1 is I+1,
+    gen_clauses(I1, N).
+
+gen_clause(I) :-
+    K is I mod 4,
+    ( K =:= 0 ->
+        F is I*1.5,
+        writeq(fact(I, 'Quoted atom', "a string", F, [a, b-c, 0'x])),
+        display('.'), nl
+    ; K =:= 1 ->
+        display('% a comment line'), nl,
+        writeq((p(X, Y, I) :- q(X, Z), \+ r(Z, Y), Y is Z*2+I)),
+        display('.'), nl
+    ; K =:= 2 ->
+        display('/* a block comment */ '),
+        writeq(tree(node(I, leaf, leaf), {x, y}, 'Ünïcödé', -I, 0xff)),
+        display('.'), nl
+    ; writeq((:- op(200, xfy, ^^))),
+      display('.'), nl
+    ).
@@ -366,6 +366,12 @@ check_list_correctness(Loc, PredName, DP, GP, Arguments, VarNames) :-
 is_c_list_prop(c_uint8_list(ListVar), c_uint8, ListVar).
 is_c_list_prop(c_int_list(ListVar), c_int, ListVar).
 is_c_list_prop(c_double_list(ListVar), c_double, ListVar).
+is_c_list_prop(c_int8_array(ListVar), c_int8, ListVar).
+is_c_list_prop(c_int16_array(ListVar), c_int16, ListVar).
+is_c_list_prop(c_int32_array(ListVar), c_int32, ListVar).
+is_c_list_prop(c_int64_array(ListVar), c_int64, ListVar).
+is_c_list_prop(c_float_array(ListVar), c_float, ListVar).
+is_c_list_prop(c_double_array(ListVar), c_double, ListVar).
 
 valid_size_of_property(Arguments, ListVar, SizeVar, DP) :-
     \+ nocontainsx(Arguments, ListVar), 
@@ -33,6 +33,7 @@
 :- use_module(library(compiler/srcdbg), [srcdbg_expand/6]).
 :- use_module(library(compiler/global_module_options)).
 :- use_module(library(compiler/file_buffer)).
+:- use_module(library(compiler/content_stamps)).
 :- use_module(library(fastrw)).
 :- use_module(library(varnames/complete_dict)).
 :- use_module(engine(runtime_control), [current_prolog_flag/2,
@@ -68,7 +69,7 @@
 :- use_module(engine(internals), [ciao_root/1]).
 :- use_module(library(system), [
     modif_time0/2, modif_time/2, now/1, fmode/2, chmod/2,
-    working_directory/2, file_exists/1]).
+    working_directory/2, file_exists/1, touch/1]).
 :- use_module(library(dynamic/dynamic_rt),    [wellformed_body/3]).
 :- use_module(library(pathnames), [path_basename/2, path_split/3, path_concat/3, path_is_relative/1]).
 :- use_module(library(strings),    [whitespace0/2]).
@@ -757,7 +758,7 @@ new_file_status(ItfLevel, Base, PlName, Dir, Type, Status) :-
     itf_filename(Base, ItfName),
     modif_time0(ItfName, ItfTime),
     modif_time0(PlName, PlTime),
-    ( ItfTime >= PlTime,
+    ( itf_source_current(Base, PlName, ItfName, ItfTime, PlTime),
       read_itf(ItfLevel, ItfName, ItfTime, Base, Dir, Type) ->
         Status = itf_read(ItfName,ItfTime)
     ; read_record_file(PlName, Base, Dir, Type),
@@ -808,7 +809,7 @@ get_treat_action(Base, Status, Mode, StopP, SkipP, RedoP, Action) :-
             Action = action_treat_file(noread, gen_itf, ItfName)
         ; ( Status = file_noclauses(ItfName)
           ; Status = itf_read(ItfName,ItfTime),
-            changed_dependencies(Base, ItfTime)
+            changed_dependencies_refresh(Base, ItfName, ItfTime)
           ) ->
             Action = action_treat_file(read_record, gen_itf, ItfName)
         ; RedoP(Base) -> % Do not regenerate .itf
@@ -934,7 +935,7 @@ gen_itf(nogen, _Base, _PlName, _ItfName).
 gen_itf(gen_itf, Base, PlName, ItfName) :-
     ( fmode(PlName, Mode), % TODO: rename Mode in process_file (this is a file mode!)
       generate_itf(ItfName, Mode, Base) ->
-        true
+        gen_stamp(Base, PlName, ItfName, Mode)
     ; fail
     ).
 
@@ -970,7 +971,8 @@ delete_base_data :-
 :- export(cleanup_itf_cache/0).
 cleanup_itf_cache :-
     delete_time_of_itf_data(_),
-    delete_itf_data(_).
+    delete_itf_data(_),
+    retractall_fact(itf_interface_digest(_, _, _)).
 
 % ---------------------------------------------------------------------------
 :- doc(section, "Mapping between files and module names").
@@ -1626,7 +1628,8 @@ generate_itf(ItfName, Mode, Base) :-
       )
     ),
     now(Now),
-    assertz_fact(time_of_itf_data(Base,Now,1)).
+    assertz_fact(time_of_itf_data(Base,Now,1)),
+    retractall_fact(itf_interface_digest(Base, _, _)).
 
 write_itf_data_of(Format, Base) :-
     itf_data(ITF, Base, _, _, Fact),
@@ -1788,31 +1791,283 @@ changed_dependencies(Base, ItfTime) :-
     % Assume that if any of the imported files have changed our
     % dependencies have potentially changed too (which is faster than
     % the fine-grained method although it may raise some false
-    % positives)
+    % positives), unless their interface digests are the same as
+    % when our itf was generated
     ( uses(Base, File)
     ; adds(Base, File)
     ),
-    file_data(File, PlName, _),
+    base_name(File, BFile),
+    file_data(BFile, PlName, _),
     modif_time(PlName, PlTime),
-    PlTime > ItfTime.
+    PlTime > ItfTime,
+    \+ unchanged_dependency(Base, use, File).
 :- endif.
 changed_dependencies(Base, ItfTime) :-
     includes(Base, File),
     base_name(File, BFile),
     file_data(BFile, PlName, _),
     modif_time(PlName, PlTime),
-    PlTime > ItfTime.
+    PlTime > ItfTime,
+    \+ unchanged_dependency(Base, include, File).
 changed_dependencies(Base, ItfTime) :-
     loads(Base, File),
     base_name(File, Base2),
     ( file_data(Base2, PlName2, _),
       modif_time(PlName2, PlTime2),
-      PlTime2 > ItfTime
+      PlTime2 > ItfTime ->
+        true
     ; itf_filename(Base2, ItfName),
       modif_time0(ItfName, ItfTime2),
       ItfTime2 > ItfTime
+    ),
+    \+ unchanged_dependency(Base, load, File).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Content stamps").
+
+% Modification times are only a first approximation of changes. When
+% a source is not older than its itf file, or one of its dependencies
+% looks newer, the digests recorded in its stamp (see
+% @lib{content_stamps}) decide whether it really changed, so that
+% touching files, switching branches, or changing only the clauses of
+% an imported module do not force recompilation.
+%
+% A stamp is stamp(ItfDigest, SrcDigest, Deps), where Deps is a list
+% of dep(Kind, File, Digest), Kind is include or load (Digest is the
+% digest of the included file or of the source of the module loaded
+% for compilation) or use (Digest is the interface digest of the
+% imported module), and File is as in includes/2, loads/2, uses/2 or
+% adds/2. Stamps are ignored unless ItfDigest is the digest of the
+% current itf file.
+
+% The itf file of Base, generated at time ItfTime, has interface
+% digest Digest
+:- data itf_interface_digest/3.
+
+gen_stamp(Base, PlName, ItfName, Mode) :-
+    ( file_digest(ItfName, ItfDigest),
+      file_digest(PlName, SrcDigest) ->
+        findall(Dep, stamp_dependency(Base, Dep), Deps),
+        write_stamp(Base, Mode, stamp(ItfDigest, SrcDigest, Deps))
+    ; delete_stamp(Base)
     ).
 
+stamp_dependency(Base, dep(include, File, Digest)) :-
+    includes(Base, File),
+    source_digest(File, Digest).
+stamp_dependency(Base, dep(load, File, Digest)) :-
+    loads(Base, File),
+    source_digest(File, Digest).
+stamp_dependency(Base, dep(use, File, Digest)) :-
+    ( uses(Base, File)
+    ; adds(Base, File)
+    ),
+    base_name(File, BFile),
+    interface_digest(BFile, Digest).
+
+source_digest(File, Digest) :-
+    base_name(File, BFile),
+    file_data(BFile, PlName, _),
+    file_digest(PlName, Digest).
+
+% Stamp of Base, if it describes its current itf file
+valid_stamp(Base, ItfName, Stamp) :-
+    read_stamp(Base, Stamp),
+    Stamp = stamp(ItfDigest, _, _),
+    file_digest(ItfName, ItfDigest).
+
+% The contents of the source of Base did not change since its itf
+% file was generated
+source_unchanged(Base, PlName, ItfName) :-
+    valid_stamp(Base, ItfName, stamp(_, SrcDigest, _)),
+    file_digest(PlName, SrcDigest).
+
+% The dependency File of Base did not change since the itf file of
+% Base was generated
+unchanged_dependency(Base, Kind, File) :-
+    itf_filename(Base, ItfName),
+    valid_stamp(Base, ItfName, stamp(_, _, Deps)),
+    member(dep(Kind, File, Digest), Deps), !,
+    ( Kind = use ->
+        base_name(File, BFile),
+        interface_digest(BFile, Digest)
+    ; source_digest(File, Digest)
+    ),
+    ( current_fact(unchanged_dependencies(Base)) -> true
+    ; assertz_fact(unchanged_dependencies(Base))
+    ).
+
+% Some dependency of Base looked newer than its itf file but did not
+% change
+:- data unchanged_dependencies/1.
+
+% Like changed_dependencies/2, refreshing the itf file of Base when
+% dependencies look newer but did not change
+changed_dependencies_refresh(Base, ItfName, ItfTime) :-
+    retractall_fact(unchanged_dependencies(Base)),
+    ( changed_dependencies(Base, ItfTime) ->
+        retractall_fact(unchanged_dependencies(Base))
+    ; retract_fact(unchanged_dependencies(Base)),
+      refresh_itf_products(Base, ItfName, ItfTime),
+      fail
+    ).
+
+% The itf file of Base describes the current contents of its source.
+% Modification times only decide when the itf file is strictly newer
+% (the source may have changed in the same second it was generated);
+% otherwise the source digest in a valid stamp must match (refreshing
+% the itf file if the source looks newer). Without a stamp, an itf
+% file as old as its source is assumed to be up to date.
+itf_source_current(Base, PlName, ItfName, ItfTime, PlTime) :-
+    ( ItfTime > PlTime ->
+        true
+    ; valid_stamp(Base, ItfName, stamp(_, SrcDigest, _)) ->
+        file_digest(PlName, SrcDigest),
+        ( ItfTime < PlTime ->
+            refresh_itf_products(Base, ItfName, ItfTime)
+        ; true
+        )
+    ; ItfTime =:= PlTime
+    ).
+
+% The source of Base looks newer than its itf file (with modification
+% time ItfTime) but did not change: refresh the itf file
+refresh_unchanged_itf(Base, PlName, ItfName, ItfTime) :-
+    source_unchanged(Base, PlName, ItfName),
+    refresh_itf_products(Base, ItfName, ItfTime).
+
+:- export(refresh_unchanged_source/1).
+:- pred refresh_unchanged_source(Base) # "If the source @var{Base}.pl
+   looks newer than its itf file but its contents did not change,
+   update the modification times of the itf file and of the products
+   of its compilation that were up to date, so that checks based only
+   on modification times (e.g., @lib{up_to_date}) hold again.".
+
+refresh_unchanged_source(Base) :-
+    atom_concat(Base, '.pl', PlName),
+    itf_filename(Base, ItfName),
+    modif_time0(ItfName, ItfTime),
+    modif_time0(PlName, PlTime),
+    ItfTime > 0,
+    ItfTime < PlTime,
+    refresh_unchanged_itf(Base, PlName, ItfName, ItfTime),
+    !.
+refresh_unchanged_source(_).
+
+% Update the modification time of the itf file of Base (which has not
+% changed since ItfTime) and of the products of its compilation that
+% were not older than it (in this order, so that they are still
+% considered up to date w.r.t. the itf file)
+refresh_itf_products(Base, ItfName, ItfTime) :-
+    findall(Name, ( refreshed_product(Type),
+                    product_filename(Type, Base, Name),
+                    modif_time0(Name, Time),
+                    Time >= ItfTime ), Names),
+    touch_nofail(ItfName),
+    ( member(Name, Names),
+        touch_nofail(Name),
+        fail
+    ; true
+    ).
+
+refreshed_product(prolog_object).
+refreshed_product(prolog_wam).
+refreshed_product(prolog_assertion).
+refreshed_product(prolog_assertion2).
+
+% (e.g., for read-only installations)
+touch_nofail(File) :-
+    prolog_flag(fileerrors, OldFE, off),
+    ( catch(touch(File), _, fail) -> true ; true ),
+    set_prolog_flag(fileerrors, OldFE).
+
+itf_up_to_date(Base) :-
+    file_data(Base, PlName, _),
+    itf_filename(Base, ItfName),
+    modif_time0(ItfName, ItfTime),
+    ItfTime > 0,
+    modif_time0(PlName, PlTime),
+    ( ItfTime >= PlTime -> true
+    ; source_unchanged(Base, PlName, ItfName)
+    ).
+
+% Digest of the data in the itf file of Base that is visible to
+% importers (including the interfaces of reexported modules). If the
+% itf file is not up to date, the source of Base has been read in this
+% compilation (see get_file_deps/2) and the digest is computed from
+% the data to be written in its new itf file. Fails otherwise.
+interface_digest(Base, Digest) :-
+    interface_digest_(Base, [], Digest).
+
+interface_digest_(Base, Seen, Digest) :-
+    ( itf_up_to_date(Base) ->
+        itf_filename(Base, ItfName),
+        modif_time0(ItfName, ItfTime),
+        ( current_fact(itf_interface_digest(Base, ItfTime, Digest0)) ->
+            true
+        ; read_itf_interface(ItfName, Interface),
+          interface_digest_of(Interface, Base, Seen, Digest0),
+          retractall_fact(itf_interface_digest(Base, _, _)),
+          assertz_fact(itf_interface_digest(Base, ItfTime, Digest0))
+        )
+    ; current_fact(status(Base, file_read(_))) ->
+        findall(ITF, ( itf_data(ITF, Base, _, _, Fact),
+                       interface_itf_data(ITF),
+                       current_fact(Fact) ), Interface),
+        interface_digest_of(Interface, Base, Seen, Digest0)
+    ; fail
+    ),
+    Digest = Digest0.
+
+interface_digest_of(Interface, Base, Seen, Digest) :-
+    findall(File-D, ( member(h(File), Interface),
+                      reexported_digest(File, [Base|Seen], D) ), Reexported),
+    term_digest(Interface-Reexported, Digest).
+
+reexported_digest(File, Seen, Digest) :-
+    ( base_name(File, BFile),
+      \+ member(BFile, Seen),
+      interface_digest_(BFile, Seen, Digest0) ->
+        Digest = Digest0
+    ; Digest = unknown
+    ).
+
+read_itf_interface(ItfName, Interface) :-
+    prolog_flag(fileerrors, OldFE, off),
+    ( '$open'(ItfName, r, Stream) -> true ; Stream = none ),
+    set_prolog_flag(fileerrors, OldFE),
+    Stream \== none,
+    current_input(CI),
+    set_input(Stream),
+    ( itf_version(V),
+      read(v(V,Format)) ->
+        read_itf_interface_(Format, Interface0)
+    ; Interface0 = none
+    ),
+    set_input(CI),
+    close(Stream),
+    Interface0 \== none,
+    Interface = Interface0.
+
+read_itf_interface_(Format, Interface) :-
+    do_read(Format, ITF),
+    ( ITF = end_of_file ->
+        Interface = []
+    ; interface_itf_data(ITF) ->
+        Interface = [ITF|Interface0],
+        read_itf_interface_(Format, Interface0)
+    ; read_itf_interface_(Format, Interface)
+    ).
+
+% (see itf_data/5)
+interface_itf_data(m(_)).         % defines_module/2
+interface_itf_data(h(_)).         % reexports_from/2
+interface_itf_data(m(_,_,_)).     % def_multifile/4
+interface_itf_data(e(_,_,_,_)).   % direct_export/5
+interface_itf_data(r(_,_,_)).     % reexports/4
+interface_itf_data(r(_)).         % reexports_all/2
+interface_itf_data(d(_)).         % decl/2
+
 % ---------------------------------------------------------------------------
 
 :- meta_predicate sequence_contains(+, pred(1), -, -).
@@ -1979,6 +2234,22 @@ make_po_file_1(Base, FilePred, Mode, Message) :-
     end_doing.
 
 make_po_file_2(PoName, Mode, Base, Module, Source) :-
+    Mode = ql(_),
+    po_cache_key(Base, Key),
+    !,
+    ( objcache_fetch(Key, '.po', PoName) ->
+        fmode(Source, FMode),
+        chmod(PoName, FMode)
+    ; make_po_file_3(PoName, Mode, Base, Module, Source),
+      ( file_exists(PoName) ->
+          objcache_store(Key, '.po', PoName)
+      ; true
+      )
+    ).
+make_po_file_2(PoName, Mode, Base, Module, Source) :-
+    make_po_file_3(PoName, Mode, Base, Module, Source).
+
+make_po_file_3(PoName, Mode, Base, Module, Source) :-
     file_buffer_begin(PoName, Buffer, Stream),
     flatten_mod_name(Module, FlatModule), % TODO: use flat name in more places?
     reset_counter(FlatModule),
@@ -1998,6 +2269,44 @@ make_po_file_2(PoName, Mode, Base, Module, Source) :-
     ; file_buffer_erase(Buffer) % TODO: keep previous version instead?
     ).
 
+% Key of the .po of Base in the object cache (see @lib{content_stamps}).
+% It identifies the compiler, the flags that change the generated
+% code, the path of Base (.po files contain absolute paths, e.g., of
+% the source and of the modules it imports), and the stamp of Base
+% (i.e., its source and itf, its included files, the sources of the
+% modules loaded for its compilation, and the interfaces of its
+% imported modules). Fails if the object cache is not enabled or some
+% of these is not known.
+po_cache_key(Base, Key) :-
+    objcache_enabled,
+    itf_filename(Base, ItfName),
+    valid_stamp(Base, ItfName, Stamp),
+    Stamp = stamp(_, _, Deps),
+    \+ ( ( uses(Base, File) ; adds(Base, File) ),
+          \+ member(dep(use, File, _), Deps) ),
+    \+ ( loads(Base, File),
+          \+ member(dep(load, File, _), Deps) ),
+    poversion(PoVersion),
+    compiler_version(CompilerVersion),
+    current_prolog_flag(version_data, VersionData),
+    findall(Flag=Value, ( po_cache_flag(Flag),
+                          current_prolog_flag(Flag, Value) ), Flags),
+    term_digest(po(PoVersion, CompilerVersion, VersionData, Flags, Base, Stamp),
+                Key).
+
+po_cache_flag(read_assertions).
+po_cache_flag(runtime_checks).
+po_cache_flag(rtchecks_level).
+po_cache_flag(rtchecks_trust).
+po_cache_flag(rtchecks_entry).
+po_cache_flag(rtchecks_exit).
+po_cache_flag(rtchecks_test).
+po_cache_flag(rtchecks_asrloc).
+po_cache_flag(rtchecks_predloc).
+po_cache_flag(rtchecks_callloc).
+po_cache_flag(rtchecks_namefmt).
+po_cache_flag(keep_assertions).
+
 % ---------------------------------------------------------------------------
 :- doc(section, "Expand and check assertions").
 
@@ -0,0 +1,221 @@
+:- module(_, [], [assertions, nortchecks]).
+
+:- doc(title, "Content stamps for incremental compilation").
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module implements the content digests used by
+   @lib{c_itf} to decide recompilation from the contents of files, in
+   addition to their modification times, and an optional
+   @concept{object cache} that survives cleaning build directories.
+
+   The @em{stamp} of a source (a @tt{.stamp} file next to its
+   @tt{.itf} file) records the digest of the @tt{.itf} file that it
+   describes, the digest of the source, the digests of the included
+   files, and the @em{interface digests} of the imported modules at
+   the time the @tt{.itf} file was generated. Digests are SHA-256
+   hashes computed natively by the engine (see @lib{digest}).
+
+   The object cache is enabled by setting the @tt{CIAOOBJCACHE}
+   environment variable to a directory (which is created if needed).
+   Entries are named after the digest of all the inputs of a
+   compilation, including the path of the source (compiled files
+   contain absolute paths), so that cleaned builds or switching back
+   and forth between branches reuse previous compilations.").
+
+:- use_module(engine(internals), [
+    '$digest_init'/2, '$digest_update'/3, '$digest_update_file'/3,
+    '$digest_final'/2, stamp_filename/2, '$open'/3]).
+:- use_module(engine(stream_basic)).
+:- use_module(engine(runtime_control), [prolog_flag/3, set_prolog_flag/2]).
+:- use_module(library(system), [
+    file_exists/1, copy_file/3, rename_file/2, mktemp/2, getenvstr/2,
+    make_directory/1, chmod/2]).
+:- use_module(library(pathnames), [path_concat/3]).
+:- use_module(library(fastrw), [fast_read/1, fast_write/1]).
+:- use_module(library(compiler/file_buffer)).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Digests").
+
+:- export(file_digest/2).
+:- pred file_digest(+File, -Digest) # "@var{Digest} is the digest of
+   the contents of @var{File}. Fails if @var{File} cannot be read.".
+
+file_digest(File, Digest) :-
+    '$digest_init'(sha256, Ctx0),
+    catch('$digest_update_file'(Ctx0, File, Ctx), _, fail),
+    '$digest_final'(Ctx, Digest).
+
+:- export(term_digest/2).
+:- pred term_digest(+Term, -Digest) # "@var{Digest} is the digest of
+   @var{Term}. Variables are numbered in order of appearance, so that
+   variants have the same digest.".
+
+term_digest(Term, Digest) :-
+    '$digest_init'(sha256, Ctx0),
+    digest_term(Term, [], _, Ctx0, Ctx),
+    '$digest_final'(Ctx, Digest).
+
+% (each node is prefixed by its type and terminated by a newline, so
+% that different terms have different encodings)
+digest_term(X, Vs0, Vs, Ctx0, Ctx) :- var(X), !,
+    var_index(Vs0, X, 0, I, Vs),
+    digest_line('v', I, Ctx0, Ctx).
+digest_term(X, Vs, Vs, Ctx0, Ctx) :- atom(X), !,
+    digest_line('a', X, Ctx0, Ctx).
+digest_term(X, Vs, Vs, Ctx0, Ctx) :- number(X), !,
+    digest_line('n', X, Ctx0, Ctx).
+digest_term(X, Vs0, Vs, Ctx0, Ctx) :-
+    functor(X, N, Ar),
+    digest_line('f', Ar, Ctx0, Ctx1),
+    digest_line('a', N, Ctx1, Ctx2),
+    digest_args(1, Ar, X, Vs0, Vs, Ctx2, Ctx).
+
+digest_args(I, Ar, _, Vs, Vs, Ctx0, Ctx) :- I > Ar, !, Ctx = Ctx0.
+digest_args(I, Ar, X, Vs0, Vs, Ctx0, Ctx) :-
+    arg(I, X, Y),
+    digest_term(Y, Vs0, Vs1, Ctx0, Ctx1),
+    I1 is I + 1,
+    digest_args(I1, Ar, X, Vs1, Vs, Ctx1, Ctx).
+
+digest_line(Type, X, Ctx0, Ctx) :-
+    ( atom(X) -> A = X
+    ; number_codes(X, Cs),
+      atom_codes(A, Cs)
+    ),
+    '$digest_update'(Ctx0, Type, Ctx1),
+    '$digest_update'(Ctx1, A, Ctx2),
+    '$digest_update'(Ctx2, '\n', Ctx).
+
+% I is the index of variable X in Vs0 (which is extended with X as Vs
+% if needed)
+var_index([], X, I0, I, [X]) :- I = I0.
+var_index([V|Vs0], X, I0, I, Vs) :-
+    ( V == X ->
+        I = I0, Vs = [V|Vs0]
+    ; I1 is I0 + 1,
+      Vs = [V|Vs1],
+      var_index(Vs0, X, I1, I, Vs1)
+    ).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Stamp files").
+
+stamp_version(1).
+
+:- export(read_stamp/2).
+:- pred read_stamp(+Base, -Stamp) # "@var{Stamp} is the term stored in
+   the stamp file of source @var{Base}.pl. Fails if there is no valid
+   stamp file.".
+
+read_stamp(Base, Stamp) :-
+    stamp_filename(Base, Name),
+    file_exists(Name),
+    prolog_flag(fileerrors, OldFE, off),
+    ( '$open'(Name, r, Stream) -> true ; Stream = none ),
+    set_prolog_flag(fileerrors, OldFE),
+    Stream \== none,
+    current_input(CI),
+    set_input(Stream),
+    ( fast_read(V), stamp_version(V), fast_read(Stamp0) -> OK = yes
+    ; OK = no
+    ),
+    set_input(CI),
+    close(Stream),
+    OK = yes,
+    Stamp = Stamp0.
+
+:- export(write_stamp/3).
+:- pred write_stamp(+Base, +Mode, +Stamp) # "Store @var{Stamp} in the
+   stamp file of source @var{Base}.pl, with file mode @var{Mode}. The
+   stamp file is removed if it cannot be written.".
+
+write_stamp(Base, Mode, Stamp) :-
+    stamp_filename(Base, Name),
+    file_buffer_begin(Name, Buffer, Stream),
+    current_output(CO),
+    set_output(Stream),
+    stamp_version(V),
+    fast_write(V),
+    fast_write(Stamp),
+    set_output(CO),
+    ( file_buffer_commit(Buffer) -> chmod(Name, Mode)
+    ; del_file_nofail(Name)
+    ).
+
+:- export(delete_stamp/1).
+delete_stamp(Base) :-
+    stamp_filename(Base, Name),
+    del_file_nofail(Name).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Object cache").
+
+:- export(objcache_enabled/0).
+:- pred objcache_enabled # "The object cache is enabled.".
+
+objcache_enabled :-
+    objcache_dir(_).
+
+objcache_dir(Dir) :-
+    getenvstr('CIAOOBJCACHE', Cs),
+    Cs = [_|_],
+    atom_codes(Dir, Cs).
+
+% (entries are spread in subdirectories named after the first two
+% digits of their keys)
+objcache_entry(Key, Ext, Entry) :-
+    objcache_entry_dir(Key, SubDir),
+    atom_concat(Key, Ext, Name),
+    path_concat(SubDir, Name, Entry).
+
+objcache_entry_dir(Key, SubDir) :-
+    objcache_dir(Dir),
+    sub_atom(Key, 0, 2, Sub),
+    path_concat(Dir, Sub, SubDir).
+
+:- export(objcache_fetch/3).
+:- pred objcache_fetch(+Key, +Ext, +File) # "Copy the entry of the
+   object cache for @var{Key} and extension @var{Ext} to
+   @var{File}. Fails if there is no such entry.".
+
+objcache_fetch(Key, Ext, File) :-
+    objcache_entry(Key, Ext, Entry),
+    file_exists(Entry),
+    copy_atomic(Entry, File).
+
+:- export(objcache_store/3).
+:- pred objcache_store(+Key, +Ext, +File) # "Store a copy of @var{File}
+   in the object cache, as the entry for @var{Key} and extension
+   @var{Ext}. Errors are ignored.".
+
+objcache_store(Key, Ext, File) :-
+    objcache_entry(Key, Ext, Entry),
+    ( file_exists(Entry) ->
+        true
+    ; objcache_dir(Dir),
+      objcache_entry_dir(Key, SubDir),
+      ensure_directory(Dir),
+      ensure_directory(SubDir),
+      copy_atomic(File, Entry) ->
+        true
+    ; true
+    ).
+
+ensure_directory(Dir) :-
+    ( file_exists(Dir) -> true
+    ; catch(make_directory(Dir), _, true), % (may be created concurrently)
+      file_exists(Dir)
+    ).
+
+% Copy Source to Target, replacing Target atomically (so that
+% concurrent builds never see partial files)
+copy_atomic(Source, Target) :-
+    atom_concat(Target, '-tmpciaoXXXXXX', TmpTemplate),
+    catch(mktemp(TmpTemplate, Tmp), _, fail),
+    ( catch(copy_file(Source, Tmp, [overwrite]), _, fail),
+      catch(rename_file(Tmp, Target), _, fail) ->
+        true
+    ; del_file_nofail(Tmp),
+      fail
+    ).
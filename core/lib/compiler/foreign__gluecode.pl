@@ -45,6 +45,7 @@ interface_function_body(F/A, Module, ForeignName, Arguments, ResVar, NeedsCtx) -
     params_apply(~filter_compound(Arguments), check),
     params_apply(~filter_single(Arguments), to_c),
     params_apply(~filter_compound(Arguments), to_c),
+    params_apply(~filter_single(Arguments), check_length),
     % c call
     do_call(ForeignName, Arguments, ResVar, NeedsCtx), 
     % c -> prolog
@@ -71,6 +72,7 @@ param_apply(u_decl, X) --> !, param_apply_u_decl(X).
 param_apply(ref, X) --> !, param_apply_ref(X).
 param_apply(check, X) --> !, param_apply_check(X).
 param_apply(to_c, X) --> !, param_apply_to_c(X).
+param_apply(check_length, X) --> !, param_apply_check_length(X).
 param_apply(from_c, X) --> !, param_apply_from_c(X).
 param_apply(free, X) --> !, param_apply_free(X).
 param_apply(unify, X) --> !, param_apply_unify(X).
@@ -106,6 +108,11 @@ param_apply_to_c(arg(N, TTr, compound(_), _)) --> { ToC = ~ttr_to_c(TTr) }, !,
     [~c(N) = call(ToC, [ctx, ~t(N)])].
 param_apply_to_c(_) --> !.
 
+% (check the given length if the data knows its own length)
+param_apply_check_length(X) --> { X = arg(N, TTr, compound(LengthN), _), LengthOf = ~ttr_length_of(TTr) }, !,
+    [if(~c(LengthN) > call(LengthOf, [ctx, ~t(N)]), ~exception_code(X))].
+param_apply_check_length(_) --> !.
+
 param_apply_from_c(arg(N, TTr, XN, _)) --> { FromC = ~ttr_from_c(TTr) }, !,
     [~u(N) = ~from_c_code(FromC, N, XN)].
 param_apply_from_c(_) --> !.
@@ -160,6 +167,7 @@ x(N) := call('X', [N]).
 :- data ttr_call_cref/2.
 :- data ttr_from_c/2.
 :- data ttr_free/2.
+:- data ttr_length_of/2.
 
 load_ttr_defs([Decl|Decls]) :- !,
     ( Decl = ttr_def(X, Ys) -> assert_ttr_def(Ys, X) ; true ), 
@@ -179,6 +187,7 @@ assert_ttr_def_2(compound, X, V) :- !, asserta_fact(ttr_compound(X, V)).
 assert_ttr_def_2(call_cref, X, V) :- !, asserta_fact(ttr_call_cref(X, V)).
 assert_ttr_def_2(from_c, X, V) :- !, asserta_fact(ttr_from_c(X, V)).
 assert_ttr_def_2(free, X, V) :- !, asserta_fact(ttr_free(X, V)).
+assert_ttr_def_2(length_of, X, V) :- !, asserta_fact(ttr_length_of(X, V)).
 
 :- data ttr_match_0/4.
 
@@ -208,6 +217,7 @@ clean_all_ttr :-
     retractall_fact(ttr_compound(_, _)),
     retractall_fact(ttr_call_cref(_, _)),
     retractall_fact(ttr_from_c(_, _)),
-    retractall_fact(ttr_free(_, _)).
+    retractall_fact(ttr_free(_, _)),
+    retractall_fact(ttr_length_of(_, _)).
 
 
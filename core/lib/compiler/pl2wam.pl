@@ -309,9 +309,56 @@ compile_one_proc(Profiled, Head, Body, Choice, ClName, Data) :-
     ),
     profile_struct(Profiled, ProfileData, _, _, _),
     trans_clause(ProfileData, Body1, FinalCode, TypeKey0, TypeKey),
-    compile_file_emit(clause(ClName,FinalCode,ProfileData,TypeKey,Data)),
+    Head = structure(_, Args),
+    index_keys(Args, IxKeys),
+    compile_file_emit(clause(ClName,FinalCode,ProfileData,TypeKey,IxKeys,Data)),
     emit_models(ProfileData, ClName).
 
+% Keys for secondary indexing (see incore_index_t in the engine):
+% Pos-Key for the head arguments other than the first one and for the
+% arguments of the head arguments, with Pos = Arg + 256*SubArg (SubArg
+% is 0 for the argument itself). Only the first few positions are
+% considered.
+
+index_keys(Args, IxKeys) :-
+    index_keys_(Args, 1, IxKeys, []).
+
+index_keys_([], _) --> [].
+index_keys_([X|Xs], I) -->
+    ( { I > 8 } -> []
+    ; ( { I > 1 } -> index_key(X, I) ; [] ),
+      index_subkeys(X, I),
+      { I1 is I+1 },
+      index_keys_(Xs, I1)
+    ).
+
+index_subkeys(list(X,Y), I) --> !,
+    { P1 is I+256, P2 is I+512 },
+    index_key(X, P1),
+    index_key(Y, P2).
+index_subkeys(structure(_,Xs), I) --> !,
+    index_subkeys_(Xs, 1, I).
+index_subkeys(_, _) --> [].
+
+index_subkeys_([], _, _) --> [].
+index_subkeys_([X|Xs], J, I) -->
+    ( { J > 4 } -> []
+    ; { P is I+256*J },
+      index_key(X, P),
+      { J1 is J+1 },
+      index_subkeys_(Xs, J1, I)
+    ).
+
+index_key(constant(K), P) --> !,
+    % (no key for large numbers, see incore_index_key() in the engine)
+    ( { number(K), large_heap_usage(K, _) } -> [] ; [P-K] ).
+index_key(nil, P) --> !, [P-[]].
+index_key(list(_,_), P) --> !, [P-[_|_]].
+index_key(structure(F,Xs), P) --> !,
+    { length(Xs, A), functor(K, F, A) },
+    [P-K].
+index_key(_, _) --> [].
+
 doing_wam :-
     compiler_mode(Mode), !, Mode = wam.
 
@@ -0,0 +1,70 @@
+:- module(_, [], [assertions, nativeprops]).
+
+:- doc(title, "Tests for pl2wam.pl").
+
+:- doc(module, "Checks indexing of static predicates on arguments other
+   than the first one and on the arguments of the first one: calls
+   select the same clauses, in the same order, and calls that match a
+   single clause leave no choicepoints.").
+
+:- use_module(library(aggregates), [findall/3]).
+
+:- export(rule/3).
+rule(a, 1, x).
+rule(b, 2, y).
+rule(c, 3, z).
+rule(a, 4, w).
+
+:- test rule(T, I, R) : (I = 2) => (T = b, R = y) + (not_fails, is_det).
+:- test rule(T, I, R) : (T = a, I = 4) => (R = w) + (not_fails, is_det).
+:- test rule(T, I, R) : (I = 5) + fails.
+
+:- export(table/2).
+table(f(a), 1).
+table(f(b), 2).
+table(f(c), 3).
+table(g, 4).
+table(f(_), 5).
+
+:- test table(K, V) : (K = f(d)) => (V = 5) + (not_fails, is_det).
+:- test table(K, V) : (K = g) => (V = 4) + (not_fails, is_det).
+
+:- export(prefix/2).
+prefix([a|_], 1).
+prefix([b|_], 2).
+prefix([], 3).
+
+:- test prefix(L, V) : (L = [a, b]) => (V = 1) + (not_fails, is_det).
+:- test prefix(L, V) : (L = [b]) => (V = 2) + (not_fails, is_det).
+
+:- export(all_solutions/0).
+:- test all_solutions # "All the matching clauses, in order".
+
+all_solutions :-
+    findall(T-I-R, rule(T, I, R), [a-1-x, b-2-y, c-3-z, a-4-w]),
+    findall(I-R, rule(a, I, R), [1-x, 4-w]),
+    findall(V, table(f(_), V), [1, 2, 3, 5]),
+    findall(V, table(f(b), V), [2, 5]),
+    findall(K-V, table(K, V), [f(a)-1, f(b)-2, f(c)-3, g-4, f(_)-5]),
+    findall(V, prefix([_|_], V), [1, 2]).
+
+:- export(large/3).
+large(a, x, 1).
+large(a, 100000000000000000000000, 2).
+large(a, y, 3).
+large(a, 2.5, 4).
+large(a, f(100000000000000000000001), 5).
+large(a, _, 6).
+
+:- export(large_numbers/0).
+:- test large_numbers # "Large numbers (bignums and floats) select the
+   clauses where they appear".
+
+large_numbers :-
+    findall(N, large(a, 100000000000000000000000, N), [2, 6]),
+    X is 100000000000 * 1000000000000,
+    findall(N, large(a, X, N), [2, 6]),
+    findall(N, large(a, 100000000000000000000001, N), [6]),
+    findall(N, large(a, 2.5, N), [4, 6]),
+    findall(N, large(a, f(100000000000000000000001), N), [5, 6]),
+    findall(N, large(a, y, N), [3, 6]).
@@ -749,10 +749,9 @@ ql_compile_file_emit(instruction_model(Clause,InsnModel), Stream) :-
 E_GAUGE ***/
 ql_compile_file_emit(set_currmod(Mod), Stream) :- !,
     ql_emit_directive('internals:$set_currmod'(Mod), _, _, Stream).
-ql_compile_file_emit(clause(Pred/_,Code,ProfileData,TypeKey,Data), Stream) :- !,
-    Data = f(EffType,EffKey),
+ql_compile_file_emit(clause(Pred/_,Code,ProfileData,TypeKey,IxKeys,Data), Stream) :- !,
     profile_struct(_,ProfileData,_,InsnModel,Counters),
-    incore_parse_key(TypeKey, EffType, EffKey),
+    clause_data(TypeKey, IxKeys, Data),
     asm_insns(Code, InsnModel, 0, Size, Tokens, []),
     qdump_load_dbnode(0, Size, Counters, Stream),
     qdump(Tokens, 0, Dic, Stream),
@@ -826,10 +825,9 @@ incore_compile_file_emit(instruction_model(Clause,InsnModel)) :-
 E_GAUGE ***/
 incore_compile_file_emit(set_currmod(Mod)) :- !,
     '$set_currmod'(Mod).
-incore_compile_file_emit(clause(Pred/_,Code,ProfileData,TypeKey,Data)) :- !,
-    Data = f(EffType,EffKey),
+incore_compile_file_emit(clause(Pred/_,Code,ProfileData,TypeKey,IxKeys,Data)) :- !,
     profile_struct(_,ProfileData,_,InsnModel,Counters),
-    incore_parse_key(TypeKey, EffType, EffKey),
+    clause_data(TypeKey, IxKeys, Data),
     asm_insns(Code, InsnModel, 0, Size, Tokens, []),
     '$make_bytecode_object'(Size, Counters, Tokens, Obj),
     define_predicate_mode(Mode),
@@ -850,6 +848,13 @@ incore_subdef(1, PredName) :- !,
     asserta_fact(incore_mode_of(Head0, Mode)).
 incore_subdef(_, _).
 
+% Data for '$compiled_clause'/4: f(Type,Key) or f(Type,Key,IxKeys)
+clause_data(TypeKey, IxKeys, Data) :-
+    incore_parse_key(TypeKey, EffType, EffKey),
+    ( IxKeys = [] -> Data = f(EffType,EffKey)
+    ; Data = f(EffType,EffKey,IxKeys)
+    ).
+
 incore_parse_key(type_key(Type,hash(N/A)), Type, F) :- !, functor(F, N, A).
 incore_parse_key(type_key(Type,hash(K)), Type, K) :- !.
 incore_parse_key(type_key(Type,nohash), Type, _).
@@ -858,10 +863,9 @@ incore_parse_key(type_key(Type,nohash), Type, _).
 incore_ql_compile_file_emit(set_currmod(Mod), Stream) :- !,
     '$set_currmod'(Mod),
     ql_emit_directive('internals:$set_currmod'(Mod), _, _, Stream).
-incore_ql_compile_file_emit(clause(Pred/_,Code,ProfileData,TypeKey,Data), Stream) :- !,
-    Data = f(EffType,EffKey),
+incore_ql_compile_file_emit(clause(Pred/_,Code,ProfileData,TypeKey,IxKeys,Data), Stream) :- !,
     profile_struct(_,ProfileData,_,InsnModel,Counters),
-    incore_parse_key(TypeKey, EffType, EffKey),
+    clause_data(TypeKey, IxKeys, Data),
     asm_insns(Code, InsnModel, 0, Size, Tokens, []),
     '$make_bytecode_object'(Size, Counters, Tokens, Obj),
     qdump_load_dbnode(0, Size, Counters, Stream),
@@ -1221,7 +1225,7 @@ wam_compile_file_emit(set_currmod(Mod), Stream) :- !,
     set_output(Stream),
     display('set_currmod('), displayq(Mod), display(').'), nl,
     set_output(Cout).
-wam_compile_file_emit(clause(Pred/No,Code,_,TypeKey,Data), Stream) :- !,
+wam_compile_file_emit(clause(Pred/No,Code,_,TypeKey,_,Data), Stream) :- !,
     Data = f(EffType,EffKey),
     incore_parse_key(TypeKey, EffType, EffKey),
     wam_clause_name(Pred/No, ClName),
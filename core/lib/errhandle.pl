@@ -127,6 +127,7 @@ translate_ball(integer,             'an integer') :- !.
 translate_ball(list,                'a list') :- !.
 translate_ball(number,              'a number') :- !.
 translate_ball(predicate_indicator, 'a predicate indicator') :- !.
+translate_ball(rational,            'a rational number') :- !.
 % TODO: RH : remove in ISO corregendum 2.
 %translate_ball(variable,            'an (unbound) variable') :- !.
 %
@@ -0,0 +1,25 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for the C API of the foreign interface").
+
+:- doc(module, "Runs queries from C threads, each with its own
+   context, through the C functions in
+   @tt{tests/embedding_threads.c}.").
+
+:- use_module(library(foreign_interface/tests/embedding_threads)).
+
+:- export(time_slices/0).
+:- test time_slices # "Queries with a time slice are suspended and
+   resumed until they end".
+
+time_slices :-
+    count_sliced(2000000, 1000, Suspensions),
+    Suspensions > 0,
+    % (no suspensions without a time slice)
+    count_sliced(2000000, 0, 0).
+
+:- export(threads/0).
+:- test threads # "Queries run at the same time in several threads".
+
+threads :-
+    count_threads(8, 500000, 8).
@@ -633,6 +633,54 @@ and all pending search branches are pruned.
 
 @end{itemize} 
 
+@subsection{Contexts, threads, and time slices}
+
+Each function above has a variant with an @tt{_s} suffix that takes
+an explicit context (@tt{ciao_ctx}) as first argument. The variants
+without suffix use the context stored in @tt{ciao_implicit_ctx},
+which is a per-thread variable. A context owns its own worker (stacks
+and registers), while code and atoms are shared by all of them, so
+that a multithreaded application can create one context per thread
+(after a single call to @tt{ciao_init()}) and run queries on each of
+them concurrently:
+
+@begin{itemize} 
+
+@item @tt{ciao_ctx ciao_ctx_new(void);}
+
+  Creates a new context. It must be used by one thread at a time.
+
+@item @tt{void ciao_ctx_free(ciao_ctx ctx);}
+
+  Releases a context which is not running a query.
+
+@item @tt{void ciao_ctx_set_time_slice(ciao_ctx ctx, long usecs);}
+
+  Limits to about @tt{usecs} microseconds (@tt{0} for no limit) each
+  run of the queries of @tt{ctx} started by @tt{ciao_query_begin()},
+  @tt{ciao_query_next()}, or @tt{ciao_query_resume()}. When the time
+  is over the query is suspended at the next predicate call, so that
+  the application can do other work and obtain the answers
+  incrementally. The thread running the query is notified with a
+  @tt{SIGURG} signal (which the application must not block). A
+  handler of @tt{SIGURG} installed by the application before the first
+  time slice is still called for the signals that are not sent by the
+  engine.
+
+@item @tt{ciao_bool ciao_query_suspended(ciao_query *query);}
+
+  Determines whether the query has been suspended (at the end of a
+  time slice or by a call to @tt{internals:'$yield'/0}).
+
+@item @tt{void ciao_query_resume(ciao_query *query);}
+
+  Continues the execution of a suspended query (for another time
+  slice, if any).
+
+@end{itemize} 
+
+Loading code (@tt{ciao_load_qfile()}) is serialized across threads.
+
 @section{Examples}
 
 @subsection{Mathematical functions}
@@ -267,11 +267,48 @@ c_int_list(List) :- list(c_int,List).
 :- regtype c_double_list(List) # "@var{List} is a list of @regtype{c_double/1}.".
 c_double_list(List) :- list(c_double,List).
 
+:- export(c_int8_array/1).
+:- regtype c_int8_array(Array) # "@var{Array} is a numeric array of
+   type @tt{int8} (see @lib{numarray}), passed to C as a @tt{int8_t *}
+   pointer to its data (without copying).".
+c_int8_array('$numarray'(Id, int8, Off, Len)) :- int(Id), int(Off), int(Len).
+
+:- export(c_int16_array/1).
+:- regtype c_int16_array(Array) # "@var{Array} is a numeric array of
+   type @tt{int16} (see @lib{numarray}), passed to C as a @tt{int16_t *}
+   pointer to its data (without copying).".
+c_int16_array('$numarray'(Id, int16, Off, Len)) :- int(Id), int(Off), int(Len).
+
+:- export(c_int32_array/1).
+:- regtype c_int32_array(Array) # "@var{Array} is a numeric array of
+   type @tt{int32} (see @lib{numarray}), passed to C as a @tt{int32_t *}
+   pointer to its data (without copying).".
+c_int32_array('$numarray'(Id, int32, Off, Len)) :- int(Id), int(Off), int(Len).
+
+:- export(c_int64_array/1).
+:- regtype c_int64_array(Array) # "@var{Array} is a numeric array of
+   type @tt{int64} (see @lib{numarray}), passed to C as a @tt{int64_t *}
+   pointer to its data (without copying).".
+c_int64_array('$numarray'(Id, int64, Off, Len)) :- int(Id), int(Off), int(Len).
+
+:- export(c_float_array/1).
+:- regtype c_float_array(Array) # "@var{Array} is a numeric array of
+   type @tt{float32} (see @lib{numarray}), passed to C as a @tt{float *}
+   pointer to its data (without copying).".
+c_float_array('$numarray'(Id, float32, Off, Len)) :- int(Id), int(Off), int(Len).
+
+:- export(c_double_array/1).
+:- regtype c_double_array(Array) # "@var{Array} is a numeric array of
+   type @tt{float64} (see @lib{numarray}), passed to C as a @tt{double *}
+   pointer to its data (without copying).".
+c_double_array('$numarray'(Id, float64, Off, Len)) :- int(Id), int(Off), int(Len).
+
 :- export(size_of/3).
 :- prop size_of(Name,ListVar,SizeVar)
-   # "For predicate @var{Name}, the size of the list argument
-   @var{ListVar}, is given by the argument of type integer
-   @var{SizeVar}.".
+   # "For predicate @var{Name}, the size of the list (or numeric
+   array) argument @var{ListVar}, is given by the argument of type
+   integer @var{SizeVar}. For input numeric arrays, @var{SizeVar}
+   must not exceed the length of the array.".
 size_of(_,_,_).
 
 :- export(do_not_free/2).
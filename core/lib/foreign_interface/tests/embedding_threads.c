@@ -0,0 +1,74 @@
+#include <ciao_prolog.h>
+#include <pthread.h>
+#include <stdlib.h>
+
+typedef struct {
+  int n;
+  long usecs;
+  int suspensions;
+  int ok;
+} count_run_t;
+
+static void *count_run(void *arg) {
+  count_run_t *r = (count_run_t *)arg;
+  ciao_ctx ctx;
+  ciao_query *q;
+  ciao_term v;
+
+  ctx = ciao_ctx_new();
+  ciao_ctx_set_time_slice(ctx, r->usecs);
+  ciao_frame_begin_s(ctx);
+  q = ciao_query_begin_s(ctx, "embedding_threads:count", 1, ciao_mk_c_int_s(ctx, r->n));
+  r->suspensions = 0;
+  while (ciao_query_suspended(q)) {
+    r->suspensions++;
+    ciao_query_resume(q);
+  }
+  r->ok = ciao_query_ok(q);
+  ciao_query_end(q);
+  /* (a query with an answer, checked from this thread) */
+  v = ciao_var_s(ctx);
+  if (r->ok && !(ciao_commit_call_s(ctx, "embedding_threads:count", 1, v) &&
+                 ciao_get_c_int_s(ctx, v) == 1000)) {
+    r->ok = 0;
+  }
+  ciao_frame_end_s(ctx);
+  ciao_ctx_free(ctx);
+  return NULL;
+}
+
+int count_sliced(int n, long usecs) {
+  pthread_t thread;
+  count_run_t r;
+
+  r.n = n;
+  r.usecs = usecs;
+  r.ok = 0;
+  if (pthread_create(&thread, NULL, count_run, &r) != 0) return -1;
+  pthread_join(thread, NULL);
+  return r.ok ? r.suspensions : -1;
+}
+
+int count_threads(int threads, int n) {
+  pthread_t *thread;
+  count_run_t *r;
+  int i, ok;
+
+  thread = (pthread_t *)malloc(threads * sizeof(pthread_t));
+  r = (count_run_t *)malloc(threads * sizeof(count_run_t));
+  for (i = 0; i < threads; i++) {
+    r[i].n = n;
+    r[i].usecs = 1000;
+    r[i].ok = 0;
+    if (pthread_create(&thread[i], NULL, count_run, &r[i]) != 0) break;
+  }
+  threads = i;
+  ok = 0;
+  for (i = 0; i < threads; i++) {
+    pthread_join(thread[i], NULL);
+    if (r[i].ok) ok++;
+  }
+  free(thread);
+  free(r);
+  return ok;
+}
@@ -0,0 +1,38 @@
+:- module(embedding_threads, [count/1], [assertions, foreign_interface]).
+
+:- doc(title, "Queries from C threads (for foreign_interface.test.pl)").
+
+:- doc(module, "The C functions of this module create their own
+   threads, each with its own context, and run queries on them through
+   the C API (@tt{ciao_prolog.h}).").
+
+:- use_foreign_source(embedding_threads).
+:- use_foreign_library(pthread).
+
+:- export(count_sliced/3).
+:- trust pred count_sliced(in(N), in(Usecs), go(Suspensions))
+   :: c_int * c_long * c_int + (foreign, returns(Suspensions))
+   # "Run @pred{count/1} for @var{N} in a new thread and context with
+   a time slice of @var{Usecs} microseconds. @var{Suspensions} is the
+   number of times that the query was suspended, or -1 if it did not
+   succeed.".
+
+:- export(count_threads/3).
+:- trust pred count_threads(in(Threads), in(N), go(Ok))
+   :: c_int * c_int * c_int + (foreign, returns(Ok))
+   # "Run @pred{count/1} for @var{N} in @var{Threads} threads at the
+   same time, each with its own context and a time slice of 1
+   millisecond. @var{Ok} is the number of threads whose query
+   succeeded with the right answer.".
+
+:- pred count(N) # "Count down from @var{N} to 0 (or up, if @var{N}
+   is free: @var{N} is bound to the number of calls).".
+
+count(N) :- integer(N), !, count_(N).
+count(N) :- count_up(0, N).
+
+count_(0) :- !.
+count_(N) :- N1 is N-1, count_(N1).
+
+count_up(N, N) :- N >= 1000, !.
+count_up(N0, N) :- N1 is N0+1, count_up(N1, N).
@@ -46,7 +46,11 @@
     world!"", []).
     ```
     @noindent
-    will result in @tt{Hello world!}.").
+    will result in @tt{Hello world!}.
+
+    Controls are executed by a native formatter when possible. The
+    @lib{format_compile} package additionally compiles the controls
+    that are known at compile time.").
 
 :- doc(format_control/1,"
 The general format of a control sequence is @tt{~@var{N}@var{C}}.
@@ -340,6 +344,8 @@ position movement to @var{N}, where @var{N} defaults to @key{SPC}.
 :- use_module(library(write)).
 :- use_module(library(system)).
 :- use_module(engine(io_basic), ['$format_print_float'/3, '$format_print_integer'/3]).
+:- use_module(engine(internals), ['$format'/3]).
+:- use_module(engine(runtime_control), [current_prolog_flag/2]).
 
 %% FOR TEMPORARILY PARTIALLY DOCUMENTING:
 :- use_module(library(assertions/doc_props)).
@@ -372,7 +378,7 @@ format_control(C) :- atm(C).
 format(Control, _) :-
     var(Control), !,
     throw(error(instantiation_error, format/2-1)).
-format(Control, Arguments) :- format1(Control, Arguments), !.
+format(Control, Arguments) :- format_(Control, Arguments), !.
 format(Control, Arguments) :-
     throw(error(invalid_arguments(format(Control, Arguments)), format/2)).
 
@@ -389,7 +395,7 @@ format(_, Control, _) :-
 format(Stream, Control, Arguments) :-
     current_output(Curr),
     set_output(Stream),
-    (   format1(Control, Arguments) -> OK=yes
+    (   format_(Control, Arguments) -> OK=yes
     ;   OK=no
     ),
     set_output(Curr),
@@ -397,6 +403,13 @@ format(Stream, Control, Arguments) :-
 format(_, Control, Arguments) :-
     throw(error(invalid_arguments(format(..., Control, Arguments)), format/3)).
 
+% Use the native formatter if possible, format1/2 otherwise
+format_(Control, Arguments) :-
+    fmt_compile(Control, Fmt),
+    fmt_native(Fmt, Arguments), !.
+format_(Control, Arguments) :-
+    format1(Control, Arguments).
+
 format1(Control, Arguments) :-
     (   atom(Control) -> atom_codes(Control, ControlList)
     ;   ControlList=Control
@@ -582,6 +595,167 @@ putn_list(N, [C|Chars]) :-
     put_code(Char),
     putn_list(N1, Chars).
 
+% ---------------------------------------------------------------------------
+% Compiled controls (for the native formatter)
+
+:- doc(hide, '$format_compile'/2).
+:- export('$format_compile'/2).
+% '$format_compile'(+Control, -Fmt): Fmt is the compiled form of the
+% control Control, for '$format_compiled'/2,3 (see
+% library(format_compile)). Fails if Control must be interpreted.
+'$format_compile'(Control, Fmt) :-
+    fmt_compile(Control, Fmt).
+
+:- doc(hide, '$format_compiled'/2).
+:- export('$format_compiled'/2).
+% '$format_compiled'(+Fmt, +Arguments): like format/2 for a compiled
+% control
+'$format_compiled'(Fmt, Arguments) :-
+    fmt_native(Fmt, Arguments), !.
+'$format_compiled'(Fmt, Arguments) :-
+    fmt_decompile(Fmt, Control),
+    format(Control, Arguments).
+
+:- doc(hide, '$format_compiled'/3).
+:- export('$format_compiled'/3).
+% '$format_compiled'(+Stream, +Fmt, +Arguments): like format/3 for a
+% compiled control
+'$format_compiled'(Stream, Fmt, Arguments) :-
+    current_output(Curr),
+    set_output(Stream),
+    (   fmt_native(Fmt, Arguments) -> OK=yes
+    ;   OK=no
+    ),
+    set_output(Curr),
+    OK=yes, !.
+'$format_compiled'(Stream, Fmt, Arguments) :-
+    fmt_decompile(Fmt, Control),
+    format(Stream, Control, Arguments).
+
+% fmt_native(+Fmt, +Arguments): print with '$format'/3 (fails without
+% printing anything if format1/2 must be used)
+fmt_native(fmt(Items, Write), Arguments) :-
+    fmt_write_strings(Write, WS),
+    (   '$format'(Items, Arguments, WS) -> true
+    ;   '$format'(Items, [Arguments], WS)
+    ).
+
+% (terms are written natively only if library(write) would do it)
+fmt_write_strings(false, none).
+fmt_write_strings(true, WS) :-
+    (   current_prolog_flag(native_writer, on) ->
+        current_prolog_flag(write_strings, WS)
+    ;   WS = none
+    ).
+
+% fmt_compile(+Control, -Fmt): Fmt=fmt(Items,Write) where Items is the
+% list of directives of Control for '$format'/3 (literal text as atoms,
+% ~C as C and ~NC as d(C,N)) and Write is true if some of them writes
+% terms. Fails if Control contains ~p or unusual forms (which are left
+% to format1/2).
+fmt_compile(Control, fmt(Items, Write)) :-
+    (   atom(Control) -> atom_codes(Control, Cs)
+    ;   ground(Control), Cs = Control
+    ),
+    fmt_items(Cs, Items, false, Write).
+
+fmt_items([], [], W, W) :- !.
+fmt_items([0'\\, 0'c, 0'
+         |Cs], Items, W0, W) :- !,
+    fmt_items(Cs, Items, W0, W).
+fmt_items([0'~, C|Cs], [Item|Items], W0, W) :- C \== 0'~, !,
+    fmt_directive(C, Cs, Cs1, Item, W0, W1),
+    fmt_items(Cs1, Items, W1, W).
+fmt_items(Cs, [A|Items], W0, W) :-
+    fmt_text(Cs, Text, Cs1),
+    Text \== [],
+    atom_codes(A, Text),
+    fmt_items(Cs1, Items, W0, W).
+
+% (literal text up to the next directive or \c)
+fmt_text([0'~, 0'~|Cs], [0'~|Text], Rest) :- !,
+    fmt_text(Cs, Text, Rest).
+fmt_text([0'\\, 0'c, 0'
+        |Cs], [], [0'\\, 0'c, 0'
+                  |Cs]) :- !.
+fmt_text([C|Cs], [C|Text], Rest) :- C \== 0'~, !,
+    integer(C), C > 0, C =< 255,
+    fmt_text(Cs, Text, Rest).
+fmt_text(Cs, [], Cs).
+
+fmt_directive(0'`, [F, 0't|Cs], Cs, d(0't, F), W, W) :- !,
+    integer(F).
+fmt_directive(0'*, [C|Cs], Cs, d(C, *), W0, W) :- !,
+    fmt_char(C, W0, W).
+fmt_directive(D, Cs0, Cs, d(C, N), W0, W) :- D >= 0'0, D =< 0'9, !,
+    fmt_digits(Cs0, D-0'0, N, [C|Cs]),
+    fmt_char(C, W0, W).
+fmt_directive(C, Cs, Cs, C, W0, W) :-
+    fmt_char(C, W0, W).
+
+fmt_digits([D|Cs0], N0, N, Cs) :- D >= 0'0, D =< 0'9, !,
+    N1 is 10*N0+D-0'0,
+    fmt_digits(Cs0, N1, N, Cs).
+fmt_digits(Cs, N0, N, Cs) :- N is N0.
+
+% (directives that '$format'/3 knows, and whether they write terms)
+fmt_char(C, W0, W) :-
+    fmt_char_(C, W1),
+    (   W1 = true -> W = true ; W = W0 ).
+
+fmt_char_(0'~, false).
+fmt_char_(0'n, false).
+fmt_char_(0'N, false).
+fmt_char_(0'|, false).
+fmt_char_(0'+, false).
+fmt_char_(0't, false).
+fmt_char_(0'i, false).
+fmt_char_(0'a, false).
+fmt_char_(0'c, false).
+fmt_char_(0'e, false).
+fmt_char_(0'E, false).
+fmt_char_(0'f, false).
+fmt_char_(0'g, false).
+fmt_char_(0'G, false).
+fmt_char_(0'd, false).
+fmt_char_(0'D, false).
+fmt_char_(0'r, false).
+fmt_char_(0'R, false).
+fmt_char_(0's, false).
+fmt_char_(0'k, true).
+fmt_char_(0'q, true).
+fmt_char_(0'w, true).
+
+% fmt_decompile(+Fmt, -Control): a control that fmt_compile/2
+% compiles to Fmt (for format1/2)
+fmt_decompile(fmt(Items, _), Control) :-
+    fmt_decompile_(Items, Control, []).
+
+fmt_decompile_([]) --> [].
+fmt_decompile_([A|Items]) --> { atom(A) }, !,
+    { atom_codes(A, Text) },
+    fmt_escape(Text),
+    (   { Items = [B|_], atom(B) } -> "\\c\n" % (texts split by \c)
+    ;   []
+    ),
+    fmt_decompile_(Items).
+fmt_decompile_([d(C, N)|Items]) --> !,
+    "~", fmt_number(N), [C],
+    fmt_decompile_(Items).
+fmt_decompile_([C|Items]) -->
+    "~", [C],
+    fmt_decompile_(Items).
+
+fmt_escape([]) --> [].
+fmt_escape([0'~|Cs]) --> !, "~~", fmt_escape(Cs).
+fmt_escape([C|Cs]) --> [C], fmt_escape(Cs).
+
+fmt_number(*) --> !, "*".
+fmt_number(N) --> { number_codes(N, Cs) }, fmt_codes(Cs).
+
+fmt_codes([]) --> [].
+fmt_codes([C|Cs]) --> [C], fmt_codes(Cs).
+
 % ===========================================================================
 
 % :- trust comp format_to_string(S,C,A) + native(format_to_string(S,C,A)).
@@ -0,0 +1,85 @@
+:- module(_, [], [assertions, format_compile]).
+
+:- doc(title, "Tests for format.pl").
+
+:- doc(module, "Checks the output of the native formatter, for controls
+   compiled by the @lib{format_compile} package and for controls only
+   known at run time.").
+
+:- use_module(library(format)).
+:- use_module(engine(stream_basic)).
+:- use_module(engine(hiord_rt), [call/1]).
+:- use_module(engine(runtime_control), [set_prolog_flag/2]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1]).
+:- use_module(library(stream_utils), [file_to_string/2]).
+
+% sample(Id, Control, Arguments, Output)
+sample(1, "~a~t~20|~d~t~10+~2f~n", [name, 42, 1.5],
+       "name                42        1.50\n").
+sample(2, "~w ~q ~k~n", [f('A',"ab"), 'it''s', [a|b]],
+       "f(A,[97,98]) 'it''s' '.'(a,b)\n").
+sample(3, "~e ~3d ~D ~16r ~8|~s~c~n", [2.5, 12345, 1234567, 255, "ab", 0'x],
+       "2.500000e+00 12.345 1,234,567 ff \n        abx\n").
+sample(4, "~`-t~30|~n", [],
+       "------------------------------\n").
+sample(5, "~p and ~i~w", [p, skipped, w],
+       "p and w").
+sample(6, "~w", hello,
+       "hello").
+sample(7, "a~~b\\c
+~a", [c],
+       "a~bc").
+sample(8, "~t~w~10|~w~n", [right, x],
+       "right     x\n").
+
+% (the same calls, with constant controls)
+compiled(1) :- format("~a~t~20|~d~t~10+~2f~n", [name, 42, 1.5]).
+compiled(2) :- format("~w ~q ~k~n", [f('A',"ab"), 'it''s', [a|b]]).
+compiled(3) :- format("~e ~3d ~D ~16r ~8|~s~c~n", [2.5, 12345, 1234567, 255, "ab", 0'x]).
+compiled(4) :- format("~`-t~30|~n", []).
+compiled(5) :- format("~p and ~i~w", [p, skipped, w]).
+compiled(6) :- format("~w", hello).
+compiled(7) :- format("a~~b\\c
+~a", [c]).
+compiled(8) :- format("~t~w~10|~w~n", [right, x]).
+
+% Text written by Goal
+output_of(Goal, Text) :-
+    mktemp_in_tmp('formatXXXXXX', File),
+    open(File, write, S),
+    current_output(Old),
+    set_output(S),
+    call(Goal),
+    set_output(Old),
+    close(S),
+    file_to_string(File, Text),
+    delete_file(File).
+
+:- export(runtime_controls/0).
+:- test runtime_controls # "Controls known at run time".
+
+runtime_controls :-
+    \+ ( sample(_, Control, Args, Text),
+         \+ output_of(format(Control, Args), Text) ),
+    set_prolog_flag(native_writer, off),
+    ( sample(2, Control2, Args2, Text2),
+      output_of(format(Control2, Args2), Text2) -> Ok = yes
+    ; Ok = no
+    ),
+    set_prolog_flag(native_writer, on),
+    Ok = yes.
+
+:- export(compiled_controls/0).
+:- test compiled_controls # "Controls compiled by format_compile".
+
+compiled_controls :-
+    \+ ( sample(Id, _, _, Text),
+         \+ output_of(compiled(Id), Text) ).
+
+:- export(compiled_errors/0).
+:- test compiled_errors
+   + exception(error(invalid_arguments(_), format/2))
+   # "Errors of compiled controls".
+
+compiled_errors :-
+    format("~a", [1]).
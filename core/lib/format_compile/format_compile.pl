@@ -0,0 +1,6 @@
+:- package(format_compile).
+
+% Precompile constant controls of format/2,3 (see format_compile_doc.pl)
+
+:- load_compilation_module(library(format_compile/format_compile_tr)).
+:- add_clause_trans(format_compile_tr:clause_tr/3, 108800). % (after_mexp phase)
@@ -0,0 +1,29 @@
+:- use_package(assertions).
+:- doc(nodoc,assertions).
+:- doc(nodoc,assertions_basic).
+
+:- doc(title,"Precompiled format controls").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module,"This package precompiles the controls of
+   @pred{format/2} and @pred{format/3} (see @lib{format}) that are
+   known at compile time. A call such as
+
+@begin{verbatim}
+    format(S, ""~a: ~d items~n"", [Name, N])
+@end{verbatim}
+
+@noindent
+   is translated into a call that receives the list of directives
+   (the literal text and the @tt{~a}, @tt{~d} and @tt{~n} directives)
+   instead of the control string, which is then executed by a native
+   formatter that writes directly into the output buffer of the
+   stream.
+
+   Only calls to the predicates of @lib{format} whose control is a
+   ground atom or string are translated. Controls with @tt{~p} (which
+   may call @pred{portray/1}) and unusual forms of the directives are
+   left untouched, and calls whose arguments the native formatter
+   does not accept fall back to the Prolog implementation, so that
+   the output and errors are the same as without the package.").
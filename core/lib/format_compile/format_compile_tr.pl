@@ -0,0 +1,36 @@
+:- module(format_compile_tr, [clause_tr/3], []).
+
+% Translation module for the format_compile package. It runs after
+% module expansion, so that only calls to library(format) are
+% rewritten: goals format(C,A) and format(S,C,A) where C is a ground
+% atom or string are replaced by calls to '$format_compiled'/2,3 with
+% the directive list of C, as computed by '$format_compile'/2.
+
+:- use_module(library(format), ['$format_compile'/2]).
+
+clause_tr(clause(H, B), clause(H, B1), _M) :-
+    body_tr(B, B1).
+
+body_tr(G, G) :- var(G), !.
+body_tr('basiccontrol:,'(A, B), 'basiccontrol:,'(A1, B1)) :- !,
+    body_tr(A, A1),
+    body_tr(B, B1).
+body_tr('basiccontrol:;'(A, B), 'basiccontrol:;'(A1, B1)) :- !,
+    body_tr(A, A1),
+    body_tr(B, B1).
+body_tr('basiccontrol:->'(A, B), 'basiccontrol:->'(A1, B1)) :- !,
+    body_tr(A, A1),
+    body_tr(B, B1).
+body_tr('basiccontrol:\\+'(A), 'basiccontrol:\\+'(A1)) :- !,
+    body_tr(A, A1).
+body_tr('basiccontrol:if'(A, B, C), 'basiccontrol:if'(A1, B1, C1)) :- !,
+    body_tr(A, A1),
+    body_tr(B, B1),
+    body_tr(C, C1).
+body_tr('format:format'(C, As), G) :-
+    '$format_compile'(C, Fmt), !,
+    G = 'format:$format_compiled'(Fmt, As).
+body_tr('format:format'(S, C, As), G) :-
+    '$format_compile'(C, Fmt), !,
+    G = 'format:$format_compiled'(S, Fmt, As).
+body_tr(G, G).
@@ -5,6 +5,8 @@
     standard_ops/0],
     [assertions,isomodes,datafacts]).
 
+:- use_module(engine(internals), ['$op_update'/5]).
+
 :- doc(title, "Defining operators").
 
 :- doc(author, "Daniel Cabeza (modifications and documentation,"||
@@ -80,6 +82,7 @@ do_ops([X|Xs], Left, Prec, Right, Type) :-
       fail
     ; true
     ),
+    '$op_update'(X, Type, Left, Prec, Right), % (for the native writer)
     do_ops(Xs, Left, Prec, Right, Type).
 
 :- doc(current_op(Precedence,Type,Op), "The atom @var{Op} is
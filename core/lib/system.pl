@@ -801,6 +801,19 @@ dev_null('/dev/null').
 :- impl_defined(wait/2).
 :- endif.
 
+:- export(wait_any/2).
+:- trust pred wait_any(-Pid, -RetCode) : (var(Pid),var(RetCode)) => (int(Pid),int(RetCode))
+   # "Waits for any child process to terminate. @var{Pid} is its
+      process number and @var{RetCode} its return code (as in
+      @pred{wait/2}). Fails if there are no child processes (or they
+      did not terminate normally).".
+
+:- if(defined(optim_comp)).
+:- '$props'(wait_any/2, [impnat=cbool(prolog_wait_any)]).
+:- else.
+:- impl_defined(wait_any/2).
+:- endif.
+
 % (see internals:$exec/9' for low-level process creation or
 % library(process) for a higher-level interface)
 
@@ -61,6 +61,7 @@
 
 define_flag(character_escapes, [iso, sicstus, off], iso).
 define_flag(doccomments, [on, off], off).
+define_flag(native_tokenizer, [on, off], on).
 
 % Existing tokens:
 %    atom(atom)
@@ -98,6 +99,11 @@ token('.').
 :- pred read_tokens(TokenList, Dictionary) 
     => (list(token,TokenList), dictionary(Dictionary)).
 
+read_tokens(TokenList, Dictionary) :-
+    native_tokenizer(CEF), !,
+    second_prompt(SP, SP),
+    '$read_tokens'(CEF, SP, TokenList, Vars),
+    enter_vars(Vars, Dictionary).
 read_tokens(TokenList, Dictionary) :-
     getct1(Ch, Type),
     second_prompt(SP, SP),
@@ -105,6 +111,28 @@ read_tokens(TokenList, Dictionary) :-
     read_tokens(Type, Ch, Dictionary, TokenList),
     '$prompt'(_, Old).
 
+% The native tokenizer ('$read_tokens'/4) produces the same tokens.
+% It does not support doccomments nor curly blocks.
+native_tokenizer(CEF) :-
+    current_prolog_flag(native_tokenizer, on),
+    current_prolog_flag(doccomments, off),
+    current_prolog_flag(read_curly_blocks, off),
+    current_prolog_flag(character_escapes, CEF0),
+    cef_code(CEF0, CEF).
+
+cef_code(off, 0).
+cef_code(iso, 1).
+cef_code(sicstus, 2).
+
+% Enter the variables returned by '$read_tokens'/4 (in order of first
+% occurrence) as read_tokens/4 does.
+enter_vars([], _).
+enter_vars([v(S, Var, N)|Vs], Dict) :-
+    dic_lookup(Dict, S, Node),
+    check_singleton(Node, Var),
+    ( N > 1 -> check_singleton(Node, Var) ; true ),
+    enter_vars(Vs, Dict).
+
 % The only difference between read_tokens_after_layout(Typ, Ch, D, Tokens)
 % and read_tokens/4 is what they do when Ch is "(".  The former finds the
 % token to be ' (', while the later finds the token to be '('.  This is
@@ -0,0 +1,119 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for tokenize.pl").
+
+:- doc(module, "Checks that the native tokenizer (@tt{native_tokenizer}
+   flag) produces the same tokens, variable dictionaries and consumed
+   characters as the tokenizer written in Prolog.").
+
+:- use_module(library(tokenize), [read_tokens/2]).
+:- use_module(engine(stream_basic)).
+:- use_module(engine(io_basic)).
+:- use_module(engine(runtime_control), [set_prolog_flag/2, current_prolog_flag/2]).
+:- use_module(library(format), [format/3]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1, file_exists/1]).
+:- use_module(library(terms_check), [variant/2]).
+
+sample("f(X, _Y, X, _, 'it''s', \"s\\x41\\\", 0'a, 0' , 0''', 0x1F, 2'101).\n").
+sample("a (b) - g( ) + h() /* comment */ % comment\n  .\n").
+sample("1.5e10 0.Nan 1.0Inf 12.x 3e 0b101 0o17 0'\\n 0'\\\\ 123456789012345678901234567890.\n").
+sample("'\\a\\b\\t\\v\\f\\r\\e\\d\\s\\z' \"\\101\\ \\\n\" `bq` {x, y} [H|T] ! ; , | .\n").
+sample("'Ünïcödé' é+ ''\n'unterminated\n").
+sample("X = f(A,\n B, C) . p :- q.").
+
+tokens_all(Flag, Text, Results) :-
+    mktemp_in_tmp('tokenizeXXXXXX', File),
+    open(File, write, Out),
+    format(Out, "~s", [Text]),
+    close(Out),
+    set_prolog_flag(native_tokenizer, Flag),
+    open(File, read, In),
+    current_input(Old),
+    set_input(In),
+    read_all(In, Results),
+    set_input(Old),
+    close(In),
+    set_prolog_flag(native_tokenizer, on),
+    delete_file(File).
+
+read_all(In, Results) :-
+    catch(read_tokens(Tokens, Dict), E, (Tokens = error(E), Dict = [])),
+    character_count(In, C),
+    ( Tokens = [atom(end_of_file)|_] ->
+        Results = []
+    ; Tokens = error(_) ->
+        Results = [C-Tokens-Dict]
+    ; Results = [C-Tokens-Dict|Results0],
+      read_all(In, Results0)
+    ).
+
+:- export(native_tokens/0).
+:- test native_tokens # "Native and Prolog tokenizers agree".
+
+native_tokens :-
+    \+ ( sample(Text),
+         tokens_all(on, Text, R1),
+         tokens_all(off, Text, R2),
+         \+ variant(R1, R2) ).
+
+:- export(escapes/0).
+:- test escapes # "Both tokenizers agree with any character_escapes".
+
+escapes :-
+    current_prolog_flag(character_escapes, Old),
+    ( member_(CEF, [iso, sicstus, off]),
+      set_prolog_flag(character_escapes, CEF),
+      sample(Text),
+      tokens_all(on, Text, R1),
+      tokens_all(off, Text, R2),
+      \+ variant(R1, R2) ->
+        Ok = no
+    ; Ok = yes
+    ),
+    set_prolog_flag(character_escapes, Old),
+    Ok = yes.
+
+:- export(past_eof/0).
+:- test past_eof # "Reading past the end raises the same error".
+
+past_eof :-
+    past_eof_error(on, E1),
+    past_eof_error(off, E2),
+    nonvar(E1),
+    variant(E1, E2).
+
+past_eof_error(Flag, E) :-
+    mktemp_in_tmp('tokenizeXXXXXX', File),
+    open(File, write, Out),
+    format(Out, "a.", []),
+    close(Out),
+    set_prolog_flag(native_tokenizer, Flag),
+    open(File, read, In),
+    current_input(Old),
+    set_input(In),
+    catch((read_tokens(_, _), read_tokens(_, _), read_tokens(_, _)), E, true),
+    set_input(Old),
+    close(In),
+    set_prolog_flag(native_tokenizer, on),
+    delete_file(File).
+
+:- export(io_error/0).
+:- test io_error # "I/O errors while reading are raised (and can be
+   caught)".
+
+io_error :-
+    % (reading from address 0 fails with EIO in Linux)
+    ( file_exists('/proc/self/mem') ->
+        open('/proc/self/mem', read, In),
+        current_input(Old),
+        set_input(In),
+        catch((read_tokens(_, _), fail), error(resource_error(_), _), true),
+        set_input(Old),
+        close(In)
+    ; true
+    ),
+    tokens_all(on, "p(X).", [_-Tokens-_|_]),
+    Tokens = [atom(p), '(', var(_, "X"), ')', '.'].
+
+member_(X, [X|_]).
+member_(X, [_|Xs]) :- member_(X, Xs).
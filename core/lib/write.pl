@@ -12,7 +12,7 @@
 
 :- use_module(library(operators)).
 :- use_module(library(sort)).
-:- use_module(engine(internals), ['$atom_mode'/2]).
+:- use_module(engine(internals), ['$atom_mode'/2, '$write_term'/4]).
 :- use_module(engine(stream_basic)).
 :- use_module(engine(io_basic)).
 :- use_module(engine(runtime_control), [current_prolog_flag/2]).
@@ -40,9 +40,13 @@
     @includedef{define_flag/3}
     (See @ref{Runtime system control and flags}).
 
-    If flag is @tt{on}, lists which may be written as strings are.").
+    If @tt{write_strings} is @tt{on}, lists which may be written as
+    strings are. If @tt{native_writer} is @tt{on}, terms are written
+    by a native (C) version of this library, except when portray hooks
+    are enabled.").
 
 define_flag(write_strings, [on,off], off).
+define_flag(native_writer, [on,off], on).
 
 writeq_quick(Term) :- var(Term), displayq(Term).
 writeq_quick(Term) :- atomic(Term), displayq(Term).
@@ -74,8 +78,17 @@ write_term(Term, OptList) :-
     write_term_internal(Term, OptList, 2).
 
 write_term_internal(Term, OptList, N) :-
-    Default = options(false,false,false,false,1000000),
+    Default = options(false,false,false,false,1000000,[]),
     compute_options(OptList, N, Default, 1200, Options, Priority),
+    write_top(Term, Options, Priority).
+
+% Write the term using the native writer when possible
+write_top(Term, Options, Priority) :-
+    Options = options(_,_,_,false,_,_),
+    current_prolog_flag(native_writer, on),
+    current_prolog_flag(write_strings, WS),
+    '$write_term'(Term, Options, Priority, WS), !.
+write_top(Term, Options, Priority) :-
     write_out(Term, Options, Priority, 0, 0, '(', 2'100, _).
 
 
@@ -127,6 +140,11 @@ write_term_internal(Term, OptList, N) :-
  If the term to be printed has higher priority than @em{prio}, it will be
  printed parenthesized.  Default value is 1200 (no term parenthesized).
 
+ @item @bf{variable_names(}@em{names}@bf{):} @em{names} is a list of
+ elements of the form @tt{Name=Var}, where @tt{Name} is an atom. Each
+ free variable @tt{Var} is written as the first @tt{Name} associated
+ with it (without quotes). Default value is @tt{[]}.
+
 @end{itemize}").
 
 write_option(quoted(Qt)) :- boolean(Qt).
@@ -135,6 +153,7 @@ write_option(numbervars(NV)) :- boolean(NV).
 write_option(portrayed(Pr)) :- boolean(Pr).
 write_option(max_depth(MD)) :- integer(MD), MD >= 0.
 write_option(priority(Prio)) :- integer(Prio), Prio >= 1, Prio =< 1200.
+write_option(variable_names(VN)) :- variable_names(VN).
 
 compute_options(V, N, _, _, _, _) :- var(V), !,
     throw(error(instantiation_error, write_term/N-N)).
@@ -147,20 +166,23 @@ compute_options(Opts, N, _, _, _, _) :-
 
 one_opt(V, N, _, _, _, _) :- var(V), !,
     throw(error(instantiation_error, write_term/N-N)).
-one_opt(quoted(Qt),     _, options(_ ,IO,NV,Pr,Li), Prio,
-                       options(Qt,IO,NV,Pr,Li), Prio) :- boolean(Qt), !.
-one_opt(ignore_ops(IO), _, options(Qt,_ ,NV,Pr,Li), Prio,
-                       options(Qt,IO,NV,Pr,Li), Prio) :- ignore_ops_flag(IO), !.
-one_opt(numbervars(NV), _, options(Qt,IO,_, Pr,Li), Prio,
-                       options(Qt,IO,NV,Pr,Li), Prio) :- boolean(NV), !.
-one_opt(portrayed(Pr),  _, options(Qt,IO,NV,_, Li), Prio,
-                       options(Qt,IO,NV,Pr,Li), Prio) :- boolean(Pr), !.
-one_opt(max_depth(MD),  _, options(Qt,IO,NV,Pr,_ ), Prio,
-                       options(Qt,IO,NV,Pr,Li), Prio) :-
+one_opt(quoted(Qt),     _, options(_ ,IO,NV,Pr,Li,VN), Prio,
+                       options(Qt,IO,NV,Pr,Li,VN), Prio) :- boolean(Qt), !.
+one_opt(ignore_ops(IO), _, options(Qt,_ ,NV,Pr,Li,VN), Prio,
+                       options(Qt,IO,NV,Pr,Li,VN), Prio) :- ignore_ops_flag(IO), !.
+one_opt(numbervars(NV), _, options(Qt,IO,_, Pr,Li,VN), Prio,
+                       options(Qt,IO,NV,Pr,Li,VN), Prio) :- boolean(NV), !.
+one_opt(portrayed(Pr),  _, options(Qt,IO,NV,_, Li,VN), Prio,
+                       options(Qt,IO,NV,Pr,Li,VN), Prio) :- boolean(Pr), !.
+one_opt(max_depth(MD),  _, options(Qt,IO,NV,Pr,_, VN), Prio,
+                       options(Qt,IO,NV,Pr,Li,VN), Prio) :-
                        integer(MD), MD >= 0, !,
                        (MD = 0 -> Li = 1000000; Li = MD).
 one_opt(priority(Prio), _, Opts, _, Opts, Prio) :-
     integer(Prio), Prio >= 1, Prio =< 1200, !.
+one_opt(variable_names(VN), _, options(Qt,IO,NV,Pr,Li,_ ), Prio,
+                       options(Qt,IO,NV,Pr,Li,VN), Prio) :-
+                       variable_names(VN), !.
 one_opt(Opt, N, _, _, _, _) :-
     throw(error(domain_error(write_option, Opt), write_term/N-N)).
 
@@ -178,6 +200,16 @@ ignore_ops_flag(true).
 ignore_ops_flag(ops).
 ignore_ops_flag(false).
 
+:- prop variable_names(VN)
+    # "@var{VN} is a list of elements of the form @tt{Name=Var},
+      where @tt{Name} is an atom.".
+
+variable_names(VN) :- var(VN), !, fail.
+variable_names([]).
+variable_names([Name=_|VN]) :-
+    atom(Name),
+    variable_names(VN).
+
 
 :- pred write_canonical(@Stream, ?Term) : stream * term + iso
        # "Behaves like @tt{write_term(Stream, Term, [quoted(true),
@@ -200,8 +232,8 @@ write_canonical(Stream, Term) :-
 write_canonical(Term) :-
     writeq_quick(Term), !.
 write_canonical(Term) :-
-    Options = options(true,true,false,false,1000000),
-    write_out(Term, Options, 1200, 0, 0, '(', 2'100, _).
+    Options = options(true,true,false,false,1000000,[]),
+    write_top(Term, Options, 1200).
 
 :- pred print(@Stream, ?Term): stream * term
     # "Behaves like @tt{write_term(Stream, Term,
@@ -218,8 +250,8 @@ print(Stream, Term) :-
     # "Behaves like @tt{current_output(S), print(S,Term)}.".
 
 print(Term) :-
-    Options = options(false,false,true,true,1000000),
-    write_out(Term, Options, 1200, 0, 0, '(', 2'100, _).
+    Options = options(false,false,true,true,1000000,[]),
+    write_top(Term, Options, 1200).
 
 :- pred printq(@Stream, ?Term): stream * term
     # "Behaves like @tt{write_term(Stream, Term,
@@ -236,8 +268,8 @@ printq(Stream, Term) :-
     # "Behaves like @tt{current_output(S), printq(S,Term)}.".
 
 printq(Term) :-
-    Options = options(true,false,true,true,1000000),
-    write_out(Term, Options, 1200, 0, 0, '(', 2'100, _).
+    Options = options(true,false,true,true,1000000,[]),
+    write_top(Term, Options, 1200).
 
 :- trust pred write(@Stream, ?Term): stream * term + (iso, is_det)
     # "Behaves like @tt{write_term(Stream, Term, [numbervars(true)])}.".
@@ -255,8 +287,8 @@ write(Stream, Term) :-
 write(Term) :-
     write_quick(Term), !.
 write(Term) :-
-    Options = options(false,false,true,false,1000000),
-    write_out(Term, Options, 1200, 0, 0, '(', 2'100, _).
+    Options = options(false,false,true,false,1000000,[]),
+    write_top(Term, Options, 1200).
 
 :- trust pred writeq(@Stream, ?Term): stream * term + (iso, is_det)
     # "Behaves like @tt{write_term(Stream, Term, [quoted(true),
@@ -275,8 +307,8 @@ writeq(Stream, Term) :-
 writeq(Term) :-
     writeq_quick(Term), !.
 writeq(Term) :-
-    Options = options(true,false,true,false,1000000),
-    write_out(Term, Options, 1200, 0, 0, '(', 2'100, _).
+    Options = options(true,false,true,false,1000000,[]),
+    write_top(Term, Options, 1200).
 
 %   writes a parenthesis if the context demands it.
 %   Context = 2'000 for alpha
@@ -357,26 +389,31 @@ variable like an unbound variable, e.g. @tt{_673}.".
 %
 write_out(Term, Options,  _, _, _, _, _, 2'000) :-
     get_attribute(Term,M),
-    Options = options(_,_,_,true,_),
+    Options = options(_,_,_,true,_,_),
     ( \+ portray_attribute(M,Term) ->
           fail               % portray_attribute might bind variables
     ; true
     ),
     !.
-write_out(Term, _, _, _, _, _, Ci, 2'000) :-
+write_out(Term, Options, _, _, _, _, Ci, Co) :-
     var(Term), !,
-    maybe_space(Ci, 2'000),
-    displayq(Term).
+    Options = options(_,_,_,_,_,VN),
+    ( var_name(VN, Term, Name) ->
+        write_atom(false, Name, Ci, Co)
+    ; Co = 2'000,
+      maybe_space(Ci, 2'000),
+      displayq(Term)
+    ).
 write_out(_, Options, _, _, Depth, _, Ci, 2'010) :-
-    Options = options(_,_,_,_,Limit),
+    Options = options(_,_,_,_,Limit,_),
     Depth >= Limit, !,
     maybe_space(Ci, 2'010),
     display(...).
 write_out('$VAR'(N), Options, _, _, _, _, Ci, Co) :-
-    Options = options(_,_,true,_,_),
+    Options = options(_,_,true,_,_,_),
     write_VAR(N, Ci, Co), !.
 write_out(Term, Options, _, _, _, _, _, 2'000) :-
-    Options = options(_,_,_,true,_),
+    Options = options(_,_,_,true,_,_),
     (   \+ portray(Term) ->
         fail                 % portray might bind variables
     ;   true
@@ -386,12 +423,12 @@ write_out(Atom, Options, _, PrePrio, _, Lpar, _, 2'100) :-
     current_prefixop(Atom, P, _),
     P =< PrePrio, !,
     display(Lpar),
-    Options = options(Quote,_,_,_,_),
+    Options = options(Quote,_,_,_,_,_),
     write_atom(Quote, Atom, 2'100, _),
     put_code(0')).
 write_out(Atom, Options, _, _, _, _, Ci, Co) :-
     atom(Atom), !,
-    Options = options(Quote,_,_,_,_),
+    Options = options(Quote,_,_,_,_,_),
     write_atom(Quote, Atom, Ci, Co).
 write_out(N, _, _, _, _, _, Ci, 2'000) :-
     number(N), !,
@@ -403,7 +440,7 @@ write_out(N, _, _, _, _, _, Ci, 2'000) :-
     ),
     displayq(N).
 write_out(Term, Options, _, _, Depth, _, Ci, 2'100) :-
-    Options = options(Quote,true,_,_,_), % Ignore lists and operators
+    Options = options(Quote,true,_,_,_,_), % Ignore lists and operators
     functor(Term, Atom, Arity), !,
     write_atom(Quote, Atom, Ci, _),
     Depth1 is Depth+1,
@@ -427,7 +464,7 @@ write_out([Head|Tail], Options, _, _, Depth, _, _, 2'100) :- !,
     write_out(Head, Options, 999, 0, Depth1, '(', 2'100, _),
     write_tail(Tail, Options, Depth1).
 write_out(Term, Options, _, _, Depth, _, Ci, 2'100) :-
-    Options = options(Quote,ops,_,_,_), % Ignore operators
+    Options = options(Quote,ops,_,_,_,_), % Ignore operators
     functor(Term, Atom, Arity), !,
     write_atom(Quote, Atom, Ci, _),
     Depth1 is Depth+1,
@@ -443,7 +480,7 @@ write_out((A,B), Options, Prio, _, Depth, Lpar, Ci, Co) :- !,
 write_out(Term, Options, Prio, PrePrio, Depth, Lpar, Ci, Co) :-
     functor(Term, F, N),
     Depth1 is Depth+1,
-    Options = options(Quote,_,_,_,_),
+    Options = options(Quote,_,_,_,_,_),
     write_out_(N, F, Term, Quote, Options, Prio, PrePrio, Depth1, Lpar, Ci, Co).
 
 write_out_(1, F, Term, Quote, Options, Prio, _, Depth, Lpar, Ci, Co) :-
@@ -505,6 +542,17 @@ write_VAR(String, Ci, Co) :-
     maybe_space(Ci, Co),
     display(Atom).
 
+var_name([Name=V|_], Var, Name) :- V == Var, !.
+var_name([_|VN], Var, Name) :- var_name(VN, Var, Name).
+
+% (no spacing)
+write_var(Var, Options) :-
+    Options = options(_,_,_,_,_,VN),
+    ( var_name(VN, Var, Name) ->
+        display(Name)
+    ; displayq(Var)
+    ).
+
 write_atom(false, Atom, Ci, Co) :-
     '$atom_mode'(Atom, Co),
     maybe_space(Ci, Co),
@@ -520,7 +568,7 @@ write_atom(true, Atom, Ci, Co) :-
 %   all told in SynStyle, LexStyle, given that DoneSoFar have already been written.
 
 write_args(0, _, _, Options, Depth) :-
-    Options = options(_,_,_,_,Limit),
+    Options = options(_,_,_,_,Limit,_),
     Depth >= Limit, !,
     put_code(0'(), display(...),    put_code(0')).
 write_args(N, N, _, _, _) :- !,
@@ -540,15 +588,15 @@ write_sep(_) :- put_code(0',).
 %   write_tail(Tail, Options, Depth)
 %   writes the tail of a list given Options, Depth.
 
-write_tail(Var, _, _) :-                        %  |var]
+write_tail(Var, Options, _) :-                  %  |var]
     var(Var), !,
     put_code(0'|),
-    displayq(Var),
+    write_var(Var, Options),
     put_code(0']).
 write_tail([], _, _) :- !,                      %  ]
     put_code(0']).
 write_tail(_, Options, Depth) :-
-    Options = options(_,_,_,_,Limit),
+    Options = options(_,_,_,_,Limit,_),
     Depth >= Limit, !,
     put_code(0'|),
     display(...),
@@ -563,16 +611,16 @@ write_tail(Other, Options, Depth) :-    %  |junk]
     write_out(Other, Options, 999, 0, Depth, '(', 2'100, _),
     put_code(0']).
 
-write_string_tail(Var, _, _, 2'000) :-
+write_string_tail(Var, Options, _, 2'000) :-
     var(Var), !,
     put_code(0'"),
     put_code(0'|),
     put_code(0'|),
-    displayq(Var).
+    write_var(Var, Options).
 write_string_tail([], _, _, 2'100) :- !,
     put_code(0'").
 write_string_tail(_, Options, Depth, 2'010) :-
-    Options = options(_,_,_,_,Limit),
+    Options = options(_,_,_,_,Limit,_),
     Depth >= Limit, !,
     put_code(0'"),  % end string with '"'
     put_code(0'|),
@@ -720,17 +768,17 @@ portray_clause1(:-(Command)) :-
     'list clauses'(Body, :-(Key), 4, Co),
     write_fullstop(Co).
 portray_clause1((Pred:-Body)) :- !,
-    write_out(Pred, options(true,false,true,false,1000000), 1199, 1200, -1, '(', 2'100, Ci), % writeq
+    write_out(Pred, options(true,false,true,false,1000000,[]), 1199, 1200, -1, '(', 2'100, Ci), % writeq
     (   Body=true -> write_fullstop(Ci)
     ;   'list clauses'(Body, 0, 4, Co),
         write_fullstop(Co)
     ).
 portray_clause1('-->'(Pred, Body)) :- !,
-    write_out(Pred, options(true,false,true,false,1000000), 1199, 1200, -1, '(', 2'100, _), % writeq
+    write_out(Pred, options(true,false,true,false,1000000,[]), 1199, 1200, -1, '(', 2'100, _), % writeq
     'list clauses'(Body, 2, 4, Co),
     write_fullstop(Co).
 portray_clause1(Pred) :-
-    write_out(Pred, options(true,false,true,false,1000000), 1200, 0, -1, '(', 2'100, Ci), % writeq
+    write_out(Pred, options(true,false,true,false,1000000,[]), 1200, 0, -1, '(', 2'100, Ci), % writeq
     write_fullstop(Ci).
 
 write_fullstop(Ci) :-
@@ -761,7 +809,7 @@ write_fullstop(Ci) :-
     display(' --> !').
 'list clauses'(Goal, L, D, Co) :-
     'list magic'(L, D),
-    write_out(Goal, options(true,false,true,false,1000000), 999, 0, -1, '(', 2'100, Co). % writeq
+    write_out(Goal, options(true,false,true,false,1000000,[]), 999, 0, -1, '(', 2'100, Co). % writeq
 
 
 'list magic'(0, D) :-
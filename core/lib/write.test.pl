@@ -0,0 +1,110 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for write.pl").
+
+:- doc(module, "Checks that the native writer (@tt{native_writer}
+   flag) produces exactly the same text as the writer written in
+   Prolog.").
+
+:- use_module(library(write)).
+:- use_module(library(operators), [op/3]).
+:- use_module(engine(stream_basic)).
+:- use_module(engine(io_basic)).
+:- use_module(engine(hiord_rt), [call/1]).
+:- use_module(engine(runtime_control), [set_prolog_flag/2]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1]).
+:- use_module(library(stream_utils), [file_to_string/2]).
+
+sample(f(_X, - 1, -(1), -(-(1)), 1-2, a- -1, -(a), \+a, -(-a), [a|b],
+         'A'-"abc", {x}, '$VAR'(27), '$VAR'('Foo'), '$VAR'("Bar"),
+         '$VAR'(-1), '$VAR'(x))).
+sample(g(-(0.0), 1.5e300, -1.5e-300, 123456789012345678901234567890,
+         a-(-123456789012345678901234567890), 0.Nan, -(0.Inf))).
+sample(h((a:-b,c;d->e), f((a,b)), (-)-(-), [-], -(2)^2, 1 rem 2, f(;),
+         ';'(a), '|'(a,b), 'hello world', [], '[]', {}, '{}'(a,b), "abc",
+         [0'a,0'"|"b\\"], [1,2|"ab"], ("a"||_))).
+sample(i((p:-q), (:- a), - - a, \ \ a, 1-(2-3), (1-2)-3, 2**(3**4),
+         (2**3)**4, f(a=b,(:-)), [(a:-b)], 'it''s', '\n', f(','),
+         ','(a), - (-), +(-(1)), -(1)+2, a*(b+c), \+ (a,b), (dynamic),
+         a:(b:c), (a=b)=c, '$VAR'(1,2), [](a), 'X', '_', "", "\t\n ")).
+sample(j(&(&(a)), &(-(1)), &(1), -(&), &(-), [&], &((a,b)), -(&(a)),
+         fact(1), fact(1,2), yy(yy(a)), fact(fact(a)), -(yy(1)))).
+sample(k(T, T, [T, T|T])) :-
+    T = f((p:-q), a- -1, "abc", [-]).
+
+options([]).
+options([quoted(true)]).
+options([quoted(true), ignore_ops(true)]).
+options([quoted(true), ignore_ops(ops)]).
+options([quoted(true), numbervars(true), max_depth(3)]).
+options([numbervars(true), max_depth(7)]).
+options([quoted(true), priority(999)]).
+
+% Text written by Goal
+output_of(Goal, Text) :-
+    mktemp_in_tmp('writeXXXXXX', File),
+    open(File, write, S),
+    current_output(Old),
+    set_output(S),
+    call(Goal),
+    set_output(Old),
+    close(S),
+    file_to_string(File, Text),
+    delete_file(File).
+
+same_output(Goal) :-
+    set_prolog_flag(native_writer, on),
+    output_of(Goal, Text1),
+    set_prolog_flag(native_writer, off),
+    output_of(Goal, Text2),
+    set_prolog_flag(native_writer, on),
+    anon_vars(Text1, Norm),
+    anon_vars(Text2, Norm).
+
+% Replace variable names (e.g., _123, which depend on heap addresses)
+% by _
+anon_vars([], []).
+anon_vars([0'_|Cs0], [0'_|Cs]) :- !,
+    skip_digits(Cs0, Cs1),
+    anon_vars(Cs1, Cs).
+anon_vars([C|Cs0], [C|Cs]) :-
+    anon_vars(Cs0, Cs).
+
+skip_digits([C|Cs0], Cs) :- C >= 0'0, C =< 0'9, !, skip_digits(Cs0, Cs).
+skip_digits(Cs, Cs).
+
+write_all(Opts) :-
+    ( sample(T),
+      write_term(T, Opts), nl,
+      fail
+    ; true
+    ).
+
+:- export(native_write/0).
+:- test native_write # "Native and Prolog writers agree".
+
+native_write :-
+    op(100, fy, [&]),
+    op(200, xf, [fact]),
+    op(700, xfx, [fact]),
+    op(100, yf, [yy]),
+    \+ ( options(Opts),
+         \+ same_output(write_all(Opts)) ),
+    set_prolog_flag(write_strings, on),
+    ( same_output(write_all([quoted(true)])) -> Ok = yes ; Ok = no ),
+    set_prolog_flag(write_strings, off),
+    op(0, fy, [&]),
+    op(0, xf, [fact]),
+    op(0, xfx, [fact]),
+    op(0, yf, [yy]),
+    Ok = yes.
+
+:- export(variable_names/0).
+:- test variable_names # "variable_names/1 write option".
+
+variable_names :-
+    T = f(X, [Y|Z], "ab"||Z, _),
+    Opts = [quoted(true), variable_names(['X'=X, 'Y'=Y, 'Z'=Z, 'W'=X])],
+    same_output(write_term(T, Opts)),
+    output_of(write_term(T, Opts), Text),
+    Text = "f(X,[Y|Z],[97,98|Z],"||_.
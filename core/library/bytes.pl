@@ -0,0 +1,171 @@
+:- module(bytes, [
+    is_bytes/1,
+    bytes_codes/2,
+    bytes_length/2,
+    sub_bytes/4,
+    bytes_concat/3,
+    bytes_concat_list/2,
+    bytes_search/4,
+    bytes_byte/3,
+    bytes_compare/3,
+    bytes_read/3,
+    bytes_read_file/4,
+    bytes_write/2
+], [assertions, isomodes, regtypes]).
+
+:- doc(title, "Byte buffers").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module implements @concept{byte buffers}:
+   immutable sequences of bytes stored compactly in the heap (several
+   bytes per heap cell, instead of two cells per byte as in lists of
+   codes). Byte buffers are ordinary terms, so they can be stored in
+   the database, copied, or garbage collected as any other term.
+
+   Length and slicing (@pred{sub_bytes/4}) take constant time, since
+   slices share the data of the original buffer. Buffers can be read
+   from and written to streams (including sockets) without
+   converting them to lists of codes.
+
+   Note that two buffers with the same contents are not necessarily
+   identical terms (e.g., a slice and a copy of it); use
+   @pred{bytes_compare/3} to compare their contents.").
+
+:- use_module(engine(stream_basic), [stream/1]).
+:- use_module(engine(internals), [
+    '$bytes_from_codes'/2,
+    '$bytes_to_codes'/2,
+    '$bytes_sub'/4,
+    '$bytes_concat'/2,
+    '$bytes_search'/4,
+    '$bytes_get'/3,
+    '$bytes_compare'/3,
+    '$bytes_read'/3,
+    '$bytes_read_file'/4,
+    '$bytes_write'/2]).
+
+:- regtype is_bytes(B) # "@var{B} is a byte buffer.".
+
+is_bytes('$bytes'(Data, Off, Len)) :-
+    term(Data), int(Off), int(Len).
+
+check_bytes(B, _) :- B = '$bytes'(_,_,_), !.
+check_bytes(B, PredName) :- var(B), !,
+    throw(error(instantiation_error, PredName)).
+check_bytes(B, PredName) :-
+    throw(error(type_error(bytes, B), PredName)).
+
+:- pred bytes_codes(+Bytes, ?Codes) :: is_bytes * list(int)
+   # "@var{Codes} is the list of bytes in @var{Bytes}.".
+:- pred bytes_codes(-Bytes, +Codes) :: is_bytes * list(int)
+   # "@var{Bytes} is a new byte buffer with the bytes in @var{Codes}.".
+
+bytes_codes(Bytes, Codes) :- nonvar(Bytes), !,
+    check_bytes(Bytes, bytes_codes/2),
+    '$bytes_to_codes'(Bytes, Codes).
+bytes_codes(Bytes, Codes) :-
+    ( '$bytes_from_codes'(Codes, Bytes0) -> Bytes = Bytes0
+    ; throw(error(type_error(bytelist, Codes), bytes_codes/2))
+    ).
+
+:- pred bytes_length(+Bytes, ?Length) :: is_bytes * int
+   # "@var{Length} is the number of bytes in @var{Bytes} (in
+   constant time).".
+
+bytes_length(Bytes, Length) :-
+    check_bytes(Bytes, bytes_length/2),
+    Bytes = '$bytes'(_, _, Length0),
+    Length = Length0.
+
+:- pred sub_bytes(+Bytes, +Offset, +Length, -Sub)
+   :: is_bytes * int * int * is_bytes
+   # "@var{Sub} is the slice of @var{Length} bytes of @var{Bytes}
+   starting at @var{Offset} (0-based). It takes constant time (the
+   data is shared). Fails if the slice is out of bounds.".
+
+sub_bytes(Bytes, Offset, Length, Sub) :-
+    check_bytes(Bytes, sub_bytes/4),
+    '$bytes_sub'(Bytes, Offset, Length, Sub).
+
+:- pred bytes_concat(+Bytes1, +Bytes2, -Bytes)
+   :: is_bytes * is_bytes * is_bytes
+   # "@var{Bytes} is the concatenation of @var{Bytes1} and
+   @var{Bytes2}.".
+
+bytes_concat(Bytes1, Bytes2, Bytes) :-
+    check_bytes(Bytes1, bytes_concat/3),
+    check_bytes(Bytes2, bytes_concat/3),
+    '$bytes_concat'([Bytes1, Bytes2], Bytes).
+
+:- pred bytes_concat_list(+BytesList, -Bytes) :: list(is_bytes) * is_bytes
+   # "@var{Bytes} is the concatenation of all the buffers in
+   @var{BytesList} (copied once).".
+
+bytes_concat_list(BytesList, Bytes) :-
+    check_bytes_list(BytesList),
+    '$bytes_concat'(BytesList, Bytes).
+
+check_bytes_list(L) :- var(L), !,
+    throw(error(instantiation_error, bytes_concat_list/2)).
+check_bytes_list([]) :- !.
+check_bytes_list([B|Bs]) :- !,
+    check_bytes(B, bytes_concat_list/2),
+    check_bytes_list(Bs).
+check_bytes_list(L) :-
+    throw(error(type_error(list, L), bytes_concat_list/2)).
+
+:- pred bytes_search(+Bytes, +Pattern, +From, -Pos)
+   :: is_bytes * is_bytes * int * int
+   # "@var{Pos} is the first position (not before @var{From}) where
+   @var{Pattern} occurs in @var{Bytes}. Fails if there is none.".
+
+bytes_search(Bytes, Pattern, From, Pos) :-
+    check_bytes(Bytes, bytes_search/4),
+    check_bytes(Pattern, bytes_search/4),
+    '$bytes_search'(Bytes, Pattern, From, Pos).
+
+:- pred bytes_byte(+Bytes, +Index, -Byte) :: is_bytes * int * int
+   # "@var{Byte} is the byte at position @var{Index} (0-based) of
+   @var{Bytes}. Fails if @var{Index} is out of bounds.".
+
+bytes_byte(Bytes, Index, Byte) :-
+    check_bytes(Bytes, bytes_byte/3),
+    '$bytes_get'(Bytes, Index, Byte).
+
+:- pred bytes_compare(?Order, +Bytes1, +Bytes2) :: atm * is_bytes * is_bytes
+   # "@var{Order} is the result (@tt{<}, @tt{=}, or @tt{>}) of
+   comparing the contents of @var{Bytes1} and @var{Bytes2}
+   lexicographically.".
+
+bytes_compare(Order, Bytes1, Bytes2) :-
+    check_bytes(Bytes1, bytes_compare/3),
+    check_bytes(Bytes2, bytes_compare/3),
+    '$bytes_compare'(Order, Bytes1, Bytes2).
+
+:- pred bytes_read(+Stream, +Max, -Bytes) :: stream * int * is_bytes
+   # "Reads at most @var{Max} bytes from @var{Stream} into
+   @var{Bytes}. Fewer bytes are returned only at the end of the
+   stream or, for sockets, when less data is available (an empty
+   buffer means that the peer closed the connection).".
+
+bytes_read(Stream, Max, Bytes) :-
+    '$bytes_read'(Stream, Max, Bytes).
+
+:- pred bytes_read_file(+File, +Offset, +Length, -Bytes)
+   :: atm * int * int * is_bytes
+   # "@var{Bytes} holds the @var{Length} bytes of the regular file
+   @var{File} starting at @var{Offset} (the range is clipped to the
+   size of the file). The file is mapped into memory (where
+   available) instead of being read through a stream.".
+
+bytes_read_file(File, Offset, Length, Bytes) :-
+    '$bytes_read_file'(File, Offset, Length, Bytes).
+
+:- pred bytes_write(+Stream, +Bytes) :: stream * is_bytes
+   # "Writes all the bytes of @var{Bytes} to @var{Stream} (which may
+   be a socket).".
+
+bytes_write(Stream, Bytes) :-
+    check_bytes(Bytes, bytes_write/2),
+    '$bytes_write'(Stream, Bytes).
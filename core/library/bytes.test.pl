@@ -0,0 +1,114 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for bytes.pl").
+
+:- use_module(library(bytes)).
+:- use_module(library(lists), [length/2]).
+:- use_module(library(between), [between/3]).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1]).
+:- use_module(library(stream_utils), [write_bytes/2]).
+:- use_module(engine(stream_basic)).
+
+:- export(test_codes/0).
+:- test test_codes # "Conversion from and to lists of codes".
+test_codes :-
+    findall(X, between(0, 255, X), Cs),
+    bytes_codes(B, Cs),
+    bytes_length(B, 256),
+    bytes_codes(B, Cs2),
+    Cs2 == Cs,
+    bytes_codes(E, []),
+    bytes_length(E, 0),
+    bytes_codes(E, []).
+
+:- export(test_slice/0).
+:- test test_slice # "Slices share data and keep the contents".
+test_slice :-
+    bytes_codes(B, "hello, world"),
+    sub_bytes(B, 7, 5, S),
+    bytes_codes(S, "world"),
+    sub_bytes(S, 1, 3, S2),
+    bytes_codes(S2, "orl"),
+    bytes_byte(S2, 0, 0'o),
+    \+ sub_bytes(B, 10, 5, _),
+    \+ bytes_byte(S2, 3, _).
+
+:- export(test_concat_search/0).
+:- test test_concat_search # "Concatenation, search and comparison".
+test_concat_search :-
+    bytes_codes(A, "GET / HTTP/1.1\r\n"),
+    bytes_codes(B, "Host: x\r\n\r\nbody"),
+    bytes_concat(A, B, AB),
+    bytes_length(AB, 31),
+    bytes_codes(Sep, "\r\n\r\n"),
+    bytes_search(AB, Sep, 0, 23),
+    \+ bytes_search(AB, Sep, 24, _),
+    sub_bytes(AB, 0, 16, A2),
+    bytes_compare(=, A, A2),
+    bytes_compare(<, A2, AB),
+    bytes_concat_list([A, B, A], L),
+    bytes_length(L, 47).
+
+:- export(test_large/0).
+:- test test_large # "Large buffers (packed in few heap cells)".
+test_large :-
+    length(Cs, 100000),
+    fill(Cs, 0),
+    bytes_codes(B, Cs),
+    sub_bytes(B, 99990, 10, S),
+    bytes_codes(S, [92,93,94,95,96,97,98,99,100,101]).
+
+fill([], _).
+fill([C|Cs], I) :- C is I mod 251, I1 is I+1, fill(Cs, I1).
+
+:- export(test_read_file/0).
+:- test test_read_file # "Byte ranges of a file (mapped)".
+test_read_file :-
+    mktemp_in_tmp('bytesXXXXXX', Path),
+    length(Cs, 5000),
+    fill(Cs, 0),
+    open(Path, write, S),
+    write_bytes(S, Cs),
+    close(S),
+    ( check_read_file(Path, Cs) -> Ok = yes ; Ok = no ),
+    delete_file(Path),
+    Ok = yes.
+
+check_read_file(Path, Cs) :-
+    bytes_read_file(Path, 0, 5000, All),
+    bytes_codes(All, Cs),
+    % (across a page boundary)
+    bytes_read_file(Path, 4090, 10, B),
+    bytes_codes(B, [74,75,76,77,78,79,80,81,82,83]),
+    % (clipped to the size of the file)
+    bytes_read_file(Path, 4995, 100, C),
+    bytes_length(C, 5),
+    bytes_read_file(Path, 6000, 10, E),
+    bytes_length(E, 0).
+
+:- export(test_read_write/0).
+:- test test_read_write # "Reading and writing streams (with line counts)".
+test_read_write :-
+    mktemp_in_tmp('bytesXXXXXX', Path),
+    ( check_read_write(Path) -> Ok = yes ; Ok = no ),
+    delete_file(Path),
+    Ok = yes.
+
+check_read_write(Path) :-
+    length(Cs, 200000),
+    fill(Cs, 0),
+    bytes_codes(B, Cs),
+    bytes_codes(NL, "a\nb\n"),
+    open(Path, write, S),
+    bytes_write(S, NL),
+    line_count(S, 2),
+    bytes_write(S, B),
+    close(S),
+    open(Path, read, R),
+    % (the buffer grows with the data, not with the maximum)
+    bytes_read(R, 100000000, All),
+    close(R),
+    bytes_length(All, 200004),
+    sub_bytes(All, 4, 200000, B2),
+    bytes_compare(=, B, B2).
@@ -28,6 +28,7 @@
 
 :- use_module(library(clpqr/arith_extra)).
 % For rationals
+:- use_module(library(rationals), [addq/6, subq/6, mulq/6, divq/6, comq/5]).
 
 % low level arithmetic for clp(r,q,z)
 %
@@ -107,55 +108,6 @@ rat(min(X,Y), Cn,Cd)  :- rat(X, An,Ad), rat(Y, Bn,Bd),
 rat(max(X,Y), Cn,Cd)  :- rat(X, An,Ad), rat(Y, Bn,Bd),
   ( comq(An,Ad, Bn,Bd, >) -> Cn=An,Cd=Ad; Cn=Bn,Cd=Bd ).
 
-mulq(Na,Da, Nb,Db, Nc,Dc) :-
-  Gcd1 is gcd(Na,Db),
-  ( Gcd1 = 1 -> Na1=Na,Db1=Db; Na1 is Na//Gcd1,Db1 is Db//Gcd1 ),
-  Gcd2 is gcd(Nb,Da),
-  ( Gcd2 = 1 -> Nb1=Nb,Da1=Da; Nb1 is Nb//Gcd2,Da1 is Da//Gcd2 ),
-  Nc is Na1 * Nb1,
-  Dc is Da1 * Db1.
-
-
-divq(Na,Da, Nb,Db, Nc,Dc) :-
-  Gcd1 is gcd(Na,Nb),
-  ( Gcd1 = 1 -> Na1=Na,Nb1=Nb; Na1 is Na//Gcd1,Nb1 is Nb//Gcd1 ),
-  Gcd2 is gcd(Da,Db),
-  ( Gcd2 = 1 -> Da1=Da,Db1=Db; Da1 is Da//Gcd2,Db1 is Db//Gcd2 ),
-  ( Nb1 < 0 ->           % keep denom positive !!!
-   Nc is -(Na1 * Db1),
-   Dc is Da1 * (-Nb1)
-  ;
-   Nc is Na1 * Db1,
-   Dc is Da1 * Nb1
-  ).
-
-addq(Na,Da, Nb,Db, Nc,Dc) :-
-  Gcd1 is gcd(Da,Db),
-  ( Gcd1 = 1 ->          % This is the case (for random input) with
-                     % probability 6/(pi**2).
-   Nc is Na*Db + Nb*Da,
-   Dc is Da*Db
-  ;
-   T is Na*(Db//Gcd1) + Nb*(Da//Gcd1),
-   Gcd2 is gcd(T,Gcd1),
-   Nc is T//Gcd2,
-   Dc is Da//Gcd1 * Db//Gcd2
-  ).
-
-subq(Na,Da, Nb,Db, Nc,Dc) :-
-  Gcd1 is gcd(Da,Db),
-  ( Gcd1 = 1 ->          % This is the case (for random input) with
-                     % probability 6/(pi**2).
-   Nc is Na*Db - Nb*Da,
-   Dc is Da*Db
-  ;
-   T is Na*(Db//Gcd1) - Nb*(Da//Gcd1),
-   Gcd2 is gcd(T,Gcd1),
-   Nc is T//Gcd2,
-   Dc is Da//Gcd1 * Db//Gcd2
-  ).
-
-
 comQ(Na,Da, Nb,Db, X) :-  % return a numeric value
   comq(Na,Da, Nb,Db, S),
   rel_to_sign(S, X).
@@ -164,12 +116,6 @@ rel_to_sign(<, -1).
 rel_to_sign(=,  0).
 rel_to_sign(>,  1).
 
-comq(Na,Da, Nb,Db, S) :-  % todo: avoid multiplication by looking a signs first !!!
-  Xa is Na * Db,
-  Xb is Nb * Da,
-  compare(S, Xa, Xb).
-
-
 % ----------------------------- float -> rational -----------------------------
 
 float_rat(F, Rat) :-
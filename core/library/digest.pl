@@ -0,0 +1,130 @@
+:- module(digest, [
+    digest_algorithm/1,
+    digest_init/2,
+    digest_update/3,
+    digest_update_stream/3,
+    digest_update_file/3,
+    digest_final/2,
+    digest/3,
+    digest_stream/3,
+    digest_file/3
+], [assertions, isomodes, regtypes]).
+
+:- doc(title, "Message digests").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module computes @concept{message digests}
+   (hashes) of data, streams, and files natively in the engine, without
+   spawning external tools. The supported algorithms are MD5, SHA-1,
+   SHA-256 (using the SHA extensions of x86-64 processors when
+   available), and the (non-cryptographic) XXH64 hash.
+
+   Digests can be computed incrementally using a @em{context}: an
+   ordinary (immutable) term obtained from @pred{digest_init/2},
+   updated with @pred{digest_update/3} and related predicates, and
+   finished with @pred{digest_final/2}. Files and streams are hashed
+   in fixed-size chunks, so that memory usage does not depend on their
+   size.
+
+   Digests are returned as atoms of lowercase hexadecimal digits, e.g.:
+@begin{verbatim}
+?- digest(sha256, abc, H).
+
+H = ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad ?
+@end{verbatim}
+   ").
+
+:- use_module(engine(stream_basic), [stream/1]).
+:- use_module(engine(internals), [
+    '$digest_init'/2,
+    '$digest_update'/3,
+    '$digest_update_stream'/3,
+    '$digest_update_file'/3,
+    '$digest_final'/2]).
+:- use_module(library(bytes), [is_bytes/1]).
+
+:- regtype digest_algorithm(Alg) # "@var{Alg} is a digest algorithm.".
+
+digest_algorithm(md5).
+digest_algorithm(sha1).
+digest_algorithm(sha256).
+digest_algorithm(xxh64).
+
+:- regtype digest_ctx(Ctx) # "@var{Ctx} is a digest context.".
+
+digest_ctx(Ctx) :- is_bytes(Ctx).
+
+:- regtype digest_data(Data) # "@var{Data} is a byte buffer (see
+   @lib{bytes}), a list of bytes, or an atom (its UTF-8 encoding).".
+
+digest_data(Data) :- is_bytes(Data).
+digest_data(Data) :- list(Data, int).
+digest_data(Data) :- atm(Data).
+
+:- pred digest_init(+Alg, -Ctx) :: digest_algorithm * digest_ctx
+   # "@var{Ctx} is a new digest context for algorithm @var{Alg}.".
+
+digest_init(Alg, Ctx) :-
+    '$digest_init'(Alg, Ctx).
+
+:- pred digest_update(+Ctx0, +Data, -Ctx)
+   :: digest_ctx * digest_data * digest_ctx
+   # "@var{Ctx} is the context @var{Ctx0} after processing
+   @var{Data}. Fails if @var{Data} is not valid.".
+
+digest_update(Ctx0, Data, Ctx) :-
+    '$digest_update'(Ctx0, Data, Ctx).
+
+:- pred digest_update_stream(+Ctx0, +Stream, -Ctx)
+   :: digest_ctx * stream * digest_ctx
+   # "@var{Ctx} is the context @var{Ctx0} after processing all the
+   (remaining) bytes of @var{Stream}, which is left at its end.".
+
+digest_update_stream(Ctx0, Stream, Ctx) :-
+    '$digest_update_stream'(Ctx0, Stream, Ctx).
+
+:- pred digest_update_file(+Ctx0, +File, -Ctx)
+   :: digest_ctx * atm * digest_ctx
+   # "@var{Ctx} is the context @var{Ctx0} after processing the
+   contents of @var{File}.".
+
+digest_update_file(Ctx0, File, Ctx) :-
+    '$digest_update_file'(Ctx0, File, Ctx).
+
+:- pred digest_final(+Ctx, -Digest) :: digest_ctx * atm
+   # "@var{Digest} is the digest (in hexadecimal) of the data
+   processed by @var{Ctx}. The context is not consumed and can be
+   further updated.".
+
+digest_final(Ctx, Digest) :-
+    '$digest_final'(Ctx, Digest).
+
+:- pred digest(+Alg, +Data, -Digest)
+   :: digest_algorithm * digest_data * atm
+   # "@var{Digest} is the digest of @var{Data} using @var{Alg}.".
+
+digest(Alg, Data, Digest) :-
+    '$digest_init'(Alg, Ctx0),
+    '$digest_update'(Ctx0, Data, Ctx),
+    '$digest_final'(Ctx, Digest).
+
+:- pred digest_stream(+Alg, +Stream, -Digest)
+   :: digest_algorithm * stream * atm
+   # "@var{Digest} is the digest of the (remaining) contents of
+   @var{Stream} using @var{Alg}.".
+
+digest_stream(Alg, Stream, Digest) :-
+    '$digest_init'(Alg, Ctx0),
+    '$digest_update_stream'(Ctx0, Stream, Ctx),
+    '$digest_final'(Ctx, Digest).
+
+:- pred digest_file(+Alg, +File, -Digest)
+   :: digest_algorithm * atm * atm
+   # "@var{Digest} is the digest of the contents of @var{File} using
+   @var{Alg}.".
+
+digest_file(Alg, File, Digest) :-
+    '$digest_init'(Alg, Ctx0),
+    '$digest_update_file'(Ctx0, File, Ctx),
+    '$digest_final'(Ctx, Digest).
@@ -0,0 +1,50 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for digest.pl").
+
+:- use_module(library(digest)).
+:- use_module(library(bytes)).
+:- use_module(library(between), [between/3]).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(lists), [append/3]).
+
+:- export(test_vectors/0).
+:- test test_vectors # "Known digests of short inputs".
+test_vectors :-
+    digest(md5, '', d41d8cd98f00b204e9800998ecf8427e),
+    digest(md5, abc, '900150983cd24fb0d6963f7d28e17f72'),
+    digest(sha1, '', da39a3ee5e6b4b0d3255bfef95601890afd80709),
+    digest(sha1, "abc", a9993e364706816aba3e25717850c26c9cd0d89d),
+    digest(sha256, '', e3b0c44298fc1c149afbf4c8996fb92427ae41e4649b934ca495991b7852b855),
+    digest(sha256, abc, ba7816bf8f01cfea414140de5dae2223b00361a396177a9cb410ff61f20015ad),
+    digest(xxh64, '', ef46db3751d8e999),
+    digest(xxh64, abc, '44bc2cf5ad770999').
+
+long_data(Cs) :-
+    findall(X, between(0, 255, X), Cs0),
+    append(Cs0, Cs0, Cs1),
+    append(Cs1, Cs1, Cs2),
+    append(Cs2, Cs0, Cs). % 1280 bytes
+
+:- export(test_incremental/0).
+:- test test_incremental # "Incremental updates with mixed data".
+test_incremental :-
+    long_data(Cs),
+    bytes_codes(B, Cs),
+    sub_bytes(B, 0, 100, B1),
+    sub_bytes(B, 100, 1180, B2),
+    \+ ( member(Alg-D, [
+          md5-'82829f1f3f2bb0f18b25f278e5bba8bd',
+          sha1-e37a04cb2353309f5cff4ee036cfb91a5e31cefd,
+          sha256-d414b085826eb06778483ba35564dc849e643359f69ed9747878ba6e54985bed,
+          xxh64-afc184ad7938a354]),
+         \+ ( digest(Alg, Cs, D),
+              digest(Alg, B, D),
+              digest_init(Alg, C0),
+              digest_update(C0, B1, C1),
+              digest_update(C1, B2, C2),
+              digest_final(C2, D) )
+       ).
+
+member(X, [X|_]).
+member(X, [_|Xs]) :- member(X, Xs).
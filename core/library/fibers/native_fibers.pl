@@ -0,0 +1,343 @@
+:- module(native_fibers, [
+    fiber/1,
+    fiber_new/2,
+    fiber_resume/3,
+    fiber_yield/2,
+    fiber_self/1,
+    fiber_free/1,
+    fiber_run/1,
+    fiber_spawn/1,
+    fiber_spawn/2,
+    fiber_pause/0,
+    fiber_wait_read/1,
+    fiber_wait_write/1,
+    fiber_sleep/1
+], [assertions, isomodes, regtypes, hiord]).
+
+:- doc(title, "Native fibers").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module implements @concept{fibers} (coroutines)
+   supported directly by the engine, and a cooperative scheduler for
+   them with waits for I/O readiness.
+
+   Each fiber runs its goal in its own (small) set of stacks, which
+   grow on demand. Switching to a fiber (@pred{fiber_resume/3})
+   continues its execution where it was suspended
+   (@pred{fiber_yield/2}) in constant time, without going through the
+   dynamic database. Values passed between fibers are copied.
+
+   The low-level interface (@pred{fiber_new/2},
+   @pred{fiber_resume/3}, @pred{fiber_yield/2}) can be used to write
+   generators:
+
+@begin{verbatim}
+?- fiber_new((between(1,3,X), fiber_yield(X,_), fail ; true), F),
+   fiber_resume(F, _, A), fiber_resume(F, _, B).
+
+A = yield(1),
+B = yield(2),
+F = '$fiber'(1) ?
+@end{verbatim}
+
+   @pred{fiber_run/1} runs a goal as a fiber and schedules it
+   together with all the fibers that it spawns (@pred{fiber_spawn/2})
+   until all of them end. Scheduled fibers give control to other
+   fibers when they call @pred{fiber_pause/0}, @pred{fiber_sleep/1},
+   or wait for a stream to be ready (@pred{fiber_wait_read/1},
+   @pred{fiber_wait_write/1}). Fibers waiting for I/O are polled
+   (with a single @tt{poll()} call) when there are no other fibers
+   ready to run.
+
+   Note that:
+   @begin{itemize}
+   @item Fibers are not garbage collected: fibers created with
+     @pred{fiber_new/2} must be released with @pred{fiber_free/1}
+     (@pred{fiber_run/1} releases the fibers that it schedules).
+   @item Each fiber needs some memory for its stacks: around 60KB
+     are allocated initially (about 20KB of them are actually touched
+     by a new fiber, on 64-bit Linux). That is, 100,000 fibers take
+     about 6GB of address space (2GB resident), which is too much for
+     that many fibers per process; the minimum size is bounded by the
+     overflow pads of the engine stacks (see @tt{eng_fiber.h}).
+   @item @pred{fiber_yield/2} suspends the fiber when it makes its
+     next predicate call. The low-level @tt{'$fiber_yield'/2} must be
+     directly followed by a predicate call: if a cut runs in between,
+     the fiber cannot continue, and resuming it raises a permission
+     error.
+   @item Fibers run on the thread that resumes them. A fiber must
+     not be resumed from other thread while it is suspended.
+   @end{itemize}
+   ").
+
+:- use_module(engine(internals), [
+    '$fiber_new'/2,
+    '$fiber_resume'/2,
+    '$fiber_result'/2,
+    '$fiber_yield'/2,
+    '$fiber_self'/1,
+    '$fiber_free'/1,
+    '$fiber_poll'/3]).
+:- use_module(engine(stream_basic), [stream/1, stream_code/2]).
+:- use_module(engine(runtime_control), [statistics/2]).
+:- use_module(library(lists), [reverse/2]).
+
+:- regtype fiber(F) # "@var{F} is a fiber.".
+
+fiber('$fiber'(Id)) :- int(Id).
+
+check_fiber(F, _) :- F = '$fiber'(_), !.
+check_fiber(F, PredName) :- var(F), !,
+    throw(error(instantiation_error, PredName)).
+check_fiber(F, PredName) :-
+    throw(error(type_error(fiber, F), PredName)).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Fibers").
+
+:- pred fiber_new(+Goal, -F) :: callable * fiber
+   # "@var{F} is a new fiber that will run (a copy of) @var{Goal}
+   when it is resumed for the first time.".
+
+:- meta_predicate fiber_new(goal, ?).
+fiber_new(Goal, F) :-
+    new_fiber(fiber_main(Goal), F).
+
+:- meta_predicate new_fiber(primitive(goal), ?).
+new_fiber(G, F) :-
+    '$fiber_new'(G, F).
+
+% The goal of a fiber (it never ends, the fiber is always suspended)
+fiber_main(Goal) :-
+    catch(fiber_main_(Goal, R), E, R = exception(E)),
+    fiber_exit(R).
+
+fiber_main_(Goal, R) :-
+    ( call(Goal) -> R = true ; R = fail ).
+
+fiber_exit(R) :-
+    suspend(exit(R), _),
+    fiber_exit(R).
+
+% suspend(+Out, ?In): suspend the current fiber (see '$fiber_yield'/2)
+suspend(Out, In) :-
+    '$fiber_yield'(Out, In),
+    % (the fiber stops when entering fiber_switch/0, before any cut
+    % could remove the choicepoint pushed by '$fiber_yield'/2)
+    fiber_switch.
+
+fiber_switch.
+
+check_in_fiber(_, _) :- '$fiber_self'(_), !.
+check_in_fiber(Action, PredName) :-
+    throw(error(permission_error(Action, fiber, none), PredName)).
+
+:- pred fiber_resume(+F, +In, -Out) :: fiber * term * term
+   # "Continues the execution of @var{F} until it yields or ends.
+   @var{In} is passed to the @pred{fiber_yield/2} call that suspended
+   @var{F} (it is ignored the first time). @var{Out} is
+   @tt{yield(X)} if the fiber called @pred{fiber_yield(X, _)}, or
+   @tt{exit(R)} if its goal ended, where @var{R} is @tt{true},
+   @tt{fail}, or @tt{exception(E)}. Resuming a fiber that has ended
+   returns @tt{exit(R)} again. It is an error to resume a running
+   fiber (e.g., a fiber from itself) or a released one.".
+
+fiber_resume(F, In, Out) :-
+    check_fiber(F, fiber_resume/3),
+    ( '$fiber_resume'(F, In) -> true
+    ; throw(error(permission_error(resume, fiber, F), fiber_resume/3))
+    ),
+    '$fiber_result'(F, Out).
+
+:- pred fiber_yield(+X, -In) :: term * term
+   # "Suspends the current fiber. Its resumer obtains @tt{yield(X)}
+   and @var{In} is unified with the value passed to
+   @pred{fiber_resume/3} by the next resumer.".
+
+fiber_yield(X, In) :-
+    check_in_fiber(yield, fiber_yield/2),
+    suspend(yield(X), In).
+
+:- pred fiber_self(-F) :: fiber
+   # "@var{F} is the current fiber. Fails if not called from a
+   fiber.".
+
+fiber_self(F) :-
+    '$fiber_self'(F).
+
+:- pred fiber_free(+F) :: fiber
+   # "Releases the fiber @var{F} (which must not be running).".
+
+fiber_free(F) :-
+    check_fiber(F, fiber_free/1),
+    ( '$fiber_free'(F) -> true
+    ; throw(error(permission_error(free, fiber, F), fiber_free/1))
+    ).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Scheduler").
+
+:- pred fiber_run(+Goal) :: callable
+   # "Runs @var{Goal} as a fiber, scheduling it together with all the
+   fibers spawned from them, until all of them end. Fails if
+   @var{Goal} fails. If the goal of some fiber raises an exception,
+   all the fibers are released and the exception is raised
+   again.".
+
+:- meta_predicate fiber_run(goal).
+fiber_run(Goal) :-
+    fiber_new(Goal, F),
+    sched([F-true], [], [], [], F, R),
+    R = true.
+
+% sched(+Front, +Back, +Waits, +Timers, +Root, -R): schedule the
+% ready fibers in Front and Back (a queue, as F-In pairs), the fibers
+% waiting for I/O in Waits ((Fd-Mode)-F pairs), and the fibers
+% sleeping in Timers (Deadline-F pairs). R is the result of the Root
+% fiber.
+sched([F-In|Front], Back, Waits, Timers, Root, R) :- !,
+    '$fiber_resume'(F, In),
+    '$fiber_result'(F, Out),
+    sched_(Out, F, Front, Back, Waits, Timers, Root, R).
+sched([], [], [], [], _, _) :- !.
+sched([], Back, Waits, Timers, Root, R) :-
+    reverse(Back, Front0),
+    wake(Front0, Waits, Timers, Front, Waits1, Timers1),
+    sched(Front, [], Waits1, Timers1, Root, R).
+
+sched_(exit(R0), F, Front, Back, Waits, Timers, Root, R) :- !,
+    '$fiber_free'(F),
+    ( R0 = exception(E) ->
+        free_queue(Front), free_queue(Back),
+        free_waiting(Waits), free_waiting(Timers),
+        throw(E)
+    ; true
+    ),
+    ( F == Root -> R = R0 ; true ),
+    sched(Front, Back, Waits, Timers, Root, R).
+sched_(sched(spawn(G)), F, Front, Back, Waits, Timers, Root, R) :- !,
+    % (the spawning fiber continues, the new one is queued)
+    new_fiber(fiber_main(G), F2),
+    sched([F-F2|Front], [F2-true|Back], Waits, Timers, Root, R).
+sched_(sched(Req), F, Front, Back, Waits, Timers, Root, R) :- !,
+    sched_req(Req, F, Back, Waits, Timers, Back1, Waits1, Timers1),
+    sched(Front, Back1, Waits1, Timers1, Root, R).
+sched_(_, F, Front, Back, Waits, Timers, Root, R) :- % (yield/1)
+    sched(Front, [F-true|Back], Waits, Timers, Root, R).
+
+sched_req(pause, F, Back, Waits, Timers, [F-true|Back], Waits, Timers).
+sched_req(wait(Fd, Mode), F, Back, Waits, Timers, Back, [(Fd-Mode)-F|Waits], Timers).
+sched_req(sleep(Deadline), F, Back, Waits, Timers, Back, Waits, [Deadline-F|Timers]).
+
+% Move the fibers whose wait is over from Waits and Timers to Front
+% (blocking until some is over if there are no ready fibers)
+wake(Front0, [], [], Front, [], []) :- !,
+    Front = Front0.
+wake(Front0, Waits, Timers, Front, Waits1, Timers1) :-
+    now(Now),
+    wake_timers(Timers, Now, Front0, Front1, Timers1),
+    poll_timeout(Front1, Timers1, Now, Timeout),
+    wait_keys(Waits, Fds),
+    '$fiber_poll'(Fds, Timeout, Ready),
+    wake_waits(Waits, Ready, Front1, Front, Waits1).
+
+wake_timers([], _, Front, Front, []).
+wake_timers([T-F|Timers], Now, Front0, Front, Timers1) :-
+    ( T =< Now ->
+        Front = [F-true|Front1], Timers1 = Timers2
+    ; Front = Front1, Timers1 = [T-F|Timers2]
+    ),
+    wake_timers(Timers, Now, Front0, Front1, Timers2).
+
+% (do not block if there are ready fibers; otherwise, block until the
+% first timer expires, or forever if there are no timers)
+poll_timeout([_|_], _, _, 0) :- !.
+poll_timeout([], [], _, -1) :- !.
+poll_timeout([], [T-_|Timers], Now, Timeout) :-
+    min_deadline(Timers, T, Min),
+    ( Min > Now -> Timeout is Min - Now ; Timeout = 0 ).
+
+min_deadline([], Min, Min).
+min_deadline([T-_|Timers], Min0, Min) :-
+    ( T < Min0 -> Min1 = T ; Min1 = Min0 ),
+    min_deadline(Timers, Min1, Min).
+
+wait_keys([], []).
+wait_keys([W-_|Waits], [W|Fds]) :-
+    wait_keys(Waits, Fds).
+
+% (Ready is an ordered subsequence of the keys of Waits)
+wake_waits([], _, Front, Front, []).
+wake_waits([W-F|Waits], Ready, Front0, Front, Waits1) :-
+    ( Ready = [R|Ready1], R == W ->
+        Front = [F-true|Front1], Waits1 = Waits2
+    ; Ready1 = Ready, Front = Front1, Waits1 = [W-F|Waits2]
+    ),
+    wake_waits(Waits, Ready1, Front0, Front1, Waits2).
+
+% (current time in milliseconds)
+now(Now) :-
+    statistics(walltime, [T|_]),
+    Now is integer(T).
+
+free_queue([]).
+free_queue([F-_|Xs]) :-
+    '$fiber_free'(F),
+    free_queue(Xs).
+
+free_waiting([]).
+free_waiting([_-F|Xs]) :-
+    '$fiber_free'(F),
+    free_waiting(Xs).
+
+% Request to the scheduler
+sched_call(Req, Reply, PredName) :-
+    check_in_fiber(schedule, PredName),
+    suspend(sched(Req), Reply).
+
+:- pred fiber_spawn(+Goal) :: callable
+   # "Like @pred{fiber_spawn/2} but ignore the spawned fiber.".
+
+:- meta_predicate fiber_spawn(goal).
+fiber_spawn(Goal) :-
+    fiber_spawn(Goal, _).
+
+:- pred fiber_spawn(+Goal, -F) :: callable * fiber
+   # "Creates a new fiber @var{F} that runs @var{Goal}, scheduled by
+   the @pred{fiber_run/1} call that schedules the current fiber.".
+
+:- meta_predicate fiber_spawn(goal, ?).
+fiber_spawn(Goal, F) :-
+    sched_call(spawn(Goal), F, fiber_spawn/2).
+
+:- pred fiber_pause # "Gives control to the other scheduled fibers
+   that are ready to run.".
+
+fiber_pause :-
+    sched_call(pause, _, fiber_pause/0).
+
+:- pred fiber_sleep(+Time) :: num
+   # "Suspends the current (scheduled) fiber during @var{Time}
+   seconds, letting other fibers run.".
+
+fiber_sleep(Time) :-
+    now(Now),
+    Deadline is Now + integer(Time * 1000),
+    sched_call(sleep(Deadline), _, fiber_sleep/1).
+
+:- pred fiber_wait_read(+Stream) :: stream
+   # "Suspends the current (scheduled) fiber until @var{Stream} has
+   data to read (or end of file), letting other fibers run.".
+
+fiber_wait_read(Stream) :-
+    stream_code(Stream, Fd),
+    sched_call(wait(Fd, read), _, fiber_wait_read/1).
+
+:- pred fiber_wait_write(+Stream) :: stream
+   # "Suspends the current (scheduled) fiber until @var{Stream} can
+   be written without blocking, letting other fibers run.".
+
+fiber_wait_write(Stream) :-
+    stream_code(Stream, Fd),
+    sched_call(wait(Fd, write), _, fiber_wait_write/1).
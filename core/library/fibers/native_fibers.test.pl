@@ -0,0 +1,130 @@
+:- module(_, [], [assertions, datafacts]).
+
+:- doc(title, "Tests for native_fibers.pl").
+
+:- use_module(library(fibers/native_fibers)).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(lists), [length/2]).
+:- use_module(engine(stream_basic), [close/1]).
+:- use_module(library(process)).
+:- use_module(library(stream_utils), [get_line/2]).
+:- use_module(engine(internals), ['$fiber_yield'/2]).
+
+:- export(test_generator/0).
+:- test test_generator # "Values passed on yield and resume".
+test_generator :-
+    fiber_new(gen(3, a), F),
+    fiber_resume(F, none, yield(1-a)),
+    fiber_resume(F, b, yield(2-b)),
+    fiber_resume(F, c, yield(3-c)),
+    fiber_resume(F, d, exit(true)),
+    fiber_resume(F, e, exit(true)),
+    fiber_free(F),
+    catch(fiber_resume(F, e, _), error(permission_error(resume, fiber, _), _), true),
+    catch(fiber_yield(x, _), error(permission_error(yield, fiber, _), _), true).
+
+gen(N, Prev) :-
+    gen_(1, N, Prev).
+
+gen_(I, N, Prev) :-
+    ( I > N -> true
+    ; fiber_yield(I-Prev, In),
+      I1 is I+1,
+      gen_(I1, N, In)
+    ).
+
+:- export(test_exits/0).
+:- test test_exits # "Failure, exceptions, and copies of terms".
+test_exits :-
+    fiber_new(fail, F1),
+    fiber_resume(F1, none, exit(fail)),
+    fiber_free(F1),
+    fiber_new(throw(oops), F2),
+    fiber_resume(F2, none, exit(exception(oops))),
+    fiber_free(F2),
+    Big is 1<<100,
+    fiber_new((fiber_yield(f(Big, 1.5, X, X), In), In = g(Y), Y > 0), F3),
+    fiber_resume(F3, none, yield(f(Big1, 1.5, A, B))),
+    Big1 =:= Big, A == B, var(A),
+    fiber_resume(F3, g(3.25), exit(true)),
+    fiber_free(F3).
+
+:- export(test_cut_after_yield/0).
+:- test test_cut_after_yield # "Fibers whose yield choicepoint was cut
+   are not resumed".
+test_cut_after_yield :-
+    fiber_new(cut_after_yield, F),
+    catch((fiber_resume(F, none, _), fail), error(permission_error(resume, fiber, _), _), true),
+    catch((fiber_resume(F, none, _), fail), error(permission_error(resume, fiber, _), _), true),
+    fiber_free(F).
+
+cut_after_yield :-
+    '$fiber_yield'(x, _), !,
+    after_yield.
+
+after_yield.
+
+:- data log/1.
+
+:- export(test_run/0).
+:- test test_run # "Scheduling spawned fibers".
+test_run :-
+    retractall_fact(log(_)),
+    fiber_run((fiber_spawn(worker(a)), fiber_spawn(worker(b)), worker(c))),
+    findall(X, log(X), L),
+    L == [c-1, a-1, b-1, c-2, a-2, b-2].
+
+worker(Name) :-
+    assertz_fact(log(Name-1)),
+    fiber_pause,
+    assertz_fact(log(Name-2)).
+
+:- export(test_sleep/0).
+:- test test_sleep # "Sleeping fibers wake up in order".
+test_sleep :-
+    retractall_fact(log(_)),
+    fiber_run((fiber_spawn(sleeper(0.06, b)), fiber_spawn(sleeper(0.02, a)), sleeper(0.1, c))),
+    findall(X, log(X), L),
+    L == [a, b, c].
+
+sleeper(T, Name) :-
+    fiber_sleep(T),
+    assertz_fact(log(Name)).
+
+:- export(test_many/0).
+:- test test_many # "Many fibers".
+test_many :-
+    retractall_fact(log(_)),
+    fiber_run(spawn_n(1000)),
+    findall(x, log(_), L),
+    length(L, 1000).
+
+spawn_n(0) :- !.
+spawn_n(N) :-
+    fiber_spawn((fiber_pause, assertz_fact(log(N)))),
+    N1 is N-1,
+    spawn_n(N1).
+
+:- export(test_exception/0).
+:- test test_exception # "Exceptions in scheduled fibers".
+test_exception :-
+    catch(fiber_run((fiber_spawn(throw(oops)), fiber_pause, fail)), E, true),
+    E == oops,
+    \+ fiber_run(fail).
+
+:- export(test_wait_read/0).
+:- test test_wait_read # "Waiting for input".
+test_wait_read :-
+    retractall_fact(log(_)),
+    process_call(path(sh), ['-c', 'sleep 0.1; echo hi'],
+                 [stdout(pipe(S)), background(P)]),
+    fiber_run((fiber_spawn(assertz_fact(log(other))), reader(S))),
+    close(S),
+    process_join(P),
+    findall(X, log(X), L),
+    L == [other, "hi"].
+
+reader(S) :-
+    fiber_wait_read(S),
+    get_line(S, Line),
+    assertz_fact(log(Line)).
@@ -333,6 +333,19 @@ header_value('last-modified', last_modified(D)) --> !,
     http_date_str(D),
     http_crlf.
 
+header_field(accept_ranges(_), 'accept-ranges').
+header_shown('accept-ranges', 'Accept-Ranges').
+header_value('accept-ranges', accept_ranges(U)) --> !,
+    http_line_atm(U).
+
+header_field(content_range(_,_,_), 'content-range').
+header_shown('content-range', 'Content-Range').
+header_value('content-range', content_range(First,Last,Length)) --> !,
+    "bytes ", integer_str(First), "-", integer_str(Last),
+    "/", integer_str(Length),
+    http_lws0,
+    http_crlf.
+
 % --
 
 header_field(user_agent(_), 'user-agent').
@@ -346,6 +359,17 @@ header_value('if-modified-since', if_modified_since(Date)) --> !,
     http_date_str(Date),
     http_crlf.
 
+% (Ranges is a list of First-Last, First-none, or suffix(N); it is
+% empty if the ranges are not understood)
+header_field(range(_), 'range').
+header_shown('range', 'Range').
+header_value('range', range(Ranges)) --> 'PRINTING', !,
+    http_byte_ranges(Ranges),
+    http_crlf.
+header_value('range', range(Ranges)) --> !,
+    http_line(Str),
+    { http_byte_ranges(Ranges0, Str, []) -> Ranges = Ranges0 ; Ranges = [] }.
+
 header_field(authorization(_,_), 'authorization').
 header_shown('authorization', 'Authorization').
 header_value('authorization', authorization(Scheme, Params)) --> !,
@@ -354,6 +378,30 @@ header_value('authorization', authorization(Scheme, Params)) --> !,
 
 % ---------------------------------------------------------------------------
 
+http_byte_ranges([R|Rs]) -->
+    "bytes=",
+    http_byte_range(R),
+    http_byte_ranges_rest(Rs).
+
+http_byte_ranges_rest([R|Rs]) -->
+    ",", http_lws0,
+    http_byte_range(R), !,
+    http_byte_ranges_rest(Rs).
+http_byte_ranges_rest([]) --> "".
+
+http_byte_range(suffix(N)) --> "-", !,
+    integer_str(N).
+http_byte_range(First-Last) -->
+    integer_str(First), "-",
+    http_byte_range_last(Last).
+
+http_byte_range_last(Last) --> 'PRINTING', !,
+    ( { Last = none } -> "" ; integer_str(Last) ).
+http_byte_range_last(Last) --> integer_str(Last), !.
+http_byte_range_last(none) --> "".
+
+% ----------------------------------------------------------------------------
+
 % TODO: "Basic" auth-scheme is not supported (need token68 - see https://tools.ietf.org/html/rfc7235#page-12) 
 http_credentials(Scheme,Params) -->
     http_lo_up_token(Scheme),
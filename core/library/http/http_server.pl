@@ -11,14 +11,14 @@
 %  It can be used to handle individual HTTP requests
 %  (@pred{http_serve_fetch/2}) or for implementing a simple HTTP
 %  server (see @pred{http_bind/1}, @pred{http_loop/1},
-%  @pred{http_shutdown/1}).
+%  @pred{http_shutdown/1}), optionally with a pool of preforked
+%  worker processes (@pred{http_prefork_loop/2}).
 %
 %  Clients of this module must use the @lib{http_server_hooks} package
 %  and implement the multifile @pred{httpserv.handle/3} (see
 %  @pred{http_loop/1} for details).
 
 :- use_module(library(lists), [member/2, append/3, select/3, length/2]).
-:- use_module(library(port_reify), [once_port_reify/2, port_call/1]).
 :- use_module(engine(stream_basic)).
 :- use_module(engine(io_basic)).
 :- use_module(library(pathnames), [path_concat/3]).
@@ -43,12 +43,28 @@ http_read_request(Stream, Request) :-
             http_read_content(Stream, Request1, Request2, Tail)
         ; Request2 = Request1
         ),
-        socket_getpeername(Stream, RemoteAddr),
-        Request = [uri(URIStr), remote_addr(RemoteAddr)|Request2]
+        add_request_info(Stream, URIStr, Request2, Request)
     ; log(error, failed(http_request_str/4)),
       fail % TODO: exception?
     ).
 
+% Parse a request already framed by the event loop (see
+% socket_evloop_wait/3)
+http_parse_request(Stream, RequestBytes, Content, Request) :-
+    ( http_request_str(URIStr,Request1,RequestBytes,_) ->
+        ( member(method(post),Request1) ->
+            Request2 = [content(Content)|Request1]
+        ; Request2 = Request1
+        ),
+        add_request_info(Stream, URIStr, Request2, Request)
+    ; log(error, failed(http_request_str/4)),
+      fail
+    ).
+
+add_request_info(Stream, URIStr, Request0, Request) :-
+    socket_getpeername(Stream, RemoteAddr),
+    Request = [uri(URIStr), remote_addr(RemoteAddr)|Request0].
+
 % Receive header and content
 http_read_header(Stream,Str,Tail):-
     http_read_header_(Stream,Data,[],Tail),
@@ -126,26 +142,53 @@ trim([X|Xs],N,[X|Ys]):-
 % ===========================================================================
 :- doc(section, "Write HTTP responses").
 
-:- use_module(library(sockets), [socket_sendall/2, socket_send_stream/2]).
+:- use_module(library(sockets), [socket_sendall/2, socket_sendall_list/2, socket_send_file/4]).
 :- use_module(library(stream_utils), [write_bytes/2, copy_stream/3]).
+:- use_module(library(bytes), [bytes_read_file/4, bytes_codes/2, bytes_concat/3, bytes_write/2]).
 % :- use_module(library(stream_utils), [file_to_bytes/2]).
 
 http_write_response(Stream, Response) :-
     expand_response(Response, Response2, Content),
     http_send_response(Stream, Response2, Content).
 
-% Send Response and Contents
+% Send Response and Contents (and close Stream)
 http_send_response(Stream, Response, Content) :-
+    http_send_response_(Stream, Response, Content),
+    close(Stream).
+
+% Send Response and Contents (keeping Stream open)
+http_send_response_(Stream, Response, Content) :-
     http_response_str(Response,ResponseBytes,[]),
-    catch(write_bytes(Stream,ResponseBytes), _, true), % TODO: log errors? (e.g., resource_error(undefined) due to broken pipe)
-    catch(send_data(Stream,Content), _, true), % TODO: log errors? (e.g., resource_error(undefined) due to broken pipe)
-    flush_output(Stream),
-    close(Stream). % TODO: could be keep Stream open? (see socket_select leak problem)
+    catch(send_response(Content,Stream,ResponseBytes), _, true), % TODO: log errors? (e.g., resource_error(undefined) due to broken pipe)
+    flush_output(Stream).
+
+% (header and in-memory content are sent together)
+send_response(bytelist(Bytes), Stream, ResponseBytes) :- !,
+    socket_sendall_list(Stream, [ResponseBytes, Bytes]).
+% (small files are mapped and sent with the header, so that the
+% response is not split in two segments)
+send_response(file(Path, Offset, Length), Stream, ResponseBytes) :-
+    Length =< 65536, !,
+    bytes_read_file(Path, Offset, Length, Data),
+    bytes_codes(Header, ResponseBytes),
+    bytes_concat(Header, Data, Bytes),
+    bytes_write(Stream, Bytes).
+send_response(Content, Stream, ResponseBytes) :-
+    socket_sendall(Stream, ResponseBytes),
+    send_data(Stream, Content).
+
+% The connection can be kept alive only if the client can tell where
+% the response ends
+keep_alive_response(Response, _Content) :-
+    member(content_length(_), Response), !.
+keep_alive_response(_Response, none).
     
 % Expand some common HTTP responses into response fields and contents field:
 %   - not_found(P): P is not found
 %   - file(P): serve file P
 %   - file_if_newer(OldModifDate, P): serve file P if it has been modified since OldModifDate
+%   - file_range(R, P): serve the byte range R of file P (see range/1 header),
+%       or the whole file if R is not satisfiable
 %   - file_(S,C,OldModifDate,P): serve file P with specific status S and content type C
 %       (if modified since OldModifDate) -- otherwise send 304 status
 %   - string_(S,C,X): serve string X with specific status S and content type C
@@ -174,6 +217,19 @@ expand_response(file_if_newer(OldModifDate, Path), Response, Content) :-
     Status = status(success,200,"OK"),
     file_content_type(Path, ContentType),
     expand_response(file_(Status, ContentType, OldModifDate, Path), Response, Content).
+expand_response(file_range(Range, Path), Response, Content) :-
+    file_properties(Path, _, _, _, _, Size),
+    ( byte_range_bounds(Range, Size, First, Last) ->
+        Status = status(success,206,"Partial Content"),
+        file_content_type(Path, ContentType),
+        modif_time(Path, ModifTime),
+        date_time(ModifTime, ModifDate),
+        ContentLength is Last - First + 1,
+        Content = file(Path, First, ContentLength),
+        response_header(Status, ModifDate, ContentType, ContentLength, Response,
+                        [content_range(First, Last, Size)])
+    ; expand_response(file(Path), Response, Content)
+    ).
 expand_response(html_string(String), Response, Content) :- !,
     Status = status(success,200,"OK"),
     expand_response(html_string(Status, String), Response, Content).
@@ -186,14 +242,15 @@ expand_response(json_string(String), Response, Content) :- !,
     ContentType = content_type(application,json,[]), % TODO: no charset OK?
     expand_response(string_(Status, ContentType, String), Response, Content).
 % Contents of file at Path
+% (sent from the file with socket_send_file/4, without going through terms)
 expand_response(file_(Status, ContentType, OldModifDate, Path), Response, Content) :-
-    % TODO: add special 'contents_from_file' response, serve without going through terms
     modif_time(Path, ModifTime),
     date_time(ModifTime, ModifDate),
     ( needs_update(OldModifDate, ModifDate) ->
         file_properties(Path, _, _, _, _, ContentLength),
-        Content = file(Path),
-        response_header(Status, ModifDate, ContentType, ContentLength, Response, [])
+        Content = file(Path, 0, ContentLength),
+        response_header(Status, ModifDate, ContentType, ContentLength, Response,
+                        [accept_ranges(bytes)])
     ; Content = none,
       not_modified_response(ModifDate, Response, [])
     ).
@@ -229,6 +286,19 @@ not_modified_response(ModifDate) -->
     [date(CurrDate)],
     ( { ModifDate = none } -> [] ; [last_modified(ModifDate)] ).
 
+% First and Last byte positions of Range in a file of the given Size
+% (fails if the range is not satisfiable)
+byte_range_bounds(suffix(N), Size, First, Last) :-
+    N > 0, Size > 0,
+    ( N < Size -> First is Size - N ; First = 0 ),
+    Last is Size - 1.
+byte_range_bounds(First-Last0, Size, First, Last) :-
+    First < Size,
+    ( Last0 = none -> Last is Size - 1
+    ; Last0 >= First,
+      ( Last0 < Size -> Last = Last0 ; Last is Size - 1 )
+    ).
+
 needs_update(none, _ModifDate) :- !.
 needs_update(OldModifDate, ModifDate) :-
     % It is OK to use exact date comparison here (the client
@@ -245,13 +315,8 @@ send_data_(none, _Stream) :- !.
 send_data_(bytelist(Bytes), Stream) :- !,
     %write_bytes(Stream, Bytes).
     socket_sendall(Stream, Bytes). % TODO: merge with write_bytes/2?
-send_data_(file(Path), Stream) :- !,
-%    file_to_bytes(Path, Bytes),
-%    socket_sendall(Stream, Bytes). % TODO: merge with write_bytes/2?
-    open(Path, read, InS),
-    once_port_reify(socket_send_stream(Stream, InS), Port), % TODO: deal with errors
-    close(InS),
-    port_call(Port).
+send_data_(file(Path, Offset, Length), Stream) :- !,
+    socket_send_file(Stream, Path, Offset, Length).
 
 % ===========================================================================
 :- doc(section, "Receive and parse one request").
@@ -279,7 +344,6 @@ http_serve_fetch(Stream,Serve):-
 :- doc(section, "Simple server").
     
 :- use_module(library(sockets)).
-:- use_module(library(sockets/sockets_io), [serve_socket/3]).
 :- use_module(library(system), [file_exists/1, current_host/1, modif_time/2]).
 :- use_module(library(lists), [length/2, list_concat/2]).
 :- use_module(library(pathnames), [path_splitext/3]).
@@ -314,24 +378,197 @@ http_bind(Port) :-
       this loop by @pred{http_shutdown/1} predicate. Requests are
       handled by multifile @pred{httpserv.handle/3} and
       @pred{httpserv.file_path/2} predicates (declared in
-      @lib{http_server_hooks} file).".
+      @lib{http_server_hooks} file).
+
+      Connections are multiplexed with an event loop (see
+      @pred{socket_evloop_wait/3}): requests are read without
+      blocking and only complete requests are handled, so that slow
+      clients do not block the server. Complete requests are handed
+      to a pool of worker threads, each with its own engine (see
+      @pred{http_workers/1}), so that handlers run concurrently and
+      must be thread-safe. Responses are written back by the event
+      loop without blocking (see @pred{socket_evloop_send/4}).
+      Connections are kept alive (for HTTP/1.1 clients or when
+      @tt{Connection: keep-alive} is requested) when the response has
+      a known length.".
 
 http_loop(ExitCode) :-
     curr_socket(Socket),
-    catch(serve_socket_loop(Socket),
+    socket_evloop_new(Socket, Loop),
+    ( current_fact(max_content(Max)) ->
+        socket_evloop_max_content(Loop, Max)
+    ; true
+    ),
+    ( current_fact(workers(N)) -> true ; N = 4 ),
+    retractall_fact(job(_)),
+    retractall_fact(response(_, _, _)),
+    start_http_workers(N, Loop, Workers),
+    catch(evloop_serve(Loop, N),
          err_shutdown(Code),
-         ExitCode=Code).
-
-% TODO: I need to handle 'connection reset by peer'
-% TODO: Why is loop needed? Maybe due to interrupts
-serve_socket_loop(Socket) :-
-    ( serve_socket(Socket, socket_serve, catcher) ->
-        true
-    ; log(note, serve_socket_loop), % try again!
-      serve_socket_loop(Socket)
+         ExitCode=Code),
+    stop_http_workers(Workers),
+    retractall_fact(response(_, _, _)),
+    socket_evloop_close(Loop, Streams),
+    close_streams(Streams).
+
+% (failure-driven, to reclaim memory between events)
+evloop_serve(Loop, Workers) :-
+    repeat,
+      socket_evloop_wait(Loop, off, Events),
+      evloop_events(Events, Loop, Workers),
+      evloop_responses(Loop),
+      fail.
+
+evloop_events([], _Loop, _Workers).
+evloop_events([Event|Events], Loop, Workers) :-
+    evloop_event(Event, Loop, Workers),
+    evloop_events(Events, Loop, Workers).
+
+evloop_event(closed(Stream), Loop, _Workers) :-
+    socket_evloop_release(Loop, Stream),
+    close(Stream).
+evloop_event(rejected(Stream, Code), Loop, _Workers) :-
+    log(error, rejected_request(Code)),
+    rejected_status(Code, Status),
+    Status = status(_,_,Reason),
+    expand_response(html_string(Status, Reason), Response, Data),
+    append(Response, [connection("close")], Response2),
+    response_parts(Response2, Data, Parts),
+    evloop_send(Loop, Stream, Parts, false).
+evloop_event(request(Stream, RequestBytes, Content, KeepAlive0), Loop, Workers) :-
+    Job = request(Stream, RequestBytes, Content, KeepAlive0),
+    ( Workers > 0 ->
+        assertz_fact(job(Job))
+    ; serve_job(Job, Parts, KeepAlive, Error),
+      evloop_send(Loop, Stream, Parts, KeepAlive),
+      ( nonvar(Error) -> catcher(Error) ; true )
+    ).
+
+% Send the responses prepared by the workers
+evloop_responses(Loop) :-
+    ( retract_fact_nb(response(Stream, Parts, KeepAlive)) ->
+        evloop_send(Loop, Stream, Parts, KeepAlive),
+        evloop_responses(Loop)
+    ; true
+    ).
+
+evloop_send(Loop, Stream, Parts, KeepAlive) :-
+    catch(socket_evloop_send(Loop, Stream, Parts, KeepAlive), E,
+          ( log(error, E),
+            socket_evloop_send(Loop, Stream, [], false) )),
+    check_shutdown.
+
+% Parts of the response to a request (for socket_evloop_send/4),
+% whether the connection is kept alive, and the exception raised
+% while handling it (if any)
+serve_job(request(Stream, RequestBytes, Content, KeepAlive0), Parts, KeepAlive, Error) :-
+    catch(evloop_request(Stream, RequestBytes, Content, KeepAlive0, Parts, KeepAlive),
+          E, (Parts = [], KeepAlive = false, Error = E)).
+
+evloop_request(Stream, RequestBytes, Content, KeepAlive0, Parts, KeepAlive) :-
+    ( http_parse_request(Stream, RequestBytes, Content, Request) ->
+        ( http_serve(Stream, Request, Response) ->
+            expand_response(Response, Response2, Data),
+            ( KeepAlive0 = true, keep_alive_response(Response2, Data) ->
+                KeepAlive = true,
+                append(Response2, [connection("keep-alive")], Response3)
+            ; KeepAlive = false,
+              Response3 = Response2
+            ),
+            response_parts(Response3, Data, Parts)
+        ; KeepAlive = false,
+          Parts = [],
+          log(error, failed(http_serve_fetch/2, Request))
+        )
+    ; KeepAlive = false,
+      Parts = []
     ).
 
-:- data shutdown/1.
+response_parts(Response, Content, [ResponseBytes|Parts]) :-
+    http_response_str(Response, ResponseBytes, []),
+    content_parts(Content, Parts).
+
+content_parts(none, []).
+content_parts(bytelist(Bytes), [Bytes]).
+content_parts(file(Path, Offset, Length), [file(Path, Offset, Length)]).
+
+% ---------------------------------------------------------------------------
+% Worker threads
+
+:- use_module(library(concurrency), [eng_call/4, eng_wait/1, eng_release/1]).
+
+% Requests to be handled by the workers (or stop)
+:- concurrent job/1.
+% Responses to be sent by the event loop
+:- concurrent response/3.
+
+start_http_workers(N, _Loop, []) :- N =< 0, !.
+start_http_workers(N, Loop, [Id|Ids]) :-
+    eng_call(http_worker(Loop), create, create, Id),
+    N1 is N - 1,
+    start_http_workers(N1, Loop, Ids).
+
+% (blocks on job/1 until there is some job)
+http_worker(Loop) :-
+    repeat,
+      retract_fact(job(Job)),
+      ( Job = stop -> !
+      ; Job = request(Stream, _, _, _),
+        serve_job(Job, Parts, KeepAlive, Error),
+        ( nonvar(Error) -> worker_error(Error) ; true ),
+        assertz_fact(response(Stream, Parts, KeepAlive)),
+        socket_evloop_wake(Loop),
+        fail
+      ).
+
+worker_error(err_shutdown(Code)) :- !,
+    http_shutdown(Code).
+worker_error(Error) :-
+    log(error, Error).
+
+% (pending requests are dropped, their connections are closed with
+% the event loop)
+stop_http_workers(Workers) :-
+    retractall_fact(job(_)),
+    ( member(_, Workers), assertz_fact(job(stop)), fail ; true ),
+    ( member(Id, Workers), eng_wait(Id), eng_release(Id), fail ; true ).
+
+:- data workers/1.
+
+:- export(http_workers/1).
+:- pred http_workers(N) # "Requests read by @pred{http_loop/1} (or
+   @pred{http_prefork_loop/2}) are handled by @var{N} worker threads
+   (4 by default). If @var{N} is 0 they are handled by the event loop
+   itself, one at a time.".
+
+http_workers(N) :-
+    retractall_fact(workers(_)),
+    assertz_fact(workers(N)).
+
+rejected_status(400, status(request_error,400,"Bad Request")).
+rejected_status(413, status(request_error,413,"Content Too Large")).
+rejected_status(431, status(request_error,431,"Request Header Fields Too Large")).
+rejected_status(501, status(server_error,501,"Not Implemented")).
+
+:- data max_content/1.
+
+:- export(http_max_content/1).
+:- pred http_max_content(Bytes) # "Requests handled by
+   @pred{http_loop/1} (or @pred{http_prefork_loop/2}) with content
+   longer than @var{Bytes} are rejected with status 413 (see
+   @pred{socket_evloop_max_content/2}, by default 16MB).".
+
+http_max_content(Bytes) :-
+    retractall_fact(max_content(_)),
+    assertz_fact(max_content(Bytes)).
+
+close_streams([]).
+close_streams([S|Ss]) :-
+    close(S),
+    close_streams(Ss).
+
+% (asserted by worker threads)
+:- concurrent shutdown/1.
 
 :- export(http_shutdown/1).
 :- pred http_shutdown(ExitCode) # "@var{ExitCode} mark that we are not
@@ -340,13 +577,12 @@ serve_socket_loop(Socket) :-
 http_shutdown(ExitCode) :-
     assertz_fact(shutdown(ExitCode)).
 
-socket_serve(Stream, yes) :-
-    % TODO: Are Stream objects here leaking? (see C code)
-    http_serve_fetch(Stream,http_serve(Stream)), % Note: http_serve_fetch/1 closes Stream
-    ( current_fact(shutdown(Code)) ->
+check_shutdown :-
+    ( current_fact_nb(shutdown(Code)) ->
         throw(err_shutdown(Code)) % TODO: better way?
     ; true
-    ).
+    ),
+    check_retire.
 
 http_serve(_Stream, Request, Response) :-
     log(note, received_message(Request)),
@@ -370,6 +606,8 @@ handle_(File0, Request, Response) :-
     ( locate_file(File, LocalFile) ->
         ( member(if_modified_since(OldModifDate), Request) ->
             Response = file_if_newer(OldModifDate, LocalFile)
+        ; member(range([Range]), Request) -> % (only single ranges)
+            Response = file_range(Range, LocalFile)
         ; Response = file(LocalFile)
         )
     ; % log(error, not_found(File)),
@@ -536,3 +774,162 @@ log_response(Request, Response) :-
     ; true
     ),
     nl.
+
+% ===========================================================================
+:- doc(section, "Prefork server").
+
+:- use_module(library(process), [process_fork/2, process_pid/2]).
+:- use_module(library(system), [wait_any/2, wait/2, kill/2, pause/1]).
+:- use_module(engine(runtime_control), [statistics/2]).
+
+:- export(http_prefork_loop/2).
+:- pred http_prefork_loop(Opts, ExitCode)
+   # "Like @pred{http_loop/1}, but requests are handled by a pool of
+      worker processes forked from the current one (which must have
+      called @pred{http_bind/1}). Workers are copy-on-write clones of
+      the already loaded and initialized program, so they start
+      immediately, and memory leaked while handling requests (e.g.,
+      in the dynamic database or the atom table) is reclaimed when
+      they are recycled. The current process only supervises the
+      pool: a worker that terminates (or crashes) is replaced by a
+      new one. Workers that crash repeatedly (less than 10 seconds
+      after they were started) are replaced after an increasing
+      delay (none after the first crash, then 1, 2, 4, ... seconds,
+      up to 32), so that a persistent
+      failure does not make the supervisor fork in a loop. The
+      options in @var{Opts} are:
+
+      @begin{itemize}
+      @item @tt{workers(N)}: number of workers (default 4).
+      @item @tt{max_requests(N)}: recycle a worker after it has
+        handled @var{N} requests (default 0, no limit).
+      @item @tt{max_memory(Bytes)}: recycle a worker when its memory
+        usage (see @tt{statistics(memory, _)}) exceeds @var{Bytes}
+        (default 0, no limit).
+      @end{itemize}
+
+      A call to @pred{http_shutdown/1} in a worker stops all the
+      workers and @var{ExitCode} is unified with its argument (which
+      must be an integer between 0 and 63).".
+
+http_prefork_loop(Opts, ExitCode) :-
+    prefork_opt(workers(N), Opts, 4),
+    prefork_opt(max_requests(MaxReqs), Opts, 0),
+    prefork_opt(max_memory(MaxMem), Opts, 0),
+    retractall_fact(prefork_worker(_, _)),
+    retractall_fact(prefork_crashes(_)),
+    assertz_fact(prefork_crashes(0)),
+    spawn_workers(N, MaxReqs, MaxMem),
+    supervise_workers(MaxReqs, MaxMem, ExitCode).
+
+prefork_opt(Opt, Opts, Default) :-
+    ( member(Opt, Opts) -> true
+    ; arg(1, Opt, Default)
+    ).
+
+% Pids of live workers and their start time in ms (in the supervisor)
+:- data prefork_worker/2.
+% Number of consecutive crashes of workers (in the supervisor)
+:- data prefork_crashes/1.
+
+spawn_workers(N, _MaxReqs, _MaxMem) :- N =< 0, !.
+spawn_workers(N, MaxReqs, MaxMem) :-
+    spawn_worker(MaxReqs, MaxMem),
+    N1 is N - 1,
+    spawn_workers(N1, MaxReqs, MaxMem).
+
+spawn_worker(MaxReqs, MaxMem) :-
+    process_fork(prefork_worker_main(MaxReqs, MaxMem), [background(P)]),
+    process_pid(P, Pid),
+    statistics(walltime, [Start, _]),
+    assertz_fact(prefork_worker(Pid, Start)).
+
+% Exit status of workers: 0 when retired, 64+Code on http_shutdown(Code)
+prefork_worker_main(MaxReqs, MaxMem) :-
+    assertz_fact(retire_limits(MaxReqs, MaxMem)),
+    assertz_fact(served(0)),
+    http_loop(Code),
+    ( Code == retire -> Status = 0
+    ; integer(Code), Code >= 0, Code < 64 -> Status is 64 + Code
+    ; Status = 65
+    ),
+    halt(Status).
+
+supervise_workers(MaxReqs, MaxMem, ExitCode) :-
+    ( wait_any(Pid, Status) ->
+        ( retract_fact(prefork_worker(Pid, Start)) ->
+            ( Status >= 64, Status < 128 ->
+                ExitCode is Status - 64,
+                stop_workers
+            ; ( Status =:= 0 ->
+                  set_prefork_crashes(0)
+              ; log(error, worker_crashed(Pid, Status)),
+                respawn_backoff(Start)
+              ),
+              spawn_worker(MaxReqs, MaxMem),
+              supervise_workers(MaxReqs, MaxMem, ExitCode)
+            )
+        ; supervise_workers(MaxReqs, MaxMem, ExitCode) % (not a worker)
+        )
+    ; ExitCode = 0 % (no children left)
+    ).
+
+% Wait before replacing a worker (started at Start) that crashed,
+% longer after each consecutive crash
+respawn_backoff(Start) :-
+    statistics(walltime, [Now, _]),
+    ( Now - Start >= 10000 -> % (it was working for a while)
+        Crashes = 1
+    ; current_fact(prefork_crashes(Crashes0)),
+      Crashes is Crashes0 + 1
+    ),
+    set_prefork_crashes(Crashes),
+    respawn_delay(Crashes, Delay),
+    ( Delay > 0 ->
+        log(error, respawn_delayed(Delay)),
+        pause(Delay)
+    ; true
+    ).
+
+% Seconds to wait after the N-th consecutive crash (none after the
+% first one)
+respawn_delay(N, Delay) :-
+    ( N =< 1 -> Delay = 0
+    ; N >= 7 -> Delay = 32
+    ; Delay is 1 << (N - 2)
+    ).
+
+set_prefork_crashes(N) :-
+    retractall_fact(prefork_crashes(_)),
+    assertz_fact(prefork_crashes(N)).
+
+stop_workers :-
+    ( prefork_worker(Pid, _),
+        kill(Pid, 15), % SIGTERM=15
+        fail
+    ; true
+    ),
+    ( retract_fact(prefork_worker(Pid, _)),
+        ( wait(Pid, _) -> true ; true ),
+        fail
+    ; true
+    ).
+
+% Limits for recycling the current worker (only in workers)
+:- data retire_limits/2.
+% Number of requests handled by the current worker
+:- data served/1.
+
+check_retire :-
+    ( current_fact(retire_limits(MaxReqs, MaxMem)) ->
+        retract_fact(served(N0)),
+        N is N0 + 1,
+        assertz_fact(served(N)),
+        ( MaxReqs > 0, N >= MaxReqs ->
+            throw(err_shutdown(retire))
+        ; MaxMem > 0, statistics(memory, [Used, _]), Used > MaxMem ->
+            throw(err_shutdown(retire))
+        ; true
+        )
+    ; true
+    ).
@@ -0,0 +1,106 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for http_server.pl").
+
+:- doc(module, "Runs a prefork server (see @pred{http_prefork_loop/2})
+   in a forked process, and makes its worker crash on purpose to check
+   that it is replaced, with a delay after consecutive crashes. Also
+   checks that slow handlers run concurrently in the worker threads
+   of @pred{http_loop/1}.").
+
+:- use_module(library(http/http_server)).
+:- use_module(library(sockets)).
+:- use_module(library(process), [process_fork/2, process_join/1]).
+:- use_module(library(lists), [append/3]).
+:- use_module(engine(runtime_control), [statistics/2]).
+:- use_module(library(system), [pause/1]).
+:- use_module(engine(stream_basic)).
+
+:- include(library(http/http_server_hooks)).
+
+'httpserv.handle'("/crash", _Request, _Response) :-
+    halt(3).
+'httpserv.handle'("/ok", _Request, html_string("ok")).
+'httpserv.handle'("/slow", _Request, html_string("slow")) :-
+    pause(1).
+'httpserv.handle'("/shutdown", _Request, html_string("bye")) :-
+    http_shutdown(0).
+
+:- export(respawn_backoff/0).
+:- test respawn_backoff # "Workers that crash repeatedly are
+   replaced after a delay".
+
+respawn_backoff :-
+    http_bind(Port),
+    process_fork(http_prefork_loop([workers(1)], _),
+                 [background(P), stdout(null)]),
+    ( catch(check_backoff(Port), _, fail) -> Ok = yes ; Ok = no ),
+    get(Port, "/shutdown", _),
+    process_join(P),
+    Ok = yes.
+
+:- export(concurrent_handlers/0).
+:- test concurrent_handlers # "Requests are handled concurrently by
+   the worker threads".
+
+concurrent_handlers :-
+    http_bind(Port),
+    http_workers(2),
+    process_fork(http_loop(_), [background(P), stdout(null)]),
+    ( catch(check_concurrent(Port), _, fail) -> Ok = yes ; Ok = no ),
+    get(Port, "/shutdown", _),
+    process_join(P),
+    Ok = yes.
+
+% (two slow requests take less than twice as long as one)
+check_concurrent(Port) :-
+    get(Port, "/ok", R0), answered(R0),
+    statistics(walltime, [T0, _]),
+    send_get(Port, "/slow", S1),
+    send_get(Port, "/slow", S2),
+    recv_all(S1, R1), close(S1), answered(R1),
+    recv_all(S2, R2), close(S2), answered(R2),
+    statistics(walltime, [T1, _]),
+    T1 - T0 < 1900.
+
+check_backoff(Port) :-
+    get(Port, "/ok", R0), answered(R0),
+    % (replaced at once after the first crash)
+    get(Port, "/crash", []),
+    get(Port, "/ok", R1), answered(R1),
+    % (1 second after the second one, 2 after the third one)
+    get(Port, "/crash", []),
+    timed_get(Port, "/ok", R2, T2), answered(R2),
+    T2 >= 900,
+    get(Port, "/crash", []),
+    timed_get(Port, "/ok", R3, T3), answered(R3),
+    T3 >= 1900.
+
+answered(Response) :-
+    append("HTTP/1.", _, Response).
+
+timed_get(Port, Path, Response, Ms) :-
+    statistics(walltime, [T0, _]),
+    get(Port, Path, Response),
+    statistics(walltime, [T1, _]),
+    Ms is T1 - T0.
+
+% Response (a list of bytes, empty if the connection was closed
+% without an answer) of a GET request for Path
+get(Port, Path, Response) :-
+    send_get(Port, Path, S),
+    recv_all(S, Response),
+    close(S).
+
+send_get(Port, Path, S) :-
+    connect_to_socket(localhost, Port, S),
+    append("GET ", Path, R0),
+    append(R0, " HTTP/1.0\r\n\r\n", Request),
+    socket_sendall(S, Request).
+
+recv_all(S, Bytes) :-
+    socket_recv(S, Chunk, Len),
+    ( Len =:= 0 -> Bytes = []
+    ; append(Chunk, Bytes1, Bytes),
+      recv_all(S, Bytes1)
+    ).
@@ -0,0 +1,8 @@
+:- package(jit).
+
+:- use_module(library(jit/jit_rt)).
+
+:- multifile '$jit_src'/3.
+
+:- load_compilation_module(library(jit/jit_tr)).
+:- add_sentence_trans(jit_tr:sentence_tr/3, 8410).
@@ -0,0 +1,112 @@
+:- module(_, [], [assertions, nativeprops, jit]).
+
+:- doc(title, "Tests for the jit package").
+
+:- doc(module, "Compiles some predicates of this module to native code
+   and checks that they give the same results as their bytecode,
+   including calls where the native code must go back to bytecode.").
+
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(between), [between/3]).
+
+% (predicates to compile)
+
+fib(0, 0).
+fib(1, 1).
+fib(N, F) :- N > 1, N1 is N-1, N2 is N-2, fib(N1, F1), fib(N2, F2), F is F1+F2.
+
+nrev([], []).
+nrev([H|T], R) :- nrev(T, RT), app(RT, [H], R).
+
+app([], L, L).
+app([H|T], L, [H|R]) :- app(T, L, R).
+
+len(L, N) :- len_(L, 0, N).
+
+len_([], N, N).
+len_([_|T], N0, N) :- N1 is N0+1, len_(T, N1, N).
+
+count(0, Acc) :- !, Acc = done.
+count(N, Acc) :- N1 is N-1, count(N1, Acc).
+
+sum_tree(leaf, 0).
+sum_tree(node(L, X, R), S) :- sum_tree(L, SL), sum_tree(R, SR), S is SL+X+SR.
+
+% (not deterministic, stays in bytecode)
+member_(X, [X|_]).
+member_(X, [_|Xs]) :- member_(X, Xs).
+
+:- export(compiled/0).
+:- test compiled # "Native code gives the same results".
+
+compiled :-
+    jit_set_threshold(0),
+    jit_compile(nrev/2),
+    jit_compile(fib/2),
+    jit_compile(len/2),
+    jit_compile(count/2),
+    jit_compile(sum_tree/2),
+    \+ jit_compile(member_/2),
+    jit_native(app/3),
+    jit_native(len_/3),
+    \+ jit_native(member_/2),
+    fib(21, 10946),
+    \+ fib(5, 6),
+    nrev([1, 2, f(x), a], [a, f(x), 2, 1]),
+    findall(X-Y, app(X, Y, [1, 2]), [[]-[1, 2], [1]-[2], [1, 2]-[]]),
+    app([A], [2], [B, B]), A == 2,
+    \+ app([1], [2], [1, 3]),
+    len([a, b, c], 3),
+    \+ len([a, b, c], 4),
+    count(100000, done),
+    sum_tree(node(node(leaf, 1, leaf), 2, node(leaf, 3, leaf)), 6),
+    \+ sum_tree(node(leaf, 1, foo), _),
+    jit_native(fib/2).
+
+:- export(bail/0).
+:- test bail # "Back to bytecode on calls that native code cannot complete".
+
+bail :-
+    jit_set_threshold(0),
+    jit_compile(fib/2),
+    jit_compile(nrev/2),
+    jit_compile(len/2),
+    jit_compile(count/2),
+    % (bignums)
+    len_([a], 1152921504606846975, 1152921504606846976),
+    len_([a, b], 134217727, 134217729),
+    % (floats)
+    \+ fib(3.0, _),
+    % (unbound arguments at the positions that select the clause)
+    count(_, done),
+    % (these have more solutions, in bytecode)
+    ( nrev(L, [1]) -> L == [1] ),
+    ( nrev([X, Y|Z], [1, 2]) -> X-Y-Z == 2-1-[] ),
+    % (errors are raised by the bytecode)
+    catch(len_([a], foo, _), error(type_error(_, _), _), true),
+    jit_native(fib/2).
+
+:- export(deoptimize/0).
+:- test deoptimize # "Going back to bytecode for a unit".
+
+deoptimize :-
+    jit_set_threshold(0),
+    jit_compile(nrev/2),
+    jit_native(app/3),
+    jit_deoptimize(app/3),
+    \+ jit_native(nrev/2),
+    \+ jit_native(app/3),
+    nrev([1, 2, 3], [3, 2, 1]).
+
+:- export(hot/0).
+:- test hot # "Predicates are compiled after the threshold".
+
+hot :-
+    jit_set_threshold(0),
+    jit_deoptimize(fib/2),
+    jit_set_threshold(100),
+    \+ jit_native(fib/2),
+    ( between(1, 10, _), fib(10, _), fail ; true ),
+    jit_set_threshold(0),
+    jit_native(fib/2),
+    fib(20, 6765).
@@ -0,0 +1,127 @@
+:- module(jit_aot, [make_native/1], [assertions, isomodes]).
+
+:- doc(title, "AOT for jit modules").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module compiles the predicates of modules that
+   use the @lib{jit} package to native code before they are run (see
+   the @tt{--native} option of @apl{ciaoc}). The C code is the same
+   that @lib{jit/jit_rt} would build for hot predicates (see
+   @lib{jit/jit_c}), for all the predicates of the module that can be
+   translated. It is compiled to the shared object that holds the
+   foreign code of the module, so that it is loaded with the module,
+   also by static executables, and no C compiler is needed to run it.
+
+   The native code is installed when the module is initialized, unless
+   its source has changed since it was compiled (then the module runs
+   from bytecode, with a warning). Modules with a foreign interface
+   (which already have their own shared object) cannot be compiled
+   this way.").
+
+:- doc(bug, "This is not a translation of WAM code to C: the native
+   code is built from the source clauses by @lib{jit/jit_c}, with the
+   same limits (deterministic code on small integers, atoms and
+   structures, bailing out to bytecode otherwise). Emitting C for each
+   WAM instruction of the compiled clauses, from the instruction
+   definitions in @tt{absmach_def.pl}, is not implemented.").
+
+:- use_module(engine(internals), [find_pl_filename/4, so_filename/2, product_filename/3]).
+:- use_module(engine(stream_basic)).
+:- use_module(library(compiler), [use_module/1]).
+:- use_module(library(compiler/c_itf), [module_from_base/2]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1, file_exists/1]).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(engine(messages_basic), [message/2]).
+:- use_module(library(jit/jit_c)).
+:- use_module(library(jit/jit_rt), ['$jit_build'/3]).
+
+:- multifile '$jit_src'/3.
+
+:- pred make_native(+Files) : list(atm) # "Compile the modules
+   @var{Files} (which must use the @lib{jit} package) to native code.
+   Fails if some of them could not be compiled.".
+
+make_native(Files) :-
+    make_native_(Files, ok, Status),
+    Status = ok.
+
+make_native_([], Status, Status).
+make_native_([File|Files], Status0, Status) :-
+    ( native_module(File) -> Status1 = Status0 ; Status1 = error ),
+    make_native_(Files, Status1, Status).
+
+native_module(File) :-
+    find_pl_filename(File, _, Base, _),
+    so_filename(Base, SoName),
+    product_filename(gluecode_c, Base, GlueName),
+    ( file_exists(GlueName) ->
+        native_error(File, 'it has a foreign interface')
+    ; true
+    ),
+    % (an old one would be loaded with the module)
+    ( file_exists(SoName) -> delete_file(SoName) ; true ),
+    use_module(File),
+    module_from_base(Base, M),
+    ( file_exists(GlueName) ->
+        native_error(File, 'it has a foreign interface')
+    ; \+ '$jit_src'(M, _, _) ->
+        native_error(File, 'it does not use the jit package')
+    ; \+ c_identifier(M) ->
+        native_error(File, 'its name is not a C identifier')
+    ; true
+    ),
+    findall(F/A-Cs, '$jit_src'(M, F/A, Cs), Src),
+    jit_eligible(Src, Preds),
+    findall(F/A, member_(p(F, A, _, _, _), Preds), Roots),
+    jit_closure(Preds, Roots, Unit),
+    jit_src_stamp(Src, Stamp),
+    atom_concat(M, '_jit', Prefix),
+    mktemp_in_tmp('ciaojitXXXXXX', TmpBase),
+    atom_concat(TmpBase, '.c', CFile),
+    atom_concat(TmpBase, '.o', OFile),
+    ( catch(build_native(M, Unit, Prefix, Stamp, CFile, OFile, SoName), _, fail) ->
+        Ok = yes
+    ; Ok = no
+    ),
+    delete_files([TmpBase, CFile, OFile]),
+    ( Ok = yes -> true
+    ; delete_files([SoName]),
+      native_error(File, 'the C code could not be compiled')
+    ).
+
+build_native(M, Unit, Prefix, Stamp, CFile, OFile, SoName) :-
+    open(CFile, write, S),
+    jit_write_c(S, Prefix, M, Unit, Entries),
+    jit_write_dynlink(S, Prefix, M, Stamp, Entries),
+    close(S),
+    '$jit_build'(CFile, OFile, SoName).
+
+native_error(File, Why) :-
+    message(error, ['Cannot compile ', File, ' to native code: ', Why]),
+    fail.
+
+% (the init function of the shared object is M_init)
+c_identifier(M) :-
+    atom_codes(M, [C|Cs]),
+    \+ digit(C),
+    c_idchars([C|Cs]).
+
+c_idchars([]).
+c_idchars([C|Cs]) :-
+    ( C >= 0'a, C =< 0'z -> true
+    ; C >= 0'A, C =< 0'Z -> true
+    ; digit(C) -> true
+    ; C =:= 0'_
+    ),
+    c_idchars(Cs).
+
+digit(C) :- C >= 0'0, C =< 0'9.
+
+member_(X, [X|_]).
+member_(X, [_|Xs]) :- member_(X, Xs).
+
+delete_files([]).
+delete_files([F|Fs]) :-
+    ( file_exists(F) -> delete_file(F) ; true ),
+    delete_files(Fs).
@@ -0,0 +1,65 @@
+:- module(_, [], [assertions, nativeprops, hiord]).
+
+:- doc(title, "Tests for jit_aot.pl").
+
+:- doc(module, "Compiles a small module in a temporary directory to
+   native code ahead of time, then checks that its shared object is
+   used when the module is loaded, and not once its source has
+   changed.").
+
+:- use_module(library(jit/jit_aot)).
+:- use_module(library(jit/jit_rt), [jit_set_threshold/1, '$jit_register'/1]).
+:- use_module(library(compiler), [use_module/1]).
+:- use_module(engine(internals), [load_so/2]).
+:- use_module(library(terms_io), [terms_to_file/2]).
+:- use_module(library(source_tree), [remove_dir/1]).
+:- use_module(library(pathnames), [path_concat/3]).
+:- use_module(library(system), [
+    mktemp_in_tmp/2, delete_file/1, make_directory/1, pause/1]).
+
+:- export(native/0).
+:- test native # "Native code compiled ahead of time".
+
+native :-
+    mktemp_in_tmp('jitaotXXXXXX', Dir),
+    delete_file(Dir),
+    make_directory(Dir),
+    path_concat(Dir, jit_aot_ex, Base),
+    write_module(Dir, 0),
+    ( check_native(Dir, Base) -> Ok = yes ; Ok = no ),
+    remove_dir(Dir),
+    Ok = yes.
+
+check_native(Dir, Base) :-
+    M = jit_aot_ex, % (not imported here)
+    jit_set_threshold(0),
+    make_native([Base]),
+    % (make_native/1 loads the module before its shared object exists)
+    use_module(Base),
+    \+ call(M:native),
+    load_so(jit_aot_ex, Base),
+    '$jit_register'(jit_aot_ex),
+    call(M:native),
+    call(M:fib(21, 10946)),
+    call(M:nrev([1, 2, f(x)], [f(x), 2, 1])),
+    pause(1), % (modification times have a resolution of seconds)
+    % the source changed: back to bytecode
+    write_module(Dir, 1),
+    use_module(Base),
+    \+ call(M:native),
+    call(M:fib(21, 17711)).
+
+write_module(Dir, K) :-
+    path_concat(Dir, 'jit_aot_ex.pl', Path),
+    terms_to_file([
+        (:- module(jit_aot_ex, [native/0, fib/2, nrev/2], [jit])),
+        (native :- jit_native(fib/2), jit_native(app/3)),
+        fib(0, K),
+        fib(1, 1),
+        (fib(N, F) :- N > 1, N1 is N-1, N2 is N-2,
+                      fib(N1, F1), fib(N2, F2), F is F1+F2),
+        nrev([], []),
+        (nrev([H|T], R) :- nrev(T, RT), app(RT, [H], R)),
+        app([], L, L),
+        (app([H|T], L, [H|R]) :- app(T, L, R))
+    ], Path).
@@ -0,0 +1,1126 @@
+:- module(jit_c, [], [assertions, dcg, datafacts]).
+
+:- doc(title, "C code for deterministic predicates").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module translates a subset of Prolog predicates
+   to C functions for the engine (see @tt{eng_jit.h}). It is the back
+   end of @lib{jit}.
+
+   A predicate is given by its source clauses. It can be translated
+   if it is deterministic and each clause is made of:
+
+   @begin{itemize}
+   @item a head whose arguments are variables, atoms, small integers,
+     or structures of them;
+   @item guards: arithmetic comparisons, @tt{V is E} for a new
+     variable @tt{V}, type tests (@pred{integer/1}, @pred{atom/1},
+     @pred{atomic/1}, @pred{number/1}, @pred{var/1},
+     @pred{nonvar/1}), and @pred{==/2} or @pred{\\==/2} with an
+     atom or a small integer;
+   @item an optional cut after the guards;
+   @item a body with those goals, @pred{is/2}, @pred{=/2},
+     @pred{true/0}, @pred{fail/0}, and calls to predicates of the
+     same module that can be translated.
+   @end{itemize}
+
+   Arithmetic is limited to small integers with @tt{+ - * // mod rem
+   abs sign min max >> << /\\ \\/ # \\}. The predicate is
+   deterministic when each clause (but the last) has a cut after its
+   guards or cannot match together with any of the clauses after it:
+   their arguments at some position have different principal
+   functors, a constant of one fails the guards of the other, or
+   their guards are complementary (e.g., @tt{X < Y} and
+   @tt{X >= Y}).
+
+   Head unification does not bind anything until the clause is
+   selected: arguments are tested first (and bound later if they are
+   unbound variables), then the guards run. The generated code bails
+   out (returns @tt{JIT_BAIL}) whenever it cannot go on with the same
+   results as the bytecode: arithmetic on other numbers, errors,
+   unbound arguments at the positions that select the clause, etc.").
+
+:- use_module(library(lists), [member/2, append/3, length/2, nth/3, reverse/2]).
+:- use_module(library(sort), [sort/2]).
+:- use_module(library(format), [format/3]).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(iso_misc), [compound/1]).
+:- use_module(engine(io_basic), [nl/1, put_code/2]).
+:- use_module(engine(internals), [module_concat/3]).
+:- use_module(library(write), [numbervars/3]).
+:- use_module(library(digest), [digest_init/2, digest_update/3, digest_final/2]).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Analysis").
+
+:- export(jit_eligible/2).
+:- pred jit_eligible(+Src, -Preds) # "@var{Preds} are the predicates of
+   @var{Src} (a list of @tt{F/A-Clauses}, with clauses as @tt{(H :-
+   B)}) that can be translated, analyzed, including only those whose
+   calls stay in @var{Preds}.".
+
+jit_eligible(Src, Preds) :-
+    src_keys(Src, Keys),
+    norm_preds(Src, Keys, Preds0),
+    prune(Preds0, Preds).
+
+src_keys([], []).
+src_keys([FA-_|Src], [FA|Keys]) :- src_keys(Src, Keys).
+
+norm_preds([], _, []).
+norm_preds([F/A-Cs|Src], Keys, Ps) :-
+    ( norm_pred(F, A, Cs, Keys, P) -> Ps = [P|Ps0] ; Ps = Ps0 ),
+    norm_preds(Src, Keys, Ps0).
+
+% Remove the predicates that call removed predicates
+prune(Ps0, Ps) :-
+    pred_keys(Ps0, Ks),
+    prune_(Ps0, Ks, Ps1),
+    length(Ps0, N0),
+    length(Ps1, N1),
+    ( N0 =:= N1 -> Ps = Ps1 ; prune(Ps1, Ps) ).
+
+prune_([], _, []).
+prune_([P|Ps0], Ks, Ps) :-
+    P = p(_, _, _, _, Calls),
+    ( all_member(Calls, Ks) -> Ps = [P|Ps1] ; Ps = Ps1 ),
+    prune_(Ps0, Ks, Ps1).
+
+pred_keys([], []).
+pred_keys([p(F, A, _, _, _)|Ps], [F/A|Ks]) :- pred_keys(Ps, Ks).
+
+all_member([], _).
+all_member([X|Xs], Ys) :- member(X, Ys), !, all_member(Xs, Ys).
+
+:- export(jit_closure/3).
+:- pred jit_closure(+Preds, +Roots, -Unit) # "@var{Unit} are the
+   predicates of @var{Preds} that are reachable from the predicates
+   @var{Roots} (a list of @tt{F/A}).".
+
+jit_closure(Ps, Roots, Unit) :-
+    closure_(Roots, Ps, [], Unit0),
+    reverse(Unit0, Unit).
+
+closure_([], _, Unit, Unit).
+closure_([F/A|FAs], Ps, Unit0, Unit) :-
+    ( member(p(F, A, _, _, _), Unit0) ->
+        closure_(FAs, Ps, Unit0, Unit)
+    ; member(P, Ps), P = p(F, A, _, _, Calls) ->
+        append(FAs, Calls, FAs1),
+        closure_(FAs1, Ps, [P|Unit0], Unit)
+    ; closure_(FAs, Ps, Unit0, Unit)
+    ).
+
+% p(F, A, Clauses, Disc, Calls): Clauses are
+% cl(K, Args, Guards, Cut, Body, Fail), with variables replaced by
+% '$jit_v'(K, N) (N-th variable of the K-th clause); Disc are the
+% argument positions that select clauses (they must not be unbound);
+% Fail is the result when a binding after selecting the clause fails.
+
+norm_pred(F, A, Cs, Keys, p(F, A, Cls, Disc, Calls)) :-
+    Cs = [_|_],
+    norm_clauses(Cs, 1, Keys, Cls),
+    det_clauses(Cls, Disc0),
+    sort(Disc0, Disc),
+    clause_calls(Cls, Keys, Calls0),
+    sort(Calls0, Calls).
+
+norm_clauses([], _, _, []).
+norm_clauses([C|Cs], K, Keys, [Cl|Cls]) :-
+    norm_clause(C, K, Keys, Cl),
+    K1 is K+1,
+    norm_clauses(Cs, K1, Keys, Cls).
+
+norm_clause(C, K, Keys, cl(K, Args, Gs, Cut, Body, _Fail)) :-
+    copy_term(C, (H :- B)),
+    conj_list(B, Goals),
+    bind_vars(H-Goals, K, 0, _),
+    H =.. [_|Args],
+    terms_ok(Args),
+    markers(Args, Kn0, []),
+    guards(Goals, Keys, Kn0, Gs, Kn, Rest),
+    ( Rest = [!|Body] -> Cut = yes ; Rest = Body, Cut = no ),
+    body_ok(Body, Keys, Kn).
+
+conj_list(G, _) :- var(G), !, fail.
+conj_list((A, B), Gs) :- !,
+    conj_list(A, Gs0),
+    conj_list(B, Gs1),
+    append(Gs0, Gs1, Gs).
+conj_list(true, []) :- !.
+conj_list(G, [G]).
+
+bind_vars(T, K, N0, N) :- var(T), !,
+    T = '$jit_v'(K, N0),
+    N is N0+1.
+bind_vars(T, _, N0, N) :- atomic(T), !, N = N0.
+bind_vars(T, K, N0, N) :-
+    functor(T, _, Ar),
+    bind_args(1, Ar, T, K, N0, N).
+
+bind_args(I, Ar, _, _, N0, N) :- I > Ar, !, N = N0.
+bind_args(I, Ar, T, K, N0, N) :-
+    arg(I, T, X),
+    bind_vars(X, K, N0, N1),
+    I1 is I+1,
+    bind_args(I1, Ar, T, K, N1, N).
+
+marker(X) :- nonvar(X), X = '$jit_v'(_, _).
+
+% Variables of T (with repetitions)
+markers(T, Vs, Vs0) :- marker(T), !, Vs = [T|Vs0].
+markers(T, Vs, Vs0) :- atomic(T), !, Vs = Vs0.
+markers(T, Vs, Vs0) :-
+    T =.. [_|Xs],
+    markers_list(Xs, Vs, Vs0).
+
+markers_list([], Vs, Vs).
+markers_list([X|Xs], Vs, Vs0) :-
+    markers(X, Vs, Vs1),
+    markers_list(Xs, Vs1, Vs0).
+
+has_marker(T) :- markers(T, [_|_], []).
+
+% Atoms and integers that fit in small integers of any engine
+literal(X) :- atom(X), !.
+literal(X) :- integer(X), X >= -134217728, X < 134217728.
+
+% Terms that can be built or matched
+term_ok(X) :- marker(X), !.
+term_ok(X) :- literal(X), !.
+term_ok(X) :- compound(X),
+    X =.. [_|Xs],
+    terms_ok(Xs).
+
+terms_ok([]).
+terms_ok([X|Xs]) :- term_ok(X), terms_ok(Xs).
+
+known(V, Kn) :- member(W, Kn), W == V, !.
+
+% Goals that are not calls to predicates of the module
+inline(G, Keys) :-
+    functor(G, N, A),
+    \+ member(N/A, Keys).
+
+guards([G|Gs], Keys, Kn0, [G|Gs1], Kn, Rest) :-
+    inline(G, Keys),
+    guard(G, Kn0, Kn1), !,
+    guards(Gs, Keys, Kn1, Gs1, Kn, Rest).
+guards(Gs, _, Kn, [], Kn, Gs).
+
+guard(V is E, Kn0, [V|Kn0]) :- !,
+    marker(V), \+ known(V, Kn0),
+    expr_ok(E, Kn0).
+guard(G, Kn, Kn) :- test_ok(G, Kn).
+
+test_ok(G, Kn) :-
+    G =.. [Op, X, Y],
+    cmp_op(Op, _), !,
+    expr_ok(X, Kn),
+    expr_ok(Y, Kn).
+test_ok(G, Kn) :-
+    G =.. [T, X],
+    type_test(T, _), !,
+    marker(X), known(X, Kn).
+test_ok(G, Kn) :-
+    G =.. [Op, X, Y],
+    ( Op = (==) ; Op = (\==) ), !,
+    eq_args(X, Y, V, C),
+    marker(V), known(V, Kn), literal(C).
+
+eq_args(X, Y, X, Y) :- marker(X), !.
+eq_args(X, Y, Y, X).
+
+cmp_op(<, '<').
+cmp_op(>, '>').
+cmp_op(=<, '<=').
+cmp_op(>=, '>=').
+cmp_op(=:=, '==').
+cmp_op(=\=, '!=').
+
+type_test(integer, 'IsInteger').
+type_test(atom, 'TaggedIsATM').
+type_test(atomic, 'JIT_IS_ATOMIC').
+type_test(number, 'IsNumber').
+type_test(var, 'IsVar').
+type_test(nonvar, '!IsVar').
+
+expr_ok(X, Kn) :- marker(X), !, known(X, Kn).
+expr_ok(X, _) :- integer(X), !, literal(X).
+expr_ok(X, Kn) :- compound(X),
+    functor(X, N, A),
+    arith_op(N, A, _), !,
+    X =.. [_|Xs],
+    exprs_ok(Xs, Kn).
+
+exprs_ok([], _).
+exprs_ok([X|Xs], Kn) :- expr_ok(X, Kn), exprs_ok(Xs, Kn).
+
+arith_op(+, 2, 'JIT_ADD').
+arith_op(-, 2, 'JIT_SUB').
+arith_op(*, 2, 'JIT_MUL').
+arith_op(//, 2, 'JIT_IDIV').
+arith_op(mod, 2, 'JIT_MOD').
+arith_op(rem, 2, 'JIT_REM').
+arith_op(<<, 2, 'JIT_SHL').
+arith_op(>>, 2, 'JIT_SHR').
+arith_op(/\, 2, '&').
+arith_op(\/, 2, '|').
+arith_op(#, 2, '^').
+arith_op(min, 2, 'JIT_MIN').
+arith_op(max, 2, 'JIT_MAX').
+arith_op(-, 1, 'JIT_NEG').
+arith_op(+, 1, '').
+arith_op(\, 1, '~').
+arith_op(abs, 1, 'JIT_ABS').
+arith_op(sign, 1, 'JIT_SIGN').
+
+body_ok([], _, _).
+body_ok([G|Gs], Keys, Kn0) :-
+    body_goal(G, Keys, Kn0, Kn),
+    body_ok(Gs, Keys, Kn).
+
+body_goal(G, _, _, _) :- marker(G), !, fail.
+body_goal(G, Keys, Kn0, Kn) :-
+    functor(G, N, A),
+    member(N/A, Keys), !,
+    G =.. [_|Xs],
+    terms_ok(Xs),
+    markers_list(Xs, Kn, Kn0).
+body_goal(true, _, Kn, Kn) :- !.
+body_goal(fail, _, Kn, Kn) :- !.
+body_goal(V is E, _, Kn0, Kn) :- !,
+    ( marker(V) -> Kn = [V|Kn0] ; literal(V), Kn = Kn0 ),
+    expr_ok(E, Kn0).
+body_goal(X = Y, _, Kn0, Kn) :- !,
+    term_ok(X),
+    term_ok(Y),
+    markers_list([X, Y], Kn, Kn0).
+body_goal(G, _, Kn, Kn) :-
+    G \== !,
+    test_ok(G, Kn).
+
+clause_calls([], _, []).
+clause_calls([cl(_, _, _, _, Body, _)|Cls], Keys, Calls) :-
+    goal_calls(Body, Keys, Calls, Calls0),
+    clause_calls(Cls, Keys, Calls0).
+
+goal_calls([], _, Calls, Calls).
+goal_calls([G|Gs], Keys, Calls, Calls0) :-
+    functor(G, N, A),
+    ( member(N/A, Keys) -> Calls = [N/A|Calls1] ; Calls = Calls1 ),
+    goal_calls(Gs, Keys, Calls1, Calls0).
+
+% ---------------------------------------------------------------------------
+% Determinism
+
+det_clauses([], []).
+det_clauses([C|Cs], Disc) :-
+    C = cl(_, _, _, Cut, _, Fail),
+    ( Cs = [] ->
+        Fail = 'JIT_FAIL', D = []
+    ; Cut = yes ->
+        % (selected by the cut; only check what needs no selecting positions)
+        D = [],
+        ( excl_all(Cs, C, []) -> Fail = 'JIT_FAIL' ; Fail = 'JIT_BAIL' )
+    ; excl_all(Cs, C, D),
+      Fail = 'JIT_FAIL'
+    ),
+    det_clauses(Cs, Disc1),
+    append(D, Disc1, Disc).
+
+excl_all([], _, []).
+excl_all([J|Js], K, D) :-
+    excl(K, J, D0),
+    excl_all(Js, K, D1),
+    append(D0, D1, D).
+
+excl(K, J, []) :- guards_contra(K, J), !.
+excl(K, J, [I]) :- functor_differ(K, J, I), !.
+excl(K, J, [I]) :- const_guard(K, J, I), !.
+excl(K, J, [I]) :- const_guard(J, K, I), !.
+
+functor_differ(cl(_, As, _, _, _, _), cl(_, Bs, _, _, _, _), I) :-
+    nth(I, As, X),
+    nth(I, Bs, Y),
+    \+ marker(X), \+ marker(Y),
+    functor(X, N1, A1),
+    functor(Y, N2, A2),
+    \+ (N1 == N2, A1 == A2).
+
+% A constant of K at I fails a guard of J
+const_guard(cl(_, As, _, _, _, _), cl(_, Bs, Gs, _, _, _), I) :-
+    nth(I, As, C),
+    literal(C),
+    nth(I, Bs, V),
+    marker(V),
+    subst_is(Gs, Gs1),
+    subst(Gs1, V, C, Gs2),
+    member(G, Gs2),
+    \+ has_marker(G),
+    catch(ground_false(G), _, fail), !.
+
+ground_false(X < Y) :- \+ X < Y.
+ground_false(X > Y) :- \+ X > Y.
+ground_false(X =< Y) :- \+ X =< Y.
+ground_false(X >= Y) :- \+ X >= Y.
+ground_false(X =:= Y) :- \+ X =:= Y.
+ground_false(X =\= Y) :- \+ X =\= Y.
+ground_false(integer(X)) :- \+ integer(X).
+ground_false(atom(X)) :- \+ atom(X).
+ground_false(atomic(X)) :- \+ atomic(X).
+ground_false(number(X)) :- \+ number(X).
+ground_false(var(_)).
+ground_false(X == Y) :- X \== Y.
+ground_false(X \== Y) :- X == Y.
+
+% Complementary guards on the same arguments
+guards_contra(cl(_, As, Gs, _, _, _), cl(_, Bs, Hs, _, _, _)) :-
+    arg_names(As, 1, M1),
+    arg_names(Bs, 1, M2),
+    subst_is(Gs, Gs1),
+    subst_is(Hs, Hs1),
+    subst_map(M1, Gs1, Gs2),
+    subst_map(M2, Hs1, Hs2),
+    member(G, Gs2),
+    member(H, Hs2),
+    contra(G, H), !.
+
+arg_names([], _, []).
+arg_names([X|Xs], I, M) :-
+    ( marker(X) -> M = [X-'$jit_a'(I)|M0] ; M = M0 ),
+    I1 is I+1,
+    arg_names(Xs, I1, M0).
+
+subst_map([], T, T).
+subst_map([V-X|M], T0, T) :-
+    subst(T0, V, X, T1),
+    subst_map(M, T1, T).
+
+% Replace variables defined by V is E with E in the rest of the guards
+subst_is([], []).
+subst_is([G|Gs], Gs1) :-
+    ( G = (V is E), marker(V) ->
+        subst(Gs, V, E, Gs0),
+        subst_is(Gs0, Gs1)
+    ; Gs1 = [G|Gs2],
+      subst_is(Gs, Gs2)
+    ).
+
+subst(T, V, X, X) :- T == V, !.
+subst(T, _, _, T) :- atomic(T), !.
+subst(T, _, _, T) :- marker(T), !.
+subst(T, V, X, T1) :-
+    T =.. [N|As],
+    subst_list(As, V, X, As1),
+    T1 =.. [N|As1].
+
+subst_list([], _, _, []).
+subst_list([A|As], V, X, [A1|As1]) :-
+    subst(A, V, X, A1),
+    subst_list(As, V, X, As1).
+
+contra(G, H) :- contra_(G, H), !.
+contra(G, H) :- contra_(H, G).
+
+contra_(G, H) :-
+    cmp_norm(G, G1),
+    cmp_norm(H, H1),
+    cmp_contra(G1, H1).
+contra_(var(X), nonvar(Y)) :- X == Y.
+contra_(X == C, Y == D) :- X == Y, C \== D.
+contra_(X == C, Y \== D) :- X == Y, C == D.
+
+cmp_norm(X < Y, lt(X, Y)).
+cmp_norm(X > Y, lt(Y, X)).
+cmp_norm(X =< Y, le(X, Y)).
+cmp_norm(X >= Y, le(Y, X)).
+cmp_norm(X =:= Y, eq(X, Y)).
+cmp_norm(X =\= Y, ne(X, Y)).
+
+cmp_contra(G, H) :- cmp_contra_(G, H), !.
+cmp_contra(G, H) :- cmp_contra_(H, G).
+
+cmp_contra_(lt(X, Y), le(Y1, X1)) :- X == X1, Y == Y1.
+cmp_contra_(lt(X, Y), lt(Y1, X1)) :- X == X1, Y == Y1.
+cmp_contra_(lt(X, Y), eq(X1, Y1)) :- X == X1, Y == Y1.
+cmp_contra_(lt(X, Y), eq(Y1, X1)) :- X == X1, Y == Y1.
+cmp_contra_(eq(X, Y), ne(X1, Y1)) :- X == X1, Y == Y1.
+cmp_contra_(eq(X, Y), ne(Y1, X1)) :- X == X1, Y == Y1.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Code generation").
+
+:- export(jit_write_c/5).
+:- pred jit_write_c(+Stream, +Prefix, +M, +Unit, -Entries) # "Write to
+   @var{Stream} the C code for the predicates @var{Unit} (from
+   @pred{jit_closure/3}) of module @var{M}. The entry of each
+   predicate is the function @tt{Prefix_I}, and @tt{Prefix_init}
+   must be called before them. @var{Entries} is a list of
+   @tt{'M:f'/A-Symbol}.".
+
+jit_write_c(S, Prefix, M, Unit, Entries) :-
+    retractall_fact(atom_ix(_, _)),
+    retractall_fact(functor_ix(_, _, _)),
+    pred_fns(Unit, 0, Fns),
+    code_preds(Unit, Fns, Codes),
+    format(S, "/* Generated by library(jit) */~n~n", []),
+    format(S, "#include <ciao/eng.h>~n", []),
+    format(S, "#include <ciao/eng_registry.h>~n", []),
+    format(S, "#include <ciao/eng_jit.h>~n~n", []),
+    write_tables(S),
+    write_protos(Unit, Fns, S),
+    write_codes(Codes, S),
+    write_entries(Unit, Fns, S, Prefix, M, 0, Entries),
+    write_init(S, Prefix).
+
+% The C function of each predicate
+pred_fns([], _, []).
+pred_fns([p(F, A, _, _, _)|Ps], I, [F/A-I|Fns]) :-
+    I1 is I+1,
+    pred_fns(Ps, I1, Fns).
+
+pred_fn(F/A, Fns, I) :- member(F/A-I, Fns), !.
+
+code_preds([], _, []).
+code_preds([P|Ps], Fns, [Code|Codes]) :-
+    code_pred(P, Fns, Code),
+    code_preds(Ps, Fns, Codes).
+
+% ---------------------------------------------------------------------------
+% Atoms and functors (initialized by Prefix_init)
+
+:- data atom_ix/2.
+:- data functor_ix/3.
+
+atom_expr(X, atm(I)) :-
+    ( current_fact(atom_ix(X, I)) -> true
+    ; count_facts(atom_ix(_, _), I),
+      assertz_fact(atom_ix(X, I))
+    ).
+
+functor_expr(N, A, fun(I)) :-
+    ( current_fact(functor_ix(N, A, I)) -> true
+    ; count_facts(functor_ix(_, _, _), I),
+      assertz_fact(functor_ix(N, A, I))
+    ).
+
+count_facts(Fact, N) :-
+    findall(x, current_fact(Fact), Xs),
+    length(Xs, N).
+
+literal_expr(X, small(X)) :- integer(X), !.
+literal_expr(X, E) :- atom_expr(X, E).
+
+write_tables(S) :-
+    count_facts(atom_ix(_, _), NA),
+    count_facts(functor_ix(_, _, _), NF),
+    nonzero(NA, NA1),
+    nonzero(NF, NF1),
+    format(S, "static tagged_t jit_atoms[~w];~n", [NA1]),
+    format(S, "static tagged_t jit_functors[~w];~n~n", [NF1]).
+
+% (C arrays cannot be empty)
+nonzero(0, 1) :- !.
+nonzero(N, N).
+
+write_init(S, Prefix) :-
+    format(S, "~nvoid ~w_init(void) {~n", [Prefix]),
+    ( current_fact(atom_ix(X, I)),
+      format(S, "  jit_atoms[~w] = GET_ATOM(", [I]),
+      write_c_string(S, X),
+      format(S, ");~n", []),
+      fail
+    ; true
+    ),
+    ( current_fact(functor_ix(N, A, I)),
+      format(S, "  jit_functors[~w] = SetArity(GET_ATOM(", [I]),
+      write_c_string(S, N),
+      format(S, "), ~w);~n", [A]),
+      fail
+    ; true
+    ),
+    format(S, "}~n", []).
+
+% (in UTF-8, as atoms are stored)
+write_c_string(S, X) :-
+    atom_codes(X, Cs),
+    format(S, "\"", []),
+    write_c_chars(Cs, S),
+    format(S, "\"", []).
+
+write_c_chars([], _).
+write_c_chars([C|Cs], S) :-
+    utf8_bytes(C, Bs, []),
+    write_c_bytes(Bs, S),
+    write_c_chars(Cs, S).
+
+write_c_bytes([], _).
+write_c_bytes([B|Bs], S) :-
+    ( c_plain(B) ->
+        put_code(S, B)
+    ; O1 is (B >> 6) /\ 7,
+      O2 is (B >> 3) /\ 7,
+      O3 is B /\ 7,
+      format(S, "\\~w~w~w", [O1, O2, O3])
+    ),
+    write_c_bytes(Bs, S).
+
+c_plain(B) :- B >= 0'a, B =< 0'z, !.
+c_plain(B) :- B >= 0'A, B =< 0'Z, !.
+c_plain(B) :- B >= 0'0, B =< 0'9, !.
+c_plain(0'_).
+
+utf8_bytes(C, [C|Bs], Bs) :- C < 0x80, !.
+utf8_bytes(C, [B1, B2|Bs], Bs) :- C < 0x800, !,
+    B1 is 0xC0 \/ (C >> 6),
+    B2 is 0x80 \/ (C /\ 0x3F).
+utf8_bytes(C, [B1, B2, B3|Bs], Bs) :- C < 0x10000, !,
+    B1 is 0xE0 \/ (C >> 12),
+    B2 is 0x80 \/ ((C >> 6) /\ 0x3F),
+    B3 is 0x80 \/ (C /\ 0x3F).
+utf8_bytes(C, [B1, B2, B3, B4|Bs], Bs) :-
+    B1 is 0xF0 \/ (C >> 18),
+    B2 is 0x80 \/ ((C >> 12) /\ 0x3F),
+    B3 is 0x80 \/ ((C >> 6) /\ 0x3F),
+    B4 is 0x80 \/ (C /\ 0x3F).
+
+% ---------------------------------------------------------------------------
+% Functions
+
+write_protos([], _, _).
+write_protos([p(F, A, _, _, _)|Ps], Fns, S) :-
+    pred_fn(F/A, Fns, I),
+    format(S, "static CFUN__PROTO(p~w, intmach_t, intmach_t depth", [I]),
+    write_params(1, A, S),
+    format(S, ");~n", []),
+    write_protos(Ps, Fns, S).
+
+write_params(I, A, _) :- I > A, !.
+write_params(I, A, S) :-
+    format(S, ", tagged_t a~w", [I]),
+    I1 is I+1,
+    write_params(I1, A, S).
+
+write_entries([], _, _, _, _, _, []).
+write_entries([p(F, A, _, _, _)|Ps], Fns, S, Prefix, M, N, [MF/A-Sym|Es]) :-
+    module_concat(M, F, MF),
+    pred_fn(F/A, Fns, I),
+    number_codes(N, Cs),
+    atom_codes(NA, Cs),
+    atom_concat(Prefix, '_', Sym0),
+    atom_concat(Sym0, NA, Sym),
+    format(S, "~n/* ~q */~n", [MF/A]),
+    format(S, "CFUN__PROTO(~w, intmach_t) {~n", [Sym]),
+    format(S, "  return CFUN__EVAL(p~w, 0", [I]),
+    write_xregs(0, A, S),
+    format(S, ");~n}~n", []),
+    N1 is N+1,
+    write_entries(Ps, Fns, S, Prefix, M, N1, Es).
+
+write_xregs(I, A, _) :- I >= A, !.
+write_xregs(I, A, S) :-
+    format(S, ", X(~w)", [I]),
+    I1 is I+1,
+    write_xregs(I1, A, S).
+
+write_codes([], _).
+write_codes([Code|Codes], S) :-
+    write_lines(Code, S),
+    write_codes(Codes, S).
+
+% Code is a list of lines, each a list of tokens (see write_token/2)
+write_lines([], _).
+write_lines([L|Ls], S) :-
+    write_tokens(L, S),
+    nl(S),
+    write_lines(Ls, S).
+
+write_tokens([], _).
+write_tokens([T|Ts], S) :-
+    write_token(T, S),
+    write_tokens(Ts, S).
+
+write_token([], _) :- !.
+write_token(T, S) :- atom(T), !, format(S, "~w", [T]).
+write_token(T, S) :- number(T), !, format(S, "~w", [T]).
+write_token('$jit_v'(K, N), S) :- !, format(S, "v~w_~w", [K, N]).
+write_token(a(I), S) :- !, format(S, "a~w", [I]).
+write_token(t(N), S) :- !, format(S, "t~w", [N]).
+write_token(i(N), S) :- !, format(S, "i~w", [N]).
+write_token(f(K, I), S) :- !, format(S, "f~w_~w", [K, I]).
+write_token(atm(I), S) :- !, format(S, "jit_atoms[~w]", [I]).
+write_token(fun(I), S) :- !, format(S, "jit_functors[~w]", [I]).
+write_token(small(X), S) :- !, format(S, "MakeSmall(~w)", [X]).
+write_token(next(K), S) :- !, format(S, "next~w", [K]).
+write_token([T|Ts], S) :- write_tokens([T|Ts], S).
+
+
+% ---------------------------------------------------------------------------
+% Code of a predicate
+
+:- data tmp_count/1.
+
+new_tmp(N) :-
+    retract_fact(tmp_count(N)),
+    N1 is N+1,
+    asserta_fact(tmp_count(N1)).
+
+code_pred(p(F, A, Cls, Disc, _), Fns, Code) :-
+    pred_fn(F/A, Fns, I),
+    set_fact(tmp_count(0)),
+    code_clauses(Cls, F/A, Disc, Fns, Body, []),
+    current_fact(tmp_count(NT)),
+    markers_list(Cls, Vs0, []),
+    sort(Vs0, Vs),
+    clauses_flags(Cls, Disc, Fs, []),
+    tmps(0, NT, t, Ts),
+    tmps(0, NT, i, Is),
+    params(1, A, Ps),
+    decls([tagged_t-Vs, tagged_t-Ts, intmach_t-Is, intmach_t-Fs], Decls),
+    derefs(1, A, Derefs),
+    disc_tests(Disc, Tests),
+    append([[],
+            ['/* ', F, '/', A, ' */'],
+            ['static CFUN__PROTO(p', I, ', intmach_t, intmach_t depth', Ps, ') {']
+           |Decls],
+           [['  if (depth > JIT_MAX_DEPTH) return JIT_BAIL;'],
+            [' top:']
+           |Pre], Code),
+    append(Derefs, Tests, Pre0),
+    append(Pre0, Body, Pre1),
+    append(Pre1, [['  return JIT_FAIL;'], ['}']], Pre).
+
+tmps(N, NT, _, []) :- N >= NT, !.
+tmps(N, NT, T, [X|Xs]) :-
+    X =.. [T, N],
+    N1 is N+1,
+    tmps(N1, NT, T, Xs).
+
+params(I, A, []) :- I > A, !.
+params(I, A, [', tagged_t ', a(I)|Ps]) :-
+    I1 is I+1,
+    params(I1, A, Ps).
+
+decls([], []).
+decls([_-[]|Ds], Ls) :- !, decls(Ds, Ls).
+decls([T-[X|Xs]|Ds], [['  ', T, ' ', X|L]|Ls]) :-
+    decl_rest(Xs, L),
+    decls(Ds, Ls).
+
+decl_rest([], [';']).
+decl_rest([X|Xs], [', ', X|L]) :- decl_rest(Xs, L).
+
+derefs(I, A, []) :- I > A, !.
+derefs(I, A, [['  DEREF(', a(I), ', ', a(I), ');']|Ls]) :-
+    I1 is I+1,
+    derefs(I1, A, Ls).
+
+disc_tests([], []).
+disc_tests([I|Is], [['  if (IsVar(', a(I), ')) return JIT_BAIL;']|Ls]) :-
+    disc_tests(Is, Ls).
+
+% Flags of the arguments that are bound after selecting the clause
+clauses_flags([], _, Fs, Fs).
+clauses_flags([cl(K, Args, Gs, _, _, _)|Cls], Disc, Fs, Fs0) :-
+    args_flags(Args, 1, K, Gs, Disc, Fs, Fs1),
+    clauses_flags(Cls, Disc, Fs1, Fs0).
+
+args_flags([], _, _, _, _, Fs, Fs).
+args_flags([P|Ps], I, K, Gs, Disc, Fs, Fs0) :-
+    ( deferred(P, I, Gs, Disc) -> Fs = [f(K, I)|Fs1] ; Fs = Fs1 ),
+    I1 is I+1,
+    args_flags(Ps, I1, K, Gs, Disc, Fs1, Fs0).
+
+% The argument is matched, or bound later if it is an unbound
+% variable (unless its variables are needed by the guards)
+deferred(P, I, Gs, Disc) :-
+    \+ marker(P),
+    \+ member(I, Disc),
+    \+ pattern_in_guards(P, Gs).
+
+pattern_in_guards(P, Gs) :-
+    markers(P, Vs, []),
+    markers_list(Gs, Ws, []),
+    member(V, Vs),
+    known(V, Ws), !.
+
+% ---------------------------------------------------------------------------
+% Clauses
+
+code_clauses([], _, _, _) --> [].
+code_clauses([C|Cs], Self, Disc, Fns) -->
+    { C = cl(K, Args, Gs, _, Body, Fail) },
+    [[], ['  /* clause ', K, ' */']],
+    code_head(Args, 1, K, Gs, Disc, [], Kn1, Defs, []),
+    code_guards(Gs, ['goto ', next(K)], Kn1, Kn2),
+    code_defs(Defs, K, Fail),
+    code_body(Body, Self, Fns, Kn2),
+    [[' ', next(K), ':;']],
+    code_clauses(Cs, Self, Disc, Fns).
+
+% Test the arguments, without binding them (Defs are bindings to do
+% after selecting the clause)
+code_head([], _, _, _, _, Kn, Kn, Defs, Defs) --> [].
+code_head([P|Ps], I, K, Gs, Disc, Kn0, Kn, Defs, Defs0) -->
+    code_arg(P, I, K, Gs, Disc, Kn0, Kn1, Defs, Defs1),
+    { I1 is I+1 },
+    code_head(Ps, I1, K, Gs, Disc, Kn1, Kn, Defs1, Defs0).
+
+code_arg(P, I, _, _, _, Kn, Kn, [dup(P, a(I))|Defs], Defs) -->
+    { marker(P), known(P, Kn) }, !.
+code_arg(P, I, _, _, _, Kn, [P|Kn], Defs, Defs) -->
+    { marker(P) }, !,
+    [['  ', P, ' = ', a(I), ';']].
+code_arg(P, I, K, Gs, Disc, Kn0, Kn, Defs, Defs0) -->
+    ( { deferred(P, I, Gs, Disc) } ->
+        % (Dups are only done if the argument was not unbound)
+        { Defs = [bind(P, I, Kn0, Dups)|Defs0] },
+        [['  if (IsVar(', a(I), ')) {'],
+         ['  ', f(K, I), ' = 1;'],
+         ['  } else {'],
+         ['  ', f(K, I), ' = 0;']],
+        code_match(a(I), P, K, Kn0, Kn1, Dups, []),
+        [['  }']],
+        { markers(P, Kn, Kn1) }
+    ; ( { member(I, Disc) } -> []
+      ; [['  if (IsVar(', a(I), ')) return JIT_BAIL;']]
+      ),
+      code_match(a(I), P, K, Kn0, Kn, Defs, Defs0)
+    ).
+
+% Match the (dereferenced) value T with pattern P (variables already
+% known are unified later, in Defs)
+code_match(T, P, _, Kn, Kn, [dup(P, T)|Defs], Defs) -->
+    { marker(P), known(P, Kn) }, !.
+code_match(T, P, _, Kn, [P|Kn], Defs, Defs) --> { marker(P) }, !,
+    [['  ', P, ' = ', T, ';']].
+code_match(T, P, K, Kn, Kn, Defs, Defs) --> { literal(P) }, !,
+    { literal_expr(P, C) },
+    [['  if (', T, ' != ', C, ') { if (IsVar(', T, ')) return JIT_BAIL; goto ', next(K), '; }']].
+code_match(T, [X|Xs], K, Kn0, Kn, Defs, Defs0) --> !,
+    [['  if (!TaggedIsLST(', T, ')) { if (IsVar(', T, ')) return JIT_BAIL; goto ', next(K), '; }']],
+    code_sub(['*TaggedToCar(', T, ')'], X, K, Kn0, Kn1, Defs, Defs1),
+    code_sub(['*TaggedToCdr(', T, ')'], Xs, K, Kn1, Kn, Defs1, Defs0).
+code_match(T, P, K, Kn0, Kn, Defs, Defs0) -->
+    { functor(P, N, A), functor_expr(N, A, Fn) },
+    [['  if (!TaggedIsSTR(', T, ') || TaggedToHeadfunctor(', T, ') != ', Fn, ') { if (IsVar(', T, ')) return JIT_BAIL; goto ', next(K), '; }']],
+    code_sub_args(1, A, T, P, K, Kn0, Kn, Defs, Defs0).
+
+code_sub_args(J, A, _, _, _, Kn, Kn, Defs, Defs) --> { J > A }, !.
+code_sub_args(J, A, T, P, K, Kn0, Kn, Defs, Defs0) -->
+    { arg(J, P, X) },
+    code_sub(['*TaggedToArg(', T, ', ', J, ')'], X, K, Kn0, Kn1, Defs, Defs1),
+    { J1 is J+1 },
+    code_sub_args(J1, A, T, P, K, Kn1, Kn, Defs1, Defs0).
+
+code_sub(E, P, _, Kn, Kn, [dup(P, t(N))|Defs], Defs) -->
+    { marker(P), known(P, Kn) }, !,
+    { new_tmp(N) },
+    [['  ', t(N), ' = ', E, ';']].
+code_sub(E, P, _, Kn, [P|Kn], Defs, Defs) --> { marker(P) }, !,
+    [['  ', P, ' = ', E, ';']].
+code_sub(E, P, K, Kn0, Kn, Defs, Defs0) -->
+    { new_tmp(N) },
+    [['  DEREF(', t(N), ', ', E, ');']],
+    code_match(t(N), P, K, Kn0, Kn, Defs, Defs0).
+
+% Bindings of the head, after selecting the clause
+code_defs([], _, _) --> [].
+code_defs([D|Ds], K, Fail) -->
+    code_def(D, K, Fail),
+    code_defs(Ds, K, Fail).
+
+code_def(dup(V, T), _, Fail) -->
+    [['  JIT_UNIFY(', V, ', ', T, ', ', Fail, ');']].
+code_def(bind(P, I, Kn, Dups), K, Fail) -->
+    { cells(P, Cells) },
+    [['  if (', f(K, I), ') {']],
+    code_heap(Cells),
+    code_build(P, Kn, _, E),
+    [['  JIT_UNIFY(', a(I), ', ', E, ', ', Fail, ');']],
+    ( { Dups = [] } -> []
+    ; [['  } else {']],
+      code_defs(Dups, K, Fail)
+    ),
+    [['  }']].
+
+% ---------------------------------------------------------------------------
+% Guards and tests
+
+code_guards([], _, Kn, Kn) --> [].
+code_guards([G|Gs], Fail, Kn0, Kn) -->
+    code_test(G, Fail, Kn0, Kn1),
+    code_guards(Gs, Fail, Kn1, Kn).
+
+code_test(V is E, _, Kn, [V|Kn]) --> !,
+    code_expr(E, X),
+    [['  JIT_SMALL(', V, ', ', X, ');']].
+code_test(G, Fail, Kn, Kn) -->
+    { G =.. [Op, X, Y], cmp_op(Op, COp) }, !,
+    code_expr(X, EX),
+    code_expr(Y, EY),
+    [['  if (!(', EX, ' ', COp, ' ', EY, ')) ', Fail, ';']].
+code_test(G, Fail, Kn, Kn) -->
+    { G =.. [T, X], type_test(T, CT) }, !,
+    { new_tmp(N) },
+    [['  DEREF(', t(N), ', ', X, ');'],
+     ['  if (!(', CT, '(', t(N), '))) ', Fail, ';']].
+code_test(G, Fail, Kn, Kn) -->
+    { G =.. [Op, X, Y], eq_args(X, Y, V, C), literal_expr(C, EC) },
+    { new_tmp(N) },
+    { Op = (==) -> COp = ' != ' ; COp = ' == ' },
+    [['  DEREF(', t(N), ', ', V, ');'],
+     ['  if (', t(N), COp, EC, ') ', Fail, ';']].
+
+% Evaluate an arithmetic expression (to a C integer expression)
+code_expr(X, X) --> { integer(X) }, !.
+code_expr(V, i(N)) --> { marker(V) }, !,
+    { new_tmp(N) },
+    [['  JIT_INT(', i(N), ', ', V, ');']].
+code_expr(E, X) --> { E = +(Y) }, !,
+    code_expr(Y, X).
+code_expr(E, i(N)) -->
+    { E =.. [Op|Ys], functor(E, _, A), arith_op(Op, A, COp) },
+    code_exprs(Ys, Xs),
+    { new_tmp(N) },
+    code_op(Xs, COp, i(N)).
+
+code_exprs([], []) --> [].
+code_exprs([Y|Ys], [X|Xs]) -->
+    code_expr(Y, X),
+    code_exprs(Ys, Xs).
+
+code_op([X], '~', R) --> !, [['  ', R, ' = ~', X, ';']].
+code_op([X], COp, R) --> !, [['  ', COp, '(', R, ', ', X, ');']].
+code_op([X, Y], COp, R) --> { c_bitwise(COp) }, !,
+    [['  ', R, ' = ', X, ' ', COp, ' ', Y, ';']].
+code_op([X, Y], COp, R) -->
+    [['  ', COp, '(', R, ', ', X, ', ', Y, ');']].
+
+c_bitwise('&').
+c_bitwise('|').
+c_bitwise('^').
+
+% ---------------------------------------------------------------------------
+% Body
+
+code_body([], _, _, _) -->
+    [['  return JIT_OK;']].
+code_body([G|Gs], Self, Fns, Kn0) -->
+    code_goal(G, Gs, Self, Fns, Kn0, Kn, Done),
+    ( { Done = yes } -> []
+    ; code_body(Gs, Self, Fns, Kn)
+    ).
+
+% (Done = yes if the goal ends the clause)
+code_goal(true, _, _, _, Kn, Kn, no) --> !.
+code_goal(fail, _, _, _, Kn, Kn, yes) --> !,
+    [['  return JIT_FAIL;']].
+code_goal(V is E, _, _, _, Kn, Kn1, no) --> !,
+    code_expr(E, X),
+    ( { marker(V), \+ known(V, Kn) } ->
+        { Kn1 = [V|Kn] },
+        [['  JIT_SMALL(', V, ', ', X, ');']]
+    ; { Kn1 = Kn, new_tmp(N) },
+      { marker(V) -> EV = V ; literal_expr(V, EV) },
+      [['  JIT_SMALL(', t(N), ', ', X, ');'],
+       ['  JIT_UNIFY(', EV, ', ', t(N), ', JIT_FAIL);']]
+    ).
+code_goal(X = Y, _, _, _, Kn, Kn1, no) --> !,
+    { cells(X, C1), cells(Y, C2), Cells is C1+C2 },
+    code_heap(Cells),
+    ( { marker(X), \+ known(X, Kn) } ->
+        code_build(Y, Kn, Kn0, EY),
+        [['  ', X, ' = ', EY, ';']],
+        { Kn1 = [X|Kn0] }
+    ; { marker(Y), \+ known(Y, Kn) } ->
+        code_build(X, Kn, Kn0, EX),
+        [['  ', Y, ' = ', EX, ';']],
+        { Kn1 = [Y|Kn0] }
+    ; code_build(X, Kn, Kn0, EX),
+      code_build(Y, Kn0, Kn1, EY),
+      [['  JIT_UNIFY(', EX, ', ', EY, ', JIT_FAIL);']]
+    ).
+code_goal(G, Gs, Self, Fns, Kn, Kn1, Done) -->
+    { functor(G, N, A), member(N/A-I, Fns) }, !,
+    { G =.. [_|Xs], cells_list(Xs, Cells) },
+    code_heap(Cells),
+    code_builds(Xs, Kn, Kn1, Es),
+    { call_args(Es, As) },
+    ( { Gs = [], Self = N/A } ->
+        % (last call to itself)
+        { Done = yes },
+        code_self_call(Es),
+        [['  if (TestEvent()) return JIT_BAIL;'],
+         ['  goto top;']]
+    ; { Gs = [] } ->
+        { Done = yes },
+        [['  return CFUN__EVAL(p', I, ', depth+1', As, ');']]
+    ; { Done = no },
+      [['  JIT_CALL(CFUN__EVAL(p', I, ', depth+1', As, '));']]
+    ).
+code_goal(G, _, _, _, Kn0, Kn, no) -->
+    code_test(G, 'return JIT_FAIL', Kn0, Kn).
+
+call_args([], []).
+call_args([E|Es], [', ', E|As]) :- call_args(Es, As).
+
+code_self_call(Es) -->
+    code_self_tmps(Es, Ts),
+    code_self_args(Ts, 1).
+
+code_self_tmps([], []) --> [].
+code_self_tmps([E|Es], [t(N)|Ts]) -->
+    { new_tmp(N) },
+    [['  ', t(N), ' = ', E, ';']],
+    code_self_tmps(Es, Ts).
+
+code_self_args([], _) --> [].
+code_self_args([T|Ts], I) -->
+    [['  ', a(I), ' = ', T, ';']],
+    { I1 is I+1 },
+    code_self_args(Ts, I1).
+
+% ---------------------------------------------------------------------------
+% Terms
+
+% Heap cells to build a term (at most)
+cells(X, 1) :- marker(X), !.
+cells(X, 0) :- atomic(X), !.
+cells(X, N) :-
+    X =.. [_|Xs],
+    cells_list(Xs, N0),
+    ( X = [_|_] -> N is N0+2 ; functor(X, _, A), N is N0+A+1 ).
+
+cells_list([], 0).
+cells_list([X|Xs], N) :-
+    cells(X, N0),
+    cells_list(Xs, N1),
+    N is N0+N1.
+
+code_heap(0) --> !.
+code_heap(Cells) --> [['  JIT_HEAP(', Cells, ');']].
+
+code_builds([], Kn, Kn, []) --> [].
+code_builds([X|Xs], Kn0, Kn, [E|Es]) -->
+    code_build(X, Kn0, Kn1, E),
+    code_builds(Xs, Kn1, Kn, Es).
+
+% Build a term (E is its C expression)
+code_build(X, Kn, Kn, X) --> { marker(X), known(X, Kn) }, !.
+code_build(X, Kn, [X|Kn], X) --> { marker(X) }, !,
+    [['  LoadHVA(', X, ', G->heap_top);']].
+code_build(X, Kn, Kn, E) --> { literal(X) }, !,
+    { literal_expr(X, E) }.
+code_build(X, Kn0, Kn, t(N)) -->
+    { X =.. [_|Xs] },
+    code_build_subterms(Xs, Kn0, Kn1, Es),
+    { new_tmp(N) },
+    ( { X = [_|_] } ->
+        [['  ', t(N), ' = Tagp(LST, G->heap_top);']]
+    ; { functor(X, F, A), functor_expr(F, A, Fn) },
+      [['  ', t(N), ' = Tagp(STR, G->heap_top);'],
+       ['  HeapPush(G->heap_top, ', Fn, ');']]
+    ),
+    code_push(Xs, Es, Kn1, Kn).
+
+% (compound subterms are built first)
+code_build_subterms([], Kn, Kn, []) --> [].
+code_build_subterms([X|Xs], Kn0, Kn, [E|Es]) -->
+    ( { compound(X), \+ marker(X) } ->
+        code_build(X, Kn0, Kn1, E)
+    ; { Kn1 = Kn0, E = none }
+    ),
+    code_build_subterms(Xs, Kn1, Kn, Es).
+
+code_push([], [], Kn, Kn) --> [].
+code_push([X|Xs], [E|Es], Kn0, Kn) -->
+    code_push_(X, E, Kn0, Kn1),
+    code_push(Xs, Es, Kn1, Kn).
+
+code_push_(X, _, Kn, Kn) --> { marker(X), known(X, Kn) }, !,
+    [['  JIT_PUSH(', X, ');']].
+code_push_(X, _, Kn, [X|Kn]) --> { marker(X) }, !,
+    [['  HeapPush(G->heap_top, ', X, ' = Tagp(HVA, G->heap_top));']].
+code_push_(X, _, Kn, Kn) --> { literal(X) }, !,
+    { literal_expr(X, E) },
+    [['  HeapPush(G->heap_top, ', E, ');']].
+code_push_(_, E, Kn, Kn) -->
+    [['  HeapPush(G->heap_top, ', E, ');']].
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Ahead of time").
+
+:- export(jit_write_dynlink/5).
+:- pred jit_write_dynlink(+Stream, +Prefix, +M, +Stamp, +Entries) #
+   "Write to @var{Stream}, after the code written by
+   @pred{jit_write_c/5}, the functions @tt{M_init} and @tt{M_end}
+   that @pred{dynlink/2} calls when the shared object is the foreign
+   code of module @var{M}. They register the native code of
+   @var{Entries} for the source with @var{Stamp} (see
+   @pred{jit_src_stamp/2}).".
+
+jit_write_dynlink(S, Prefix, M, Stamp, Entries) :-
+    format(S, "~nstatic jit_entry_t ~w_entries[] = {~n", [Prefix]),
+    write_entry_table(Entries, S),
+    format(S, "};~n", []),
+    length(Entries, N),
+    format(S, "~nvoid ~w_init(char *module) {~n", [M]),
+    format(S, "  jit_aot_register(module, ", []),
+    write_c_string(S, Stamp),
+    format(S, ", ~w_init, ~w, ~w_entries);~n}~n", [Prefix, N, Prefix]),
+    format(S, "~nvoid ~w_end(char *module) {~n", [M]),
+    format(S, "  jit_aot_unregister(module);~n}~n", []).
+
+write_entry_table([], _).
+write_entry_table([MF/A-Sym|Es], S) :-
+    format(S, "  {", []),
+    write_c_string(S, MF),
+    format(S, ", ~w, ~w},~n", [A, Sym]),
+    write_entry_table(Es, S).
+
+:- export(jit_src_stamp/2).
+:- pred jit_src_stamp(+Src, -Stamp) # "@var{Stamp} identifies the
+   source @var{Src} (as in @pred{jit_eligible/2}), up to variable
+   renaming.".
+
+jit_src_stamp(Src, Stamp) :-
+    copy_term(Src, Src1),
+    numbervars(Src1, 0, _),
+    digest_init(xxh64, Ctx0),
+    stamp_term(Src1, Ctx0, Ctx),
+    digest_final(Ctx, Stamp).
+
+stamp_term(X, Ctx0, Ctx) :- atom(X), !,
+    stamp_atom(0'a, X, Ctx0, Ctx).
+stamp_term(X, Ctx0, Ctx) :- number(X), !,
+    number_codes(X, Cs),
+    digest_update(Ctx0, [0'n|Cs], Ctx1),
+    digest_update(Ctx1, [0], Ctx).
+stamp_term(X, Ctx0, Ctx) :-
+    functor(X, N, A),
+    number_codes(A, Cs),
+    stamp_atom(0'f, N, Ctx0, Ctx1),
+    digest_update(Ctx1, Cs, Ctx2),
+    digest_update(Ctx2, [0], Ctx3),
+    stamp_args(1, A, X, Ctx3, Ctx).
+
+stamp_args(I, A, _, Ctx, Ctx) :- I > A, !.
+stamp_args(I, A, X, Ctx0, Ctx) :-
+    arg(I, X, Y),
+    stamp_term(Y, Ctx0, Ctx1),
+    I1 is I+1,
+    stamp_args(I1, A, X, Ctx1, Ctx).
+
+% (a tag, the UTF-8 bytes, and a terminator)
+stamp_atom(Tag, X, Ctx0, Ctx) :-
+    atom_codes(X, Cs),
+    utf8_codes(Cs, Bs, [0]),
+    digest_update(Ctx0, [Tag|Bs], Ctx).
+
+utf8_codes([], Bs, Bs).
+utf8_codes([C|Cs], Bs, Bs0) :-
+    utf8_bytes(C, Bs, Bs1),
+    utf8_codes(Cs, Bs1, Bs0).
@@ -0,0 +1,245 @@
+:- module(jit_rt, [
+    jit_set_threshold/1,
+    jit_compile/1,
+    jit_native/1,
+    jit_deoptimize/1,
+    '$jit_register'/1,
+    '$jit_build'/3
+], [assertions, isomodes, hiord, datafacts]).
+
+:- doc(title, "Native code for hot predicates (runtime)").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This is the runtime of the @lib{jit} package. The
+   predicates of a module that uses it are counted at each call. When
+   one of them reaches the threshold (see @pred{jit_set_threshold/1}),
+   it is translated to C together with the predicates that it calls
+   (see @lib{jit/jit_c}), the C code is compiled to a shared object
+   with the C compiler used for foreign code, and the engine enters
+   those predicates through their native code.
+
+   Predicates that cannot be translated stay in bytecode. Native code
+   goes back to bytecode for a call that it cannot complete (see
+   @tt{eng_jit.h}), and for good when any of the predicates of the
+   shared object is redefined (e.g., when its module is loaded again
+   or its clauses are abolished).
+
+   A module can also come with its native code compiled ahead of time
+   (see @lib{jit/jit_aot}). It is installed when the module is
+   initialized, unless the source of the module has changed since
+   then.").
+
+:- use_module(engine(internals), [
+    module_concat/3,
+    '$jit_candidate'/2,
+    '$jit_install'/3,
+    '$jit_uninstall'/1,
+    '$jit_native'/1,
+    '$jit_aot_stamp'/2,
+    '$jit_aot_install'/1]).
+:- use_module(engine(system_info), [ciao_c_headers_dir/1, eng_is_sharedlib/0, get_platform/1]).
+:- use_module(engine(stream_basic)).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1, file_exists/1]).
+:- use_module(library(process), [process_call/3]).
+:- use_module(library(foreign_compilation), [compiler_and_opts/2, linker_and_opts/2]).
+:- use_module(library(compiler/engine_path), [get_engine_dir/2]).
+:- use_module(library(lists), [append/3]).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(jit/jit_c)).
+:- use_module(engine(messages_basic), [message/2]).
+
+% '$jit_src'(M, F/A, Clauses): source of the predicates of modules
+% that use the jit package
+:- multifile '$jit_src'/3.
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Interface").
+
+:- data threshold/1.
+threshold(1000).
+
+:- pred jit_set_threshold(+N) : int # "Predicates are compiled to
+   native code after @var{N} calls (never if @var{N} is 0). This also
+   restarts the counts of the predicates that are not compiled
+   yet. The default is 1000.".
+
+jit_set_threshold(N) :-
+    integer(N), N >= 0,
+    set_fact(threshold(N)),
+    ( '$jit_src'(M, F/A, _),
+      module_concat(M, F, MF),
+      \+ '$jit_native'(MF/A),
+      '$jit_candidate'(MF/A, N),
+      fail
+    ; true
+    ).
+
+:- meta_predicate jit_compile(spec).
+:- pred jit_compile(+Pred) # "Compile now the predicate @var{Pred}
+   (@tt{F/A}) to native code, with the predicates that it calls. Fails
+   if it cannot be compiled.".
+
+jit_compile(Spec) :-
+    spec_name(Spec, MF/A),
+    compile_pred(MF/A).
+
+:- meta_predicate jit_native(spec).
+:- pred jit_native(+Pred) # "The predicate @var{Pred} (@tt{F/A}) is
+   entered through native code.".
+
+jit_native(Spec) :-
+    spec_name(Spec, MF/A),
+    '$jit_native'(MF/A).
+
+:- meta_predicate jit_deoptimize(spec).
+:- pred jit_deoptimize(+Pred) # "Go back to bytecode for the
+   predicate @var{Pred} (@tt{F/A}) and the predicates compiled with
+   it.".
+
+jit_deoptimize(Spec) :-
+    spec_name(Spec, MF/A),
+    ( '$jit_uninstall'(MF/A) -> true ; true ).
+
+spec_name('$:'(Spec), Spec).
+
+% (called at the initialization of modules that use the package)
+'$jit_register'(M) :-
+    threshold(N),
+    ( '$jit_src'(M, F/A, _),
+      module_concat(M, F, MF),
+      '$jit_candidate'(MF/A, N),
+      fail
+    ; true
+    ),
+    install_aot(M).
+
+% (native code compiled ahead of time, if it is up to date)
+install_aot(M) :-
+    '$jit_aot_stamp'(M, Stamp), !,
+    findall(F/A-Cs, '$jit_src'(M, F/A, Cs), Src),
+    jit_src_stamp(Src, Stamp0),
+    ( Stamp0 == Stamp, '$jit_aot_install'(M) ->
+        ( '$jit_src'(M, F/A, _),
+          module_concat(M, F, MF),
+          '$jit_native'(MF/A),
+          '$jit_candidate'(MF/A, 0),
+          fail
+        ; true
+        )
+    ; message(warning, ['Native code of module ', M,
+                        ' is out of date, using bytecode'])
+    ).
+install_aot(_).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Hot predicates").
+
+:- multifile '$jit_compile_hook'/1.
+
+'$jit_compile_hook'(Specs) :- compile_hot(Specs).
+
+% (predicates that become hot while compiling others wait here)
+:- data compiling/0.
+:- data pending/1.
+
+compile_hot(Specs) :-
+    ( current_fact(compiling) ->
+        ( member_(Spec, Specs), assertz_fact(pending(Spec)), fail ; true )
+    ; asserta_fact(compiling),
+      compile_hot_(Specs),
+      retractall_fact(compiling)
+    ).
+
+compile_hot_([]) :-
+    ( retract_fact(pending(Spec)) -> compile_hot_([Spec]) ; true ).
+compile_hot_([Spec|Specs]) :-
+    ( catch(compile_pred(Spec), _, fail) -> true ; true ),
+    compile_hot_(Specs).
+
+member_(X, [X|_]).
+member_(X, [_|Xs]) :- member_(X, Xs).
+
+% ---------------------------------------------------------------------------
+:- doc(section, "Compilation").
+
+:- data unit_count/1.
+unit_count(0).
+
+compile_pred(MF/A) :-
+    '$jit_src'(M, F/A, _),
+    module_concat(M, F, MF), !,
+    findall(F1/A1-Cs, '$jit_src'(M, F1/A1, Cs), Src),
+    jit_eligible(Src, Preds),
+    jit_closure(Preds, [F/A], Unit),
+    Unit = [_|_],
+    retract_fact(unit_count(N)),
+    N1 is N+1,
+    asserta_fact(unit_count(N1)),
+    number_codes(N, NCs),
+    atom_codes(NA, NCs),
+    atom_concat(ciao_jit_, NA, Prefix),
+    mktemp_in_tmp('ciaojitXXXXXX', Base),
+    atom_concat(Base, '.c', CFile),
+    atom_concat(Base, '.o', OFile),
+    atom_concat(Base, '.so', SoFile),
+    atom_concat(Prefix, '_init', Init),
+    ( catch(build_unit(M, Unit, Prefix, CFile, OFile, SoFile, Entries), _, fail),
+      '$jit_install'(SoFile, Init, Entries) ->
+        Ok = yes
+    ; Ok = no
+    ),
+    % (the shared object stays loaded)
+    delete_files([Base, CFile, OFile, SoFile]),
+    Ok = yes,
+    % (they are not counted anymore)
+    ( member_(Spec-_, Entries), '$jit_candidate'(Spec, 0), fail ; true ).
+
+build_unit(M, Unit, Prefix, CFile, OFile, SoFile, Entries) :-
+    open(CFile, write, S),
+    jit_write_c(S, Prefix, M, Unit, Entries),
+    close(S),
+    '$jit_build'(CFile, OFile, SoFile).
+
+% (also for library(jit/jit_aot))
+'$jit_build'(CFile, OFile, SoFile) :-
+    compiler_and_opts(CC, CCOpts),
+    ciao_c_headers_dir(HDir),
+    atom_concat('-I', HDir, IOpt),
+    append(CCOpts, [IOpt, '-O2', '-c', '-o', OFile, CFile], CCArgs),
+    build_call(CC, CCArgs),
+    linker_and_opts(LD, LDOpts),
+    engine_libs(Libs),
+    append(LDOpts, ['-o', SoFile, OFile|Libs], LDArgs),
+    build_call(LD, LDArgs).
+
+% (the first failure is shown, with the errors of the command; the
+% rest would most likely repeat them)
+:- data build_failed/0.
+
+build_call(Cmd, Args) :-
+    catch(process_call(path(Cmd), Args,
+                       [stdout(null), stderr(string(Err)), status(S)]),
+          E, true),
+    ( var(E), S =:= 0 -> true
+    ; current_fact(build_failed) -> fail
+    ; assertz_fact(build_failed),
+      ( var(E) ->
+          message(warning, ['Native code could not be built (', Cmd,
+                            ' exited with status ', S, '):\n', $$(Err)])
+      ; message(warning, ['Native code could not be built (', Cmd,
+                          ' could not be run): ', ~~(E)])
+      ),
+      fail
+    ).
+
+% (link against the engine if it is a shared library)
+engine_libs(['-L', EngDir, '-lciaoengine']) :- eng_is_sharedlib, !,
+    get_platform(Eng),
+    get_engine_dir(Eng, EngDir).
+engine_libs([]).
+
+delete_files([]).
+delete_files([F|Fs]) :-
+    ( file_exists(F) -> delete_file(F) ; true ),
+    delete_files(Fs).
@@ -0,0 +1,63 @@
+:- module(jit_tr, [sentence_tr/3], [datafacts]).
+
+% Translation module for the jit package: it keeps the source of the
+% static predicates of the module, as '$jit_src'(M, F/A, Clauses)
+% facts for jit_rt, and registers them when the module is loaded.
+
+:- use_module(library(lists), [reverse/2]).
+:- use_module(library(sort), [sort/2]).
+:- use_module(library(aggregates), [findall/3]).
+
+:- data clause_/3. % (in reverse order)
+:- data excluded/2.
+
+sentence_tr(0, _, M) :- !,
+    retractall_fact(clause_(_, _, M)),
+    retractall_fact(excluded(_, M)),
+    fail.
+sentence_tr(end_of_file, Cs, M) :- !,
+    findall(FA, current_fact(clause_(FA, _, M)), FAs0),
+    sort(FAs0, FAs),
+    src_facts(FAs, M, Cs, [(:- initialization('$jit_register'(M))), end_of_file]),
+    retractall_fact(clause_(_, _, M)),
+    retractall_fact(excluded(_, M)).
+sentence_tr((:- Decl), _, M) :- !,
+    decl(Decl, M),
+    fail.
+sentence_tr((H :- B), _, M) :- !,
+    add_clause(H, B, M),
+    fail.
+sentence_tr(H, _, M) :-
+    add_clause(H, true, M),
+    fail.
+
+add_clause(H, B, M) :-
+    nonvar(H),
+    functor(H, F, A),
+    atom(F),
+    H \= _:_, !,
+    asserta_fact(clause_(F/A, (H :- B), M)).
+add_clause(_, _, _).
+
+% Predicates whose clauses may change at run time
+decl(dynamic(Ps), M) :- !, exclude(Ps, M).
+decl(data(Ps), M) :- !, exclude(Ps, M).
+decl(concurrent(Ps), M) :- !, exclude(Ps, M).
+decl(multifile(Ps), M) :- !, exclude(Ps, M).
+decl(_, _).
+
+exclude(Ps, _) :- var(Ps), !.
+exclude((P, Ps), M) :- !, exclude(P, M), exclude(Ps, M).
+exclude([P|Ps], M) :- !, exclude(P, M), exclude(Ps, M).
+exclude(F/A, M) :- !, assertz_fact(excluded(F/A, M)).
+exclude(_, _).
+
+src_facts([], _, Cs, Cs).
+src_facts([FA|FAs], M, Cs, Cs0) :-
+    ( current_fact(excluded(FA, M)) ->
+        Cs = Cs1
+    ; findall(C, current_fact(clause_(FA, C, M)), Rs),
+      reverse(Rs, Clauses),
+      Cs = ['$jit_src'(M, FA, Clauses)|Cs1]
+    ),
+    src_facts(FAs, M, Cs1, Cs0).
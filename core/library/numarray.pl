@@ -0,0 +1,220 @@
+:- module(numarray, [
+    numarray/1,
+    numarray_elem_type/1,
+    numarray_new/3,
+    list_numarray/3,
+    numarray_to_list/2,
+    numarray_length/2,
+    numarray_type/2,
+    numarray_get/3,
+    numarray_set/3,
+    numarray_fill/2,
+    numarray_slice/4,
+    numarray_copy/2,
+    numarray_op/4,
+    numarray_sum/2,
+    numarray_min/2,
+    numarray_max/2,
+    numarray_free/1
+], [assertions, isomodes, regtypes]).
+
+:- doc(title, "Numeric arrays").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module implements @concept{numeric arrays}:
+   arrays of packed machine numbers (8 to 64 bit integers, single and
+   double precision floats), useful to exchange large amounts of
+   numeric data with C code without converting them to and from lists.
+
+   The data of an array is stored outside the heap and never moves,
+   so that C code (see the @tt{c_int8_array}, ..., @tt{c_double_array}
+   types of the foreign interface and the @tt{ciao_numarray_*}
+   functions of the C API) can read or fill it in place through a
+   plain pointer. Arrays are referenced by ordinary (small) terms.
+   Slices (@pred{numarray_slice/4}) take constant time and share the
+   data of the original array.
+
+   Note that:
+   @begin{itemize}
+   @item Arrays are @em{mutable}: @pred{numarray_set/3} and
+     @pred{numarray_fill/2} update the data destructively (also for
+     all the slices sharing it), and the updates are not undone on
+     backtracking.
+   @item Arrays are not garbage collected: they must be released with
+     @pred{numarray_free/1}. Predicates fail on freed arrays.
+   @item Integer elements wrap around (as in C) when the values do not
+     fit in the element type.
+   @end{itemize}
+   ").
+
+:- use_module(engine(internals), [
+    '$numarray_new'/3,
+    '$numarray_from_list'/3,
+    '$numarray_to_list'/2,
+    '$numarray_get'/3,
+    '$numarray_set'/3,
+    '$numarray_fill'/2,
+    '$numarray_copy'/2,
+    '$numarray_op'/4,
+    '$numarray_reduce'/3,
+    '$numarray_free'/1]).
+
+:- regtype numarray(A) # "@var{A} is a numeric array.".
+
+numarray('$numarray'(Id, Type, Off, Len)) :-
+    int(Id), numarray_elem_type(Type), int(Off), int(Len).
+
+:- regtype numarray_elem_type(Type) # "@var{Type} is the type of the
+   elements of a numeric array.".
+
+numarray_elem_type(int8).
+numarray_elem_type(int16).
+numarray_elem_type(int32).
+numarray_elem_type(int64).
+numarray_elem_type(float32).
+numarray_elem_type(float64).
+
+check_numarray(A, _) :- A = '$numarray'(_,_,_,_), !.
+check_numarray(A, PredName) :- var(A), !,
+    throw(error(instantiation_error, PredName)).
+check_numarray(A, PredName) :-
+    throw(error(type_error(numarray, A), PredName)).
+
+check_type(Type, PredName) :- var(Type), !,
+    throw(error(instantiation_error, PredName)).
+check_type(Type, _) :- numarray_elem_type(Type), !.
+check_type(Type, PredName) :-
+    throw(error(domain_error(numarray_elem_type, Type), PredName)).
+
+:- pred numarray_new(+Type, +Length, -A)
+   :: numarray_elem_type * int * numarray
+   # "@var{A} is a new array of @var{Length} elements of type
+   @var{Type}, initialized to zero.".
+
+numarray_new(Type, Length, A) :-
+    check_type(Type, numarray_new/3),
+    '$numarray_new'(Type, Length, A).
+
+:- pred list_numarray(+Type, +List, -A)
+   :: numarray_elem_type * list(num) * numarray
+   # "@var{A} is a new array of type @var{Type} with the elements of
+   @var{List} (which must be integers for integer types).".
+
+list_numarray(Type, List, A) :-
+    check_type(Type, list_numarray/3),
+    ( '$numarray_from_list'(Type, List, A0) -> A = A0
+    ; throw(error(type_error(list(num), List), list_numarray/3))
+    ).
+
+:- pred numarray_to_list(+A, -List) :: numarray * list(num)
+   # "@var{List} is the list of elements of @var{A}.".
+
+numarray_to_list(A, List) :-
+    check_numarray(A, numarray_to_list/2),
+    '$numarray_to_list'(A, List).
+
+:- pred numarray_length(+A, ?Length) :: numarray * int
+   # "@var{Length} is the number of elements of @var{A}.".
+
+numarray_length(A, Length) :-
+    check_numarray(A, numarray_length/2),
+    A = '$numarray'(_, _, _, Length0),
+    Length = Length0.
+
+:- pred numarray_type(+A, ?Type) :: numarray * numarray_elem_type
+   # "@var{Type} is the type of the elements of @var{A}.".
+
+numarray_type(A, Type) :-
+    check_numarray(A, numarray_type/2),
+    A = '$numarray'(_, Type0, _, _),
+    Type = Type0.
+
+:- pred numarray_get(+A, +Index, -X) :: numarray * int * num
+   # "@var{X} is the element at position @var{Index} (0-based) of
+   @var{A}. Fails if @var{Index} is out of bounds.".
+
+numarray_get(A, Index, X) :-
+    check_numarray(A, numarray_get/3),
+    '$numarray_get'(A, Index, X).
+
+:- pred numarray_set(+A, +Index, +X) :: numarray * int * num
+   # "Destructively sets the element at position @var{Index}
+   (0-based) of @var{A} to @var{X}. Fails if @var{Index} is out of
+   bounds.".
+
+numarray_set(A, Index, X) :-
+    check_numarray(A, numarray_set/3),
+    '$numarray_set'(A, Index, X).
+
+:- pred numarray_fill(+A, +X) :: numarray * num
+   # "Destructively sets all the elements of @var{A} to @var{X}.".
+
+numarray_fill(A, X) :-
+    check_numarray(A, numarray_fill/2),
+    '$numarray_fill'(A, X).
+
+:- pred numarray_slice(+A, +Offset, +Length, -Slice)
+   :: numarray * int * int * numarray
+   # "@var{Slice} is the slice of @var{Length} elements of @var{A}
+   starting at @var{Offset} (0-based). It takes constant time (the
+   data is shared). Fails if the slice is out of bounds.".
+
+numarray_slice(A, Offset, Length, Slice) :-
+    check_numarray(A, numarray_slice/4),
+    A = '$numarray'(Id, Type, Off0, Len0),
+    integer(Offset), integer(Length),
+    Offset >= 0, Length >= 0, Offset + Length =< Len0,
+    Off is Off0 + Offset,
+    Slice = '$numarray'(Id, Type, Off, Length).
+
+:- pred numarray_copy(+A, -Copy) :: numarray * numarray
+   # "@var{Copy} is a new array with a copy of the elements of
+   @var{A}.".
+
+numarray_copy(A, Copy) :-
+    check_numarray(A, numarray_copy/2),
+    '$numarray_copy'(A, Copy).
+
+:- pred numarray_op(+Op, +A, +B, -C) :: atm * numarray * term * numarray
+   # "@var{C} is a new array (of the type of @var{A}) where each
+   element is the result of @var{Op} applied to the corresponding
+   elements of @var{A} and @var{B}, where @var{B} is either an array
+   with the same length as @var{A} or a number. @var{Op} is one of
+   @tt{+}, @tt{-}, @tt{*}, @tt{/}, @tt{min}, or @tt{max} (@tt{/} is
+   truncating division for integer types). The operation is computed
+   in a single loop in C.".
+
+numarray_op(Op, A, B, C) :-
+    check_numarray(A, numarray_op/4),
+    '$numarray_op'(Op, A, B, C).
+
+:- pred numarray_sum(+A, -Sum) :: numarray * num
+   # "@var{Sum} is the sum of the elements of @var{A}.".
+
+numarray_sum(A, Sum) :-
+    check_numarray(A, numarray_sum/2),
+    '$numarray_reduce'(sum, A, Sum).
+
+:- pred numarray_min(+A, -Min) :: numarray * num
+   # "@var{Min} is the smallest element of @var{A}. Fails if @var{A}
+   is empty.".
+
+numarray_min(A, Min) :-
+    check_numarray(A, numarray_min/2),
+    '$numarray_reduce'(min, A, Min).
+
+:- pred numarray_max(+A, -Max) :: numarray * num
+   # "@var{Max} is the largest element of @var{A}. Fails if @var{A}
+   is empty.".
+
+numarray_max(A, Max) :-
+    check_numarray(A, numarray_max/2),
+    '$numarray_reduce'(max, A, Max).
+
+:- pred numarray_free(+A) :: numarray
+   # "Releases the data of @var{A} (and all its slices).".
+
+numarray_free(A) :-
+    check_numarray(A, numarray_free/1),
+    '$numarray_free'(A).
@@ -0,0 +1,48 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for numarray.pl").
+
+:- use_module(library(numarray)).
+
+:- export(test_elements/0).
+:- test test_elements # "Conversion, access, slices, and wrap around".
+test_elements :-
+    list_numarray(int16, [1, -2, 3, 40000], A),
+    numarray_to_list(A, [1, -2, 3, -25536]),
+    numarray_length(A, 4),
+    numarray_type(A, int16),
+    numarray_slice(A, 1, 2, S),
+    numarray_to_list(S, [-2, 3]),
+    numarray_set(S, 0, 7),
+    numarray_get(A, 1, 7),
+    \+ numarray_get(S, 2, _),
+    numarray_new(float64, 3, F),
+    numarray_fill(F, 1.5),
+    numarray_to_list(F, [1.5, 1.5, 1.5]),
+    numarray_free(A),
+    \+ numarray_get(S, 0, _),
+    numarray_free(F).
+
+:- export(test_arith/0).
+:- test test_arith # "Element-wise operations and reductions".
+test_arith :-
+    list_numarray(float64, [1.0, 2.0, 3.0], A),
+    list_numarray(int32, [10, 20, 30], B),
+    numarray_op(+, A, B, C),
+    numarray_to_list(C, [11.0, 22.0, 33.0]),
+    numarray_op(*, B, 2, D),
+    numarray_to_list(D, [20, 40, 60]),
+    numarray_op(/, B, 7, E),
+    numarray_to_list(E, [1, 2, 4]),
+    numarray_op(max, B, D, M),
+    numarray_to_list(M, [20, 40, 60]),
+    numarray_sum(C, 66.0),
+    numarray_sum(B, 60),
+    numarray_min(A, 1.0),
+    numarray_max(B, 30),
+    catch((numarray_op(/, B, 0, _), fail), error(evaluation_error(zero_divisor), _), true),
+    numarray_copy(B, B2),
+    numarray_set(B2, 0, 0),
+    numarray_get(B, 0, 10),
+    numarray_free(A), numarray_free(B), numarray_free(B2),
+    numarray_free(C), numarray_free(D), numarray_free(E), numarray_free(M).
@@ -12,7 +12,9 @@
     initialize_db/0,
     make_persistent/2,
     update_files/0,
-    update_files/1]).
+    update_files/1,
+    sync_files/0,
+    set_sync_policy/1]).
 
 :- redefining(asserta_fact/1).
 :- redefining(assertz_fact/1).
@@ -1,13 +1,15 @@
 :- module(persdb_cache,
     [add_term_to_file/3, add_term_to_file_db/3,
      delete_bak_if_no_ops/2, delete_file1/1,
-     get_pred_files/7, keyword/1, persistent/5],
+     get_pred_files/7, keyword/1, persistent/5,
+     wal_close/1, wal_full/1, wal_set_limit/2, wal_sync/0, wal_set_policy/1],
     [assertions, datafacts]).
 
 :- use_module(engine(runtime_control), [module_split/3]).
 
 :- use_module(engine(stream_basic)).
-:- use_module(library(terms_io), [term_write/1]).
+:- use_module(library(fastrw), [fast_write/2]).
+:- use_module(engine(internals), ['$fsync_output'/1, '$stream_is_file'/2]).
 :- use_module(library(lists)).
 :- use_module(library(system)).
 :- use_module(library(system_extra), [mkpath/1]).
@@ -25,6 +27,9 @@ add_term_to_file_db(Term, Pred, FilePerms) :-
 add_term_to_file_db(_Term, _Pred, _FilePerms).
 
 % This ensure that we not create an operations file in a transient state
+delete_bak_if_no_ops(File_ops, _File_bak) :-
+    current_fact(wal_stream(File_ops, Stream, _, _)),
+    '$stream_is_file'(Stream, File_ops), !. % (open, so it exists)
 delete_bak_if_no_ops(File_ops, File_bak) :-
     ( file_exists(File_ops) -> true
     ; file_exists(File_bak) -> delete_file1(File_bak)
@@ -36,23 +41,110 @@ delete_file1(File):-
     ;
      true).
 
+% ---------------------------------------------------------------------------
+% Operations files as write-ahead logs.
+%
+% An operations file is opened on its first update and kept open
+% until the next checkpoint (see wal_close/1). Each operation is
+% appended as a fastrw record and flushed, so that it survives if the
+% process dies. Syncing to disk (fsync) is done according to the sync
+% policy: after each record (always, the default), once every N
+% records of the same file (group(N)), or only at checkpoints and
+% wal_sync/0 (none).
+%
+% The file is locked while a record is appended. If another process
+% has compacted the log in the meantime (removing the file, or
+% replacing it with a new one), the file is opened again.
+
+:- data wal_stream/4. % wal_stream(File, Stream, Unsynced, Records)
+:- data wal_policy/1.
+:- data wal_limit/2. % wal_limit(File, Records)
+
+wal_policy(always).
+
+% Compact the log into the data file after this number of records (at
+% least, or the number of facts of the predicate if larger)
+wal_checkpoint_records(10000).
+
 % add_term_to_file(Term,File,FilePerms) adds the term Term to a file
 % File (if File is created, FilePerms are applied)
 add_term_to_file(Term, File, FilePerms) :-
+    lock_file(File, FD, _),
+    wal_open(File, FilePerms, Stream, Unsynced0, Records0),
+    fast_write(Stream, Term),
+    flush_output(Stream),
+    Records is Records0 + 1,
+    ( wal_must_sync(Unsynced0) ->
+        '$fsync_output'(Stream),
+        Unsynced = 0
+    ; Unsynced is Unsynced0 + 1
+    ),
+    retract_fact(wal_stream(File, _, _, _)),
+    assertz_fact(wal_stream(File, Stream, Unsynced, Records)),
+    unlock_file(FD, _).
+
+wal_open(File, FilePerms, Stream, Unsynced, Records) :-
+    current_fact(wal_stream(File, Stream0, Unsynced0, Records0)), !,
+    ( '$stream_is_file'(Stream0, File) ->
+        Stream = Stream0, Unsynced = Unsynced0, Records = Records0
+    ; % (the log was compacted by another process)
+      retract_fact(wal_stream(File, _, _, _)),
+      close(Stream0),
+      wal_open(File, FilePerms, Stream, Unsynced, Records)
+    ).
+wal_open(File, FilePerms, Stream, 0, 0) :-
 %jcf-begin
     ( file_exists(File) ->
       true
     ; create(File, FilePerms) % just to put right permissions in File.
     ),
 %jcf-end
-    current_output(OldOutput),
-    lock_file(File, FD, _),
-    open(File,append,Stream),
-    set_output(Stream),
-    term_write(Term),
-    close(Stream),
-    unlock_file(FD, _),
-    set_output(OldOutput).
+    open(File, append, Stream),
+    assertz_fact(wal_stream(File, Stream, 0, 0)).
+
+% (Unsynced records before the current one)
+wal_must_sync(Unsynced) :-
+    current_fact(wal_policy(Policy)),
+    ( Policy = always -> true
+    ; Policy = group(N) -> Unsynced + 1 >= N
+    ; fail
+    ).
+
+% The log of File is large enough to be compacted
+wal_full(File) :-
+    current_fact(wal_stream(File, _, _, Records)),
+    ( current_fact(wal_limit(File, Max)) -> true
+    ; wal_checkpoint_records(Max)
+    ),
+    Records >= Max.
+
+% The data file of the log File has Size facts
+wal_set_limit(File, Size) :-
+    wal_checkpoint_records(Min),
+    ( Size > Min -> Max = Size ; Max = Min ),
+    retractall_fact(wal_limit(File, _)),
+    assertz_fact(wal_limit(File, Max)).
+
+% Sync and close the log of File (if open)
+wal_close(File) :-
+    ( retract_fact(wal_stream(File, Stream, Unsynced, _)) ->
+        ( Unsynced > 0 -> '$fsync_output'(Stream) ; true ),
+        close(Stream)
+    ; true
+    ).
+
+% Sync all the open logs
+wal_sync :-
+    ( retract_fact(wal_stream(File, Stream, Unsynced, Records)),
+        ( Unsynced > 0 -> '$fsync_output'(Stream) ; true ),
+        assertz_fact(wal_stream(File, Stream, 0, Records)),
+        fail
+    ; true
+    ).
+
+wal_set_policy(Policy) :-
+    retractall_fact(wal_policy(_)),
+    assertz_fact(wal_policy(Policy)).
 
 get_pred_files(Dir,DirPerms, Name, Arity, File, File_ops, File_bak):-
     add_final_slash(Dir, DIR),
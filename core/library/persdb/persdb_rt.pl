@@ -12,15 +12,19 @@
      make_persistent/2,
      update_files/0,
      update_files/1,
+     sync_files/0,
+     set_sync_policy/1,
      create/2],
     [assertions,regtypes,nortchecks,datafacts,library(persdb/persdb_decl)]).
 
 :- use_module(library(aggregates), [findall/3]).
 
 :- use_module(engine(stream_basic)).
-:- use_module(library(terms_io), [file_to_terms/3, terms_to_file/2]).
-:- use_module(engine(internals), [term_to_meta/2]).
-:- use_module(library(lists),    [select/3]).
+:- use_module(library(terms_io), [file_to_terms/3, term_write/1]).
+:- use_module(library(fastrw), [fast_read/1]).
+:- use_module(engine(io_basic), [peek_byte/2]).
+:- use_module(engine(internals), [term_to_meta/2, '$fsync_output'/1]).
+:- use_module(library(lists),    [length/2]).
 :- use_module(library(system)).
 :- use_module(library(file_locks)).
 %:- use_module(engine(basic_props)).
@@ -149,8 +153,8 @@ Copyright @copyright{} 1997-2002 The Clip Group.
 
    Predicates declared as persistent are linked to directory, and the 
    persistent state of the predicate will be kept in several files below that 
-   directory.  The files in which the persistent predicates are stored are in 
-   readable, plain ASCII format, and in Prolog syntax. One advantage of this 
+   directory.  The data files in which the persistent predicates are stored are
+   in readable, plain ASCII format, and in Prolog syntax. One advantage of this 
    approach is that such files can also be created or edited by hand, in a 
    text editor, or even by other applications.
 
@@ -199,7 +203,10 @@ persistent_dir(dbdir, '/home/clip/public_html/db').
    persistence set. However, in order to incurr only a small overhead
    in the execution, rather than changing the data file directly, a
    record of each of the insertion and deletion operations is
-   @em{appended} to the operations file. The predicate is then in a
+   @em{appended} to the operations file, which is kept open and acts
+   as a @concept{write-ahead log}. Records are written in the binary
+   format of @lib{fastrw}, and synced to disk after each update (or
+   in groups, see @pred{set_sync_policy/1}). The predicate is then in a
    @concept{transient state}, in that the contents of the data file do
    not reflect exactly the current state of the corresponding
    predicate. However, the complete persistence set does.
@@ -211,7 +218,8 @@ persistent_dir(dbdir, '/home/clip/public_html/db').
    that, if at any point the process dies, on restart the data will be
    completely recovered. This process of updating the persistence set
    can also be triggered at any point in the execution of the program
-   (for example, when halting) by calling @pred{update_files}.
+   (for example, when halting) by calling @pred{update_files}, and it
+   is done automatically when an operations file grows too large.
 
    @section{Defining an initial database}
 
@@ -289,8 +297,7 @@ passerta_fact(MPred):-
     term_to_meta(Pred, MPred),
     functor(Pred, F, N),
     current_fact(persistent(F, N, File_ops, _, File_bak, FilePerms)), !,
-    delete_bak_if_no_ops(File_ops, File_bak),
-    add_term_to_file(a(Pred), File_ops, FilePerms),
+    log_operation(a(Pred), F, N, File_ops, File_bak, FilePerms),
     datafacts_rt:asserta_fact(MPred).
 passerta_fact(MPred):-
     term_to_meta(Pred, MPred),
@@ -307,8 +314,7 @@ asserta_fact(MPred):-
     term_to_meta(Pred, MPred),
     functor(Pred, F, N),
     ( current_fact(persistent(F, N, File_ops, _, File_bak, FilePerms)) ->
-        delete_bak_if_no_ops(File_ops, File_bak),
-        add_term_to_file(a(Pred), File_ops, FilePerms)
+        log_operation(a(Pred), F, N, File_ops, File_bak, FilePerms)
     ; true),
     datafacts_rt:asserta_fact(MPred).
 
@@ -328,8 +334,7 @@ passertz_fact(MPred):-
     term_to_meta(Pred, MPred),
     functor(Pred, F, N),
     current_fact(persistent(F, N, File_ops, _, File_bak, FilePerms)), !,
-    delete_bak_if_no_ops(File_ops, File_bak),
-    add_term_to_file(z(Pred), File_ops, FilePerms),
+    log_operation(z(Pred), F, N, File_ops, File_bak, FilePerms),
     datafacts_rt:assertz_fact(MPred).
 passertz_fact(MPred):-
     term_to_meta(Pred, MPred),
@@ -346,8 +351,7 @@ assertz_fact(MPred):-
     term_to_meta(Pred, MPred),
     functor(Pred, F, N),
     ( current_fact(persistent(F, N, File_ops, _, File_bak, FilePerms)) ->
-        delete_bak_if_no_ops(File_ops, File_bak),
-        add_term_to_file(z(Pred), File_ops, FilePerms)
+        log_operation(z(Pred), F, N, File_ops, File_bak, FilePerms)
     ; true),
     datafacts_rt:assertz_fact(MPred).
 
@@ -366,9 +370,8 @@ pretract_fact(MPred):-
     term_to_meta(Pred, MPred),
     functor(Pred, F, N),
     current_fact(persistent(F, N, File_ops, _, File_bak, FilePerms)), !,
-    delete_bak_if_no_ops(File_ops, File_bak),
     datafacts_rt:retract_fact(MPred),
-    add_term_to_file(r(Pred), File_ops, FilePerms).
+    log_operation(r(Pred), F, N, File_ops, File_bak, FilePerms).
 pretract_fact(MPred):-
     term_to_meta(Pred, MPred),
     throw(error(type_error(persistent_data,Pred), pretract_fact/2-1)).
@@ -384,9 +387,8 @@ retract_fact(MPred):-
     term_to_meta(Pred, MPred),
     functor(Pred, F, N),
     ( current_fact(persistent(F, N, File_ops, _, File_bak, FilePerms)) ->
-        delete_bak_if_no_ops(File_ops, File_bak),
         datafacts_rt:retract_fact(MPred),
-        add_term_to_file(r(Pred), File_ops, FilePerms)
+        log_operation(r(Pred), F, N, File_ops, File_bak, FilePerms)
     ; datafacts_rt:retract_fact(MPred)
     ).
 
@@ -412,6 +414,15 @@ retractall_fact(MPred):-
     fail.
 retractall_fact(_).
 
+% Append an operation to the log, compacting it if it is too large
+log_operation(Op, F, N, File_ops, File_bak, FilePerms) :-
+    delete_bak_if_no_ops(File_ops, File_bak),
+    add_term_to_file(Op, File_ops, FilePerms),
+    ( wal_full(File_ops) ->
+        update_files_of(F, N)
+    ; true
+    ).
+
 :- data persistent/6.
 :- data db_initialized/0.
 
@@ -474,6 +485,7 @@ make_persistent(Spec, _Key) :-
 
 ini_persistent(P, File_ops, File, File_bak, FilePerms):- 
     term_to_meta(P, Pred),
+    wal_close(File_ops),
     lock_file(File, Fd1, _),        
     lock_file(File_ops, Fd2, _),    
     lock_file(File_bak, Fd3, _),
@@ -511,30 +523,57 @@ ini_persistent(P, File_ops, File, File_bak, FilePerms):-
 %  f+
 
 secure_update(File, File_ops, File_bak, NewTerms, FilePerms):-
-    file_to_term_list(File, Terms, Terms_),
+    file_to_term_list(File, Terms, []),
     ( file_exists(File_ops) ->
-        file_to_term_list(File_ops, Lops, []),
-        make_operations(Lops, Terms, Terms_, NewTerms),
+        file_to_op_list(File_ops, Lops),
+        make_operations(Lops, Terms, NewTerms),
         mv(File, File_bak, FilePerms),
         term_list_to_file(NewTerms, File, FilePerms),
         delete_file1(File_ops),
         delete_file1(File_bak)
-    ; Terms_ = [],
-      NewTerms = Terms
-    ).
-
-make_operations([], Terms, [], Terms).
-make_operations([Operation|Operations], Terms, Terms_, NewTerms):-
-    make_operation(Operation, Terms, Terms_, NTerms, NTerms_),
-    make_operations(Operations, NTerms, NTerms_, NewTerms).
-
-% Adds a fact to the head of the list
-make_operation(a(Pred), Terms, Terms_, [Pred|Terms], Terms_).
-% Adds a fact to the tail of the list
-make_operation(z(Pred), Terms, [Pred|Terms_], Terms, Terms_).
-% Removes the first fact which unify (exists)
-make_operation(r(Pred), Terms, Terms_, NTerms, Terms_) :-
-    select(Pred, Terms, NTerms), !.
+    ; NewTerms = Terms
+    ),
+    length(NewTerms, Size),
+    wal_set_limit(File_ops, Size).
+
+% The operations are replayed on a temporary data predicate, indexed
+% on the first argument of the facts, so that removing a fact does not
+% need to traverse all the previous ones.
+
+:- data replayed/2. % replayed(Arg1, Fact)
+
+make_operations(Operations, Terms, NewTerms) :-
+    replay_terms(Terms),
+    make_operations_(Operations),
+    findall(T, datafacts_rt:retract_fact(replayed(_, T)), NewTerms).
+
+replay_terms([]).
+replay_terms([T|Ts]) :-
+    replay_key(T, K),
+    datafacts_rt:assertz_fact(replayed(K, T)),
+    replay_terms(Ts).
+
+make_operations_([]).
+make_operations_([Operation|Operations]) :-
+    make_operation(Operation),
+    make_operations_(Operations).
+
+% Adds a fact at the beginning
+make_operation(a(Pred)) :-
+    replay_key(Pred, K),
+    datafacts_rt:asserta_fact(replayed(K, Pred)).
+% Adds a fact at the end
+make_operation(z(Pred)) :-
+    replay_key(Pred, K),
+    datafacts_rt:assertz_fact(replayed(K, Pred)).
+% Removes the first fact which unify (if any)
+make_operation(r(Pred)) :-
+    replay_key(Pred, K),
+    ( datafacts_rt:retract_fact(replayed(K, Pred)) -> true ; true ).
+
+replay_key(Pred, K) :-
+    functor(Pred, _, A),
+    ( A > 0 -> arg(1, Pred, K) ; K = [] ).
 
 % process_terms(Facts) asserts the data contained in Facts into the
 %  dynamic database
@@ -568,6 +607,7 @@ update_files(Bad) :-
 
 update_files_of(Pred, Arity) :-
     current_fact(persistent(Pred, Arity, File_ops, File, File_bak, FilePerms)),
+    wal_close(File_ops),
     lock_file(File, Fd1, _),        
     lock_file(File_ops, Fd2, _),    
     lock_file(File_bak, Fd3, _),
@@ -598,8 +638,32 @@ file_to_term_list(File, Terms, Terms_) :-
     file_to_terms(File, Terms, Terms_).
 file_to_term_list(_File, Terms, Terms).
 
+% file_to_op_list(File, Ops) reads the list of operations Ops from the
+%  operations file File. Stops at the first incomplete record (the
+%  process died while writing it).
+file_to_op_list(File, Ops) :-
+    file_exists(File, 6), !,
+    open(File, read, Stream),
+    ( peek_byte(Stream, 0'C) -> % fastrw records
+        current_input(OldInput),
+        set_input(Stream),
+        read_ops(Ops),
+        set_input(OldInput),
+        close(Stream)
+    ; close(Stream), % (text, written by older versions)
+      file_to_terms(File, Ops, [])
+    ).
+file_to_op_list(_File, []).
+
+read_ops(Ops) :-
+    ( catch(fast_read(Op), _, fail), Op \== end_of_file ->
+        Ops = [Op|Ops0],
+        read_ops(Ops0)
+    ; Ops = []
+    ).
+
 % term_list_to_file(Terms, File, FilePerms) writes a list of terms Terms onto a file
-%  File
+%  File (and syncs it to disk)
 term_list_to_file(Terms, File, FilePerms) :-
 %jcf-begin
     ( file_exists(File) ->
@@ -607,7 +671,18 @@ term_list_to_file(Terms, File, FilePerms) :-
     ; create(File, FilePerms) % just to put right permissions in File.
     ),
 %jcf-end
-    terms_to_file(Terms, File).
+    open(File, write, Stream),
+    current_output(OldOutput),
+    set_output(Stream),
+    terms_write(Terms),
+    set_output(OldOutput),
+    '$fsync_output'(Stream),
+    close(Stream).
+
+terms_write([]).
+terms_write([T|Ts]) :-
+    term_write(T),
+    terms_write(Ts).
 
 % :- pred mv(Path1, Path2, Perms) ; "Rename a file, or create target with file permisssion Perms.".
 mv(Source, Target, _FilePerms):-
@@ -630,6 +705,38 @@ create(Path, FilePerms):-
     ). 
 
 
+:- pred sync_files # "Forces all the pending updates of persistent
+   predicates to be written to disk (see @pred{set_sync_policy/1}).".
+
+sync_files :-
+    wal_sync.
+
+:- pred set_sync_policy(Policy) : sync_policy
+# "Sets the policy for writing to disk the updates of persistent
+   predicates. Updates are always written to the operations file
+   before returning (so they are kept if the program dies), but the
+   operating system may delay writing them to disk. The policy
+   specifies when to wait for the disk: after each update (@tt{always},
+   the default), after each group of @tt{N} updates of the same
+   predicate (@tt{group(N)}, e.g., @tt{group(64)}, which is much faster
+   but may lose the last @tt{N-1} updates on a system crash), or only
+   when the persistence set is updated or @pred{sync_files/0} is
+   called (@tt{none}).".
+
+set_sync_policy(Policy) :-
+    ( sync_policy(Policy) ->
+        wal_set_policy(Policy)
+    ; throw(error(domain_error(sync_policy, Policy), set_sync_policy/1-1))
+    ).
+
+:- export(sync_policy/1).
+:- regtype sync_policy(P) # "@var{P} is a policy for writing updates to
+   disk.".
+
+sync_policy(always).
+sync_policy(group(N)) :- nnegint(N).
+sync_policy(none).
+
 :- doc(doinclude, keyword/1).
 :- doc(keyword/1,"An atom which identifies a fact of the
    @pred{persistent_dir/2} relation. This fact relates this atom to a
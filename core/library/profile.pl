@@ -138,15 +138,41 @@ $ cd core/examples/general
 $ CIAODBG=profile CIAORTOPTS=\"--profile-calls --profile-roughtime\" ciaopp -A guardians.pl
 @end{verbatim}
 
+  @section{Clause counters}
+
+  Clause counters are available in every engine (no special
+  @tt{debug_level} is needed) and can be switched on and off at
+  runtime. When enabled, the emulator counts how many times each
+  clause is entered as the first alternative of a call (@em{tries})
+  and on backtracking (@em{retries}). Counters are kept per worker
+  and merged when they are queried. The overhead when disabled is a
+  single test on clause entry.
+
+@begin{verbatim}
+?- clause_counters(queens(8,Q)), print_clause_heat.
+Tries   Retries  Clause
+=====   =======  ======
+ 1876      1488  nqueens:no_attack_2/3 #2
+ ...
+@end{verbatim}
+
+  Clauses with many retries are candidates for reordering or for
+  better indexing.
 ").
 
 :- use_module(engine(internals), [
     '$profile_flags_set'/1,
     '$profile_flags_get'/1,
     '$profile_dump'/0,
-    '$profile_reset'/0
+    '$profile_reset'/0,
+    '$clause_counters_set'/1,
+    '$clause_counters_get'/1,
+    '$clause_counters_reset'/0,
+    '$clause_counters'/1
 ]).
 :- use_module(library(port_reify), [once_port_reify/2, port_call/1]).
+:- use_module(library(format), [format/2]).
+:- use_module(library(sort), [keysort/2]).
 
 % ---------------------------------------------------------------------------
 
@@ -220,3 +246,71 @@ print_profile :-
     % TODO: hardwired
     file_to_string('/tmp/ciao__profile.txt', Str),
     write_string(Str).
+
+% ---------------------------------------------------------------------------
+
+:- export(clause_counters/1).
+:- meta_predicate clause_counters(goal).
+:- pred clause_counters(G) : callable(G)
+   # "Execute @var{G} (as with @pred{once/1}) with clause counters
+     enabled, after resetting them.".
+
+clause_counters(G) :-
+    '$clause_counters_get'(Old),
+    '$clause_counters_reset',
+    '$clause_counters_set'(on),
+    once_port_reify(G, Port),
+    '$clause_counters_set'(Old),
+    port_call(Port).
+
+:- export(clause_counters_on/0).
+:- pred clause_counters_on # "Start counting clause entries.".
+clause_counters_on :- '$clause_counters_set'(on).
+
+:- export(clause_counters_off/0).
+:- pred clause_counters_off # "Stop counting clause entries (keeps
+   the collected counters).".
+clause_counters_off :- '$clause_counters_set'(off).
+
+:- export(reset_clause_counters/0).
+:- pred reset_clause_counters # "Reset all clause counters.".
+reset_clause_counters :- '$clause_counters_reset'.
+
+:- export(clause_heat/1).
+:- pred clause_heat(L) => list(L)
+   # "@var{L} is the list of
+     @tt{clause_count(Pred, N, Tries, Retries)} for each clause
+     @var{N} of @var{Pred} entered at least once, hottest clauses
+     (@var{Tries}+@var{Retries}) first.".
+
+clause_heat(L) :-
+    '$clause_counters'(L0),
+    heat_keys(L0, K0),
+    keysort(K0, K),
+    heat_values(K, [], L).
+
+heat_keys([], []).
+heat_keys([C|Cs], [Heat-C|Ks]) :-
+    C = clause_count(_, _, Tries, Retries),
+    Heat is Tries+Retries,
+    heat_keys(Cs, Ks).
+
+% (reverses, hottest first)
+heat_values([], L, L).
+heat_values([_-C|Ks], L0, L) :- heat_values(Ks, [C|L0], L).
+
+:- export(print_clause_heat/0).
+:- pred print_clause_heat
+   # "Print the clause counters through @tt{user_output}, hottest
+     clauses first.".
+
+print_clause_heat :-
+    clause_heat(L),
+    format("~w~t~8|~w~t~17|~w~n", ['Tries', 'Retries', 'Clause']),
+    format("~w~t~8|~w~t~17|~w~n", ['=====', '=======', '======']),
+    print_heat(L).
+
+print_heat([]).
+print_heat([clause_count(Pred, N, Tries, Retries)|Cs]) :-
+    format("~w~t~8|~w~t~17|~w #~w~n", [Tries, Retries, Pred, N]),
+    print_heat(Cs).
@@ -0,0 +1,84 @@
+:- module(_, [], [assertions, hiord]).
+
+:- doc(title, "Tests for the clause counters of profile.pl").
+
+:- use_module(library(profile)).
+:- use_module(library(between), [between/3]).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(lists), [member/2]).
+:- use_module(library(compiler), [use_module/1]).
+:- use_module(library(terms_io), [terms_to_file/2]).
+:- use_module(library(source_tree), [remove_dir/1]).
+:- use_module(library(pathnames), [path_concat/3]).
+:- use_module(library(system), [
+    mktemp_in_tmp/2, delete_file/1, make_directory/1, pause/1]).
+
+s(1).
+s(2).
+s(3).
+
+% Tries and retries of clause N of F/1 in this module
+count(F, N, Tries, Retries) :-
+    clause_heat(L),
+    ( member(clause_count(MF/1, N, Tries0, Retries0), L),
+      atom_concat(M, F, MF),
+      atom_concat(_, ':', M) ->
+        Tries = Tries0, Retries = Retries0
+    ; Tries = 0, Retries = 0
+    ).
+
+:- export(tries_retries/0).
+:- test tries_retries # "Tries and retries of each clause".
+
+tries_retries :-
+    clause_counters(( between(1, 5, _), findall(X, s(X), _), fail ; true )),
+    count(s, 1, 5, 0),
+    count(s, 2, 0, 5),
+    count(s, 3, 0, 5),
+    reset_clause_counters,
+    count(s, 1, 0, 0).
+
+:- export(on_off/0).
+:- test on_off # "Counters only change while they are on".
+
+on_off :-
+    reset_clause_counters,
+    clause_counters_on,
+    ( s(1) -> true ; fail ),
+    clause_counters_off,
+    ( s(1) -> true ; fail ),
+    count(s, 1, 1, 0).
+
+:- export(freed/0).
+:- test freed # "Clauses that are freed on reload lose their counts".
+
+freed :-
+    mktemp_in_tmp('profileXXXXXX', Dir),
+    delete_file(Dir),
+    make_directory(Dir),
+    path_concat(Dir, 'profile_ex.pl', Path),
+    write_ex(Path),
+    ( check_freed(Path) -> Ok = yes ; Ok = no ),
+    remove_dir(Dir),
+    Ok = yes.
+
+check_freed(Path) :-
+    M = profile_ex, % (not imported here)
+    use_module(Path),
+    reset_clause_counters,
+    clause_counters_on,
+    ( between(1, 100, _), call(M:t(_)), fail ; true ),
+    pause(1), % (modification times have a resolution of seconds)
+    % (the new clauses may reuse the memory of the old ones)
+    write_ex(Path),
+    use_module(Path),
+    ( call(M:t(_)) -> true ; fail ),
+    clause_counters_off,
+    count(t, 1, 1, 0).
+
+write_ex(Path) :-
+    terms_to_file([
+        (:- module(profile_ex, [t/1], [])),
+        t(1),
+        t(2)
+    ], Path).
@@ -0,0 +1,161 @@
+:- module(rationals, [
+    rational/1,
+    rational/3,
+    rat_eval/2,
+    rat_compare/3,
+    rat_float/2,
+    addq/6, subq/6, mulq/6, divq/6, powq/5, comq/5
+], [assertions, isomodes, regtypes]).
+
+:- doc(title, "Rational numbers").
+
+:- doc(author, "The Ciao Development Team").
+
+:- doc(module, "This module implements exact arithmetic on
+   @concept{rational numbers}. A rational number is either an integer
+   or a term @tt{'$rat'(N,D)}, where @var{N} and @var{D} are coprime
+   integers and @tt{D > 1} (i.e., the representation is normalized and
+   unique, so that rationals can be compared with @pred{==/2}).
+
+   This is the representation of rationals in the engine arithmetic:
+   @pred{is/2} and the comparison predicates accept rationals and
+   compute exactly on them (see @pred{rdiv/2} in
+   @lib{arithmetic}), so that the operations in this module reduce to
+   a single native call. @lib{clpq} uses them on its own numerator and
+   denominator pairs.
+
+   Expressions are evaluated with @pred{rat_eval/2}, e.g.:
+@begin{verbatim}
+?- rat_eval(1/3 + 1/6, Q).
+
+Q = '$rat'(1,2) ?
+
+?- rat_eval((2/3)^ -2 * 4, Q).
+
+Q = 9 ?
+@end{verbatim}
+   ").
+
+:- regtype rational(Q) # "@var{Q} is a (normalized) rational number.".
+
+rational(N) :- int(N).
+rational('$rat'(N,D)) :- int(N), int(D).
+
+:- pred rational(?Q, ?N, ?D) # "@var{Q} is the rational number
+   @var{N}/@var{D}, where @var{D} is positive and coprime with
+   @var{N}. If @var{Q} is unbound, @var{N} and @var{D} may be any
+   integers (with @var{D} non-zero) and @var{Q} is the normalized
+   rational.".
+
+rational(Q, N, D) :- nonvar(Q), !,
+    rat_leaf(Q, N, D).
+rational(Q, N, D) :-
+    integer(N), integer(D),
+    Q is rdiv(N, D).
+
+rat_leaf(N, N, 1) :- integer(N), !.
+rat_leaf('$rat'(N,D), N, D).
+
+:- pred rat_eval(+Exp, -Q) # "@var{Q} is the value of the rational
+   expression @var{Exp}, which is built from rationals and the
+   functors @tt{+/2}, @tt{-/2}, @tt{-/1}, @tt{*/2}, @tt{//2},
+   @tt{^/2} (with an integer exponent), @tt{abs/1}, @tt{min/2} and
+   @tt{max/2}.".
+
+rat_eval(X, _) :- var(X), !,
+    throw(error(instantiation_error, rat_eval/2)).
+rat_eval(N, Q) :- integer(N), !, Q = N.
+rat_eval(Q0, Q) :- Q0 = '$rat'(_,_), !, Q = Q0.
+rat_eval(X+Y, Q) :- !, rat_eval(X, A), rat_eval(Y, B), Q is A+B.
+rat_eval(X-Y, Q) :- !, rat_eval(X, A), rat_eval(Y, B), Q is A-B.
+rat_eval(-X, Q) :- !, rat_eval(X, A), Q is -A.
+rat_eval(X*Y, Q) :- !, rat_eval(X, A), rat_eval(Y, B), Q is A*B.
+rat_eval(X/Y, Q) :- !, rat_eval(X, A), rat_eval(Y, B), Q is rdiv(A, B).
+rat_eval(X^E, Q) :- integer(E), !, rat_eval(X, A),
+    rat_leaf(A, Na, Da), powq(Na, Da, E, Nc, Dc), Q is rdiv(Nc, Dc).
+rat_eval(abs(X), Q) :- !, rat_eval(X, A), Q is abs(A).
+rat_eval(min(X,Y), Q) :- !, rat_eval(X, A), rat_eval(Y, B),
+    ( A > B -> Q = B ; Q = A ).
+rat_eval(max(X,Y), Q) :- !, rat_eval(X, A), rat_eval(Y, B),
+    ( A < B -> Q = B ; Q = A ).
+rat_eval(X, _) :-
+    throw(error(type_error(evaluable, X), rat_eval/2)).
+
+:- pred rat_compare(-Order, +X, +Y) # "@var{Order} is the result of
+   comparing the values of the rational expressions @var{X} and
+   @var{Y} (@tt{<}, @tt{=} or @tt{>}).".
+
+rat_compare(Order, X, Y) :-
+    rat_eval(X, A),
+    rat_eval(Y, B),
+    ( A < B -> Order = (<)
+    ; A > B -> Order = (>)
+    ; Order = (=)
+    ).
+
+:- pred rat_float(+Exp, -F) # "@var{F} is the float nearest to the
+   value of the rational expression @var{Exp}.".
+
+rat_float(Exp, F) :-
+    rat_eval(Exp, Q),
+    F is float(Q).
+
+% ---------------------------------------------------------------------------
+% Operations on normalized numerator/denominator pairs
+
+:- pred mulq(+Na, +Da, +Nb, +Db, -Nc, -Dc) # "@var{Nc}/@var{Dc} is
+   the product of @var{Na}/@var{Da} and @var{Nb}/@var{Db}.".
+
+mulq(Na, Da, Nb, Db, Nc, Dc) :-
+    Q is '$rat'(Na,Da) * '$rat'(Nb,Db),
+    rat_leaf(Q, Nc, Dc).
+
+:- pred divq(+Na, +Da, +Nb, +Db, -Nc, -Dc) # "@var{Nc}/@var{Dc} is
+   the quotient of @var{Na}/@var{Da} and @var{Nb}/@var{Db}.".
+
+divq(Na, Da, Nb, Db, Nc, Dc) :-
+    Q is rdiv('$rat'(Na,Da), '$rat'(Nb,Db)),
+    rat_leaf(Q, Nc, Dc).
+
+:- pred addq(+Na, +Da, +Nb, +Db, -Nc, -Dc) # "@var{Nc}/@var{Dc} is
+   the sum of @var{Na}/@var{Da} and @var{Nb}/@var{Db}.".
+
+addq(Na, Da, Nb, Db, Nc, Dc) :-
+    Q is '$rat'(Na,Da) + '$rat'(Nb,Db),
+    rat_leaf(Q, Nc, Dc).
+
+:- pred subq(+Na, +Da, +Nb, +Db, -Nc, -Dc) # "@var{Nc}/@var{Dc} is
+   the difference of @var{Na}/@var{Da} and @var{Nb}/@var{Db}.".
+
+subq(Na, Da, Nb, Db, Nc, Dc) :-
+    Q is '$rat'(Na,Da) - '$rat'(Nb,Db),
+    rat_leaf(Q, Nc, Dc).
+
+:- pred powq(+Na, +Da, +E, -Nc, -Dc) # "@var{Nc}/@var{Dc} is
+   @var{Na}/@var{Da} to the (integer) power @var{E}.".
+
+% (powers of coprime integers are coprime)
+powq(Na, Da, E, Nc, Dc) :- E >= 0, !,
+    ipow(Na, E, Nc),
+    ipow(Da, E, Dc).
+powq(Na, Da, E, Nc, Dc) :-
+    E1 is -E,
+    divq(1, 1, Na, Da, Nb, Db),
+    powq(Nb, Db, E1, Nc, Dc).
+
+ipow(_, 0, P) :- !, P = 1.
+ipow(B, 1, P) :- !, P = B.
+ipow(B, E, P) :-
+    E2 is E >> 1,
+    ipow(B, E2, P2),
+    ( E /\ 1 =:= 0 -> P is P2*P2 ; P is P2*P2*B ).
+
+:- pred comq(+Na, +Da, +Nb, +Db, -Order) # "@var{Order} is the
+   result of comparing @var{Na}/@var{Da} and @var{Nb}/@var{Db}.".
+
+comq(Na, Da, Nb, Db, Order) :-
+    ( Da =:= Db ->
+        compare(Order, Na, Nb)
+    ; '$rat'(Na,Da) < '$rat'(Nb,Db) -> Order = (<)
+    ; Order = (>) % (normalized, so different denominators are different values)
+    ).
@@ -0,0 +1,57 @@
+:- module(_, [], [assertions, nativeprops]).
+
+:- doc(title, "Tests for rationals.pl").
+
+:- use_module(library(rationals)).
+
+:- export(eval/0).
+:- test eval # "Evaluation of rational expressions".
+
+eval :-
+    rat_eval(1/3 + 1/6, '$rat'(1,2)),
+    rat_eval(1/3 * 3, 1),
+    rat_eval((2/3)^ -2 * 4, 9),
+    rat_eval(-(6/4) - '$rat'(1,2), -2),
+    rat_eval(max(1/3, 2/7) - min(1/3, 2/7), '$rat'(1,21)),
+    rat_eval(abs(5 / -10), '$rat'(1,2)),
+    catch(rat_eval(1/(1/2 - '$rat'(1,2)), _), E, true),
+    E = error(evaluation_error(zero_divisor), _).
+
+:- export(construct/0).
+:- test construct # "Construction and decomposition of rationals".
+
+construct :-
+    rational(Q, 10, -4), Q == '$rat'(-5,2),
+    rational('$rat'(3,7), 3, 7),
+    rational(12, 12, 1),
+    rational(R, 6, 3), R == 2.
+
+:- export(comparison/0).
+:- test comparison # "Comparison of rationals".
+
+comparison :-
+    rat_compare(>, 1/3, 2/7),
+    rat_compare(<, -1/3, 1/7),
+    rat_compare(=, 2/6, 1/3),
+    rat_compare(<, '$rat'(-7,3), -2).
+
+:- export(harmonic/0).
+:- test harmonic # "Sums of large rationals stay normalized".
+
+% (H(n) = sum(1/k), the numerator of H(100) has 41 digits)
+harmonic :-
+    harmonic_(100, 0, H),
+    H = '$rat'(N, D),
+    number_codes(N, Cs), length_(Cs, 0, 41),
+    1 =:= gcd(N, D),
+    rat_eval(H - H, 0),
+    rat_float(H, F), F > 5.18, F < 5.19.
+
+harmonic_(0, H, H) :- !.
+harmonic_(K, H0, H) :-
+    rat_eval(H0 + 1/K, H1),
+    K1 is K - 1,
+    harmonic_(K1, H1, H).
+
+length_([], N, N).
+length_([_|Xs], N0, N) :- N1 is N0 + 1, length_(Xs, N1, N).
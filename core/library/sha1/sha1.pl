@@ -2,18 +2,23 @@
     [
         sha1/2
     ], 
-    [foreign_interface, assertions, isomodes]).
+    [assertions, isomodes]).
 
 :- doc(title, "SHA-1 implementation").
 :- doc(author, "Jos@'{e} Manuel G@'{o}mez P@'{e}rez").
 
 :- doc(module, "This module provides predicates for generating
-    hash keys according to SHA-1 specifications").
+    hash keys according to SHA-1 specifications (see also
+    @lib{digest}).").
 
-:- trust pred sha1(in(String), go(Key)) :: 
-    string * string + (foreign(sha1_c),returns(Key)) #
+:- use_module(library(digest), [digest/3]).
+
+:- pred sha1(+String, -Key) :: string * string #
 
     "@var{Key} is the corresponding key of string @var{String}
-    according to the SHA-1 algorithm.".
+    according to the SHA-1 algorithm, as a string of 40 hexadecimal
+    codes.".
 
-:- use_foreign_source(sha1_c).
+sha1(String, Key) :-
+    digest(sha1, String, Key0),
+    atom_codes(Key0, Key).
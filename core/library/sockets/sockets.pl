@@ -6,9 +6,19 @@
     select_socket/5,
     socket_send/3,
     socket_sendall/2,
+    socket_sendall_list/2,
     socket_send_stream/2,
+    socket_send_file/4,
     socket_recv/3,
     socket_shutdown/2,
+    socket_evloop_new/2,
+    socket_evloop_max_content/2,
+    socket_evloop_wait/3,
+    socket_evloop_resume/2,
+    socket_evloop_release/2,
+    socket_evloop_send/4,
+    socket_evloop_wake/1,
+    socket_evloop_close/2,
     % socket_buffering/4,
     hostname_address/2,
     socket_getpeername/2,
@@ -121,12 +131,29 @@ connect_to_socket(Hostname, Port, Stream):-
    # "Sends all @var{Bytes} to the socket associated to @var{Stream}. The
    socket has to be in connected state.".
 
+:- trust pred socket_sendall_list(+Stream, +ByteLists)
+   :: stream * list(bytelist)
+   + foreign_low(prolog_socket_sendall_list)
+   # "Like @pred{socket_sendall/2} on the concatenation of the byte
+   lists in @var{ByteLists}, but sending them in as few system calls
+   as possible (useful to send a header and a body together).".
+
 :- trust pred socket_send_stream(+Stream, +FromStream) :: stream * stream
    + foreign_low(prolog_socket_send_stream)
    # "Sends all bytes from stream @var{FromStream} to the socket
    associated to @var{Stream}. The socket has to be in connected
    state. @var{FromStream} cannot be a socket stream".
 
+:- trust pred socket_send_file(+Stream, +Path, +Offset, +Length)
+   :: stream * atm * int * int
+   + foreign_low(prolog_socket_send_file)
+   # "Sends @var{Length} bytes of the file at @var{Path}, starting at
+   byte @var{Offset}, to the socket associated to @var{Stream}. A
+   negative @var{Length} sends up to the end of the file. The data is
+   sent by the kernel with @tt{sendfile()} where available (or from a
+   memory mapping of the file otherwise), without copying it to
+   Prolog terms or user-space buffers.".
+
 :- trust pred socket_recv(+Stream, ?Bytes, ?Length)
    :: stream * bytelist * int 
    + foreign_low(prolog_socket_receive)
@@ -134,6 +161,93 @@ connect_to_socket(Hostname, Port, Stream):-
    @var{Stream}, and returns its @var{Length}. For TCP, @var{Length}
    is 0 if the peer has performed an orderly shutdown on the socket.".
 
+% ---------------------------------------------------------------------------
+:- doc(section, "Event loop for servers").
+
+:- trust pred socket_evloop_new(+Socket, -Loop) :: int * int
+   + foreign_low(prolog_socket_evloop_new)
+   # "Creates an event loop @var{Loop} for the listening socket
+   @var{Socket} (as obtained from @pred{bind_socket/3}).
+   @cindex{event loop} The event loop watches the socket and all the
+   connections accepted from it, using @tt{epoll()} where available
+   (and @tt{poll()} otherwise), so that the number of connections is
+   not limited by @tt{FD_SETSIZE} as in @pred{select_socket/5}. Data
+   is read without blocking and buffered per connection until a
+   complete HTTP request (header and @tt{Content-Length} bytes of
+   content, or content with the @tt{chunked} transfer coding, which
+   is decoded) is available, so that a slow client never blocks the
+   server.".
+
+:- trust pred socket_evloop_max_content(+Loop, +Bytes) :: int * int
+   + foreign_low(prolog_socket_evloop_max_content)
+   # "Sets to @var{Bytes} the maximum length of the content of the
+   requests read by @var{Loop} (16MB by default). Larger requests are
+   rejected (see @pred{socket_evloop_wait/3}) as soon as their header
+   is read, or when the chunked content grows past the limit.".
+
+:- trust pred socket_evloop_wait(+Loop, +TO_ms, -Events)
+   :: int * term * list(term)
+   + foreign_low(prolog_socket_evloop_wait)
+   # "Accepts new connections and reads available data, waiting at
+   most @var{TO_ms} milliseconds (or forever if @var{TO_ms} is
+   @tt{off}). @var{Events} is a (possibly empty) list of
+   @tt{request(Stream, Header, Content, KeepAlive)} terms, where
+   @var{Header} is the list of bytes of the request line and header
+   fields (including the final empty line), @var{Content} the bytes
+   of the message body and @var{KeepAlive} is @tt{true} if the
+   client wants to reuse the connection; of
+   @tt{rejected(Stream, Status)} terms for requests that cannot be
+   read, where @var{Status} is the HTTP status code that should be
+   answered before closing the connection (e.g., 413 if the content is
+   too large, 431 if the header is, 400 for malformed framing and 501
+   for transfer codings other than @tt{chunked}); and of
+   @tt{closed(Stream)} terms for connections closed by the
+   peer. Accepting new connections is delayed for a while when the
+   process runs out of file descriptors. The connection of an event
+   is no longer watched until @pred{socket_evloop_resume/2} or
+   @pred{socket_evloop_release/2} is called on it.".
+
+:- trust pred socket_evloop_resume(+Loop, +Stream) :: int * stream
+   + foreign_low(prolog_socket_evloop_resume)
+   # "Watches again the connection @var{Stream}, after answering a
+   request that should keep it alive. Pipelined requests already
+   received are returned by the next @pred{socket_evloop_wait/3}.".
+
+:- trust pred socket_evloop_release(+Loop, +Stream) :: int * stream
+   + foreign_low(prolog_socket_evloop_release)
+   # "Removes the connection @var{Stream} from @var{Loop}. The stream
+   must be closed afterwards with @pred{close/1}.".
+
+:- trust pred socket_evloop_send(+Loop, +Stream, +Parts, +KeepAlive)
+   :: int * stream * list(term) * atm
+   + foreign_low(prolog_socket_evloop_send)
+   # "Queues the response to the request of the connection
+   @var{Stream} and sends it without blocking: what cannot be sent
+   at once is sent by the next calls to @pred{socket_evloop_wait/3},
+   in a single @tt{sendmsg()} call for all the queued parts when
+   possible. @var{Parts} is a list of lists of bytes and
+   @tt{file(Path, Offset, Length)} terms for ranges of files (which
+   are mapped instead of read). When the whole response is sent the
+   connection is watched again (as with @pred{socket_evloop_resume/2})
+   if @var{KeepAlive} is @tt{true}; otherwise, or if it cannot be
+   sent, a @tt{closed(Stream)} event is returned.".
+
+:- trust pred socket_evloop_wake(+Loop) :: int
+   + foreign_low(prolog_socket_evloop_wake)
+   # "Makes the current (or next) @pred{socket_evloop_wait/3} of
+   @var{Loop} return. It can be called from other threads, e.g., when
+   they have a response ready for @pred{socket_evloop_send/4}.".
+
+:- trust pred socket_evloop_close(+Loop, -Streams) :: int * list(stream)
+   + foreign_low(prolog_socket_evloop_close)
+   # "Destroys @var{Loop}, returning in @var{Streams} the connections
+   that were still open (which must be closed with @pred{close/1}),
+   after sending their pending output (waiting at most one second).
+   The listening socket is restored to its original (blocking)
+   mode.".
+
+% ---------------------------------------------------------------------------
+
 :- trust pred socket_shutdown(+Stream, +How)
    :: stream * shutdown_type
    + foreign_low(prolog_socket_shutdown)
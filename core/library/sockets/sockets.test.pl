@@ -0,0 +1,136 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for the event loop of sockets.pl").
+
+:- doc(module, "Sends HTTP requests to an event loop from client
+   sockets in the same process (connections are completed by the
+   kernel before they are accepted), and checks how they are
+   framed.").
+
+:- use_module(library(sockets)).
+:- use_module(engine(stream_basic)).
+:- use_module(library(lists), [append/3]).
+
+:- export(chunked/0).
+:- test chunked # "Chunked content is decoded".
+
+chunked :-
+    with_loop(16, check_chunked).
+
+check_chunked(Loop, Port) :-
+    send_request(Port, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6;x=y\r\n world\r\n0\r\nX-Trailer: 1\r\n\r\n", S),
+    wait_events(Loop, [request(_, _, Content, true)]),
+    Content = "hello world",
+    close(S).
+
+:- export(content_length/0).
+:- test content_length # "Content of the length in the header".
+
+content_length :-
+    with_loop(16, check_content_length).
+
+check_content_length(Loop, Port) :-
+    send_request(Port, "POST / HTTP/1.0\r\nContent-Length: 3\r\n\r\nabcGET /", S),
+    wait_events(Loop, [request(_, _, Content, false)]),
+    Content = "abc",
+    close(S).
+
+:- export(too_large/0).
+:- test too_large # "Requests with too large content are rejected".
+
+too_large :-
+    with_loop(16, check_too_large).
+
+check_too_large(Loop, Port) :-
+    send_request(Port, "POST / HTTP/1.1\r\nContent-Length: 17\r\n\r\n", S1),
+    wait_events(Loop, [rejected(_, 413)]),
+    send_request(Port, "POST / HTTP/1.1\r\nContent-Length: 100000000000000000000000000000\r\n\r\n", S2),
+    wait_events(Loop, [rejected(_, 413)]),
+    send_request(Port, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n10\r\n0123456789abcdef\r\n1\r\n", S3),
+    wait_events(Loop, [rejected(_, 413)]),
+    close(S1), close(S2), close(S3).
+
+:- export(bad_framing/0).
+:- test bad_framing # "Requests that cannot be framed are rejected".
+
+bad_framing :-
+    with_loop(16, check_bad_framing).
+
+check_bad_framing(Loop, Port) :-
+    send_request(Port, "POST / HTTP/1.1\r\nContent-Length: 1x\r\n\r\n", S1),
+    wait_events(Loop, [rejected(_, 400)]),
+    send_request(Port, "POST / HTTP/1.1\r\nTransfer-Encoding: gzip\r\n\r\n", S2),
+    wait_events(Loop, [rejected(_, 501)]),
+    send_request(Port, "POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\nContent-Length: 1\r\n\r\n", S3),
+    wait_events(Loop, [rejected(_, 400)]),
+    close(S1), close(S2), close(S3).
+
+:- export(send/0).
+:- test send # "Responses are sent from the event loop, and the
+   connection is reported as closed afterwards".
+
+send :-
+    with_loop(16, check_send).
+
+check_send(Loop, Port) :-
+    send_request(Port, "GET / HTTP/1.0\r\n\r\n", S),
+    wait_events_(50, Loop, [request(C, _, _, false)]),
+    socket_evloop_send(Loop, C, ["HTTP/1.0 200 OK\r\n\r\n", "ok"], false),
+    wait_events(Loop, [closed(C)]),
+    recv_all(S, Response),
+    Response = "HTTP/1.0 200 OK\r\n\r\nok",
+    close(S).
+
+recv_all(S, Bytes) :-
+    socket_recv(S, Chunk, Len),
+    ( Len =:= 0 -> Bytes = []
+    ; append(Chunk, Bytes1, Bytes),
+      recv_all(S, Bytes1)
+    ).
+
+% Call Check(Loop, Port) with an event loop whose content limit is Max
+with_loop(Max, Check) :-
+    bind_socket(Port, 5, Socket),
+    socket_evloop_new(Socket, Loop),
+    socket_evloop_max_content(Loop, Max),
+    ( catch(call_check(Check, Loop, Port), _, fail) -> Ok = yes ; Ok = no ),
+    socket_evloop_close(Loop, Streams),
+    close_all(Streams),
+    Ok = yes.
+
+call_check(check_chunked, Loop, Port) :- check_chunked(Loop, Port).
+call_check(check_content_length, Loop, Port) :- check_content_length(Loop, Port).
+call_check(check_too_large, Loop, Port) :- check_too_large(Loop, Port).
+call_check(check_bad_framing, Loop, Port) :- check_bad_framing(Loop, Port).
+call_check(check_send, Loop, Port) :- check_send(Loop, Port).
+
+send_request(Port, Bytes, S) :-
+    connect_to_socket(localhost, Port, S),
+    socket_sendall(S, Bytes).
+
+% Wait (at most 5 seconds) for some events, and release their
+% connections
+wait_events(Loop, Events) :-
+    wait_events_(50, Loop, Events0),
+    Events = Events0,
+    release_all(Events0, Loop).
+
+wait_events_(N, Loop, Events) :-
+    N > 0,
+    socket_evloop_wait(Loop, 100, Events0),
+    ( Events0 = [_|_] -> Events = Events0
+    ; N1 is N - 1,
+      wait_events_(N1, Loop, Events)
+    ).
+
+release_all([], _).
+release_all([E|Es], Loop) :-
+    arg(1, E, S),
+    socket_evloop_release(Loop, S),
+    close(S),
+    release_all(Es, Loop).
+
+close_all([]).
+close_all([S|Ss]) :-
+    close(S),
+    close_all(Ss).
@@ -11,14 +11,25 @@
 #endif
 #include <sys/types.h>
 #include <sys/time.h>
+#include <time.h>
 #include <sys/socket.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
 #include <netinet/tcp.h>
 #include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#if defined(LINUX)
+#include <sys/epoll.h>
+#include <sys/sendfile.h>
+#endif
 
 
 #include <stdio.h>
+#include <ctype.h>
 void perror(const char *s);
 
 #include <errno.h>
@@ -349,16 +360,24 @@ CBOOL__PROTO(prolog_select_socket) {
 
 /* TODO: use another buffer? share with part of prolog_constant_codes */
 
-/* Copy list X(ci) to the atom buffer, return its length */
-static CFUN__PROTO(bytelist_to_atmbuf, intmach_t, intmach_t ci,
+/* Copy list X(ci) to the atom buffer starting at offset 'start',
+   return the total length */
+static CFUN__PROTO(bytelist_to_atmbuf, intmach_t, intmach_t ci, intmach_t start,
                    char *err__name, intmach_t err__arity) {
   tagged_t cdr, car;
   int msglen;
   unsigned char *buffpt;
   DEREF(X(ci), X(ci));
   cdr = X(ci);
-  buffpt = (unsigned char *)Atom_Buffer;
-  for (msglen=0; cdr!=atom_nil; msglen++) {
+  while (start > Atom_Buffer_Length) {
+    Atom_Buffer = checkrealloc_ARRAY(char,
+                                     Atom_Buffer_Length,
+                                     Atom_Buffer_Length<<1,
+                                     Atom_Buffer);
+    Atom_Buffer_Length <<= 1;
+  }
+  buffpt = (unsigned char *)Atom_Buffer+start;
+  for (msglen=start; cdr!=atom_nil; msglen++) {
     if (IsVar(cdr)) {
       BUILTIN_ERROR(ERR_instantiation_error,atom_nil,ci+1);
     } else if (!TaggedIsLST(cdr)) {
@@ -386,12 +405,28 @@ static CFUN__PROTO(bytelist_to_atmbuf, intmach_t, intmach_t ci,
 }
 
 /* Send all bytes from buffer, returns len on success and -1 on error */
+/* Wait until a (non-blocking) socket can be written again */
+static int wait_writable(int sockfd) {
+  struct pollfd pfd;
+  int n;
+  pfd.fd = sockfd;
+  pfd.events = POLLOUT;
+  do {
+    n = poll(&pfd, 1, -1);
+  } while (n < 0 && errno == EINTR);
+  return n < 0 ? -1 : 0;
+}
+
 ssize_t sendall(int sockfd, const unsigned char *buf, size_t len) {
   ssize_t bytes_sent = 0;
   ssize_t n = 0;
   while (len > 0) {
     n = send(sockfd, buf+bytes_sent, len, 0);
-    if (n == -1) return -1;
+    if (n == -1) {
+      if (errno == EINTR) continue;
+      if ((errno == EAGAIN || errno == EWOULDBLOCK) && wait_writable(sockfd) == 0) continue;
+      return -1;
+    }
     bytes_sent += n;
     len -= n;
   }
@@ -411,7 +446,7 @@ CBOOL__PROTO(prolog_socket_send) {
   if (s->streammode != 's')
     USAGE_FAULT("socket_send/3: first argument must be a socket stream");
 
-  msglen = CFUN__EVAL(bytelist_to_atmbuf, 1, err__name, err__arity);
+  msglen = CFUN__EVAL(bytelist_to_atmbuf, 1, 0, err__name, err__arity);
   unsigned char *buffpt = (unsigned char *)Atom_Buffer;
 
   bytes_sent = send(GetSmall(s->label), buffpt, msglen, 0);
@@ -435,7 +470,7 @@ CBOOL__PROTO(prolog_socket_sendall) {
   if (s->streammode != 's')
     USAGE_FAULT("socket_sendall/2: first argument must be a socket stream");
 
-  msglen = CFUN__EVAL(bytelist_to_atmbuf, 1, err__name, err__arity);
+  msglen = CFUN__EVAL(bytelist_to_atmbuf, 1, 0, err__name, err__arity);
   unsigned char *buffpt = (unsigned char *)Atom_Buffer;
 
   bytes_sent = sendall(GetSmall(s->label), buffpt, msglen);
@@ -480,6 +515,75 @@ CBOOL__PROTO(prolog_socket_send_stream) {
   return TRUE;
 }
 
+/* Send Len bytes of file fd (from Off) to the socket (zero-copy),
+   returns 0 on success and -1 on error */
+static int sendfile_range(int sockfd, int fd, off_t off, size_t len) {
+#if defined(LINUX)
+  ssize_t n;
+  while (len > 0) {
+    n = sendfile(sockfd, fd, &off, len);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      if ((errno == EAGAIN || errno == EWOULDBLOCK) && wait_writable(sockfd) == 0) continue;
+      return -1;
+    }
+    if (n == 0) break; /* file truncated */
+    len -= n;
+  }
+  return 0;
+#else
+  /* Map the file instead of copying it through a buffer */
+  off_t page_off;
+  void *addr;
+  ssize_t n;
+  if (len == 0) return 0;
+  page_off = off % sysconf(_SC_PAGESIZE);
+  addr = mmap(NULL, len + page_off, PROT_READ, MAP_PRIVATE, fd, off - page_off);
+  if (addr == MAP_FAILED) return -1;
+  n = sendall(sockfd, (unsigned char *)addr + page_off, len);
+  munmap(addr, len + page_off);
+  return n < 0 ? -1 : 0;
+#endif
+}
+
+/* socket_send_file(+Stream, +Path, +Offset, +Length) */
+CBOOL__PROTO(prolog_socket_send_file) {
+  ERR__FUNCTOR("sockets:socket_send_file", 4);
+  stream_node_t *s;
+  int fd, errcode, res;
+  struct stat st;
+  intmach_t off, len;
+
+  s = stream_to_ptr_check(X(0), 'w', &errcode);
+  if (!s) BUILTIN_ERROR(errcode, X(0), 1);
+  if (s->streammode != 's')
+    USAGE_FAULT("socket_send_file/4: first argument must be a socket stream");
+  DEREF(X(1), X(1));
+  if (!TaggedIsATM(X(1))) BUILTIN_ERROR(ERR_type_error(atom), X(1), 2);
+  DEREF(X(2), X(2));
+  if (!TaggedIsSmall(X(2))) BUILTIN_ERROR(ERR_type_error(integer), X(2), 3);
+  DEREF(X(3), X(3));
+  if (!TaggedIsSmall(X(3))) BUILTIN_ERROR(ERR_type_error(integer), X(3), 4);
+  off = GetSmall(X(2));
+  len = GetSmall(X(3));
+
+  fd = open(GetString(X(1)), O_RDONLY);
+  if (fd < 0) BUILTIN_ERROR(ERR_existence_error(source_sink), X(1), 2);
+  if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+    close(fd);
+    BUILTIN_ERROR(ERR_domain_error(source_sink), X(1), 2);
+  }
+  /* Clip the range to the file size */
+  if (off < 0 || off > st.st_size) off = st.st_size;
+  if (len < 0 || len > st.st_size - off) len = st.st_size - off;
+
+  res = sendfile_range(GetSmall(s->label), fd, off, len);
+  close(fd);
+  if (res < 0)
+    MAJOR_FAULT("socket_send_file/4: send() call failed");
+  return TRUE;
+}
+
 /* socket_recv(+Stream, ?Bytes, ?Length).  Needs socket in connected state. */
 
 CBOOL__PROTO(prolog_socket_receive) {
@@ -531,6 +635,1083 @@ CBOOL__PROTO(prolog_socket_receive) {
 }
 
 
+/* socket_sendall_list(+Stream, +ByteLists) */
+
+/* Like socket_sendall/2 on the concatenation of ByteLists, but with a
+   single send loop (instead of one syscall per part). */
+
+CBOOL__PROTO(prolog_socket_sendall_list) {
+  ERR__FUNCTOR("sockets:socket_sendall_list", 2);
+  stream_node_t *s;
+  tagged_t car, cdr;
+  intmach_t len;
+  int errcode;
+
+  s = stream_to_ptr_check(X(0), 'w', &errcode);
+  if (!s) BUILTIN_ERROR(errcode, X(0), 1);
+  if (s->streammode != 's')
+    USAGE_FAULT("socket_sendall_list/2: first argument must be a socket stream");
+
+  /* Concatenate all chunks in the atom buffer (X(2) holds the chunk) */
+  len = 0;
+  DEREF(cdr, X(1));
+  while (cdr != atom_nil) {
+    if (IsVar(cdr)) BUILTIN_ERROR(ERR_instantiation_error, X(1), 2);
+    if (!TaggedIsLST(cdr)) BUILTIN_ERROR(ERR_type_error(list), X(1), 2);
+    DerefCar(car, cdr);
+    DerefCdr(cdr, cdr);
+    X(3) = cdr;
+    X(2) = car;
+    len = CFUN__EVAL(bytelist_to_atmbuf, 2, len, err__name, err__arity);
+    cdr = X(3);
+  }
+
+  if (sendall(GetSmall(s->label), (unsigned char *)Atom_Buffer, len) < 0)
+    MAJOR_FAULT("socket_sendall_list/2: send() call failed");
+
+  return TRUE;
+}
+
+/* --------------------------------------------------------------------------- */
+/* Event loop for servers (HTTP request framing) */
+
+/* An event loop watches a listening socket and all the connections
+   accepted from it, using epoll() where available (poll()
+   otherwise), so that there is no FD_SETSIZE limit. Incoming data is
+   read without blocking into a per-connection buffer until a complete
+   HTTP request (header plus Content-Length bytes, or a chunked body,
+   which is decoded in place) is available; only then the request is
+   returned to Prolog. Requests whose content is larger than the limit
+   of the loop, or that cannot be framed, are rejected (with the HTTP
+   status that should be answered) as soon as it is known. A
+   connection with a delivered request is not watched until it is
+   resumed (keep-alive) or released (before closing it).
+
+   Responses are queued per connection (see socket_evloop_send/4) and
+   sent without blocking, with a single sendmsg() call (i.e., writev())
+   for all the queued parts when possible. Files are mapped instead of
+   read. Other threads can wake up a loop that is waiting (see
+   socket_evloop_wake/1), e.g., when they have a response ready. */
+
+/* Queued output (data is in a mapping of a file if map != NULL) */
+typedef struct evout_ evout_t;
+struct evout_ {
+  evout_t *next;
+  unsigned char *data;
+  size_t len;
+  size_t off; /* (already sent) */
+  void *map;
+  size_t map_len;
+};
+
+typedef struct evconn_ evconn_t;
+struct evconn_ {
+  stream_node_t *stream; /* NULL if the slot is free */
+  unsigned char *buf;
+  size_t len;
+  size_t cap;
+  bool_t paused; /* a request was delivered and not yet answered */
+  bool_t eof; /* peer closed the connection */
+  bool_t watched; /* waiting for input */
+  bool_t writing; /* waiting to send queued output */
+  int events; /* (registered with epoll) */
+  evout_t *out; /* queued output */
+  bool_t keep_after; /* resume after sending the output (or finish) */
+  bool_t finished; /* output sent or failed, report as closed */
+  /* Framing of the first request in buf */
+  size_t hlen; /* header length (0 if the header is not complete) */
+  size_t clen; /* content length (decoded, for chunked content) */
+  bool_t keep; /* keep-alive */
+  bool_t chunked; /* Transfer-Encoding: chunked */
+  bool_t trailer; /* last chunk seen, reading the trailer */
+  bool_t done; /* chunked content complete */
+  size_t dec; /* end of the decoded chunked content */
+  size_t raw; /* next (not decoded) chunked content */
+  size_t trail; /* trailer length */
+};
+
+typedef struct evloop_ evloop_t;
+struct evloop_ {
+  int listen_fd;
+  int listen_flags; /* (restored on close) */
+  int wake_rd; /* (self-pipe for socket_evloop_wake/1) */
+  int wake_wr;
+  int epfd; /* -1 if poll() is used */
+  evconn_t *conns; /* indexed by file descriptor */
+  int conns_size;
+  size_t max_content; /* larger requests are rejected (413) */
+  bool_t listen_paused; /* out of file descriptors */
+  int64_t listen_resume; /* (monotonic time in ms) */
+};
+
+#define EVLOOP_READ_CHUNK 16384
+#define EVLOOP_MAX_HEADER (64*1024)
+#define EVLOOP_MAX_CHUNK_LINE 8192
+#define EVLOOP_MAX_EVENTS 256
+#define EVLOOP_MAX_CONTENT (16*1024*1024)
+/* (so that the heap needed for a request never overflows) */
+#define EVLOOP_MAX_CONTENT_LIMIT ((size_t)INTMACH_MAX / (LSTCELLS*sizeof(tagged_t)) / 4)
+/* Heap cells for the events of one call (at least one is returned) */
+#define EVLOOP_HEAP_BUDGET (4*1024*1024)
+/* Delay before accepting again when out of file descriptors (ms) */
+#define EVLOOP_ACCEPT_BACKOFF 100
+/* Parts of the output sent in one call */
+#define EVLOOP_MAX_IOV 64
+/* Time to send pending output when the loop is closed (ms) */
+#define EVLOOP_CLOSE_FLUSH 1000
+
+#if defined(MSG_NOSIGNAL)
+#define EVLOOP_NOSIGNAL MSG_NOSIGNAL
+#else
+#define EVLOOP_NOSIGNAL 0
+#endif
+
+static int64_t evloop_now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+/* Maximum buffered data of a connection (a request that is not
+   complete by then is rejected) */
+static size_t evloop_max_buffer(evloop_t *l) {
+  return EVLOOP_MAX_HEADER + 2*(l->max_content + EVLOOP_MAX_CHUNK_LINE) + EVLOOP_READ_CHUNK;
+}
+
+/* Register the events that the connection waits for (for epoll) */
+static void evloop_update(evloop_t *l, int fd) {
+#if defined(LINUX)
+  evconn_t *c = &l->conns[fd];
+  int events = (c->watched ? EPOLLIN : 0) | (c->writing ? EPOLLOUT : 0);
+  if (l->epfd >= 0 && events != c->events) {
+    struct epoll_event ev;
+    ev.events = events;
+    ev.data.fd = fd;
+    epoll_ctl(l->epfd,
+              c->events == 0 ? EPOLL_CTL_ADD :
+              events == 0 ? EPOLL_CTL_DEL : EPOLL_CTL_MOD,
+              fd, &ev);
+  }
+  c->events = events;
+#endif
+}
+
+static void evloop_watch(evloop_t *l, int fd, bool_t on) {
+  if (l->conns[fd].watched == on) return;
+  l->conns[fd].watched = on;
+  evloop_update(l, fd);
+}
+
+/* Stop (or resume) accepting connections */
+static void evloop_listen(evloop_t *l, bool_t on) {
+  if (l->listen_paused != on) return;
+  l->listen_paused = !on;
+#if defined(LINUX)
+  if (l->epfd >= 0) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = l->listen_fd;
+    epoll_ctl(l->epfd, on ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, l->listen_fd, &ev);
+  }
+#endif
+}
+
+static evconn_t *evloop_conn(evloop_t *l, int fd) {
+  if (fd >= l->conns_size) {
+    int size = l->conns_size;
+    int new_size = size;
+    while (fd >= new_size) new_size <<= 1;
+    l->conns = checkrealloc_ARRAY(evconn_t, size, new_size, l->conns);
+    memset(l->conns + size, 0, (new_size - size) * sizeof(evconn_t));
+    l->conns_size = new_size;
+  }
+  return &l->conns[fd];
+}
+
+/* Forget the framing of the first request */
+static void evloop_unframe(evconn_t *c) {
+  c->hlen = 0;
+  c->clen = 0;
+  c->chunked = FALSE;
+  c->trailer = FALSE;
+  c->done = FALSE;
+  c->trail = 0;
+}
+
+static void evloop_accept(evloop_t *l) {
+  int fd;
+  char name[32];
+  evconn_t *c;
+
+  while ((fd = accept(l->listen_fd, NULL, 0)) >= 0) {
+    sprintf(name, "<socket %d>", fd);
+    c = evloop_conn(l, fd);
+    c->stream = new_socket_stream(GET_ATOM(name), fd);
+    c->len = 0;
+    c->paused = FALSE;
+    c->eof = FALSE;
+    c->watched = FALSE;
+    c->writing = FALSE;
+    c->events = 0;
+    c->out = NULL;
+    c->keep_after = FALSE;
+    c->finished = FALSE;
+    evloop_unframe(c);
+    evloop_watch(l, fd, TRUE);
+  }
+  /* Out of file descriptors (or memory): the pending connections
+     would make the listening socket ready again at once, so wait a
+     bit (or until some connection is released) */
+  if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM) {
+    evloop_listen(l, FALSE);
+    l->listen_resume = evloop_now_ms() + EVLOOP_ACCEPT_BACKOFF;
+  }
+}
+
+static int evloop_frame(evloop_t *l, evconn_t *c);
+
+#define EVLOOP_FRAME_PARTIAL 0
+#define EVLOOP_FRAME_DONE 1
+/* (other results of evloop_frame() are the HTTP status of a rejected
+   request) */
+
+/* Read all pending data (without blocking) */
+static void evloop_read(evloop_t *l, int fd) {
+  evconn_t *c = &l->conns[fd];
+  ssize_t n;
+
+  for (;;) {
+    /* (the rest is read when the connection is watched again) */
+    if (c->len >= evloop_max_buffer(l) &&
+        (evloop_frame(l, c) != EVLOOP_FRAME_PARTIAL || c->len >= evloop_max_buffer(l))) return;
+    if (c->cap - c->len < EVLOOP_READ_CHUNK) {
+      size_t cap = c->cap == 0 ? EVLOOP_READ_CHUNK*2 : c->cap*2;
+      c->buf = c->buf == NULL ? checkalloc_ARRAY(unsigned char, cap)
+        : checkrealloc_ARRAY(unsigned char, c->cap, cap, c->buf);
+      c->cap = cap;
+    }
+    n = recv(fd, c->buf + c->len, c->cap - c->len, MSG_DONTWAIT);
+    if (n > 0) {
+      c->len += n;
+    } else if (n == 0 || (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)) {
+      c->eof = TRUE;
+      evloop_watch(l, fd, FALSE);
+      return;
+    } else {
+      return;
+    }
+  }
+}
+
+#define EVLOOP_OUT_DONE 0
+#define EVLOOP_OUT_PENDING 1
+#define EVLOOP_OUT_ERROR 2
+
+static void evloop_out_free(evout_t *o) {
+  if (o->map != NULL) {
+    munmap(o->map, o->map_len);
+  } else {
+    checkdealloc_ARRAY(unsigned char, o->len, o->data);
+  }
+  checkdealloc_TYPE(evout_t, o);
+}
+
+static void evloop_out_clear(evconn_t *c) {
+  evout_t *o;
+  while ((o = c->out) != NULL) {
+    c->out = o->next;
+    evloop_out_free(o);
+  }
+}
+
+/* Send queued output (without blocking) */
+static int evloop_flush(evconn_t *c, int fd) {
+  struct iovec iov[EVLOOP_MAX_IOV];
+  struct msghdr msg;
+  evout_t *o;
+  ssize_t n;
+  size_t left;
+  int k;
+
+  while (c->out != NULL) {
+    k = 0;
+    for (o = c->out; o != NULL && k < EVLOOP_MAX_IOV; o = o->next, k++) {
+      iov[k].iov_base = o->data + o->off;
+      iov[k].iov_len = o->len - o->off;
+    }
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov = iov;
+    msg.msg_iovlen = k;
+    n = sendmsg(fd, &msg, MSG_DONTWAIT | EVLOOP_NOSIGNAL);
+    if (n < 0) {
+      if (errno == EINTR) continue;
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return EVLOOP_OUT_PENDING;
+      return EVLOOP_OUT_ERROR;
+    }
+    /* Drop what was sent */
+    while (n > 0) {
+      o = c->out;
+      left = o->len - o->off;
+      if ((size_t)n < left) {
+        o->off += n;
+        break;
+      }
+      n -= left;
+      c->out = o->next;
+      evloop_out_free(o);
+    }
+  }
+  return EVLOOP_OUT_DONE;
+}
+
+/* Wait for output, resume, or finish the connection after trying to
+   send its output (with result res) */
+static void evloop_sent(evloop_t *l, int fd, int res) {
+  evconn_t *c = &l->conns[fd];
+  if (res == EVLOOP_OUT_PENDING) {
+    c->writing = TRUE;
+  } else {
+    c->writing = FALSE;
+    evloop_out_clear(c);
+    if (res == EVLOOP_OUT_DONE && c->keep_after) {
+      c->paused = FALSE;
+      c->watched = !c->eof;
+    } else {
+      c->finished = TRUE;
+    }
+  }
+  evloop_update(l, fd);
+}
+
+static void evloop_drain_wake(evloop_t *l) {
+  char buf[64];
+  while (read(l->wake_rd, buf, sizeof(buf)) > 0) {}
+}
+
+/* Case-insensitive prefix test */
+static bool_t evloop_prefix(const unsigned char *p, const unsigned char *end, const char *prefix) {
+  for (; *prefix; p++, prefix++) {
+    if (p >= end || tolower(*p) != *prefix) return FALSE;
+  }
+  return TRUE;
+}
+
+/* Only blanks up to the end of the line */
+static bool_t evloop_blank(const unsigned char *p, const unsigned char *end) {
+  for (; p < end; p++) {
+    if (*p != ' ' && *p != '\t' && *p != '\r') return FALSE;
+  }
+  return TRUE;
+}
+
+static int evloop_hex(unsigned char ch) {
+  if (ch >= '0' && ch <= '9') return ch - '0';
+  if (ch >= 'a' && ch <= 'f') return ch - 'a' + 10;
+  if (ch >= 'A' && ch <= 'F') return ch - 'A' + 10;
+  return -1;
+}
+
+/* Frame the header of the first request in the buffer (sets hlen,
+   clen, keep and chunked) */
+static int evloop_header(evloop_t *l, evconn_t *c) {
+  const unsigned char *b = c->buf, *end, *p, *line;
+  size_t i, hlen, clen, d;
+  bool_t http11, has_clen;
+
+  /* Find the end of the header */
+  hlen = 0;
+  for (i = 0; i < c->len; i++) {
+    if (b[i] != '\n') continue;
+    if (i+1 < c->len && b[i+1] == '\n') { hlen = i+2; break; }
+    if (i+2 < c->len && b[i+1] == '\r' && b[i+2] == '\n') { hlen = i+3; break; }
+  }
+  if (hlen == 0) return EVLOOP_FRAME_PARTIAL;
+
+  /* Scan request line and header fields */
+  end = b + hlen;
+  clen = 0;
+  has_clen = FALSE;
+  c->chunked = FALSE;
+  line = b;
+  while (line < end && *line != '\n') line++;
+  http11 = (line - b >= 9 && memcmp(line - (line[-1] == '\r' ? 9 : 8), "HTTP/1.1", 8) == 0);
+  c->keep = http11;
+  for (p = line + 1; p < end; p = line + 1) {
+    for (line = p; line < end && *line != '\n'; line++) {}
+    if (evloop_prefix(p, line, "content-length:")) {
+      for (p += 15; p < line && (*p == ' ' || *p == '\t'); p++) {}
+      if (p >= line || *p < '0' || *p > '9') return 400;
+      for (d = 0; p < line && *p >= '0' && *p <= '9'; p++) {
+        if (d > l->max_content / 10) return 413;
+        d = d * 10 + (*p - '0');
+        if (d > l->max_content) return 413;
+      }
+      if (!evloop_blank(p, line)) return 400;
+      if (has_clen && d != clen) return 400;
+      has_clen = TRUE;
+      clen = d;
+    } else if (evloop_prefix(p, line, "transfer-encoding:")) {
+      for (p += 18; p < line && (*p == ' ' || *p == '\t'); p++) {}
+      /* (only the chunked coding is implemented) */
+      if (!evloop_prefix(p, line, "chunked") || !evloop_blank(p + 7, line)) return 501;
+      c->chunked = TRUE;
+    } else if (evloop_prefix(p, line, "connection:")) {
+      for (p += 11; p < line && (*p == ' ' || *p == '\t'); p++) {}
+      if (evloop_prefix(p, line, "close")) c->keep = FALSE;
+      else if (evloop_prefix(p, line, "keep-alive")) c->keep = TRUE;
+    }
+  }
+  /* (ambiguous framing, see RFC 7230, section 3.3.3) */
+  if (c->chunked && has_clen) return 400;
+  c->hlen = hlen;
+  c->clen = clen;
+  c->dec = hlen;
+  c->raw = hlen;
+  return EVLOOP_FRAME_DONE;
+}
+
+/* Decode the chunked content received so far. The data of each chunk
+   is moved to the end of the decoded content (dec), and the rest of
+   the buffer is moved over the chunk headers once the content is
+   complete (or when they take more space than the data that is not
+   decoded yet) */
+static int evloop_chunks(evloop_t *l, evconn_t *c) {
+  unsigned char *b = c->buf;
+  size_t p, eol, n, sz;
+  int h;
+
+  while (!c->done) {
+    p = c->raw;
+    for (eol = p; eol < c->len && b[eol] != '\n'; eol++) {}
+    if (eol >= c->len) {
+      if (c->len - p > EVLOOP_MAX_CHUNK_LINE) return 400;
+      break;
+    }
+    if (eol - p > EVLOOP_MAX_CHUNK_LINE) return 400;
+    if (c->trailer) {
+      /* (trailer fields are ignored) */
+      if (eol == p || (eol == p + 1 && b[p] == '\r')) {
+        c->done = TRUE;
+      } else if (c->trail + (eol + 1 - p) > EVLOOP_MAX_HEADER) {
+        return 431;
+      } else {
+        c->trail += eol + 1 - p;
+      }
+      c->raw = eol + 1;
+      continue;
+    }
+    /* Chunk size (and ignored extensions) */
+    sz = 0;
+    for (n = p; n < eol && (h = evloop_hex(b[n])) >= 0; n++) {
+      if (sz > l->max_content / 16) return 413;
+      sz = sz * 16 + h;
+    }
+    if (n == p) return 400;
+    if (sz > l->max_content - (c->dec - c->hlen)) return 413;
+    for (; n < eol && (b[n] == ' ' || b[n] == '\t'); n++) {}
+    if (n < eol && b[n] != ';' && b[n] != '\r') return 400;
+    if (sz == 0) {
+      c->trailer = TRUE;
+      c->raw = eol + 1;
+      continue;
+    }
+    /* Chunk data and line end */
+    n = eol + 1 + sz;
+    if (n >= c->len) break;
+    if (b[n] == '\r') {
+      if (n + 1 >= c->len) break;
+      if (b[n + 1] != '\n') return 400;
+      n += 2;
+    } else if (b[n] == '\n') {
+      n++;
+    } else {
+      return 400;
+    }
+    memmove(b + c->dec, b + eol + 1, sz);
+    c->dec += sz;
+    c->raw = n;
+  }
+  if (c->done || c->raw - c->dec >= c->len - c->raw) {
+    memmove(b + c->dec, b + c->raw, c->len - c->raw);
+    c->len -= c->raw - c->dec;
+    c->raw = c->dec;
+  }
+  if (!c->done) return EVLOOP_FRAME_PARTIAL;
+  c->clen = c->dec - c->hlen;
+  return EVLOOP_FRAME_DONE;
+}
+
+/* Frame the first request in the buffer. Returns
+   EVLOOP_FRAME_PARTIAL if it is not complete yet, EVLOOP_FRAME_DONE
+   if it is (with header length, content and keep-alive in the
+   connection), or the HTTP status to answer if it must be rejected */
+static int evloop_frame(evloop_t *l, evconn_t *c) {
+  int res;
+  if (c->hlen == 0) {
+    res = evloop_header(l, c);
+    if (res != EVLOOP_FRAME_DONE) return res;
+  }
+  if (c->chunked) return evloop_chunks(l, c);
+  return c->len >= c->hlen + c->clen ? EVLOOP_FRAME_DONE : EVLOOP_FRAME_PARTIAL;
+}
+
+static CFUN__PROTO(evloop_bytes, tagged_t, const unsigned char *p, size_t len) {
+  tagged_t list = atom_nil;
+  while (len > 0) {
+    len--;
+    MakeLST(list, MakeSmall(p[len]), list);
+  }
+  return list;
+}
+
+/* socket_evloop_new(+Socket, -Loop) */
+CBOOL__PROTO(prolog_socket_evloop_new) {
+  ERR__FUNCTOR("sockets:socket_evloop_new", 2);
+  evloop_t *l;
+  int fd, flags;
+  int wake[2];
+
+  DEREF(X(0), X(0));
+  if (!TaggedIsSmall(X(0)))
+    BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+  fd = GetSmall(X(0));
+  flags = fcntl(fd, F_GETFL, 0);
+  if (flags < 0 || fcntl(fd, F_SETFL, flags | O_NONBLOCK) < 0)
+    BUILTIN_ERROR(ERR_system_error, X(0), 1);
+  if (pipe(wake) < 0) {
+    fcntl(fd, F_SETFL, flags);
+    BUILTIN_ERROR(ERR_system_error, X(0), 1);
+  }
+  fcntl(wake[0], F_SETFL, fcntl(wake[0], F_GETFL, 0) | O_NONBLOCK);
+  fcntl(wake[1], F_SETFL, fcntl(wake[1], F_GETFL, 0) | O_NONBLOCK);
+  fcntl(wake[0], F_SETFD, FD_CLOEXEC);
+  fcntl(wake[1], F_SETFD, FD_CLOEXEC);
+
+  l = checkalloc_TYPE(evloop_t);
+  l->listen_fd = fd;
+  l->listen_flags = flags;
+  l->wake_rd = wake[0];
+  l->wake_wr = wake[1];
+  l->conns_size = 64;
+  l->conns = checkalloc_ARRAY(evconn_t, l->conns_size);
+  memset(l->conns, 0, l->conns_size * sizeof(evconn_t));
+  l->max_content = EVLOOP_MAX_CONTENT;
+  l->listen_paused = FALSE;
+  l->listen_resume = 0;
+#if defined(LINUX)
+  l->epfd = epoll_create1(0);
+  if (l->epfd >= 0) {
+    struct epoll_event ev;
+    ev.events = EPOLLIN;
+    ev.data.fd = fd;
+    epoll_ctl(l->epfd, EPOLL_CTL_ADD, fd, &ev);
+    ev.data.fd = l->wake_rd;
+    epoll_ctl(l->epfd, EPOLL_CTL_ADD, l->wake_rd, &ev);
+  }
+#else
+  l->epfd = -1;
+#endif
+
+  CBOOL__LASTUNIFY(PointerToTerm(l), X(1));
+}
+
+static evloop_t *evloop_get(tagged_t t) {
+  DEREF(t, t);
+  if (!TaggedIsSmall(t)) return NULL;
+  return TermToPointer(evloop_t, t);
+}
+
+/* socket_evloop_max_content(+Loop, +Bytes): set the maximum length of
+   the content of requests */
+CBOOL__PROTO(prolog_socket_evloop_max_content) {
+  ERR__FUNCTOR("sockets:socket_evloop_max_content", 2);
+  evloop_t *l;
+  intmach_t max;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+  DEREF(X(1), X(1));
+  if (!TaggedIsSmall(X(1))) BUILTIN_ERROR(ERR_type_error(integer), X(1), 2);
+  max = GetSmall(X(1));
+  if (max < 0) BUILTIN_ERROR(ERR_domain_error(not_less_than_zero), X(1), 2);
+  l->max_content = (size_t)max > EVLOOP_MAX_CONTENT_LIMIT ? EVLOOP_MAX_CONTENT_LIMIT : (size_t)max;
+  return TRUE;
+}
+
+/* Wait for readiness (at most TimeoutMs, or forever if negative) and
+   read available data */
+static void evloop_poll(evloop_t *l, int timeout_ms) {
+  int i, n;
+  if (l->listen_paused) {
+    int64_t wait = l->listen_resume - evloop_now_ms();
+    if (wait <= 0) {
+      evloop_listen(l, TRUE);
+    } else if (timeout_ms < 0 || timeout_ms > wait) {
+      timeout_ms = (int)wait;
+    }
+  }
+#if defined(LINUX)
+  if (l->epfd >= 0) {
+    struct epoll_event evs[EVLOOP_MAX_EVENTS];
+    n = epoll_wait(l->epfd, evs, EVLOOP_MAX_EVENTS, timeout_ms);
+    for (i = 0; i < n; i++) {
+      int fd = evs[i].data.fd;
+      if (fd == l->listen_fd) {
+        evloop_accept(l);
+      } else if (fd == l->wake_rd) {
+        evloop_drain_wake(l);
+      } else {
+        evconn_t *c = &l->conns[fd];
+        if (c->writing && (evs[i].events & (EPOLLOUT|EPOLLERR|EPOLLHUP))) {
+          evloop_sent(l, fd, evloop_flush(c, fd));
+        }
+        if (c->watched && (evs[i].events & (EPOLLIN|EPOLLERR|EPOLLHUP))) {
+          evloop_read(l, fd);
+        }
+      }
+    }
+    return;
+  }
+#endif
+  {
+    struct pollfd *fds;
+    int nfds = 0;
+    int size = l->conns_size + 2;
+    fds = checkalloc_ARRAY(struct pollfd, size);
+    if (!l->listen_paused) {
+      fds[nfds].fd = l->listen_fd;
+      fds[nfds++].events = POLLIN;
+    }
+    fds[nfds].fd = l->wake_rd;
+    fds[nfds++].events = POLLIN;
+    for (i = 0; i < l->conns_size; i++) {
+      evconn_t *c = &l->conns[i];
+      if (c->stream != NULL && (c->watched || c->writing)) {
+        fds[nfds].fd = i;
+        fds[nfds++].events = (c->watched ? POLLIN : 0) | (c->writing ? POLLOUT : 0);
+      }
+    }
+    n = poll(fds, nfds, timeout_ms);
+    for (i = 0; n > 0 && i < nfds; i++) {
+      int fd = fds[i].fd;
+      short re = fds[i].revents;
+      if (re == 0) continue;
+      if (fd == l->listen_fd) {
+        evloop_accept(l);
+      } else if (fd == l->wake_rd) {
+        evloop_drain_wake(l);
+      } else {
+        evconn_t *c = &l->conns[fd];
+        if (c->writing && (re & (POLLOUT|POLLERR|POLLHUP))) {
+          evloop_sent(l, fd, evloop_flush(c, fd));
+        }
+        if (c->watched && (re & (POLLIN|POLLERR|POLLHUP))) {
+          evloop_read(l, fd);
+        }
+      }
+    }
+    checkdealloc_ARRAY(struct pollfd, size, fds);
+  }
+}
+
+#define EVLOOP_NONE 0
+#define EVLOOP_REQUEST 1
+#define EVLOOP_CLOSED 2
+#define EVLOOP_REJECTED 3
+
+/* Find the next connection (from *fd) with a complete request, a
+   rejected one (with HTTP *status), or closed by the peer */
+static int evloop_next(evloop_t *l, int *fd, int *status) {
+  evconn_t *c;
+  int res;
+  for (; *fd < l->conns_size; (*fd)++) {
+    c = &l->conns[*fd];
+    if (c->stream == NULL) continue;
+    if (c->finished) return EVLOOP_CLOSED;
+    if (c->paused) continue;
+    res = evloop_frame(l, c);
+    if (res == EVLOOP_FRAME_DONE) return EVLOOP_REQUEST;
+    *status = res;
+    if (res != EVLOOP_FRAME_PARTIAL) return EVLOOP_REJECTED;
+    if (c->eof) return EVLOOP_CLOSED;
+    *status = (c->hlen == 0 ? 431 : 413);
+    if (c->hlen == 0 && c->len > EVLOOP_MAX_HEADER) return EVLOOP_REJECTED;
+    if (c->len >= evloop_max_buffer(l)) return EVLOOP_REJECTED;
+  }
+  return EVLOOP_NONE;
+}
+
+/* socket_evloop_wait(+Loop, +TO_ms, -Events) */
+CBOOL__PROTO(prolog_socket_evloop_wait) {
+  ERR__FUNCTOR("sockets:socket_evloop_wait", 3);
+  evloop_t *l;
+  int fd, timeout_ms, kind, status, n;
+  evconn_t *c;
+  size_t cells, need;
+  tagged_t list, ev, functor_request, functor_closed, functor_rejected;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+
+  DEREF(X(1), X(1));
+  if (X(1) == atom_off) {
+    timeout_ms = -1;
+  } else if (TaggedIsSmall(X(1))) {
+    timeout_ms = GetSmall(X(1));
+  } else {
+    BUILTIN_ERROR(ERR_type_error(integer), X(1), 2);
+  }
+
+  /* Do not wait if there are pending events (e.g., pipelined requests) */
+  fd = 0;
+  kind = evloop_next(l, &fd, &status);
+  evloop_poll(l, kind != EVLOOP_NONE ? 0 : timeout_ms);
+
+  /* Reserve heap for the events (those that do not fit in the budget
+     are returned by the next call) */
+  cells = 0;
+  n = 0;
+  for (fd = 0; (kind = evloop_next(l, &fd, &status)) != EVLOOP_NONE; fd++) {
+    c = &l->conns[fd];
+    if (kind == EVLOOP_REQUEST) {
+      need = LSTCELLS + 5 + 3 + (c->hlen + c->clen) * LSTCELLS;
+    } else if (kind == EVLOOP_REJECTED) {
+      need = LSTCELLS + 3 + 3;
+    } else {
+      need = LSTCELLS + 2 + 3;
+    }
+    if (n > 0 && cells + need > EVLOOP_HEAP_BUDGET) break;
+    cells += need;
+    n++;
+  }
+  TEST_HEAP_OVERFLOW(G->heap_top, cells*sizeof(tagged_t)+CONTPAD, 3);
+
+  functor_request = SetArity(GET_ATOM("request"), 4);
+  functor_closed = SetArity(GET_ATOM("closed"), 1);
+  functor_rejected = SetArity(GET_ATOM("rejected"), 2);
+  list = atom_nil;
+  for (fd = 0; n > 0 && (kind = evloop_next(l, &fd, &status)) != EVLOOP_NONE; fd++, n--) {
+    c = &l->conns[fd];
+    if (kind == EVLOOP_REQUEST) {
+      tagged_t header, content, stream;
+      stream = ptr_to_stream(Arg, c->stream);
+      header = CFUN__EVAL(evloop_bytes, c->buf, c->hlen);
+      content = CFUN__EVAL(evloop_bytes, c->buf + c->hlen, c->clen);
+      ev = Tagp(STR, G->heap_top);
+      HeapPush(G->heap_top, functor_request);
+      HeapPush(G->heap_top, stream);
+      HeapPush(G->heap_top, header);
+      HeapPush(G->heap_top, content);
+      HeapPush(G->heap_top, c->keep ? atom_true : atom_false);
+      MakeLST(list, ev, list);
+      /* Consume the request and stop watching the connection */
+      c->len -= c->hlen + c->clen;
+      memmove(c->buf, c->buf + c->hlen + c->clen, c->len);
+    } else if (kind == EVLOOP_REJECTED) {
+      tagged_t stream;
+      stream = ptr_to_stream(Arg, c->stream);
+      ev = Tagp(STR, G->heap_top);
+      HeapPush(G->heap_top, functor_rejected);
+      HeapPush(G->heap_top, stream);
+      HeapPush(G->heap_top, MakeSmall(status));
+      MakeLST(list, ev, list);
+      c->len = 0;
+    } else {
+      tagged_t stream;
+      stream = ptr_to_stream(Arg, c->stream);
+      ev = Tagp(STR, G->heap_top);
+      HeapPush(G->heap_top, functor_closed);
+      HeapPush(G->heap_top, stream);
+      MakeLST(list, ev, list);
+      c->len = 0;
+      c->finished = FALSE;
+    }
+    evloop_unframe(c);
+    evloop_watch(l, fd, FALSE);
+    c->paused = TRUE;
+  }
+
+  CBOOL__LASTUNIFY(list, X(2));
+}
+
+static CFUN__PROTO(evloop_stream_conn, evconn_t *, evloop_t *l, tagged_t t) {
+  stream_node_t *s;
+  int fd;
+  s = stream_to_ptr(t, 'r');
+  if (s == NULL || s->streammode != 's') return NULL;
+  fd = GetSmall(s->label);
+  if (fd >= l->conns_size || l->conns[fd].stream != s) return NULL;
+  return &l->conns[fd];
+}
+
+/* socket_evloop_resume(+Loop, +Stream): watch the connection again
+   (after answering a keep-alive request) */
+CBOOL__PROTO(prolog_socket_evloop_resume) {
+  ERR__FUNCTOR("sockets:socket_evloop_resume", 2);
+  evloop_t *l;
+  evconn_t *c;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+  c = CFUN__EVAL(evloop_stream_conn, l, X(1));
+  if (c == NULL) BUILTIN_ERROR(ERR_domain_error(stream_or_alias), X(1), 2);
+  c->paused = FALSE;
+  if (!c->eof) evloop_watch(l, GetSmall(c->stream->label), TRUE);
+  return TRUE;
+}
+
+/* Output segment for a part of a response (see socket_evloop_send/4),
+   NULL if empty or not valid (*err is then nonzero) */
+#define EVLOOP_PART_BYTES 1 /* not a list of bytes */
+#define EVLOOP_PART_FILE 2 /* file not found */
+#define EVLOOP_PART_NOT_REGULAR 3 /* not a regular file */
+static evout_t *evloop_out_new(tagged_t part, int *err) {
+  evout_t *o;
+  tagged_t t, car;
+  size_t len;
+
+  *err = 0;
+  DEREF(part, part);
+  if (TaggedIsSTR(part) && TaggedToHeadfunctor(part) == SetArity(GET_ATOM("file"), 3)) {
+    tagged_t path, toff, tlen;
+    struct stat st;
+    intmach_t off, flen;
+    off_t page_off;
+    void *map;
+    int fd;
+    DerefArg(path, part, 1);
+    DerefArg(toff, part, 2);
+    DerefArg(tlen, part, 3);
+    if (!TaggedIsATM(path) || !TaggedIsSmall(toff) || !TaggedIsSmall(tlen)) {
+      *err = EVLOOP_PART_BYTES;
+      return NULL;
+    }
+    fd = open(GetString(path), O_RDONLY);
+    if (fd < 0) {
+      *err = EVLOOP_PART_FILE;
+      return NULL;
+    }
+    if (fstat(fd, &st) < 0 || !S_ISREG(st.st_mode)) {
+      close(fd);
+      *err = EVLOOP_PART_NOT_REGULAR;
+      return NULL;
+    }
+    /* Clip the range to the file size */
+    off = GetSmall(toff);
+    flen = GetSmall(tlen);
+    if (off < 0 || off > st.st_size) off = st.st_size;
+    if (flen < 0 || flen > st.st_size - off) flen = st.st_size - off;
+    if (flen == 0) {
+      close(fd);
+      return NULL;
+    }
+    page_off = off % sysconf(_SC_PAGESIZE);
+    map = mmap(NULL, flen + page_off, PROT_READ, MAP_PRIVATE, fd, off - page_off);
+    close(fd);
+    if (map == MAP_FAILED) {
+      *err = EVLOOP_PART_NOT_REGULAR;
+      return NULL;
+    }
+    o = checkalloc_TYPE(evout_t);
+    o->map = map;
+    o->map_len = flen + page_off;
+    o->data = (unsigned char *)map + page_off;
+    o->len = flen;
+  } else {
+    len = 0;
+    for (t = part; TaggedIsLST(t); ) {
+      DerefCar(car, t);
+      if (!TaggedIsSmall(car) || car < TaggedZero || car >= MakeSmall(256)) {
+        *err = EVLOOP_PART_BYTES;
+        return NULL;
+      }
+      len++;
+      DerefCdr(t, t);
+    }
+    if (t != atom_nil) {
+      *err = EVLOOP_PART_BYTES;
+      return NULL;
+    }
+    if (len == 0) return NULL;
+    o = checkalloc_TYPE(evout_t);
+    o->map = NULL;
+    o->map_len = 0;
+    o->data = checkalloc_ARRAY(unsigned char, len);
+    o->len = len;
+    len = 0;
+    for (t = part; TaggedIsLST(t); ) {
+      DerefCar(car, t);
+      o->data[len++] = GetSmall(car);
+      DerefCdr(t, t);
+    }
+  }
+  o->off = 0;
+  o->next = NULL;
+  return o;
+}
+
+/* socket_evloop_send(+Loop, +Stream, +Parts, +KeepAlive): queue the
+   response to a request and send it without blocking */
+CBOOL__PROTO(prolog_socket_evloop_send) {
+  ERR__FUNCTOR("sockets:socket_evloop_send", 4);
+  evloop_t *l;
+  evconn_t *c;
+  evout_t *out, **tail, *o;
+  tagged_t parts, part;
+  int fd, err;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+  c = CFUN__EVAL(evloop_stream_conn, l, X(1));
+  if (c == NULL) BUILTIN_ERROR(ERR_domain_error(stream_or_alias), X(1), 2);
+  DEREF(X(3), X(3));
+  if (X(3) != atom_true && X(3) != atom_false)
+    BUILTIN_ERROR(ERR_type_error(atom), X(3), 4);
+
+  /* Build the segments first (nothing is queued on errors) */
+  out = NULL;
+  tail = &out;
+  DEREF(parts, X(2));
+  while (TaggedIsLST(parts)) {
+    DerefCar(part, parts);
+    o = evloop_out_new(part, &err);
+    if (err != 0) {
+      while ((o = out) != NULL) {
+        out = o->next;
+        evloop_out_free(o);
+      }
+      if (err == EVLOOP_PART_FILE)
+        BUILTIN_ERROR(ERR_existence_error(source_sink), X(2), 3);
+      if (err == EVLOOP_PART_NOT_REGULAR)
+        BUILTIN_ERROR(ERR_domain_error(source_sink), X(2), 3);
+      BUILTIN_ERROR(ERR_type_error(list), X(2), 3);
+    }
+    if (o != NULL) {
+      *tail = o;
+      tail = &o->next;
+    }
+    DerefCdr(parts, parts);
+  }
+
+  fd = GetSmall(c->stream->label);
+  for (tail = &c->out; *tail != NULL; tail = &(*tail)->next) {}
+  *tail = out;
+  c->keep_after = X(3) == atom_true;
+  evloop_sent(l, fd, evloop_flush(c, fd));
+  return TRUE;
+}
+
+/* socket_evloop_wake(+Loop): make a (concurrent) wait of Loop return */
+CBOOL__PROTO(prolog_socket_evloop_wake) {
+  ERR__FUNCTOR("sockets:socket_evloop_wake", 1);
+  evloop_t *l;
+  ssize_t n;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+  /* (if the pipe is full the loop wakes up anyway) */
+  n = write(l->wake_wr, "w", 1);
+  (void)n;
+  return TRUE;
+}
+
+static void evloop_release_conn(evloop_t *l, evconn_t *c) {
+  c->watched = FALSE;
+  c->writing = FALSE;
+  evloop_update(l, GetSmall(c->stream->label));
+  evloop_out_clear(c);
+  c->finished = FALSE;
+  if (c->buf != NULL) checkdealloc_ARRAY(unsigned char, c->cap, c->buf);
+  c->buf = NULL;
+  c->cap = 0;
+  c->len = 0;
+  c->stream = NULL;
+  /* (a file descriptor is available again) */
+  if (l->listen_paused) l->listen_resume = 0;
+}
+
+/* socket_evloop_release(+Loop, +Stream): forget the connection (the
+   stream must be closed afterwards) */
+CBOOL__PROTO(prolog_socket_evloop_release) {
+  ERR__FUNCTOR("sockets:socket_evloop_release", 2);
+  evloop_t *l;
+  evconn_t *c;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+  c = CFUN__EVAL(evloop_stream_conn, l, X(1));
+  if (c != NULL) evloop_release_conn(l, c);
+  return TRUE;
+}
+
+/* Send the pending output of all the connections (waiting at most
+   EVLOOP_CLOSE_FLUSH ms) */
+static void evloop_flush_all(evloop_t *l) {
+  int64_t deadline = evloop_now_ms() + EVLOOP_CLOSE_FLUSH;
+  int64_t wait;
+  struct pollfd *fds;
+  int i, nfds, size;
+
+  for (;;) {
+    wait = deadline - evloop_now_ms();
+    if (wait <= 0) return;
+    size = l->conns_size;
+    fds = checkalloc_ARRAY(struct pollfd, size);
+    nfds = 0;
+    for (i = 0; i < l->conns_size; i++) {
+      if (l->conns[i].stream != NULL && l->conns[i].writing) {
+        fds[nfds].fd = i;
+        fds[nfds++].events = POLLOUT;
+      }
+    }
+    if (nfds > 0 && poll(fds, nfds, (int)wait) > 0) {
+      for (i = 0; i < nfds; i++) {
+        if (fds[i].revents == 0) continue;
+        evloop_sent(l, fds[i].fd, evloop_flush(&l->conns[fds[i].fd], fds[i].fd));
+      }
+    }
+    checkdealloc_ARRAY(struct pollfd, size, fds);
+    if (nfds == 0) return;
+  }
+}
+
+/* socket_evloop_close(+Loop, -Streams): destroy the event loop,
+   returning the streams of the connections that were still open */
+CBOOL__PROTO(prolog_socket_evloop_close) {
+  ERR__FUNCTOR("sockets:socket_evloop_close", 2);
+  evloop_t *l;
+  int fd, n;
+  tagged_t list;
+
+  l = evloop_get(X(0));
+  if (l == NULL) BUILTIN_ERROR(ERR_type_error(integer), X(0), 1);
+
+  evloop_flush_all(l);
+  n = 0;
+  for (fd = 0; fd < l->conns_size; fd++) {
+    if (l->conns[fd].stream != NULL) n++;
+  }
+  TEST_HEAP_OVERFLOW(G->heap_top, n*(LSTCELLS+3)*sizeof(tagged_t)+CONTPAD, 2);
+  list = atom_nil;
+  for (fd = 0; fd < l->conns_size; fd++) {
+    if (l->conns[fd].stream != NULL) {
+      MakeLST(list, ptr_to_stream(Arg, l->conns[fd].stream), list);
+      evloop_release_conn(l, &l->conns[fd]);
+    }
+  }
+#if defined(LINUX)
+  if (l->epfd >= 0) close(l->epfd);
+#endif
+  close(l->wake_rd);
+  close(l->wake_wr);
+  fcntl(l->listen_fd, F_SETFL, l->listen_flags);
+  checkdealloc_ARRAY(evconn_t, l->conns_size, l->conns);
+  checkdealloc_TYPE(evloop_t, l);
+  CBOOL__LASTUNIFY(list, X(1));
+}
+
+/* --------------------------------------------------------------------------- */
+
 /* socket_shutdown(+Stream, +Type) */
 
 /* Patch constants apparently not defined in all Linux implementations (at
@@ -3,162 +3,362 @@
 
    Author: Remy Haemmerle
 */
-   
+
+/* Alarms are driven by a single timer thread and a hierarchical
+   timing wheel (insertion and cancellation are O(1)). When an alarm
+   expires the timer thread interrupts the worker that created it
+   (with interrupt_worker()).
+
+   The alarms of each worker form a chain (newest last) that
+   corresponds to nested calls to call_with_time_limit/3. It is freed
+   (with release_alarms()) when the outermost call exits. All the
+   state is protected by alarm_lock. */
 
 #include <ciao_prolog.h>
 #include <ciao/internals.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <pthread.h>
 #include <unistd.h>
 #include <signal.h>
-
-#if defined(__ANDROID__)
-/* TODO: Android NDK (bionic) lacks pthread_cancel(). We replace it by
-   pthread_kill() by now but we'd additionally need proper use of
-   signals.  See https://github.com/tux-mind/libbthread for
-   details. The use of SIGTERM is probably wrong or incomplete here. */
-#define pthread_cancel(Id) pthread_kill((Id),SIGTERM)
-#endif
+#include <time.h>
 
 #define INITIALIZED  0
 #define SCHEDULED    1
 #define DONE         2
 #define STOPPED       3
 
+struct alarm_owner;
+
 struct alarm_data{
   int number, state, sent, time;
-  pthread_t thread;
-  pthread_mutex_t mutex;
+  struct alarm_owner * owner;
   struct alarm_data * next;
+  /* timing wheel */
+  int64_t expiry; /* (in ticks, i.e., milliseconds) */
+  struct alarm_data * wnext;
+  struct alarm_data ** wprev;
 };
 
-struct alarm_data * ciao_alarms;
+/* Per-worker alarm chain and oldest alarm that sent a signal */
+struct alarm_owner{
+  worker_t * worker;
+  struct alarm_data * alarms;
+  int older_sent_signal;
+  struct alarm_owner * next;
+};
+
+static struct alarm_owner * alarm_owners = NULL;
+static pthread_mutex_t alarm_lock = PTHREAD_MUTEX_INITIALIZER;
+
+/* ------------------------------------------------------------------------- */
+/* Timing wheel */
+
+#define WHEEL_BITS 6
+#define WHEEL_SIZE (1 << WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SIZE - 1)
+#define WHEEL_LEVELS 4
+/* (maximum delta that fits in the wheel, larger ones are cascaded
+   again from the last level) */
+#define WHEEL_SPAN (((int64_t)1 << (WHEEL_BITS * WHEEL_LEVELS)) - 1)
+
+static struct alarm_data * wheel[WHEEL_LEVELS][WHEEL_SIZE];
+static int64_t wheel_now; /* next tick to process */
+static int wheel_count = 0;
+
+/* Clock of timer_cond (pthread_condattr_setclock() is not available
+   in macOS, where timed waits use the realtime clock) */
+#if defined(DARWIN)
+#define TIMER_COND_CLOCK CLOCK_REALTIME
+#else
+#define TIMER_COND_CLOCK CLOCK_MONOTONIC
+#endif
 
-// int main_pid;
-worker_t *main_worker;
-int older_sent_signal = 0;
-pthread_mutex_t * older_sent_signal_mutex = NULL;
+static pthread_cond_t timer_cond;
+static int timer_started = 0;
+static int atfork_registered = 0;
 
-int stop_alarm(struct alarm_data * data);
+static int64_t current_tick(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
 
-void garbage(struct alarm_data ** data){
+static void wheel_insert(struct alarm_data * data) {
+  int64_t e, delta;
+  int level;
+  struct alarm_data ** slot;
+
+  e = data->expiry;
+  if (e < wheel_now) e = wheel_now;
+  delta = e - wheel_now;
+  if (delta > WHEEL_SPAN) {
+    delta = WHEEL_SPAN;
+    e = wheel_now + WHEEL_SPAN;
+  }
+  for (level = 0; level < WHEEL_LEVELS - 1; level++) {
+    if (delta < ((int64_t)1 << (WHEEL_BITS * (level + 1)))) break;
+  }
+  slot = &wheel[level][(e >> (WHEEL_BITS * level)) & WHEEL_MASK];
+  data->wnext = *slot;
+  if (*slot != NULL) (*slot)->wprev = &data->wnext;
+  data->wprev = slot;
+  *slot = data;
+  wheel_count++;
+}
 
-  // printf("garbage(&%d) called\n", *data);   
+static void wheel_remove(struct alarm_data * data) {
+  *(data->wprev) = data->wnext;
+  if (data->wnext != NULL) data->wnext->wprev = data->wprev;
+  data->wnext = NULL;
+  data->wprev = NULL;
+  wheel_count--;
+}
 
-  if ((*data) != NULL) {
+/* Reinsert the entries of a slot (with respect to wheel_now) */
+static int cascade(int level) {
+  int index;
+  struct alarm_data * list;
+  struct alarm_data * data;
+
+  index = (wheel_now >> (WHEEL_BITS * level)) & WHEEL_MASK;
+  list = wheel[level][index];
+  wheel[level][index] = NULL;
+  while (list != NULL) {
+    data = list;
+    list = data->wnext;
+    wheel_count--;
+    wheel_insert(data);
+  }
+  return index;
+}
 
-    // printf("stop alarm %d\n", *data);   
-    stop_alarm(*data);
-    // printf("alarm %d stoped\n", *data);   
+CVOID__PROTO(interrupt_worker, int signal_number); /* NOTE: do not use kill(), it will not work in daemons since we do not set SIGINT handler for nontty! (JF) */
 
-    garbage(&(*data)->next);
+static void fire_alarm(struct alarm_data * data) {
+  struct alarm_owner * owner = data->owner;
 
-    pthread_mutex_destroy(&((*data)->mutex));
-    pthread_join((*data)->thread, NULL);
+  if ((owner->older_sent_signal == 0) || (data->number < owner->older_sent_signal))
+    owner->older_sent_signal = data->number;
+  data->state = DONE;
+  data->sent = ciao_true;
+  WITH_WORKER(owner->worker, {
+    CVOID__CALL(interrupt_worker, SIGINT);
+  });
+}
 
-    pthread_mutex_lock(older_sent_signal_mutex);
-    if (older_sent_signal >= (*data)->number) {
-      older_sent_signal = 0 ;
+/* Process all ticks up to now */
+static void wheel_advance(int64_t now) {
+  int level;
+  struct alarm_data * list;
+  struct alarm_data * data;
+
+  while (wheel_now <= now && wheel_count > 0) {
+    /* (cascade entries from upper levels at the beginning of each
+       round) */
+    for (level = 1; level < WHEEL_LEVELS; level++) {
+      if (((wheel_now >> (WHEEL_BITS * (level - 1))) & WHEEL_MASK) != 0) break;
+      if (cascade(level) != 0) break;
     }
-    pthread_mutex_unlock(older_sent_signal_mutex);
-
-    ciao_free((*data));
-  } 
-  *data = NULL; 
-  //printf("garbage() returns\n"); 
+    list = wheel[0][wheel_now & WHEEL_MASK];
+    wheel[0][wheel_now & WHEEL_MASK] = NULL;
+    while (list != NULL) {
+      data = list;
+      list = data->wnext;
+      wheel_count--;
+      data->wnext = NULL;
+      data->wprev = NULL;
+      if (data->expiry > wheel_now) {
+        wheel_insert(data);
+      } else {
+        fire_alarm(data);
+      }
+    }
+    wheel_now++;
+  }
+  if (wheel_count == 0 && wheel_now <= now) wheel_now = now + 1;
 }
 
-void force_garbage(struct alarm_data * data){
+/* Next tick where something must be done (expiry or cascade) */
+static int64_t wheel_next_tick(void) {
+  int64_t t;
 
-  garbage(&data);
+  for (t = wheel_now; ; t++) {
+    if (wheel[0][t & WHEEL_MASK] != NULL) return t;
+    if ((t & WHEEL_MASK) == WHEEL_MASK) return t + 1;
+  }
+}
 
+static void * timer_thread(void * arg) {
+  int64_t next;
+  int64_t deadline;
+  struct timespec ts;
+
+  pthread_mutex_lock(&alarm_lock);
+  for (;;) {
+    wheel_advance(current_tick());
+    if (wheel_count == 0) {
+      pthread_cond_wait(&timer_cond, &alarm_lock);
+    } else {
+      next = wheel_next_tick();
+      /* (ticks are converted to the clock of timer_cond) */
+      clock_gettime(TIMER_COND_CLOCK, &ts);
+      deadline = (int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000 +
+        (next - current_tick());
+      ts.tv_sec = deadline / 1000;
+      ts.tv_nsec = (deadline % 1000) * 1000000;
+      pthread_cond_timedwait(&timer_cond, &alarm_lock, &ts);
+    }
+  }
+  return (void *)NULL;
 }
 
-CVOID__PROTO(interrupt_worker, int signal_number); /* NOTE: do not use kill(), it will not work in daemons since we do not set SIGINT handler for nontty! (JF) */
+/* The timer thread does not survive fork(); start a new one in the
+   child when needed. The alarms inherited from the parent are
+   stopped and forgotten (their chains are not freed, the worker that
+   forked may still refer to them and it releases its own chain when
+   it exits call_with_time_limit/3) */
+static void alarm_atfork_child(void) {
+  struct alarm_owner * owner;
+  struct alarm_data * data;
+  int level, index;
+
+  pthread_mutex_init(&alarm_lock, NULL);
+  for (owner = alarm_owners; owner != NULL; owner = owner->next) {
+    for (data = owner->alarms; data != NULL; data = data->next) {
+      if (data->state == SCHEDULED) data->state = STOPPED;
+      data->wnext = NULL;
+      data->wprev = NULL;
+    }
+  }
+  for (level = 0; level < WHEEL_LEVELS; level++) {
+    for (index = 0; index < WHEEL_SIZE; index++) wheel[level][index] = NULL;
+  }
+  wheel_count = 0;
+  alarm_owners = NULL;
+  timer_started = 0;
+}
 
-void * ciao_alarm(void * ptr){
- 
-  struct alarm_data * data = (struct alarm_data *) ptr;
-  
-  // printf("ciao_alarm(%d) called\n", ptr); 
-  
-  pthread_mutex_lock(&(data->mutex));
-  pthread_mutex_unlock(&(data->mutex));
-
-  // printf("ciao_alarm(%d) (%d) alarm scheduled \n", ptr, data->number); 
-  
-  usleep(data->time * 1000);
-
-  pthread_mutex_lock(&(data->mutex));
-  if (data->state == SCHEDULED)
-    { 
-      pthread_mutex_lock(older_sent_signal_mutex);
-      if ((older_sent_signal == 0) || (data->number < older_sent_signal))
-          older_sent_signal = data->number;
-      pthread_mutex_unlock(older_sent_signal_mutex);
-      data->state = DONE;
-      data->sent = ciao_true; 
-      // printf("%d kill %d (%d-%d) \n", getpid(), main_pid, data, data->number);
-      // kill(main_pid, SIGINT);
-      interrupt_worker(main_worker, SIGINT);
-
-      /*  printf("signal send : %d", data->number); */
-    }  
-  pthread_mutex_unlock(&(data->mutex));
+static int ensure_timer_thread(void) {
+  pthread_t thread;
+  pthread_condattr_t attr;
 
-  return (void *)NULL;
+  if (timer_started) return 1;
+  pthread_condattr_init(&attr);
+#if !defined(DARWIN)
+  pthread_condattr_setclock(&attr, TIMER_COND_CLOCK);
+#endif
+  pthread_cond_init(&timer_cond, &attr);
+  pthread_condattr_destroy(&attr);
+  if (pthread_create(&thread, NULL, timer_thread, NULL)) {
+    perror("start_alarm: ");
+    return 0;
+  }
+  pthread_detach(thread);
+  if (!atfork_registered) {
+    pthread_atfork(NULL, NULL, alarm_atfork_child);
+    atfork_registered = 1;
+  }
+  timer_started = 1;
+  return 1;
 }
 
-struct alarm_data * init_alarm(int time, struct alarm_data * last){
- 
-  struct alarm_data ** ptr;
-  int number;
+/* ------------------------------------------------------------------------- */
+/* Alarms */
 
-  // printf("init_alarm(%d, %d) called\n", time, last); 
+static struct alarm_owner * get_owner(worker_t * worker) {
+  struct alarm_owner * owner;
 
+  for (owner = alarm_owners; owner != NULL; owner = owner->next) {
+    if (owner->worker == worker) return owner;
+  }
+  owner = (struct alarm_owner *) ciao_malloc(sizeof(struct alarm_owner));
+  owner->worker = worker;
+  owner->alarms = NULL;
+  owner->older_sent_signal = 0;
+  owner->next = alarm_owners;
+  alarm_owners = owner;
+  return owner;
+}
 
-  if (last == NULL) 
-    {
-      if ( older_sent_signal_mutex == NULL )  
-        // first call: initialize library.
-        {
-          // printf("initialize library\n");
+static int stop_alarm_(struct alarm_data * data) {
+  switch (data->state) {
+  case SCHEDULED:
+    wheel_remove(data);
+  case INITIALIZED:
+    data->state = STOPPED;
+    return 0;
+  default:
+    // alarm already stopped or done
+    return 1;
+  }
+}
+
+static void garbage(struct alarm_data ** data){
+  struct alarm_data * next;
+  struct alarm_data * curr;
+
+  for (curr = *data; curr != NULL; curr = next) {
+    next = curr->next;
+    stop_alarm_(curr);
+    if (curr->owner->older_sent_signal >= curr->number) {
+      curr->owner->older_sent_signal = 0;
+    }
+    ciao_free(curr);
+  }
+  *data = NULL;
+}
 
-          // main_pid = getpid();
-          main_worker = get_my_worker();
+void force_garbage(struct alarm_data * data){
+  pthread_mutex_lock(&alarm_lock);
+  garbage(&data);
+  pthread_mutex_unlock(&alarm_lock);
+}
 
-          older_sent_signal_mutex = ciao_malloc(sizeof(pthread_mutex_t));
-          pthread_mutex_init(older_sent_signal_mutex, NULL);
+/* Free the alarm chain of the owner of data (and the owner) */
+void release_alarms(struct alarm_data * data){
+  struct alarm_owner * owner;
+  struct alarm_owner ** ptr;
+
+  pthread_mutex_lock(&alarm_lock);
+  owner = data->owner;
+  garbage(&(owner->alarms));
+  /* (it is not in the list if it comes from the parent of a fork) */
+  for (ptr = &alarm_owners; *ptr != NULL; ptr = &((*ptr)->next)) {
+    if (*ptr == owner) {
+      *ptr = owner->next;
+      break;
+    }
+  }
+  ciao_free(owner);
+  pthread_mutex_unlock(&alarm_lock);
+}
 
-          // printf("library initialized\n");
-        }
-      else 
-        {
-          //printf("garbage all alarms\n");
-          
-          garbage(&(ciao_alarms));
+struct alarm_data * init_alarm(int time, struct alarm_data * last){
+  struct alarm_data ** ptr;
+  struct alarm_owner * owner;
+  int number;
 
-          // printf("all alarms garbaged\n");
-        }
+  pthread_mutex_lock(&alarm_lock);
 
-      older_sent_signal = 0; 
+  if (last == NULL)
+    {
+      owner = get_owner(get_my_worker());
+      garbage(&(owner->alarms));
+      owner->older_sent_signal = 0;
       number = 1;
-      ptr = &ciao_alarms;
+      ptr = &(owner->alarms);
     }
   else
-    { 
-      // printf("garbage all alarms older that %d\n", last->next);
-          
+    {
+      owner = last->owner;
       garbage(&(last->next));
-      
       number = last->number + 1;
       ptr = &(last->next);
-
-      // printf("all alarms older that %d garbaged\n", last->next);
     }
-  
-  *ptr = 
+
+  *ptr =
     (struct alarm_data*) ciao_malloc(sizeof(struct alarm_data));
 
   last = *ptr;
@@ -166,92 +366,57 @@ struct alarm_data * init_alarm(int time, struct alarm_data * last){
   last->state = INITIALIZED;
   last->sent = ciao_false;
   last->number = number;
-  last->time = time;  
-  last->next = NULL; 
-  pthread_mutex_init(&(last->mutex), NULL);
-
-  pthread_mutex_lock(&(last->mutex));
-  
-  // printf(" last->number = %d, older_sent_signal = %d\n",  last->number,  older_sent_signal);
-  
-  if (pthread_create(&(last->thread), NULL, ciao_alarm, (void*) last)){ 
-    perror("init_alarm:");
-    return 0;
-  }
-  
-  // printf("init_alarm returns %d\n", last); 
+  last->time = time;
+  last->owner = owner;
+  last->next = NULL;
+  last->wnext = NULL;
+  last->wprev = NULL;
+
+  pthread_mutex_unlock(&alarm_lock);
 
   return (void *) last;
 }
 
-
 int start_alarm(struct alarm_data * data){
+  int ret;
 
-  if (data->state == INITIALIZED)
+  pthread_mutex_lock(&alarm_lock);
+  if (data->state == INITIALIZED && ensure_timer_thread())
     {
       data->state = SCHEDULED;
-      pthread_mutex_unlock(&(data->mutex));
-      return 1;
+      data->expiry = current_tick() + data->time;
+      if (wheel_count == 0) wheel_now = current_tick();
+      wheel_insert(data);
+      pthread_cond_signal(&timer_cond);
+      ret = 1;
     }
-  else return 0;
+  else ret = 0;
+  pthread_mutex_unlock(&alarm_lock);
+  return ret;
 }
 
 int stop_alarm(struct alarm_data * data){
-  
-  // printf("stop_alarm(%d) called\n", data);   
+  int ret;
 
-  switch (data->state) {
-  case SCHEDULED:
-    //  main thread does not hold lock
-    pthread_mutex_lock(&(data->mutex));
-  case INITIALIZED:  
-    //  main thread does not hold lock
-    if(pthread_cancel(data->thread)){
-      perror("stop_alarm: ");
-      return 2; 
-    }
-    data->state = STOPPED;
-    pthread_mutex_unlock(&(data->mutex));
-    return 0;
-  default:
-    // alarm already stopped or done
-    return 1;
-  }
+  pthread_mutex_lock(&alarm_lock);
+  ret = stop_alarm_(data);
+  pthread_mutex_unlock(&alarm_lock);
+  return ret;
 }
 
 int alarm_stat(struct alarm_data * data){
-
   int value;
-  
-  // printf(" alarm_stat(%d) called\n", data);
-  // printf(" data->number = %d, older_sent_signal = %d\n",  data->number,  older_sent_signal);
 
+  pthread_mutex_lock(&alarm_lock);
+  if (data->sent) value = (data->state | (1 << 2));
+  else value = data->state;
 
-  if (data->state == INITIALIZED)
-    // main thread holds the lock
-    value = data->state;
-  else 
-    // main thread does not holds the lock
-    {
-      pthread_mutex_lock(&(data->mutex));
-      if (data->sent) value = (data->state | (1 << 2));
-      else value = data->state;
-      pthread_mutex_unlock(&(data->mutex));
-    }
-
-  pthread_mutex_lock(older_sent_signal_mutex);
-  if (older_sent_signal == data->number)
+  if (data->owner->older_sent_signal == data->number)
   {
-    value = (value | (1 << 3));         
-    older_sent_signal = 0;
+    value = (value | (1 << 3));
+    data->owner->older_sent_signal = 0;
   }
-  pthread_mutex_unlock(older_sent_signal_mutex);
+  pthread_mutex_unlock(&alarm_lock);
 
   return value;
 }
-
-
-
-
-
-
@@ -43,12 +43,28 @@
 :- meta_predicate(call_with_time_limit(+, :, :)).
 call_with_time_limit(Time, Call, Handler) :- 
     Time > 0, !,
+    global_vars:getval(last, Last),
     init_alarm(Time, Id),
+    ( var(Last) ->
+        % (outermost call, release the alarms of this worker on exit)
+        ( catch(with_alarm(Id, Call, Handler),
+                E,
+                (release_alarms(Id), throw(E))) ->
+            release_alarms(Id),
+            global_vars:setval(last, _)
+        ; release_alarms(Id),
+          fail
+        )
+    ; with_alarm(Id, Call, Handler)
+    ).
+call_with_time_limit(_Time, _Call, Handler) :- 
+    call(Handler).
+
+:- meta_predicate(with_alarm(+, :, :)).
+with_alarm(Id, Call, Handler) :-
     catch(begin(Id, Call),
           E,
           on_exception(E, Id, Handler)).
-call_with_time_limit(_Time, _Call, Handler) :- 
-    call(Handler).
 
 :- meta_predicate(begin(+, :)).
 begin(Id, Call) :- 
@@ -136,6 +152,12 @@ alarm_stat(Id, State, Send, IsOldest) :-
 :- trust pred alarm_stat_c(in(ID), go(State)) :: address * c_int
     + (returns(State),  foreign(alarm_stat)). 
 
+release_alarms(Id) :-
+    release_alarms_c(Id).
+
+:- trust pred release_alarms_c(in(Id)) :: address
+    + (foreign(release_alarms)).
+
 % garbage:- 
 %       global_vars:getval(last, Id), 
 %       (
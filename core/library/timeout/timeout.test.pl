@@ -0,0 +1,85 @@
+:- module(_, [], [assertions]).
+
+:- doc(title, "Tests for timeout.pl").
+
+:- use_module(library(timeout)).
+:- use_module(library(process), [process_fork/2, process_join/1]).
+:- use_module(engine(runtime_control), [statistics/2]).
+
+:- export(fires/0).
+:- test fires # "The handler is called when the limit is exceeded".
+
+fires :-
+    call_with_time_limit(100, spin(5000), R = timeout),
+    R == timeout.
+
+:- export(completes/0).
+:- test completes # "Goals that complete in time are not interrupted".
+
+completes :-
+    call_with_time_limit(1000, spin(10), R = timeout),
+    var(R).
+
+:- export(throws/0).
+:- test throws # "The default handler throws time_limit_exceeded".
+
+throws :-
+    catch((call_with_time_limit(100, spin(5000)), fail),
+          time_limit_exceeded, true).
+
+:- export(nested/0).
+:- test nested # "Only the limit that is exceeded fires".
+
+nested :-
+    call_with_time_limit(5000,
+        call_with_time_limit(100, spin(5000), R1 = inner),
+        R2 = outer),
+    R1 == inner,
+    var(R2),
+    call_with_time_limit(100,
+        call_with_time_limit(5000, spin(5000), R3 = inner),
+        R4 = outer),
+    var(R3),
+    R4 == outer.
+
+:- export(sequential/0).
+:- test sequential # "Alarms are released and created again in
+   consecutive calls".
+
+sequential :-
+    ( between_(1, 200, _),
+      \+ call_with_time_limit(1000, true, fail) ->
+        fail
+    ; true
+    ),
+    call_with_time_limit(100, spin(5000), R = timeout),
+    R == timeout.
+
+:- export(fork/0).
+:- test fork # "Alarms pending at fork() do not fire in the child,
+   which can use its own".
+
+fork :-
+    call_with_time_limit(500,
+        process_fork(fork_child, [background(P), status(S)]),
+        fail),
+    process_join(P),
+    S == 0.
+
+fork_child :-
+    spin(1000),
+    call_with_time_limit(100, spin(5000), R = timeout),
+    R == timeout.
+
+% Busy wait (interruptible) for Ms milliseconds
+spin(Ms) :-
+    statistics(walltime, [T0, _]),
+    T is T0 + Ms,
+    spin_until(T).
+
+spin_until(T) :-
+    statistics(walltime, [T1, _]),
+    ( T1 >= T -> true ; spin_until(T) ).
+
+between_(L, H, L) :- L =< H.
+between_(L, H, X) :- L < H, L1 is L + 1, between_(L1, H, X).
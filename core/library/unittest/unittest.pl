@@ -367,7 +367,10 @@ run_tests(Target, Opts0, Actions) :-
     %
     cleanup_test_results,
     cleanup_test_db,
+    cleanup_test_times,
     ( DoCheck = no, ShowRes = no, DoSummary = no -> true % do nothing?
+    ; DoCheck = yes, Filter = [], use_jobs(Opts, Modules, Jobs) ->
+        run_tests_parallel(Modules, Jobs, Opts, ShowRes, DoSummary)
     ; maplist(run_tests_one_mod(Filter, Opts, DoCheck, ShowRes, DoSummary, SelVers), Modules)
     ),
     ( DoSummary = yes -> do_summary(Modules, Filter, Actions, Opts) ; true ),
@@ -376,6 +379,7 @@ run_tests(Target, Opts0, Actions) :-
     % (free memory)
     cleanup_modules_under_test,
     cleanup_test_db,
+    cleanup_test_times,
     cleanup_test_results.
 
 % Load and run the tests. Keep (or restore) tests results (for summaries). Show results if required.
@@ -406,6 +410,57 @@ run_tests_one_mod(_Filter, _Opts, _DoCheck, _ShowRes, _DoSummary, _SelVers, Modu
     % (e.g., loading retreived some test assertions but it still failed)
     mark_missing_as_aborted(Module).
 
+% Use Jobs>1 workers (only when there are several modules)
+use_jobs(Opts, Modules, Jobs) :-
+    get_opt(jobs(Jobs), Opts),
+    Jobs > 1,
+    Modules = [_,_|_],
+    eng_supports(processes).
+
+% Run the tests in parallel worker processes (see unittest_scheduler),
+% then restore their results from the .testin and .testout files of
+% each module, in order (as in a sequential run without check).
+run_tests_parallel(Modules, Jobs, Opts, ShowRes, DoSummary) :-
+    ( % (failure-driven loop)
+      member(Module, Modules),
+        remove_test_input(Module, new),
+        remove_test_output(Module, new),
+        fail
+    ; true
+    ),
+    schedule_tests(Modules, Jobs, ~worker_opts(Opts)),
+    maplist(merge_results_one_mod(Opts, ShowRes, DoSummary), Modules).
+
+worker_opts([], []).
+worker_opts([Opt|Opts], WOpts) :-
+    ( Opt = jobs(_) -> WOpts = WOpts1 ; WOpts = [Opt|WOpts1] ),
+    worker_opts(Opts, WOpts1).
+
+merge_results_one_mod(Opts, ShowRes, DoSummary, Module) :-
+    load_tests_one_mod(no, new, Module), % (fails if the module had errors)
+    !,
+    file_test_output(Module, new, TestOutFile),
+    ( file_exists(TestOutFile) -> load_test_output(Module, new) ; true ),
+    mark_missing_as_aborted(Module),
+    ( ShowRes = yes -> show_results_one_mod(Module, [], Opts) ; true ),
+    ( DoSummary = no -> cleanup_test_results ; true ).
+merge_results_one_mod(_Opts, _ShowRes, _DoSummary, _Module).
+
+:- use_module(engine(system_info), [eng_supports/1]).
+:- use_module(library(unittest/unittest_scheduler), [schedule_tests/3]).
+:- use_module(library(read), [read/2]).
+
+:- export(unittest_worker_batch/0).
+:- pred unittest_worker_batch # "Main predicate for the worker
+   processes of a parallel run (see unittest_scheduler). Do not use
+   directly.".
+
+unittest_worker_batch :-
+    % (written as text by schedule_tests/3, independently of read_data/2)
+    read(user_input, worker_opts(Paths, Opts, Suffs)),
+    ( Suffs = [Suff] -> opt_suffix(_, Suff) ; true ),
+    run_tests(Paths, Opts, [check]).
+
 % Load code or test db (as required)
 load_tests_one_mod(DoCheck, SelVers, Module) :-
     ( DoCheck = yes -> load_tests(Module) % (fails if the module had errors)
@@ -469,7 +524,7 @@ check_actions([Action|Actions]) :-
 %! # Decide modules to test (frontend)
 
 :- use_module(engine(internals), [opt_suff/1]).
-:- use_module(library(compiler/c_itf), [module_from_base/2]).
+:- use_module(library(compiler/c_itf), [module_from_base/2, opt_suffix/2]).
 
 % TODO: keep it simple, use ciaopp for advanced stuff?
 
@@ -776,7 +831,10 @@ check_tests_one_mod(Module, Filter, Opts, SaveRes, ShowRes) :-
         end_messages
     ; true
     ),
-    ( OutS = none -> true ; close(OutS) ).
+    ( OutS = none -> true
+    ; close(OutS),
+      save_test_times(Module)
+    ).
 
 % options for runner
 runner_opts(TestRunDir, WrapperMod, Opts, RunnerOpts) :-
@@ -37,6 +37,9 @@
 %  - test_output_db/2: The result for each solution generated for the
 %    goals under test.
 % 
+%  - test_time_db/2: The time (in ms) spent in each test, used to
+%    estimate the cost of modules when scheduling parallel runs.
+% 
 % Which are shared in the following files:
 % 
 %  - module.testout: File that stores test results.
@@ -51,6 +54,9 @@
 %  - module.testin-saved: Saved version of .testin file for
 %    regression.
 % 
+%  - module.testtimes: Timing history of the tests in a module (see
+%    unittest_scheduler).
+% 
 %  - <tmp_dir>/test_input_auto: shares test attributes between driver
 %    and runner.
 % 
@@ -74,6 +80,9 @@
 % Test results
 :- export(test_output_db/2).
 :- data test_output_db/2.
+% Test times (ms)
+:- export(test_time_db/2).
+:- data test_time_db/2.
 % Tests for runner
 :- export(runtest_db/4).
 :- data runtest_db/4.
@@ -107,10 +116,15 @@ run_filter([Filter|Filters], Test) :-
 cleanup_test_results :-
     retractall_fact(test_output_db(_, _)).
 
+:- export(cleanup_test_times/0).
+cleanup_test_times :-
+    retractall_fact(test_time_db(_, _)).
+
 % ---------------------------------------------------------------------------
 %! # Persistent state
 
-:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1]).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1, file_exists/1]).
+:- use_module(library(lists), [member/2]).
 
 :- data tmp_dir/1.
 
@@ -166,6 +180,53 @@ load_test_output(Module,Vers) :-
 assert_test_output(test_output_db(A, B)) :-
     assertz_fact(test_output_db(A, B)).
 
+:- export(remove_test_output/2).
+remove_test_output(Module, Vers) :-
+    file_test_output(Module, Vers, File),
+    del_file_nofail(File).
+
+% .testtimes
+
+:- export(file_test_times/2).
+file_test_times(Module, File) :-
+    module_base_path_db(Module,Base,_),
+    atom_concat(Base,'.testtimes',File).
+
+:- export(read_test_times/2).
+% Times is the list of TestId-Ms pairs stored in File ([] if it does
+% not exist)
+read_test_times(File, Times) :-
+    ( file_exists(File) ->
+        open(File, read, SI),
+        read_test_times_(SI, Times),
+        close(SI)
+    ; Times = []
+    ).
+
+read_test_times_(SI, Times) :-
+    ( read_data(SI, test_time_db(TestId, T)) ->
+        Times = [TestId-T|Times1],
+        read_test_times_(SI, Times1)
+    ; Times = []
+    ).
+
+:- export(save_test_times/1).
+% Save the times of the tests of Module in test_time_db/2, averaged
+% with the previous run (so that a single slow run does not dominate)
+save_test_times(Module) :-
+    file_test_times(Module, File),
+    read_test_times(File, Old),
+    open(File, write, SO),
+    ( % (failure-driven loop)
+      test_db(TestId, Module, _, _, _, _, _, _),
+      test_time_db(TestId, T0),
+        ( member(TestId-T1, Old) -> T is (T0 + T1) // 2 ; T = T0 ),
+        write_data(SO, test_time_db(TestId, T)),
+        fail
+    ; true
+    ),
+    close(SO).
+
 % runtest input (file from passing test inputs from driver to runner)
 file_runtest_input_name('test_input_auto.pl').
 
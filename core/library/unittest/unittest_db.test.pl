@@ -0,0 +1,38 @@
+:- module(_, [], [assertions, datafacts]).
+
+:- doc(title, "Tests for the test times of unittest_db.pl").
+
+:- use_module(library(unittest/unittest_db)).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1, file_exists/1]).
+
+:- export(times/0).
+:- test times # "Test times are saved, averaged with the previous
+   run".
+
+times :-
+    M = unittest_times_ex,
+    mktemp_in_tmp('unittest_timesXXXXXX', Base),
+    assertz_fact(module_base_path_db(M, Base, Base)),
+    assertz_fact(test_db(t1, M, _, _, _, _, _, _)),
+    assertz_fact(test_db(t2, M, _, _, _, _, _, _)),
+    file_test_times(M, File),
+    ( check_times(M, File) -> Ok = yes ; Ok = no ),
+    cleanup_test_times,
+    retractall_fact(test_db(_, M, _, _, _, _, _, _)),
+    retractall_fact(module_base_path_db(M, _, _)),
+    delete_file(Base),
+    ( file_exists(File) -> delete_file(File) ; true ),
+    Ok = yes.
+
+check_times(M, File) :-
+    read_test_times(File, []), % (never tested)
+    cleanup_test_times,
+    assertz_fact(test_time_db(t1, 100)),
+    assertz_fact(test_time_db(t2, 40)),
+    save_test_times(M),
+    read_test_times(File, [t1-100, t2-40]),
+    cleanup_test_times,
+    assertz_fact(test_time_db(t1, 300)),
+    assertz_fact(test_time_db(t2, 61)),
+    save_test_times(M),
+    read_test_times(File, [t1-200, t2-50]).
@@ -15,7 +15,8 @@
 :- use_module(engine(system_info), [eng_supports/1]).
 :- use_module(library(lists), [member/2]).
 
-:- use_module(library(unittest/unittest_db), [read_data/2]).
+:- use_module(engine(runtime_control), [statistics/2]).
+:- use_module(library(unittest/unittest_db), [read_data/2, test_time_db/2]).
 :- use_module(library(unittest/unittest_runner_common), [
     unittest_runner_main/2, % (for same process)
     runner_recover_aborted/5,
@@ -24,6 +25,7 @@
 
 :- data runner_cont/1.
 :- data runner_pending/2.
+:- data runner_start/2.
 
 :- export(unittest_runner/2).
 :- meta_predicate unittest_runner(?, pred(2)).
@@ -133,6 +135,7 @@ test_recover(TestId, Result, Opts, RecvData) :-
     ; throw(bug_no_dir)
     ),
     runner_recover_aborted(TestRunDir, Opts, unknown, Result, TRes),
+    record_test_time(TestId), % (time until it was aborted)
     RecvData(runner_output(TestId, TRes)).
 
 :- meta_predicate on_runner_msg(pred(2), ?).
@@ -144,13 +147,26 @@ on_runner_msg(TreatRes, X) :-
     ; X = runner_begin_test(TestId,Timeout) -> % working on TestId
         % other results for the same TestId)
         ( runner_pending(TestId0,_) -> message(error0, [bug_pending(TestId0)]) ; true ),
-        set_fact(runner_pending(TestId,Timeout))
+        set_fact(runner_pending(TestId,Timeout)),
+        statistics(walltime, [T0,_]),
+        set_fact(runner_start(TestId,T0))
         % message(error0, [runner_begin_test(TestId,Timeout)])
     ; X = runner_end_test(TestId) -> % no longer working on TestId
         ( runner_pending(TestId0,_), TestId \== TestId0 -> message(error0, [bug_pending(TestId,TestId0)]) ; true ),
-        retractall_fact(runner_pending(_,_))
+        retractall_fact(runner_pending(_,_)),
+        record_test_time(TestId)
         % message(error0, [runner_end_test(TestId)])
     ; X = runner_output(TestId, TRes) ->
         TreatRes(TestId, TRes)
     ; message(error0, [unknown_msg(X)])
     ).
+
+% Save the (wall) time spent in TestId, for scheduling (see unittest_scheduler)
+record_test_time(TestId) :-
+    ( retract_fact(runner_start(TestId,T0)) ->
+        statistics(walltime, [T,_]),
+        Ms is integer(T - T0),
+        retractall_fact(test_time_db(TestId,_)),
+        assertz_fact(test_time_db(TestId,Ms))
+    ; true
+    ).
@@ -48,6 +48,13 @@
     @item @tt{sameproc}: Use same process to run the tests (note: use
       with care, aborted tests may interrupt the whole process).
 
+    @item @tt{jobs(N)}: Run the tests of different modules in (at
+      most) @var{N} parallel worker processes. Modules are assigned
+      to workers from the longest to the shortest, using the times
+      of previous runs (saved in @tt{module.testtimes}). Results are
+      shown and summarized as in a sequential run once all workers
+      have finished. Ignored when filters are used.
+
     @end{itemize}").
 
 :- export(test_option/1).
@@ -60,6 +67,7 @@ test_option := saved_vers.
 test_option := rtc_entry.
 test_option := dir_rec.
 test_option := sameproc.
+test_option := jobs(~int).
 
 % stdout/stderr redirection
 test_redirect_opt := save % save (for regression). Default
@@ -0,0 +1,173 @@
+:- module(_, [], [assertions, fsyntax, hiord, datafacts]).
+
+%! \title Unittest scheduler
+%
+%  \module Run the tests of several modules in parallel worker
+%  processes (see the @tt{jobs(N)} test option).
+%
+%  Modules are distributed among the workers with the
+%  @em{longest-processing-time-first} rule: modules are sorted by
+%  their estimated cost and each one is assigned to the worker with
+%  the smallest load so far. The cost of a module is the sum of the
+%  times of its tests in the last runs (see the @tt{.testtimes} files
+%  in @lib{unittest_db}). Modules that were never tested are
+%  estimated with the average cost of the known ones.
+%
+%  Each worker is a @apl{ciaosh} process that runs the tests of its
+%  modules as a sequential @pred{run_tests/3} call, i.e., each test
+%  still runs in a separate runner process (with its timeouts and
+%  recovery from aborted tests). Results are left in the
+%  @tt{.testin} and @tt{.testout} files of each module, which are
+%  merged by the driver.
+
+:- use_module(engine(stream_basic)).
+:- use_module(engine(internals), [opt_suff/1]).
+:- use_module(library(lists), [length/2]).
+:- use_module(library(sort), [keysort/2]).
+:- use_module(library(system), [file_exists/1]).
+:- use_module(library(process), [process_join/1]).
+:- use_module(ciaobld(cpx_process), [cpx_process_call/3]).
+:- use_module(ciaobld(config_common), [cmd_path/4]).
+
+:- use_module(library(unittest/unittest_db), [
+    module_base_path_db/3,
+    file_test_times/2,
+    read_test_times/2
+]).
+
+% (estimated cost, in ms, of loading a module and starting its runner)
+module_overhead(200).
+% (estimated cost of a module when nothing is known)
+default_cost(1000).
+
+:- export(schedule_tests/3).
+:- pred schedule_tests(Modules, Jobs, Opts) : list(atm) * int * list
+   # "Run the tests of @var{Modules} with options @var{Opts} in
+   (at most) @var{Jobs} worker processes and wait for them.".
+
+schedule_tests(Modules, Jobs, Opts) :-
+    estimate_costs(Modules, CostMods),
+    length(Modules, N),
+    ( Jobs < N -> K = Jobs ; K = N ),
+    lpt_schedule(CostMods, K, Bins),
+    ( opt_suff(Suff) -> Suffs = [Suff] ; Suffs = [] ),
+    start_workers(Bins, Opts, Suffs, Ps),
+    join_workers(Ps).
+
+% ---------------------------------------------------------------------------
+%! # Cost estimation
+
+:- export(estimate_costs/2).
+:- pred estimate_costs(Modules, CostMods) : list(atm) * var
+   # "@var{CostMods} are the @tt{Cost-Module} pairs of @var{Modules}
+   (whose paths are known in @lib{unittest_db}), largest cost
+   first.".
+
+estimate_costs(Modules, CostMods) :-
+    known_costs(Modules, Known),
+    average_cost(Known, Avg),
+    known_or_default(Modules, Known, Avg, CostMods0),
+    keysort(CostMods0, CostMods1),
+    reverse_(CostMods1, [], CostMods).
+
+known_costs([], []).
+known_costs([M|Ms], Known) :-
+    file_test_times(M, File),
+    ( \+ file_exists(File) -> Known = Known1 % (never tested)
+    ; read_test_times(File, Times),
+      sum_times(Times, 0, Sum),
+      module_overhead(C0),
+      Cost is C0 + Sum,
+      Known = [M-Cost|Known1]
+    ),
+    known_costs(Ms, Known1).
+
+sum_times([], S, S).
+sum_times([_-T|Ts], S0, S) :- S1 is S0 + T, sum_times(Ts, S1, S).
+
+average_cost([], Avg) :- !, default_cost(Avg).
+average_cost(Known, Avg) :-
+    sum_times(Known, 0, Sum),
+    length(Known, N),
+    Avg is Sum // N.
+
+known_or_default([], _, _, []).
+known_or_default([M|Ms], Known, Avg, [Cost-M|CostMods]) :-
+    ( member_key(Known, M, Cost0) -> Cost = Cost0 ; Cost = Avg ),
+    known_or_default(Ms, Known, Avg, CostMods).
+
+member_key([K0-V0|KVs], K, V) :-
+    ( K0 == K -> V = V0 ; member_key(KVs, K, V) ).
+
+reverse_([], Ys, Ys).
+reverse_([X|Xs], Ys0, Ys) :- reverse_(Xs, [X|Ys0], Ys).
+
+% ---------------------------------------------------------------------------
+%! # LPT assignment
+
+:- export(lpt_schedule/3).
+:- pred lpt_schedule(CostMods, K, Bins) : list * int * var
+   # "@var{Bins} is the assignment of the modules in @var{CostMods}
+   (@tt{Cost-Module} pairs, largest cost first) to @var{K} workers,
+   as a list of @tt{Load-Modules} pairs (with @tt{Modules} in reverse
+   order of assignment).".
+
+lpt_schedule(CostMods, K, Bins) :-
+    empty_bins(K, Bins0),
+    lpt_assign(CostMods, Bins0, Bins).
+
+empty_bins(0, []) :- !.
+empty_bins(K, [0-[]|Bins]) :- K1 is K - 1, empty_bins(K1, Bins).
+
+lpt_assign([], Bins, Bins).
+lpt_assign([Cost-M|CostMods], Bins0, Bins) :-
+    add_to_lightest(Bins0, Cost, M, Bins1),
+    lpt_assign(CostMods, Bins1, Bins).
+
+add_to_lightest(Bins0, Cost, M, Bins) :-
+    Bins0 = [L0-_|_],
+    min_load(Bins0, L0, Min),
+    add_to_load(Bins0, Min, Cost, M, Bins).
+
+min_load([], Min, Min).
+min_load([L-_|Bins], Min0, Min) :-
+    ( L < Min0 -> min_load(Bins, L, Min) ; min_load(Bins, Min0, Min) ).
+
+add_to_load([L-Ms|Bins], Min, Cost, M, Bins2) :-
+    ( L =:= Min ->
+        L1 is L + Cost,
+        Bins2 = [L1-[M|Ms]|Bins]
+    ; Bins2 = [L-Ms|Bins1],
+      add_to_load(Bins, Min, Cost, M, Bins1)
+    ).
+
+% ---------------------------------------------------------------------------
+%! # Workers
+
+ciaosh_exec := ~cmd_path(core, plexe, 'ciaosh').
+
+start_workers([], _, _, []).
+start_workers([_-RevMods|Bins], Opts, Suffs, Ps) :-
+    reverse_(RevMods, [], Mods),
+    mods_paths(Mods, Paths),
+    ( Paths = [] -> Ps = Ps1
+    ; % Note: we cannot use invoke_ciaosh_batch/2 since it captures stdin
+      absolute_file_name(library(unittest), Unittest),
+      cpx_process_call(~ciaosh_exec, ['-q', '-f', '-u', Unittest, '-e', 'unittest_worker_batch'], [
+          stdin(terms([worker_opts(Paths, Opts, Suffs)])), % (read with read/2)
+          status(_), % (ignore status, missing results are marked as aborted)
+          background(P)
+      ]),
+      Ps = [P|Ps1]
+    ),
+    start_workers(Bins, Opts, Suffs, Ps1).
+
+mods_paths([], []).
+mods_paths([M|Ms], [Path|Paths]) :-
+    module_base_path_db(M, _, Path),
+    mods_paths(Ms, Paths).
+
+join_workers([]).
+join_workers([P|Ps]) :-
+    ( process_join(P) -> true ; true ),
+    join_workers(Ps).
@@ -0,0 +1,65 @@
+:- module(_, [], [assertions, datafacts]).
+
+:- doc(title, "Tests for unittest_scheduler.pl").
+
+:- use_module(library(unittest/unittest_scheduler)).
+:- use_module(library(unittest/unittest_db)).
+:- use_module(library(system), [mktemp_in_tmp/2, delete_file/1, file_exists/1]).
+
+:- export(lpt/0).
+:- test lpt # "Each module goes to the worker with the smallest load
+   so far (the first one on ties)".
+
+lpt :-
+    lpt_schedule([7-a, 5-b, 4-c, 3-d, 1-e], 2, Bins1),
+    Bins1 = [10-[d, a], 10-[e, c, b]],
+    lpt_schedule([2-a, 2-b], 3, Bins2),
+    Bins2 = [2-[a], 2-[b], 0-[]].
+
+:- export(costs/0).
+:- test costs # "Costs come from the saved test times, modules that
+   were never tested get the average cost".
+
+costs :-
+    Ms = [unittest_costs_a, unittest_costs_b, unittest_costs_c],
+    add_modules(Ms, Bases),
+    ( check_costs(Ms) -> Ok = yes ; Ok = no ),
+    cleanup_test_times,
+    remove_modules(Ms, Bases),
+    Ok = yes.
+
+check_costs(Ms) :-
+    Ms = [A, B, C],
+    save_times(A, [t1-100, t2-40]),
+    save_times(C, [t3-10]),
+    estimate_costs(Ms, CostMods),
+    % (each module also costs 200 ms to load and start its runner)
+    CostMods = [340-A, 275-B, 210-C].
+
+save_times(M, Times) :-
+    cleanup_test_times,
+    ( member_(Id-T, Times),
+        assertz_fact(test_db(Id, M, _, _, _, _, _, _)),
+        assertz_fact(test_time_db(Id, T)),
+        fail
+    ; true
+    ),
+    save_test_times(M).
+
+add_modules([], []).
+add_modules([M|Ms], [Base|Bases]) :-
+    mktemp_in_tmp('unittest_costsXXXXXX', Base),
+    assertz_fact(module_base_path_db(M, Base, Base)),
+    add_modules(Ms, Bases).
+
+remove_modules([], []).
+remove_modules([M|Ms], [Base|Bases]) :-
+    file_test_times(M, File),
+    ( file_exists(File) -> delete_file(File) ; true ),
+    delete_file(Base),
+    retractall_fact(test_db(_, M, _, _, _, _, _, _)),
+    retractall_fact(module_base_path_db(M, _, _)),
+    remove_modules(Ms, Bases).
+
+member_(X, [X|_]).
+member_(X, [_|Xs]) :- member_(X, Xs).
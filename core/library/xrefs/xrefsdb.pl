@@ -0,0 +1,592 @@
+:- module(xrefsdb, [], [assertions, regtypes, hiord, datafacts]).
+
+:- doc(title,"Incremental database of crossed-references").
+:- doc(author,"The Ciao Development Team").
+
+:- doc(module,"This library maintains a persistent index of the
+    crossed-references between the predicates of a (possibly large)
+    set of modules. Callers, callees, reachability and unused
+    predicates are then answered from the index, without reading
+    the sources again.
+
+    The index is stored in a single file, which is created or brought
+    up to date with @pred{xrefsdb_update/3}. There is an entry for
+    each module, keyed by the base name of its source and the digests
+    of its source and included files. An entry records the predicates
+    defined by the module, the calls between predicates (with callees
+    resolved to the module that defines them), the digest of its
+    interface (exported predicates), and the interfaces of the modules
+    that it imports at the time it was analyzed. On update, only the
+    modules whose contents changed, or that import a module whose
+    interface changed, are analyzed again, optionally in several
+    worker processes.
+
+    Predicates are denoted as @tt{M:F/A}. Calls from declarations
+    (e.g., @decl{initialization/1}) are recorded as calls from
+    @tt{M:(:-)/0}. Calls that cannot be resolved are recorded as
+    calls to @tt{'?':F/A}, and calls to unknown goals (e.g., a variable
+    goal, or a variable argument of a meta-predicate) as calls to
+    @tt{'?':call/1}.
+
+    For example:
+    @begin{verbatim}
+    ?- xrefsdb_update('/tmp/myapp.xrefs', ['src/a', 'src/b'], [jobs(4)]),
+       xrefsdb_callers(a:main/0, Cs),
+       xrefsdb_unused(Ps).
+    @end{verbatim}").
+
+:- doc(bug,"Multifile predicates are indexed in each module that
+    defines clauses for them.").
+
+:- use_module(engine(stream_basic)).
+:- use_module(library(aggregates), [findall/3]).
+:- use_module(library(lists), [length/2, append/3]).
+:- use_module(library(sort), [sort/2]).
+:- use_module(library(terms), [atom_concat/2]).
+:- use_module(library(read), [read/2]).
+:- use_module(library(system), [file_exists/1, delete_file/1]).
+:- use_module(library(fastrw), [fast_read/1, fast_write/1]).
+:- use_module(library(process), [process_join/1]).
+:- use_module(library(ctrlcclean), [ctrlc_clean/1]).
+:- use_module(library(errhandle), [error_protect/2]).
+:- use_module(library(compiler/c_itf), [
+    process_file/7, false/1, base_name/2, file_data/3, defines_module/2,
+    defines_pred/3, def_multifile/4, exports/5, meta_pred/4,
+    imports_pred/7, uses/2, adds/2, includes/2, clause_of/7]).
+:- use_module(library(compiler/content_stamps), [file_digest/2, term_digest/2]).
+:- use_module(library(compiler/file_buffer)).
+:- use_module(ciaobld(cpx_process), [cpx_process_call/3]).
+:- use_module(ciaobld(config_common), [cmd_path/4]).
+
+%-----------------------------------------------------------------------------
+% entry points
+
+:- export(xrefsdb_update/3).
+:- pred xrefsdb_update(Index,Files,Opts) : atm * list(sourcename) * list
+    # "Brings the index stored in file @var{Index} up to date with
+       respect to the source files @var{Files} (entries for other
+       files are removed) and loads it. Options in @var{Opts} are:
+       @begin{itemize}
+       @item @tt{jobs(N)}: analyze modules in (at most) @var{N} worker
+         processes.
+       @item @tt{analyzed(Bases)}: @var{Bases} is unified with the
+         (sorted) base names of the sources that were analyzed.
+       @end{itemize}".
+
+xrefsdb_update(Index,Files,Opts):-
+    read_index(Index),
+    files_bases(Files,Bases0),
+    sort(Bases0,Bases),
+    remove_other_entries(Bases),
+    retractall_fact(src_digest(_,_)),
+    stale_entries(Bases,Stale),
+    ( member_opt(jobs(Jobs),Opts) -> true ; Jobs = 1 ),
+    update_rounds(Stale,Index,Jobs,[],Analyzed),
+    write_index(Index),
+    derive_index,
+    ( member_opt(analyzed(Analyzed0),Opts) -> Analyzed0 = Analyzed ; true ).
+
+:- export(xrefsdb_load/1).
+:- pred xrefsdb_load(Index) : atm
+    # "Loads the index stored in file @var{Index} (as is, without
+       checking the sources).".
+
+xrefsdb_load(Index):-
+    read_index(Index),
+    derive_index.
+
+:- export(xrefsdb_callers/2).
+:- pred xrefsdb_callers(Pred,Callers) : xref_pred * var => xref_pred * list(xref_pred)
+    # "@var{Callers} are the predicates that call @var{Pred}.".
+
+xrefsdb_callers(M:F/A,Callers):-
+    findall(C, xcalled(F,A,M,C), Callers0),
+    sort(Callers0,Callers).
+
+:- export(xrefsdb_callees/2).
+:- pred xrefsdb_callees(Pred,Callees) : xref_pred * var => xref_pred * list(xref_pred)
+    # "@var{Callees} are the predicates called by @var{Pred}.".
+
+xrefsdb_callees(M:F/A,Callees):-
+    findall(C, xcall(F,A,M,C), Callees0),
+    sort(Callees0,Callees).
+
+:- export(xrefsdb_reachable/2).
+:- pred xrefsdb_reachable(Roots,Reached) : list(xref_pred) * var
+    => list(xref_pred) * list(xref_pred)
+    # "@var{Reached} are the predicates reachable from @var{Roots}
+       (including them).".
+
+xrefsdb_reachable(Roots,Reached):-
+    mark_reachable(Roots),
+    findall(M:F/A, retract_fact(reached(F,A,M)), Reached0),
+    sort(Reached0,Reached).
+
+:- export(xrefsdb_unused/1).
+:- pred xrefsdb_unused(Preds) : var => list(xref_pred)
+    # "@var{Preds} are the predicates defined in the indexed modules
+       that are not reachable from the exported and multifile
+       predicates nor from declarations.".
+
+xrefsdb_unused(Preds):-
+    findall(M:F/A, root_pred(F,A,M), Roots),
+    mark_reachable(Roots),
+    findall(M:F/A, ( xdef(F,A,M,_), \+ reached(F,A,M) ), Preds0),
+    retractall_fact(reached(_,_,_)),
+    sort(Preds0,Preds).
+
+root_pred(F,A,M):-
+    xdef(F,A,M,Kind),
+    Kind \== local.
+root_pred((:-),0,M):-
+    xmod(_,M,_,_,_,_,_).
+
+:- regtype xref_pred(P)
+    # "@var{P} is a predicate name @tt{M:F/A}.".
+
+xref_pred(M:F/A):- atm(M), atm(F), int(A).
+
+:- export(xrefsdb_worker/0).
+:- pred xrefsdb_worker # "Main predicate for the worker processes of
+    @pred{xrefsdb_update/3}. Do not use directly.".
+
+xrefsdb_worker:-
+    read(user_input,xrefs_job(Bases,Out)),
+    analyze_bases(Bases,Entries),
+    open(Out,write,S),
+    current_output(CO),
+    set_output(S),
+    write_entries(Entries),
+    set_output(CO),
+    close(S).
+
+%-----------------------------------------------------------------------------
+% the index
+
+% xmod(Base,Module,Files,Iface,Imports,Defs,Calls):
+%   Files: File-Digest for the source and the included files
+%   Iface: digest of the interface of Module (none if it had errors)
+%   Imports: imp(ImpBase,ImpIface,ImpSrcDigest) for each imported module
+%   Defs: def(F/A,Kind), with Kind exported, multifile or local
+%   Calls: Caller-Callee pairs, with Caller as F/A and Callee as M:F/A
+:- data xmod/7.
+
+% (derived from xmod/7, indexed on the predicate name)
+:- data xdef/4.     % xdef(F,A,M,Kind)
+:- data xcall/4.    % xcall(F,A,M,Callee): M:F/A calls Callee
+:- data xcalled/4.  % xcalled(F,A,M,Caller): M:F/A is called by Caller
+
+index_version(1).
+
+read_index(Index):-
+    retractall_fact(xmod(_,_,_,_,_,_,_)),
+    ( file_exists(Index) ->
+        open(Index,read,S),
+        current_input(CI),
+        set_input(S),
+        ( fast_read(V), index_version(V) -> read_entries ; true ),
+        set_input(CI),
+        close(S)
+    ; true
+    ).
+
+read_entries:-
+    ( fast_read(Entry) ->
+        assertz_fact(Entry),
+        read_entries
+    ; true
+    ).
+
+write_index(Index):-
+    file_buffer_begin(Index,Buffer,S),
+    current_output(CO),
+    set_output(S),
+    index_version(V),
+    fast_write(V),
+    findall(xmod(B,M,Fs,I,Is,Ds,Cs), xmod(B,M,Fs,I,Is,Ds,Cs), Entries),
+    write_entries(Entries),
+    set_output(CO),
+    file_buffer_commit(Buffer).
+
+write_entries([]).
+write_entries([E|Es]):-
+    fast_write(E),
+    write_entries(Es).
+
+derive_index:-
+    retractall_fact(xdef(_,_,_,_)),
+    retractall_fact(xcall(_,_,_,_)),
+    retractall_fact(xcalled(_,_,_,_)),
+    ( xmod(_,M,_,_,_,Defs,Calls),
+        derive_defs(Defs,M),
+        derive_calls(Calls,M),
+        fail
+    ; true
+    ).
+
+derive_defs([],_M).
+derive_defs([def(F/A,Kind)|Defs],M):-
+    assertz_fact(xdef(F,A,M,Kind)),
+    derive_defs(Defs,M).
+
+derive_calls([],_M).
+derive_calls([F/A-Callee|Calls],M):-
+    assertz_fact(xcall(F,A,M,Callee)),
+    Callee = CM:CF/CA,
+    assertz_fact(xcalled(CF,CA,CM,M:F/A)),
+    derive_calls(Calls,M).
+
+:- data reached/3.
+
+mark_reachable(Roots):-
+    retractall_fact(reached(_,_,_)),
+    mark_reachable_(Roots).
+
+mark_reachable_([]).
+mark_reachable_([M:F/A|Ps]):-
+    ( current_fact(reached(F,A,M)) ->
+        Ps1 = Ps
+    ; assertz_fact(reached(F,A,M)),
+      findall(C, xcall(F,A,M,C), Cs),
+      append(Cs,Ps,Ps1)
+    ),
+    mark_reachable_(Ps1).
+
+%-----------------------------------------------------------------------------
+% incremental update
+
+files_bases([],[]).
+files_bases([File|Files],[Base|Bases]):-
+    absolute_file_name(File,'','.pl','.',_,Base,_),
+    files_bases(Files,Bases).
+
+remove_other_entries(Bases):-
+    ( xmod(Base,_,_,_,_,_,_),
+        \+ member_ord(Base,Bases),
+        retract_fact(xmod(Base,_,_,_,_,_,_)),
+        fail
+    ; true
+    ).
+
+% (digests of sources computed in this update)
+:- data src_digest/2.
+
+cached_file_digest(File,Digest):-
+    ( current_fact(src_digest(File,Digest0)) ->
+        Digest = Digest0
+    ; file_digest(File,Digest0) ->
+        assertz_fact(src_digest(File,Digest0)),
+        Digest = Digest0
+    ; Digest = none
+    ).
+
+% Sources that are not indexed, that changed, or that import modules
+% out of the index whose sources changed
+stale_entries([],[]).
+stale_entries([Base|Bases],Stale):-
+    ( current_fact(xmod(Base,_,Files,_,Imports,_,_)),
+      unchanged_files(Files),
+      unchanged_external_imports(Imports) ->
+        Stale = Stale1
+    ; Stale = [Base|Stale1]
+    ),
+    stale_entries(Bases,Stale1).
+
+unchanged_files([]).
+unchanged_files([File-Digest|Files]):-
+    cached_file_digest(File,Digest),
+    unchanged_files(Files).
+
+unchanged_external_imports([]).
+unchanged_external_imports([imp(B,_,Digest)|Imports]):-
+    ( current_fact(xmod(B,_,_,_,_,_,_)) -> true
+    ; atom_concat(B,'.pl',Pl),
+      cached_file_digest(Pl,Digest)
+    ),
+    unchanged_external_imports(Imports).
+
+% Analyze the stale sources, then those that import indexed modules
+% whose interface changed, until none is left
+update_rounds([],_Index,_Jobs,Analyzed0,Analyzed):- !,
+    sort(Analyzed0,Analyzed).
+update_rounds(Stale,Index,Jobs,Analyzed0,Analyzed):-
+    analyze_stale(Stale,Index,Jobs),
+    indexed_interfaces(Stale),
+    append(Stale,Analyzed0,Analyzed1),
+    findall(B, outdated_interfaces(B), Stale1),
+    update_rounds(Stale1,Index,Jobs,Analyzed1,Analyzed).
+
+outdated_interfaces(B):-
+    xmod(B,_,_,_,Imports,_,_),
+    \+ current_interfaces(Imports).
+
+current_interfaces([]).
+current_interfaces([imp(B,Iface,_)|Imports]):-
+    ( current_fact(xmod(B,_,_,Iface0,_,_,_)) -> Iface0 == Iface ; true ),
+    current_interfaces(Imports).
+
+% Record the interfaces of indexed modules imported by the analyzed
+% sources as they are in the index (the interface seen by the analysis
+% may come from an outdated itf file), so that rounds terminate
+indexed_interfaces([]).
+indexed_interfaces([Base|Bases]):-
+    ( retract_fact(xmod(Base,M,Files,Iface,Imports0,Defs,Calls)) ->
+        indexed_imports(Imports0,Imports),
+        assertz_fact(xmod(Base,M,Files,Iface,Imports,Defs,Calls))
+    ; true
+    ),
+    indexed_interfaces(Bases).
+
+indexed_imports([],[]).
+indexed_imports([imp(B,Iface0,Digest)|Imports0],[imp(B,Iface,Digest)|Imports]):-
+    ( current_fact(xmod(B,_,_,Iface1,_,_,_)) -> Iface = Iface1 ; Iface = Iface0 ),
+    indexed_imports(Imports0,Imports).
+
+analyze_stale(Stale,Index,Jobs):-
+    length(Stale,N),
+    ( Jobs > 1, N > 1 ->
+        ( Jobs < N -> K = Jobs ; K = N ),
+        analyze_parallel(Stale,K,Index,Entries)
+    ; analyze_bases(Stale,Entries)
+    ),
+    replace_entries(Entries).
+
+replace_entries([]).
+replace_entries([E|Es]):-
+    arg(1,E,Base),
+    retractall_fact(xmod(Base,_,_,_,_,_,_)),
+    assertz_fact(E),
+    replace_entries(Es).
+
+%-----------------------------------------------------------------------------
+% workers
+
+xrefsdb_exec(Exec):- cmd_path(core, plexe, 'ciaosh', Exec).
+
+% (sources are dealt round-robin; missing results are analyzed again
+% in the next update)
+analyze_parallel(Bases,K,Index,Entries):-
+    deal(Bases,K,Chunks),
+    start_workers(Chunks,Index,1,Jobs),
+    join_workers(Jobs,Entries).
+
+deal(Bases,K,Chunks):-
+    empty_chunks(K,Chunks0),
+    deal_(Bases,Chunks0,[],Chunks).
+
+empty_chunks(0,[]):- !.
+empty_chunks(K,[[]|Cs]):- K1 is K-1, empty_chunks(K1,Cs).
+
+deal_([],Cs,Done,Chunks):- !,
+    append(Cs,Done,Chunks).
+deal_(Bases,[],Done,Chunks):- !,
+    reverse_(Done,[],Cs),
+    deal_(Bases,Cs,[],Chunks).
+deal_([B|Bases],[C|Cs],Done,Chunks):-
+    deal_(Bases,Cs,[[B|C]|Done],Chunks).
+
+reverse_([],Ys,Ys).
+reverse_([X|Xs],Ys0,Ys):- reverse_(Xs,[X|Ys0],Ys).
+
+start_workers([],_Index,_I,[]).
+start_workers([Bases|Chunks],Index,I,[job(P,Out)|Jobs]):-
+    number_codes(I,Cs),
+    atom_codes(IA,Cs),
+    atom_concat([Index,'-job',IA],Out),
+    absolute_file_name(library(xrefs/xrefsdb),Lib),
+    xrefsdb_exec(Exec),
+    cpx_process_call(Exec, ['-q','-f','-u',Lib,'-e','xrefsdb_worker'], [
+        stdin(terms([xrefs_job(Bases,Out)])),
+        status(_), % (ignore status, missing results are analyzed again)
+        background(P)
+    ]),
+    I1 is I+1,
+    start_workers(Chunks,Index,I1,Jobs).
+
+join_workers([],[]).
+join_workers([job(P,Out)|Jobs],Entries):-
+    ( process_join(P) -> true ; true ),
+    ( file_exists(Out) ->
+        open(Out,read,S),
+        current_input(CI),
+        set_input(S),
+        read_terms(Entries,Entries1),
+        set_input(CI),
+        close(S),
+        delete_file(Out)
+    ; Entries = Entries1
+    ),
+    join_workers(Jobs,Entries1).
+
+read_terms(Ts,Ts0):-
+    ( fast_read(T) ->
+        Ts = [T|Ts1],
+        read_terms(Ts1,Ts0)
+    ; Ts = Ts0
+    ).
+
+%-----------------------------------------------------------------------------
+% analysis of a source
+
+:- data analyzed/1.
+
+analyze_bases([],[]).
+analyze_bases([Base|Bases],[Entry|Entries]):-
+    analyze_base(Base,Entry),
+    analyze_bases(Bases,Entries).
+
+% (sources with errors get an entry without information, so that they
+% are not analyzed again until they change)
+analyze_base(Base,Entry):-
+    atom_concat(Base,'.pl',Pl),
+    retractall_fact(analyzed(_)),
+    ( error_protect(ctrlc_clean(
+            process_file(Pl, xrefs, any, treat, c_itf:false, c_itf:false, always)
+        ), fail),
+      retract_fact(analyzed(Entry0)) ->
+        Entry = Entry0
+    ; cached_file_digest(Pl,Digest),
+      Entry = xmod(Base,'?',[Pl-Digest],none,[],[],[])
+    ).
+
+always(_Base).
+
+treat(Base):-
+    defines_module(Base,M),
+    file_data(Base,Pl,_),
+    cached_file_digest(Pl,Digest),
+    findall(F-D, ( includes(Base,I), source_file(I,F), cached_file_digest(F,D) ), Incs),
+    interface_digest(Base,Iface),
+    findall(B, ( ( uses(Base,File) ; adds(Base,File) ), base_name(File,B) ), Bs0),
+    sort(Bs0,Bs),
+    imported_interfaces(Bs,Imports),
+    findall(def(F/A,Kind), defined(Base,F,A,Kind), Defs0),
+    sort(Defs0,Defs),
+    findall(Call, clause_call(Base,M,Call), Calls0),
+    sort(Calls0,Calls),
+    assertz_fact(analyzed(xmod(Base,M,[Pl-Digest|Incs],Iface,Imports,Defs,Calls))).
+
+source_file(File,Pl):-
+    base_name(File,B),
+    file_data(B,Pl,_).
+
+interface_digest(Base,Digest):-
+    findall(F/A-Meta, exports(Base,F,A,_,Meta), Exps0),
+    sort(Exps0,Exps),
+    term_digest(Exps,Digest).
+
+imported_interfaces([],[]).
+imported_interfaces([B|Bs],[imp(B,Iface,Digest)|Imports]):-
+    interface_digest(B,Iface),
+    ( file_data(B,Pl,_) -> true ; atom_concat(B,'.pl',Pl) ),
+    cached_file_digest(Pl,Digest),
+    imported_interfaces(Bs,Imports).
+
+defined(Base,F,A,Kind):-
+    ( defines_pred(Base,F,A)
+    ; def_multifile(Base,F,A,_)
+    ),
+    def_kind(Base,F,A,Kind).
+
+def_kind(Base,F,A,Kind):-
+    ( exports(Base,F,A,_,_) -> Kind = exported
+    ; def_multifile(Base,F,A,_) -> Kind = multifile
+    ; Kind = local
+    ).
+
+clause_call(Base,M,Caller-Callee):-
+    clause_of(Base,H,B,_VNs,_Source,_LBegin,_LEnd),
+    ( number(H) -> Caller = (:-)/0
+    ; functor(H,F,A), Caller = F/A
+    ),
+    body_callees(B,Base,M,Callees,[]),
+    member_(Callee,Callees).
+
+member_(X,[X|_]).
+member_(X,[_|Xs]):- member_(X,Xs).
+
+body_callees(X,_Base,_M,Cs,Tail):-
+    var(X), !,
+    Cs = ['?':call/1|Tail].
+body_callees(Q:X,Base,M,Cs,Tail):- !,
+    ( atom(Q), nonvar(X) ->
+        functor(X,F,A),
+        Cs = [Q:F/A|Tail]
+    ; body_callees(X,Base,M,Cs,Tail)
+    ).
+body_callees(!,_Base,_M,Cs,Tail):- !,
+    Cs = Tail.
+body_callees((X,Y),Base,M,Cs,Tail):- !,
+    body_callees(X,Base,M,Cs,Cs1),
+    body_callees(Y,Base,M,Cs1,Tail).
+body_callees((X;Y),Base,M,Cs,Tail):- !,
+    body_callees(X,Base,M,Cs,Cs1),
+    body_callees(Y,Base,M,Cs1,Tail).
+body_callees((X->Y),Base,M,Cs,Tail):- !,
+    body_callees(X,Base,M,Cs,Cs1),
+    body_callees(Y,Base,M,Cs1,Tail).
+body_callees(\+ X,Base,M,Cs,Tail):- !,
+    body_callees(X,Base,M,Cs,Tail).
+body_callees(X,Base,M,Cs,Tail):-
+    callable(X), !,
+    functor(X,F,A),
+    resolve(Base,M,F,A,Callee,Meta),
+    Cs = [Callee|Cs1],
+    meta_callees(Meta,X,Base,M,Cs1,Tail).
+body_callees(_X,_Base,_M,Cs,Cs).
+
+% Callee is the predicate F/A called from Base (module M), with
+% meta_predicate declaration Meta (or 0)
+resolve(Base,M,F,A,Callee,Meta):-
+    defines_pred(Base,F,A), !,
+    Callee = M:F/A,
+    ( meta_pred(Base,F,A,Meta0) -> Meta = Meta0 ; Meta = 0 ).
+resolve(Base,_M,F,A,Callee,Meta):-
+    imports_pred(Base,ImpFile,F,A,_DefType,Meta,EndFile), !,
+    ( EndFile == '.' -> DefFile = ImpFile ; DefFile = EndFile ),
+    file_module(DefFile,DM),
+    Callee = DM:F/A.
+resolve(_Base,_M,F,A,'?':F/A,0).
+
+file_module(user,user):- !.
+file_module(File,M):-
+    base_name(File,B),
+    defines_module(B,M0), !,
+    M = M0.
+file_module(File,File).
+
+% Calls in the meta-arguments of a goal
+meta_callees(0,_X,_Base,_M,Cs,Cs):- !.
+meta_callees(Meta,X,Base,M,Cs,Tail):-
+    functor(Meta,_,A),
+    meta_args(1,A,Meta,X,Base,M,Cs,Tail).
+
+meta_args(I,A,_Meta,_X,_Base,_M,Cs,Tail):- I > A, !,
+    Cs = Tail.
+meta_args(I,A,Meta,X,Base,M,Cs,Tail):-
+    arg(I,Meta,Spec),
+    arg(I,X,Arg),
+    meta_arg(Spec,Arg,Base,M,Cs,Cs1),
+    I1 is I+1,
+    meta_args(I1,A,Meta,X,Base,M,Cs1,Tail).
+
+meta_arg(goal,Arg,Base,M,Cs,Tail):- !,
+    body_callees(Arg,Base,M,Cs,Tail).
+meta_arg(pred(N),Arg,Base,M,Cs,Tail):- integer(N), !,
+    ( callable(Arg), \+ Arg = _:_ ->
+        Arg =.. L0,
+        length(Extra,N),
+        append(L0,Extra,L),
+        G =.. L,
+        body_callees(G,Base,M,Cs,Tail)
+    ; body_callees(Arg,Base,M,Cs,Tail)
+    ).
+meta_arg(_Spec,_Arg,_Base,_M,Cs,Cs).
+
+%-----------------------------------------------------------------------------
+
+member_opt(X,[Y|Ys]):-
+    ( X = Y -> true ; member_opt(X,Ys) ).
+
+member_ord(X,[Y|Ys]):-
+    ( X == Y -> true ; X @> Y, member_ord(X,Ys) ).
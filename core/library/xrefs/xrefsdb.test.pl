@@ -0,0 +1,71 @@
+:- module(_, [], [assertions, nativeprops]).
+
+:- doc(title, "Tests for xrefsdb.pl").
+
+:- doc(module, "Builds an index for two small modules in a temporary
+   directory and checks the queries and which modules are analyzed
+   again after each change.").
+
+:- use_module(library(xrefs/xrefsdb)).
+:- use_module(library(terms_io), [terms_to_file/2]).
+:- use_module(library(source_tree), [remove_dir/1]).
+:- use_module(library(pathnames), [path_concat/3]).
+:- use_module(library(system), [
+    mktemp_in_tmp/2, delete_file/1, make_directory/1, pause/1]).
+
+:- export(incremental/0).
+:- test incremental # "Queries and incremental updates".
+
+incremental :-
+    mktemp_in_tmp('xrefsdbXXXXXX', Dir),
+    delete_file(Dir),
+    make_directory(Dir),
+    path_concat(Dir, a, A),
+    path_concat(Dir, b, B),
+    path_concat(Dir, index, Index),
+    write_b(Dir, 1, [bp/1]),
+    write_module(Dir, a, [
+        (:- module(a, [main/0], [])),
+        (:- use_module(b, [bp/1])),
+        (main :- bp(X), helper(X)),
+        (helper(X) :- \+ c(X)),
+        c(1),
+        (dead :- c(_))
+    ]),
+    ( check_index(Dir, A, B, Index) -> Ok = yes ; Ok = no ),
+    remove_dir(Dir),
+    Ok = yes.
+
+check_index(Dir, A, B, Index) :-
+    xrefsdb_update(Index, [A, B], [jobs(2), analyzed(An1)]),
+    An1 == [A, B],
+    xrefsdb_callers(a:c/1, [a:dead/0, a:helper/1]),
+    xrefsdb_callees(a:main/0, [a:helper/1, b:bp/1]),
+    xrefsdb_reachable([a:main/0], R),
+    R = [a:c/1, a:helper/1, a:main/0, b:bp/1, b:bq/1|_],
+    xrefsdb_unused([a:dead/0]),
+    % nothing changed
+    xrefsdb_update(Index, [A, B], [analyzed([])]),
+    pause(1), % (modification times have a resolution of seconds)
+    % the body of b changed
+    write_b(Dir, 2, [bp/1]),
+    xrefsdb_update(Index, [A, B], [analyzed([B])]),
+    pause(1),
+    % the interface of b changed
+    write_b(Dir, 2, [bp/1, bq/1]),
+    xrefsdb_update(Index, [A, B], [analyzed([A, B])]),
+    % the index is persistent
+    xrefsdb_load(Index),
+    xrefsdb_callers(b:bq/1, [b:bp/1]).
+
+write_b(Dir, N, Exports) :-
+    write_module(Dir, b, [
+        (:- module(b, Exports, [])),
+        (bp(X) :- bq(X)),
+        bq(N)
+    ]).
+
+write_module(Dir, Name, Clauses) :-
+    atom_concat(Name, '.pl', File),
+    path_concat(Dir, File, Path),
+    terms_to_file(Clauses, Path).
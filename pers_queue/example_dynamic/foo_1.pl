@@ -0,0 +1,184 @@
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
+'example_dynamic:foo'(1) .
+'example_dynamic:foo'(5) .
+'example_dynamic:foo'(4) .
+'example_dynamic:foo'(3) .
+'example_dynamic:foo'(2) .
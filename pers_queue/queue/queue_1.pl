@@ -0,0 +1,74 @@
+'queue:queue'(first) .
+'queue:queue'(second) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .
+'queue:queue'(a) .
+'queue:queue'(b) .